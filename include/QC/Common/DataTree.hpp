@@ -34,6 +34,42 @@ private:
     DataTree( const json &js );
 
 public:
+    /**
+     * @brief A dotted key split into its tokens once, to be reused for every lookup.
+     * @example
+     *  static const DataTree::Path s_widthPath( "static.width" );
+     *  dt.Get<uint32_t>( s_widthPath, 0 );
+     */
+    class Path
+    {
+    public:
+        /**
+         * @brief Constructs a Path from a dotted key string.
+         * @param[in] key The input key string, such as "static.width".
+         * @return void
+         */
+        explicit Path( const std::string &key );
+
+        /**
+         * @brief Gets the dotted key string of this Path.
+         * @return The dotted key string.
+         */
+        const std::string &GetKey() const { return m_key; }
+
+        /**
+         * @brief Gets the tokens of this Path.
+         * @return The tokens split by '.'.
+         */
+        const std::vector<std::string> &GetTokens() const { return m_tokens; }
+
+    private:
+        std::string m_key;
+        std::vector<std::string> m_tokens;
+    };
+
+    template<typename C>
+    class Schema;
+
     DataTree();
     ~DataTree();
 
@@ -143,6 +179,28 @@ public:
      */
     QCStatus_e Get( const std::string &key, std::vector<DataTree> &dts );
 
+    /**
+     * @brief The same as the key string versions, but the key is a precompiled Path, so the
+     * lookup does not need to split the key again.
+     */
+    bool Exists( const Path &path );
+
+    template<typename T>
+    T Get( const Path &path, T dv );
+
+    template<typename T>
+    std::vector<T> Get( const Path &path, std::vector<T> dv );
+
+    QCImageFormat_e GetImageFormat( const Path &path, QCImageFormat_e dv );
+
+    QCTensorType_e GetTensorType( const Path &path, QCTensorType_e dv );
+
+    QCProcessorType_e GetProcessorType( const Path &path, QCProcessorType_e dv );
+
+    QCStatus_e Get( const Path &path, DataTree &dt );
+
+    QCStatus_e Get( const Path &path, std::vector<DataTree> &dts );
+
     /**
      * @brief Sets the value for the specified key.
      * @param[in] key The input key string.
@@ -218,42 +276,426 @@ public:
      */
     void Set( const std::string &key, std::vector<DataTree> &kv );
 
+private:
+    const json *Find( const std::string &key ) const;
+    const json *Find( const Path &path ) const;
+
+    template<typename T>
+    T GetValue( const json *pValue, const std::string &key, T dv ) const;
+
+    template<typename T>
+    std::vector<T> GetValues( const json *pValue, const std::string &key,
+                              std::vector<T> dv ) const;
+
+    static QCStatus_e ToDataTree( const json *pValue, DataTree &dt );
+    static QCStatus_e ToDataTrees( const json *pValue, std::vector<DataTree> &dts );
+    static QCImageFormat_e ToImageFormat( const json *pValue, QCImageFormat_e dv );
+    static QCTensorType_e ToTensorType( const json *pValue, QCTensorType_e dv );
+    static QCProcessorType_e ToProcessorType( const json *pValue, QCProcessorType_e dv );
+
 private:
     json m_json;
 };
 
-
-template<typename T>
-T DataTree::Get( const std::string &key, T dv )
+/**
+ * @brief Binds the members of a config structure to the keys of a DataTree.
+ *
+ * The field list is built once, with the keys precompiled into DataTree::Path, and then Bind fills
+ * the config structure from a DataTree in one pass. A missing key takes the default value, a
+ * missing required key or a value of a wrong type is reported into the errors string. The checks
+ * run once all the fields are bound, to validate ranges and the dependencies between fields.
+ *
+ * @example
+ *  static const DataTree::Schema<MyConfig_t> s_schema =
+ *          DataTree::Schema<MyConfig_t>()
+ *                  .Add<uint32_t>( "width", &MyConfig_t::width, 0, true )
+ *                  .AddEnum<MyMode_e>( "mode", &MyConfig_t::mode,
+ *                                      { { "fast", MY_MODE_FAST }, { "slow", MY_MODE_SLOW } },
+ *                                      MY_MODE_FAST )
+ *                  .Check( "width is out of range",
+ *                          []( const MyConfig_t &config ) { return config.width <= 4096; } );
+ *  status = s_schema.Bind( dt, config, errors );
+ */
+template<typename C>
+class DataTree::Schema
 {
-    std::istringstream ss( key );
-    std::string token;
-    const json *pCurrent = &m_json;
-    T retV;
-    bool bHasKey = true;
+public:
+    /**
+     * @brief Adds a field of a JSON convertible type.
+     * @param[in] key The input key string.
+     * @param[in] pMember The member of the config structure.
+     * @param[in] dv The default value if the key does not exist.
+     * @param[in] bRequired true if the key must exist.
+     * @return This Schema.
+     */
+    template<typename T>
+    Schema &Add( const std::string &key, T C::*pMember, T dv, bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [pMember, dv]( const json *pValue, C &config, const std::string &,
+                                             std::string & ) {
+                                  config.*pMember = ( nullptr != pValue ) ? pValue->get<T>() : dv;
+                                  return true;
+                              } } );
+        return *this;
+    }
 
-    while ( std::getline( ss, token, '.' ) )
+    /**
+     * @brief Adds a field of a JSON convertible type bound by a custom function, for the values
+     * that are not a plain member, or that are only valid if present with some value.
+     * @param[in] key The input key string.
+     * @param[in] binder Sets the config from the value, nullptr if the key does not exist, and
+     * returns false if the value is invalid.
+     * @param[in] bRequired true if the key must exist.
+     * @return This Schema.
+     */
+    template<typename T>
+    Schema &AddField( const std::string &key,
+                      std::function<bool( const T *pValue, C &config )> binder,
+                      bool bRequired = false )
     {
-        if ( pCurrent->contains( token ) )
+        m_fields.push_back( { Path( key ), bRequired,
+                              [binder]( const json *pValue, C &config, const std::string &,
+                                        std::string & ) {
+                                  bool bValid;
+                                  if ( nullptr == pValue )
+                                  {
+                                      bValid = binder( nullptr, config );
+                                  }
+                                  else
+                                  {
+                                      T value = pValue->get<T>();
+                                      bValid = binder( &value, config );
+                                  }
+                                  return bValid;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief The same as AddField above, but the binder describes why the value is invalid.
+     * @param[in] key The input key string.
+     * @param[in] binder Sets the config from the value, nullptr if the key does not exist, and
+     * returns false if the value is invalid, with the error reported after the key, such as
+     * "<value> is invalid" for "the key <value> is invalid".
+     * @param[in] bRequired true if the key must exist.
+     * @return This Schema.
+     */
+    template<typename T>
+    Schema &AddField( const std::string &key,
+                      std::function<bool( const T *pValue, C &config, std::string &error )> binder,
+                      bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [binder]( const json *pValue, C &config, const std::string &name,
+                                        std::string &errors ) {
+                                  bool bValid;
+                                  std::string error = "is invalid";
+                                  if ( nullptr == pValue )
+                                  {
+                                      bValid = binder( nullptr, config, error );
+                                  }
+                                  else
+                                  {
+                                      T value = pValue->get<T>();
+                                      bValid = binder( &value, config, error );
+                                  }
+                                  if ( false == bValid )
+                                  {
+                                      errors += "the " + name + " " + error + ", ";
+                                  }
+                                  return bValid;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds an enum field whose value is one of the listed strings, an invalid value is
+     * reported as "the key value is invalid".
+     * @param[in] key The input key string.
+     * @param[in] pMember The member of the config structure.
+     * @param[in] options The string and enum value pairs.
+     * @param[in] dv The default value if the key does not exist.
+     * @param[in] bRequired true if the key must exist.
+     * @return This Schema.
+     */
+    template<typename E>
+    Schema &AddEnum( const std::string &key, E C::*pMember,
+                     const std::vector<std::pair<std::string, E>> &options, E dv,
+                     bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [pMember, options, dv]( const json *pValue, C &config,
+                                                      const std::string &name,
+                                                      std::string &errors ) {
+                                  bool bValid = false;
+                                  if ( nullptr == pValue )
+                                  {
+                                      config.*pMember = dv;
+                                      bValid = true;
+                                  }
+                                  else
+                                  {
+                                      const std::string &value =
+                                              pValue->get_ref<const std::string &>();
+                                      for ( auto &option : options )
+                                      {
+                                          if ( option.first == value )
+                                          {
+                                              config.*pMember = option.second;
+                                              bValid = true;
+                                              break;
+                                          }
+                                      }
+                                      if ( false == bValid )
+                                      {
+                                          errors += "the " + name + " " + value + " is invalid, ";
+                                      }
+                                  }
+                                  return bValid;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds a list of objects, each object is bound by the schema of the list element. The
+     * errors of an element are reported with the key and the index, such as "list[1].name", or
+     * with the element name and the index, such as "item 1 name", and a value that is not a list
+     * is reported as an invalid key.
+     * @param[in] key The input key string.
+     * @param[in] pMember The list member of the config structure, empty if the key does not exist.
+     * @param[in] schema The schema of the list element.
+     * @param[in] elementName The name of an element in the errors, empty to use the key.
+     * @return This Schema.
+     */
+    template<typename E>
+    Schema &AddList( const std::string &key, std::vector<E> C::*pMember, const Schema<E> &schema,
+                     const std::string &elementName = "" )
+    {
+        m_fields.push_back( { Path( key ), false,
+                              [pMember, schema, elementName](
+                                      const json *pValue, C &config, const std::string &name,
+                                      std::string &errors ) {
+                                  bool bValid = true;
+                                  std::vector<E> &list = config.*pMember;
+                                  list.clear();
+                                  if ( nullptr == pValue )
+                                  {
+                                      /* OK if not configured */
+                                  }
+                                  else if ( false == pValue->is_array() )
+                                  {
+                                      bValid = false;
+                                  }
+                                  else
+                                  {
+                                      list.resize( pValue->size() );
+                                      for ( size_t i = 0; i < list.size(); i++ )
+                                      {
+                                          const json &element = ( *pValue )[i];
+                                          std::string index = std::to_string( i );
+                                          std::string prefix =
+                                                  elementName.empty()
+                                                          ? name + "[" + index + "]."
+                                                          : elementName + " " + index + " ";
+                                          if ( false == element.is_object() )
+                                          {
+                                              prefix.pop_back();
+                                              errors += "the " + prefix + " is invalid, ";
+                                              bValid = false;
+                                          }
+                                          else if ( QC_STATUS_OK !=
+                                                    schema.Bind( DataTree( element ), list[i],
+                                                                 prefix, errors ) )
+                                          {
+                                              bValid = false;
+                                          }
+                                          else
+                                          {
+                                              /* OK */
+                                          }
+                                      }
+                                  }
+                                  return bValid;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds an image format field, the same strings as DataTree::GetImageFormat.
+     */
+    Schema &AddImageFormat( const std::string &key, QCImageFormat_e C::*pMember,
+                            QCImageFormat_e dv, bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [pMember, dv]( const json *pValue, C &config, const std::string &,
+                                             std::string & ) {
+                                  config.*pMember = DataTree::ToImageFormat( pValue, dv );
+                                  return QC_IMAGE_FORMAT_MAX != config.*pMember;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds a tensor type field, the same strings as DataTree::GetTensorType.
+     */
+    Schema &AddTensorType( const std::string &key, QCTensorType_e C::*pMember,
+                           QCTensorType_e dv, bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [pMember, dv]( const json *pValue, C &config, const std::string &,
+                                             std::string & ) {
+                                  config.*pMember = DataTree::ToTensorType( pValue, dv );
+                                  return QC_TENSOR_TYPE_MAX != config.*pMember;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds a processor type field, the same strings as DataTree::GetProcessorType.
+     */
+    Schema &AddProcessorType( const std::string &key, QCProcessorType_e C::*pMember,
+                              QCProcessorType_e dv, bool bRequired = false )
+    {
+        m_fields.push_back( { Path( key ), bRequired,
+                              [pMember, dv]( const json *pValue, C &config, const std::string &,
+                                             std::string & ) {
+                                  config.*pMember = DataTree::ToProcessorType( pValue, dv );
+                                  return QC_PROCESSOR_MAX != config.*pMember;
+                              } } );
+        return *this;
+    }
+
+    /**
+     * @brief Adds a check of the bound config structure, run once all the fields are valid.
+     * @param[in] error The error reported if the check fails, such as "width is out of range".
+     * @param[in] isValid Returns false if the config structure is invalid.
+     * @return This Schema.
+     */
+    Schema &Check( const std::string &error, std::function<bool( const C &config )> isValid )
+    {
+        m_checks.push_back( { error, [isValid]( const C &config, std::string & ) {
+                                 return isValid( config );
+                             } } );
+        return *this;
+    }
+
+    /**
+     * @brief The same as Check above, but the check describes the error, for the errors that
+     * report the invalid value.
+     * @param[in] isValid Returns false if the config structure is invalid, with the error such as
+     * "width 8192 is out of range".
+     * @return This Schema.
+     */
+    Schema &Check( std::function<bool( const C &config, std::string &error )> isValid )
+    {
+        m_checks.push_back( { "", isValid } );
+        return *this;
+    }
+
+    /**
+     * @brief Fills the config structure from the DataTree.
+     * @param[in] dt The DataTree to read.
+     * @param[out] config The config structure to fill.
+     * @param[out] errors The related error strings of the invalid fields.
+     * @return QC_STATUS_OK on success, QC_STATUS_BAD_ARGUMENTS if any field is invalid.
+     */
+    QCStatus_e Bind( const DataTree &dt, C &config, std::string &errors ) const
+    {
+        return Bind( dt, config, "", errors );
+    }
+
+private:
+    template<typename>
+    friend class Schema;
+
+    QCStatus_e Bind( const DataTree &dt, C &config, const std::string &prefix,
+                     std::string &errors ) const
+    {
+        QCStatus_e status = QC_STATUS_OK;
+
+        for ( auto &field : m_fields )
         {
-            pCurrent = &( ( *pCurrent )[token] );
+            const json *pValue = dt.Find( field.path );
+            std::string name = prefix + field.path.GetKey();
+            if ( ( nullptr == pValue ) && ( true == field.bRequired ) )
+            {
+                errors += "the " + name + " is required, ";
+                status = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else
+            {
+                try
+                {
+                    /* a binder may report its own errors, such as the errors of a list element */
+                    size_t errorsLength = errors.size();
+                    if ( false == field.binder( pValue, config, name, errors ) )
+                    {
+                        if ( errors.size() == errorsLength )
+                        {
+                            errors += "the " + name + " is invalid, ";
+                        }
+                        status = QC_STATUS_BAD_ARGUMENTS;
+                    }
+                }
+                catch ( const json::exception &e )
+                {
+                    errors += "the " + name + " is invalid: " + e.what() + ", ";
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                }
+            }
         }
-        else
+
+        if ( QC_STATUS_OK == status )
         {
-            bHasKey = false;
+            for ( auto &check : m_checks )
+            {
+                std::string error = check.error;
+                if ( false == check.isValid( config, error ) )
+                {
+                    errors += "the " + prefix + error + ", ";
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                }
+            }
         }
+
+        return status;
     }
 
-    if ( bHasKey )
+    typedef struct
+    {
+        Path path;
+        bool bRequired;
+        std::function<bool( const json *pValue, C &config, const std::string &name,
+                            std::string &errors )>
+                binder;
+    } Field_t;
+
+    typedef struct
+    {
+        std::string error;
+        std::function<bool( const C &config, std::string &error )> isValid;
+    } Check_t;
+
+    std::vector<Field_t> m_fields;
+    std::vector<Check_t> m_checks;
+};
+
+
+template<typename T>
+T DataTree::GetValue( const json *pValue, const std::string &key, T dv ) const
+{
+    T retV;
+
+    if ( nullptr != pValue )
     {
         try
         {
-            retV = pCurrent->get<T>();
+            retV = pValue->get<T>();
         }
         catch ( const json::exception &e )
         {
-            QC_LOG_ERROR( "DataTree: Get key<%s> of %s with error: %s", key.c_str(),
-                          m_json.dump().c_str(), e.what() );
+            QC_LOG_ERROR( "DataTree: Get key<%s> with error: %s", key.c_str(), e.what() );
             retV = dv;
         }
     }
@@ -265,38 +707,21 @@ T DataTree::Get( const std::string &key, T dv )
     return retV;
 }
 
-
 template<typename T>
-std::vector<T> DataTree::Get( const std::string &key, std::vector<T> dv )
+std::vector<T> DataTree::GetValues( const json *pValue, const std::string &key,
+                                    std::vector<T> dv ) const
 {
-    std::istringstream ss( key );
-    std::string token;
-    const json *pCurrent = &m_json;
     std::vector<T> retV;
-    bool bHasKey = true;
-
-    while ( std::getline( ss, token, '.' ) )
-    {
-        if ( pCurrent->contains( token ) )
-        {
-            pCurrent = &( ( *pCurrent )[token] );
-        }
-        else
-        {
-            bHasKey = false;
-        }
-    }
 
-    if ( bHasKey && pCurrent->is_array() )
+    if ( ( nullptr != pValue ) && pValue->is_array() )
     {
         try
         {
-            retV = pCurrent->get<std::vector<T>>();
+            retV = pValue->get<std::vector<T>>();
         }
         catch ( const json::exception &e )
         {
-            QC_LOG_ERROR( "DataTree: Get key<%s> of %s with error: %s", key.c_str(),
-                          m_json.dump().c_str(), e.what() );
+            QC_LOG_ERROR( "DataTree: Get key<%s> with error: %s", key.c_str(), e.what() );
             retV = dv;
         }
     }
@@ -308,6 +733,30 @@ std::vector<T> DataTree::Get( const std::string &key, std::vector<T> dv )
     return retV;
 }
 
+template<typename T>
+T DataTree::Get( const std::string &key, T dv )
+{
+    return GetValue<T>( Find( key ), key, dv );
+}
+
+template<typename T>
+std::vector<T> DataTree::Get( const std::string &key, std::vector<T> dv )
+{
+    return GetValues<T>( Find( key ), key, dv );
+}
+
+template<typename T>
+T DataTree::Get( const Path &path, T dv )
+{
+    return GetValue<T>( Find( path ), path.GetKey(), dv );
+}
+
+template<typename T>
+std::vector<T> DataTree::Get( const Path &path, std::vector<T> dv )
+{
+    return GetValues<T>( Find( path ), path.GetKey(), dv );
+}
+
 
 template<typename T>
 void DataTree::Set( const std::string &key, T kv )
@@ -0,0 +1,180 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#ifndef QC_QUANTIZED_TENSOR_VIEW_HPP
+#define QC_QUANTIZED_TENSOR_VIEW_HPP
+
+#include "QC/Infras/Memory/TensorDescriptor.hpp"
+
+#include <cinttypes>
+#include <vector>
+
+namespace QC
+{
+namespace Memory
+{
+
+/**
+ * @class QuantizedTensorView
+ * @brief A read-only view of a 8 or 16 bit fixed point tensor for the CPU post processing.
+ *
+ * The view works on the quantized data in place. It dequantizes blocks of elements with NEON, or
+ * with AVX2 on the x86-64 CPUs that have it, looks the sigmoid of an element up in a table of all
+ * the quantized values, and maps a float threshold to a quantized threshold, so that the elements
+ * below it are skipped without being dequantized.
+ *
+ * @example
+ *   QuantizedTensorView hm;
+ *   hm.Init( hmDesc );
+ *   hm.BuildSigmoidLut();
+ *   hm.Select( hm.GetSigmoidRawThreshold( 0.6f ), 0, hm.GetNumElements(), 1, indices );
+ *   for ( uint32_t idx : indices ) {
+ *       float prob = hm.Sigmoid( idx );
+ *   }
+ */
+class QuantizedTensorView
+{
+public:
+    QuantizedTensorView();
+    ~QuantizedTensorView();
+
+    /**
+     * @brief Initializes the view with the quantization parameters of the tensor descriptor.
+     * @param[in] tensor The tensor, of type [U|S]FIXED_POINT_[8|16] or [U]INT_[8|16].
+     * @return QC_STATUS_OK on success, QC_STATUS_BAD_ARGUMENTS if the tensor type, the dims or the
+     * scale is invalid, QC_STATUS_INVALID_BUF if the buffer is too small for the dims.
+     */
+    QCStatus_e Init( const TensorDescriptor_t &tensor );
+
+    /**
+     * @brief Initializes the view with the given quantization parameters.
+     * @param[in] tensor The tensor, of type [U|S]FIXED_POINT_[8|16] or [U]INT_[8|16].
+     * @param[in] scale The quantization scale, must be positive.
+     * @param[in] offset The quantization offset.
+     * @return QC_STATUS_OK on success, others on failure.
+     */
+    QCStatus_e Init( const TensorDescriptor_t &tensor, float scale, int32_t offset );
+
+    /**
+     * @brief Gets the number of elements of the tensor.
+     * @return The number of elements.
+     */
+    size_t GetNumElements() const { return m_numElements; }
+
+    /**
+     * @brief Gets the quantized value of an element.
+     * @param[in] index The element index.
+     * @return The quantized value.
+     */
+    int32_t GetRaw( size_t index ) const
+    {
+        int32_t raw;
+        switch ( m_elemType )
+        {
+            case ELEM_TYPE_U8:
+                raw = ( (const uint8_t *) m_pData )[index];
+                break;
+            case ELEM_TYPE_S8:
+                raw = ( (const int8_t *) m_pData )[index];
+                break;
+            case ELEM_TYPE_U16:
+                raw = ( (const uint16_t *) m_pData )[index];
+                break;
+            default:
+                raw = ( (const int16_t *) m_pData )[index];
+                break;
+        }
+        return raw;
+    }
+
+    /**
+     * @brief Dequantizes an element.
+     * @param[in] index The element index.
+     * @return The real value.
+     */
+    float Dequantize( size_t index ) const { return RawToFloat( GetRaw( index ) ); }
+
+    /**
+     * @brief Dequantizes a block of consecutive elements.
+     * @param[in] start The index of the first element.
+     * @param[in] count The number of elements.
+     * @param[out] pOut The real values, at least count floats.
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if the block is out of the tensor.
+     */
+    QCStatus_e Dequantize( size_t start, size_t count, float *pOut ) const;
+
+    /**
+     * @brief Builds the sigmoid table of all the quantized values, needed by Sigmoid.
+     * @return QC_STATUS_OK on success, QC_STATUS_BAD_STATE if the view is not initialized.
+     * @note The table has 256 entries for a 8 bit tensor and 65536 entries for a 16 bit tensor, it
+     * is kept across frames as long as the type and the quantization parameters do not change.
+     */
+    QCStatus_e BuildSigmoidLut();
+
+    /**
+     * @brief Gets the sigmoid of the real value of an element from the sigmoid table.
+     * @param[in] index The element index.
+     * @return The sigmoid value.
+     */
+    float Sigmoid( size_t index ) const { return m_sigmoidLut[GetRaw( index ) - m_minRaw]; }
+
+    /**
+     * @brief Gets the smallest quantized value whose real value is greater than a threshold.
+     * @param[in] threshold The real value threshold.
+     * @return The quantized threshold, the max quantized value plus 1 if no value passes.
+     */
+    int32_t GetRawThreshold( float threshold ) const;
+
+    /**
+     * @brief Gets the smallest quantized value whose sigmoid is greater than a probability.
+     * @param[in] prob The probability threshold.
+     * @return The quantized threshold, the max quantized value plus 1 if no value passes.
+     */
+    int32_t GetSigmoidRawThreshold( float prob ) const;
+
+    /**
+     * @brief Selects the elements whose quantized value is not less than a quantized threshold.
+     * @param[in] rawThreshold The quantized threshold, from GetRawThreshold or
+     * GetSigmoidRawThreshold.
+     * @param[in] start The index of the first element.
+     * @param[in] count The number of elements to check.
+     * @param[in] stride The index distance between two checked elements.
+     * @param[out] indices The indices of the selected elements are appended.
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if the elements are out of the
+     * tensor.
+     */
+    QCStatus_e Select( int32_t rawThreshold, size_t start, size_t count, size_t stride,
+                       std::vector<uint32_t> &indices ) const;
+
+private:
+    typedef enum
+    {
+        ELEM_TYPE_U8,
+        ELEM_TYPE_S8,
+        ELEM_TYPE_U16,
+        ELEM_TYPE_S16,
+        ELEM_TYPE_MAX
+    } ElemType_e;
+
+    float RawToFloat( int32_t raw ) const { return (float) ( raw + m_offset ) * m_scale; }
+    static float SigmoidOf( float value );
+
+private:
+    const void *m_pData = nullptr;
+    size_t m_numElements = 0;
+    ElemType_e m_elemType = ELEM_TYPE_MAX;
+    int32_t m_minRaw = 0;
+    int32_t m_maxRaw = 0;
+    float m_scale = 1.0f;
+    int32_t m_offset = 0;
+
+    std::vector<float> m_sigmoidLut;
+    ElemType_e m_lutElemType = ELEM_TYPE_MAX;
+    float m_lutScale = 0.0f;
+    int32_t m_lutOffset = 0;
+};
+
+}   // namespace Memory
+}   // namespace QC
+
+#endif   // QC_QUANTIZED_TENSOR_VIEW_HPP
@@ -90,11 +90,14 @@ public:
  * @param tensorType The tensor type.
  * @param dims The tensor dimensions.
  * @param numDims The number of dimensions.
+ * @param quantScale The quantization scale of a fixed point tensor, 1.0 for the others.
+ * @param quantOffset The quantization offset of a fixed point tensor, the real value of a quantized
+ * value q is ( q + quantOffset ) * quantScale.
  */
 typedef struct TensorDescriptor : public BufferDescriptor
 {
 public:
-    TensorDescriptor() : BufferDescriptor() {}
+    TensorDescriptor() : BufferDescriptor(), quantScale( 1.0f ), quantOffset( 0 ) {}
     /**
      * @brief Sets up the tensor descriptor from another buffer descriptor object.
      * @param[in] other The buffer descriptor object from which buffer members are copied.
@@ -113,9 +116,23 @@ public:
      */
     TensorDescriptor &operator=( const QCSharedBuffer_t &other );
 
+    /**
+     * @brief Gets a new tensor descriptor that represents the batches specified by batchOffset and
+     * batchSize, the batch being the first dimension.
+     * @param[out] tensorDesc The tensor descriptor representing the batches specified by
+     * batchOffset and batchSize, a view of the same buffer.
+     * @param[in] batchOffset The batch offset.
+     * @param[in] batchSize The batch size.
+     * @return QC_STATUS_OK on success, other status codes on failure.
+     */
+    QCStatus_e GetTensorDesc( TensorDescriptor &tensorDesc, uint32_t batchOffset,
+                              uint32_t batchSize = 1 ) const;
+
     QCTensorType_e tensorType;
     uint32_t dims[QC_NUM_TENSOR_DIMS];
     uint32_t numDims;
+    float quantScale;
+    int32_t quantOffset;
 } TensorDescriptor_t;
 
 }   // namespace Memory
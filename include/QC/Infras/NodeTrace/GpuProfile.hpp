@@ -0,0 +1,63 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#ifndef QCNODE_GPU_PROFILE_HPP
+#define QCNODE_GPU_PROFILE_HPP
+
+#include <cinttypes>
+
+namespace QC
+{
+namespace Node
+{
+
+/** @brief The max length of a kernel name, the terminating null included */
+#define QCNODE_GPU_KERNEL_NAME_MAX 64u
+/** @brief The max number of the kernels profiled for one node */
+#define QCNODE_GPU_PROFILE_KERNELS_MAX 16u
+/** @brief The number of the bins of the execution time histogram */
+#define QCNODE_GPU_PROFILE_BINS 16u
+
+/**
+ * @brief The GPU timestamps of the launches of one kernel aggregated for one node.
+ * @param name The name of the kernel.
+ * @param numLaunches The number of the launches completed.
+ * @param totalQueuedNs The sum of the times from the enqueue to the submission to the device.
+ * @param totalPendingNs The sum of the times from the submission to the start of the execution,
+ * the time waiting for the GPU to be free of the other work.
+ * @param totalExecNs The sum of the execution times.
+ * @param maxExecNs The longest execution time.
+ * @param lastExecNs The execution time of the last launch.
+ * @param histogram The number of launches by execution time, the bin 0 counts the launches under
+ * 1 microsecond, the bin i the launches of [2^(i-1), 2^i) microseconds and the last bin all the
+ * longer ones.
+ */
+typedef struct
+{
+    char name[QCNODE_GPU_KERNEL_NAME_MAX];
+    uint64_t numLaunches;
+    uint64_t totalQueuedNs;
+    uint64_t totalPendingNs;
+    uint64_t totalExecNs;
+    uint64_t maxExecNs;
+    uint64_t lastExecNs;
+    uint64_t histogram[QCNODE_GPU_PROFILE_BINS];
+} QCNodeGpuKernelProfile_t;
+
+/**
+ * @brief The GPU profile of the kernels of one node.
+ * @param numKernels The number of the valid entries of kernels.
+ * @param kernels The profile of each kernel, in the order of their names.
+ * @note This structure is placed by the monitoring interface of the GPU nodes.
+ */
+typedef struct
+{
+    uint32_t numKernels;
+    uint32_t reserved;
+    QCNodeGpuKernelProfile_t kernels[QCNODE_GPU_PROFILE_KERNELS_MAX];
+} QCNodeGpuProfile_t;
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QCNODE_GPU_PROFILE_HPP
@@ -0,0 +1,140 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#ifndef QCNODE_PERF_COUNTERS_HPP
+#define QCNODE_PERF_COUNTERS_HPP
+
+#include <cinttypes>
+#include <mutex>
+#include <vector>
+
+#include "QC/Common/QCDefs.hpp"
+#include "QC/Infras/NodeTrace/Ifs/QCNodeTraceIfs.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/** @brief The hardware and software performance counters sampled around a node execution */
+typedef enum
+{
+    QCNODE_PERF_COUNTER_CYCLES,           /**< CPU cycles */
+    QCNODE_PERF_COUNTER_INSTRUCTIONS,     /**< retired instructions */
+    QCNODE_PERF_COUNTER_CACHE_MISSES,     /**< last level cache misses */
+    QCNODE_PERF_COUNTER_CONTEXT_SWITCHES, /**< context switches */
+    QCNODE_PERF_COUNTER_PAGE_FAULTS,      /**< page faults */
+    QCNODE_PERF_COUNTER_MAX
+} QCNodePerfCounterType_e;
+
+/**
+ * @brief The performance counters aggregated for one node.
+ * @param numSamples The number of executions sampled.
+ * @param available Bit mask of the counters that could be opened, indexed by
+ * QCNodePerfCounterType_e. A counter may be unavailable due to the kernel perf_event_paranoid
+ * setting or the PMU of the platform.
+ * @param total The sum of each counter over all the sampled executions.
+ * @param last The value of each counter for the last sampled execution.
+ * @note This structure is placed by the monitoring interface of the CPU nodes.
+ */
+typedef struct
+{
+    uint64_t numSamples;
+    uint32_t available;
+    uint32_t reserved;
+    uint64_t total[QCNODE_PERF_COUNTER_MAX];
+    uint64_t last[QCNODE_PERF_COUNTER_MAX];
+} QCNodePerfCounters_t;
+
+/**
+ * @brief Sample the perf_event_open counters around a node execution.
+ *
+ * The counters are opened as one group for the thread calling Begin, and are reopened only when
+ * the calling thread changes. On platforms without perf_event_open, Init returns
+ * QC_STATUS_UNSUPPORTED and Begin/End do nothing.
+ *
+ * @example
+ *   QCStatus_e ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc ) {
+ *       m_perfCounters.Begin();
+ *       ...
+ *       m_perfCounters.End();
+ *       QC_TRACE_COUNTER( "PerfCounters", m_perfCounters.GetTraceArgs() );
+ *   }
+ */
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    /**
+     * @brief Enable the performance counters sampling.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if perf_event_open is not supported.
+     */
+    QCStatus_e Init();
+
+    /**
+     * @brief Disable the performance counters sampling and close the counters.
+     * @return QC_STATUS_OK on success, others on failure.
+     */
+    QCStatus_e Deinit();
+
+    /**
+     * @brief Check if the performance counters sampling is enabled.
+     * @return true if enabled.
+     */
+    bool IsEnabled();
+
+    /**
+     * @brief Reset and start the counters of the calling thread.
+     */
+    void Begin();
+
+    /**
+     * @brief Stop the counters of the calling thread and accumulate the values.
+     */
+    void End();
+
+    /**
+     * @brief Get a copy of the aggregated counters.
+     * @param[out] counters The aggregated counters.
+     */
+    void Get( QCNodePerfCounters_t &counters );
+
+    /**
+     * @brief Reset the aggregated counters.
+     */
+    void Reset();
+
+    /**
+     * @brief Get the counters of the last sampled execution as NodeTrace counter arguments.
+     * @return The list of NodeTrace arguments.
+     */
+    std::vector<QCNodeTraceArg_t> GetTraceArgs();
+
+    /**
+     * @brief Get the name of a counter.
+     * @param[in] type The counter type.
+     * @return The counter name.
+     */
+    static const char *GetName( QCNodePerfCounterType_e type );
+
+private:
+    QCStatus_e Open();
+    void Close();
+
+private:
+    bool m_bEnabled = false;
+    bool m_bStarted = false;
+    int64_t m_tid = -1;
+    int m_fds[QCNODE_PERF_COUNTER_MAX];
+    uint32_t m_numOpened = 0;
+    QCNodePerfCounterType_e m_openedTypes[QCNODE_PERF_COUNTER_MAX];
+    std::mutex m_lock;
+    QCNodePerfCounters_t m_counters;
+};
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QCNODE_PERF_COUNTERS_HPP
@@ -46,9 +46,22 @@ typedef enum
     CL2DFLEX_WORK_MODE_CONVERT_UBWC,  /**<convert from ubwc compress format to normal format*/
     CL2DFLEX_WORK_MODE_REMAP_NEAREST, /**<color convert and remap using nearest point in map table
                                          to do undistortion*/
+    CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE,    /**<color convert, resize use nearest point, normalize
+                                               and quantize into a tensor with one kernel*/
+    CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE, /**<color convert, letterbox with fixed height/width
+                                               ratio use nearest point, normalize and quantize
+                                               into a tensor with one kernel*/
     CL2DFLEX_WORK_MODE_MAX
 } CL2DFlex_Work_Mode_e;
 
+/** @brief CL2DFlex tensor layouts for the normalize work modes */
+typedef enum
+{
+    CL2DFLEX_TENSOR_LAYOUT_NHWC, /**<tensor dims [N, H, W, 3], the channels of a pixel are packed*/
+    CL2DFLEX_TENSOR_LAYOUT_NCHW, /**<tensor dims [N, 3, H, W], each channel is a plane*/
+    CL2DFLEX_TENSOR_LAYOUT_MAX
+} CL2DFlex_Tensor_Layout_e;
+
 /** @brief remap tables for input images */
 typedef struct
 {
@@ -70,6 +83,9 @@ typedef struct
                         than input height*/
 } CL2DFlex_ROIConfig_t;
 
+/** @brief The max number of ROIs of the multiple ROI work modes */
+#define QC_CL2DFLEX_ROI_NUMBER_MAX 100
+
 /** @brief CL2DFlex component configuration */
 typedef struct
 {
@@ -94,9 +110,39 @@ typedef struct
     OpenclIfcae_Perf_e priority =
             OPENCLIFACE_PERF_NORMAL; /**<OpenCL performance priority level, default set to normal*/
     uint32_t deviceId = 0;           /**<OpenCL device ID, default set to 0*/
+    float normalizeMean[3] = { 0.0f, 0.0f, 0.0f }; /**<the R,G,B mean subtracted by the normalize
+                                                      work modes, in 0-255 pixel units*/
+    float normalizeStd[3] = { 1.0f, 1.0f, 1.0f };  /**<the R,G,B standard deviation divided by the
+                                                      normalize work modes, in 0-255 pixel units*/
+    CL2DFlex_Tensor_Layout_e tensorLayout =
+            CL2DFLEX_TENSOR_LAYOUT_NHWC; /**<the output tensor layout of the normalize work modes*/
 
 } CL2DFlex_Config_t;
 
+/**
+ * @brief The input image of the multiple ROI work modes with the ROIs of the frame.
+ *
+ * Set it as the input buffer of the frame descriptor instead of an ImageDescriptor to crop and
+ * resize or letterbox other ROIs of each frame, such as the boxes of tracked objects, without
+ * reconfiguring the node. The ROI i is written into the image i of the output. The ROIs of the
+ * frame are passed to the kernel by value, up to 32 ROIs per kernel dispatch, so more ROIs take
+ * one dispatch per 32 ROIs.
+ *
+ * New Members:
+ * @param numOfROIs The number of ROIs of the frame, up to the numOfROIs of the configuration, 0
+ * to use the ROIs buffer given by ROIsBufferId.
+ * @param ROIs The ROIs of the frame, each inside the input image and not empty.
+ * @note The output images after the numOfROIs images are not written.
+ */
+typedef struct CL2DFlex_ROIImageDescriptor : public ImageDescriptor_t
+{
+public:
+    CL2DFlex_ROIImageDescriptor() : ImageDescriptor_t(), numOfROIs( 0 ) {}
+    using ImageDescriptor_t::operator=;
+    uint32_t numOfROIs;
+    CL2DFlex_ROIConfig_t ROIs[QC_CL2DFLEX_ROI_NUMBER_MAX];
+} CL2DFlex_ROIImageDescriptor_t;
+
 /**
  * @brief Represents the CL2DFlex implementation used by CL2DFlexConfig, CL2DFlexMonitor, and Node
  * CL2DFlex.
@@ -161,7 +207,8 @@ public:
      *              "roiHeight": "The input roiHeight, type: uint32_t",
      *              "workMode": "The input work mode, type: string,
      *                          options: [convert, resize_nearest, letterbox_nearest, convert_ubwc,
-     *                          letterbox_nearest_multiple, resize_nearest_multiple, remap_nearest]"
+     *                          letterbox_nearest_multiple, resize_nearest_multiple, remap_nearest,
+     *                          resize_normalize, letterbox_normalize]"
      *              "mapXBufferId": "The buffer id of X direction map table, type: uint32_t",
      *              "mapYBufferId": "The buffer id of Y direction map table, type: uint32_t"
      *           }
@@ -177,14 +224,79 @@ public:
      *           }
      *        ],
      *        "deRegisterAllBuffersWhenStop": "Flag to deregister all buffers when stopped,
-     *                   type: bool, default: false"
+     *                   type: bool, default: false",
+     *        "batched": "Flag to process the inputs of the same work mode with one kernel
+     *                   dispatch, type: bool, default: false",
+     *        "normalizeMean": [The R,G,B mean in 0-255 pixel units, type: float,
+     *                          default: [0, 0, 0]],
+     *        "normalizeStd": [The R,G,B standard deviation in 0-255 pixel units, type: float,
+     *                         default: [1, 1, 1]],
+     *        "tensorLayout": "The output tensor layout, type: string, options: [nhwc, nchw],
+     *                         default: nhwc",
+     *        "processorType": "The processor running the pipelines, type: string,
+     *                          options: [gpu, cpu], default: gpu",
+     *        "cpuThreads": "The number of threads of the cpu processor, type: uint32_t,
+     *                       default: 0",
+     *        "sharedContext": "The name of the OpenCL context shared with other GPU nodes,
+     *                          type: string, default: \"\"",
+     *        "notifyOnEnqueue": "Flag to call the callback once the frame is enqueued to the
+     *                            shared context, type: bool, default: false",
+     *        "queueName": "The name of the OpenCL command queue in the shared context,
+     *                      type: string, default: \"\"",
+     *        "queuePriority": "The priority hint of the command queue, type: string,
+     *                          options: [low, normal, high], default: normal",
+     *        "queueThrottle": "The throttle hint of the command queue, type: string,
+     *                          options: [low, normal, high], default: normal",
+     *        "outOfOrder": "Flag to execute the kernels of the inputs out of order,
+     *                       type: bool, default: false",
+     *        "tuningPath": "The path of the database of the tuned local work sizes,
+     *                       type: string, default: \"\"",
+     *        "tuneWorkGroups": "Flag to tune the kernels missing from the database at their
+     *                           first run, type: bool, default: false",
+     *        "gpuProfiling": "Flag to record the GPU timestamps of the kernels, type: bool,
+     *                         default: false",
+     *        "programCacheDir": "The directory of the cached OpenCL program binaries,
+     *                            type: string, default: \"\""
      *     }
      *   }
      * @note: priority is optional, default set to normal.
      *        deviceId is optional, default set to 0.
      *        mapXBufferId and mapYBufferId are optional, only used for remap_nearest work mode.
      *        numOfROIs and ROIsBufferId are optional, only used for resize_nearest_multiple and
-     *        letterbox_nearest_multiple work mode.
+     *        letterbox_nearest_multiple work mode, ROIsBufferId may be omitted when every frame
+     *        gives its ROIs with a CL2DFlex_ROIImageDescriptor_t input.
+     *        batched applies to the nv12 inputs of the convert, resize_nearest and
+     *        letterbox_nearest work modes with the rgb output, up to 8 inputs per dispatch, the
+     *        other inputs are processed one by one.
+     *        normalizeMean, normalizeStd and tensorLayout are optional, only used for
+     *        resize_normalize and letterbox_normalize work modes, which are used by all the inputs
+     *        or none of them, the output is then a tensor of one image per input, in the R,G,B
+     *        order for the rgb output format or B,G,R for bgr. The value written is
+     *        (pixel - mean) / std, quantized with the tensor quantScale and quantOffset for the
+     *        fixed point tensor types.
+     *        processorType and cpuThreads are optional, the cpu processor runs the convert,
+     *        resize_nearest, letterbox_nearest, the multiple and remap_nearest work modes on
+     *        cpuThreads threads, the calling thread included, 0 for one thread per core, and the
+     *        frame is done when ProcessFrameDescriptor returns.
+     *        sharedContext and notifyOnEnqueue are optional, the nodes with the same
+     *        sharedContext use one OpenCL context, and a node waits on the GPU for the kernels
+     *        writing its inputs instead of on the host. With notifyOnEnqueue the callback is
+     *        called once the frame is enqueued, so its output must only be read by GPU nodes of
+     *        the same sharedContext.
+     *        queueName, queuePriority, queueThrottle and outOfOrder are optional, the nodes of a
+     *        sharedContext with the same queueName use one command queue with the same hints, the
+     *        queues of different names run concurrently. On an out-of-order queue the kernels of
+     *        the inputs of a frame may overlap, the frames still run one after the other. A hint
+     *        or the out-of-order mode not supported by the device is ignored.
+     *        tuningPath and tuneWorkGroups are optional, the kernels use the local work size
+     *        tuned for their global work size in the database instead of the driver choice. With
+     *        tuneWorkGroups, a kernel missing from the database is timed with the candidate local
+     *        work sizes at its first run and the fastest is saved, which delays that frame.
+     *        gpuProfiling is optional, the kernels are timed on the GPU, the profile by kernel is
+     *        placed by the monitoring interface and each launch is traced as a "GpuKernel" event.
+     *        It is ignored with a warning on a queue of the sharedContext created without it.
+     *        programCacheDir is optional, the program binary built for the device is saved there
+     *        and loaded by the later runs instead of building the source again.
      * @return QC_STATUS_OK on success, other values on failure.
      */
     virtual QCStatus_e VerifyAndSet( const std::string config, std::string &errors );
@@ -242,11 +354,27 @@ public:
 
     virtual const QCNodeMonitoringBase_t &Get() { return m_monitorConfig; }
 
-    virtual uint32_t GetMaximalSize() { return UINT32_MAX; }
-    virtual uint32_t GetCurrentSize() { return UINT32_MAX; }
+    /**
+     * @brief Get the maximal size of the monitoring data in bytes.
+     * @return The size of QCNodeGpuProfile_t.
+     */
+    virtual uint32_t GetMaximalSize();
 
+    /**
+     * @brief Get the current size of the monitoring data in bytes.
+     * @return The size of QCNodeGpuProfile_t if gpuProfiling is set, 0 otherwise.
+     */
+    virtual uint32_t GetCurrentSize();
 
-    virtual QCStatus_e Place( void *ptr, uint32_t &size ) { return QC_STATUS_UNSUPPORTED; }
+    /**
+     * @brief Place the GPU profile of the kernels aggregated by kernel name.
+     * @param[in] ptr Pointer to the data to be placed, of type QCNodeGpuProfile_t.
+     * @param[in, out] size The size of the buffer ptr and returns the actual size of the placed
+     * data.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if gpuProfiling is not set or the
+     * processorType is cpu, other values on failure.
+     */
+    virtual QCStatus_e Place( void *ptr, uint32_t &size );
 
 private:
     CL2DFlexImpl *m_pCL2DFlexImpl;
@@ -274,6 +402,9 @@ public:
      * @brief Initializes Node CL2DFlex.
      * @param[in] config The Node CL2DFlex configuration.
      * @note QCNodeInit::config - Refer to the comments of the API CL2DFlexConfig::VerifyAndSet.
+     * @note QCNodeInit::callback - The user application callback to notify the status of
+     * the API ProcessFrameDescriptor. This is optional. If provided, the API ProcessFrameDescriptor
+     * will be asynchronous; otherwise, the API ProcessFrameDescriptor will be synchronous.
      * @note QCNodeInit::buffers - Buffers provided by the user application. The buffers can be
      * provided for the following purposes:
      * - 1. A buffer provided to store the mapping tables for remap work mode.
@@ -310,6 +441,11 @@ public:
      * - ...
      * - The globalBufferIdMap[N-1].globalBufferId of QCFrameDescriptorNodeIfs will be input N-1.
      * - The globalBufferIdMap[N].globalBufferId of QCFrameDescriptorNodeIfs will be output.
+     * @note The kernels of all the inputs are enqueued back-to-back to the GPU. If the
+     * QCNodeInit::callback is provided, this call returns once they are enqueued, and the callback
+     * is invoked from an OpenCL event callback thread when they are done, the frame descriptor
+     * must be kept valid until then. Up to 8 frames can be in flight. If the QCNodeInit::callback
+     * is not provided, this call returns when the output is ready.
      * @return QC_STATUS_OK on success, or an error code on failure.
      */
     virtual QCStatus_e ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc );
@@ -121,8 +121,14 @@ public:
      *              "id": "The index to a buffer in QCFrameDescriptorNodeIfs"
      *           }
      *        ],
+     *        "registerBuffersAtStart": "Registers the buffers of bufferIds in bulk in the
+     *                   background when started instead of during the initialization,
+     *                   type: bool, default: false",
      *        "deRegisterAllBuffersWhenStop": "Flag to deregister all buffers when stopped,
      *                   type: bool, default: false",
+     *        "reRegisterBuffersWhenStart": "Registers the buffers deregistered when stopped
+     *                   again in bulk in the background when started, requires
+     *                   deRegisterAllBuffersWhenStop, type: bool, default: false",
      *        "perfProfile": "Specifies perf profile to set, type: string,
      *                  options: [ low_balanced, balanced, default, high_performance,
      *                             sustained_high_performance, burst, low_power_saver,
@@ -130,13 +136,45 @@ public:
      *                  default: default",
      *        "weightSharingEnabled": "Enables weight sharing, type: bool, default: false",
      *        "extendedUdma": "Activates extended UDMA support, type: bool, default: false",
+     *        "graphs": [ A list of the names of the graphs to execute for each frame, in order,
+     *                    an input named as an output of a previous graph is chained to it ],
+     *                  default: [ the first graph ],
+     *        "parallelGraphs": "Submits the independent graphs together in asynchronous mode,
+     *                   type: bool, default: false",
+     *        "strictValidation": "Validates every buffer on every frame instead of only on
+     *                   its first use, type: bool, default: false",
+     *        "inFlightDepth": "The max number of frames in flight in asynchronous mode,
+     *                   type: uint32_t, range: [1, 8], default: 8",
+     *        "targetLatency": "The target frame latency in microseconds, the HTP perf
+     *                   profile is governed by the measured latency if not 0, the execution
+     *                   time profiled by the backend when the perf is enabled, type: uint32_t,
+     *                   default: 0",
+     *        "minPerfProfile": "The lowest perf profile of the governor, type: string,
+     *                   options: the perfProfile options but default, default: power_saver",
+     *        "maxPerfProfile": "The highest perf profile of the governor, type: string,
+     *                   options: the perfProfile options but default, default: burst",
+     *        "governorWindow": "The number of frames averaged by the governor, type: uint32_t,
+     *                   range: [1, 1024], default: 16",
+     *        "warmupFrames": "The number of dummy executions of each graph on scratch tensors
+     *                   at Start, their median latency is the baseline of the graph given by
+     *                   the QnnMonitor options, type: uint32_t, range: [0, 100], default: 0",
+     *        "batchSlices": [
+     *           {
+     *              "name": "The name of a batched model tensor, type: string",
+     *              "ids": [ The indices of the per-batch tensor views of one buffer in
+     *                       QCFrameDescriptorNodeIfs, in batch order, bound together as the
+     *                       batched tensor without a copy ]
+     *           }
+     *        ],
      *     }
      *   }
      *   @note: The udoPackages is a list and is optional.
      * 2. Dynamic configuration used to change some runtime parameters:
      *   {
      *     "dynamic": {
-     *        "enablePerf": "enable performance profiling, type: bool"
+     *        "enablePerf": "enable performance profiling, type: bool",
+     *        "activeGraphs": [ A list of the names of the configured graphs to execute for the
+     *                          following frames, empty for all the configured graphs ]
      *     }
      *   }
      * @return QC_STATUS_OK on success, other values on failure.
@@ -158,7 +196,6 @@ public:
     virtual const QCNodeConfigBase_t &Get();
 
 private:
-    QCStatus_e VerifyStaticConfig( DataTree &dt, std::string &errors );
     QCStatus_e ParseStaticConfig( DataTree &dt, std::string &errors );
     QCStatus_e ApplyDynamicConfig( DataTree &dt, std::string &errors );
 
@@ -189,6 +226,24 @@ public:
 
     virtual QCStatus_e VerifyAndSet( const std::string config, std::string &errors );
 
+    /**
+     * @brief Gets the latency baselines calibrated by the warm-up of the last Start.
+     * @return A JSON string, "{}" if the node was started without warmupFrames:
+     *   {
+     *     "baselines": [
+     *       {
+     *         "graph": "The graph name, type: string",
+     *         "frames": "The number of warm-up executions, type: uint32_t",
+     *         "wallTime": "The median wall clock time in microseconds, type: uint64_t",
+     *         "entireExecTime": "The Qnn_Perf_t times of the median execution, 0 if the
+     *                            backend does not profile them, type: uint64_t",
+     *         "rpcExecTimeCPU": type: uint64_t,
+     *         "rpcExecTimeHTP": type: uint64_t,
+     *         "rpcExecTimeAcc": type: uint64_t
+     *       }
+     *     ]
+     *   }
+     */
     virtual const std::string &GetOptions();
 
     virtual const QCNodeMonitoringBase_t &Get();
@@ -288,6 +343,9 @@ public:
      * - The globalBufferIdMap[N+M].globalBufferId of QCFrameDescriptorNodeIfs will be the
      *   slot for error data information if QNN asynchronous mode is used with the callback
      *   specified.
+     * @note A tensor configured in batchSlices is bound from the buffers batchSlices.ids instead,
+     * they must be views of one buffer at consecutive offsets, such as those given by
+     * TensorDescriptor::GetTensorDesc.
      * @note This API is not thread-safe. Avoid calling the ProcessFrameDescriptor API
      * on the same instance from multiple threads simultaneously.
      * @return QC_STATUS_OK on success, or an error code on failure.
@@ -300,6 +358,31 @@ public:
      */
     virtual QCStatus_e Stop();
 
+    /**
+     * @brief Registers buffers into QNN ahead of their first frame.
+     *
+     * The buffers not registered yet, such as all the buffers of a pool, are registered together
+     * by one memRegister call, so that the frames do not pay for the registration of new buffers.
+     *
+     * @param[in] buffers The buffers to register, only the tensor buffers are registered.
+     * @param[in] bAsync If true, the buffers are registered by a background thread and the call
+     * returns immediately, the frames may be processed meanwhile.
+     * @note The node must be initialized. The memory of the buffers must stay valid until they are
+     * registered.
+     * @return QC_STATUS_OK on success; other status codes indicate failure.
+     */
+    QCStatus_e
+    RegisterBuffers( std::vector<std::reference_wrapper<QCBufferDescriptorBase_t>> &buffers,
+                     bool bAsync = true );
+
+    /**
+     * @brief Waits for the background buffer registration to be done.
+     * @param[in] timeoutMs The max time to wait in milliseconds.
+     * @return QC_STATUS_OK if all the buffers are registered, QC_STATUS_TIMEOUT if the registration
+     * is still going on, or the error of a failed registration since the last wait.
+     */
+    QCStatus_e WaitBuffersRegistered( uint32_t timeoutMs );
+
     /**
      * @brief De-initializes the QNN Node and releases associated resources.
      *
@@ -4,6 +4,7 @@
 #ifndef QC_NODE_RADAR_HPP
 #define QC_NODE_RADAR_HPP
 
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
 #include "QC/Node/NodeBase.hpp"
 #include "QC/component/Radar.hpp"
 
@@ -22,6 +23,7 @@ using namespace QC::component;
  * QCFrameDescriptorNodeIfs is used for Radar input and output.
  * @param deRegisterAllBuffersWhenStop When the Stop API of the Radar node is called and
  * deRegisterAllBuffersWhenStop is true, deregister all buffers.
+ * @param bEnablePerfCounters Sample the CPU performance counters around each execution.
  */
 typedef struct RadarConfig : public QCNodeConfigBase_t
 {
@@ -29,6 +31,7 @@ typedef struct RadarConfig : public QCNodeConfigBase_t
     std::vector<uint32_t> bufferIds;
     std::vector<QCNodeBufferMapEntry_t> globalBufferIdMap;
     bool bDeRegisterAllBuffersWhenStop;
+    bool bEnablePerfCounters;
 } RadarConfig_t;
 
 class RadarConfigIfs : public NodeConfigIfs
@@ -71,7 +74,9 @@ public:
      *           }
      *        ],
      *        "deRegisterAllBuffersWhenStop": "Flag to deregister all buffers when stopped,
-     *                   type: bool, default: false"
+     *                   type: bool, default: false",
+     *        "enablePerfCounters": "Flag to sample the CPU performance counters around each
+     *                   execution, type: bool, default: false"
      *     }
      *   }
      * @return QC_STATUS_OK on success, other values on failure.
@@ -110,7 +115,12 @@ typedef struct RadarMonitorConfig : public QCNodeMonitoringBase_t
 class RadarMonitoringIfs : public QCNodeMonitoringIfs
 {
 public:
-    RadarMonitoringIfs() {}
+    /**
+     * @brief RadarMonitoringIfs Constructor
+     * @param[in] perfCounters A reference to the performance counters of the Radar node.
+     * @return None
+     */
+    RadarMonitoringIfs( PerfCounters &perfCounters ) : m_perfCounters( perfCounters ) {}
     ~RadarMonitoringIfs() {}
 
     virtual QCStatus_e VerifyAndSet( const std::string config, std::string &errors )
@@ -122,14 +132,48 @@ public:
 
     virtual const QCNodeMonitoringBase_t &Get() { return m_config; };
 
-    virtual uint32_t GetMaximalSize() { return UINT32_MAX; }
-    virtual uint32_t GetCurrentSize() { return UINT32_MAX; }
+    virtual uint32_t GetMaximalSize() { return sizeof( QCNodePerfCounters_t ); }
+    virtual uint32_t GetCurrentSize()
+    {
+        return m_perfCounters.IsEnabled() ? sizeof( QCNodePerfCounters_t ) : 0;
+    }
 
-    virtual QCStatus_e Place( void *ptr, uint32_t &size ) { return QC_STATUS_UNSUPPORTED; }
+    /**
+     * @brief Places the Radar performance counters into a user-provided buffer.
+     * @param[in] ptr The user-provided buffer of type QCNodePerfCounters_t.
+     * @param[inout] size The size of the buffer ptr and returns the actual size of the placed data.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if the performance counters are not
+     * enabled, or an error code on failure.
+     */
+    virtual QCStatus_e Place( void *ptr, uint32_t &size )
+    {
+        QCStatus_e status = QC_STATUS_OK;
+
+        if ( nullptr == ptr )
+        {
+            status = QC_STATUS_NULL_PTR;
+        }
+        else if ( size < sizeof( QCNodePerfCounters_t ) )
+        {
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( false == m_perfCounters.IsEnabled() )
+        {
+            status = QC_STATUS_UNSUPPORTED;
+        }
+        else
+        {
+            m_perfCounters.Get( *static_cast<QCNodePerfCounters_t *>( ptr ) );
+            size = sizeof( QCNodePerfCounters_t );
+        }
+
+        return status;
+    }
 
 private:
     std::string m_options;
     RadarMonitorConfig_t m_config;
+    PerfCounters &m_perfCounters;
 };
 
 class Radar : public NodeBase
@@ -139,7 +183,7 @@ public:
      * @brief Radar Constructor
      * @return None
      */
-    Radar() : m_configIfs( m_logger, m_radar ){};
+    Radar() : m_configIfs( m_logger, m_radar ), m_monitorIfs( m_perfCounters ){};
 
     /**
      * @brief Radar Destructor
@@ -209,6 +253,7 @@ private:
 
 private:
     QC::component::Radar m_radar;
+    PerfCounters m_perfCounters;
     RadarConfigIfs m_configIfs;
     RadarMonitoringIfs m_monitorIfs;
     bool m_bDeRegisterAllBuffersWhenStop = false;
@@ -5,6 +5,7 @@
 #define QC_NODE_REMAP_HPP
 
 #include "FadasRemap.hpp"
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
 #include "QC/Node/NodeBase.hpp"
 
 namespace QC
@@ -153,7 +154,9 @@ public:
      *           }
      *        ],
      *        "deRegisterAllBuffersWhenStop": "Flag to deregister all buffers when stopped,
-     *                   type: bool, default: false"
+     *                   type: bool, default: false",
+     *        "enablePerfCounters": "Flag to sample the CPU performance counters around each
+     *                   execution, type: bool, default: false"
      *     }
      *   }
      * @note: mapXBufferId and mapYBufferId are optional,
@@ -218,11 +221,19 @@ public:
 
     virtual const QCNodeMonitoringBase_t &Get() { return m_monitorConfig; }
 
-    virtual uint32_t GetMaximalSize() { return UINT32_MAX; }
-    virtual uint32_t GetCurrentSize() { return UINT32_MAX; }
+    virtual uint32_t GetMaximalSize();
+    virtual uint32_t GetCurrentSize();
 
-
-    virtual QCStatus_e Place( void *ptr, uint32_t &size ) { return QC_STATUS_UNSUPPORTED; }
+    /**
+     * @brief Places the Remap performance counters into a user-provided buffer.
+     * @param[in] pData The user-provided buffer to store the performance counters.
+     * @param[inout] size The size of the buffer pData and returns the actual size of the placed
+     * data.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if enablePerfCounters is not set,
+     * or an error code on failure.
+     * @note pData is of type QCNodePerfCounters_t.
+     */
+    virtual QCStatus_e Place( void *pData, uint32_t &size );
 
 private:
     RemapImpl *m_pRemapImpl;
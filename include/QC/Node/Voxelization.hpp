@@ -4,6 +4,8 @@
 #ifndef QC_NODE_VOXELIZATION_HPP
 #define QC_NODE_VOXELIZATION_HPP
 
+#include "QC/Infras/NodeTrace/GpuProfile.hpp"
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
 #include "QC/Node/NodeBase.hpp"
 
 namespace QC
@@ -106,7 +108,27 @@ public:
      *            }
      *         ],
      *         "deRegisterAllBuffersWhenStop": "Flag to deregister all buffers when stopped,
-     *                                         type: bool, default: false"
+     *                                         type: bool, default: false",
+     *         "enablePerfCounters": "Flag to sample the CPU performance counters around each
+     *                               execution of the cpu processor, type: bool,
+     *                               default: false",
+     *         "programCacheDir": "The directory of the OpenCL program binary cache, empty to
+     *                            disable it, type: string, default: \"\"",
+     *         "priority": "The performance priority level of the OpenCL context, type: string,
+     *                     options: [low, normal, high], default: normal",
+     *         "deviceId": "The index of the OpenCL device, type: uint32_t, default: 0",
+     *         "sharedContext": "The name of the OpenCL context shared with other GPU nodes,
+     *                          empty to use a private context, type: string, default: \"\"",
+     *         "queueName": "The name of the OpenCL command queue in the shared context,
+     *                      type: string, default: \"\"",
+     *         "queuePriority": "The priority hint of the command queue, type: string,
+     *                          options: [low, normal, high], default: normal",
+     *         "queueThrottle": "The throttle hint of the command queue, type: string,
+     *                          options: [low, normal, high], default: normal",
+     *         "outOfOrder": "Flag to create an out-of-order command queue, type: bool,
+     *                       default: false",
+     *         "gpuProfiling": "Flag to record the GPU timestamps of the kernels, type: bool,
+     *                         default: false"
      *     }
      * }
      * @endcode
@@ -114,6 +136,8 @@ public:
      * @note: 
      * plrPointsBufferId and coordToPlrIdxBufferId is only needed while the processorType is gpu.
      * globalBufferIdMap is optional. If not set, this config will be set to default.
+     * gpuProfiling is only used while the processorType is gpu, the profile of the kernels is
+     * placed by the monitoring interface and each launch is traced as a "GpuKernel" event.
      */
     virtual QCStatus_e VerifyAndSet( const std::string config, std::string &errors );
 
@@ -192,22 +216,27 @@ public:
      * @brief Get the maximal size of the monitoring data in bytes.
      * @return The maximal size of the monitoring data in bytes.
      */
-    virtual inline uint32_t GetMaximalSize() { return 0; }
+    virtual uint32_t GetMaximalSize();
 
     /**
      * @brief Get the current size of the monitoring data in bytes.
      * @return The current size of the monitoring data in bytes.
      */
-    virtual inline uint32_t GetCurrentSize() { return 0; }
+    virtual uint32_t GetCurrentSize();
 
     /**
-     * @brief Place monitoring data.
-     * This method places the monitoring data. Currently, this functionality is unsupported.
-     * @param[in] pData Pointer to the data to be placed.
-     * @param[in, out] size The size of the data to be placed.
-     * @return QC_STATUS_UNSUPPORTED as this functionality is not supported.
-     */
-    virtual QCStatus_e Place( void *pData, uint32_t &size ) { return QC_STATUS_UNSUPPORTED; }
+     * @brief Place monitoring data.
+     * This method places the performance counters sampled around each execution of the cpu
+     * processor, or the GPU profile of the kernels of the gpu processor.
+     * @param[in] pData Pointer to the data to be placed, a QCNodePerfCounters_t if
+     * enablePerfCounters is set on the cpu processor and supported, or a QCNodeGpuProfile_t if
+     * gpuProfiling is set on the gpu processor.
+     * @param[in, out] size The size of the buffer pData and returns the actual size of the placed
+     * data.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if neither enablePerfCounters nor
+     * gpuProfiling is set, other values on failure.
+     */
+    virtual QCStatus_e Place( void *pData, uint32_t &size );
 
 private:
     VoxelizationImpl *m_pVoxelImpl;
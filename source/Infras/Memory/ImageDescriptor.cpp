@@ -209,7 +209,7 @@ QCStatus_e ImageDescriptor::GetImageDesc( ImageDescriptor &imageDesc, uint32_t b
         QC_LOG_ERROR( "buffer batch offset %u(>=%u) out of range", batchOffset, this->batchSize );
         status = QC_STATUS_BAD_ARGUMENTS;
     }
-    else if ( ( batchOffset + batchSize ) >= this->batchSize )
+    else if ( ( batchOffset + batchSize ) > this->batchSize )
     {
         QC_LOG_ERROR( "buffer batch size %u out of range", batchSize );
         status = QC_STATUS_BAD_ARGUMENTS;
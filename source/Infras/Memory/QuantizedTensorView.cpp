@@ -0,0 +1,462 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#include "QC/Infras/Memory/QuantizedTensorView.hpp"
+#include "QC/Infras/Log/Logger.hpp"
+
+#include <cmath>
+
+#if defined( __ARM_NEON ) && defined( __aarch64__ )
+#include <arm_neon.h>
+#define QC_QUANT_VIEW_NEON
+#elif defined( __x86_64__ ) && defined( __GNUC__ )
+#include <immintrin.h>
+/* the build targets any x86-64 cpu, only the functions of the AVX2 path are compiled for AVX2,
+ * and the path is taken when the cpu has it */
+#define QC_QUANT_VIEW_AVX2
+#define QC_QUANT_VIEW_AVX2_TARGET __attribute__( ( target( "avx2" ) ) )
+#endif
+
+namespace QC
+{
+namespace Memory
+{
+
+#if defined( QC_QUANT_VIEW_NEON )
+/* widen 8 quantized values to 2 x 4 int32 lanes */
+static inline void Load8( const uint8_t *p, int32x4_t &lo, int32x4_t &hi )
+{
+    uint16x8_t v = vmovl_u8( vld1_u8( p ) );
+    lo = vreinterpretq_s32_u32( vmovl_u16( vget_low_u16( v ) ) );
+    hi = vreinterpretq_s32_u32( vmovl_u16( vget_high_u16( v ) ) );
+}
+
+static inline void Load8( const int8_t *p, int32x4_t &lo, int32x4_t &hi )
+{
+    int16x8_t v = vmovl_s8( vld1_s8( p ) );
+    lo = vmovl_s16( vget_low_s16( v ) );
+    hi = vmovl_s16( vget_high_s16( v ) );
+}
+
+static inline void Load8( const uint16_t *p, int32x4_t &lo, int32x4_t &hi )
+{
+    uint16x8_t v = vld1q_u16( p );
+    lo = vreinterpretq_s32_u32( vmovl_u16( vget_low_u16( v ) ) );
+    hi = vreinterpretq_s32_u32( vmovl_u16( vget_high_u16( v ) ) );
+}
+
+static inline void Load8( const int16_t *p, int32x4_t &lo, int32x4_t &hi )
+{
+    int16x8_t v = vld1q_s16( p );
+    lo = vmovl_s16( vget_low_s16( v ) );
+    hi = vmovl_s16( vget_high_s16( v ) );
+}
+#elif defined( QC_QUANT_VIEW_AVX2 )
+/* widen 8 quantized values to 8 int32 lanes */
+QC_QUANT_VIEW_AVX2_TARGET static inline __m256i Load8( const uint8_t *p )
+{
+    return _mm256_cvtepu8_epi32( _mm_loadl_epi64( (const __m128i *) p ) );
+}
+
+QC_QUANT_VIEW_AVX2_TARGET static inline __m256i Load8( const int8_t *p )
+{
+    return _mm256_cvtepi8_epi32( _mm_loadl_epi64( (const __m128i *) p ) );
+}
+
+QC_QUANT_VIEW_AVX2_TARGET static inline __m256i Load8( const uint16_t *p )
+{
+    return _mm256_cvtepu16_epi32( _mm_loadu_si128( (const __m128i *) p ) );
+}
+
+QC_QUANT_VIEW_AVX2_TARGET static inline __m256i Load8( const int16_t *p )
+{
+    return _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i *) p ) );
+}
+
+/* the elements in blocks of 8, returns the number of elements done */
+template<typename T>
+QC_QUANT_VIEW_AVX2_TARGET static size_t DequantizeBlockAvx2( const T *pIn, size_t count,
+                                                             float scale, int32_t offset,
+                                                             float *pOut )
+{
+    size_t i = 0;
+    __m256i vOffset = _mm256_set1_epi32( offset );
+    __m256 vScale = _mm256_set1_ps( scale );
+
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        __m256i v = _mm256_add_epi32( Load8( pIn + i ), vOffset );
+        _mm256_storeu_ps( pOut + i, _mm256_mul_ps( _mm256_cvtepi32_ps( v ), vScale ) );
+    }
+
+    return i;
+}
+
+/* the consecutive elements in blocks of 8, returns the number of elements done */
+template<typename T>
+QC_QUANT_VIEW_AVX2_TARGET static size_t SelectBlockAvx2( const T *pIn, size_t start, size_t count,
+                                                         int32_t rawThreshold,
+                                                         std::vector<uint32_t> &indices )
+{
+    size_t i = 0;
+    __m256i vThreshold = _mm256_set1_epi32( rawThreshold - 1 );
+
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        __m256i pass = _mm256_cmpgt_epi32( Load8( pIn + start + i ), vThreshold );
+        int mask = _mm256_movemask_ps( _mm256_castsi256_ps( pass ) );
+        for ( size_t j = i; 0 != mask; j++, mask >>= 1 )
+        {
+            if ( 0 != ( mask & 1 ) )
+            {
+                indices.push_back( (uint32_t) ( start + j ) );
+            }
+        }
+    }
+
+    return i;
+}
+
+/* the cpu features are read once, also when called by a static constructor */
+static bool HasAvx2()
+{
+    static const bool s_bAvx2 = []() {
+        __builtin_cpu_init();
+        return ( 0 != __builtin_cpu_supports( "avx2" ) );
+    }();
+
+    return s_bAvx2;
+}
+#endif
+
+template<typename T>
+static void DequantizeBlock( const T *pIn, size_t count, float scale, int32_t offset, float *pOut )
+{
+    size_t i = 0;
+
+    /* the vector path computes ( q + offset ) * scale in the same order as the scalar path, so
+     * both give the same bits */
+#if defined( QC_QUANT_VIEW_NEON )
+    int32x4_t vOffset = vdupq_n_s32( offset );
+    float32x4_t vScale = vdupq_n_f32( scale );
+    for ( ; i + 8 <= count; i += 8 )
+    {
+        int32x4_t lo, hi;
+        Load8( pIn + i, lo, hi );
+        vst1q_f32( pOut + i, vmulq_f32( vcvtq_f32_s32( vaddq_s32( lo, vOffset ) ), vScale ) );
+        vst1q_f32( pOut + i + 4, vmulq_f32( vcvtq_f32_s32( vaddq_s32( hi, vOffset ) ), vScale ) );
+    }
+#elif defined( QC_QUANT_VIEW_AVX2 )
+    if ( true == HasAvx2() )
+    {
+        i = DequantizeBlockAvx2( pIn, count, scale, offset, pOut );
+    }
+#endif
+
+    for ( ; i < count; i++ )
+    {
+        pOut[i] = (float) ( (int32_t) pIn[i] + offset ) * scale;
+    }
+}
+
+template<typename T>
+static void SelectBlock( const T *pIn, size_t start, size_t count, size_t stride,
+                         int32_t rawThreshold, std::vector<uint32_t> &indices )
+{
+    size_t i = 0;
+
+    if ( 1 == stride )
+    {
+        /* most of the elements of a score map are below the threshold, skip 8 at a time */
+#if defined( QC_QUANT_VIEW_NEON )
+        int32x4_t vThreshold = vdupq_n_s32( rawThreshold );
+        for ( ; i + 8 <= count; i += 8 )
+        {
+            int32x4_t lo, hi;
+            Load8( pIn + start + i, lo, hi );
+            uint32x4_t pass = vorrq_u32( vcgeq_s32( lo, vThreshold ), vcgeq_s32( hi, vThreshold ) );
+            if ( 0 != vmaxvq_u32( pass ) )
+            {
+                for ( size_t j = i; j < i + 8; j++ )
+                {
+                    if ( (int32_t) pIn[start + j] >= rawThreshold )
+                    {
+                        indices.push_back( (uint32_t) ( start + j ) );
+                    }
+                }
+            }
+        }
+#elif defined( QC_QUANT_VIEW_AVX2 )
+        if ( true == HasAvx2() )
+        {
+            i = SelectBlockAvx2( pIn, start, count, rawThreshold, indices );
+        }
+#endif
+    }
+
+    for ( ; i < count; i++ )
+    {
+        size_t index = start + i * stride;
+        if ( (int32_t) pIn[index] >= rawThreshold )
+        {
+            indices.push_back( (uint32_t) index );
+        }
+    }
+}
+
+QuantizedTensorView::QuantizedTensorView() {}
+
+QuantizedTensorView::~QuantizedTensorView() {}
+
+QCStatus_e QuantizedTensorView::Init( const TensorDescriptor_t &tensor )
+{
+    return Init( tensor, tensor.quantScale, tensor.quantOffset );
+}
+
+QCStatus_e QuantizedTensorView::Init( const TensorDescriptor_t &tensor, float scale,
+                                      int32_t offset )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    ElemType_e elemType = ELEM_TYPE_MAX;
+    size_t elemSize = 0;
+    size_t numElements = 1;
+
+    switch ( tensor.tensorType )
+    {
+        case QC_TENSOR_TYPE_UFIXED_POINT_8:
+        case QC_TENSOR_TYPE_UINT_8:
+            elemType = ELEM_TYPE_U8;
+            elemSize = sizeof( uint8_t );
+            break;
+        case QC_TENSOR_TYPE_SFIXED_POINT_8:
+        case QC_TENSOR_TYPE_INT_8:
+            elemType = ELEM_TYPE_S8;
+            elemSize = sizeof( int8_t );
+            break;
+        case QC_TENSOR_TYPE_UFIXED_POINT_16:
+        case QC_TENSOR_TYPE_UINT_16:
+            elemType = ELEM_TYPE_U16;
+            elemSize = sizeof( uint16_t );
+            break;
+        case QC_TENSOR_TYPE_SFIXED_POINT_16:
+        case QC_TENSOR_TYPE_INT_16:
+            elemType = ELEM_TYPE_S16;
+            elemSize = sizeof( int16_t );
+            break;
+        default:
+            QC_LOG_ERROR( "QuantizedTensorView: unsupported tensor type %d",
+                          (int) tensor.tensorType );
+            status = QC_STATUS_BAD_ARGUMENTS;
+            break;
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        if ( ( false == std::isfinite( scale ) ) || ( scale <= 0.0f ) )
+        {
+            QC_LOG_ERROR( "QuantizedTensorView: invalid scale %f", scale );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( ( 0 == tensor.numDims ) || ( tensor.numDims > QC_NUM_TENSOR_DIMS ) )
+        {
+            QC_LOG_ERROR( "QuantizedTensorView: invalid numDims %u", tensor.numDims );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            for ( uint32_t i = 0; i < tensor.numDims; i++ )
+            {
+                numElements *= tensor.dims[i];
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        if ( ( nullptr == tensor.GetDataPtr() ) ||
+             ( tensor.GetDataSize() < numElements * elemSize ) )
+        {
+            QC_LOG_ERROR( "QuantizedTensorView: buffer of size %" PRIu64 " too small for %" PRIu64
+                          " elements",
+                          (uint64_t) tensor.GetDataSize(), (uint64_t) numElements );
+            status = QC_STATUS_INVALID_BUF;
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        static const int32_t s_minRaw[ELEM_TYPE_MAX] = { 0, INT8_MIN, 0, INT16_MIN };
+        static const int32_t s_maxRaw[ELEM_TYPE_MAX] = { UINT8_MAX, INT8_MAX, UINT16_MAX,
+                                                         INT16_MAX };
+        m_pData = tensor.GetDataPtr();
+        m_numElements = numElements;
+        m_elemType = elemType;
+        m_minRaw = s_minRaw[elemType];
+        m_maxRaw = s_maxRaw[elemType];
+        m_scale = scale;
+        m_offset = offset;
+    }
+
+    return status;
+}
+
+QCStatus_e QuantizedTensorView::Dequantize( size_t start, size_t count, float *pOut ) const
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( ( start > m_numElements ) || ( count > m_numElements - start ) )
+    {
+        QC_LOG_ERROR( "QuantizedTensorView: block out of %" PRIu64 " elements",
+                      (uint64_t) m_numElements );
+        status = QC_STATUS_OUT_OF_BOUND;
+    }
+    else if ( nullptr == pOut )
+    {
+        status = QC_STATUS_NULL_PTR;
+    }
+    else
+    {
+        switch ( m_elemType )
+        {
+            case ELEM_TYPE_U8:
+                DequantizeBlock( (const uint8_t *) m_pData + start, count, m_scale, m_offset,
+                                 pOut );
+                break;
+            case ELEM_TYPE_S8:
+                DequantizeBlock( (const int8_t *) m_pData + start, count, m_scale, m_offset, pOut );
+                break;
+            case ELEM_TYPE_U16:
+                DequantizeBlock( (const uint16_t *) m_pData + start, count, m_scale, m_offset,
+                                 pOut );
+                break;
+            default:
+                DequantizeBlock( (const int16_t *) m_pData + start, count, m_scale, m_offset,
+                                 pOut );
+                break;
+        }
+    }
+
+    return status;
+}
+
+float QuantizedTensorView::SigmoidOf( float value )
+{
+    return 1.0f / ( 1.0f + expf( -value ) );
+}
+
+QCStatus_e QuantizedTensorView::BuildSigmoidLut()
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( ELEM_TYPE_MAX == m_elemType )
+    {
+        QC_LOG_ERROR( "QuantizedTensorView: not initialized" );
+        status = QC_STATUS_BAD_STATE;
+    }
+    else if ( ( m_lutElemType != m_elemType ) || ( m_lutScale != m_scale ) ||
+              ( m_lutOffset != m_offset ) )
+    {
+        m_sigmoidLut.resize( (size_t) ( m_maxRaw - m_minRaw + 1 ) );
+        for ( int32_t raw = m_minRaw; raw <= m_maxRaw; raw++ )
+        {
+            m_sigmoidLut[raw - m_minRaw] = SigmoidOf( RawToFloat( raw ) );
+        }
+        m_lutElemType = m_elemType;
+        m_lutScale = m_scale;
+        m_lutOffset = m_offset;
+    }
+    else
+    {
+        /* the table of the previous frame is still valid */
+    }
+
+    return status;
+}
+
+int32_t QuantizedTensorView::GetRawThreshold( float threshold ) const
+{
+    /* the real value increases with the quantized value, find the first one passing */
+    int32_t lo = m_minRaw;
+    int32_t hi = m_maxRaw + 1;
+    while ( lo < hi )
+    {
+        int32_t mid = lo + ( hi - lo ) / 2;
+        if ( RawToFloat( mid ) > threshold )
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+int32_t QuantizedTensorView::GetSigmoidRawThreshold( float prob ) const
+{
+    int32_t lo = m_minRaw;
+    int32_t hi = m_maxRaw + 1;
+    while ( lo < hi )
+    {
+        int32_t mid = lo + ( hi - lo ) / 2;
+        if ( SigmoidOf( RawToFloat( mid ) ) > prob )
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+QCStatus_e QuantizedTensorView::Select( int32_t rawThreshold, size_t start, size_t count,
+                                        size_t stride, std::vector<uint32_t> &indices ) const
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( 0 == stride )
+    {
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( ( 0 < count ) && ( ( start >= m_numElements ) ||
+                                 ( count - 1 > ( m_numElements - 1 - start ) / stride ) ) )
+    {
+        QC_LOG_ERROR( "QuantizedTensorView: selection out of %" PRIu64 " elements",
+                      (uint64_t) m_numElements );
+        status = QC_STATUS_OUT_OF_BOUND;
+    }
+    else if ( 0 < count )
+    {
+        switch ( m_elemType )
+        {
+            case ELEM_TYPE_U8:
+                SelectBlock( (const uint8_t *) m_pData, start, count, stride, rawThreshold,
+                             indices );
+                break;
+            case ELEM_TYPE_S8:
+                SelectBlock( (const int8_t *) m_pData, start, count, stride, rawThreshold,
+                             indices );
+                break;
+            case ELEM_TYPE_U16:
+                SelectBlock( (const uint16_t *) m_pData, start, count, stride, rawThreshold,
+                             indices );
+                break;
+            default:
+                SelectBlock( (const int16_t *) m_pData, start, count, stride, rawThreshold,
+                             indices );
+                break;
+        }
+    }
+    else
+    {
+        /* nothing to select */
+    }
+
+    return status;
+}
+
+}   // namespace Memory
+}   // namespace QC
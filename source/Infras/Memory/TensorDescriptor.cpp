@@ -26,6 +26,8 @@ TensorDescriptor &TensorDescriptor::operator=( const TensorDescriptor &other )
         uint32_t numDims = std::min( other.numDims, (uint32_t) QC_NUM_TENSOR_DIMS );
         std::copy( other.dims, other.dims + numDims, this->dims );
         this->numDims = numDims;
+        this->quantScale = other.quantScale;
+        this->quantOffset = other.quantOffset;
     }
     return *this;
 }
@@ -76,12 +78,61 @@ TensorDescriptor &TensorDescriptor::operator=( const QCSharedBuffer_t &other )
     std::copy( other.tensorProps.dims, other.tensorProps.dims + other.tensorProps.numDims,
                this->dims );
     this->numDims = other.tensorProps.numDims;
+    this->quantScale = 1.0f;
+    this->quantOffset = 0;
 
     QC_LOG_DEBUG( "Tensor %s = %u [%u %u %u %u]", this->name.c_str(), this->numDims, this->dims[0],
                   this->dims[1], this->dims[2], this->dims[3] );
     return *this;
 }
 
+QCStatus_e TensorDescriptor::GetTensorDesc( TensorDescriptor &tensorDesc, uint32_t batchOffset,
+                                            uint32_t batchSize ) const
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( nullptr == this->pBuf )
+    {
+        QC_LOG_ERROR( "tensor not allocated" );
+        status = QC_STATUS_INVALID_BUF;
+    }
+    else if ( QC_BUFFER_TYPE_TENSOR != this->type )
+    {
+        QC_LOG_ERROR( "buffer type %d is not tensor", this->type );
+        status = QC_STATUS_UNSUPPORTED;
+    }
+    else if ( ( 0 == this->numDims ) || ( batchOffset >= this->dims[0] ) )
+    {
+        QC_LOG_ERROR( "tensor batch offset %u out of range", batchOffset );
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( ( 0 == batchSize ) || ( ( batchOffset + batchSize ) > this->dims[0] ) )
+    {
+        QC_LOG_ERROR( "tensor batch size %u out of range", batchSize );
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( 0 != ( this->validSize % this->dims[0] ) )
+    {
+        QC_LOG_ERROR( "tensor size %" PRIu64 " is not a multiple of the batch %u",
+                      (uint64_t) this->validSize, this->dims[0] );
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        tensorDesc = *this;
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        size_t batchBytes = this->validSize / this->dims[0];
+        tensorDesc.dims[0] = batchSize;
+        tensorDesc.validSize = batchSize * batchBytes;
+        tensorDesc.offset = this->offset + batchOffset * batchBytes;
+    }
+
+    return status;
+}
+
 }   // namespace Memory
 
 }   // namespace QC
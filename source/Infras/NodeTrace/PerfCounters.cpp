@@ -0,0 +1,252 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
+
+#include <string.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace QC
+{
+namespace Node
+{
+
+#if defined( __linux__ )
+typedef struct
+{
+    uint32_t type;
+    uint64_t config;
+} PerfCounterEvent_t;
+
+static const PerfCounterEvent_t s_perfCounterEvents[QCNODE_PERF_COUNTER_MAX] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+        { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+};
+#endif
+
+static const char *s_perfCounterNames[QCNODE_PERF_COUNTER_MAX] = {
+        "cycles", "instructions", "cacheMisses", "contextSwitches", "pageFaults",
+};
+
+PerfCounters::PerfCounters()
+{
+    for ( uint32_t i = 0; i < QCNODE_PERF_COUNTER_MAX; i++ )
+    {
+        m_fds[i] = -1;
+        m_openedTypes[i] = QCNODE_PERF_COUNTER_MAX;
+    }
+    (void) memset( &m_counters, 0, sizeof( m_counters ) );
+}
+
+PerfCounters::~PerfCounters()
+{
+    Close();
+}
+
+QCStatus_e PerfCounters::Init()
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+#if defined( __linux__ )
+    std::lock_guard<std::mutex> l( m_lock );
+    (void) memset( &m_counters, 0, sizeof( m_counters ) );
+    m_bEnabled = true;
+#else
+    status = QC_STATUS_UNSUPPORTED;
+#endif
+
+    return status;
+}
+
+QCStatus_e PerfCounters::Deinit()
+{
+    std::lock_guard<std::mutex> l( m_lock );
+    m_bEnabled = false;
+    Close();
+
+    return QC_STATUS_OK;
+}
+
+QCStatus_e PerfCounters::Open()
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+#if defined( __linux__ )
+    int leaderFd = -1;
+
+    Close();
+    m_counters.available = 0;
+    for ( uint32_t i = 0; i < QCNODE_PERF_COUNTER_MAX; i++ )
+    {
+        struct perf_event_attr attr;
+        (void) memset( &attr, 0, sizeof( attr ) );
+        attr.size = sizeof( attr );
+        attr.type = s_perfCounterEvents[i].type;
+        attr.config = s_perfCounterEvents[i].config;
+        attr.disabled = ( -1 == leaderFd ) ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        /* counters not supported by the PMU or not permitted are skipped */
+        int fd = (int) syscall( __NR_perf_event_open, &attr, 0, -1, leaderFd, 0 );
+        if ( fd >= 0 )
+        {
+            if ( -1 == leaderFd )
+            {
+                leaderFd = fd;
+            }
+            m_fds[m_numOpened] = fd;
+            m_openedTypes[m_numOpened] = (QCNodePerfCounterType_e) i;
+            m_numOpened++;
+            m_counters.available |= ( 1u << i );
+        }
+    }
+
+    if ( 0 == m_numOpened )
+    {
+        status = QC_STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        m_tid = (int64_t) syscall( SYS_gettid );
+    }
+#else
+    status = QC_STATUS_UNSUPPORTED;
+#endif
+
+    return status;
+}
+
+void PerfCounters::Close()
+{
+    for ( uint32_t i = 0; i < m_numOpened; i++ )
+    {
+        if ( m_fds[i] >= 0 )
+        {
+            (void) close( m_fds[i] );
+            m_fds[i] = -1;
+        }
+        m_openedTypes[i] = QCNODE_PERF_COUNTER_MAX;
+    }
+    m_numOpened = 0;
+    m_tid = -1;
+    m_bStarted = false;
+}
+
+bool PerfCounters::IsEnabled()
+{
+    std::lock_guard<std::mutex> l( m_lock );
+    return m_bEnabled;
+}
+
+void PerfCounters::Begin()
+{
+#if defined( __linux__ )
+    std::lock_guard<std::mutex> l( m_lock );
+    if ( true == m_bEnabled )
+    {
+        QCStatus_e status = QC_STATUS_OK;
+
+        /* perf events opened with pid 0 only count the thread that opened them */
+        if ( (int64_t) syscall( SYS_gettid ) != m_tid )
+        {
+            status = Open();
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            (void) ioctl( m_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP );
+            (void) ioctl( m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+            m_bStarted = true;
+        }
+        else
+        {
+            /* nothing could be opened, stop trying for every frame */
+            m_bEnabled = false;
+        }
+    }
+#endif
+}
+
+void PerfCounters::End()
+{
+#if defined( __linux__ )
+    std::lock_guard<std::mutex> l( m_lock );
+    if ( true == m_bEnabled )
+    {
+        if ( ( true == m_bStarted ) && ( (int64_t) syscall( SYS_gettid ) == m_tid ) )
+        {
+            /* PERF_FORMAT_GROUP layout: nr, then one value per opened counter */
+            uint64_t values[QCNODE_PERF_COUNTER_MAX + 1];
+            (void) ioctl( m_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP );
+            ssize_t size = read( m_fds[0], values, sizeof( values ) );
+            if ( ( size >= (ssize_t) sizeof( uint64_t ) ) && ( values[0] == m_numOpened ) )
+            {
+                for ( uint32_t i = 0; i < m_numOpened; i++ )
+                {
+                    QCNodePerfCounterType_e type = m_openedTypes[i];
+                    m_counters.last[type] = values[i + 1];
+                    m_counters.total[type] += values[i + 1];
+                }
+                m_counters.numSamples++;
+            }
+        }
+        m_bStarted = false;
+    }
+#endif
+}
+
+void PerfCounters::Get( QCNodePerfCounters_t &counters )
+{
+    std::lock_guard<std::mutex> l( m_lock );
+    counters = m_counters;
+}
+
+void PerfCounters::Reset()
+{
+    std::lock_guard<std::mutex> l( m_lock );
+    uint32_t available = m_counters.available;
+    (void) memset( &m_counters, 0, sizeof( m_counters ) );
+    m_counters.available = available;
+}
+
+std::vector<QCNodeTraceArg_t> PerfCounters::GetTraceArgs()
+{
+    std::vector<QCNodeTraceArg_t> args;
+    std::lock_guard<std::mutex> l( m_lock );
+
+    for ( uint32_t i = 0; i < QCNODE_PERF_COUNTER_MAX; i++ )
+    {
+        if ( 0 != ( m_counters.available & ( 1u << i ) ) )
+        {
+            args.push_back( QCNodeTraceArg( s_perfCounterNames[i], m_counters.last[i] ) );
+        }
+    }
+
+    return args;
+}
+
+const char *PerfCounters::GetName( QCNodePerfCounterType_e type )
+{
+    const char *pName = "unknown";
+
+    if ( type < QCNODE_PERF_COUNTER_MAX )
+    {
+        pName = s_perfCounterNames[type];
+    }
+
+    return pName;
+}
+
+}   // namespace Node
+}   // namespace QC
@@ -4,6 +4,15 @@
 
 #include "OpenclIface.hpp"
 
+#include <algorithm>
+#include <errno.h>
+#include <inttypes.h>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace QC
 {
 namespace libs
@@ -11,6 +20,65 @@ namespace libs
 namespace OpenclIface
 {
 
+/* the FNV-1a hash of a data block, chained over several blocks by the seed */
+static uint64_t Hash( const void *pData, size_t size, uint64_t seed = 0xcbf29ce484222325ull )
+{
+    const uint8_t *pBytes = (const uint8_t *) pData;
+    uint64_t hash = seed;
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        hash ^= pBytes[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+/* create the missing parent directories of a file one by one, an existing one is not an error */
+static QCStatus_e MakeParentDirs( const std::string &path )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    for ( size_t pos = path.find( '/', 1 ); std::string::npos != pos;
+          pos = path.find( '/', pos + 1 ) )
+    {
+        std::string dir = path.substr( 0, pos );
+        if ( ( 0 != mkdir( dir.c_str(), 0755 ) ) && ( EEXIST != errno ) )
+        {
+            QC_LOG_ERROR( "Failed to create the directory %s: %d", dir.c_str(), errno );
+            ret = QC_STATUS_FAIL;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+bool GetPerfLevel( const std::string &level, OpenclIfcae_Perf_e &perf )
+{
+    bool bValid = true;
+
+    if ( "normal" == level )
+    {
+        perf = OPENCLIFACE_PERF_NORMAL;
+    }
+    else if ( "high" == level )
+    {
+        perf = OPENCLIFACE_PERF_HIGH;
+    }
+    else if ( "low" == level )
+    {
+        perf = OPENCLIFACE_PERF_LOW;
+    }
+    else
+    {
+        bValid = false;
+    }
+
+    return bValid;
+}
+
 QCStatus_e OpenclSrv::Init( const char *pName, Logger_Level_e level, OpenclIfcae_Perf_e priority,
                             uint32_t deviceId )
 {
@@ -113,10 +181,9 @@ QCStatus_e OpenclSrv::Init( const char *pName, Logger_Level_e level, OpenclIfcae
 
     if ( CL_SUCCESS == retCL )
     {
-        m_commandQueue = clCreateCommandQueueWithProperties( m_context, m_deviceID, NULL, &retCL );
+        retCL = CreateQueue();
         if ( CL_SUCCESS != retCL )
         {
-            QC_ERROR( "Unable to create command queue, retCL = %d", retCL );
             ret = QC_STATUS_FAIL;
         }
     }
@@ -196,6 +263,344 @@ QCStatus_e OpenclSrv::Init( const char *pName, Logger_Level_e level, OpenclIfcae
     return ret;
 }
 
+bool OpenclSrv::HasExtension( const char *pExtension )
+{
+    size_t extensionSize = 0;
+    (void) clGetDeviceInfo( m_deviceID, CL_DEVICE_EXTENSIONS, 0, NULL, &extensionSize );
+    std::vector<char> extensions( extensionSize + 1, 0 );
+    cl_int retCL = clGetDeviceInfo( m_deviceID, CL_DEVICE_EXTENSIONS, extensionSize,
+                                    extensions.data(), NULL );
+
+    return ( CL_SUCCESS == retCL ) && ( nullptr != strstr( extensions.data(), pExtension ) );
+}
+
+cl_int OpenclSrv::CreateQueue()
+{
+    cl_int retCL = CL_SUCCESS;
+    cl_queue_properties properties[7];
+    uint32_t numOfProperties = 0;
+    cl_command_queue_properties queueProperties = 0;
+
+    m_bOutOfOrder = false;
+    if ( m_queueConfig.bOutOfOrder )
+    {
+        cl_command_queue_properties supported = 0;
+        retCL = clGetDeviceInfo( m_deviceID, CL_DEVICE_QUEUE_ON_HOST_PROPERTIES,
+                                 sizeof( supported ), &supported, NULL );
+        if ( ( CL_SUCCESS == retCL ) &&
+             ( 0 != ( supported & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE ) ) )
+        {
+            queueProperties |= CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+            m_bOutOfOrder = true;
+        }
+        else
+        {
+            QC_WARN( "Out-of-order queue is not supported, the commands run in order" );
+        }
+    }
+
+    /* the profiling is supported by all the devices */
+    m_bProfiling = m_queueConfig.bProfiling;
+    if ( m_bProfiling )
+    {
+        queueProperties |= CL_QUEUE_PROFILING_ENABLE;
+    }
+
+    if ( 0 != queueProperties )
+    {
+        properties[numOfProperties++] = CL_QUEUE_PROPERTIES;
+        properties[numOfProperties++] = queueProperties;
+    }
+
+    /* the normal level is the default medium hint of the device, so no property is needed */
+    if ( OPENCLIFACE_PERF_NORMAL != m_queueConfig.priority )
+    {
+        if ( HasExtension( "cl_khr_priority_hints" ) )
+        {
+            properties[numOfProperties++] = CL_QUEUE_PRIORITY_KHR;
+            properties[numOfProperties++] = ( OPENCLIFACE_PERF_HIGH == m_queueConfig.priority )
+                                                    ? CL_QUEUE_PRIORITY_HIGH_KHR
+                                                    : CL_QUEUE_PRIORITY_LOW_KHR;
+        }
+        else
+        {
+            QC_WARN( "Queue priority hint is not supported, ignored" );
+        }
+    }
+
+    if ( OPENCLIFACE_PERF_NORMAL != m_queueConfig.throttle )
+    {
+        if ( HasExtension( "cl_khr_throttle_hints" ) )
+        {
+            properties[numOfProperties++] = CL_QUEUE_THROTTLE_KHR;
+            properties[numOfProperties++] = ( OPENCLIFACE_PERF_HIGH == m_queueConfig.throttle )
+                                                    ? CL_QUEUE_THROTTLE_HIGH_KHR
+                                                    : CL_QUEUE_THROTTLE_LOW_KHR;
+        }
+        else
+        {
+            QC_WARN( "Queue throttle hint is not supported, ignored" );
+        }
+    }
+    properties[numOfProperties] = 0;
+
+    m_commandQueue = clCreateCommandQueueWithProperties(
+            m_context, m_deviceID, ( 0 < numOfProperties ) ? properties : NULL, &retCL );
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to create command queue, retCL = %d", retCL );
+    }
+
+    return retCL;
+}
+
+/* the shared contexts of the process by name, the entries do not move while the map changes */
+static std::mutex sg_sharedLock;
+static std::map<std::string, OpenclIface_SharedContext_t> sg_sharedContexts;
+
+QCStatus_e OpenclSrv::Init( const char *pName, Logger_Level_e level, OpenclIfcae_Perf_e priority,
+                            uint32_t deviceId, const std::string &sharedContext,
+                            const OpenclIface_QueueConfig_t &queueConfig )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    m_queueConfig = queueConfig;
+    if ( sharedContext.empty() )
+    {
+        ret = Init( pName, level, priority, deviceId );
+    }
+    else
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = sg_sharedContexts.find( sharedContext );
+        if ( sg_sharedContexts.end() == it )
+        {
+            ret = Init( pName, level, priority, deviceId );
+            if ( QC_STATUS_OK == ret )
+            {
+                OpenclIface_SharedContext_t &shared = sg_sharedContexts[sharedContext];
+                shared.platformID = m_platformID;
+                shared.deviceID = m_deviceID;
+                shared.context = m_context;
+                shared.queues[m_queueConfig.name] = { m_commandQueue, m_queueConfig,
+                                                      m_bOutOfOrder, 1 };
+                shared.sampler = m_sampler;
+                shared.priority = priority;
+                shared.deviceId = deviceId;
+                shared.numUsers = 1;
+                m_pShared = &shared;
+                m_sharedName = sharedContext;
+                QC_INFO( "Shared context %s created", sharedContext.c_str() );
+            }
+        }
+        else
+        {
+            ret = QC_LOGGER_INIT( pName, level );
+            if ( QC_STATUS_OK != ret )
+            {
+                (void) fprintf( stderr,
+                                "WARINING: failed to create logger for OpenclSrv %s: ret = %d\n",
+                                pName, ret );
+                ret = QC_STATUS_OK; /* ignore logger init error */
+            }
+
+            if ( ( priority != it->second.priority ) || ( deviceId != it->second.deviceId ) )
+            {
+                QC_ERROR( "Shared context %s is of priority %d and device ID %u, not %d and %u",
+                          sharedContext.c_str(), it->second.priority, it->second.deviceId,
+                          priority, deviceId );
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else
+            {
+                ret = JoinSharedContext( it->second );
+            }
+
+            if ( QC_STATUS_OK == ret )
+            {
+                it->second.numUsers++;
+                m_pShared = &it->second;
+                m_sharedName = sharedContext;
+                QC_INFO( "Shared context %s joined by %u instances", sharedContext.c_str(),
+                         it->second.numUsers );
+            }
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::JoinSharedContext( OpenclIface_SharedContext_t &shared )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = CL_SUCCESS;
+
+    auto it = shared.queues.find( m_queueConfig.name );
+    if ( ( shared.queues.end() != it ) &&
+         ( ( m_queueConfig.priority != it->second.config.priority ) ||
+           ( m_queueConfig.throttle != it->second.config.throttle ) ||
+           ( m_queueConfig.bOutOfOrder != it->second.config.bOutOfOrder ) ) )
+    {
+        QC_ERROR( "Shared queue \"%s\" is of another priority, throttle or order mode",
+                  m_queueConfig.name.c_str() );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        m_platformID = shared.platformID;
+        m_deviceID = shared.deviceID;
+
+        /* each instance holds its own references, released by its Deinit */
+        retCL = clRetainContext( shared.context );
+        if ( CL_SUCCESS == retCL )
+        {
+            m_context = shared.context;
+            retCL = clRetainSampler( shared.sampler );
+        }
+
+        if ( CL_SUCCESS == retCL )
+        {
+            m_sampler = shared.sampler;
+            if ( shared.queues.end() == it )
+            {
+                retCL = CreateQueue();
+                if ( CL_SUCCESS == retCL )
+                {
+                    shared.queues[m_queueConfig.name] = { m_commandQueue, m_queueConfig,
+                                                          m_bOutOfOrder, 1 };
+                }
+            }
+            else
+            {
+                retCL = clRetainCommandQueue( it->second.commandQueue );
+                if ( CL_SUCCESS == retCL )
+                {
+                    m_commandQueue = it->second.commandQueue;
+                    m_bOutOfOrder = it->second.bOutOfOrder;
+                    m_bProfiling = m_queueConfig.bProfiling && it->second.config.bProfiling;
+                    if ( m_queueConfig.bProfiling && ( false == m_bProfiling ) )
+                    {
+                        QC_WARN( "Shared queue \"%s\" created without profiling, disabled",
+                                 m_queueConfig.name.c_str() );
+                    }
+                    it->second.numUsers++;
+                }
+            }
+        }
+
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to retain the shared context objects, retCL = %d", retCL );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    return ret;
+}
+
+void OpenclSrv::LeaveSharedContext()
+{
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = m_pShared->queues.find( m_queueConfig.name );
+        if ( m_pShared->queues.end() != it )
+        {
+            it->second.numUsers--;
+            if ( 0 == it->second.numUsers )
+            {
+                (void) m_pShared->queues.erase( it );
+            }
+        }
+
+        m_pShared->numUsers--;
+        if ( 0 == m_pShared->numUsers )
+        {
+            /* the buffers and the OpenCL objects were released by the Deinit of each instance */
+            (void) sg_sharedContexts.erase( m_sharedName );
+            QC_INFO( "Shared context %s released", m_sharedName.c_str() );
+        }
+        m_pShared = nullptr;
+        m_sharedName.clear();
+    }
+}
+
+bool OpenclSrv::GetSharedBuffer( void *pData, cl_mem &bufferCL )
+{
+    bool bFound = false;
+
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = m_pShared->bufferMap.find( pData );
+        if ( m_pShared->bufferMap.end() != it )
+        {
+            cl_int retCL = clRetainMemObject( it->second.clMem );
+            if ( CL_SUCCESS == retCL )
+            {
+                it->second.numUsers++;
+                bufferCL = it->second.clMem;
+                bFound = true;
+            }
+            else
+            {
+                QC_ERROR( "Unable to retain shared CL buffer, retCL = %d", retCL );
+            }
+        }
+    }
+
+    return bFound;
+}
+
+void OpenclSrv::AddSharedBuffer( void *pData, cl_mem &bufferCL )
+{
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = m_pShared->bufferMap.find( pData );
+        if ( m_pShared->bufferMap.end() == it )
+        {
+            m_pShared->bufferMap[pData] = { bufferCL, 1, nullptr };
+        }
+        else if ( CL_SUCCESS == clRetainMemObject( it->second.clMem ) )
+        {
+            /* wrapped by another instance meanwhile, use the same one */
+            (void) clReleaseMemObject( bufferCL );
+            it->second.numUsers++;
+            bufferCL = it->second.clMem;
+        }
+        else
+        {
+            QC_WARN( "Unable to retain shared CL buffer, the buffer is not shared" );
+        }
+    }
+}
+
+cl_int OpenclSrv::ReleaseBuffer( void *pData, cl_mem bufferCL )
+{
+    cl_int retCL = clReleaseMemObject( bufferCL );
+
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = m_pShared->bufferMap.find( pData );
+        if ( ( m_pShared->bufferMap.end() != it ) && ( bufferCL == it->second.clMem ) )
+        {
+            it->second.numUsers--;
+            if ( 0 == it->second.numUsers )
+            {
+                if ( nullptr != it->second.lastWrite )
+                {
+                    (void) clReleaseEvent( it->second.lastWrite );
+                }
+                (void) m_pShared->bufferMap.erase( it );
+            }
+        }
+    }
+
+    return retCL;
+}
+
 QCStatus_e OpenclSrv::LoadFromSource( const char *pSourceFile )
 {
     QCStatus_e ret = QC_STATUS_OK;
@@ -210,7 +615,7 @@ QCStatus_e OpenclSrv::LoadFromSource( const char *pSourceFile )
     }
     else
     {
-        retCL = clBuildProgram( m_program, 1, &m_deviceID, "-cl-fast-relaxed-math", NULL, NULL );
+        retCL = clBuildProgram( m_program, 1, &m_deviceID, OPENCLIFACE_BUILD_OPTIONS, NULL, NULL );
         if ( CL_SUCCESS != retCL )
         {
             QC_ERROR( "Unable to build program, retCL = %d", retCL );
@@ -229,29 +634,647 @@ QCStatus_e OpenclSrv::LoadFromSource( const char *pSourceFile )
             }
             else
             {
-                QC_ERROR( "Unable to get build log!" );
+                QC_ERROR( "Unable to get build log!" );
+            }
+            logs.clear();
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::LoadFromSource( const char *pSourceFile, const std::string &cacheDir )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::vector<unsigned char> binary;
+    std::string path;
+    uint64_t key = 0;
+    bool bLoaded = false;
+
+    if ( false == cacheDir.empty() )
+    {
+        ret = GetProgramKey( pSourceFile, key );
+        if ( QC_STATUS_OK == ret )
+        {
+            char name[32];
+            (void) snprintf( name, sizeof( name ), "%016" PRIx64 ".clbin", key );
+            path = cacheDir + "/" + name;
+            ret = ReadProgramCache( path, key, binary );
+        }
+        if ( QC_STATUS_OK == ret )
+        {
+            ret = LoadFromBinary( binary.data(), binary.size() );
+            bLoaded = ( QC_STATUS_OK == ret );
+        }
+
+        if ( false == bLoaded )
+        {
+            QC_INFO( "Program binary %s not usable: %d, compile the program", path.c_str(), ret );
+        }
+    }
+
+    if ( false == bLoaded )
+    {
+        ret = LoadFromSource( pSourceFile );
+        if ( ( QC_STATUS_OK == ret ) && ( false == path.empty() ) )
+        {
+            QCStatus_e ret2 = GetProgramBinary( binary );
+            if ( QC_STATUS_OK == ret2 )
+            {
+                ret2 = WriteProgramCache( path, key, binary );
+            }
+            if ( QC_STATUS_OK != ret2 )
+            {
+                QC_WARN( "Failed to save program binary %s: %d", path.c_str(), ret2 );
+            }
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::GetProgramKey( const char *pSourceFile, uint64_t &key )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::string signature;
+
+    ret = GetDeviceSignature( signature );
+    if ( QC_STATUS_OK == ret )
+    {
+        /* a program binary is only valid for the same source, build options, device and driver */
+        key = Hash( pSourceFile, strlen( pSourceFile ) );
+        key = Hash( OPENCLIFACE_BUILD_OPTIONS, strlen( OPENCLIFACE_BUILD_OPTIONS ), key );
+        key = Hash( signature.data(), signature.size(), key );
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::ReadProgramCache( const std::string &path, uint64_t key,
+                                        std::vector<unsigned char> &binary )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    OpenclIface_CacheHeader_t header;
+    struct stat st;
+
+    FILE *pFile = fopen( path.c_str(), "rb" );
+    if ( nullptr == pFile )
+    {
+        /* not cached yet */
+        ret = QC_STATUS_OUT_OF_BOUND;
+    }
+    else
+    {
+        if ( ( 0 != fstat( fileno( pFile ), &st ) ) ||
+             ( sizeof( header ) != fread( &header, 1, sizeof( header ), pFile ) ) )
+        {
+            QC_LOG_ERROR( "Program binary %s is truncated", path.c_str() );
+            ret = QC_STATUS_FAIL;
+        }
+        else if ( ( OPENCLIFACE_CACHE_MAGIC != header.magic ) ||
+                  ( OPENCLIFACE_CACHE_VERSION != header.version ) || ( key != header.key ) )
+        {
+            QC_LOG_INFO( "Program binary %s is stale", path.c_str() );
+            ret = QC_STATUS_UNSUPPORTED;
+        }
+        else if ( ( 0 == header.binarySize ) ||
+                  ( (uint64_t) st.st_size != sizeof( header ) + header.binarySize ) )
+        {
+            QC_LOG_ERROR( "Program binary %s is truncated", path.c_str() );
+            ret = QC_STATUS_FAIL;
+        }
+        else
+        {
+            binary.resize( header.binarySize );
+            if ( binary.size() != fread( binary.data(), 1, binary.size(), pFile ) )
+            {
+                QC_LOG_ERROR( "Program binary %s is truncated", path.c_str() );
+                ret = QC_STATUS_FAIL;
+            }
+            else if ( header.checksum != Hash( binary.data(), binary.size() ) )
+            {
+                QC_LOG_ERROR( "Program binary %s is corrupted", path.c_str() );
+                ret = QC_STATUS_FAIL;
+            }
+            else
+            {
+                /* OK */
+            }
+        }
+        (void) fclose( pFile );
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::WriteProgramCache( const std::string &path, uint64_t key,
+                                         const std::vector<unsigned char> &binary )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    OpenclIface_CacheHeader_t header;
+
+    ret = MakeParentDirs( path );
+    if ( QC_STATUS_OK == ret )
+    {
+        header.magic = OPENCLIFACE_CACHE_MAGIC;
+        header.version = OPENCLIFACE_CACHE_VERSION;
+        header.key = key;
+        header.binarySize = binary.size();
+        header.checksum = Hash( binary.data(), binary.size() );
+
+        /* written into a temporary file and renamed, so that the other instances loading or saving
+         * the same program never see a partially written binary */
+        std::string tmpPath = path + ".tmp." + std::to_string( getpid() ) + "." +
+                              std::to_string( (uintptr_t) &binary );
+        FILE *pFile = fopen( tmpPath.c_str(), "wb" );
+        if ( nullptr == pFile )
+        {
+            QC_LOG_ERROR( "Failed to create %s", tmpPath.c_str() );
+            ret = QC_STATUS_FAIL;
+        }
+        else
+        {
+            if ( ( sizeof( header ) != fwrite( &header, 1, sizeof( header ), pFile ) ) ||
+                 ( binary.size() != fwrite( binary.data(), 1, binary.size(), pFile ) ) )
+            {
+                QC_LOG_ERROR( "Failed to write %s", tmpPath.c_str() );
+                ret = QC_STATUS_FAIL;
+            }
+            if ( 0 != fclose( pFile ) )
+            {
+                QC_LOG_ERROR( "Failed to close %s: %d", tmpPath.c_str(), errno );
+                ret = QC_STATUS_FAIL;
+            }
+
+            if ( ( QC_STATUS_OK == ret ) && ( 0 != rename( tmpPath.c_str(), path.c_str() ) ) )
+            {
+                QC_LOG_ERROR( "Failed to rename %s", tmpPath.c_str() );
+                ret = QC_STATUS_FAIL;
+            }
+
+            if ( QC_STATUS_OK != ret )
+            {
+                (void) unlink( tmpPath.c_str() );
+            }
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::LoadFromBinary( const unsigned char *pBinaryFile )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = CL_SUCCESS;
+
+    m_program = clCreateProgramWithBinary( m_context, 1, &m_deviceID, NULL, &pBinaryFile, NULL,
+                                           &retCL );
+    if ( retCL != CL_SUCCESS )
+    {
+        QC_ERROR( "Unable to create program with binary, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::LoadFromBinary( const unsigned char *pBinary, size_t size )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = CL_SUCCESS;
+    cl_int binaryStatus = CL_SUCCESS;
+
+    m_program = clCreateProgramWithBinary( m_context, 1, &m_deviceID, &size, &pBinary,
+                                           &binaryStatus, &retCL );
+    if ( ( CL_SUCCESS != retCL ) || ( CL_SUCCESS != binaryStatus ) )
+    {
+        QC_ERROR( "Unable to create program with binary, retCL = %d, binaryStatus = %d", retCL,
+                  binaryStatus );
+        ret = QC_STATUS_FAIL;
+    }
+    else
+    {
+        retCL = clBuildProgram( m_program, 1, &m_deviceID, OPENCLIFACE_BUILD_OPTIONS, NULL, NULL );
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to build program from binary, retCL = %d", retCL );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    if ( ( QC_STATUS_OK != ret ) && ( nullptr != m_program ) )
+    {
+        (void) clReleaseProgram( m_program );
+        m_program = nullptr;
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::GetProgramBinary( std::vector<unsigned char> &binary )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = CL_SUCCESS;
+    size_t binarySize = 0;
+
+    retCL = clGetProgramInfo( m_program, CL_PROGRAM_BINARY_SIZES, sizeof( binarySize ),
+                              &binarySize, NULL );
+    if ( ( CL_SUCCESS != retCL ) || ( 0 == binarySize ) )
+    {
+        QC_ERROR( "Unable to get program binary size, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+    else
+    {
+        binary.resize( binarySize );
+        unsigned char *pBinary = binary.data();
+        retCL = clGetProgramInfo( m_program, CL_PROGRAM_BINARIES, sizeof( pBinary ), &pBinary,
+                                  NULL );
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to get program binary, retCL = %d", retCL );
+            binary.clear();
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::GetDeviceSignature( std::string &signature )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    const cl_device_info infos[] = { CL_DEVICE_NAME, CL_DEVICE_VERSION, CL_DRIVER_VERSION };
+
+    signature = "";
+    for ( cl_device_info info : infos )
+    {
+        size_t infoSize = 0;
+        cl_int retCL = clGetDeviceInfo( m_deviceID, info, 0, NULL, &infoSize );
+        if ( CL_SUCCESS == retCL )
+        {
+            std::vector<char> value( infoSize + 1, '\0' );
+            retCL = clGetDeviceInfo( m_deviceID, info, infoSize, value.data(), NULL );
+            if ( CL_SUCCESS == retCL )
+            {
+                signature += value.data();
+                signature += ";";
+            }
+        }
+
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to get device info 0x%x, retCL = %d", info, retCL );
+            ret = QC_STATUS_FAIL;
+            break;
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::LoadTuning( const std::string &path, bool bTune )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::string signature;
+
+    ret = GetDeviceSignature( signature );
+    if ( QC_STATUS_OK == ret )
+    {
+        m_tuningPath = path;
+        m_bTune = bTune;
+        m_tuningKey = Hash( signature.data(), signature.size() );
+        m_tuningMap.clear();
+        m_tunedSizes.clear();
+        ret = ReadTuning( path, m_tuningKey, m_tuningMap );
+        if ( QC_STATUS_OK == ret )
+        {
+            QC_INFO( "Tuning database %s loaded with %" PRIu64 " entries", path.c_str(),
+                     (uint64_t) m_tuningMap.size() );
+        }
+        else if ( bTune )
+        {
+            /* missing or stale, the kernels are tuned again */
+            ret = QC_STATUS_OK;
+        }
+        else
+        {
+            QC_WARN( "Tuning database %s is not usable, the driver chooses the local work sizes",
+                     path.c_str() );
+            ret = QC_STATUS_OK;
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::ReadTuning( const std::string &path, uint64_t key,
+                                  std::map<std::string, OpenclIface_TuningEntry_t> &entries )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    char magic[8] = { 0 };
+    uint32_t version = 0;
+    uint64_t fileKey = 0;
+
+    FILE *pFile = fopen( path.c_str(), "r" );
+    if ( nullptr == pFile )
+    {
+        /* not tuned yet */
+        ret = QC_STATUS_OUT_OF_BOUND;
+    }
+    else
+    {
+        if ( ( 3 != fscanf( pFile, "%7s %" SCNu32 " %" SCNx64, magic, &version, &fileKey ) ) ||
+             ( 0 != strcmp( OPENCLIFACE_TUNING_MAGIC, magic ) ) ||
+             ( OPENCLIFACE_TUNING_VERSION != version ) || ( key != fileKey ) )
+        {
+            QC_LOG_INFO( "Tuning database %s is stale", path.c_str() );
+            ret = QC_STATUS_UNSUPPORTED;
+        }
+        else
+        {
+            /* one line per kernel and global work size: the kernel name, the work dimensions,
+             * the global work size, the local work size and the time in nanoseconds */
+            char name[128];
+            uint32_t workDim;
+            size_t globalWorkSize[3];
+            OpenclIface_TuningEntry_t entry;
+            while ( 9 == fscanf( pFile, "%127s %" SCNu32 " %zu %zu %zu %zu %zu %zu %" SCNu64, name,
+                                 &workDim, &globalWorkSize[0], &globalWorkSize[1],
+                                 &globalWorkSize[2], &entry.localWorkSize[0],
+                                 &entry.localWorkSize[1], &entry.localWorkSize[2],
+                                 &entry.timeNs ) )
+            {
+                std::string tuningKey = std::string( name ) + " " + std::to_string( workDim ) +
+                                        " " + std::to_string( globalWorkSize[0] ) + " " +
+                                        std::to_string( globalWorkSize[1] ) + " " +
+                                        std::to_string( globalWorkSize[2] );
+                entries[tuningKey] = entry;
+            }
+        }
+        (void) fclose( pFile );
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::WriteTuning( const std::string &path, uint64_t key,
+                                   const std::map<std::string, OpenclIface_TuningEntry_t> &entries )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::map<std::string, OpenclIface_TuningEntry_t> merged;
+
+    /* keep the entries tuned meanwhile by the other instances of the same database */
+    (void) ReadTuning( path, key, merged );
+    for ( auto &it : entries )
+    {
+        merged[it.first] = it.second;
+    }
+
+    /* written into a temporary file and renamed, so that the other instances never see a
+     * partially written database */
+    std::string tmpPath = path + ".tmp." + std::to_string( getpid() ) + "." +
+                          std::to_string( (uintptr_t) &entries );
+    ret = MakeParentDirs( path );
+    FILE *pFile = nullptr;
+    if ( QC_STATUS_OK == ret )
+    {
+        pFile = fopen( tmpPath.c_str(), "w" );
+        if ( nullptr == pFile )
+        {
+            QC_LOG_ERROR( "Failed to create %s: %d", tmpPath.c_str(), errno );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    if ( nullptr != pFile )
+    {
+        int written = fprintf( pFile, "%s %" PRIu32 " %016" PRIx64 "\n", OPENCLIFACE_TUNING_MAGIC,
+                               OPENCLIFACE_TUNING_VERSION, key );
+        for ( auto &it : merged )
+        {
+            if ( 0 < written )
+            {
+                written = fprintf( pFile, "%s %zu %zu %zu %" PRIu64 "\n", it.first.c_str(),
+                                   it.second.localWorkSize[0], it.second.localWorkSize[1],
+                                   it.second.localWorkSize[2], it.second.timeNs );
+            }
+        }
+        if ( 0 >= written )
+        {
+            QC_LOG_ERROR( "Failed to write %s", tmpPath.c_str() );
+            ret = QC_STATUS_FAIL;
+        }
+        if ( 0 != fclose( pFile ) )
+        {
+            QC_LOG_ERROR( "Failed to close %s: %d", tmpPath.c_str(), errno );
+            ret = QC_STATUS_FAIL;
+        }
+
+        if ( ( QC_STATUS_OK == ret ) && ( 0 != rename( tmpPath.c_str(), path.c_str() ) ) )
+        {
+            QC_LOG_ERROR( "Failed to rename %s", tmpPath.c_str() );
+            ret = QC_STATUS_FAIL;
+        }
+
+        if ( QC_STATUS_OK != ret )
+        {
+            (void) unlink( tmpPath.c_str() );
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::Tune( cl_kernel kernel, const OpenclIface_WorkParams_t *pWorkParam,
+                            OpenclIface_TuningEntry_t &entry )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = CL_SUCCESS;
+    size_t maxSize = 0;
+    size_t globalWorkSize[3] = { 1, 1, 1 };
+    std::vector<std::vector<size_t>> candidates;
+
+    if ( nullptr == m_profilingQueue )
+    {
+        cl_queue_properties properties[] = { CL_QUEUE_PROPERTIES, CL_QUEUE_PROFILING_ENABLE, 0 };
+        m_profilingQueue =
+                clCreateCommandQueueWithProperties( m_context, m_deviceID, properties, &retCL );
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to create profiling command queue, retCL = %d", retCL );
+            m_profilingQueue = nullptr;
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        retCL = clGetKernelWorkGroupInfo( kernel, m_deviceID, CL_KERNEL_WORK_GROUP_SIZE,
+                                          sizeof( maxSize ), &maxSize, NULL );
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to get kernel work group size, retCL = %d", retCL );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        /* the kernel reads what the commands enqueued before write */
+        ret = Finish();
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        for ( size_t i = 0; ( i < pWorkParam->workDim ) && ( i < 3 ); i++ )
+        {
+            globalWorkSize[i] = pWorkParam->pGlobalWorkSize[i];
+        }
+
+        /* the driver choice, then the power of 2 sizes dividing the global work size of the first
+         * 2 dimensions, as the kernels are not built for the non-uniform work groups */
+        candidates.push_back( { 0, 0, 0 } );
+        for ( size_t x = 1; ( x <= maxSize ) && ( x <= globalWorkSize[0] ); x *= 2 )
+        {
+            for ( size_t y = 1; ( x * y <= maxSize ) && ( y <= globalWorkSize[1] ); y *= 2 )
+            {
+                if ( ( 0 == ( globalWorkSize[0] % x ) ) && ( 0 == ( globalWorkSize[1] % y ) ) &&
+                     ( 8 <= x * y ) )
+                {
+                    candidates.push_back( { x, y, 1 } );
+                }
+            }
+        }
+
+        entry.timeNs = UINT64_MAX;
+        for ( auto &candidate : candidates )
+        {
+            uint64_t timeNs = UINT64_MAX;
+            const size_t *pLocalWorkSize = ( 0 == candidate[0] ) ? NULL : candidate.data();
+            for ( uint32_t run = 0; run < OPENCLIFACE_TUNING_RUNS; run++ )
+            {
+                cl_event event;
+                cl_ulong start = 0;
+                cl_ulong end = 0;
+                retCL = clEnqueueNDRangeKernel( m_profilingQueue, kernel, pWorkParam->workDim,
+                                                pWorkParam->pGlobalWorkOffset,
+                                                pWorkParam->pGlobalWorkSize, pLocalWorkSize, 0,
+                                                NULL, &event );
+                if ( CL_SUCCESS == retCL )
+                {
+                    retCL = clWaitForEvents( 1, &event );
+                    if ( CL_SUCCESS == retCL )
+                    {
+                        retCL = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_START,
+                                                         sizeof( start ), &start, NULL );
+                    }
+                    if ( CL_SUCCESS == retCL )
+                    {
+                        retCL = clGetEventProfilingInfo( event, CL_PROFILING_COMMAND_END,
+                                                         sizeof( end ), &end, NULL );
+                    }
+                    if ( ( CL_SUCCESS == retCL ) && ( end - start < timeNs ) )
+                    {
+                        timeNs = end - start;
+                    }
+                    (void) clReleaseEvent( event );
+                }
+                else
+                {
+                    /* the kernel resources do not fit a work group of this size */
+                    break;
+                }
+            }
+
+            if ( timeNs < entry.timeNs )
+            {
+                entry.timeNs = timeNs;
+                for ( size_t i = 0; i < 3; i++ )
+                {
+                    entry.localWorkSize[i] = candidate[i];
+                }
             }
-            logs.clear();
+        }
+
+        if ( UINT64_MAX == entry.timeNs )
+        {
+            QC_ERROR( "No local work size could be timed" );
+            ret = QC_STATUS_FAIL;
         }
     }
 
     return ret;
 }
 
-QCStatus_e OpenclSrv::LoadFromBinary( const unsigned char *pBinaryFile )
+bool OpenclSrv::GetTunedSize( cl_kernel kernel, const OpenclIface_WorkParams_t *pWorkParam,
+                              size_t *pLocalWorkSize )
 {
-    QCStatus_e ret = QC_STATUS_OK;
-    cl_int retCL = CL_SUCCESS;
+    bool bTuned = false;
+    char name[128] = { 0 };
+    OpenclIface_TunedSizeKey_t sizeKey = { kernel, { pWorkParam->workDim, 1, 1, 1 } };
 
-    m_program = clCreateProgramWithBinary( m_context, 1, &m_deviceID, NULL, &pBinaryFile, NULL,
-                                           &retCL );
-    if ( retCL != CL_SUCCESS )
+    if ( 3 >= pWorkParam->workDim )
     {
-        QC_ERROR( "Unable to create program with binary, retCL = %d", retCL );
-        ret = QC_STATUS_FAIL;
+        for ( size_t i = 0; i < pWorkParam->workDim; i++ )
+        {
+            sizeKey.second[i + 1] = pWorkParam->pGlobalWorkSize[i];
+        }
+
+        /* the kernel name and the database are only looked up at the first launch of a size */
+        auto sizeIt = m_tunedSizes.find( sizeKey );
+        if ( m_tunedSizes.end() == sizeIt )
+        {
+            std::array<size_t, 3> localWorkSize = { 0, 0, 0 };
+            cl_int retCL = clGetKernelInfo( kernel, CL_KERNEL_FUNCTION_NAME, sizeof( name ) - 1,
+                                            name, NULL );
+            if ( CL_SUCCESS == retCL )
+            {
+                std::string tuningKey = std::string( name ) + " " +
+                                        std::to_string( sizeKey.second[0] ) + " " +
+                                        std::to_string( sizeKey.second[1] ) + " " +
+                                        std::to_string( sizeKey.second[2] ) + " " +
+                                        std::to_string( sizeKey.second[3] );
+                auto it = m_tuningMap.find( tuningKey );
+                if ( ( m_tuningMap.end() == it ) && m_bTune )
+                {
+                    OpenclIface_TuningEntry_t entry;
+                    QCStatus_e ret = Tune( kernel, pWorkParam, entry );
+                    if ( QC_STATUS_OK == ret )
+                    {
+                        QC_INFO( "Tuned %s to local work size {%zu, %zu, %zu} in %" PRIu64 " ns",
+                                 tuningKey.c_str(), entry.localWorkSize[0],
+                                 entry.localWorkSize[1], entry.localWorkSize[2], entry.timeNs );
+                        m_tuningMap[tuningKey] = entry;
+                        it = m_tuningMap.find( tuningKey );
+                        if ( QC_STATUS_OK != WriteTuning( m_tuningPath, m_tuningKey, m_tuningMap ) )
+                        {
+                            QC_WARN( "Failed to save the tuning database %s",
+                                     m_tuningPath.c_str() );
+                        }
+                    }
+                }
+
+                if ( m_tuningMap.end() != it )
+                {
+                    std::copy( it->second.localWorkSize, it->second.localWorkSize + 3,
+                               localWorkSize.begin() );
+                }
+            }
+            sizeIt = m_tunedSizes.emplace( sizeKey, localWorkSize ).first;
+        }
+
+        if ( 0 != sizeIt->second[0] )
+        {
+            for ( size_t i = 0; i < pWorkParam->workDim; i++ )
+            {
+                pLocalWorkSize[i] = sizeIt->second[i];
+            }
+            bTuned = true;
+        }
     }
 
-    return ret;
+    return bTuned;
 }
 
 QCStatus_e OpenclSrv::CreateKernel( cl_kernel *pKernel, const char *pKernelName )
@@ -305,6 +1328,16 @@ QCStatus_e OpenclSrv::Deinit()
         ret = QC_STATUS_FAIL;
     }
 
+    if ( nullptr != m_profilingQueue )
+    {
+        (void) clReleaseCommandQueue( m_profilingQueue );
+        m_profilingQueue = nullptr;
+    }
+    m_tuningMap.clear();
+    m_tunedSizes.clear();
+    m_tuningPath.clear();
+    ReleaseProfiles();
+
     retCL = clReleaseCommandQueue( m_commandQueue );
     if ( CL_SUCCESS != retCL )
     {
@@ -321,7 +1354,7 @@ QCStatus_e OpenclSrv::Deinit()
 
     for ( auto &it : m_bufferMap )
     {
-        retCL = clReleaseMemObject( it.second.clMem );
+        retCL = ReleaseBuffer( it.first, it.second.clMem );
         if ( CL_SUCCESS != retCL )
         {
             QC_ERROR( "Unable to deregister buffer %d", it.first );
@@ -356,6 +1389,8 @@ QCStatus_e OpenclSrv::Deinit()
         ret = QC_STATUS_FAIL;
     }
 
+    LeaveSharedContext();
+
 
     ret = QC_LOGGER_DEINIT();
     if ( QC_STATUS_OK != ret )
@@ -381,7 +1416,12 @@ QCStatus_e OpenclSrv::RegBuf( const QCBuffer_t *pBuffer, cl_mem *pBufferCL )
     else
     {
         auto it = m_bufferMap.find( pBuffer->pData );
-        if ( it == m_bufferMap.end() )
+        if ( ( it == m_bufferMap.end() ) && GetSharedBuffer( pBuffer->pData, *pBufferCL ) )
+        {
+            /* wrapped by another instance of the shared context */
+            m_bufferMap[pBuffer->pData] = { *pBufferCL };
+        }
+        else if ( it == m_bufferMap.end() )
         {
 #if defined( __QNXNTO__ )
             cl_mem_pmem_host_ptr clBufHostPtr = { 0 };
@@ -410,6 +1450,7 @@ QCStatus_e OpenclSrv::RegBuf( const QCBuffer_t *pBuffer, cl_mem *pBufferCL )
             }
             else
             {
+                AddSharedBuffer( pBuffer->pData, bufferCL );
                 m_bufferMap[pBuffer->pData] = { bufferCL };
                 *pBufferCL = bufferCL;
             }
@@ -429,7 +1470,12 @@ QCStatus_e OpenclSrv::RegBufferDesc( QCBufferDescriptorBase_t &buffer, cl_mem &b
     cl_int retCL = CL_SUCCESS;
 
     auto it = m_bufferMap.find( buffer.pBuf );
-    if ( it == m_bufferMap.end() )
+    if ( ( it == m_bufferMap.end() ) && GetSharedBuffer( buffer.pBuf, bufferCL ) )
+    {
+        /* wrapped by another instance of the shared context */
+        m_bufferMap[buffer.pBuf] = { bufferCL };
+    }
+    else if ( it == m_bufferMap.end() )
     {
 #if defined( __QNXNTO__ )
         cl_mem_pmem_host_ptr clBufHostPtr = { 0 };
@@ -456,6 +1502,7 @@ QCStatus_e OpenclSrv::RegBufferDesc( QCBufferDescriptorBase_t &buffer, cl_mem &b
         }
         else
         {
+            AddSharedBuffer( buffer.pBuf, bufferCL );
             m_bufferMap[buffer.pBuf] = { bufferCL };
         }
     }
@@ -580,7 +1627,7 @@ QCStatus_e OpenclSrv::DeregBuf( const QCBuffer_t *pBuffer )
         auto it = m_bufferMap.find( pBuffer->pData );
         if ( it != m_bufferMap.end() )
         {
-            retCL = clReleaseMemObject( it->second.clMem );
+            retCL = ReleaseBuffer( it->first, it->second.clMem );
             if ( CL_SUCCESS != retCL )
             {
                 QC_ERROR( "Unable to release CL buffer, retCL = %d", retCL );
@@ -653,7 +1700,7 @@ QCStatus_e OpenclSrv::DeregBufferDesc( QCBufferDescriptorBase_t &buffer )
     auto it = m_bufferMap.find( buffer.pBuf );
     if ( it != m_bufferMap.end() )
     {
-        retCL = clReleaseMemObject( it->second.clMem );
+        retCL = ReleaseBuffer( it->first, it->second.clMem );
         if ( CL_SUCCESS != retCL )
         {
             QC_ERROR( "Unable to release CL buffer, retCL = %d", retCL );
@@ -672,6 +1719,21 @@ QCStatus_e OpenclSrv::Execute( const cl_kernel *pKernel, const OpenclIfcae_Arg_t
                                size_t numOfArgs, const OpenclIface_WorkParams_t *pWorkParam )
 {
     QCStatus_e ret = QC_STATUS_OK;
+
+    ret = ExecuteAsync( pKernel, pArgs, numOfArgs, pWorkParam );
+    if ( QC_STATUS_OK == ret )
+    {
+        ret = Finish();
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::ExecuteAsync( const cl_kernel *pKernel, const OpenclIfcae_Arg_t *pArgs,
+                                    size_t numOfArgs, const OpenclIface_WorkParams_t *pWorkParam,
+                                    cl_event *pEvent )
+{
+    QCStatus_e ret = QC_STATUS_OK;
     cl_int retCL = CL_SUCCESS;
 
     for ( int i = 0; i < numOfArgs; i++ )
@@ -686,28 +1748,404 @@ QCStatus_e OpenclSrv::Execute( const cl_kernel *pKernel, const OpenclIfcae_Arg_t
 
     if ( QC_STATUS_OK == ret )
     {
+        size_t localWorkSize[3];
+        size_t *pLocalWorkSize = pWorkParam->pLocalWorkSize;
+        if ( ( nullptr == pLocalWorkSize ) && ( false == m_tuningPath.empty() ) &&
+             GetTunedSize( *pKernel, pWorkParam, localWorkSize ) )
+        {
+            pLocalWorkSize = localWorkSize;
+        }
+
+        /* the profiling needs the event of the kernel even if the caller does not */
+        cl_event event = nullptr;
+        cl_event *pLaunchEvent = pEvent;
+        if ( m_bProfiling && ( nullptr == pLaunchEvent ) )
+        {
+            pLaunchEvent = &event;
+        }
+
+        /* the arguments are copied at enqueue, the kernel can be set up again for the next one */
         retCL = clEnqueueNDRangeKernel( m_commandQueue, *pKernel, pWorkParam->workDim,
                                         pWorkParam->pGlobalWorkOffset, pWorkParam->pGlobalWorkSize,
-                                        pWorkParam->pLocalWorkSize, 0, NULL, NULL );
+                                        pLocalWorkSize, 0, NULL, pLaunchEvent );
         if ( CL_SUCCESS != retCL )
         {
             QC_ERROR( "Unable to enqueue range kernel, retCL = %d", retCL );
             ret = QC_STATUS_FAIL;
         }
+        else if ( m_bProfiling )
+        {
+            ret = AddProfiledLaunch( *pKernel, *pLaunchEvent );
+        }
+        else
+        {
+            /* no timestamps recorded */
+        }
+
+        if ( nullptr != event )
+        {
+            (void) clReleaseEvent( event );
+        }
+    }
+
+    return ret;
+}
+
+/* the time from a timestamp to a later one, 0 if the device reports them out of order */
+static inline uint64_t Elapsed( cl_ulong from, cl_ulong to )
+{
+    return ( to > from ) ? ( to - from ) : 0;
+}
+
+QCStatus_e OpenclSrv::AddProfiledLaunch( cl_kernel kernel, cl_event event )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    char name[128] = { 0 };
+
+    cl_int retCL = clGetKernelInfo( kernel, CL_KERNEL_FUNCTION_NAME, sizeof( name ) - 1, name,
+                                    NULL );
+    if ( CL_SUCCESS == retCL )
+    {
+        retCL = clRetainEvent( event );
+    }
+
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to profile the kernel, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> l( m_profileLock );
+        CollectProfiles();
+        if ( OPENCLIFACE_PROFILE_PENDING_MAX <= m_profiledLaunches.size() )
+        {
+            /* bound the events kept when the caller never waits by Finish */
+            (void) clFlush( m_commandQueue );
+            (void) clWaitForEvents( 1, &m_profiledLaunches.front().event );
+            CollectProfiles();
+        }
+        m_profiledLaunches.push_back( { name, event } );
+    }
+
+    return ret;
+}
+
+void OpenclSrv::CollectProfiles()
+{
+    auto it = m_profiledLaunches.begin();
+    while ( m_profiledLaunches.end() != it )
+    {
+        cl_int eventStatus = CL_QUEUED;
+        cl_int retCL = clGetEventInfo( it->event, CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                       sizeof( eventStatus ), &eventStatus, NULL );
+        if ( ( CL_SUCCESS == retCL ) && ( CL_COMPLETE == eventStatus ) )
+        {
+            cl_ulong queued = 0;
+            cl_ulong submit = 0;
+            cl_ulong start = 0;
+            cl_ulong end = 0;
+            retCL = clGetEventProfilingInfo( it->event, CL_PROFILING_COMMAND_QUEUED,
+                                             sizeof( queued ), &queued, NULL );
+            if ( CL_SUCCESS == retCL )
+            {
+                retCL = clGetEventProfilingInfo( it->event, CL_PROFILING_COMMAND_SUBMIT,
+                                                 sizeof( submit ), &submit, NULL );
+            }
+            if ( CL_SUCCESS == retCL )
+            {
+                retCL = clGetEventProfilingInfo( it->event, CL_PROFILING_COMMAND_START,
+                                                 sizeof( start ), &start, NULL );
+            }
+            if ( CL_SUCCESS == retCL )
+            {
+                retCL = clGetEventProfilingInfo( it->event, CL_PROFILING_COMMAND_END,
+                                                 sizeof( end ), &end, NULL );
+            }
+
+            /* the kernels beyond QCNODE_GPU_PROFILE_KERNELS_MAX are only in the events */
+            auto profileIt = m_kernelProfiles.find( it->name );
+            if ( ( CL_SUCCESS == retCL ) && ( m_kernelProfiles.end() == profileIt ) &&
+                 ( QCNODE_GPU_PROFILE_KERNELS_MAX > m_kernelProfiles.size() ) )
+            {
+                QC::Node::QCNodeGpuKernelProfile_t newProfile = {};
+                (void) snprintf( newProfile.name, sizeof( newProfile.name ), "%s",
+                                 it->name.c_str() );
+                profileIt = m_kernelProfiles.emplace( it->name, newProfile ).first;
+            }
+
+            if ( CL_SUCCESS != retCL )
+            {
+                QC_ERROR( "Unable to get the timestamps of kernel %s, retCL = %d",
+                          it->name.c_str(), retCL );
+            }
+            else
+            {
+                if ( m_kernelProfiles.end() != profileIt )
+                {
+                    QC::Node::QCNodeGpuKernelProfile_t &profile = profileIt->second;
+                    uint64_t execNs = Elapsed( start, end );
+                    uint64_t execUs = execNs / 1000;
+                    uint32_t bin = 0;
+                    while ( ( 0 < execUs ) && ( QCNODE_GPU_PROFILE_BINS - 1 > bin ) )
+                    {
+                        execUs >>= 1;
+                        bin++;
+                    }
+                    profile.numLaunches++;
+                    profile.totalQueuedNs += Elapsed( queued, submit );
+                    profile.totalPendingNs += Elapsed( submit, start );
+                    profile.totalExecNs += execNs;
+                    profile.maxExecNs = std::max( profile.maxExecNs, execNs );
+                    profile.lastExecNs = execNs;
+                    profile.histogram[bin]++;
+                }
+
+                if ( OPENCLIFACE_PROFILE_EVENTS_MAX <= m_kernelEvents.size() )
+                {
+                    m_kernelEvents.pop_front();
+                }
+                m_kernelEvents.push_back( { it->name, queued, submit, start, end } );
+            }
+
+            (void) clReleaseEvent( it->event );
+            it = m_profiledLaunches.erase( it );
+        }
+        else if ( ( CL_SUCCESS != retCL ) || ( 0 > eventStatus ) )
+        {
+            /* the launch was aborted, it has no timestamps */
+            (void) clReleaseEvent( it->event );
+            it = m_profiledLaunches.erase( it );
+        }
         else
         {
-            retCL = clFinish( m_commandQueue );
+            ++it;
+        }
+    }
+}
+
+void OpenclSrv::ReleaseProfiles()
+{
+    std::lock_guard<std::mutex> l( m_profileLock );
+    for ( ProfiledLaunch_t &launch : m_profiledLaunches )
+    {
+        (void) clReleaseEvent( launch.event );
+    }
+    m_profiledLaunches.clear();
+    m_kernelProfiles.clear();
+    m_kernelEvents.clear();
+    m_bProfiling = false;
+}
+
+QCStatus_e OpenclSrv::GetKernelProfile( QC::Node::QCNodeGpuProfile_t &profile )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::lock_guard<std::mutex> l( m_profileLock );
+
+    if ( false == m_bProfiling )
+    {
+        ret = QC_STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        CollectProfiles();
+        profile.numKernels = 0;
+        profile.reserved = 0;
+        for ( auto &it : m_kernelProfiles )
+        {
+            profile.kernels[profile.numKernels] = it.second;
+            profile.numKernels++;
+        }
+    }
+
+    return ret;
+}
+
+void OpenclSrv::GetKernelEvents( std::vector<OpenclIface_KernelEvent_t> &events )
+{
+    std::lock_guard<std::mutex> l( m_profileLock );
+
+    events.clear();
+    if ( m_bProfiling )
+    {
+        CollectProfiles();
+        events.assign( m_kernelEvents.begin(), m_kernelEvents.end() );
+        m_kernelEvents.clear();
+    }
+}
+
+void OpenclSrv::TraceKernelEvents( QC::QCNodeTraceIfs &trace )
+{
+    std::vector<OpenclIface_KernelEvent_t> events;
+
+    GetKernelEvents( events );
+    for ( size_t i = 0; i < events.size(); i++ )
+    {
+        trace.Trace( "GpuKernel", QC::QCNODE_TRACE_TYPE_EVENT,
+                     { QCNodeTraceArg( "kernel", events[i].name ),
+                       QCNodeTraceArg( "queued", events[i].queued ),
+                       QCNodeTraceArg( "submit", events[i].submit ),
+                       QCNodeTraceArg( "start", events[i].start ),
+                       QCNodeTraceArg( "end", events[i].end ) } );
+    }
+}
+
+QCStatus_e OpenclSrv::EnqueueMarker( cl_event *pEvent )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = clEnqueueMarkerWithWaitList( m_commandQueue, 0, NULL, pEvent );
+
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to enqueue marker, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::EnqueueBarrier()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = clEnqueueBarrierWithWaitList( m_commandQueue, 0, NULL, NULL );
+
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to enqueue barrier, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::SetBufferEvent( void *pData, cl_event event )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        auto it = m_pShared->bufferMap.find( pData );
+        if ( m_pShared->bufferMap.end() == it )
+        {
+            QC_ERROR( "Buffer %p not registered in shared context %s", pData,
+                      m_sharedName.c_str() );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            cl_int retCL = clRetainEvent( event );
             if ( CL_SUCCESS != retCL )
             {
-                QC_ERROR( "Unable to finish command queue, retCL = %d", retCL );
+                QC_ERROR( "Unable to retain event, retCL = %d", retCL );
                 ret = QC_STATUS_FAIL;
             }
+            else
+            {
+                if ( nullptr != it->second.lastWrite )
+                {
+                    (void) clReleaseEvent( it->second.lastWrite );
+                }
+                it->second.lastWrite = event;
+            }
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::WaitBuffers( void *const *ppData, uint32_t numOfBuffers )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    std::vector<cl_event> events;
+
+    if ( nullptr != m_pShared )
+    {
+        std::lock_guard<std::mutex> l( sg_sharedLock );
+        for ( uint32_t i = 0; i < numOfBuffers; i++ )
+        {
+            auto it = m_pShared->bufferMap.find( ppData[i] );
+            if ( ( m_pShared->bufferMap.end() != it ) && ( nullptr != it->second.lastWrite ) )
+            {
+                cl_int eventStatus = CL_QUEUED;
+                cl_int retCL = clGetEventInfo( it->second.lastWrite,
+                                               CL_EVENT_COMMAND_EXECUTION_STATUS,
+                                               sizeof( eventStatus ), &eventStatus, NULL );
+                if ( ( CL_SUCCESS == retCL ) && ( CL_COMPLETE == eventStatus ) )
+                {
+                    /* already written, nothing to wait for */
+                    (void) clReleaseEvent( it->second.lastWrite );
+                    it->second.lastWrite = nullptr;
+                }
+                else if ( CL_SUCCESS == clRetainEvent( it->second.lastWrite ) )
+                {
+                    events.push_back( it->second.lastWrite );
+                }
+                else
+                {
+                    QC_ERROR( "Unable to retain event of buffer %p", ppData[i] );
+                    ret = QC_STATUS_FAIL;
+                }
+            }
+        }
+    }
+
+    if ( false == events.empty() )
+    {
+        cl_int retCL = clEnqueueBarrierWithWaitList( m_commandQueue, (cl_uint) events.size(),
+                                                     events.data(), NULL );
+        if ( CL_SUCCESS != retCL )
+        {
+            QC_ERROR( "Unable to enqueue barrier, retCL = %d", retCL );
+            ret = QC_STATUS_FAIL;
+        }
+        for ( cl_event event : events )
+        {
+            (void) clReleaseEvent( event );
         }
     }
 
     return ret;
 }
 
+QCStatus_e OpenclSrv::Flush()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = clFlush( m_commandQueue );
+
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to flush command queue, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+
+    return ret;
+}
+
+QCStatus_e OpenclSrv::Finish()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    cl_int retCL = clFinish( m_commandQueue );
+
+    if ( CL_SUCCESS != retCL )
+    {
+        QC_ERROR( "Unable to finish command queue, retCL = %d", retCL );
+        ret = QC_STATUS_FAIL;
+    }
+    else if ( m_bProfiling )
+    {
+        /* all the launches are complete, their events are released at once */
+        std::lock_guard<std::mutex> l( m_profileLock );
+        CollectProfiles();
+    }
+    else
+    {
+        /* no timestamps to read */
+    }
+
+    return ret;
+}
+
 }   // namespace OpenclIface
 }   // namespace libs
 }   // namespace QC
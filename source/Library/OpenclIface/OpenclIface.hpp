@@ -7,13 +7,19 @@
 #include <CL/cl.h>
 #include <CL/cl_ext.h>
 #include <CL/cl_ext_qcom.h>
+#include <array>
+#include <deque>
 #include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "QC/Common/Types.hpp"
 #include "QC/Infras/Log/Logger.hpp"
+#include "QC/Infras/NodeTrace/GpuProfile.hpp"
 #include "QC/Infras/Memory/ImageDescriptor.hpp"
 #include "QC/Infras/Memory/TensorDescriptor.hpp"
+#include "QC/Infras/NodeTrace/Ifs/QCNodeTraceIfs.hpp"
 
 using namespace QC;
 using namespace QC::Memory;
@@ -29,6 +35,51 @@ namespace OpenclIface
 ** Typedefs
 =================================================================================================*/
 
+/** @brief OpenCL program build options */
+#define OPENCLIFACE_BUILD_OPTIONS "-cl-fast-relaxed-math"
+
+/** @brief magic "QCLB" of the OpenCL program binary cache file */
+#define OPENCLIFACE_CACHE_MAGIC 0x424C4351u
+#define OPENCLIFACE_CACHE_VERSION 1u
+
+/**
+ * @brief The header of an OpenCL program binary cache file, followed by the program binary.
+ * @param magic The OPENCLIFACE_CACHE_MAGIC.
+ * @param version The OPENCLIFACE_CACHE_VERSION.
+ * @param key The hash of the program source, the build options and the device signature.
+ * @param binarySize The size of the program binary in bytes.
+ * @param checksum The FNV-1a hash of the program binary.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint64_t binarySize;
+    uint64_t checksum;
+} OpenclIface_CacheHeader_t;
+
+/** @brief magic "QCLT" and version of the first line of the work-group tuning database file */
+#define OPENCLIFACE_TUNING_MAGIC "QCLT"
+#define OPENCLIFACE_TUNING_VERSION 1u
+/** @brief the number of runs of each candidate local work size, the fastest run is kept */
+#define OPENCLIFACE_TUNING_RUNS 3
+
+/**
+ * @brief The tuned local work size of a kernel for a global work size.
+ * @param localWorkSize The local work size, all 0 for the size chosen by the driver.
+ * @param timeNs The execution time of the kernel with the local work size in nanoseconds.
+ */
+typedef struct
+{
+    size_t localWorkSize[3];
+    uint64_t timeNs;
+} OpenclIface_TuningEntry_t;
+
+/** @brief a kernel and its work dimensions and global work size, the sizes of the unused
+ * dimensions are 1 */
+typedef std::pair<cl_kernel, std::array<size_t, 4>> OpenclIface_TunedSizeKey_t;
+
 /** @brief OpenCL performance priority level */
 typedef enum
 {
@@ -38,6 +89,52 @@ typedef enum
     OPENCLIFACE_PERF_LOW     /**request lower priority for all submissions for any command*/
 } OpenclIfcae_Perf_e;
 
+/** @brief OpenCL command queue configuration */
+typedef struct
+{
+    std::string name; /**name of the queue in a shared context, the instances with the same name
+                         use the same queue, the default queue if empty*/
+    OpenclIfcae_Perf_e priority = OPENCLIFACE_PERF_NORMAL; /**queue priority hint of
+                                                              cl_khr_priority_hints*/
+    OpenclIfcae_Perf_e throttle = OPENCLIFACE_PERF_NORMAL; /**queue throttle hint of
+                                                              cl_khr_throttle_hints*/
+    bool bOutOfOrder = false; /**execute the commands out of order, ordered by events only*/
+    bool bProfiling = false;  /**record the GPU timestamps of the kernels*/
+} OpenclIface_QueueConfig_t;
+
+/**
+ * @brief Parse a performance level of the configuration of a node
+ * @param[in] level the level, "low", "normal" or "high"
+ * @param[out] perf the performance level, unchanged if the level is invalid
+ * @return true if the level is valid, false otherwise
+ * @note The same levels are used by the context priority and the queue priority and throttle
+ * hints.
+ */
+bool GetPerfLevel( const std::string &level, OpenclIfcae_Perf_e &perf );
+
+/** @brief the max number of the kernel launches waiting for their timestamps, the oldest is waited
+ * for when it is reached */
+#define OPENCLIFACE_PROFILE_PENDING_MAX 64u
+/** @brief the max number of the kernel events kept until GetKernelEvents, the oldest are dropped */
+#define OPENCLIFACE_PROFILE_EVENTS_MAX 256u
+
+/**
+ * @brief The GPU timestamps of a kernel launch, in nanoseconds of the device clock.
+ * @param name The name of the kernel.
+ * @param queued The time the kernel was enqueued.
+ * @param submit The time the kernel was submitted to the device.
+ * @param start The time the kernel started.
+ * @param end The time the kernel ended.
+ */
+typedef struct
+{
+    std::string name;
+    uint64_t queued;
+    uint64_t submit;
+    uint64_t start;
+    uint64_t end;
+} OpenclIface_KernelEvent_t;
+
 /** @brief OpenCL execute arguments structure */
 typedef struct
 {
@@ -60,6 +157,38 @@ typedef struct
     cl_mem clMem; /**OpenCL memory buffer*/
 } OpenclIface_MemInfo_t;
 
+/** @brief OpenCL memory of a shared context structure */
+typedef struct
+{
+    cl_mem clMem;       /**OpenCL memory buffer*/
+    uint32_t numUsers;  /**number of the OpenclSrv instances which registered the buffer*/
+    cl_event lastWrite; /**event of the last command writing the buffer, nullptr if none*/
+} OpenclIface_SharedMemInfo_t;
+
+/** @brief OpenCL command queue of a shared context structure */
+typedef struct
+{
+    cl_command_queue commandQueue;    /**OpenCL command queue*/
+    OpenclIface_QueueConfig_t config; /**configuration of the queue*/
+    bool bOutOfOrder;                 /**the queue executes the commands out of order*/
+    uint32_t numUsers;                /**number of the OpenclSrv instances using the queue*/
+} OpenclIface_SharedQueue_t;
+
+/** @brief OpenCL objects of a named context shared by the OpenclSrv instances of a process */
+typedef struct
+{
+    cl_platform_id platformID; /**OpenCL platform ID*/
+    cl_device_id deviceID;     /**OpenCL device ID*/
+    cl_context context;        /**OpenCL context*/
+    std::map<std::string, OpenclIface_SharedQueue_t> queues; /**OpenCL command queues by name*/
+    cl_sampler sampler;                                      /**OpenCL sampler*/
+    OpenclIfcae_Perf_e priority;   /**performance priority level of the context*/
+    uint32_t deviceId;             /**device ID of the context*/
+    uint32_t numUsers;             /**number of the OpenclSrv instances in the context*/
+    std::map<void *, OpenclIface_SharedMemInfo_t>
+            bufferMap; /**OpenCL buffer memory map of the buffers registered in the context*/
+} OpenclIface_SharedContext_t;
+
 class OpenclSrv
 {
 
@@ -82,6 +211,31 @@ public:
     QCStatus_e Init( const char *pName, Logger_Level_e level,
                      OpenclIfcae_Perf_e priority = OPENCLIFACE_PERF_NORMAL, uint32_t deviceId = 0 );
 
+    /**
+     * @brief Initialize the OpenclIface object in a named context shared within the process
+     * @param[in] pName the OpenclIface unique instance name
+     * @param[in] level the logger message level
+     * @param[in] priority the desired performance priority level
+     * @param[in] deviceId the device ID to be used
+     * @param[in] sharedContext the name of the shared context, empty for a private context
+     * @param[in] queueConfig the configuration of the command queue
+     * @return QC_STATUS_OK on success, others on failure
+     * @note The first instance of a name creates the context and the sampler, the others join
+     * them, with the same priority and device ID. The instances with the same queue name use the
+     * same command queue, with the same queue configuration, and their commands run in the order
+     * they are enqueued, while the queues of different names run concurrently by their priority
+     * and throttle hints. The buffers registered by RegBuf and RegBufferDesc are also shared, so a
+     * buffer passed between the nodes of the context is wrapped once. The program and the kernels
+     * stay per instance. Finish waits for the commands of all the instances of the queue. The
+     * shared objects are released by the Deinit of the last instance.
+     * A hint or the out-of-order mode not supported by the device is ignored with a warning.
+     * The profiling of the queue configuration is per instance, it is disabled with a warning
+     * when the instance joins a queue created without it.
+     */
+    QCStatus_e Init( const char *pName, Logger_Level_e level, OpenclIfcae_Perf_e priority,
+                     uint32_t deviceId, const std::string &sharedContext,
+                     const OpenclIface_QueueConfig_t &queueConfig = OpenclIface_QueueConfig_t() );
+
     /**
      * @brief Load OpenCL program from source file
      * @param[in] pSourceFile the OpenCL program source file string pointer
@@ -91,6 +245,18 @@ public:
      */
     QCStatus_e LoadFromSource( const char *pSourceFile );
 
+    /**
+     * @brief Load OpenCL program from source file through a program binary cache
+     * @param[in] pSourceFile the OpenCL program source file string pointer
+     * @param[in] cacheDir the directory of the program binary cache, empty to disable the cache
+     * @return QC_STATUS_OK on success, others on failure
+     * @note The program binary is looked up in the cache by a key of the source, the build options
+     * and the device signature. A missing, stale or corrupted binary is rebuilt from the source
+     * and stored into the cache, so that the source is only compiled on the first boot. A failure
+     * to store the binary is not an error. Must be called after Init.
+     */
+    QCStatus_e LoadFromSource( const char *pSourceFile, const std::string &cacheDir );
+
     /**
      * @brief Load OpenCL program from binary file
      * @param[in] pBinaryFile the OpenCL program binary file string pointer
@@ -100,6 +266,106 @@ public:
      */
     QCStatus_e LoadFromBinary( const unsigned char *pBinaryFile );
 
+    /**
+     * @brief Load OpenCL program from a program binary of the current device
+     * @param[in] pBinary the OpenCL program binary pointer
+     * @param[in] size the OpenCL program binary size
+     * @return QC_STATUS_OK on success, others on failure
+     * @note Create and build OpenCL program from a binary returned by GetProgramBinary on the same
+     * device and driver, the compilation of the source is skipped. Must be called after Init.
+     */
+    QCStatus_e LoadFromBinary( const unsigned char *pBinary, size_t size );
+
+    /**
+     * @brief Get the binary of the loaded OpenCL program
+     * @param[out] binary the OpenCL program binary for the current device
+     * @return QC_STATUS_OK on success, others on failure
+     * @note Must be called after LoadFromSource or LoadFromBinary.
+     */
+    QCStatus_e GetProgramBinary( std::vector<unsigned char> &binary );
+
+    /**
+     * @brief Get the signature of the current device
+     * @param[out] signature the device name, device version and driver version
+     * @return QC_STATUS_OK on success, others on failure
+     * @note A program binary is only valid for the device and driver with the same signature.
+     */
+    QCStatus_e GetDeviceSignature( std::string &signature );
+
+    /**
+     * @brief Get the key of a program binary of the current device
+     * @param[in] pSourceFile the OpenCL program source file string pointer
+     * @param[out] key the hash of the source, the build options and the device signature
+     * @return QC_STATUS_OK on success, others on failure
+     * @note A program binary cached by this key is only valid for the same source, build options,
+     * device and driver.
+     */
+    QCStatus_e GetProgramKey( const char *pSourceFile, uint64_t &key );
+
+    /**
+     * @brief Read a program binary from a program binary cache file
+     * @param[in] path the path of the cache file
+     * @param[in] key the expected key of the program binary
+     * @param[out] binary the program binary
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if the file does not exist,
+     * QC_STATUS_UNSUPPORTED if the format version or the key does not match, QC_STATUS_FAIL if the
+     * file is truncated or corrupted
+     */
+    static QCStatus_e ReadProgramCache( const std::string &path, uint64_t key,
+                                        std::vector<unsigned char> &binary );
+
+    /**
+     * @brief Write a program binary into a program binary cache file
+     * @param[in] path the path of the cache file, the missing parent directories are created
+     * @param[in] key the key of the program binary
+     * @param[in] binary the program binary
+     * @return QC_STATUS_OK on success, others on failure
+     * @note The file is written into a temporary file and then renamed, so that the other
+     * instances loading or saving the same program never see a partially written binary.
+     */
+    static QCStatus_e WriteProgramCache( const std::string &path, uint64_t key,
+                                         const std::vector<unsigned char> &binary );
+
+    /**
+     * @brief Use a database of the tuned local work sizes of the kernels
+     * @param[in] path the path of the tuning database file
+     * @param[in] bTune tune the kernels missing from the database at their first run
+     * @return QC_STATUS_OK on success, others on failure
+     * @note When the work parameters leave the local work size to the driver, Execute and
+     * ExecuteAsync use the size tuned for the kernel and the global work size. To tune one, the
+     * commands enqueued before are waited for, then the kernel is run OPENCLIFACE_TUNING_RUNS
+     * times with each candidate local work size, the driver choice included, on a profiling
+     * queue, the fastest is kept and the database is saved. So tuning must only be enabled for
+     * the kernels which give the same output when run again. A database tuned on another device
+     * or driver is discarded. Must be called after Init.
+     */
+    QCStatus_e LoadTuning( const std::string &path, bool bTune );
+
+    /**
+     * @brief Read the entries of a work-group tuning database file
+     * @param[in] path the path of the tuning database file
+     * @param[in] key the expected hash of the device signature
+     * @param[out] entries the tuned entries by kernel name and global work size, added to
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if the file does not exist,
+     * QC_STATUS_UNSUPPORTED if the format version or the key does not match
+     */
+    static QCStatus_e ReadTuning( const std::string &path, uint64_t key,
+                                  std::map<std::string, OpenclIface_TuningEntry_t> &entries );
+
+    /**
+     * @brief Write the entries of a work-group tuning database file
+     * @param[in] path the path of the tuning database file
+     * @param[in] key the hash of the device signature
+     * @param[in] entries the tuned entries by kernel name and global work size
+     * @return QC_STATUS_OK on success, others on failure
+     * @note The entries of the file of the same key are kept unless replaced, so the kernels
+     * tuned meanwhile by other instances are not lost, those of another key are dropped. The
+     * file is written into a temporary file and then renamed.
+     */
+    static QCStatus_e
+    WriteTuning( const std::string &path, uint64_t key,
+                 const std::map<std::string, OpenclIface_TuningEntry_t> &entries );
+
     /**
      * @brief Create OpenCL kernel from OpenCL program
      * @param[in] pKernel the OpenCL kernel pointer
@@ -217,6 +483,145 @@ public:
     QCStatus_e Execute( const cl_kernel *pKernel, const OpenclIfcae_Arg_t *pArgs, size_t numOfArgs,
                         const OpenclIface_WorkParams_t *pWorkParam );
 
+    /**
+     * @brief Enqueue the OpenclIface kernel without waiting for its completion
+     * @param[in] pKernel the OpenCL kernel pointer
+     * @param[in] pArgs the arguments structure pointer for certain kernel
+     * @param[in] numOfArgs the arguments number
+     * @param[in] pWorkParam the work parameters structure pointer
+     * @param[out] pEvent the event of the kernel execution, nullptr if not needed, otherwise it
+     * must be released by clReleaseEvent
+     * @return QC_STATUS_OK on success, others on failure
+     * @note Same as Execute, but returns once the kernel is enqueued. The kernels run in the order
+     * they are enqueued, so the kernels of several inputs can be enqueued back-to-back and waited
+     * once by Finish or by the event of the last one. With the profiling, the event of the kernel
+     * is kept until its timestamps are read by a later ExecuteAsync, Finish, GetKernelProfile or
+     * GetKernelEvents.
+     */
+    QCStatus_e ExecuteAsync( const cl_kernel *pKernel, const OpenclIfcae_Arg_t *pArgs,
+                             size_t numOfArgs, const OpenclIface_WorkParams_t *pWorkParam,
+                             cl_event *pEvent = nullptr );
+
+    /**
+     * @brief Enqueue a marker which completes when all the commands enqueued before it complete
+     * @param[out] pEvent the event of the marker, must be released by clReleaseEvent
+     * @return QC_STATUS_OK on success, others on failure
+     * @note A completion callback can be set on the event by clSetEventCallback.
+     */
+    QCStatus_e EnqueueMarker( cl_event *pEvent );
+
+    /**
+     * @brief Enqueue a barrier which completes when all the commands enqueued before it complete
+     * @return QC_STATUS_OK on success, others on failure
+     * @note The commands enqueued after the barrier do not start before it completes, even on an
+     * out-of-order queue.
+     */
+    QCStatus_e EnqueueBarrier();
+
+    /**
+     * @brief Check if the command queue executes the commands out of order
+     * @return true if the commands may run out of order, false otherwise
+     * @note The commands of an out-of-order queue only wait for the events, markers and barriers
+     * they depend on, so independent kernels can overlap on the device.
+     */
+    bool IsOutOfOrder() { return m_bOutOfOrder; }
+
+    /**
+     * @brief Get the command queue
+     * @return the OpenCL command queue, the one of its queueName in a shared context
+     */
+    cl_command_queue GetCommandQueue() { return m_commandQueue; }
+
+    /**
+     * @brief Record the event of the last command writing a buffer
+     * @param[in] pData the host pointer of the buffer registered by RegBuf or RegBufferDesc
+     * @param[in] event the event, retained until the next write or the release of the buffer
+     * @return QC_STATUS_OK on success, others on failure
+     * @note For a shared context, the other instances wait for the event by WaitBuffers before
+     * reading the buffer, so the producer can pass the buffer on once its commands are enqueued,
+     * without a synchronization on the host. Nothing is recorded for a private context.
+     */
+    QCStatus_e SetBufferEvent( void *pData, cl_event event );
+
+    /**
+     * @brief Make the commands enqueued next wait for the last writes of buffers
+     * @param[in] ppData the host pointers of the buffers
+     * @param[in] numOfBuffers the number of buffers
+     * @return QC_STATUS_OK on success, others on failure
+     * @note Enqueue a barrier with the events recorded by SetBufferEvent for the buffers which
+     * are not complete yet, nothing if there is none or for a private context.
+     */
+    QCStatus_e WaitBuffers( void *const *ppData, uint32_t numOfBuffers );
+
+    /**
+     * @brief Submit the enqueued commands to the device without waiting for them
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Flush();
+
+    /**
+     * @brief Wait for the completion of all the enqueued commands
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Finish();
+
+    /**
+     * @brief Check if the GPU timestamps of the kernels are recorded
+     * @return true if the queue configuration enabled the profiling and the queue supports it
+     */
+    bool IsProfiling()
+    {
+        std::lock_guard<std::mutex> l( m_profileLock );
+        return m_bProfiling;
+    }
+
+    /**
+     * @brief Get the GPU timestamps of the kernels aggregated by kernel name
+     * @param[out] profile the aggregated profile of the kernels
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if the profiling is not enabled
+     * @note The launches completed so far are collected first, the launches still running are
+     * counted by a later call. Up to QCNODE_GPU_PROFILE_KERNELS_MAX kernels are profiled.
+     */
+    QCStatus_e GetKernelProfile( QC::Node::QCNodeGpuProfile_t &profile );
+
+    /**
+     * @brief Take the GPU timestamps of the kernel launches completed since the last call
+     * @param[out] events the timestamps of the launches, in the order of their completion
+     * @note Up to OPENCLIFACE_PROFILE_EVENTS_MAX launches are kept, nothing if the profiling is
+     * not enabled.
+     */
+    void GetKernelEvents( std::vector<OpenclIface_KernelEvent_t> &events );
+
+    /**
+     * @brief Trace the kernel launches completed since the last call, one "GpuKernel" event each
+     * @param[in] trace the trace of the node that launched the kernels
+     * @note The timestamps are of the device clock, in nanoseconds.
+     */
+    void TraceKernelEvents( QC::QCNodeTraceIfs &trace );
+
+
+private:
+    QCStatus_e Tune( cl_kernel kernel, const OpenclIface_WorkParams_t *pWorkParam,
+                     OpenclIface_TuningEntry_t &entry );
+    bool GetTunedSize( cl_kernel kernel, const OpenclIface_WorkParams_t *pWorkParam,
+                       size_t *pLocalWorkSize );
+    bool HasExtension( const char *pExtension );
+    cl_int CreateQueue();
+    QCStatus_e JoinSharedContext( OpenclIface_SharedContext_t &shared );
+    bool GetSharedBuffer( void *pData, cl_mem &bufferCL );
+    void AddSharedBuffer( void *pData, cl_mem &bufferCL );
+    cl_int ReleaseBuffer( void *pData, cl_mem bufferCL );
+    void LeaveSharedContext();
+    QCStatus_e AddProfiledLaunch( cl_kernel kernel, cl_event event );
+    void CollectProfiles();
+    void ReleaseProfiles();
+
+    /* a kernel launch waiting for its timestamps */
+    typedef struct
+    {
+        std::string name; /**name of the kernel*/
+        cl_event event;   /**event of the launch, retained until its timestamps are read*/
+    } ProfiledLaunch_t;
 
 private:
     cl_platform_id m_platformID;                         /**OpenCL platform ID*/
@@ -229,6 +634,24 @@ private:
     std::map<std::pair<void *, uint32_t>, OpenclIface_MemInfo_t>
             m_planeMap;                           /**OpenCL plane memory map*/
     std::map<std::string, cl_kernel> m_kernelMap; /**OpenCL kernel map*/
+    std::string m_tuningPath; /**path of the tuning database, empty if not used*/
+    bool m_bTune = false;     /**tune the kernels missing from the tuning database*/
+    uint64_t m_tuningKey = 0; /**hash of the device signature of the tuning database*/
+    std::map<std::string, OpenclIface_TuningEntry_t>
+            m_tuningMap; /**tuned local work sizes by kernel name and global work size*/
+    std::map<OpenclIface_TunedSizeKey_t, std::array<size_t, 3>>
+            m_tunedSizes; /**local work sizes of the launched kernels, all 0 if not tuned*/
+    cl_command_queue m_profilingQueue = nullptr; /**OpenCL command queue to time the tuning*/
+    OpenclIface_QueueConfig_t m_queueConfig;     /**OpenCL command queue configuration*/
+    bool m_bOutOfOrder = false;              /**the command queue executes out of order*/
+    std::string m_sharedName; /**name of the shared context, empty for a private context*/
+    OpenclIface_SharedContext_t *m_pShared = nullptr; /**shared context, nullptr if private*/
+    bool m_bProfiling = false; /**the GPU timestamps of the kernels are recorded*/
+    std::mutex m_profileLock;  /**lock of the profiles, read by the monitoring of another thread*/
+    std::deque<ProfiledLaunch_t> m_profiledLaunches; /**launches waiting for their timestamps*/
+    std::map<std::string, QC::Node::QCNodeGpuKernelProfile_t>
+            m_kernelProfiles; /**GPU profiles by kernel name*/
+    std::deque<OpenclIface_KernelEvent_t> m_kernelEvents; /**launches not taken yet*/
 
 public:
     cl_sampler m_sampler; /**OpenCL sampler*/
@@ -38,117 +38,150 @@ std::string DataTree::Dump()
     return m_json.dump();
 }
 
-bool DataTree::Exists( const std::string &key )
+DataTree::Path::Path( const std::string &key ) : m_key( key )
+{
+    size_t start = 0;
+    size_t pos;
+
+    do
+    {
+        pos = key.find( '.', start );
+        m_tokens.push_back( key.substr( start, pos - start ) );
+        start = pos + 1;
+    } while ( std::string::npos != pos );
+}
+
+const json *DataTree::Find( const std::string &key ) const
 {
-    std::istringstream ss( key );
-    std::string token;
     const json *pCurrent = &m_json;
-    bool bExists = true;
+    std::string token;
+    size_t start = 0;
+    size_t pos;
 
-    while ( std::getline( ss, token, '.' ) )
+    do
     {
-        if ( pCurrent->contains( token ) )
+        pos = key.find( '.', start );
+        token.assign( key, start, pos - start );
+        auto it = pCurrent->find( token );
+        if ( pCurrent->end() != it )
         {
-            pCurrent = &( ( *pCurrent )[token] );
+            pCurrent = &( *it );
         }
         else
         {
-            bExists = false;
+            pCurrent = nullptr;
         }
-    }
+        start = pos + 1;
+    } while ( ( nullptr != pCurrent ) && ( std::string::npos != pos ) );
 
-    return bExists;
+    return pCurrent;
 }
 
-QCStatus_e DataTree::Get( const std::string &key, DataTree &dt )
+const json *DataTree::Find( const Path &path ) const
 {
-    std::istringstream ss( key );
-    std::string token;
     const json *pCurrent = &m_json;
-    QCStatus_e status = QC_STATUS_OK;
-    bool bHasKey = true;
 
-    while ( std::getline( ss, token, '.' ) )
+    for ( auto &token : path.GetTokens() )
     {
-        if ( pCurrent->contains( token ) )
+        auto it = pCurrent->find( token );
+        if ( pCurrent->end() != it )
         {
-            pCurrent = &( ( *pCurrent )[token] );
+            pCurrent = &( *it );
         }
         else
         {
-            status = QC_STATUS_OUT_OF_BOUND;
+            pCurrent = nullptr;
+            break;
         }
     }
 
-    if ( QC_STATUS_OK == status )
+    return pCurrent;
+}
+
+bool DataTree::Exists( const std::string &key )
+{
+    return nullptr != Find( key );
+}
+
+bool DataTree::Exists( const Path &path )
+{
+    return nullptr != Find( path );
+}
+
+QCStatus_e DataTree::ToDataTree( const json *pValue, DataTree &dt )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( nullptr == pValue )
     {
-        dt = DataTree( *pCurrent );
+        status = QC_STATUS_OUT_OF_BOUND;
+    }
+    else
+    {
+        dt = DataTree( *pValue );
     }
 
     return status;
 }
 
-QCStatus_e DataTree::Get( const std::string &key, std::vector<DataTree> &dts )
+QCStatus_e DataTree::ToDataTrees( const json *pValue, std::vector<DataTree> &dts )
 {
-    std::istringstream ss( key );
-    std::string token;
-    const json *pCurrent = &m_json;
     QCStatus_e status = QC_STATUS_OK;
 
-    while ( std::getline( ss, token, '.' ) )
+    if ( nullptr == pValue )
     {
-        if ( pCurrent->contains( token ) )
-        {
-            pCurrent = &( ( *pCurrent )[token] );
-        }
-        else
-        {
-            status = QC_STATUS_OUT_OF_BOUND;
-        }
+        status = QC_STATUS_OUT_OF_BOUND;
     }
-
-    if ( QC_STATUS_OK == status )
+    else if ( pValue->is_array() )
     {
-        if ( pCurrent->is_array() )
+        for ( auto &js : *pValue )
         {
-            for ( auto &js : *pCurrent )
-            {
-                dts.push_back( DataTree( js ) );
-            }
-        }
-        else
-        {
-            status = QC_STATUS_BAD_ARGUMENTS;
+            dts.push_back( DataTree( js ) );
         }
     }
+    else
+    {
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
 
     return status;
 }
 
-QCImageFormat_e DataTree::GetImageFormat( const std::string key, QCImageFormat_e dv )
+QCStatus_e DataTree::Get( const std::string &key, DataTree &dt )
+{
+    return ToDataTree( Find( key ), dt );
+}
+
+QCStatus_e DataTree::Get( const Path &path, DataTree &dt )
+{
+    return ToDataTree( Find( path ), dt );
+}
+
+QCStatus_e DataTree::Get( const std::string &key, std::vector<DataTree> &dts )
+{
+    return ToDataTrees( Find( key ), dts );
+}
+
+QCStatus_e DataTree::Get( const Path &path, std::vector<DataTree> &dts )
+{
+    return ToDataTrees( Find( path ), dts );
+}
+
+QCImageFormat_e DataTree::ToImageFormat( const json *pValue, QCImageFormat_e dv )
 {
     QCImageFormat_e retV;
-    std::istringstream ss( key );
-    std::string token;
-    std::string format;
-    const json *pCurrent = &m_json;
-    bool bHasKey = true;
 
-    while ( std::getline( ss, token, '.' ) )
+    if ( nullptr == pValue )
     {
-        if ( pCurrent->contains( token ) )
-        {
-            pCurrent = &( ( *pCurrent )[token] );
-        }
-        else
-        {
-            bHasKey = false;
-        }
+        retV = dv;
     }
-
-    if ( bHasKey )
+    else if ( false == pValue->is_string() )
     {
-        format = pCurrent->get<std::string>();
+        retV = QC_IMAGE_FORMAT_MAX;
+    }
+    else
+    {
+        const std::string &format = pValue->get_ref<const std::string &>();
         if ( "rgb" == format )
         {
             retV = QC_IMAGE_FORMAT_RGB888;
@@ -190,38 +223,35 @@ QCImageFormat_e DataTree::GetImageFormat( const std::string key, QCImageFormat_e
             retV = QC_IMAGE_FORMAT_MAX;
         }
     }
-    else
-    {
-        retV = dv;
-    }
 
     return retV;
 }
 
-QCTensorType_e DataTree::GetTensorType( const std::string key, QCTensorType_e dv )
+QCImageFormat_e DataTree::GetImageFormat( const std::string key, QCImageFormat_e dv )
+{
+    return ToImageFormat( Find( key ), dv );
+}
+
+QCImageFormat_e DataTree::GetImageFormat( const Path &path, QCImageFormat_e dv )
+{
+    return ToImageFormat( Find( path ), dv );
+}
+
+QCTensorType_e DataTree::ToTensorType( const json *pValue, QCTensorType_e dv )
 {
     QCTensorType_e retV;
-    std::istringstream ss( key );
-    std::string token;
-    std::string tensorType;
-    const json *pCurrent = &m_json;
-    bool bHasKey = true;
 
-    while ( std::getline( ss, token, '.' ) )
+    if ( nullptr == pValue )
     {
-        if ( pCurrent->contains( token ) )
-        {
-            pCurrent = &( ( *pCurrent )[token] );
-        }
-        else
-        {
-            bHasKey = false;
-        }
+        retV = dv;
     }
-
-    if ( bHasKey )
+    else if ( false == pValue->is_string() )
     {
-        tensorType = pCurrent->get<std::string>();
+        retV = QC_TENSOR_TYPE_MAX;
+    }
+    else
+    {
+        const std::string &tensorType = pValue->get_ref<const std::string &>();
         if ( "int8" == tensorType )
         {
             retV = QC_TENSOR_TYPE_INT_8;
@@ -295,38 +325,35 @@ QCTensorType_e DataTree::GetTensorType( const std::string key, QCTensorType_e dv
             retV = QC_TENSOR_TYPE_MAX;
         }
     }
-    else
-    {
-        retV = dv;
-    }
 
     return retV;
 }
 
-QCProcessorType_e DataTree::GetProcessorType( const std::string key, QCProcessorType_e dv )
+QCTensorType_e DataTree::GetTensorType( const std::string key, QCTensorType_e dv )
+{
+    return ToTensorType( Find( key ), dv );
+}
+
+QCTensorType_e DataTree::GetTensorType( const Path &path, QCTensorType_e dv )
+{
+    return ToTensorType( Find( path ), dv );
+}
+
+QCProcessorType_e DataTree::ToProcessorType( const json *pValue, QCProcessorType_e dv )
 {
     QCProcessorType_e retV;
-    std::istringstream ss( key );
-    std::string token;
-    std::string processor;
-    const json *pCurrent = &m_json;
-    bool bHasKey = true;
 
-    while ( std::getline( ss, token, '.' ) )
+    if ( nullptr == pValue )
     {
-        if ( pCurrent->contains( token ) )
-        {
-            pCurrent = &( ( *pCurrent )[token] );
-        }
-        else
-        {
-            bHasKey = false;
-        }
+        retV = dv;
     }
-
-    if ( bHasKey )
+    else if ( false == pValue->is_string() )
     {
-        processor = pCurrent->get<std::string>();
+        retV = QC_PROCESSOR_MAX;
+    }
+    else
+    {
+        const std::string &processor = pValue->get_ref<const std::string &>();
         if ( "htp0" == processor )
         {
             retV = QC_PROCESSOR_HTP0;
@@ -348,14 +375,20 @@ QCProcessorType_e DataTree::GetProcessorType( const std::string key, QCProcessor
             retV = QC_PROCESSOR_MAX;
         }
     }
-    else
-    {
-        retV = dv;
-    }
 
     return retV;
 }
 
+QCProcessorType_e DataTree::GetProcessorType( const std::string key, QCProcessorType_e dv )
+{
+    return ToProcessorType( Find( key ), dv );
+}
+
+QCProcessorType_e DataTree::GetProcessorType( const Path &path, QCProcessorType_e dv )
+{
+    return ToProcessorType( Find( path ), dv );
+}
+
 void DataTree::Set( const std::string &key, DataTree &dt )
 {
     std::istringstream ss( key );
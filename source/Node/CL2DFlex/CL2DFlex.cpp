@@ -41,7 +41,7 @@ QCStatus_e CL2DFlex::Initialize( QCNodeInit_t &config )
     if ( QC_STATUS_OK == status )
     {
         bNodeBaseInitDone = true;
-        status = m_pCL2DFlexImpl->Initialize( config.buffers );
+        status = m_pCL2DFlexImpl->Initialize( config.callback, config.buffers );
     }
 
     if ( QC_STATUS_OK != status )
@@ -103,5 +103,48 @@ QCObjectState_e CL2DFlex::GetState()
     return m_pCL2DFlexImpl->GetState();
 }
 
+uint32_t CL2DFlexMonitoring::GetMaximalSize()
+{
+    return sizeof( QCNodeGpuProfile_t );
+}
+
+uint32_t CL2DFlexMonitoring::GetCurrentSize()
+{
+    uint32_t size = 0;
+
+    if ( true == m_pCL2DFlexImpl->IsGpuProfiling() )
+    {
+        size = sizeof( QCNodeGpuProfile_t );
+    }
+
+    return size;
+}
+
+QCStatus_e CL2DFlexMonitoring::Place( void *ptr, uint32_t &size )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( nullptr == ptr )
+    {
+        QC_ERROR( "Place with null data" );
+        ret = QC_STATUS_NULL_PTR;
+    }
+    else if ( size < sizeof( QCNodeGpuProfile_t ) )
+    {
+        QC_ERROR( "Place with invalid size" );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        ret = m_pCL2DFlexImpl->GetGpuProfile( *(QCNodeGpuProfile_t *) ptr );
+        if ( QC_STATUS_OK == ret )
+        {
+            size = sizeof( QCNodeGpuProfile_t );
+        }
+    }
+
+    return ret;
+}
+
 }   // namespace Node
 }   // namespace QC
@@ -49,13 +49,16 @@ QCStatus_e CL2DFlexConfig::VerifyStaticConfig( DataTree &dt, std::string &errors
         if ( ( "convert" != mode ) && ( "resize_nearest" != mode ) &&
              ( "letterbox_nearest" != mode ) && ( "letterbox_nearest_multiple" != mode ) &&
              ( "resize_nearest_multiple" != mode ) && ( "convert_ubwc" != mode ) &&
-             ( "remap_nearest" != mode ) )
+             ( "remap_nearest" != mode ) && ( "resize_normalize" != mode ) &&
+             ( "letterbox_normalize" != mode ) )
         {
             errors += "the mode is invalid, ";
             status = QC_STATUS_BAD_ARGUMENTS;
         }
         if ( ( "letterbox_nearest_multiple" == mode ) || ( "resize_nearest_multiple" == mode ) )
         {
+            /* the ROIs buffer ID is optional, without it the ROIs of each frame are taken from a
+             * CL2DFlex_ROIImageDescriptor_t input */
             if ( !dt.Exists( "numOfROIs" ) )
             {
                 errors += "multiple work mode without number of ROIs, ";
@@ -71,14 +74,6 @@ QCStatus_e CL2DFlexConfig::VerifyStaticConfig( DataTree &dt, std::string &errors
                 }
             }
         }
-        if ( ( "letterbox_nearest_multiple" == mode ) || ( "resize_nearest_multiple" == mode ) )
-        {
-            if ( !dt.Exists( "ROIsBufferId" ) )
-            {
-                errors += "multiple work mode without ROIs buffer ID, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-        }
         if ( "remap_nearest" == mode )
         {
             if ( ( !idt.Exists( "mapXBufferId" ) ) || ( !idt.Exists( "mapYBufferId" ) ) )
@@ -95,6 +90,79 @@ QCStatus_e CL2DFlexConfig::VerifyStaticConfig( DataTree &dt, std::string &errors
         status = QC_STATUS_BAD_ARGUMENTS;
     }
 
+    if ( dt.Exists( "normalizeMean" ) )
+    {
+        std::vector<float> mean = dt.Get<float>( "normalizeMean", std::vector<float>{} );
+        if ( 3 != mean.size() )
+        {
+            errors += "the normalizeMean is invalid, ";
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+    }
+
+    if ( dt.Exists( "normalizeStd" ) )
+    {
+        std::vector<float> stdDev = dt.Get<float>( "normalizeStd", std::vector<float>{} );
+        if ( 3 != stdDev.size() )
+        {
+            errors += "the normalizeStd is invalid, ";
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            for ( float value : stdDev )
+            {
+                if ( 0.0f == value )
+                {
+                    errors += "the normalizeStd has zero value, ";
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                }
+            }
+        }
+    }
+
+    std::string layout = dt.Get<std::string>( "tensorLayout", "nhwc" );
+    if ( ( "nhwc" != layout ) && ( "nchw" != layout ) )
+    {
+        errors += "the tensorLayout is invalid, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    QCProcessorType_e processorType = dt.GetProcessorType( "processorType", QC_PROCESSOR_GPU );
+    if ( ( QC_PROCESSOR_GPU != processorType ) && ( QC_PROCESSOR_CPU != processorType ) )
+    {
+        errors += "the processorType is invalid, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    std::string sharedContext = dt.Get<std::string>( "sharedContext", "" );
+    bool bNotifyOnEnqueue = dt.Get<bool>( "notifyOnEnqueue", false );
+    if ( bNotifyOnEnqueue && ( sharedContext.empty() || ( QC_PROCESSOR_GPU != processorType ) ) )
+    {
+        errors += "the notifyOnEnqueue needs the sharedContext on gpu, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    if ( dt.Get<bool>( "tuneWorkGroups", false ) &&
+         ( "" == dt.Get<std::string>( "tuningPath", "" ) ) )
+    {
+        errors += "the tuneWorkGroups needs the tuningPath, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    OpenclIfcae_Perf_e perf;
+    if ( false == GetPerfLevel( dt.Get<std::string>( "queuePriority", "normal" ), perf ) )
+    {
+        errors += "the queuePriority is invalid, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    if ( false == GetPerfLevel( dt.Get<std::string>( "queueThrottle", "normal" ), perf ) )
+    {
+        errors += "the queueThrottle is invalid, ";
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+
     std::vector<DataTree> globalBufferIdMap;
     status2 = dt.Get( "globalBufferIdMap", globalBufferIdMap );
     if ( QC_STATUS_OUT_OF_BOUND == status2 )
@@ -146,20 +214,8 @@ QCStatus_e CL2DFlexConfig::ParseStaticConfig( DataTree &dt, std::string &errors
         config.params.outputHeight = dt.Get<uint32_t>( "outputHeight", 1024 );
         config.params.outputFormat = dt.GetImageFormat( "outputFormat", QC_IMAGE_FORMAT_RGB888 );
 
-        std::string priority = dt.Get<std::string>( "priority", "normal" );
-        if ( "normal" == priority )
-        {
-            config.params.priority = OPENCLIFACE_PERF_NORMAL;
-        }
-        else if ( "high" == priority )
-        {
-            config.params.priority = OPENCLIFACE_PERF_HIGH;
-        }
-        else if ( "low" == priority )
-        {
-            config.params.priority = OPENCLIFACE_PERF_LOW;
-        }
-        else
+        if ( false == GetPerfLevel( dt.Get<std::string>( "priority", "normal" ),
+                                    config.params.priority ) )
         {
             errors += "the priority is invalid, ";
             status = QC_STATUS_BAD_ARGUMENTS;
@@ -216,6 +272,14 @@ QCStatus_e CL2DFlexConfig::ParseStaticConfig( DataTree &dt, std::string &errors
                 config.params.remapTable[inputId].mapYBufferId =
                         idt.Get<uint32_t>( "mapYBufferId", UINT32_MAX );
             }
+            else if ( "resize_normalize" == mode )
+            {
+                config.params.workModes[inputId] = CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE;
+            }
+            else if ( "letterbox_normalize" == mode )
+            {
+                config.params.workModes[inputId] = CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE;
+            }
             else
             {
                 config.params.workModes[inputId] = CL2DFLEX_WORK_MODE_RESIZE_NEAREST;
@@ -225,6 +289,23 @@ QCStatus_e CL2DFlexConfig::ParseStaticConfig( DataTree &dt, std::string &errors
         }
         config.params.numOfInputs = inputId;
 
+        std::vector<float> mean = dt.Get<float>( "normalizeMean", std::vector<float>{} );
+        std::vector<float> stdDev = dt.Get<float>( "normalizeStd", std::vector<float>{} );
+        for ( uint32_t i = 0; i < 3; i++ )
+        {
+            config.params.normalizeMean[i] = ( 3 == mean.size() ) ? mean[i] : 0.0f;
+            config.params.normalizeStd[i] = ( 3 == stdDev.size() ) ? stdDev[i] : 1.0f;
+        }
+        std::string layout = dt.Get<std::string>( "tensorLayout", "nhwc" );
+        if ( "nchw" == layout )
+        {
+            config.params.tensorLayout = CL2DFLEX_TENSOR_LAYOUT_NCHW;
+        }
+        else
+        {
+            config.params.tensorLayout = CL2DFLEX_TENSOR_LAYOUT_NHWC;
+        }
+
         config.bufferIds = dt.Get<uint32_t>( "bufferIds", std::vector<uint32_t>{} );
 
         std::vector<DataTree> globalBufferIdMap;
@@ -240,6 +321,22 @@ QCStatus_e CL2DFlexConfig::ParseStaticConfig( DataTree &dt, std::string &errors
 
         config.bDeRegisterAllBuffersWhenStop =
                 dt.Get<bool>( "deRegisterAllBuffersWhenStop", false );
+        config.programCacheDir = dt.Get<std::string>( "programCacheDir", "" );
+        config.bBatched = dt.Get<bool>( "batched", false );
+        config.processorType = dt.GetProcessorType( "processorType", QC_PROCESSOR_GPU );
+        config.cpuThreads = dt.Get<uint32_t>( "cpuThreads", 0 );
+        config.sharedContext = dt.Get<std::string>( "sharedContext", "" );
+        config.bNotifyOnEnqueue = dt.Get<bool>( "notifyOnEnqueue", false );
+        config.queueConfig.name = dt.Get<std::string>( "queueName", "" );
+        (void) GetPerfLevel( dt.Get<std::string>( "queuePriority", "normal" ),
+                             config.queueConfig.priority );
+        (void) GetPerfLevel( dt.Get<std::string>( "queueThrottle", "normal" ),
+                             config.queueConfig.throttle );
+        config.queueConfig.bOutOfOrder = dt.Get<bool>( "outOfOrder", false );
+        config.tuningPath = dt.Get<std::string>( "tuningPath", "" );
+        config.bTuneWorkGroups = dt.Get<bool>( "tuneWorkGroups", false );
+        config.queueConfig.bProfiling = ( QC_PROCESSOR_GPU == config.processorType ) &&
+                                        dt.Get<bool>( "gpuProfiling", false );
     }
     else
     {
@@ -2,13 +2,18 @@
 // SPDX-License-Identifier: BSD-3-Clause-Clear
 
 
+#include <algorithm>
+
 #include "CL2DFlexImpl.hpp"
 #include "kernel/CL2DFlex.cl.h"
 #include "pipeline/CL2DPipelineBase.hpp"
+#include "pipeline/CL2DPipelineBatch.hpp"
 #include "pipeline/CL2DPipelineConvert.hpp"
 #include "pipeline/CL2DPipelineConvertUBWC.hpp"
+#include "pipeline/CL2DPipelineCpu.hpp"
 #include "pipeline/CL2DPipelineLetterbox.hpp"
 #include "pipeline/CL2DPipelineLetterboxMultiple.hpp"
+#include "pipeline/CL2DPipelineNormalize.hpp"
 #include "pipeline/CL2DPipelineRemap.hpp"
 #include "pipeline/CL2DPipelineResize.hpp"
 #include "pipeline/CL2DPipelineResizeMultiple.hpp"
@@ -25,6 +30,13 @@ QCStatus_e CL2DFlexImpl::Start()
     QC_TRACE_BEGIN( "Start", {} );
     if ( QC_OBJECT_STATE_READY == m_state )
     {
+        if ( ( nullptr == m_pCpuWorkers ) && ( nullptr != m_callback ) &&
+             ( false == m_config.bNotifyOnEnqueue ) )
+        {
+            /* the callback is not called on the OpenCL thread of the event callbacks */
+            m_bNotifierStop = false;
+            m_notifierThread = std::thread( &CL2DFlexImpl::NotifierThreadMain, this );
+        }
         m_state = QC_OBJECT_STATE_RUNNING;
     }
     else
@@ -44,6 +56,22 @@ QCStatus_e CL2DFlexImpl::Stop()
     QC_TRACE_BEGIN( "Stop", {} );
     if ( QC_OBJECT_STATE_RUNNING == m_state )
     {
+        /* the frames in flight are done and notified before the buffers can be released */
+        if ( QC_PROCESSOR_GPU == m_config.processorType )
+        {
+            (void) m_OpenclSrvObj.Finish();
+        }
+        std::unique_lock<std::mutex> lock( m_notifyLock );
+        m_notifyCond.wait( lock, [this]() {
+            return CL2DFLEX_NOTIFY_PARAM_NUM == m_freeNotifyParams.size();
+        } );
+        m_bNotifierStop = true;
+        m_notifierCond.notify_all();
+        lock.unlock();
+        if ( m_notifierThread.joinable() )
+        {
+            m_notifierThread.join();
+        }
         m_state = QC_OBJECT_STATE_READY;
     }
     else
@@ -57,7 +85,60 @@ QCStatus_e CL2DFlexImpl::Stop()
 }
 
 QCStatus_e
-CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
+CL2DFlexImpl::SetupBatches( std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::vector<uint32_t> groups[CL2DFLEX_WORK_MODE_MAX];
+
+    /* group the batchable inputs by work mode, their formats are all NV12 to RGB888 */
+    for ( uint32_t inputId = 0; inputId < m_config.params.numOfInputs; inputId++ )
+    {
+        if ( CL2DPipelineBatch::IsBatchable( m_config.params, inputId ) )
+        {
+            groups[m_config.params.workModes[inputId]].push_back( inputId );
+        }
+    }
+
+    m_batchNum = 0;
+    for ( std::vector<uint32_t> &group : groups )
+    {
+        for ( size_t begin = 0; ( QC_STATUS_OK == status ) && ( begin < group.size() );
+              begin += CL2DFLEX_BATCH_MAX )
+        {
+            size_t end = std::min( group.size(), begin + CL2DFLEX_BATCH_MAX );
+            /* a single input gains nothing from a batch, it keeps its own pipeline */
+            if ( ( end - begin ) > 1 )
+            {
+                std::vector<uint32_t> inputIds( group.begin() + begin, group.begin() + end );
+                CL2DPipelineBatch *pBatch = new CL2DPipelineBatch( inputIds );
+                m_pCL2DBatch[m_batchNum] = pBatch;
+                m_batchNum++;
+                pBatch->InitLogger( "CL2DPipelineBatch", LOGGER_LEVEL_ERROR );
+                status = pBatch->Init( inputIds[0], &m_kernel[inputIds[0]], &m_config.params,
+                                       &m_OpenclSrvObj, buffers );
+                if ( QC_STATUS_OK != status )
+                {
+                    QC_ERROR( "Setup batch pipeline failed for inputId=%u!", inputIds[0] );
+                }
+                else
+                {
+                    for ( uint32_t inputId : inputIds )
+                    {
+                        m_bBatchedInput[inputId] = true;
+                    }
+                    QC_INFO( "Batch %u: %u inputs from inputId=%u", m_batchNum - 1,
+                             (uint32_t) inputIds.size(), inputIds[0] );
+                }
+            }
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e
+CL2DFlexImpl::Initialize( QCNodeEventCallBack_t callback,
+                          std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
 {
     QCStatus_e status = QC_STATUS_OK;
 
@@ -66,7 +147,8 @@ CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorB
         std::ostringstream oss;
         oss << "{";
         oss << "\"name\": \"" << m_nodeId.name << "\", ";
-        oss << "\"processor\": \"" << "gpu" << "\", ";
+        oss << "\"processor\": \""
+            << ( ( QC_PROCESSOR_CPU == m_config.processorType ) ? "cpu" : "gpu" ) << "\", ";
         oss << "\"coreIds\": [0]";
         oss << "}";
         return oss.str();
@@ -83,31 +165,95 @@ CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorB
         QC_INFO( "CL2DFLEX node version: %u.%u.%u", QCNODE_CL2DFLEX_VERSION_MAJOR,
                  QCNODE_CL2DFLEX_VERSION_MINOR, QCNODE_CL2DFLEX_VERSION_PATCH );
 
-        status = m_OpenclSrvObj.Init( "Opencl", LOGGER_LEVEL_ERROR, m_config.params.priority,
-                                      m_config.params.deviceId );
-        if ( QC_STATUS_OK != status )
+        if ( QC_PROCESSOR_CPU == m_config.processorType )
         {
-            QC_ERROR( "Init OpenCL failed!" );
-            status = QC_STATUS_FAIL;
+            /* no OpenCL device needed, the inputs are processed by the worker threads */
+            m_pCpuWorkers = new CL2DCpuWorkers();
+            status = m_pCpuWorkers->Init( m_config.cpuThreads );
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "Init CPU worker threads failed!" );
+            }
+            else
+            {
+                QC_INFO( "CL2DFlex on CPU with %u threads", m_pCpuWorkers->GetNumThreads() );
+            }
         }
         else
         {
-            status = m_OpenclSrvObj.LoadFromSource( s_pSourceCL2DFlex );
-        }
+            status = m_OpenclSrvObj.Init( "Opencl", LOGGER_LEVEL_ERROR, m_config.params.priority,
+                                          m_config.params.deviceId, m_config.sharedContext,
+                                          m_config.queueConfig );
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "Init OpenCL failed!" );
+                status = QC_STATUS_FAIL;
+            }
+            else
+            {
+                status = m_OpenclSrvObj.LoadFromSource( s_pSourceCL2DFlex,
+                                                        m_config.programCacheDir );
+            }
 
-        if ( QC_STATUS_OK != status )
-        {
-            QC_ERROR( "Load program from source file s_pSourceCL2DFlex failed!" );
-            status = QC_STATUS_FAIL;
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "Load program from source file s_pSourceCL2DFlex failed!" );
+                status = QC_STATUS_FAIL;
+            }
+            else if ( "" != m_config.tuningPath )
+            {
+                /* all the kernels of CL2DFlex give the same output when run again */
+                status = m_OpenclSrvObj.LoadTuning( m_config.tuningPath, m_config.bTuneWorkGroups );
+                if ( QC_STATUS_OK != status )
+                {
+                    QC_ERROR( "Load tuning database %s failed!", m_config.tuningPath.c_str() );
+                }
+            }
+            else
+            {
+                /* the driver chooses the local work sizes */
+            }
+
+            if ( ( QC_STATUS_OK == status ) && m_config.bBatched )
+            {
+                status = SetupBatches( buffers );
+            }
         }
-        else
+
+        if ( QC_STATUS_OK == status )
         {
+            /* the output is a tensor for the normalize work modes, used by all the inputs */
+            m_bTensorOutput = CL2DPipelineNormalize::IsNormalize( m_config.params, 0 );
             for ( uint32_t inputId = 0; inputId < m_config.params.numOfInputs; inputId++ )
             {
                 m_pCL2DPipeline[inputId] = nullptr;
                 CL2DFlex_Work_Mode_e workMode = m_config.params.workModes[inputId];
 
-                if ( CL2DFLEX_WORK_MODE_CONVERT == workMode )
+                if ( m_bBatchedInput[inputId] )
+                {
+                    /* processed by its batch */
+                }
+                else if ( nullptr != m_pCpuWorkers )
+                {
+                    if ( CL2DPipelineCpu::IsSupported( m_config.params, inputId ) )
+                    {
+                        m_pCL2DPipeline[inputId] = new CL2DPipelineCpu( *m_pCpuWorkers );
+                    }
+                    else
+                    {
+                        QC_ERROR( "CL2DFlex work mode not supported on CPU for inputId=%d!",
+                                  inputId );
+                        status = QC_STATUS_UNSUPPORTED;
+                    }
+                }
+                else if ( m_bTensorOutput !=
+                          CL2DPipelineNormalize::IsNormalize( m_config.params, inputId ) )
+                {
+                    QC_ERROR( "Normalize work mode not used by all inputs for inputId=%d!",
+                              inputId );
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                }
+                else if ( CL2DFLEX_WORK_MODE_CONVERT == workMode )
                 {
                     m_pCL2DPipeline[inputId] = new CL2DPipelineConvert();
                 }
@@ -135,19 +281,32 @@ CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorB
                 {
                     m_pCL2DPipeline[inputId] = new CL2DPipelineRemap();
                 }
+                else if ( ( CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE == workMode ) ||
+                          ( CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE == workMode ) )
+                {
+                    m_pCL2DPipeline[inputId] = new CL2DPipelineNormalize();
+                }
                 else
                 {
                     QC_ERROR( "Invalid CL2DFlex work mode for inputId=%d!", inputId );
                     status = QC_STATUS_BAD_ARGUMENTS;
                 }
 
-                if ( nullptr != m_pCL2DPipeline[inputId] )
+                if ( m_bBatchedInput[inputId] )
+                {
+                    /* setup by SetupBatches */
+                }
+                else if ( nullptr != m_pCL2DPipeline[inputId] )
                 {
                     m_pCL2DPipeline[inputId]->InitLogger( "CL2DPipeline", LOGGER_LEVEL_ERROR );
                     status = m_pCL2DPipeline[inputId]->Init( inputId, &m_kernel[inputId],
                                                              &m_config.params, &m_OpenclSrvObj,
                                                              buffers );
                 }
+                else if ( QC_STATUS_OK != status )
+                {
+                    /* error already reported */
+                }
                 else
                 {
                     QC_ERROR( "CL2D pipeline create failed for inputId=%d!", inputId );
@@ -167,8 +326,8 @@ CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorB
             status = SetupGlobalBufferIdMap();
         }
 
-        if ( QC_STATUS_OK == status )
-        {   // do buffer register during initialization
+        if ( ( QC_STATUS_OK == status ) && ( nullptr == m_pCpuWorkers ) )
+        {   // do buffer register during initialization, the CPU pipelines use the host pointers
             for ( uint32_t bufferId : m_config.bufferIds )
             {
                 if ( bufferId < buffers.size() )
@@ -191,6 +350,15 @@ CL2DFlexImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorB
 
         if ( QC_STATUS_OK == status )
         {
+            m_callback = callback;
+            m_freeNotifyParams.clear();
+            for ( NotifyParam_t &notifyParam : m_notifyParam )
+            {
+                notifyParam.pSelf = this;
+                notifyParam.pFrameDesc = nullptr;
+                notifyParam.eventStatus = CL_COMPLETE;
+                m_freeNotifyParams.push_back( &notifyParam );
+            }
             m_state = QC_OBJECT_STATE_READY;
         }
     }
@@ -212,11 +380,18 @@ QCStatus_e CL2DFlexImpl::DeInitialize()
     }
     else
     {
-        status2 = m_OpenclSrvObj.Deinit();
-        if ( QC_STATUS_OK != status2 )
+        if ( nullptr != m_pCpuWorkers )
+        {
+            m_pCpuWorkers->Deinit();
+        }
+        else
         {
-            QC_ERROR( "Release CL resources failed!" );
-            status = status2;
+            status2 = m_OpenclSrvObj.Deinit();
+            if ( QC_STATUS_OK != status2 )
+            {
+                QC_ERROR( "Release CL resources failed!" );
+                status = status2;
+            }
         }
 
         for ( uint32_t inputId = 0; inputId < m_config.params.numOfInputs; inputId++ )
@@ -232,6 +407,28 @@ QCStatus_e CL2DFlexImpl::DeInitialize()
                 }
                 delete m_pCL2DPipeline[inputId];
             }
+            m_bBatchedInput[inputId] = false;
+        }
+
+        for ( uint32_t batchId = 0; batchId < m_batchNum; batchId++ )
+        {
+            m_pCL2DBatch[batchId]->DeinitLogger();
+            status2 = m_pCL2DBatch[batchId]->Deinit();
+            if ( QC_STATUS_OK != status2 )
+            {
+                QC_ERROR( "Deinit batch pipeline failed for batchId=%u!", batchId );
+                status = status2;
+            }
+            delete m_pCL2DBatch[batchId];
+            m_pCL2DBatch[batchId] = nullptr;
+        }
+        m_batchNum = 0;
+
+        /* after the pipelines referring to it */
+        if ( nullptr != m_pCpuWorkers )
+        {
+            delete m_pCpuWorkers;
+            m_pCpuWorkers = nullptr;
         }
     }
     QC_TRACE_END( "DeInit", {} );
@@ -253,25 +450,68 @@ QCStatus_e CL2DFlexImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frame
         if ( QC_STATUS_OK == status )
         {
             uint32_t outputBufferId = m_config.globalBufferIdMap[m_inputNum].globalBufferId;
-            ImageDescriptor_t &outputBufDesc =
-                    dynamic_cast<ImageDescriptor_t &>( frameDesc.GetBuffer( outputBufferId ) );
-            if ( m_config.params.outputFormat != outputBufDesc.format )
+            QCBufferDescriptorBase_t &outputDesc = frameDesc.GetBuffer( outputBufferId );
+            ImageDescriptor_t *pOutputBufDesc = dynamic_cast<ImageDescriptor_t *>( &outputDesc );
+            TensorDescriptor_t *pOutputTensorDesc =
+                    dynamic_cast<TensorDescriptor_t *>( &outputDesc );
+            if ( m_bTensorOutput )
+            {
+                /* the tensor type, dims and quantization are checked by the pipelines */
+                if ( nullptr == pOutputTensorDesc )
+                {
+                    QC_ERROR( "Output buffer is not a tensor!" );
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                }
+            }
+            else if ( nullptr == pOutputBufDesc )
+            {
+                QC_ERROR( "Output buffer is not an image!" );
+                status = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else if ( m_config.params.outputFormat != pOutputBufDesc->format )
             {
                 QC_ERROR( "Output image format not match!" );
                 status = QC_STATUS_BAD_ARGUMENTS;
             }
-            else if ( m_config.params.outputWidth != outputBufDesc.width )
+            else if ( m_config.params.outputWidth != pOutputBufDesc->width )
             {
                 QC_ERROR( "Output image width not match!" );
                 status = QC_STATUS_BAD_ARGUMENTS;
             }
-            else if ( m_config.params.outputHeight != outputBufDesc.height )
+            else if ( m_config.params.outputHeight != pOutputBufDesc->height )
             {
                 QC_ERROR( "Output image height not match!" );
                 status = QC_STATUS_BAD_ARGUMENTS;
             }
             else
             {
+                /* the output image is valid */
+            }
+
+            if ( ( QC_STATUS_OK == status ) && ( nullptr == m_pCpuWorkers ) &&
+                 m_OpenclSrvObj.IsOutOfOrder() )
+            {
+                /* the inputs of this frame may overlap each other, but not the frames enqueued
+                 * before, which may still write the same output */
+                status = m_OpenclSrvObj.EnqueueBarrier();
+            }
+
+            if ( ( QC_STATUS_OK == status ) && ( nullptr == m_pCpuWorkers ) )
+            {
+                /* the kernels enqueued next wait on the GPU for the producers of the inputs in the
+                 * shared context, nothing is waited for in a private context */
+                void *pInputs[QC_MAX_INPUTS] = { nullptr };
+                for ( uint32_t inputId = 0; inputId < m_inputNum; inputId++ )
+                {
+                    uint32_t inputBufferId = m_config.globalBufferIdMap[inputId].globalBufferId;
+                    pInputs[inputId] = frameDesc.GetBuffer( inputBufferId ).pBuf;
+                }
+                status = m_OpenclSrvObj.WaitBuffers( pInputs, m_inputNum );
+            }
+
+            if ( QC_STATUS_OK == status )
+            {
+                ImageDescriptor_t *pInputBufDescs[QC_MAX_INPUTS] = { nullptr };
                 for ( uint32_t inputId = 0; inputId < m_inputNum; inputId++ )
                 {
                     uint32_t inputBufferId = m_config.globalBufferIdMap[inputId].globalBufferId;
@@ -297,6 +537,11 @@ QCStatus_e CL2DFlexImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frame
                         QC_ERROR( "Input image height not match for inputId=%d!", inputId );
                         status = QC_STATUS_BAD_ARGUMENTS;
                     }
+                    else if ( m_bBatchedInput[inputId] )
+                    {
+                        /* enqueued with the other inputs of its batch below */
+                        pInputBufDescs[inputId] = &inputBufDesc;
+                    }
                     else
                     {
                         if ( nullptr == m_pCL2DPipeline[inputId] )
@@ -308,8 +553,16 @@ QCStatus_e CL2DFlexImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frame
                         {
                             QC_TRACE_BEGIN( "Execute",
                                             { QCNodeTraceArg( "frameId", inputBufDesc.id ) } );
-                            status = m_pCL2DPipeline[inputId]->Execute( inputBufDesc,
-                                                                        outputBufDesc );
+                            if ( m_bTensorOutput )
+                            {
+                                status = m_pCL2DPipeline[inputId]->ExecuteTensor(
+                                        inputBufDesc, *pOutputTensorDesc );
+                            }
+                            else
+                            {
+                                status = m_pCL2DPipeline[inputId]->Execute( inputBufDesc,
+                                                                            *pOutputBufDesc );
+                            }
                             QC_TRACE_END( "Execute", {} );
                         }
                     }
@@ -319,18 +572,222 @@ QCStatus_e CL2DFlexImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frame
                         break;
                     }
                 }
+
+                for ( uint32_t batchId = 0; ( QC_STATUS_OK == status ) && ( batchId < m_batchNum );
+                      batchId++ )
+                {
+                    QC_TRACE_BEGIN( "ExecuteBatch", { QCNodeTraceArg( "batchId", batchId ) } );
+                    status = m_pCL2DBatch[batchId]->ExecuteBatch( pInputBufDescs,
+                                                                  *pOutputBufDesc );
+                    QC_TRACE_END( "ExecuteBatch", {} );
+                    if ( QC_STATUS_OK != status )
+                    {
+                        QC_ERROR( "Failed to execute batch pipeline for batchId=%u!", batchId );
+                    }
+                }
+
+                if ( QC_STATUS_OK == status )
+                {
+                    status = Submit( frameDesc, outputDesc.pBuf );
+                }
+                else if ( nullptr == m_pCpuWorkers )
+                {
+                    /* the kernels enqueued for the previous inputs still use the buffers */
+                    (void) m_OpenclSrvObj.Finish();
+                }
+                else
+                {
+                    /* the CPU pipelines are done on return */
+                }
             }
         }
     }
 
+    /* the kernels complete by now, those of an asynchronous frame by a later call */
+    QC_TRACE_IF( m_OpenclSrvObj.IsProfiling(), m_OpenclSrvObj.TraceKernelEvents( m_trace ) );
+
     return status;
 }
 
+QCStatus_e CL2DFlexImpl::Submit( QCFrameDescriptorNodeIfs &frameDesc, void *pOutput )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    NotifyParam_t *pNotifyParam = nullptr;
+    cl_event event = nullptr;
+
+    if ( nullptr != m_pCpuWorkers )
+    {
+        /* the CPU pipelines are done on return, the frame is notified at once */
+        if ( nullptr != m_callback )
+        {
+            QCNodeEventInfo_t info( frameDesc, m_nodeId, status, m_state );
+            m_callback( info );
+        }
+    }
+    else if ( nullptr == m_callback )
+    {
+        /* a single wait for the kernels of all the inputs */
+        status = m_OpenclSrvObj.Finish();
+    }
+    else if ( m_config.bNotifyOnEnqueue )
+    {
+        /* the consumers in the shared context wait for the event of the output on the GPU */
+        status = m_OpenclSrvObj.EnqueueMarker( &event );
+        if ( QC_STATUS_OK == status )
+        {
+            status = m_OpenclSrvObj.SetBufferEvent( pOutput, event );
+            (void) clReleaseEvent( event );
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            status = m_OpenclSrvObj.Flush();
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            QCNodeEventInfo_t info( frameDesc, m_nodeId, status, m_state );
+            m_callback( info );
+        }
+        else
+        {
+            (void) m_OpenclSrvObj.Finish();
+        }
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> l( m_notifyLock );
+            if ( false == m_freeNotifyParams.empty() )
+            {
+                pNotifyParam = m_freeNotifyParams.back();
+                m_freeNotifyParams.pop_back();
+            }
+        }
+
+        if ( nullptr == pNotifyParam )
+        {
+            QC_ERROR( "%u frames in flight, no free notify param!", CL2DFLEX_NOTIFY_PARAM_NUM );
+            status = QC_STATUS_FAIL;
+        }
+        else
+        {
+            pNotifyParam->pFrameDesc = &frameDesc;
+            status = m_OpenclSrvObj.EnqueueMarker( &event );
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            cl_int retCL = clSetEventCallback( event, CL_COMPLETE, EventCallback, pNotifyParam );
+            if ( CL_SUCCESS != retCL )
+            {
+                QC_ERROR( "Unable to set event callback, retCL = %d", retCL );
+                status = QC_STATUS_FAIL;
+            }
+            (void) clReleaseEvent( event );
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            /* the frame is reported by the callback from now on */
+            (void) m_OpenclSrvObj.Flush();
+        }
+        else
+        {
+            (void) m_OpenclSrvObj.Finish();
+            if ( nullptr != pNotifyParam )
+            {
+                std::lock_guard<std::mutex> l( m_notifyLock );
+                m_freeNotifyParams.push_back( pNotifyParam );
+                m_notifyCond.notify_all();
+            }
+        }
+    }
+
+    return status;
+}
+
+void CL_CALLBACK CL2DFlexImpl::EventCallback( cl_event event, cl_int eventStatus,
+                                              void *pUserData )
+{
+    NotifyParam_t *pNotifyParam = static_cast<NotifyParam_t *>( pUserData );
+
+    if ( nullptr != pNotifyParam )
+    {
+        pNotifyParam->pSelf->NotifyFn( *pNotifyParam, eventStatus );
+    }
+    else
+    {
+        QC_LOG_ERROR( "CL2DFlex notify with nullptr" );
+    }
+}
+
+void CL2DFlexImpl::NotifyFn( NotifyParam_t &notifyParam, cl_int eventStatus )
+{
+    /* only posted, the OpenCL thread of the event callbacks is not blocked by the callback */
+    std::lock_guard<std::mutex> l( m_notifyLock );
+    notifyParam.eventStatus = eventStatus;
+    m_doneNotifyParams.push_back( &notifyParam );
+    m_notifierCond.notify_one();
+}
+
+void CL2DFlexImpl::NotifierThreadMain()
+{
+    std::unique_lock<std::mutex> lock( m_notifyLock );
+
+    while ( true )
+    {
+        m_notifierCond.wait( lock, [this]() {
+            return m_bNotifierStop || ( false == m_doneNotifyParams.empty() );
+        } );
+        if ( m_doneNotifyParams.empty() )
+        {
+            /* stopped, all the frames in flight are notified */
+            break;
+        }
+
+        NotifyParam_t *pNotifyParam = m_doneNotifyParams.front();
+        m_doneNotifyParams.pop_front();
+        lock.unlock();
+
+        QCStatus_e status = QC_STATUS_OK;
+        if ( CL_COMPLETE != pNotifyParam->eventStatus )
+        {
+            QC_ERROR( "Frame execution failed, eventStatus = %d", pNotifyParam->eventStatus );
+            status = QC_STATUS_FAIL;
+        }
+        QCNodeEventInfo_t info( *pNotifyParam->pFrameDesc, m_nodeId, status, m_state );
+        m_callback( info );
+
+        /* released after the callback, so that Stop returns only when no callback is running */
+        lock.lock();
+        pNotifyParam->pFrameDesc = nullptr;
+        m_freeNotifyParams.push_back( pNotifyParam );
+        m_notifyCond.notify_all();
+    }
+}
+
 QCObjectState_e CL2DFlexImpl::GetState()
 {
     return m_state;
 }
 
+QCStatus_e CL2DFlexImpl::GetGpuProfile( QCNodeGpuProfile_t &profile )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( nullptr != m_pCpuWorkers )
+    {
+        status = QC_STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        status = m_OpenclSrvObj.GetKernelProfile( profile );
+    }
+
+    return status;
+}
+
 QCStatus_e CL2DFlexImpl::SetupGlobalBufferIdMap()
 {
     QCStatus_e status = QC_STATUS_OK;
@@ -6,15 +6,22 @@
 #define QC_CL2DFLEX_HPP
 
 #include <cinttypes>
+#include <condition_variable>
+#include <deque>
 #include <inttypes.h>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unistd.h>
 
 #include "OpenclIface.hpp"
 #include "QC/Infras/NodeTrace/NodeTrace.hpp"
 #include "QC/Node/CL2DFlex.hpp"
 
-#define QC_CL2DFLEX_ROI_NUMBER_MAX 100 /**<max number of roi parameters for ExecuteWithROI API*/
+#ifndef CL2DFLEX_NOTIFY_PARAM_NUM
+/* the max number of frames in flight when the callback is provided */
+#define CL2DFLEX_NOTIFY_PARAM_NUM 8u
+#endif
 
 namespace QC
 {
@@ -41,6 +48,26 @@ using namespace QC::libs::OpenclIface;
  * - The index N of QCFrameDescriptorNodeIfs will be output.
  * @param bDeRegisterAllBuffersWhenStop When the Stop API of the CL2DFlex node is called and
  * bDeRegisterAllBuffersWhenStop is true, deregister all buffers.
+ * @param programCacheDir The directory of the OpenCL program binary cache. Empty to disable the
+ * cache.
+ * @param bBatched Process the NV12 to RGB888 convert, resize and letterbox inputs of the same work
+ * mode with one kernel dispatch for up to CL2DFLEX_BATCH_MAX inputs.
+ * @param processorType The processor running the pipelines, QC_PROCESSOR_GPU for the OpenCL
+ * kernels or QC_PROCESSOR_CPU for the CPU pipelines, which need no OpenCL device.
+ * @param cpuThreads The number of threads of the CPU pipelines, including the thread calling
+ * ProcessFrameDescriptor, 0 for one thread per CPU core.
+ * @param sharedContext The name of the OpenCL context shared with the other GPU nodes of the
+ * process, empty for a private context.
+ * @param bNotifyOnEnqueue Notify the frame once its kernels are enqueued, the consumers in the
+ * shared context wait for the event of the output buffer on the GPU instead.
+ * @param queueConfig The name, the priority and throttle hints and the out-of-order mode of the
+ * OpenCL command queue, the inputs of a frame overlap on the GPU on an out-of-order queue.
+ * @param tuningPath The path of the database of the tuned local work sizes of the kernels, empty
+ * to let the driver choose them.
+ * @param bTuneWorkGroups Tune the kernels and global work sizes missing from the tuning database
+ * at their first run and save them into it.
+ * @note queueConfig.bProfiling records the GPU timestamps of the kernels for the monitoring and
+ * the node trace.
  */
 typedef struct CL2DFlexImplConfig : public QCNodeConfigBase_t
 {
@@ -48,9 +75,20 @@ typedef struct CL2DFlexImplConfig : public QCNodeConfigBase_t
     std::vector<uint32_t> bufferIds;
     std::vector<QCNodeBufferMapEntry_t> globalBufferIdMap;
     bool bDeRegisterAllBuffersWhenStop;
+    std::string programCacheDir;
+    bool bBatched;
+    QCProcessorType_e processorType = QC_PROCESSOR_GPU;
+    uint32_t cpuThreads = 0;
+    std::string sharedContext;
+    bool bNotifyOnEnqueue = false;
+    OpenclIface_QueueConfig_t queueConfig;
+    std::string tuningPath;
+    bool bTuneWorkGroups = false;
 } CL2DFlexImplConfig_t;
 
-class CL2DPipelineBase; /**<pipeline base class*/
+class CL2DPipelineBase;  /**<pipeline base class*/
+class CL2DPipelineBatch; /**<batch pipeline class*/
+class CL2DCpuWorkers;    /**<worker threads of the cpu pipelines*/
 
 class CL2DFlexImpl
 {
@@ -62,15 +100,34 @@ public:
           m_state( QC_OBJECT_STATE_INITIAL ) {};
     CL2DFlexImplConfig_t &GetConifg() { return m_config; }
 
-    QCStatus_e Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
+    QCStatus_e Initialize( QCNodeEventCallBack_t callback,
+                           std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
     QCStatus_e Start();
     QCStatus_e ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc );
     QCStatus_e Stop();
     QCStatus_e DeInitialize();
     QCObjectState_e GetState();
+    /* the GPU profile of the kernels, QC_STATUS_UNSUPPORTED if the profiling is not enabled */
+    QCStatus_e GetGpuProfile( QCNodeGpuProfile_t &profile );
+    /* the GPU timestamps of the kernels are recorded, the queue may not support the profiling */
+    bool IsGpuProfiling() { return m_OpenclSrvObj.IsProfiling(); }
+
+private:
+    /* the state of a frame executed asynchronously, until its completion is notified */
+    typedef struct
+    {
+        CL2DFlexImpl *pSelf;
+        QCFrameDescriptorNodeIfs *pFrameDesc;
+        cl_int eventStatus;
+    } NotifyParam_t;
 
 private:
     QCStatus_e SetupGlobalBufferIdMap();
+    QCStatus_e SetupBatches( std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
+    QCStatus_e Submit( QCFrameDescriptorNodeIfs &frameDesc, void *pOutput );
+    static void CL_CALLBACK EventCallback( cl_event event, cl_int eventStatus, void *pUserData );
+    void NotifyFn( NotifyParam_t &notifyParam, cl_int eventStatus );
+    void NotifierThreadMain();
 
 private:
     QCNodeID_t &m_nodeId;
@@ -81,10 +138,27 @@ private:
     OpenclSrv m_OpenclSrvObj;
     CL2DPipelineBase *m_pCL2DPipeline[QC_MAX_INPUTS] = { nullptr };
     cl_kernel m_kernel[QC_MAX_INPUTS];
+    CL2DPipelineBatch *m_pCL2DBatch[QC_MAX_INPUTS] = { nullptr };
+    uint32_t m_batchNum = 0;
+    bool m_bBatchedInput[QC_MAX_INPUTS] = { false };
+    bool m_bTensorOutput = false;
+    CL2DCpuWorkers *m_pCpuWorkers = nullptr;
 
     uint32_t m_inputNum;
     uint32_t m_outputNum = 1;
 
+    QCNodeEventCallBack_t m_callback = nullptr;
+    NotifyParam_t m_notifyParam[CL2DFLEX_NOTIFY_PARAM_NUM];
+    std::vector<NotifyParam_t *> m_freeNotifyParams;
+    std::mutex m_notifyLock;
+    std::condition_variable m_notifyCond;
+    /* the completed frames, posted by the OpenCL event callback and notified to the callback by
+     * the notifier thread of the node, in their order of completion */
+    std::deque<NotifyParam_t *> m_doneNotifyParams;
+    std::condition_variable m_notifierCond;
+    std::thread m_notifierThread;
+    bool m_bNotifierStop = false;
+
     QC_DECLARE_NODETRACE();
 
 };   // class CL2DFlexImpl
@@ -13,6 +13,10 @@ KernelCode(
         __constant float4 coeffUV4 = ( float4 )( 2.017999649f, -0.812999725f, -0.390999794f,
                                                  1.5959997177f );
 
+        /* the ROIs of a frame of the multiple work modes, it must match CL2DROIParams_t of
+         * CL2DROIParams.hpp */
+        typedef struct { int ROIs[128]; } CL2DROIParams_t;
+
 )
 
 #endif   // QC_CONSTANT_CLH
@@ -11,10 +11,12 @@ inline const char *Kernels()
 {
     static const char *kernels =
 #include "kernel/CL2DConstant.cl.h"
+#include "kernel/CL2DPipelineBatch.cl.h"
 #include "kernel/CL2DPipelineConvert.cl.h"
 #include "kernel/CL2DPipelineConvertUBWC.cl.h"
 #include "kernel/CL2DPipelineLetterbox.cl.h"
 #include "kernel/CL2DPipelineLetterboxMultiple.cl.h"
+#include "kernel/CL2DPipelineNormalize.cl.h"
 #include "kernel/CL2DPipelineRemap.cl.h"
 #include "kernel/CL2DPipelineResize.cl.h"
 #include "kernel/CL2DPipelineResizeMultiple.cl.h"
@@ -0,0 +1,173 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_PIPELINE_BATCH_CLH
+#define QC_CL2D_PIPELINE_BATCH_CLH
+
+/* the batched kernels compute the same pixels as the single input kernels, the third work
+ * dimension is the index of the input in the batch, its parameters are in the batch parameters
+ * which must match CL2DBatchParams_t of CL2DBatchParams.hpp */
+KernelCode(
+
+        typedef struct {
+            int srcOffset;
+            int dstOffset;
+            int inputStride0;
+            int inputPlane0Size;
+            int inputStride1;
+            int roiX;
+            int roiY;
+            int roiWidth;
+            int roiHeight;
+            float inputRatio;
+        } CL2DBatchParam_t;
+
+        typedef struct { CL2DBatchParam_t params[8]; } CL2DBatchParams_t;
+
+        __global const uchar *BatchSource( int i, __global const uchar *src0,
+                                           __global const uchar *src1, __global const uchar *src2,
+                                           __global const uchar *src3, __global const uchar *src4,
+                                           __global const uchar *src5, __global const uchar *src6,
+                                           __global const uchar *src7 ) {
+            __global const uchar *srcs[8] = { src0, src1, src2, src3, src4, src5, src6, src7 };
+            return srcs[i];
+        }
+
+        uchar3 BatchNV12ToRGBPixel( __global const uchar *ySrc, __global const uchar *uSrc,
+                                    int xIn, int yIn, int inputStride0, int inputStride1 ) {
+            int yPtr = mad24( yIn, inputStride0, xIn );
+            int uPtr = mad24( yIn / 2, inputStride1, ( xIn / 2 ) << 1 );
+            float Y = max( 0, ySrc[yPtr] - 16 ) * coeffY;
+            float2 UV = convert_float2( vload2( 0, uSrc + uPtr ) ) - 128.0f;
+            float4 UV4 = ( float4 )( UV, UV );
+            UV4 = mad( UV4, coeffUV4, 0.5f );
+            UV4.s1 = UV4.s1 + UV4.s2 - 0.5f;
+            UV4 += Y;
+            return convert_uchar3_sat( ( float3 )( UV4.s3, UV4.s1, UV4.s0 ) );
+        }
+
+        __kernel void ConvertNV12ToRGBBatch(
+                __global const uchar *src0, __global const uchar *src1, __global const uchar *src2,
+                __global const uchar *src3, __global const uchar *src4, __global const uchar *src5,
+                __global const uchar *src6, __global const uchar *src7, __global uchar *dstPtr,
+                CL2DBatchParams_t batch, int outputStride ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            int i = get_global_id( 2 );
+            CL2DBatchParam_t p = batch.params[i];
+            __global const uchar *srcPtr =
+                    BatchSource( i, src0, src1, src2, src3, src4, src5, src6, src7 );
+
+            int yOffset = p.srcOffset +
+                          mad24( ( y + p.roiY ) << 1, p.inputStride0, ( ( x + p.roiX ) << 1 ) );
+            int uOffset = p.srcOffset + p.inputPlane0Size +
+                          mad24( ( y + p.roiY ), p.inputStride1, ( ( x + p.roiX ) << 1 ) );
+            int dstOffset1 = p.dstOffset + mad24( y << 1, outputStride, x * 6 );
+            int dstOffset2 = dstOffset1 + outputStride;
+
+            float2 Y12 = convert_float2( vload2( 0, srcPtr + yOffset ) ) - 16.0f;
+            float2 Y34 = convert_float2( vload2( 0, srcPtr + yOffset + p.inputStride0 ) ) - 16.0f;
+            Y12 = max( 0, Y12 ) * coeffY;
+            Y34 = max( 0, Y34 ) * coeffY;
+
+            float2 UV = convert_float2( vload2( 0, srcPtr + uOffset ) ) - 128.0f;
+            float4 UV4 = ( float4 )( UV, UV );
+            UV4 = mad( UV4, coeffUV4, 0.5f );
+            UV4.s1 = UV4.s1 + UV4.s2 - 0.5f;
+
+            float4 Y1UV = UV4 + Y12.s0;
+            float4 Y2UV = UV4 + Y12.s1;
+            float4 Y3UV = UV4 + Y34.s0;
+            float4 Y4UV = UV4 + Y34.s1;
+
+            uchar4 dst1Val4 =
+                    convert_uchar4_sat( ( float4 )( Y1UV.s3, Y1UV.s1, Y1UV.s0, Y2UV.s3 ) );
+            uchar2 dst1Val2 = convert_uchar2_sat( ( float2 )( Y2UV.s1, Y2UV.s0 ) );
+            uchar4 dst2Val4 =
+                    convert_uchar4_sat( ( float4 )( Y3UV.s3, Y3UV.s1, Y3UV.s0, Y4UV.s3 ) );
+            uchar2 dst2Val2 = convert_uchar2_sat( ( float2 )( Y4UV.s1, Y4UV.s0 ) );
+
+            vstore4( dst1Val4, 0, dstPtr + dstOffset1 );
+            vstore2( dst1Val2, 2, dstPtr + dstOffset1 );
+            vstore4( dst2Val4, 0, dstPtr + dstOffset2 );
+            vstore2( dst2Val2, 2, dstPtr + dstOffset2 );
+        }
+
+        __kernel void ResizeNV12ToRGBBatch(
+                __global const uchar *src0, __global const uchar *src1, __global const uchar *src2,
+                __global const uchar *src3, __global const uchar *src4, __global const uchar *src5,
+                __global const uchar *src6, __global const uchar *src7, __global uchar *dstPtr,
+                CL2DBatchParams_t batch, int resizeHeight, int resizeWidth, int outputStride ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            int i = get_global_id( 2 );
+            CL2DBatchParam_t p = batch.params[i];
+            __global const uchar *srcPtr =
+                    BatchSource( i, src0, src1, src2, src3, src4, src5, src6, src7 );
+            __global const uchar *ySrc = srcPtr + p.srcOffset;
+            __global const uchar *uSrc = srcPtr + p.srcOffset + p.inputPlane0Size;
+            __global uchar *dst = dstPtr + p.dstOffset + mad24( y, outputStride, x * 3 );
+
+            int xIn = round( (float) ( x + p.roiX ) * native_recip( (float) resizeWidth ) *
+                             (float) p.roiWidth );
+            int yIn = round( (float) ( y + p.roiY ) * native_recip( (float) resizeHeight ) *
+                             (float) p.roiHeight );
+            uchar3 RGB =
+                    BatchNV12ToRGBPixel( ySrc, uSrc, xIn, yIn, p.inputStride0, p.inputStride1 );
+            vstore3( RGB, 0, dst );
+        }
+
+        __kernel void LetterboxNV12ToRGBBatch(
+                __global const uchar *src0, __global const uchar *src1, __global const uchar *src2,
+                __global const uchar *src3, __global const uchar *src4, __global const uchar *src5,
+                __global const uchar *src6, __global const uchar *src7, __global uchar *dstPtr,
+                CL2DBatchParams_t batch, int resizeHeight, int resizeWidth, int outputStride,
+                float outputRatio, int paddingValue ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            int i = get_global_id( 2 );
+            CL2DBatchParam_t p = batch.params[i];
+            __global const uchar *srcPtr =
+                    BatchSource( i, src0, src1, src2, src3, src4, src5, src6, src7 );
+            __global const uchar *ySrc = srcPtr + p.srcOffset;
+            __global const uchar *uSrc = srcPtr + p.srcOffset + p.inputPlane0Size;
+            __global uchar *dst = dstPtr + p.dstOffset + mad24( y, outputStride, x * 3 );
+            uchar3 RGB;
+            RGB.s0 = ( paddingValue >> 16 ) & 0xFF;
+            RGB.s1 = ( paddingValue >> 8 ) & 0xFF;
+            RGB.s2 = (paddingValue) &0xFF;
+            if ( p.inputRatio < outputRatio )
+            {
+                if ( y < ( resizeWidth * p.inputRatio ) )
+                {
+                    int xIn = round( (float) x * native_recip( (float) resizeWidth ) *
+                                     (float) p.roiWidth ) +
+                              p.roiX;
+                    int yIn = round( (float) y * native_recip( (float) resizeWidth ) *
+                                     (float) p.roiWidth ) +
+                              p.roiY;
+                    RGB = BatchNV12ToRGBPixel( ySrc, uSrc, xIn, yIn, p.inputStride0,
+                                               p.inputStride1 );
+                }
+            }
+            else
+            {
+                if ( x < ( resizeHeight * native_recip( p.inputRatio ) ) )
+                {
+                    int xIn = round( (float) x * native_recip( (float) resizeHeight ) *
+                                     (float) p.roiHeight ) +
+                              p.roiX;
+                    int yIn = round( (float) y * native_recip( (float) resizeHeight ) *
+                                     (float) p.roiHeight ) +
+                              p.roiY;
+                    RGB = BatchNV12ToRGBPixel( ySrc, uSrc, xIn, yIn, p.inputStride0,
+                                               p.inputStride1 );
+                }
+            }
+            vstore3( RGB, 0, dst );
+        }
+
+)
+
+#endif   // QC_CL2D_PIPELINE_BATCH_CLH
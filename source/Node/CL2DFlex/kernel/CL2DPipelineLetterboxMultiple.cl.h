@@ -5,20 +5,15 @@
 #ifndef QC_CL2D_PIPELINE_LETTERBOXMULTIPLE_CLH
 #define QC_CL2D_PIPELINE_LETTERBOXMULTIPLE_CLH
 
+/* the ROIs are read from a buffer by LetterboxNV12ToRGBMultiple and from the kernel argument by
+ * LetterboxNV12ToRGBMultipleROIs, the first work dimension is the index of the ROI */
 KernelCode(
 
-        __kernel void LetterboxNV12ToRGBMultiple(
-                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
-                __global const int *roiPtr, int resizeHeight, int resizeWidth, int inputStride0,
-                int inputPlane0Size, int inputStride1, int outputStride, int paddingValue ) {
-            int i = get_global_id( 0 );
-            int x = get_global_id( 1 );
-            int y = get_global_id( 2 );
-            __global const uchar *ySrc = srcPtr + srcOffset;
-            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
-            __global uchar *dst = dstPtr + dstOffset + i * resizeHeight * outputStride +
-                                  mad24( y, outputStride, x * 3 );
-            int4 XYWH = vload4( 0, roiPtr + i * 4 );
+        void LetterboxNV12ToRGBMultiplePixel( __global const uchar *ySrc,
+                                              __global const uchar *uSrc, __global uchar *dst,
+                                              int4 XYWH, int x, int y, int resizeHeight,
+                                              int resizeWidth, int inputStride0, int inputStride1,
+                                              int paddingValue ) {
             float inputRatio = (float) XYWH.s3 * native_recip( (float) XYWH.s2 );
             float outputRatio = (float) resizeHeight * native_recip( (float) resizeWidth );
             uchar3 RGB;
@@ -83,6 +78,43 @@ KernelCode(
             }
         }
 
+        __kernel void LetterboxNV12ToRGBMultiple(
+                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
+                __global const int *roiPtr, int resizeHeight, int resizeWidth, int inputStride0,
+                int inputPlane0Size, int inputStride1, int outputStride, int paddingValue ) {
+            int i = get_global_id( 0 );
+            int x = get_global_id( 1 );
+            int y = get_global_id( 2 );
+            __global const uchar *ySrc = srcPtr + srcOffset;
+            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
+            __global uchar *dst = dstPtr + dstOffset + i * resizeHeight * outputStride +
+                                  mad24( y, outputStride, x * 3 );
+            int4 XYWH = vload4( 0, roiPtr + i * 4 );
+            LetterboxNV12ToRGBMultiplePixel( ySrc, uSrc, dst, XYWH, x, y, resizeHeight,
+                                             resizeWidth, inputStride0, inputStride1,
+                                             paddingValue );
+        }
+
+        __kernel void LetterboxNV12ToRGBMultipleROIs(
+                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
+                CL2DROIParams_t rois, int roiBase, int resizeHeight, int resizeWidth,
+                int inputStride0, int inputPlane0Size, int inputStride1, int outputStride,
+                int paddingValue ) {
+            int i = get_global_id( 0 );
+            int x = get_global_id( 1 );
+            int y = get_global_id( 2 );
+            __global const uchar *ySrc = srcPtr + srcOffset;
+            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
+            __global uchar *dst = dstPtr + dstOffset +
+                                  ( roiBase + i ) * resizeHeight * outputStride +
+                                  mad24( y, outputStride, x * 3 );
+            int4 XYWH = ( int4 )( rois.ROIs[i * 4], rois.ROIs[i * 4 + 1], rois.ROIs[i * 4 + 2],
+                                  rois.ROIs[i * 4 + 3] );
+            LetterboxNV12ToRGBMultiplePixel( ySrc, uSrc, dst, XYWH, x, y, resizeHeight,
+                                             resizeWidth, inputStride0, inputStride1,
+                                             paddingValue );
+        }
+
 )
 
 #endif   // QC_CL2D_PIPELINE_LETTERBOXMULTIPLE_CLH
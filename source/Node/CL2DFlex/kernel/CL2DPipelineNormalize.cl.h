@@ -0,0 +1,163 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_PIPELINE_NORMALIZE_CLH
+#define QC_CL2D_PIPELINE_NORMALIZE_CLH
+
+/* the normalize kernels color convert, resize or letterbox, normalize and quantize one input into
+ * a tensor with one pass, the RGB pixels are the same as the ones of the resize and letterbox
+ * kernels, the parameters must match CL2DNormalizeParam_t of CL2DNormalizeParams.hpp */
+KernelCode(
+
+        typedef struct {
+            float alpha[3];
+            float beta[3];
+            float scaleX;
+            float scaleY;
+            int dstOffset;
+            int rowStride;
+            int pixelStride;
+            int channelStride;
+            int roiX;
+            int roiY;
+            int roiWidth;
+            int roiHeight;
+            int validWidth;
+            int validHeight;
+            int paddingValue;
+            int outputType;
+            int bgr;
+        } CL2DNormalizeParam_t;
+
+        int2 NormalizeSourceCoord( int x, int y, CL2DNormalizeParam_t p ) {
+            int xIn = min( (int) round( (float) x * p.scaleX ), p.roiWidth - 1 ) + p.roiX;
+            int yIn = min( (int) round( (float) y * p.scaleY ), p.roiHeight - 1 ) + p.roiY;
+            return ( int2 )( xIn, yIn );
+        }
+
+        uchar3 NormalizeYUVToRGB( int y, float2 UV ) {
+            float Y = max( 0, y - 16 ) * coeffY;
+            float4 UV4 = ( float4 )( UV - 128.0f, UV - 128.0f );
+            UV4 = mad( UV4, coeffUV4, 0.5f );
+            UV4.s1 = UV4.s1 + UV4.s2 - 0.5f;
+            UV4 += Y;
+            return convert_uchar3_sat( ( float3 )( UV4.s3, UV4.s1, UV4.s0 ) );
+        }
+
+        uchar3 NormalizePadding( int paddingValue ) {
+            return ( uchar3 )( ( paddingValue >> 16 ) & 0xFF, ( paddingValue >> 8 ) & 0xFF,
+                               paddingValue & 0xFF );
+        }
+
+        void NormalizeStore( __global uchar *dstPtr, int x, int y, uchar3 RGB,
+                             CL2DNormalizeParam_t p ) {
+            float3 pixel = convert_float3( RGB );
+            if ( 0 != p.bgr )
+            {
+                pixel = pixel.zyx;
+            }
+            pixel = mad( pixel, ( float3 )( p.alpha[0], p.alpha[1], p.alpha[2] ),
+                         ( float3 )( p.beta[0], p.beta[1], p.beta[2] ) );
+            int idx = mad24( y, p.rowStride, x * p.pixelStride );
+            int3 idx3 = ( int3 )( idx, idx + p.channelStride, idx + 2 * p.channelStride );
+            if ( 0 == p.outputType )
+            {
+                __global uchar *dst = dstPtr + p.dstOffset;
+                uchar3 out = convert_uchar3_sat_rte( pixel );
+                dst[idx3.s0] = out.s0;
+                dst[idx3.s1] = out.s1;
+                dst[idx3.s2] = out.s2;
+            }
+            else if ( 1 == p.outputType )
+            {
+                __global char *dst = (__global char *) ( dstPtr + p.dstOffset );
+                char3 out = convert_char3_sat_rte( pixel );
+                dst[idx3.s0] = out.s0;
+                dst[idx3.s1] = out.s1;
+                dst[idx3.s2] = out.s2;
+            }
+            else if ( 2 == p.outputType )
+            {
+                __global half *dst = (__global half *) ( dstPtr + p.dstOffset );
+                vstore_half_rte( pixel.s0, idx3.s0, dst );
+                vstore_half_rte( pixel.s1, idx3.s1, dst );
+                vstore_half_rte( pixel.s2, idx3.s2, dst );
+            }
+            else
+            {
+                __global float *dst = (__global float *) ( dstPtr + p.dstOffset );
+                dst[idx3.s0] = pixel.s0;
+                dst[idx3.s1] = pixel.s1;
+                dst[idx3.s2] = pixel.s2;
+            }
+        }
+
+        __kernel void NormalizeNV12( __global const uchar *srcPtr, int srcOffset,
+                                     int inputStride0, int inputPlane0Size, int inputStride1,
+                                     __global uchar *dstPtr, CL2DNormalizeParam_t p ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            uchar3 RGB;
+            if ( ( x < p.validWidth ) && ( y < p.validHeight ) )
+            {
+                __global const uchar *ySrc = srcPtr + srcOffset;
+                __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
+                int2 coord = NormalizeSourceCoord( x, y, p );
+                int yPtr = mad24( coord.y, inputStride0, coord.x );
+                int uPtr = mad24( coord.y / 2, inputStride1, ( coord.x / 2 ) << 1 );
+                RGB = NormalizeYUVToRGB( ySrc[yPtr], convert_float2( vload2( 0, uSrc + uPtr ) ) );
+            }
+            else
+            {
+                RGB = NormalizePadding( p.paddingValue );
+            }
+            NormalizeStore( dstPtr, x, y, RGB, p );
+        }
+
+        __kernel void NormalizeUYVY( __global const uchar *srcPtr, int srcOffset, int inputStride,
+                                     __global uchar *dstPtr, CL2DNormalizeParam_t p ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            uchar3 RGB;
+            if ( ( x < p.validWidth ) && ( y < p.validHeight ) )
+            {
+                __global const uchar *src = srcPtr + srcOffset;
+                int2 coord = NormalizeSourceCoord( x, y, p );
+                int yPtr = mad24( coord.y, inputStride, coord.x << 1 ) + 1;
+                int uPtr = mad24( coord.y, inputStride, ( coord.x / 2 ) * 4 );
+                float3 UV3 = convert_float3( vload3( 0, src + uPtr ) );
+                RGB = NormalizeYUVToRGB( src[yPtr], ( float2 )( UV3.s0, UV3.s2 ) );
+            }
+            else
+            {
+                RGB = NormalizePadding( p.paddingValue );
+            }
+            NormalizeStore( dstPtr, x, y, RGB, p );
+        }
+
+        __kernel void NormalizeNV12UBWC( __read_only image2d_t srcYPlane,
+                                         __read_only image2d_t srcUVPlane, sampler_t sampler,
+                                         __global uchar *dstPtr, CL2DNormalizeParam_t p ) {
+            int x = get_global_id( 0 );
+            int y = get_global_id( 1 );
+            uchar3 RGB;
+            if ( ( x < p.validWidth ) && ( y < p.validHeight ) )
+            {
+                int2 coord = NormalizeSourceCoord( x, y, p );
+                float4 pixelY = read_imagef( srcYPlane, sampler, coord );
+                float4 pixelUV = read_imagef( srcUVPlane, sampler, coord );
+                uchar3 YUV = convert_uchar3_sat( ( float3 )( pixelY.s0, pixelUV.s0, pixelUV.s1 ) *
+                                                 255 );
+                RGB = NormalizeYUVToRGB( YUV.s0, convert_float2( YUV.s12 ) );
+            }
+            else
+            {
+                RGB = NormalizePadding( p.paddingValue );
+            }
+            NormalizeStore( dstPtr, x, y, RGB, p );
+        }
+
+)
+
+#endif   // QC_CL2D_PIPELINE_NORMALIZE_CLH
@@ -5,20 +5,14 @@
 #ifndef QC_CL2D_PIPELINE_RESIZEMULTIPLE_CLH
 #define QC_CL2D_PIPELINE_RESIZEMULTIPLE_CLH
 
+/* the ROIs are read from a buffer by ResizeNV12ToRGBMultiple and from the kernel argument by
+ * ResizeNV12ToRGBMultipleROIs, the first work dimension is the index of the ROI */
 KernelCode(
 
-        __kernel void ResizeNV12ToRGBMultiple(
-                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
-                __global const int *roiPtr, int resizeHeight, int resizeWidth, int inputStride0,
-                int inputPlane0Size, int inputStride1, int outputStride ) {
-            int i = get_global_id( 0 );
-            int x = get_global_id( 1 );
-            int y = get_global_id( 2 );
-            __global const uchar *ySrc = srcPtr + srcOffset;
-            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
-            __global uchar *dst = dstPtr + dstOffset + i * resizeHeight * outputStride +
-                                  mad24( y, outputStride, x * 3 );
-            int4 XYWH = vload4( 0, roiPtr + i * 4 );
+        void ResizeNV12ToRGBMultiplePixel( __global const uchar *ySrc, __global const uchar *uSrc,
+                                           __global uchar *dst, int4 XYWH, int x, int y,
+                                           int resizeHeight, int resizeWidth, int inputStride0,
+                                           int inputStride1 ) {
             uchar3 RGB;
             int xIn = round( (float) x * native_recip( (float) resizeWidth ) * (float) XYWH.s2 ) +
                       XYWH.s0;
@@ -36,6 +30,40 @@ KernelCode(
             vstore3( RGB, 0, dst );
         }
 
+        __kernel void ResizeNV12ToRGBMultiple(
+                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
+                __global const int *roiPtr, int resizeHeight, int resizeWidth, int inputStride0,
+                int inputPlane0Size, int inputStride1, int outputStride ) {
+            int i = get_global_id( 0 );
+            int x = get_global_id( 1 );
+            int y = get_global_id( 2 );
+            __global const uchar *ySrc = srcPtr + srcOffset;
+            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
+            __global uchar *dst = dstPtr + dstOffset + i * resizeHeight * outputStride +
+                                  mad24( y, outputStride, x * 3 );
+            int4 XYWH = vload4( 0, roiPtr + i * 4 );
+            ResizeNV12ToRGBMultiplePixel( ySrc, uSrc, dst, XYWH, x, y, resizeHeight, resizeWidth,
+                                          inputStride0, inputStride1 );
+        }
+
+        __kernel void ResizeNV12ToRGBMultipleROIs(
+                __global const uchar *srcPtr, int srcOffset, __global uchar *dstPtr, int dstOffset,
+                CL2DROIParams_t rois, int roiBase, int resizeHeight, int resizeWidth,
+                int inputStride0, int inputPlane0Size, int inputStride1, int outputStride ) {
+            int i = get_global_id( 0 );
+            int x = get_global_id( 1 );
+            int y = get_global_id( 2 );
+            __global const uchar *ySrc = srcPtr + srcOffset;
+            __global const uchar *uSrc = srcPtr + srcOffset + inputPlane0Size;
+            __global uchar *dst = dstPtr + dstOffset +
+                                  ( roiBase + i ) * resizeHeight * outputStride +
+                                  mad24( y, outputStride, x * 3 );
+            int4 XYWH = ( int4 )( rois.ROIs[i * 4], rois.ROIs[i * 4 + 1], rois.ROIs[i * 4 + 2],
+                                  rois.ROIs[i * 4 + 3] );
+            ResizeNV12ToRGBMultiplePixel( ySrc, uSrc, dst, XYWH, x, y, resizeHeight, resizeWidth,
+                                          inputStride0, inputStride1 );
+        }
+
 )
 
 #endif   // QC_CL2D_PIPELINE_RESIZEMULTIPLE_CLH
@@ -0,0 +1,37 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_BATCH_PARAMS_HPP
+#define QC_CL2D_BATCH_PARAMS_HPP
+
+#include <CL/cl.h>
+
+/** @brief The max number of inputs processed by one batched kernel dispatch, it must match the
+ * number of source buffer arguments of the batched kernels */
+#define CL2DFLEX_BATCH_MAX 8u
+
+/** @brief The parameters of one input of a batched kernel dispatch, it must match the
+ * CL2DBatchParam_t of kernel/CL2DPipelineBatch.cl.h */
+typedef struct
+{
+    cl_int srcOffset;       /**<the input offset in its source buffer*/
+    cl_int dstOffset;       /**<the output offset of the input in the destination buffer*/
+    cl_int inputStride0;    /**<the input stride of the plane 0*/
+    cl_int inputPlane0Size; /**<the input size of the plane 0*/
+    cl_int inputStride1;    /**<the input stride of the plane 1*/
+    cl_int roiX;            /**<the ROI x coordinate as used by the kernel of the work mode*/
+    cl_int roiY;            /**<the ROI y coordinate as used by the kernel of the work mode*/
+    cl_int roiWidth;        /**<the ROI width*/
+    cl_int roiHeight;       /**<the ROI height*/
+    cl_float inputRatio;    /**<the ROI height/width ratio, used by letterbox*/
+} CL2DBatchParam_t;
+
+/** @brief The parameters of all the inputs of a batched kernel dispatch, passed by value as one
+ * kernel argument, so the parameters are copied at enqueue time */
+typedef struct
+{
+    CL2DBatchParam_t params[CL2DFLEX_BATCH_MAX];
+} CL2DBatchParams_t;
+
+#endif   // QC_CL2D_BATCH_PARAMS_HPP
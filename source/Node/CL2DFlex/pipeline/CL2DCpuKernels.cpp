@@ -0,0 +1,254 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "pipeline/CL2DCpuKernels.hpp"
+
+#if defined( __ARM_NEON ) && defined( __aarch64__ )
+#include <arm_neon.h>
+#define QC_CL2D_CPU_NEON
+#elif defined( __x86_64__ ) && defined( __GNUC__ )
+#include <immintrin.h>
+/* the build targets any x86-64 cpu, only the functions of the AVX2 path are compiled for AVX2,
+ * and the path is taken when the cpu has it */
+#define QC_CL2D_CPU_AVX2
+#define QC_CL2D_AVX2_TARGET __attribute__( ( target( "avx2" ) ) )
+#endif
+
+/* this file is built with -ffp-contract=off, a fused multiply add in the scalar path would give
+ * different bits than the vector path */
+
+namespace QC
+{
+namespace Node
+{
+
+/* convert_uchar_sat of OpenCL, the conversion rounds toward zero */
+static inline uint8_t SatU8( float value )
+{
+    uint8_t ret;
+
+    if ( value <= 0.0f )
+    {
+        ret = 0;
+    }
+    else if ( value >= 255.0f )
+    {
+        ret = 255;
+    }
+    else
+    {
+        ret = (uint8_t) value;
+    }
+
+    return ret;
+}
+
+#if defined( QC_CL2D_CPU_NEON )
+/* 4 of the 16 samples to float */
+static inline float32x4_t Load4( uint8x16_t v, uint32_t idx )
+{
+    uint16x8_t v16 = ( idx < 2 ) ? vmovl_u8( vget_low_u8( v ) ) : vmovl_u8( vget_high_u8( v ) );
+    uint32x4_t v32 = ( 0 == ( idx & 1 ) ) ? vmovl_u16( vget_low_u16( v16 ) )
+                                          : vmovl_u16( vget_high_u16( v16 ) );
+    return vcvtq_f32_u32( v32 );
+}
+
+/* 4 x 4 floats to 16 saturated bytes, the float to int conversion rounds toward zero */
+static inline uint8x16_t Store16( const float32x4_t v[4] )
+{
+    uint16x8_t lo = vcombine_u16( vqmovun_s32( vcvtq_s32_f32( v[0] ) ),
+                                  vqmovun_s32( vcvtq_s32_f32( v[1] ) ) );
+    uint16x8_t hi = vcombine_u16( vqmovun_s32( vcvtq_s32_f32( v[2] ) ),
+                                  vqmovun_s32( vcvtq_s32_f32( v[3] ) ) );
+    return vcombine_u8( vqmovn_u16( lo ), vqmovn_u16( hi ) );
+}
+#elif defined( QC_CL2D_CPU_AVX2 )
+QC_CL2D_AVX2_TARGET static inline __m256 Load8( const uint8_t *p )
+{
+    return _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_loadl_epi64( (const __m128i *) p ) ) );
+}
+
+/* 2 x 8 floats to 16 saturated bytes, the float to int conversion rounds toward zero */
+QC_CL2D_AVX2_TARGET static inline __m128i Store16( __m256 lo, __m256 hi )
+{
+    __m256i loI = _mm256_cvttps_epi32( lo );
+    __m256i hiI = _mm256_cvttps_epi32( hi );
+    __m128i lo16 = _mm_packs_epi32( _mm256_castsi256_si128( loI ),
+                                    _mm256_extracti128_si256( loI, 1 ) );
+    __m128i hi16 = _mm_packs_epi32( _mm256_castsi256_si128( hiI ),
+                                    _mm256_extracti128_si256( hiI, 1 ) );
+    return _mm_packus_epi16( lo16, hi16 );
+}
+
+/* interleave 16 pixels of 3 planes into 48 bytes */
+QC_CL2D_AVX2_TARGET static inline void Interleave3( __m128i c0, __m128i c1, __m128i c2,
+                                                    uint8_t *pDst )
+{
+    const __m128i m00 = _mm_setr_epi8( 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128, -128,
+                                       4, -128, -128, 5 );
+    const __m128i m01 = _mm_setr_epi8( -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3, -128,
+                                       -128, 4, -128, -128 );
+    const __m128i m02 = _mm_setr_epi8( -128, -128, 0, -128, -128, 1, -128, -128, 2, -128, -128, 3,
+                                       -128, -128, 4, -128 );
+    const __m128i m10 = _mm_setr_epi8( -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128, 9,
+                                       -128, -128, 10, -128 );
+    const __m128i m11 = _mm_setr_epi8( 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128, -128,
+                                       9, -128, -128, 10 );
+    const __m128i m12 = _mm_setr_epi8( -128, 5, -128, -128, 6, -128, -128, 7, -128, -128, 8, -128,
+                                       -128, 9, -128, -128 );
+    const __m128i m20 = _mm_setr_epi8( -128, 11, -128, -128, 12, -128, -128, 13, -128, -128, 14,
+                                       -128, -128, 15, -128, -128 );
+    const __m128i m21 = _mm_setr_epi8( -128, -128, 11, -128, -128, 12, -128, -128, 13, -128, -128,
+                                       14, -128, -128, 15, -128 );
+    const __m128i m22 = _mm_setr_epi8( 10, -128, -128, 11, -128, -128, 12, -128, -128, 13, -128,
+                                       -128, 14, -128, -128, 15 );
+    __m128i out0 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( c0, m00 ),
+                                               _mm_shuffle_epi8( c1, m01 ) ),
+                                 _mm_shuffle_epi8( c2, m02 ) );
+    __m128i out1 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( c0, m10 ),
+                                               _mm_shuffle_epi8( c1, m11 ) ),
+                                 _mm_shuffle_epi8( c2, m12 ) );
+    __m128i out2 = _mm_or_si128( _mm_or_si128( _mm_shuffle_epi8( c0, m20 ),
+                                               _mm_shuffle_epi8( c1, m21 ) ),
+                                 _mm_shuffle_epi8( c2, m22 ) );
+    _mm_storeu_si128( (__m128i *) pDst, out0 );
+    _mm_storeu_si128( (__m128i *) ( pDst + 16 ), out1 );
+    _mm_storeu_si128( (__m128i *) ( pDst + 32 ), out2 );
+}
+
+/* the pixels of the row in blocks of 16, returns the number of pixels done */
+QC_CL2D_AVX2_TARGET static uint32_t YUVToRGBRowAvx2( const uint8_t *pY, const uint8_t *pU,
+                                                     const uint8_t *pV, uint32_t width,
+                                                     uint32_t idxR, uint32_t idxB, uint8_t *pDst )
+{
+    uint32_t i = 0;
+    const __m256 v16 = _mm256_set1_ps( 16.0f );
+    const __m256 v128 = _mm256_set1_ps( 128.0f );
+    const __m256 vZero = _mm256_setzero_ps();
+    const __m256 vHalf = _mm256_set1_ps( 0.5f );
+    const __m256 vCoeffY = _mm256_set1_ps( CL2D_CPU_COEFF_Y );
+    const __m256 vCoeffUB = _mm256_set1_ps( CL2D_CPU_COEFF_UB );
+    const __m256 vCoeffVG = _mm256_set1_ps( CL2D_CPU_COEFF_VG );
+    const __m256 vCoeffUG = _mm256_set1_ps( CL2D_CPU_COEFF_UG );
+    const __m256 vCoeffVR = _mm256_set1_ps( CL2D_CPU_COEFF_VR );
+    for ( ; i + 16 <= width; i += 16 )
+    {
+        __m256 r[2], g[2], b[2];
+        for ( uint32_t j = 0; j < 2; j++ )
+        {
+            uint32_t k = i + j * 8;
+            __m256 y = _mm256_mul_ps( _mm256_max_ps( _mm256_sub_ps( Load8( pY + k ), v16 ), vZero ),
+                                      vCoeffY );
+            __m256 u = _mm256_sub_ps( Load8( pU + k ), v128 );
+            __m256 v = _mm256_sub_ps( Load8( pV + k ), v128 );
+            __m256 ub = _mm256_add_ps( _mm256_mul_ps( u, vCoeffUB ), vHalf );
+            __m256 vg = _mm256_add_ps( _mm256_mul_ps( v, vCoeffVG ), vHalf );
+            __m256 ug = _mm256_add_ps( _mm256_mul_ps( u, vCoeffUG ), vHalf );
+            __m256 vr = _mm256_add_ps( _mm256_mul_ps( v, vCoeffVR ), vHalf );
+            r[j] = _mm256_add_ps( vr, y );
+            g[j] = _mm256_add_ps( _mm256_sub_ps( _mm256_add_ps( vg, ug ), vHalf ), y );
+            b[j] = _mm256_add_ps( ub, y );
+        }
+        __m128i c[3];
+        c[idxR] = Store16( r[0], r[1] );
+        c[1] = Store16( g[0], g[1] );
+        c[idxB] = Store16( b[0], b[1] );
+        Interleave3( c[0], c[1], c[2], pDst + i * 3 );
+    }
+
+    return i;
+}
+
+/* the cpu features are read once, also when called by a static constructor */
+static bool HasAvx2()
+{
+    static const bool s_bAvx2 = []() {
+        __builtin_cpu_init();
+        return ( 0 != __builtin_cpu_supports( "avx2" ) );
+    }();
+
+    return s_bAvx2;
+}
+#endif
+
+void CL2DCpuYUVToRGBRow( const uint8_t *pY, const uint8_t *pU, const uint8_t *pV, uint32_t width,
+                         bool bBGR, uint8_t *pDst )
+{
+    uint32_t i = 0;
+    uint32_t idxR = bBGR ? 2 : 0;
+    uint32_t idxB = bBGR ? 0 : 2;
+
+    /* the vector paths compute the channels in the same order as the scalar path, so all give
+     * the same bits */
+#if defined( QC_CL2D_CPU_NEON )
+    const float32x4_t v16 = vdupq_n_f32( 16.0f );
+    const float32x4_t v128 = vdupq_n_f32( 128.0f );
+    const float32x4_t vZero = vdupq_n_f32( 0.0f );
+    const float32x4_t vHalf = vdupq_n_f32( 0.5f );
+    const float32x4_t vCoeffY = vdupq_n_f32( CL2D_CPU_COEFF_Y );
+    const float32x4_t vCoeffUB = vdupq_n_f32( CL2D_CPU_COEFF_UB );
+    const float32x4_t vCoeffVG = vdupq_n_f32( CL2D_CPU_COEFF_VG );
+    const float32x4_t vCoeffUG = vdupq_n_f32( CL2D_CPU_COEFF_UG );
+    const float32x4_t vCoeffVR = vdupq_n_f32( CL2D_CPU_COEFF_VR );
+    for ( ; i + 16 <= width; i += 16 )
+    {
+        uint8x16_t vY = vld1q_u8( pY + i );
+        uint8x16_t vU = vld1q_u8( pU + i );
+        uint8x16_t vV = vld1q_u8( pV + i );
+        float32x4_t r[4], g[4], b[4];
+        for ( uint32_t j = 0; j < 4; j++ )
+        {
+            float32x4_t y = vmulq_f32( vmaxq_f32( vsubq_f32( Load4( vY, j ), v16 ), vZero ),
+                                       vCoeffY );
+            float32x4_t u = vsubq_f32( Load4( vU, j ), v128 );
+            float32x4_t v = vsubq_f32( Load4( vV, j ), v128 );
+            float32x4_t ub = vaddq_f32( vmulq_f32( u, vCoeffUB ), vHalf );
+            float32x4_t vg = vaddq_f32( vmulq_f32( v, vCoeffVG ), vHalf );
+            float32x4_t ug = vaddq_f32( vmulq_f32( u, vCoeffUG ), vHalf );
+            float32x4_t vr = vaddq_f32( vmulq_f32( v, vCoeffVR ), vHalf );
+            r[j] = vaddq_f32( vr, y );
+            g[j] = vaddq_f32( vsubq_f32( vaddq_f32( vg, ug ), vHalf ), y );
+            b[j] = vaddq_f32( ub, y );
+        }
+        uint8x16x3_t rgb;
+        rgb.val[idxR] = Store16( r );
+        rgb.val[1] = Store16( g );
+        rgb.val[idxB] = Store16( b );
+        vst3q_u8( pDst + i * 3, rgb );
+    }
+#elif defined( QC_CL2D_CPU_AVX2 )
+    if ( true == HasAvx2() )
+    {
+        i = YUVToRGBRowAvx2( pY, pU, pV, width, idxR, idxB, pDst );
+    }
+#endif
+
+    CL2DCpuYUVToRGBRowScalar( pY + i, pU + i, pV + i, width - i, bBGR, pDst + i * 3 );
+}
+
+void CL2DCpuYUVToRGBRowScalar( const uint8_t *pY, const uint8_t *pU, const uint8_t *pV,
+                               uint32_t width, bool bBGR, uint8_t *pDst )
+{
+    uint32_t idxR = bBGR ? 2 : 0;
+    uint32_t idxB = bBGR ? 0 : 2;
+
+    for ( uint32_t i = 0; i < width; i++ )
+    {
+        float y = (float) pY[i] - 16.0f;
+        y = ( ( y > 0.0f ) ? y : 0.0f ) * CL2D_CPU_COEFF_Y;
+        float u = (float) pU[i] - 128.0f;
+        float v = (float) pV[i] - 128.0f;
+        float ub = u * CL2D_CPU_COEFF_UB + 0.5f;
+        float vg = v * CL2D_CPU_COEFF_VG + 0.5f;
+        float ug = u * CL2D_CPU_COEFF_UG + 0.5f;
+        float vr = v * CL2D_CPU_COEFF_VR + 0.5f;
+        uint8_t *pPixel = pDst + i * 3;
+        pPixel[idxR] = SatU8( vr + y );
+        pPixel[1] = SatU8( vg + ug - 0.5f + y );
+        pPixel[idxB] = SatU8( ub + y );
+    }
+}
+
+}   // namespace Node
+}   // namespace QC
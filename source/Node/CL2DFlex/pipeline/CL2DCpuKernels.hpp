@@ -0,0 +1,46 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_CPU_KERNELS_HPP
+#define QC_CL2D_CPU_KERNELS_HPP
+
+#include <cinttypes>
+
+namespace QC
+{
+namespace Node
+{
+
+/* the color convert coefficients of kernel/CL2DConstant.cl.h */
+#define CL2D_CPU_COEFF_Y 1.163999557f
+#define CL2D_CPU_COEFF_UB 2.017999649f
+#define CL2D_CPU_COEFF_VG -0.812999725f
+#define CL2D_CPU_COEFF_UG -0.390999794f
+#define CL2D_CPU_COEFF_VR 1.5959997177f
+
+/**
+ * @brief Convert one row of Y, U and V samples to RGB888 or BGR888 pixels.
+ * @param[in] pY The Y sample of each pixel.
+ * @param[in] pU The U sample of each pixel.
+ * @param[in] pV The V sample of each pixel.
+ * @param[in] width The number of pixels.
+ * @param[in] bBGR Write the channels in B,G,R order instead of R,G,B.
+ * @param[out] pDst The 3 * width bytes of the pixels.
+ * @note The formula and the rounding of the OpenCL kernels are used, mad is computed as a multiply
+ * followed by an add and the saturated conversion rounds toward zero, with NEON on aarch64 or AVX2
+ * on an x86-64 cpu that has it, and the same bits from the scalar path otherwise.
+ */
+void CL2DCpuYUVToRGBRow( const uint8_t *pY, const uint8_t *pU, const uint8_t *pV, uint32_t width,
+                         bool bBGR, uint8_t *pDst );
+
+/**
+ * @brief The scalar path of CL2DCpuYUVToRGBRow, the reference of its vector paths.
+ */
+void CL2DCpuYUVToRGBRowScalar( const uint8_t *pY, const uint8_t *pU, const uint8_t *pV,
+                               uint32_t width, bool bBGR, uint8_t *pDst );
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QC_CL2D_CPU_KERNELS_HPP
@@ -0,0 +1,132 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include <algorithm>
+
+#include "pipeline/CL2DCpuWorkers.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* more bands than threads, so that a thread slowed down by the other loads of the system does not
+ * delay the whole image */
+#define CL2D_CPU_BANDS_PER_THREAD 4u
+
+CL2DCpuWorkers::CL2DCpuWorkers() : m_nextBand( 0 ) {}
+
+CL2DCpuWorkers::~CL2DCpuWorkers()
+{
+    Deinit();
+}
+
+QCStatus_e CL2DCpuWorkers::Init( uint32_t numThreads )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( false == m_threads.empty() )
+    {
+        status = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        if ( 0 == numThreads )
+        {
+            numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+        }
+        m_bStop = false;
+        for ( uint32_t i = 1; i < numThreads; i++ )
+        {
+            m_threads.emplace_back( &CL2DCpuWorkers::WorkerFn, this );
+        }
+    }
+
+    return status;
+}
+
+void CL2DCpuWorkers::Deinit()
+{
+    {
+        std::lock_guard<std::mutex> l( m_lock );
+        m_bStop = true;
+        m_startCond.notify_all();
+    }
+    for ( std::thread &thread : m_threads )
+    {
+        thread.join();
+    }
+    m_threads.clear();
+}
+
+void CL2DCpuWorkers::Run( uint32_t numRows, const RowFn_t &rowFn )
+{
+    std::lock_guard<std::mutex> runLock( m_runLock );
+
+    if ( m_threads.empty() || ( numRows < 2 ) )
+    {
+        rowFn( 0, numRows );
+    }
+    else
+    {
+        uint32_t numBands = std::min( numRows, GetNumThreads() * CL2D_CPU_BANDS_PER_THREAD );
+        {
+            std::lock_guard<std::mutex> l( m_lock );
+            m_pRowFn = &rowFn;
+            m_numRows = numRows;
+            m_bandRows = ( numRows + numBands - 1 ) / numBands;
+            m_numBands = ( numRows + m_bandRows - 1 ) / m_bandRows;
+            m_nextBand.store( 0 );
+            m_numBusy = (uint32_t) m_threads.size();
+            m_generation++;
+            m_startCond.notify_all();
+        }
+
+        ProcessBands();
+
+        std::unique_lock<std::mutex> l( m_lock );
+        m_doneCond.wait( l, [this]() { return 0 == m_numBusy; } );
+        m_pRowFn = nullptr;
+    }
+}
+
+void CL2DCpuWorkers::ProcessBands()
+{
+    uint32_t band = m_nextBand.fetch_add( 1 );
+    while ( band < m_numBands )
+    {
+        uint32_t begin = band * m_bandRows;
+        uint32_t end = std::min( m_numRows, begin + m_bandRows );
+        ( *m_pRowFn )( begin, end );
+        band = m_nextBand.fetch_add( 1 );
+    }
+}
+
+void CL2DCpuWorkers::WorkerFn()
+{
+    uint64_t generation = 0;
+    std::unique_lock<std::mutex> l( m_lock );
+
+    while ( false == m_bStop )
+    {
+        m_startCond.wait( l, [this, generation]() {
+            return m_bStop || ( generation != m_generation );
+        } );
+        if ( false == m_bStop )
+        {
+            generation = m_generation;
+            l.unlock();
+            ProcessBands();
+            l.lock();
+            m_numBusy--;
+            if ( 0 == m_numBusy )
+            {
+                m_doneCond.notify_all();
+            }
+        }
+    }
+}
+
+}   // namespace Node
+}   // namespace QC
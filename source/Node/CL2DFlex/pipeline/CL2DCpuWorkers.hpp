@@ -0,0 +1,70 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_CPU_WORKERS_HPP
+#define QC_CL2D_CPU_WORKERS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "QC/Common/Types.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* a fixed pool of worker threads for the CPU pipelines, Run splits the rows of an image into bands
+ * and returns once all the bands are processed by the workers and the calling thread */
+class CL2DCpuWorkers
+{
+public:
+    /* the function processing the rows [begin, end) */
+    typedef std::function<void( uint32_t begin, uint32_t end )> RowFn_t;
+
+    CL2DCpuWorkers();
+
+    ~CL2DCpuWorkers();
+
+    /* numThreads includes the calling thread, 0 for one thread per CPU core */
+    QCStatus_e Init( uint32_t numThreads );
+
+    void Deinit();
+
+    /* run rowFn over the rows [0, numRows), rows of the same band are processed by one thread */
+    void Run( uint32_t numRows, const RowFn_t &rowFn );
+
+    uint32_t GetNumThreads() const { return (uint32_t) m_threads.size() + 1; }
+
+private:
+    void WorkerFn();
+    void ProcessBands();
+
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_runLock;
+    std::mutex m_lock;
+    std::condition_variable m_startCond;
+    std::condition_variable m_doneCond;
+    bool m_bStop = false;
+    uint64_t m_generation = 0;
+    uint32_t m_numBusy = 0;
+
+    /* the job of the current generation */
+    const RowFn_t *m_pRowFn = nullptr;
+    uint32_t m_numRows = 0;
+    uint32_t m_bandRows = 0;
+    std::atomic<uint32_t> m_nextBand;
+    uint32_t m_numBands = 0;
+
+};   // class CL2DCpuWorkers
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QC_CL2D_CPU_WORKERS_HPP
@@ -0,0 +1,42 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_NORMALIZE_PARAMS_HPP
+#define QC_CL2D_NORMALIZE_PARAMS_HPP
+
+#include <CL/cl.h>
+
+/** @brief The tensor element types written by the normalize kernels */
+typedef enum
+{
+    CL2DFLEX_NORMALIZE_OUTPUT_UINT_8,   /**<uint8, saturated and rounded to nearest even*/
+    CL2DFLEX_NORMALIZE_OUTPUT_INT_8,    /**<int8, saturated and rounded to nearest even*/
+    CL2DFLEX_NORMALIZE_OUTPUT_FLOAT_16, /**<fp16, rounded to nearest even*/
+    CL2DFLEX_NORMALIZE_OUTPUT_FLOAT_32  /**<fp32*/
+} CL2DNormalizeOutput_e;
+
+/** @brief The parameters of a normalize kernel dispatch, passed by value as one kernel argument,
+ * it must match the CL2DNormalizeParam_t of kernel/CL2DPipelineNormalize.cl.h */
+typedef struct
+{
+    cl_float alpha[3];    /**<the per output channel scale applied to the 0-255 pixel value*/
+    cl_float beta[3];     /**<the per output channel offset added after the scale*/
+    cl_float scaleX;      /**<the number of ROI columns per output column*/
+    cl_float scaleY;      /**<the number of ROI rows per output row*/
+    cl_int dstOffset;     /**<the byte offset of the input image in the output tensor*/
+    cl_int rowStride;     /**<the number of elements between two output rows*/
+    cl_int pixelStride;   /**<the number of elements between two output pixels of a row*/
+    cl_int channelStride; /**<the number of elements between two output channels of a pixel*/
+    cl_int roiX;          /**<the ROI x coordinate*/
+    cl_int roiY;          /**<the ROI y coordinate*/
+    cl_int roiWidth;      /**<the ROI width*/
+    cl_int roiHeight;     /**<the ROI height*/
+    cl_int validWidth;    /**<the output columns resized from the ROI, the others are padding*/
+    cl_int validHeight;   /**<the output rows resized from the ROI, the others are padding*/
+    cl_int paddingValue;  /**<the letterbox padding RGB value*/
+    cl_int outputType;    /**<the output element type, CL2DNormalizeOutput_e*/
+    cl_int bgr;           /**<non zero to write the channels in B,G,R order*/
+} CL2DNormalizeParam_t;
+
+#endif   // QC_CL2D_NORMALIZE_PARAMS_HPP
@@ -36,5 +36,54 @@ void CL2DPipelineBase::DeinitLogger()
     /* ignore logger deinit error */
 }
 
+QCStatus_e CL2DPipelineBase::ExecuteTensor( ImageDescriptor_t &input, TensorDescriptor_t &output )
+{
+    QC_ERROR( "CL2DFlex pipeline for inputId=%u does not support tensor output!", m_inputId );
+
+    return QC_STATUS_UNSUPPORTED;
+}
+
+QCStatus_e CL2DPipelineBase::GetFrameROIs( ImageDescriptor_t &input,
+                                           const CL2DFlex_ROIConfig_t *&pROIs,
+                                           uint32_t &numOfROIs )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    CL2DFlex_ROIImageDescriptor_t *pFrame =
+            dynamic_cast<CL2DFlex_ROIImageDescriptor_t *>( &input );
+
+    pROIs = nullptr;
+    numOfROIs = 0;
+    if ( ( nullptr != pFrame ) && ( 0 < pFrame->numOfROIs ) )
+    {
+        if ( m_config.numOfROIs < pFrame->numOfROIs )
+        {
+            QC_ERROR( "Frame has %u ROIs, more than the %u output images for inputId=%u!",
+                      pFrame->numOfROIs, m_config.numOfROIs, m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        for ( uint32_t i = 0; ( QC_STATUS_OK == ret ) && ( i < pFrame->numOfROIs ); i++ )
+        {
+            const CL2DFlex_ROIConfig_t &roi = pFrame->ROIs[i];
+            if ( ( 0 == roi.width ) || ( 0 == roi.height ) ||
+                 ( m_config.inputWidths[m_inputId] < roi.width ) ||
+                 ( m_config.inputHeights[m_inputId] < roi.height ) ||
+                 ( ( m_config.inputWidths[m_inputId] - roi.width ) < roi.x ) ||
+                 ( ( m_config.inputHeights[m_inputId] - roi.height ) < roi.y ) )
+            {
+                QC_ERROR( "Frame ROI %u [%u, %u, %u, %u] invalid for inputId=%u!", i, roi.x,
+                          roi.y, roi.width, roi.height, m_inputId );
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
+        }
+        if ( QC_STATUS_OK == ret )
+        {
+            pROIs = pFrame->ROIs;
+            numOfROIs = pFrame->numOfROIs;
+        }
+    }
+
+    return ret;
+}
+
 }   // namespace Node
 }   // namespace QC
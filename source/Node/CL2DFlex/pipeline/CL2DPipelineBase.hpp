@@ -59,6 +59,16 @@ typedef enum
                                                     the map table from nv12 to rgb*/
     CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_BGR, /**<color convert and remap use nearest point in
                                                     the map table from nv12 to bgr*/
+    CL2DFLEX_PIPELINE_NORMALIZE_NV12_TO_TENSOR,     /**<color convert, resize or letterbox use
+                                                       nearest point, normalize and quantize from
+                                                       nv12 to a tensor*/
+    CL2DFLEX_PIPELINE_NORMALIZE_UYVY_TO_TENSOR,     /**<color convert, resize or letterbox use
+                                                       nearest point, normalize and quantize from
+                                                       uyvy to a tensor*/
+    CL2DFLEX_PIPELINE_NORMALIZE_NV12UBWC_TO_TENSOR, /**<color convert, resize or letterbox use
+                                                       nearest point, normalize and quantize from
+                                                       nv12 ubwc to a tensor, only valid on qnx
+                                                       currently*/
     CL2DFLEX_PIPELINE_MAX
 } CL2DFlex_Pipeline_e;
 
@@ -80,8 +90,19 @@ public:
 
     virtual QCStatus_e Deinit() = 0;
 
+    /* enqueue the kernels of the input without waiting, the caller waits for their completion */
     virtual QCStatus_e Execute( ImageDescriptor_t &input, ImageDescriptor_t &output ) = 0;
 
+    /* enqueue the kernels of the input writing into a tensor without waiting, only supported by
+     * the pipelines of the normalize work modes */
+    virtual QCStatus_e ExecuteTensor( ImageDescriptor_t &input, TensorDescriptor_t &output );
+
+protected:
+    /* the ROIs of the frame of the multiple work modes given by a CL2DFlex_ROIImageDescriptor_t
+     * input, numOfROIs is 0 when the input carries none and the configured ROIs are used */
+    QCStatus_e GetFrameROIs( ImageDescriptor_t &input, const CL2DFlex_ROIConfig_t *&pROIs,
+                             uint32_t &numOfROIs );
+
 protected:
     std::string m_name;
     uint32_t m_inputId;
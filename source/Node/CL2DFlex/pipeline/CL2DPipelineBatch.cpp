@@ -0,0 +1,230 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "pipeline/CL2DPipelineBatch.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+CL2DPipelineBatch::CL2DPipelineBatch( const std::vector<uint32_t> &inputIds )
+    : m_inputIds( inputIds )
+{}
+
+CL2DPipelineBatch::~CL2DPipelineBatch() {}
+
+bool CL2DPipelineBatch::IsBatchable( const CL2DFlex_Config_t &config, uint32_t inputId )
+{
+    bool bBatchable = false;
+
+    if ( ( QC_IMAGE_FORMAT_NV12 == config.inputFormats[inputId] ) &&
+         ( QC_IMAGE_FORMAT_RGB888 == config.outputFormat ) )
+    {
+        if ( ( CL2DFLEX_WORK_MODE_CONVERT == config.workModes[inputId] ) ||
+             ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST == config.workModes[inputId] ) ||
+             ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == config.workModes[inputId] ) )
+        {
+            bBatchable = true;
+        }
+    }
+
+    return bBatchable;
+}
+
+QCStatus_e
+CL2DPipelineBatch::Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                         OpenclSrv *pOpenclSrvObj,
+                         std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    m_inputId = inputId;
+    m_pOpenclSrvObj = pOpenclSrvObj;
+    m_config = *pConfig;
+
+    if ( ( m_inputIds.empty() ) || ( m_inputIds.size() > CL2DFLEX_BATCH_MAX ) )
+    {
+        QC_ERROR( "Invalid CL2DFlex batch size %u!", (uint32_t) m_inputIds.size() );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        for ( uint32_t id : m_inputIds )
+        {
+            if ( ( false == IsBatchable( m_config, id ) ) ||
+                 ( m_config.workModes[id] != m_config.workModes[m_inputIds[0]] ) )
+            {
+                QC_ERROR( "Invalid CL2DFlex batch pipeline for inputId=%u!", id );
+                ret = QC_STATUS_BAD_ARGUMENTS;
+                break;
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        CL2DFlex_Work_Mode_e workMode = m_config.workModes[m_inputIds[0]];
+        if ( CL2DFLEX_WORK_MODE_CONVERT == workMode )
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_CONVERT_NV12_TO_RGB;
+            ret = pOpenclSrvObj->CreateKernel( pKernel, "ConvertNV12ToRGBBatch" );
+        }
+        else if ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST == workMode )
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB;
+            ret = pOpenclSrvObj->CreateKernel( pKernel, "ResizeNV12ToRGBBatch" );
+        }
+        else
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB;
+            ret = pOpenclSrvObj->CreateKernel( pKernel, "LetterboxNV12ToRGBBatch" );
+        }
+    }
+
+    m_pKernel = pKernel;
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineBatch::Deinit()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    // empty function
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineBatch::Execute( ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    QC_ERROR( "CL2DFlex batch for inputId=%u must be executed with all its inputs!", m_inputId );
+
+    return QC_STATUS_UNSUPPORTED;
+}
+
+QCStatus_e CL2DPipelineBatch::ExecuteBatch( ImageDescriptor_t *const *ppInputs,
+                                            ImageDescriptor_t &output )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    cl_mem bufferDst;
+    cl_mem bufferSrcs[CL2DFLEX_BATCH_MAX] = { nullptr };
+    CL2DBatchParams_t batch = {};
+    uint32_t sizeOne = (uint32_t) ( output.size ) / ( output.batchSize );
+
+    ret = m_pOpenclSrvObj->RegBufferDesc( dynamic_cast<QCBufferDescriptorBase_t &>( output ),
+                                          bufferDst );
+    if ( QC_STATUS_OK != ret )
+    {
+        QC_ERROR( "Failed to register output buffer!" );
+    }
+
+    for ( size_t i = 0; ( QC_STATUS_OK == ret ) && ( i < m_inputIds.size() ); i++ )
+    {
+        uint32_t inputId = m_inputIds[i];
+        ImageDescriptor_t &input = *ppInputs[inputId];
+        const CL2DFlex_ROIConfig_t &roi = m_config.ROIs[inputId];
+        CL2DBatchParam_t &param = batch.params[i];
+
+        ret = m_pOpenclSrvObj->RegBufferDesc( dynamic_cast<QCBufferDescriptorBase_t &>( input ),
+                                              bufferSrcs[i] );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to register input buffer for inputId=%u!", inputId );
+        }
+        else
+        {
+            param.srcOffset = (cl_int) input.offset;
+            param.dstOffset = (cl_int) ( output.offset + inputId * sizeOne );
+            param.inputStride0 = (cl_int) input.stride[0];
+            param.inputPlane0Size = (cl_int) input.planeBufSize[0];
+            param.inputStride1 = (cl_int) input.stride[1];
+            param.roiWidth = (cl_int) roi.width;
+            param.roiHeight = (cl_int) roi.height;
+            /* the same ROI coordinates as the single input pipelines of the work mode */
+            if ( CL2DFLEX_PIPELINE_CONVERT_NV12_TO_RGB == m_pipeline )
+            {
+                param.roiX = (cl_int) ( roi.x / 2 );
+                param.roiY = (cl_int) ( roi.y / 2 );
+            }
+            else if ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB == m_pipeline )
+            {
+                param.roiX = (cl_int) ( roi.x / roi.width * m_config.outputWidth );
+                param.roiY = (cl_int) ( roi.y / roi.height * m_config.outputHeight );
+            }
+            else
+            {
+                param.roiX = (cl_int) roi.x;
+                param.roiY = (cl_int) roi.y;
+                param.inputRatio = (float) roi.height / (float) roi.width;
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        size_t numOfArgs = CL2DFLEX_BATCH_MAX + 3;
+        OpenclIfcae_Arg_t OpenclArgs[CL2DFLEX_BATCH_MAX + 7];
+        for ( size_t i = 0; i < CL2DFLEX_BATCH_MAX; i++ )
+        {
+            OpenclArgs[i].pArg = (void *) &bufferSrcs[i];
+            OpenclArgs[i].argSize = sizeof( cl_mem );
+        }
+        OpenclArgs[CL2DFLEX_BATCH_MAX].pArg = (void *) &bufferDst;
+        OpenclArgs[CL2DFLEX_BATCH_MAX].argSize = sizeof( cl_mem );
+        OpenclArgs[CL2DFLEX_BATCH_MAX + 1].pArg = (void *) &batch;
+        OpenclArgs[CL2DFLEX_BATCH_MAX + 1].argSize = sizeof( batch );
+
+        float outputRatio = (float) ( output.height ) / (float) ( output.width );
+        size_t globalWorkSize[3] = { output.width, output.height, m_inputIds.size() };
+        if ( CL2DFLEX_PIPELINE_CONVERT_NV12_TO_RGB == m_pipeline )
+        {
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 2].pArg = (void *) &( output.stride[0] );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 2].argSize = sizeof( cl_int );
+            globalWorkSize[0] = (size_t) ( output.width ) / 2;
+            globalWorkSize[1] = (size_t) ( output.height ) / 2;
+        }
+        else
+        {
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 2].pArg = (void *) &( m_config.outputHeight );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 2].argSize = sizeof( cl_int );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 3].pArg = (void *) &( m_config.outputWidth );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 3].argSize = sizeof( cl_int );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 4].pArg = (void *) &( output.stride[0] );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 4].argSize = sizeof( cl_int );
+            numOfArgs = CL2DFLEX_BATCH_MAX + 5;
+        }
+        if ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB == m_pipeline )
+        {
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 5].pArg = (void *) &( outputRatio );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 5].argSize = sizeof( cl_float );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 6].pArg = (void *) &( m_config.letterboxPaddingValue );
+            OpenclArgs[CL2DFLEX_BATCH_MAX + 6].argSize = sizeof( cl_int );
+            numOfArgs = CL2DFLEX_BATCH_MAX + 7;
+        }
+
+        OpenclIface_WorkParams_t OpenclWorkParams;
+        OpenclWorkParams.workDim = 3;
+        OpenclWorkParams.pGlobalWorkSize = globalWorkSize;
+        size_t globalWorkOffset[3] = { 0, 0, 0 };
+        OpenclWorkParams.pGlobalWorkOffset = globalWorkOffset;
+        /*set local work size to NULL, device would choose optimal size automatically*/
+        OpenclWorkParams.pLocalWorkSize = NULL;
+
+        ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs,
+                                             &OpenclWorkParams );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to execute batch OpenCL kernel for %u inputs!",
+                      (uint32_t) m_inputIds.size() );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    return ret;
+}
+
+}   // namespace Node
+}   // namespace QC
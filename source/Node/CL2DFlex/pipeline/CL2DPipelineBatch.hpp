@@ -0,0 +1,53 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_PIPELINE_BATCH_HPP
+#define QC_CL2D_PIPELINE_BATCH_HPP
+
+#include "pipeline/CL2DBatchParams.hpp"
+#include "pipeline/CL2DPipelineBase.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* process up to CL2DFLEX_BATCH_MAX inputs of the same work mode and formats with one kernel
+ * dispatch, the third work dimension is the index of the input in the batch */
+class CL2DPipelineBatch : public CL2DPipelineBase
+{
+public:
+    CL2DPipelineBatch( const std::vector<uint32_t> &inputIds );
+
+    ~CL2DPipelineBatch();
+
+    /* the inputId is the first input of the batch, the kernel is created in its kernel slot */
+    QCStatus_e Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                     OpenclSrv *pOpenclSrvObj,
+                     std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
+
+    QCStatus_e Deinit();
+
+    /* not supported, a batch is executed by ExecuteBatch with all its inputs */
+    QCStatus_e Execute( ImageDescriptor_t &input, ImageDescriptor_t &output );
+
+    /* enqueue the kernel of all the inputs of the batch without waiting, ppInputs is indexed by
+     * the input ID */
+    QCStatus_e ExecuteBatch( ImageDescriptor_t *const *ppInputs, ImageDescriptor_t &output );
+
+    const std::vector<uint32_t> &GetInputIds() const { return m_inputIds; }
+
+    /* check if an input can be processed by a batch, NV12 to RGB888 convert, resize and letterbox
+     * only */
+    static bool IsBatchable( const CL2DFlex_Config_t &config, uint32_t inputId );
+
+private:
+    std::vector<uint32_t> m_inputIds;
+
+};   // class CL2DPipelineBatch
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QC_CL2D_PIPELINE_BATCH_HPP
@@ -161,7 +161,7 @@ QCStatus_e CL2DPipelineConvert::ConvertFromNV12ToRGB( cl_mem bufferSrc, uint32_t
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute convert NV12 to RGB OpenCL kernel!" );
@@ -208,7 +208,7 @@ QCStatus_e CL2DPipelineConvert::ConvertFromUYVYToRGB( cl_mem bufferSrc, uint32_t
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute convert UYVY to RGB OpenCL kernel!" );
@@ -259,7 +259,7 @@ QCStatus_e CL2DPipelineConvert::ConvertFromUYVYToNV12( cl_mem bufferSrc, uint32_
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute convert UYVY to NV12 OpenCL kernel!" );
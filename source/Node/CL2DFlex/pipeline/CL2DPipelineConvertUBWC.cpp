@@ -175,7 +175,7 @@ QCStatus_e CL2DPipelineConvertUBWC::ConvertUBWCFromNV12UBWCToNV12( ImageDescript
         /*set local work size to NULL, device would choose optimal size automatically*/
         OpenclWorkParams.pLocalWorkSize = NULL;
 
-        ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+        ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     }
 
     if ( QC_STATUS_OK != ret )
@@ -0,0 +1,747 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "pipeline/CL2DCpuKernels.hpp"
+#include "pipeline/CL2DPipelineCpu.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* round of OpenCL, half way cases away from zero */
+static inline int32_t RoundToInt( float value )
+{
+    return (int32_t) std::round( value );
+}
+
+/* round( pos * native_recip( size ) * scale ) of the kernels */
+static inline int32_t SampleRecip( int32_t pos, float recip, int32_t scale )
+{
+    return RoundToInt( (float) pos * recip * (float) scale );
+}
+
+/* round( pos / size * scale ) of the kernels */
+static inline int32_t SampleDivide( int32_t pos, int32_t size, int32_t scale )
+{
+    return RoundToInt( (float) pos / (float) size * (float) scale );
+}
+
+static void FillPadding( uint8_t *pDst, uint32_t num, uint32_t paddingValue )
+{
+    uint8_t R = ( paddingValue >> 16 ) & 0xFF;
+    uint8_t G = ( paddingValue >> 8 ) & 0xFF;
+    uint8_t B = paddingValue & 0xFF;
+    for ( uint32_t i = 0; i < num; i++ )
+    {
+        pDst[i * 3] = R;
+        pDst[i * 3 + 1] = G;
+        pDst[i * 3 + 2] = B;
+    }
+}
+
+CL2DPipelineCpu::CL2DPipelineCpu( CL2DCpuWorkers &workers ) : m_workers( workers ) {}
+
+CL2DPipelineCpu::~CL2DPipelineCpu() {}
+
+bool CL2DPipelineCpu::IsSupported( const CL2DFlex_Config_t &config, uint32_t inputId )
+{
+    CL2DFlex_Work_Mode_e workMode = config.workModes[inputId];
+
+    return ( CL2DFLEX_WORK_MODE_CONVERT == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_REMAP_NEAREST == workMode );
+}
+
+QCStatus_e
+CL2DPipelineCpu::Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                       OpenclSrv *pOpenclSrvObj,
+                       std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    m_inputId = inputId;
+    m_pKernel = pKernel;
+    m_pOpenclSrvObj = nullptr;
+    m_config = *pConfig;
+    m_pipeline = CL2DFLEX_PIPELINE_MAX;
+
+    CL2DFlex_Work_Mode_e workMode = m_config.workModes[m_inputId];
+    QCImageFormat_e inputFormat = m_config.inputFormats[m_inputId];
+    QCImageFormat_e outputFormat = m_config.outputFormat;
+    CL2DFlex_ROIConfig_t &roi = m_config.ROIs[m_inputId];
+    bool bFullROI = ( m_config.outputWidth == roi.width ) &&
+                    ( m_config.outputHeight == roi.height );
+
+    if ( CL2DFLEX_WORK_MODE_CONVERT == workMode )
+    {
+        if ( bFullROI && ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+             ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) )
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_CONVERT_NV12_TO_RGB;
+        }
+        else if ( bFullROI && ( QC_IMAGE_FORMAT_UYVY == inputFormat ) &&
+                  ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) )
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_CONVERT_UYVY_TO_RGB;
+        }
+        else if ( bFullROI && ( QC_IMAGE_FORMAT_UYVY == inputFormat ) &&
+                  ( QC_IMAGE_FORMAT_NV12 == outputFormat ) )
+        {
+            m_pipeline = CL2DFLEX_PIPELINE_CONVERT_UYVY_TO_NV12;
+        }
+        else
+        {
+            /* invalid pipeline */
+        }
+    }
+    else if ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST == workMode )
+    {
+        if ( QC_IMAGE_FORMAT_RGB888 == outputFormat )
+        {
+            if ( QC_IMAGE_FORMAT_NV12 == inputFormat )
+            {
+                m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB;
+            }
+            else if ( QC_IMAGE_FORMAT_UYVY == inputFormat )
+            {
+                m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_RGB;
+            }
+            else if ( QC_IMAGE_FORMAT_RGB888 == inputFormat )
+            {
+                m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_RGB_TO_RGB;
+            }
+            else
+            {
+                /* invalid pipeline */
+            }
+        }
+        else if ( QC_IMAGE_FORMAT_NV12 == outputFormat )
+        {
+            if ( QC_IMAGE_FORMAT_UYVY == inputFormat )
+            {
+                m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_NV12;
+            }
+            else if ( QC_IMAGE_FORMAT_NV12 == inputFormat )
+            {
+                m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_NV12;
+            }
+            else
+            {
+                /* invalid pipeline */
+            }
+        }
+        else
+        {
+            /* invalid pipeline */
+        }
+    }
+    else if ( ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == workMode ) &&
+              ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+              ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB;
+    }
+    else if ( ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == workMode ) &&
+              ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+              ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) && ( 1 == m_config.numOfInputs ) )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE;
+    }
+    else if ( ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE == workMode ) &&
+              ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+              ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) && ( 1 == m_config.numOfInputs ) )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB_MULTIPLE;
+    }
+    else if ( ( CL2DFLEX_WORK_MODE_REMAP_NEAREST == workMode ) &&
+              ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+              ( QC_IMAGE_FORMAT_RGB888 == outputFormat ) )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_RGB;
+    }
+    else if ( ( CL2DFLEX_WORK_MODE_REMAP_NEAREST == workMode ) &&
+              ( QC_IMAGE_FORMAT_NV12 == inputFormat ) &&
+              ( QC_IMAGE_FORMAT_BGR888 == outputFormat ) )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_BGR;
+    }
+    else
+    {
+        /* invalid pipeline */
+    }
+
+    if ( CL2DFLEX_PIPELINE_MAX == m_pipeline )
+    {
+        QC_ERROR( "Invalid CL2DFlex cpu pipeline for inputId=%u!", m_inputId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline ) )
+    {
+        /* the ROIs are read for each frame, as the OpenCL kernels do, without a ROIs buffer each
+         * frame gives its ROIs */
+        if ( m_config.ROIsBufferId < buffers.size() )
+        {
+            m_pROIs = (const int32_t *) buffers[m_config.ROIsBufferId].get().pBuf;
+        }
+        if ( ( nullptr == m_pROIs ) && ( UINT32_MAX != m_config.ROIsBufferId ) )
+        {
+            QC_ERROR( "Invalid ROIs buffer!" );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+    }
+    else if ( ( CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_RGB == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_BGR == m_pipeline ) )
+    {
+        uint32_t mapXBufferId = m_config.remapTable[m_inputId].mapXBufferId;
+        uint32_t mapYBufferId = m_config.remapTable[m_inputId].mapYBufferId;
+        if ( ( mapXBufferId < buffers.size() ) && ( mapYBufferId < buffers.size() ) )
+        {
+            m_pMapX = (const float *) buffers[mapXBufferId].get().pBuf;
+            m_pMapY = (const float *) buffers[mapYBufferId].get().pBuf;
+        }
+        if ( ( nullptr == m_pMapX ) || ( nullptr == m_pMapY ) )
+        {
+            QC_ERROR( "Invalid mapX or mapY buffer!" );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+    }
+    else if ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB == m_pipeline )
+    {
+        float inputRatio = (float) roi.height / (float) roi.width;
+        float outputRatio = (float) m_config.outputHeight / (float) m_config.outputWidth;
+        m_samplings.resize( 1 );
+        SetupLetterbox( roi, inputRatio, outputRatio, 0, m_samplings[0] );
+    }
+    else if ( ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_RGB == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_RGB_TO_RGB == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_NV12 == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_NV12 == m_pipeline ) )
+    {
+        m_samplings.resize( 1 );
+        SetupResize( roi, m_samplings[0] );
+    }
+    else
+    {
+        /* the convert pipelines sample the ROI directly */
+    }
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineCpu::Deinit()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    m_samplings.clear();
+    m_xInUV.clear();
+    m_yInUV.clear();
+    m_pROIs = nullptr;
+    m_pMapX = nullptr;
+    m_pMapY = nullptr;
+
+    return ret;
+}
+
+void CL2DPipelineCpu::SetupResize( const CL2DFlex_ROIConfig_t &roi, Sampling_t &sampling )
+{
+    int32_t width = (int32_t) m_config.outputWidth;
+    int32_t height = (int32_t) m_config.outputHeight;
+    /* the ROI offset in output pixels passed to the resize kernels */
+    int32_t roiX = (int32_t) ( roi.x / roi.width * m_config.outputWidth );
+    int32_t roiY = (int32_t) ( roi.y / roi.height * m_config.outputHeight );
+    float recipWidth = 1.0f / (float) width;
+    float recipHeight = 1.0f / (float) height;
+    /* the kernels writing RGB888 from NV12 or UYVY multiply by the reciprocal, the others divide */
+    bool bRecip = ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB == m_pipeline ) ||
+                  ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_RGB == m_pipeline );
+
+    sampling.xIn.resize( width );
+    sampling.yIn.resize( height );
+    for ( int32_t x = 0; x < width; x++ )
+    {
+        sampling.xIn[x] = bRecip ? SampleRecip( x + roiX, recipWidth, roi.width )
+                                 : SampleDivide( x + roiX, width, roi.width );
+    }
+    for ( int32_t y = 0; y < height; y++ )
+    {
+        sampling.yIn[y] = bRecip ? SampleRecip( y + roiY, recipHeight, roi.height )
+                                 : SampleDivide( y + roiY, height, roi.height );
+    }
+    sampling.validWidth = (uint32_t) width;
+    sampling.validHeight = (uint32_t) height;
+    sampling.dstOffset = 0;
+
+    if ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_NV12 == m_pipeline )
+    {
+        /* the even source pixel of the pixel pair holding the chroma */
+        m_xInUV.resize( width / 2 );
+        m_yInUV.resize( height / 2 );
+        for ( int32_t x = 0; x < width / 2; x++ )
+        {
+            m_xInUV[x] = SampleDivide( ( x + roiX / 2 ) << 1, width, roi.width );
+        }
+        for ( int32_t y = 0; y < height / 2; y++ )
+        {
+            m_yInUV[y] = SampleDivide( ( y + roiY / 2 ) << 1, height, roi.height );
+        }
+    }
+    else if ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_NV12 == m_pipeline )
+    {
+        /* the chroma plane sampled as the kernel does */
+        m_xInUV.resize( width / 2 );
+        m_yInUV.resize( height / 2 );
+        for ( int32_t x = 0; x < width / 2; x++ )
+        {
+            m_xInUV[x] = SampleDivide( x + roiX / 2, width, roi.width );
+        }
+        for ( int32_t y = 0; y < height / 2; y++ )
+        {
+            m_yInUV[y] = SampleDivide( y + roiY / 2, height, roi.height );
+        }
+    }
+    else
+    {
+        /* no chroma plane in the output */
+    }
+}
+
+void CL2DPipelineCpu::SetupLetterbox( const CL2DFlex_ROIConfig_t &roi, float inputRatio,
+                                      float outputRatio, uint32_t dstOffset, Sampling_t &sampling )
+{
+    int32_t width = (int32_t) m_config.outputWidth;
+    int32_t height = (int32_t) m_config.outputHeight;
+
+    sampling.xIn.resize( width );
+    sampling.yIn.resize( height );
+    sampling.validWidth = 0;
+    sampling.validHeight = 0;
+    sampling.dstOffset = dstOffset;
+    if ( inputRatio < outputRatio )
+    {
+        /* scaled by the width, padding at the bottom */
+        float recip = 1.0f / (float) width;
+        float limit = (float) width * inputRatio;
+        for ( int32_t x = 0; x < width; x++ )
+        {
+            sampling.xIn[x] = SampleRecip( x, recip, roi.width ) + roi.x;
+        }
+        for ( int32_t y = 0; y < height; y++ )
+        {
+            sampling.yIn[y] = SampleRecip( y, recip, roi.width ) + roi.y;
+            if ( (float) y < limit )
+            {
+                sampling.validHeight++;
+            }
+        }
+        sampling.validWidth = (uint32_t) width;
+    }
+    else
+    {
+        /* scaled by the height, padding at the right */
+        float recip = 1.0f / (float) height;
+        float limit = (float) height * ( 1.0f / inputRatio );
+        for ( int32_t x = 0; x < width; x++ )
+        {
+            sampling.xIn[x] = SampleRecip( x, recip, roi.height ) + roi.x;
+            if ( (float) x < limit )
+            {
+                sampling.validWidth++;
+            }
+        }
+        for ( int32_t y = 0; y < height; y++ )
+        {
+            sampling.yIn[y] = SampleRecip( y, recip, roi.height ) + roi.y;
+        }
+        sampling.validHeight = (uint32_t) height;
+    }
+}
+
+void CL2DPipelineCpu::SetupMultiple( const CL2DFlex_ROIConfig_t *pFrameROIs, uint32_t numOfROIs,
+                                     uint32_t outputStride )
+{
+    int32_t width = (int32_t) m_config.outputWidth;
+    int32_t height = (int32_t) m_config.outputHeight;
+    float recipWidth = 1.0f / (float) width;
+    float recipHeight = 1.0f / (float) height;
+
+    m_samplings.resize( numOfROIs );
+    for ( uint32_t i = 0; i < numOfROIs; i++ )
+    {
+        Sampling_t &sampling = m_samplings[i];
+        CL2DFlex_ROIConfig_t roi;
+        if ( nullptr != pFrameROIs )
+        {
+            roi = pFrameROIs[i];
+        }
+        else
+        {
+            roi.x = (uint32_t) m_pROIs[i * 4];
+            roi.y = (uint32_t) m_pROIs[i * 4 + 1];
+            roi.width = (uint32_t) m_pROIs[i * 4 + 2];
+            roi.height = (uint32_t) m_pROIs[i * 4 + 3];
+        }
+        uint32_t dstOffset = i * m_config.outputHeight * outputStride;
+
+        if ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline )
+        {
+            float inputRatio = (float) roi.height * ( 1.0f / (float) roi.width );
+            float outputRatio = (float) height * recipWidth;
+            SetupLetterbox( roi, inputRatio, outputRatio, dstOffset, sampling );
+        }
+        else
+        {
+            sampling.xIn.resize( width );
+            sampling.yIn.resize( height );
+            for ( int32_t x = 0; x < width; x++ )
+            {
+                sampling.xIn[x] = SampleRecip( x, recipWidth, roi.width ) + roi.x;
+            }
+            for ( int32_t y = 0; y < height; y++ )
+            {
+                sampling.yIn[y] = SampleRecip( y, recipHeight, roi.height ) + roi.y;
+            }
+            sampling.validWidth = (uint32_t) width;
+            sampling.validHeight = (uint32_t) height;
+            sampling.dstOffset = dstOffset;
+        }
+    }
+}
+
+QCStatus_e CL2DPipelineCpu::Execute( ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    const uint8_t *pSrc = (const uint8_t *) input.pBuf + input.offset;
+    uint8_t *pDst = (uint8_t *) output.pBuf + output.offset;
+
+    if ( ( nullptr == input.pBuf ) || ( nullptr == output.pBuf ) )
+    {
+        QC_ERROR( "Null buffer for inputId=%u!", m_inputId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline ) ||
+              ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline ) )
+    {
+        const CL2DFlex_ROIConfig_t *pFrameROIs = nullptr;
+        uint32_t numOfROIs = 0;
+        ret = GetFrameROIs( input, pFrameROIs, numOfROIs );
+        if ( QC_STATUS_OK != ret )
+        {
+            /* the ROIs of the frame are invalid */
+        }
+        else if ( ( 0 == numOfROIs ) && ( nullptr == m_pROIs ) )
+        {
+            QC_ERROR( "No ROIs buffer and no ROIs in the frame for inputId=%u!", m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            /* all the ROIs are written from the output offset */
+            SetupMultiple( pFrameROIs, ( 0 < numOfROIs ) ? numOfROIs : m_config.numOfROIs,
+                           output.stride[0] );
+            SampleToRGB( pSrc, pDst, input, output );
+        }
+    }
+    else if ( 0 == output.batchSize )
+    {
+        QC_ERROR( "Invalid output batch size for inputId=%u!", m_inputId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        uint32_t sizeOne = (uint32_t) ( output.size ) / ( output.batchSize );
+        pDst += m_inputId * sizeOne;
+
+        if ( CL2DFLEX_PIPELINE_CONVERT_NV12_TO_RGB == m_pipeline )
+        {
+            ConvertNV12ToRGB( pSrc, pDst, input, output );
+        }
+        else if ( CL2DFLEX_PIPELINE_CONVERT_UYVY_TO_RGB == m_pipeline )
+        {
+            ConvertUYVYToRGB( pSrc, pDst, input, output );
+        }
+        else if ( CL2DFLEX_PIPELINE_CONVERT_UYVY_TO_NV12 == m_pipeline )
+        {
+            ConvertUYVYToNV12( pSrc, pDst, input, output );
+        }
+        else if ( ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_RGB == m_pipeline ) ||
+                  ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_RGB == m_pipeline ) ||
+                  ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB == m_pipeline ) )
+        {
+            SampleToRGB( pSrc, pDst, input, output );
+        }
+        else if ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_RGB_TO_RGB == m_pipeline )
+        {
+            ResizeRGBToRGB( pSrc, pDst, input, output );
+        }
+        else if ( ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_NV12 == m_pipeline ) ||
+                  ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_NV12_TO_NV12 == m_pipeline ) )
+        {
+            ResizeToNV12( pSrc, pDst, input, output );
+        }
+        else if ( ( CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_RGB == m_pipeline ) ||
+                  ( CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_BGR == m_pipeline ) )
+        {
+            RemapNV12ToRGB( pSrc, pDst, input, output );
+        }
+        else
+        {
+            QC_ERROR( "Invalid CL2DFlex cpu pipeline for inputId=%u!", m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+    }
+
+    return ret;
+}
+
+void CL2DPipelineCpu::SampleToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                                   ImageDescriptor_t &output )
+{
+    uint32_t width = m_config.outputWidth;
+    uint32_t height = m_config.outputHeight;
+    uint32_t outputStride = output.stride[0];
+    bool bUYVY = ( QC_IMAGE_FORMAT_UYVY == m_config.inputFormats[m_inputId] );
+    const uint8_t *pUVPlane = pSrc + input.planeBufSize[0];
+
+    m_workers.Run( (uint32_t) m_samplings.size() * height, [&]( uint32_t begin, uint32_t end ) {
+        std::vector<uint8_t> Y( width ), U( width ), V( width );
+        for ( uint32_t row = begin; row < end; row++ )
+        {
+            const Sampling_t &sampling = m_samplings[row / height];
+            uint32_t y = row % height;
+            uint8_t *pDstRow = pDst + sampling.dstOffset + y * outputStride;
+            uint32_t validWidth = ( y < sampling.validHeight ) ? sampling.validWidth : 0;
+            if ( 0 == validWidth )
+            {
+                /* the padding row */
+            }
+            else if ( bUYVY )
+            {
+                const uint8_t *pRow = pSrc + sampling.yIn[y] * input.stride[0];
+                for ( uint32_t x = 0; x < validWidth; x++ )
+                {
+                    int32_t xIn = sampling.xIn[x];
+                    Y[x] = pRow[xIn * 2 + 1];
+                    U[x] = pRow[( xIn / 2 ) * 4];
+                    V[x] = pRow[( xIn / 2 ) * 4 + 2];
+                }
+            }
+            else
+            {
+                int32_t yIn = sampling.yIn[y];
+                const uint8_t *pRow = pSrc + yIn * input.stride[0];
+                const uint8_t *pUVRow = pUVPlane + ( yIn / 2 ) * input.stride[1];
+                for ( uint32_t x = 0; x < validWidth; x++ )
+                {
+                    int32_t xIn = sampling.xIn[x];
+                    Y[x] = pRow[xIn];
+                    U[x] = pUVRow[( xIn / 2 ) << 1];
+                    V[x] = pUVRow[( ( xIn / 2 ) << 1 ) + 1];
+                }
+            }
+            CL2DCpuYUVToRGBRow( Y.data(), U.data(), V.data(), validWidth, false, pDstRow );
+            FillPadding( pDstRow + validWidth * 3, width - validWidth,
+                         m_config.letterboxPaddingValue );
+        }
+    } );
+}
+
+void CL2DPipelineCpu::ConvertNV12ToRGB( const uint8_t *pSrc, uint8_t *pDst,
+                                        ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    /* the kernel converts 2x2 pixels per work item, an odd last row or column is not written */
+    uint32_t width = ( output.width / 2 ) * 2;
+    uint32_t height = ( output.height / 2 ) * 2;
+    uint32_t roiX = m_config.ROIs[m_inputId].x / 2;
+    uint32_t roiY = m_config.ROIs[m_inputId].y / 2;
+    const uint8_t *pUVPlane = pSrc + input.planeBufSize[0];
+
+    m_workers.Run( height, [&]( uint32_t begin, uint32_t end ) {
+        std::vector<uint8_t> U( width ), V( width );
+        for ( uint32_t row = begin; row < end; row++ )
+        {
+            uint32_t pair = row / 2;
+            const uint8_t *pRow =
+                    pSrc + ( ( ( pair + roiY ) << 1 ) + ( row & 1 ) ) * input.stride[0] + roiX * 2;
+            const uint8_t *pUVRow = pUVPlane + ( pair + roiY ) * input.stride[1] + roiX * 2;
+            for ( uint32_t x = 0; x < width; x++ )
+            {
+                U[x] = pUVRow[( x / 2 ) * 2];
+                V[x] = pUVRow[( x / 2 ) * 2 + 1];
+            }
+            CL2DCpuYUVToRGBRow( pRow, U.data(), V.data(), width, false,
+                                pDst + row * output.stride[0] );
+        }
+    } );
+}
+
+void CL2DPipelineCpu::ConvertUYVYToRGB( const uint8_t *pSrc, uint8_t *pDst,
+                                        ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    /* the kernel converts 2 pixels per work item, an odd last column is not written */
+    uint32_t width = ( output.width / 2 ) * 2;
+    uint32_t roiX = m_config.ROIs[m_inputId].x / 2;
+    uint32_t roiY = m_config.ROIs[m_inputId].y;
+
+    m_workers.Run( output.height, [&]( uint32_t begin, uint32_t end ) {
+        std::vector<uint8_t> Y( width ), U( width ), V( width );
+        for ( uint32_t row = begin; row < end; row++ )
+        {
+            const uint8_t *pRow = pSrc + ( row + roiY ) * input.stride[0] + roiX * 4;
+            for ( uint32_t x = 0; x < width; x++ )
+            {
+                Y[x] = pRow[( x / 2 ) * 4 + 1 + ( x & 1 ) * 2];
+                U[x] = pRow[( x / 2 ) * 4];
+                V[x] = pRow[( x / 2 ) * 4 + 2];
+            }
+            CL2DCpuYUVToRGBRow( Y.data(), U.data(), V.data(), width, false,
+                                pDst + row * output.stride[0] );
+        }
+    } );
+}
+
+void CL2DPipelineCpu::ConvertUYVYToNV12( const uint8_t *pSrc, uint8_t *pDst,
+                                         ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    uint32_t pairs = output.width / 2;
+    uint32_t roiX = m_config.ROIs[m_inputId].x / 2;
+    uint32_t roiY = m_config.ROIs[m_inputId].y / 2;
+    uint32_t inputStride = input.stride[0];
+
+    m_workers.Run( output.height / 2, [&]( uint32_t begin, uint32_t end ) {
+        for ( uint32_t row = begin; row < end; row++ )
+        {
+            const uint8_t *pRow1 = pSrc + ( ( row + roiY ) << 1 ) * inputStride + roiX * 4;
+            const uint8_t *pRow2 = pRow1 + inputStride;
+            uint8_t *pY1 = pDst + ( row << 1 ) * output.stride[0];
+            uint8_t *pY2 = pY1 + output.stride[0];
+            uint8_t *pUV = pDst + output.planeBufSize[0] + row * output.stride[1];
+            for ( uint32_t x = 0; x < pairs; x++ )
+            {
+                pY1[x * 2] = pRow1[x * 4 + 1];
+                pY1[x * 2 + 1] = pRow1[x * 4 + 3];
+                pY2[x * 2] = pRow2[x * 4 + 1];
+                pY2[x * 2 + 1] = pRow2[x * 4 + 3];
+                /* ( U1 + U2 ) / 2.0f converted toward zero by the kernel */
+                pUV[x * 2] = (uint8_t) ( ( pRow1[x * 4] + pRow2[x * 4] ) >> 1 );
+                pUV[x * 2 + 1] = (uint8_t) ( ( pRow1[x * 4 + 2] + pRow2[x * 4 + 2] ) >> 1 );
+            }
+        }
+    } );
+}
+
+void CL2DPipelineCpu::ResizeRGBToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                                      ImageDescriptor_t &output )
+{
+    const Sampling_t &sampling = m_samplings[0];
+
+    m_workers.Run( m_config.outputHeight, [&]( uint32_t begin, uint32_t end ) {
+        for ( uint32_t y = begin; y < end; y++ )
+        {
+            const uint8_t *pRow = pSrc + sampling.yIn[y] * input.stride[0];
+            uint8_t *pDstRow = pDst + y * output.stride[0];
+            for ( uint32_t x = 0; x < m_config.outputWidth; x++ )
+            {
+                const uint8_t *pPixel = pRow + sampling.xIn[x] * 3;
+                pDstRow[x * 3] = pPixel[0];
+                pDstRow[x * 3 + 1] = pPixel[1];
+                pDstRow[x * 3 + 2] = pPixel[2];
+            }
+        }
+    } );
+}
+
+void CL2DPipelineCpu::ResizeToNV12( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                                    ImageDescriptor_t &output )
+{
+    const Sampling_t &sampling = m_samplings[0];
+    bool bUYVY = ( CL2DFLEX_PIPELINE_RESIZE_NEAREST_UYVY_TO_NV12 == m_pipeline );
+    uint32_t width = m_config.outputWidth;
+    uint32_t height = m_config.outputHeight;
+
+    m_workers.Run( height, [&]( uint32_t begin, uint32_t end ) {
+        for ( uint32_t y = begin; y < end; y++ )
+        {
+            uint8_t *pY = pDst + y * output.stride[0];
+            const uint8_t *pRow = pSrc + sampling.yIn[y] * input.stride[0];
+            for ( uint32_t x = 0; x < width; x++ )
+            {
+                pY[x] = bUYVY ? pRow[sampling.xIn[x] * 2 + 1] : pRow[sampling.xIn[x]];
+            }
+
+            if ( y < height / 2 )
+            {
+                uint8_t *pUV = pDst + output.planeBufSize[0] + y * output.stride[1];
+                if ( bUYVY )
+                {
+                    const uint8_t *pUVRow = pSrc + m_yInUV[y] * input.stride[0];
+                    for ( uint32_t x = 0; x < width / 2; x++ )
+                    {
+                        const uint8_t *pPair = pUVRow + ( m_xInUV[x] / 2 ) * 4;
+                        pUV[x * 2] = pPair[0];
+                        pUV[x * 2 + 1] = pPair[2];
+                    }
+                }
+                else
+                {
+                    const uint8_t *pUVRow =
+                            pSrc + input.planeBufSize[0] + m_yInUV[y] * input.stride[1];
+                    for ( uint32_t x = 0; x < width / 2; x++ )
+                    {
+                        const uint8_t *pPair = pUVRow + ( m_xInUV[x] << 1 );
+                        pUV[x * 2] = pPair[0];
+                        pUV[x * 2 + 1] = pPair[1];
+                    }
+                }
+            }
+        }
+    } );
+}
+
+void CL2DPipelineCpu::RemapNV12ToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                                      ImageDescriptor_t &output )
+{
+    uint32_t width = m_config.outputWidth;
+    const CL2DFlex_ROIConfig_t &roi = m_config.ROIs[m_inputId];
+    float maxX = (float) roi.width - 1.0f;
+    float maxY = (float) roi.height - 1.0f;
+    bool bBGR = ( CL2DFLEX_PIPELINE_REMAP_NEAREST_NV12_TO_BGR == m_pipeline );
+    const uint8_t *pUVPlane = pSrc + input.planeBufSize[0];
+
+    m_workers.Run( m_config.outputHeight, [&]( uint32_t begin, uint32_t end ) {
+        std::vector<uint8_t> Y( width ), U( width ), V( width );
+        for ( uint32_t y = begin; y < end; y++ )
+        {
+            const float *pMapX = m_pMapX + y * width;
+            const float *pMapY = m_pMapY + y * width;
+            for ( uint32_t x = 0; x < width; x++ )
+            {
+                /* clamped before the conversion to int, the same for the coordinates in range */
+                float mapX = std::min( std::max( std::round( pMapX[x] ), 0.0f ), maxX );
+                float mapY = std::min( std::max( std::round( pMapY[x] ), 0.0f ), maxY );
+                int32_t xIn = (int32_t) mapX + (int32_t) roi.x;
+                int32_t yIn = (int32_t) mapY + (int32_t) roi.y;
+                const uint8_t *pUV =
+                        pUVPlane + ( yIn / 2 ) * input.stride[1] + ( ( xIn / 2 ) << 1 );
+                Y[x] = pSrc[yIn * input.stride[0] + xIn];
+                U[x] = pUV[0];
+                V[x] = pUV[1];
+            }
+            CL2DCpuYUVToRGBRow( Y.data(), U.data(), V.data(), width, bBGR,
+                                pDst + y * output.stride[0] );
+        }
+    } );
+}
+
+}   // namespace Node
+}   // namespace QC
@@ -0,0 +1,87 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_PIPELINE_CPU_HPP
+#define QC_CL2D_PIPELINE_CPU_HPP
+
+#include "pipeline/CL2DCpuWorkers.hpp"
+#include "pipeline/CL2DPipelineBase.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* the convert, resize, letterbox, letterbox multiple, resize multiple and remap pipelines on the
+ * CPU, with the same sampling and color convert formula as the OpenCL kernels, the rows of the
+ * output are processed by the worker threads */
+class CL2DPipelineCpu : public CL2DPipelineBase
+{
+public:
+    CL2DPipelineCpu( CL2DCpuWorkers &workers );
+
+    ~CL2DPipelineCpu();
+
+    /* pKernel and pOpenclSrvObj are not used */
+    QCStatus_e Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                     OpenclSrv *pOpenclSrvObj,
+                     std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
+
+    QCStatus_e Deinit();
+
+    /* process the input synchronously, the output is ready when it returns */
+    QCStatus_e Execute( ImageDescriptor_t &input, ImageDescriptor_t &output );
+
+    /* check if the work mode of an input has a CPU pipeline */
+    static bool IsSupported( const CL2DFlex_Config_t &config, uint32_t inputId );
+
+private:
+    /* the source pixel of each output pixel of one resized or letterboxed image */
+    typedef struct
+    {
+        std::vector<int32_t> xIn; /**<the source column of each output column*/
+        std::vector<int32_t> yIn; /**<the source row of each output row*/
+        uint32_t validWidth;      /**<the output columns sampled, the others are padding*/
+        uint32_t validHeight;     /**<the output rows sampled, the others are padding*/
+        uint32_t dstOffset;       /**<the byte offset of the image in the output*/
+    } Sampling_t;
+
+    void SetupResize( const CL2DFlex_ROIConfig_t &roi, Sampling_t &sampling );
+    void SetupLetterbox( const CL2DFlex_ROIConfig_t &roi, float inputRatio, float outputRatio,
+                         uint32_t dstOffset, Sampling_t &sampling );
+    /* the samplings of the ROIs of the multiple work modes, the ROIs of the frame or, when it
+     * carries none, the ROIs read from the ROIs buffer */
+    void SetupMultiple( const CL2DFlex_ROIConfig_t *pFrameROIs, uint32_t numOfROIs,
+                        uint32_t outputStride );
+
+    void SampleToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                      ImageDescriptor_t &output );
+    void ConvertNV12ToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                           ImageDescriptor_t &output );
+    void ConvertUYVYToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                           ImageDescriptor_t &output );
+    void ConvertUYVYToNV12( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                            ImageDescriptor_t &output );
+    void ResizeRGBToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                         ImageDescriptor_t &output );
+    void ResizeToNV12( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                       ImageDescriptor_t &output );
+    void RemapNV12ToRGB( const uint8_t *pSrc, uint8_t *pDst, ImageDescriptor_t &input,
+                         ImageDescriptor_t &output );
+
+private:
+    CL2DCpuWorkers &m_workers;
+    std::vector<Sampling_t> m_samplings;
+    std::vector<int32_t> m_xInUV; /**<the source chroma column of the nv12 output chroma columns*/
+    std::vector<int32_t> m_yInUV; /**<the source chroma row of the nv12 output chroma rows*/
+    const int32_t *m_pROIs = nullptr;
+    const float *m_pMapX = nullptr;
+    const float *m_pMapY = nullptr;
+
+};   // class CL2DPipelineCpu
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QC_CL2D_PIPELINE_CPU_HPP
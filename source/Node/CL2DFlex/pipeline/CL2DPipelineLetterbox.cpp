@@ -150,7 +150,7 @@ QCStatus_e CL2DPipelineLetterbox::LetterboxFromNV12ToRGB( cl_mem bufferSrc, uint
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute letterbox NV12 to RGB OpenCL kernel!" );
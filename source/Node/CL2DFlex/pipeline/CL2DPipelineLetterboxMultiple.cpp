@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: BSD-3-Clause-Clear
 
 
+#include <algorithm>
+
 #include "pipeline/CL2DPipelineLetterboxMultiple.hpp"
 
 namespace QC
@@ -28,6 +30,10 @@ QCStatus_e CL2DPipelineLetterboxMultiple::Init(
     {
         m_pipeline = CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE;
         ret = m_pOpenclSrvObj->CreateKernel( pKernel, "LetterboxNV12ToRGBMultiple" );
+        if ( QC_STATUS_OK == ret )
+        {
+            ret = m_pOpenclSrvObj->CreateKernel( &m_kernelROIs, "LetterboxNV12ToRGBMultipleROIs" );
+        }
     }
     else
     {
@@ -37,19 +43,31 @@ QCStatus_e CL2DPipelineLetterboxMultiple::Init(
 
     m_pKernel = pKernel;
 
-    if ( QC_STATUS_OK == ret )
+    if ( QC_STATUS_OK != ret )
+    {
+        /* the pipeline is invalid */
+    }
+    else if ( m_config.ROIsBufferId < buffers.size() )
     {
         uint32_t ROIsBufferId = m_config.ROIsBufferId;
         QCBufferDescriptorBase_t &ROIsBufferDesc = buffers[ROIsBufferId];
         TensorDescriptor_t *pROIsBufferDesc = dynamic_cast<TensorDescriptor_t *>( &ROIsBufferDesc );
         ret = m_pOpenclSrvObj->RegBufferDesc(
                 dynamic_cast<QCBufferDescriptorBase_t &>( *pROIsBufferDesc ), m_bufferROIs );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to register ROIs buffer!" );
+        }
     }
-    if ( QC_STATUS_OK != ret )
+    else if ( UINT32_MAX != m_config.ROIsBufferId )
     {
-        QC_ERROR( "Failed to register ROIs buffer!" );
+        QC_ERROR( "Invalid ROIs buffer ID %u!", m_config.ROIsBufferId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        /* no ROIs buffer, each frame gives its ROIs */
     }
-
 
     return ret;
 }
@@ -86,19 +104,37 @@ QCStatus_e CL2DPipelineLetterboxMultiple::Execute( ImageDescriptor_t &input,
         }
         else
         {
+            const CL2DFlex_ROIConfig_t *pROIs = nullptr;
+            uint32_t numOfROIs = 0;
             uint32_t srcOffset = input.offset;
             uint32_t dstOffset = output.offset;
-            if ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE == m_pipeline )
+            ret = GetFrameROIs( input, pROIs, numOfROIs );
+            if ( QC_STATUS_OK != ret )
             {
-                ret = LetterboxFromNV12ToRGBMultiple( bufferSrc, srcOffset, bufferDst, dstOffset,
-                                                      input, output );
+                /* the ROIs of the frame are invalid */
             }
-            else
+            else if ( CL2DFLEX_PIPELINE_LETTERBOX_NEAREST_NV12_TO_RGB_MULTIPLE != m_pipeline )
             {
                 QC_ERROR( "Invalid CL2DFlex letterbox multiple pipeline for inputId=%d!",
                           m_inputId );
                 ret = QC_STATUS_BAD_ARGUMENTS;
             }
+            else if ( 0 < numOfROIs )
+            {
+                ret = LetterboxFromNV12ToRGBMultipleROIs( bufferSrc, srcOffset, bufferDst,
+                                                          dstOffset, pROIs, numOfROIs, input,
+                                                          output );
+            }
+            else if ( nullptr == m_bufferROIs )
+            {
+                QC_ERROR( "No ROIs buffer and no ROIs in the frame for inputId=%d!", m_inputId );
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else
+            {
+                ret = LetterboxFromNV12ToRGBMultiple( bufferSrc, srcOffset, bufferDst, dstOffset,
+                                                      input, output );
+            }
         }
     }
 
@@ -147,7 +183,7 @@ QCStatus_e CL2DPipelineLetterboxMultiple::LetterboxFromNV12ToRGBMultiple(
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute LetterboxMultiple NV12 to RGB OpenCL kernel!" );
@@ -157,5 +193,78 @@ QCStatus_e CL2DPipelineLetterboxMultiple::LetterboxFromNV12ToRGBMultiple(
     return ret;
 }
 
+QCStatus_e CL2DPipelineLetterboxMultiple::LetterboxFromNV12ToRGBMultipleROIs(
+        cl_mem bufferSrc, uint32_t srcOffset, cl_mem bufferDst, uint32_t dstOffset,
+        const CL2DFlex_ROIConfig_t *pROIs, uint32_t numOfROIs, ImageDescriptor_t &input,
+        ImageDescriptor_t &output )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    CL2DROIParams_t rois;
+    uint32_t roiBase = 0;
+    size_t numOfArgs = 13;
+    OpenclIfcae_Arg_t OpenclArgs[13];
+    OpenclArgs[0].pArg = (void *) &bufferSrc;
+    OpenclArgs[0].argSize = sizeof( cl_mem );
+    OpenclArgs[1].pArg = (void *) &srcOffset;
+    OpenclArgs[1].argSize = sizeof( cl_int );
+    OpenclArgs[2].pArg = (void *) &bufferDst;
+    OpenclArgs[2].argSize = sizeof( cl_mem );
+    OpenclArgs[3].pArg = (void *) &dstOffset;
+    OpenclArgs[3].argSize = sizeof( cl_int );
+    OpenclArgs[4].pArg = (void *) &rois;
+    OpenclArgs[4].argSize = sizeof( CL2DROIParams_t );
+    OpenclArgs[5].pArg = (void *) &roiBase;
+    OpenclArgs[5].argSize = sizeof( cl_int );
+    OpenclArgs[6].pArg = (void *) &( m_config.outputHeight );
+    OpenclArgs[6].argSize = sizeof( cl_int );
+    OpenclArgs[7].pArg = (void *) &( m_config.outputWidth );
+    OpenclArgs[7].argSize = sizeof( cl_int );
+    OpenclArgs[8].pArg = (void *) &( input.stride[0] );
+    OpenclArgs[8].argSize = sizeof( cl_int );
+    OpenclArgs[9].pArg = (void *) &( input.planeBufSize[0] );
+    OpenclArgs[9].argSize = sizeof( cl_int );
+    OpenclArgs[10].pArg = (void *) &( input.stride[1] );
+    OpenclArgs[10].argSize = sizeof( cl_int );
+    OpenclArgs[11].pArg = (void *) &( output.stride[0] );
+    OpenclArgs[11].argSize = sizeof( cl_int );
+    OpenclArgs[12].pArg = (void *) &( m_config.letterboxPaddingValue );
+    OpenclArgs[12].argSize = sizeof( cl_int );
+
+    /* the ROIs are copied into the kernel argument at enqueue time, so the kernels of this frame
+     * do not depend on a buffer the next frame may rewrite */
+    for ( ; ( QC_STATUS_OK == ret ) && ( roiBase < numOfROIs ); roiBase += CL2DFLEX_ROI_PARAMS_MAX )
+    {
+        uint32_t numOfDispatchROIs = std::min( numOfROIs - roiBase, CL2DFLEX_ROI_PARAMS_MAX );
+        for ( uint32_t i = 0; i < numOfDispatchROIs; i++ )
+        {
+            const CL2DFlex_ROIConfig_t &roi = pROIs[roiBase + i];
+            rois.ROIs[i * 4] = (cl_int) roi.x;
+            rois.ROIs[i * 4 + 1] = (cl_int) roi.y;
+            rois.ROIs[i * 4 + 2] = (cl_int) roi.width;
+            rois.ROIs[i * 4 + 3] = (cl_int) roi.height;
+        }
+
+        OpenclIface_WorkParams_t OpenclWorkParams;
+        OpenclWorkParams.workDim = 3;
+        size_t globalWorkSize[3] = { numOfDispatchROIs, output.width, output.height };
+        OpenclWorkParams.pGlobalWorkSize = globalWorkSize;
+        size_t globalWorkOffset[3] = { 0, 0, 0 };
+        OpenclWorkParams.pGlobalWorkOffset = globalWorkOffset;
+        /*set local work size to NULL, device would choose optimal size automatically*/
+        OpenclWorkParams.pLocalWorkSize = NULL;
+
+        ret = m_pOpenclSrvObj->ExecuteAsync( &m_kernelROIs, OpenclArgs, numOfArgs,
+                                             &OpenclWorkParams );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to execute LetterboxMultiple ROIs NV12 to RGB OpenCL kernel!" );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    return ret;
+}
+
 }   // namespace Node
 }   // namespace QC
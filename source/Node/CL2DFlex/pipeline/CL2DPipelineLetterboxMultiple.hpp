@@ -6,6 +6,7 @@
 #define QC_CL2D_PIPELINE_LETTERBOXMULTIPLE_HPP
 
 #include "pipeline/CL2DPipelineBase.hpp"
+#include "pipeline/CL2DROIParams.hpp"
 
 namespace QC
 {
@@ -33,8 +34,16 @@ private:
                                                ImageDescriptor_t &input,
                                                ImageDescriptor_t &output );
 
+    /* the ROIs of the frame, up to CL2DFLEX_ROI_PARAMS_MAX ROIs per kernel dispatch */
+    QCStatus_e LetterboxFromNV12ToRGBMultipleROIs( cl_mem bufferSrc, uint32_t srcOffset,
+                                                   cl_mem bufferDst, uint32_t dstOffset,
+                                                   const CL2DFlex_ROIConfig_t *pROIs,
+                                                   uint32_t numOfROIs, ImageDescriptor_t &input,
+                                                   ImageDescriptor_t &output );
+
 private:
-    cl_mem m_bufferROIs;
+    cl_mem m_bufferROIs = nullptr;
+    cl_kernel m_kernelROIs = nullptr;
 
 };   // class PipelineLetterboxMultiple
 
@@ -0,0 +1,391 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include <cmath>
+
+#include "pipeline/CL2DPipelineNormalize.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+CL2DPipelineNormalize::CL2DPipelineNormalize() {}
+
+CL2DPipelineNormalize::~CL2DPipelineNormalize() {}
+
+bool CL2DPipelineNormalize::IsNormalize( const CL2DFlex_Config_t &config, uint32_t inputId )
+{
+    return ( CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE == config.workModes[inputId] ) ||
+           ( CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE == config.workModes[inputId] );
+}
+
+QCStatus_e
+CL2DPipelineNormalize::Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                             OpenclSrv *pOpenclSrvObj,
+                             std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    m_inputId = inputId;
+    m_pOpenclSrvObj = pOpenclSrvObj;
+    m_config = *pConfig;
+
+    const CL2DFlex_ROIConfig_t &roi = m_config.ROIs[m_inputId];
+    if ( ( false == IsNormalize( m_config, m_inputId ) ) || ( 0 == roi.width ) ||
+         ( 0 == roi.height ) || ( 0 == m_config.outputWidth ) || ( 0 == m_config.outputHeight ) ||
+         ( ( QC_IMAGE_FORMAT_RGB888 != m_config.outputFormat ) &&
+           ( QC_IMAGE_FORMAT_BGR888 != m_config.outputFormat ) ) )
+    {
+        QC_ERROR( "Invalid CL2DFlex normalize pipeline for inputId=%d!", m_inputId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( QC_IMAGE_FORMAT_NV12 == m_config.inputFormats[m_inputId] )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_NORMALIZE_NV12_TO_TENSOR;
+        ret = m_pOpenclSrvObj->CreateKernel( pKernel, "NormalizeNV12" );
+    }
+    else if ( QC_IMAGE_FORMAT_UYVY == m_config.inputFormats[m_inputId] )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_NORMALIZE_UYVY_TO_TENSOR;
+        ret = m_pOpenclSrvObj->CreateKernel( pKernel, "NormalizeUYVY" );
+    }
+    else if ( QC_IMAGE_FORMAT_NV12_UBWC == m_config.inputFormats[m_inputId] )
+    {
+        m_pipeline = CL2DFLEX_PIPELINE_NORMALIZE_NV12UBWC_TO_TENSOR;
+        ret = m_pOpenclSrvObj->CreateKernel( pKernel, "NormalizeNV12UBWC" );
+    }
+    else
+    {
+        QC_ERROR( "Invalid CL2DFlex normalize pipeline for inputId=%d!", m_inputId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        /* the geometry of the kernel is fixed by the configuration, the output part is set for
+         * each frame by SetupOutput */
+        float outputWidth = (float) m_config.outputWidth;
+        float outputHeight = (float) m_config.outputHeight;
+        m_param = {};
+        m_param.roiX = (cl_int) roi.x;
+        m_param.roiY = (cl_int) roi.y;
+        m_param.roiWidth = (cl_int) roi.width;
+        m_param.roiHeight = (cl_int) roi.height;
+        m_param.validWidth = (cl_int) m_config.outputWidth;
+        m_param.validHeight = (cl_int) m_config.outputHeight;
+        m_param.paddingValue = (cl_int) m_config.letterboxPaddingValue;
+        m_param.bgr = ( QC_IMAGE_FORMAT_BGR888 == m_config.outputFormat ) ? 1 : 0;
+        if ( CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE == m_config.workModes[m_inputId] )
+        {
+            m_param.scaleX = (float) roi.width / outputWidth;
+            m_param.scaleY = (float) roi.height / outputHeight;
+        }
+        else
+        {
+            /* the same valid area as the letterbox work mode, padding the bottom or right edge */
+            float inputRatio = (float) roi.height / (float) roi.width;
+            float outputRatio = outputHeight / outputWidth;
+            if ( inputRatio < outputRatio )
+            {
+                m_param.scaleX = (float) roi.width / outputWidth;
+                m_param.validHeight = (cl_int) std::ceil( outputWidth * inputRatio );
+            }
+            else
+            {
+                m_param.scaleX = (float) roi.height / outputHeight;
+                m_param.validWidth = (cl_int) std::ceil( outputHeight / inputRatio );
+            }
+            m_param.scaleY = m_param.scaleX;
+        }
+    }
+
+    m_pKernel = pKernel;
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineNormalize::Deinit()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    // empty function
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineNormalize::Execute( ImageDescriptor_t &input, ImageDescriptor_t &output )
+{
+    QC_ERROR( "CL2DFlex normalize pipeline for inputId=%u requires a tensor output!", m_inputId );
+
+    return QC_STATUS_UNSUPPORTED;
+}
+
+QCStatus_e CL2DPipelineNormalize::SetupOutput( TensorDescriptor_t &output,
+                                               CL2DNormalizeParam_t &param )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    bool bQuantized = false;
+    size_t elementSize = 1;
+    uint32_t width = m_config.outputWidth;
+    uint32_t height = m_config.outputHeight;
+
+    switch ( output.tensorType )
+    {
+        case QC_TENSOR_TYPE_UFIXED_POINT_8:
+            bQuantized = true;
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_UINT_8;
+            break;
+        case QC_TENSOR_TYPE_UINT_8:
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_UINT_8;
+            break;
+        case QC_TENSOR_TYPE_SFIXED_POINT_8:
+            bQuantized = true;
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_INT_8;
+            break;
+        case QC_TENSOR_TYPE_INT_8:
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_INT_8;
+            break;
+        case QC_TENSOR_TYPE_FLOAT_16:
+            elementSize = 2;
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_FLOAT_16;
+            break;
+        case QC_TENSOR_TYPE_FLOAT_32:
+            elementSize = 4;
+            param.outputType = CL2DFLEX_NORMALIZE_OUTPUT_FLOAT_32;
+            break;
+        default:
+            QC_ERROR( "Unsupported output tensor type %d for inputId=%u!", output.tensorType,
+                      m_inputId );
+            ret = QC_STATUS_UNSUPPORTED;
+            break;
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        bool bDimsMatch = false;
+        if ( 4 == output.numDims )
+        {
+            if ( CL2DFLEX_TENSOR_LAYOUT_NCHW == m_config.tensorLayout )
+            {
+                bDimsMatch = ( 3 == output.dims[1] ) && ( height == output.dims[2] ) &&
+                             ( width == output.dims[3] );
+            }
+            else
+            {
+                bDimsMatch = ( height == output.dims[1] ) && ( width == output.dims[2] ) &&
+                             ( 3 == output.dims[3] );
+            }
+        }
+
+        size_t imageSize = (size_t) width * height * 3 * elementSize;
+        if ( ( false == bDimsMatch ) || ( m_inputId >= output.dims[0] ) )
+        {
+            QC_ERROR( "Output tensor dims not match for inputId=%u!", m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( ( 0 != ( output.offset % elementSize ) ) ||
+                  ( output.size < ( imageSize * output.dims[0] ) ) )
+        {
+            QC_ERROR( "Output tensor offset or size invalid for inputId=%u!", m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( bQuantized && ( 0.0f == output.quantScale ) )
+        {
+            QC_ERROR( "Output tensor quantScale is zero for inputId=%u!", m_inputId );
+            ret = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            param.dstOffset = (cl_int) ( output.offset + imageSize * m_inputId );
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        if ( CL2DFLEX_TENSOR_LAYOUT_NCHW == m_config.tensorLayout )
+        {
+            param.rowStride = (cl_int) width;
+            param.pixelStride = 1;
+            param.channelStride = (cl_int) ( width * height );
+        }
+        else
+        {
+            param.rowStride = (cl_int) ( width * 3 );
+            param.pixelStride = 3;
+            param.channelStride = 1;
+        }
+
+        /* (pixel - mean) / std, then pixel / scale - offset for the quantized types, as one
+         * multiply add per channel in the output channel order */
+        for ( uint32_t c = 0; c < 3; c++ )
+        {
+            uint32_t channel = ( 0 != param.bgr ) ? ( 2 - c ) : c;
+            float alpha = 1.0f / m_config.normalizeStd[channel];
+            float beta = -m_config.normalizeMean[channel] * alpha;
+            if ( bQuantized )
+            {
+                alpha = alpha / output.quantScale;
+                beta = beta / output.quantScale - (float) output.quantOffset;
+            }
+            param.alpha[c] = alpha;
+            param.beta[c] = beta;
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineNormalize::RegisterInput( ImageDescriptor_t &input, cl_mem &bufferSrc,
+                                                 cl_mem &bufferSrcY, cl_mem &bufferSrcUV )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( CL2DFLEX_PIPELINE_NORMALIZE_NV12UBWC_TO_TENSOR != m_pipeline )
+    {
+        ret = m_pOpenclSrvObj->RegBufferDesc( dynamic_cast<QCBufferDescriptorBase_t &>( input ),
+                                              bufferSrc );
+    }
+    else
+    {
+        cl_image_format inputImageFormat = { 0 };
+        inputImageFormat.image_channel_order = CL_QCOM_COMPRESSED_NV12;
+        inputImageFormat.image_channel_data_type = CL_UNORM_INT8;
+        cl_image_desc inputImageDesc = { 0 };
+        inputImageDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        inputImageDesc.image_width = (size_t) input.width;
+        inputImageDesc.image_height = (size_t) input.height;
+        ret = m_pOpenclSrvObj->RegImage( input.pBuf, input.dmaHandle, &bufferSrc,
+                                         &inputImageFormat, &inputImageDesc );
+        if ( QC_STATUS_OK == ret )
+        {
+            cl_image_format inputYFormat = { 0 };
+            inputYFormat.image_channel_order = CL_QCOM_COMPRESSED_NV12_Y;
+            inputYFormat.image_channel_data_type = CL_UNORM_INT8;
+            cl_image_desc inputYDesc = { 0 };
+            inputYDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+            inputYDesc.image_width = (size_t) input.width;
+            inputYDesc.image_height = (size_t) input.height;
+            inputYDesc.mem_object = bufferSrc;
+            ret = m_pOpenclSrvObj->RegPlane( input.pBuf, &bufferSrcY, &inputYFormat, &inputYDesc );
+        }
+        if ( QC_STATUS_OK == ret )
+        {
+            cl_image_format inputUVFormat = { 0 };
+            inputUVFormat.image_channel_order = CL_QCOM_COMPRESSED_NV12_UV;
+            inputUVFormat.image_channel_data_type = CL_UNORM_INT8;
+            cl_image_desc inputUVDesc = { 0 };
+            inputUVDesc.image_type = CL_MEM_OBJECT_IMAGE2D;
+            inputUVDesc.image_width = (size_t) input.width;
+            inputUVDesc.image_height = (size_t) input.height;
+            inputUVDesc.mem_object = bufferSrc;
+            ret = m_pOpenclSrvObj->RegPlane( input.pBuf, &bufferSrcUV, &inputUVFormat,
+                                             &inputUVDesc );
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e CL2DPipelineNormalize::ExecuteTensor( ImageDescriptor_t &input,
+                                                 TensorDescriptor_t &output )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    cl_mem bufferDst;
+    cl_mem bufferSrc;
+    cl_mem bufferSrcY;
+    cl_mem bufferSrcUV;
+    CL2DNormalizeParam_t param = m_param;
+
+    ret = SetupOutput( output, param );
+    if ( QC_STATUS_OK == ret )
+    {
+        ret = m_pOpenclSrvObj->RegBufferDesc( dynamic_cast<QCBufferDescriptorBase_t &>( output ),
+                                              bufferDst );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to register output buffer!" );
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        ret = RegisterInput( input, bufferSrc, bufferSrcY, bufferSrcUV );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to register input buffer!" );
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        size_t numOfArgs = 0;
+        OpenclIfcae_Arg_t OpenclArgs[7];
+        uint32_t srcOffset = (uint32_t) input.offset;
+        if ( CL2DFLEX_PIPELINE_NORMALIZE_NV12_TO_TENSOR == m_pipeline )
+        {
+            OpenclArgs[0].pArg = (void *) &bufferSrc;
+            OpenclArgs[0].argSize = sizeof( cl_mem );
+            OpenclArgs[1].pArg = (void *) &srcOffset;
+            OpenclArgs[1].argSize = sizeof( cl_int );
+            OpenclArgs[2].pArg = (void *) &( input.stride[0] );
+            OpenclArgs[2].argSize = sizeof( cl_int );
+            OpenclArgs[3].pArg = (void *) &( input.planeBufSize[0] );
+            OpenclArgs[3].argSize = sizeof( cl_int );
+            OpenclArgs[4].pArg = (void *) &( input.stride[1] );
+            OpenclArgs[4].argSize = sizeof( cl_int );
+            numOfArgs = 5;
+        }
+        else if ( CL2DFLEX_PIPELINE_NORMALIZE_UYVY_TO_TENSOR == m_pipeline )
+        {
+            OpenclArgs[0].pArg = (void *) &bufferSrc;
+            OpenclArgs[0].argSize = sizeof( cl_mem );
+            OpenclArgs[1].pArg = (void *) &srcOffset;
+            OpenclArgs[1].argSize = sizeof( cl_int );
+            OpenclArgs[2].pArg = (void *) &( input.stride[0] );
+            OpenclArgs[2].argSize = sizeof( cl_int );
+            numOfArgs = 3;
+        }
+        else
+        {
+            OpenclArgs[0].pArg = (void *) &bufferSrcY;
+            OpenclArgs[0].argSize = sizeof( bufferSrcY );
+            OpenclArgs[1].pArg = (void *) &bufferSrcUV;
+            OpenclArgs[1].argSize = sizeof( bufferSrcUV );
+            OpenclArgs[2].pArg = (void *) &( m_pOpenclSrvObj->m_sampler );
+            OpenclArgs[2].argSize = sizeof( m_pOpenclSrvObj->m_sampler );
+            numOfArgs = 3;
+        }
+        OpenclArgs[numOfArgs].pArg = (void *) &bufferDst;
+        OpenclArgs[numOfArgs].argSize = sizeof( cl_mem );
+        numOfArgs++;
+        OpenclArgs[numOfArgs].pArg = (void *) &param;
+        OpenclArgs[numOfArgs].argSize = sizeof( param );
+        numOfArgs++;
+
+        OpenclIface_WorkParams_t OpenclWorkParams;
+        OpenclWorkParams.workDim = 2;
+        size_t globalWorkSize[2] = { (size_t) m_config.outputWidth,
+                                     (size_t) m_config.outputHeight };
+        OpenclWorkParams.pGlobalWorkSize = globalWorkSize;
+        size_t globalWorkOffset[2] = { 0, 0 };
+        OpenclWorkParams.pGlobalWorkOffset = globalWorkOffset;
+        /*set local work size to NULL, device would choose optimal size automatically*/
+        OpenclWorkParams.pLocalWorkSize = NULL;
+
+        ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to execute normalize OpenCL kernel for inputId=%u!", m_inputId );
+            ret = QC_STATUS_FAIL;
+        }
+    }
+
+    return ret;
+}
+
+}   // namespace Node
+}   // namespace QC
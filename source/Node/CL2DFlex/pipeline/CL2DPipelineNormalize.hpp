@@ -0,0 +1,53 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_PIPELINE_NORMALIZE_HPP
+#define QC_CL2D_PIPELINE_NORMALIZE_HPP
+
+#include "pipeline/CL2DNormalizeParams.hpp"
+#include "pipeline/CL2DPipelineBase.hpp"
+
+namespace QC
+{
+namespace Node
+{
+
+/* color convert, resize or letterbox, normalize and quantize one input into its image of the output
+ * tensor with one kernel dispatch */
+class CL2DPipelineNormalize : public CL2DPipelineBase
+{
+public:
+    CL2DPipelineNormalize();
+
+    ~CL2DPipelineNormalize();
+
+    QCStatus_e Init( uint32_t inputId, cl_kernel *pKernel, CL2DFlex_Config_t *pConfig,
+                     OpenclSrv *pOpenclSrvObj,
+                     std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers );
+
+    QCStatus_e Deinit();
+
+    /* not supported, the output of the normalize work modes is a tensor */
+    QCStatus_e Execute( ImageDescriptor_t &input, ImageDescriptor_t &output );
+
+    QCStatus_e ExecuteTensor( ImageDescriptor_t &input, TensorDescriptor_t &output );
+
+    /* check if the work mode of an input is one of the normalize work modes */
+    static bool IsNormalize( const CL2DFlex_Config_t &config, uint32_t inputId );
+
+private:
+    QCStatus_e SetupOutput( TensorDescriptor_t &output, CL2DNormalizeParam_t &param );
+
+    QCStatus_e RegisterInput( ImageDescriptor_t &input, cl_mem &bufferSrc, cl_mem &bufferSrcY,
+                              cl_mem &bufferSrcUV );
+
+private:
+    CL2DNormalizeParam_t m_param;
+
+};   // class CL2DPipelineNormalize
+
+}   // namespace Node
+}   // namespace QC
+
+#endif   // QC_CL2D_PIPELINE_NORMALIZE_HPP
@@ -174,7 +174,7 @@ QCStatus_e CL2DPipelineRemap::RemapFromNV12ToRGB( cl_mem bufferSrc, uint32_t src
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute remap NV12 to RGB OpenCL kernel!" );
@@ -235,7 +235,7 @@ QCStatus_e CL2DPipelineRemap::RemapFromNV12ToBGR( cl_mem bufferSrc, uint32_t src
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute remap NV12 to BGR OpenCL kernel!" );
@@ -192,7 +192,7 @@ QCStatus_e CL2DPipelineResize::ResizeFromNV12ToRGB( cl_mem bufferSrc, uint32_t s
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute resize NV12 to RGB OpenCL kernel!" );
@@ -249,7 +249,7 @@ QCStatus_e CL2DPipelineResize::ResizeFromUYVYToRGB( cl_mem bufferSrc, uint32_t s
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute resize UYVY to RGB OpenCL kernel!" );
@@ -310,7 +310,7 @@ QCStatus_e CL2DPipelineResize::ResizeFromUYVYToNV12( cl_mem bufferSrc, uint32_t
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute resize UYVY to NV12 OpenCL kernel!" );
@@ -367,7 +367,7 @@ QCStatus_e CL2DPipelineResize::ResizeFromRGBToRGB( cl_mem bufferSrc, uint32_t sr
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute resize RGB to RGB OpenCL kernel!" );
@@ -432,7 +432,7 @@ QCStatus_e CL2DPipelineResize::ResizeFromNV12ToNV12( cl_mem bufferSrc, uint32_t
     /*set local work size to NULL, device would choose optimal size automatically*/
     OpenclWorkParams.pLocalWorkSize = NULL;
 
-    ret = m_pOpenclSrvObj->Execute( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
+    ret = m_pOpenclSrvObj->ExecuteAsync( m_pKernel, OpenclArgs, numOfArgs, &OpenclWorkParams );
     if ( QC_STATUS_OK != ret )
     {
         QC_ERROR( "Failed to execute resize NV12 to NV12 OpenCL kernel!" );
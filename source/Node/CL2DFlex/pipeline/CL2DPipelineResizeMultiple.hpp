@@ -6,6 +6,7 @@
 #define QC_CL2D_PIPELINE_RESIZEMULTIPLE_HPP
 
 #include "pipeline/CL2DPipelineBase.hpp"
+#include "pipeline/CL2DROIParams.hpp"
 
 namespace QC
 {
@@ -32,8 +33,16 @@ private:
                                             uint32_t dstOffset, ImageDescriptor_t &input,
                                             ImageDescriptor_t &output );
 
+    /* the ROIs of the frame, up to CL2DFLEX_ROI_PARAMS_MAX ROIs per kernel dispatch */
+    QCStatus_e ResizeFromNV12ToRGBMultipleROIs( cl_mem bufferSrc, uint32_t srcOffset,
+                                                cl_mem bufferDst, uint32_t dstOffset,
+                                                const CL2DFlex_ROIConfig_t *pROIs,
+                                                uint32_t numOfROIs, ImageDescriptor_t &input,
+                                                ImageDescriptor_t &output );
+
 private:
-    cl_mem m_bufferROIs;
+    cl_mem m_bufferROIs = nullptr;
+    cl_kernel m_kernelROIs = nullptr;
 
 };   // class PipelineResizeMultiple
 
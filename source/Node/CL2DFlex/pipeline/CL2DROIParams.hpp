@@ -0,0 +1,22 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_CL2D_ROI_PARAMS_HPP
+#define QC_CL2D_ROI_PARAMS_HPP
+
+#include <CL/cl.h>
+
+/** @brief The max number of the ROIs of a frame processed by one kernel dispatch of the multiple
+ * work modes, it must match the size of CL2DROIParams_t of kernel/CL2DConstant.cl.h */
+#define CL2DFLEX_ROI_PARAMS_MAX 32u
+
+/** @brief The [x, y, width, height] of the ROIs of a frame, passed by value as one kernel argument,
+ * so the ROIs are copied at enqueue time and the next frame may carry other ROIs, it must match
+ * the CL2DROIParams_t of kernel/CL2DConstant.cl.h */
+typedef struct
+{
+    cl_int ROIs[CL2DFLEX_ROI_PARAMS_MAX * 4];
+} CL2DROIParams_t;
+
+#endif   // QC_CL2D_ROI_PARAMS_HPP
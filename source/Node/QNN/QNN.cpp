@@ -95,6 +95,18 @@ QCStatus_e Qnn::Stop()
     return m_pQnnImpl->Stop();
 }
 
+QCStatus_e
+Qnn::RegisterBuffers( std::vector<std::reference_wrapper<QCBufferDescriptorBase_t>> &buffers,
+                      bool bAsync )
+{
+    return m_pQnnImpl->RegisterBuffers( buffers, bAsync );
+}
+
+QCStatus_e Qnn::WaitBuffersRegistered( uint32_t timeoutMs )
+{
+    return m_pQnnImpl->WaitBuffersRegistered( timeoutMs );
+}
+
 QCStatus_e Qnn::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc )
 {
     return m_pQnnImpl->ProcessFrameDescriptor( frameDesc );
@@ -11,6 +11,18 @@ namespace QC
 namespace Node
 {
 
+static const std::vector<std::pair<std::string, Qnn_PerfProfile_e>> sg_perfProfileOptions = {
+        { "low_balanced", QNN_PERF_PROFILE_LOW_BALANCED },
+        { "balanced", QNN_PERF_PROFILE_BALANCED },
+        { "default", QNN_PERF_PROFILE_DEFAULT },
+        { "high_performance", QNN_PERF_PROFILE_HIGH_PERFORMANCE },
+        { "sustained_high_performance", QNN_PERF_PROFILE_SUSTAINED_HIGH_PERFORMANCE },
+        { "burst", QNN_PERF_PROFILE_BURST },
+        { "low_power_saver", QNN_PERF_PROFILE_LOW_POWER_SAVER },
+        { "power_saver", QNN_PERF_PROFILE_POWER_SAVER },
+        { "high_power_saver", QNN_PERF_PROFILE_HIGH_POWER_SAVER },
+        { "extreme_power_saver", QNN_PERF_PROFILE_EXTREME_POWER_SAVER } };
+
 DataTree QnnConfig::ConvertTensorInfoToJson( const Qnn_Tensor_t &info )
 {
     DataTree dt;
@@ -54,315 +66,261 @@ QnnConfig::ConvertTensorInfoListToJson( const std::vector<Qnn_Tensor_t> &infoLis
     return dts;
 }
 
-QCStatus_e QnnConfig::VerifyStaticConfig( DataTree &dt, std::string &errors )
+/* built once and shared by all the QNN nodes, the keys are split into paths only here */
+static const DataTree::Schema<QnnImplConfig_t> &GetStaticConfigSchema()
 {
-    QCStatus_e status = QC_STATUS_OK;
-    QCStatus_e status2;
-
-    std::string type = dt.Get<std::string>( "type", "QNN" );
-    if ( "QNN" != type )
-    {
-        errors += "the type is not QNN, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
-
-    uint32_t id = dt.Get<uint32_t>( "id", UINT32_MAX );
-    if ( UINT32_MAX == id )
-    {
-        errors += "the id is empty, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
-
-    std::string processorType = dt.Get<std::string>( "processorType", "htp0" );
-    if ( ( "htp0" != processorType ) && ( "htp1" != processorType ) &&
-         ( "htp2" != processorType ) && ( "htp3" != processorType ) && ( "cpu" != processorType ) &&
-         ( "gpu" != processorType ) )
-    {
-        errors += "the processorType " + processorType + " is invalid, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
-
-    std::string perfProfile = dt.Get<std::string>( "perfProfile", "default" );
-    if ( ( "low_balanced" != perfProfile ) && ( "balanced" != perfProfile ) &&
-         ( "default" != perfProfile ) && ( "high_performance" != perfProfile ) &&
-         ( "sustained_high_performance" != perfProfile ) && ( "burst" != perfProfile ) &&
-         ( "low_power_saver" != perfProfile ) && ( "power_saver" != perfProfile ) &&
-         ( "high_power_saver" != perfProfile ) && ( "extreme_power_saver" != perfProfile ) )
-    {
-        errors += "the perfProfile " + perfProfile + " is invalid, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
-
-    std::string loadType = dt.Get<std::string>( "loadType", "binary" );
-    if ( ( "binary" == loadType ) || ( "library" == loadType ) )
-    {
-        std::string modelPath = dt.Get<std::string>( "modelPath", "" );
-        if ( "" == modelPath )
-        {
-            errors += "the modelPath is empty, ";
-            status = QC_STATUS_BAD_ARGUMENTS;
-        }
-        else
-        {
-            int err = access( modelPath.c_str(), F_OK );
-            if ( 0 != err )
-            {
-                errors += "the modelPath <" + modelPath + "> is invalid, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-        }
-    }
-    else if ( "buffer" == loadType )
-    {
-        uint32_t contextBufferId = dt.Get<uint32_t>( "contextBufferId", UINT32_MAX );
-        if ( UINT32_MAX == contextBufferId )
-        {
-            errors += "the contextBufferId is empty, ";
-            status = QC_STATUS_BAD_ARGUMENTS;
-        }
-    }
-    else
-    {
-        errors += "the loadType <" + loadType + "> is invalid, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
-
-    if ( dt.Exists( "bufferIds" ) )
-    {
-        std::vector<uint32_t> bufferIds = dt.Get<uint32_t>( "bufferIds", std::vector<uint32_t>{} );
-        if ( 0 == bufferIds.size() )
-        {
-            errors += "the bufferIds is invalid, ";
-            status = QC_STATUS_BAD_ARGUMENTS;
-        }
-    }
-
-    std::string priority = dt.Get<std::string>( "priority", "normal" );
-    if ( ( "low" != priority ) && ( "normal" != priority ) && ( "normal_high" != priority ) &&
-         ( "high" != priority ) )
-    {
-        errors += "the priority is invalid, ";
-        status = QC_STATUS_BAD_ARGUMENTS;
-    }
+    static const DataTree::Schema<QnnImplConfig_t> s_schema =
+            DataTree::Schema<QnnImplConfig_t>()
+                    .AddField<std::string>( "type",
+                                            []( const std::string *pType, QnnImplConfig_t &config,
+                                                std::string &error ) {
+                                                config.nodeId.type = QC_NODE_TYPE_QNN;
+                                                error = "is not QNN";
+                                                return ( nullptr == pType ) || ( "QNN" == *pType );
+                                            } )
+                    .AddField<std::string>( "name",
+                                            []( const std::string *pName,
+                                                QnnImplConfig_t &config ) {
+                                                config.nodeId.name =
+                                                        ( nullptr != pName ) ? *pName : "";
+                                                return true;
+                                            } )
+                    .AddField<uint32_t>( "id",
+                                         []( const uint32_t *pId, QnnImplConfig_t &config,
+                                             std::string &error ) {
+                                             config.nodeId.id =
+                                                     ( nullptr != pId ) ? *pId : UINT32_MAX;
+                                             error = "is empty";
+                                             return UINT32_MAX != config.nodeId.id;
+                                         } )
+                    .AddEnum<Qnn_ProcessorType_e>( "processorType", &QnnImplConfig_t::processorType,
+                                                   { { "htp0", QNN_PROCESSOR_HTP0 },
+                                                     { "htp1", QNN_PROCESSOR_HTP1 },
+                                                     { "htp2", QNN_PROCESSOR_HTP2 },
+                                                     { "htp3", QNN_PROCESSOR_HTP3 },
+                                                     { "cpu", QNN_PROCESSOR_CPU },
+                                                     { "gpu", QNN_PROCESSOR_GPU } },
+                                                   QNN_PROCESSOR_HTP0 )
+                    .AddEnum<Qnn_PerfProfile_e>( "perfProfile", &QnnImplConfig_t::perfProfile,
+                                                 sg_perfProfileOptions, QNN_PERF_PROFILE_DEFAULT )
+                    .Add<uint32_t>( "targetLatency", &QnnImplConfig_t::targetLatency, 0 )
+                    .AddEnum<Qnn_PerfProfile_e>( "minPerfProfile",
+                                                 &QnnImplConfig_t::minPerfProfile,
+                                                 sg_perfProfileOptions,
+                                                 QNN_PERF_PROFILE_POWER_SAVER )
+                    .AddEnum<Qnn_PerfProfile_e>( "maxPerfProfile",
+                                                 &QnnImplConfig_t::maxPerfProfile,
+                                                 sg_perfProfileOptions, QNN_PERF_PROFILE_BURST )
+                    .Add<uint32_t>( "governorWindow", &QnnImplConfig_t::governorWindow, 16 )
+                    .Add<uint32_t>( "warmupFrames", &QnnImplConfig_t::warmupFrames, 0 )
+                    .Add<std::vector<uint32_t>>( "coreIds", &QnnImplConfig_t::coreIds, { 0 } )
+                    .AddField<std::string>(
+                            "loadType",
+                            []( const std::string *pLoadType, QnnImplConfig_t &config,
+                                std::string &error ) {
+                                bool bValid = true;
+                                std::string loadType =
+                                        ( nullptr != pLoadType ) ? *pLoadType : "binary";
+                                if ( "binary" == loadType )
+                                {
+                                    config.loadType = QNN_LOAD_CONTEXT_BIN_FROM_FILE;
+                                }
+                                else if ( "library" == loadType )
+                                {
+                                    config.loadType = QNN_LOAD_SHARED_LIBRARY_FROM_FILE;
+                                }
+                                else if ( "buffer" == loadType )
+                                {
+                                    config.loadType = QNN_LOAD_CONTEXT_BIN_FROM_BUFFER;
+                                }
+                                else
+                                {
+                                    error = "<" + loadType + "> is invalid";
+                                    bValid = false;
+                                }
+                                return bValid;
+                            } )
+                    .Add<std::string>( "modelPath", &QnnImplConfig_t::modelPath, "" )
+                    .Add<uint32_t>( "contextBufferId", &QnnImplConfig_t::contextBufferId,
+                                    UINT32_MAX )
+                    .AddEnum<Qnn_Priority_t>( "priority", &QnnImplConfig_t::priority,
+                                              { { "low", QNN_PRIORITY_LOW },
+                                                { "normal", QNN_PRIORITY_NORMAL },
+                                                { "normal_high", QNN_PRIORITY_NORMAL_HIGH },
+                                                { "high", QNN_PRIORITY_HIGH } },
+                                              QNN_PRIORITY_NORMAL )
+                    .AddField<std::vector<uint32_t>>(
+                            "bufferIds",
+                            []( const std::vector<uint32_t> *pIds, QnnImplConfig_t &config ) {
+                                config.bufferIds = ( nullptr != pIds ) ? *pIds
+                                                                       : std::vector<uint32_t>{};
+                                return ( nullptr == pIds ) || ( false == pIds->empty() );
+                            } )
+                    .Add<bool>( "registerBuffersAtStart",
+                                &QnnImplConfig_t::bRegisterBuffersAtStart, false )
+                    .Add<bool>( "deRegisterAllBuffersWhenStop",
+                                &QnnImplConfig_t::bDeRegisterAllBuffersWhenStop, false )
+                    .Add<bool>( "reRegisterBuffersWhenStart",
+                                &QnnImplConfig_t::bReRegisterBuffersWhenStart, false )
+                    .Add<bool>( "weightSharingEnabled", &QnnImplConfig_t::bWeightSharingEnabled,
+                                false )
+                    .Add<bool>( "extendedUdma", &QnnImplConfig_t::bUseExtendedUdma, false )
+                    .Add<std::vector<std::string>>( "graphs", &QnnImplConfig_t::graphs, {} )
+                    .Add<bool>( "parallelGraphs", &QnnImplConfig_t::bParallelGraphs, false )
+                    .Add<bool>( "strictValidation", &QnnImplConfig_t::bStrictValidation, false )
+                    .Add<uint32_t>( "inFlightDepth", &QnnImplConfig_t::inFlightDepth,
+                                    QNN_NOTIFY_PARAM_NUM )
+                    .AddList<Qnn_UdoPackage_t>(
+                            "udoPackages", &QnnImplConfig_t::udoPackages,
+                            DataTree::Schema<Qnn_UdoPackage_t>()
+                                    .Add<std::string>( "udoLibPath",
+                                                       &Qnn_UdoPackage_t::udoLibPath, "" )
+                                    .Add<std::string>( "interfaceProvider",
+                                                       &Qnn_UdoPackage_t::interfaceProvider, "" )
+                                    .Check( "library path is empty",
+                                            []( const Qnn_UdoPackage_t &udo ) {
+                                                return false == udo.udoLibPath.empty();
+                                            } )
+                                    .Check( "interface is empty",
+                                            []( const Qnn_UdoPackage_t &udo ) {
+                                                return false == udo.interfaceProvider.empty();
+                                            } ),
+                            "udo" )
+                    .AddList<QCNodeBufferMapEntry_t>(
+                            "globalBufferIdMap", &QnnImplConfig_t::globalBufferIdMap,
+                            DataTree::Schema<QCNodeBufferMapEntry_t>()
+                                    .Add<std::string>( "name", &QCNodeBufferMapEntry_t::name, "" )
+                                    .Add<uint32_t>( "id", &QCNodeBufferMapEntry_t::globalBufferId,
+                                                    UINT32_MAX )
+                                    .Check( "name is empty",
+                                            []( const QCNodeBufferMapEntry_t &entry ) {
+                                                return false == entry.name.empty();
+                                            } )
+                                    .Check( "id is empty",
+                                            []( const QCNodeBufferMapEntry_t &entry ) {
+                                                return UINT32_MAX != entry.globalBufferId;
+                                            } ),
+                            "globalIdMap" )
+                    .AddList<Qnn_BatchSlices_t>(
+                            "batchSlices", &QnnImplConfig_t::batchSlices,
+                            DataTree::Schema<Qnn_BatchSlices_t>()
+                                    .Add<std::string>( "name", &Qnn_BatchSlices_t::name, "" )
+                                    .Add<std::vector<uint32_t>>(
+                                            "ids", &Qnn_BatchSlices_t::globalBufferIds, {} )
+                                    .Check( "name is empty",
+                                            []( const Qnn_BatchSlices_t &slices ) {
+                                                return false == slices.name.empty();
+                                            } )
+                                    .Check( "ids is empty",
+                                            []( const Qnn_BatchSlices_t &slices ) {
+                                                return false == slices.globalBufferIds.empty();
+                                            } ),
+                            "batchSlices" )
+                    .Check( []( const QnnImplConfig_t &config, std::string &error ) {
+                        bool bValid = true;
+                        if ( QNN_LOAD_CONTEXT_BIN_FROM_BUFFER == config.loadType )
+                        {
+                            /* OK, loaded from the context buffer */
+                        }
+                        else if ( config.modelPath.empty() )
+                        {
+                            error = "modelPath is empty";
+                            bValid = false;
+                        }
+                        else if ( 0 != access( config.modelPath.c_str(), F_OK ) )
+                        {
+                            error = "modelPath <" + config.modelPath + "> is invalid";
+                            bValid = false;
+                        }
+                        else
+                        {
+                            /* OK */
+                        }
+                        return bValid;
+                    } )
+                    .Check( "contextBufferId is empty",
+                            []( const QnnImplConfig_t &config ) {
+                                return ( QNN_LOAD_CONTEXT_BIN_FROM_BUFFER != config.loadType ) ||
+                                       ( UINT32_MAX != config.contextBufferId );
+                            } )
+                    .Check( "reRegisterBuffersWhenStart requires the deRegisterAllBuffersWhenStop",
+                            []( const QnnImplConfig_t &config ) {
+                                return ( false == config.bReRegisterBuffersWhenStart ) ||
+                                       ( true == config.bDeRegisterAllBuffersWhenStop );
+                            } )
+                    .Check( "minPerfProfile is invalid",
+                            []( const QnnImplConfig_t &config ) {
+                                return 0 <= QnnImpl::GetPerfLevel( config.minPerfProfile );
+                            } )
+                    .Check( "maxPerfProfile is invalid",
+                            []( const QnnImplConfig_t &config ) {
+                                return 0 <= QnnImpl::GetPerfLevel( config.maxPerfProfile );
+                            } )
+                    .Check( "minPerfProfile is higher than the maxPerfProfile",
+                            []( const QnnImplConfig_t &config ) {
+                                int32_t minLevel = QnnImpl::GetPerfLevel( config.minPerfProfile );
+                                int32_t maxLevel = QnnImpl::GetPerfLevel( config.maxPerfProfile );
+                                return ( 0 > minLevel ) || ( 0 > maxLevel ) ||
+                                       ( minLevel <= maxLevel );
+                            } )
+                    .Check( "governorWindow is invalid",
+                            []( const QnnImplConfig_t &config ) {
+                                return ( 0 < config.governorWindow ) &&
+                                       ( config.governorWindow <= QNN_GOVERNOR_WINDOW_MAX );
+                            } )
+                    .Check( "warmupFrames is invalid",
+                            []( const QnnImplConfig_t &config ) {
+                                return config.warmupFrames <= QNN_WARMUP_FRAMES_MAX;
+                            } )
+                    .Check( "inFlightDepth is invalid", []( const QnnImplConfig_t &config ) {
+                        return ( 0 < config.inFlightDepth ) &&
+                               ( config.inFlightDepth <= QNN_NOTIFY_PARAM_NUM );
+                    } );
+
+    return s_schema;
+}
 
-    std::vector<DataTree> udos;
-    status2 = dt.Get( "udoPackages", udos );
-    if ( QC_STATUS_OUT_OF_BOUND == status2 )
-    {
-        /* OK if not configured */
-    }
-    else if ( QC_STATUS_OK != status2 )
-    {
-        errors += "the udoPackages is invalid, ";
-        status = status2;
-    }
-    else
-    {
-        uint32_t idx = 0;
-        for ( DataTree &udo : udos )
-        {
-            std::string udoLibPath = udo.Get<std::string>( "udoLibPath", "" );
-            std::string interfaceProvider = udo.Get<std::string>( "interfaceProvider", "" );
-            if ( "" == udoLibPath )
-            {
-                errors += "the udo " + std::to_string( idx ) + " library path is empty, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-            if ( "" == interfaceProvider )
-            {
-                errors += "the udo " + std::to_string( idx ) + " interface is empty, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-            idx++;
-        }
-    }
+/* the name of a perf profile, for the logs */
+static const char *GetPerfProfileName( Qnn_PerfProfile_e perfProfile )
+{
+    const char *pName = "unknown";
 
-    std::vector<DataTree> globalBufferIdMap;
-    status2 = dt.Get( "globalBufferIdMap", globalBufferIdMap );
-    if ( QC_STATUS_OUT_OF_BOUND == status2 )
-    {
-        /* OK if not configured */
-    }
-    else if ( QC_STATUS_OK != status2 )
+    for ( auto &option : sg_perfProfileOptions )
     {
-        errors += "the globalBufferIdMap is invalid, ";
-        status = status2;
-    }
-    else
-    {
-        uint32_t idx = 0;
-        for ( DataTree &gbm : globalBufferIdMap )
+        if ( option.second == perfProfile )
         {
-            std::string name = gbm.Get<std::string>( "name", "" );
-            uint32_t index = gbm.Get<uint32_t>( "id", UINT32_MAX );
-            if ( "" == name )
-            {
-                errors += "the globalIdMap " + std::to_string( idx ) + " name is empty, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-
-            if ( UINT32_MAX == index )
-            {
-                errors += "the globalIdMap " + std::to_string( idx ) + " id is empty, ";
-                status = QC_STATUS_BAD_ARGUMENTS;
-            }
-            idx++;
+            pName = option.first.c_str();
+            break;
         }
     }
 
-    return status;
+    return pName;
 }
 
-
 QCStatus_e QnnConfig::ParseStaticConfig( DataTree &dt, std::string &errors )
 {
     QCStatus_e status = QC_STATUS_OK;
 
-    QnnImplConfig_t &config = m_pQnnImpl->GetConfig();
+    /* bound into a copy, so an invalid config leaves the node config unchanged */
+    QnnImplConfig_t config = m_pQnnImpl->GetConfig();
 
-    status = VerifyStaticConfig( dt, errors );
+    status = GetStaticConfigSchema().Bind( dt, config, errors );
     if ( QC_STATUS_OK == status )
     {
-        config.nodeId.name = dt.Get<std::string>( "name", "" );
-        config.nodeId.id = dt.Get<uint32_t>( "id", UINT32_MAX );
-        config.nodeId.type = QC_NODE_TYPE_QNN;
-        std::string processorType = dt.Get<std::string>( "processorType", "htp0" );
-        if ( "htp0" == processorType )
-        {
-            config.processorType = QNN_PROCESSOR_HTP0;
-        }
-        else if ( "htp1" == processorType )
-        {
-            config.processorType = QNN_PROCESSOR_HTP1;
-        }
-        else if ( "htp2" == processorType )
+        /* the model tensors depend on the configured graphs */
+        m_bOptionsBuilt = false;
+        QC_DEBUG( "QNN perf profile: %s", GetPerfProfileName( config.perfProfile ) );
+        if ( QNN_LOAD_CONTEXT_BIN_FROM_BUFFER == config.loadType )
         {
-            config.processorType = QNN_PROCESSOR_HTP2;
-        }
-        else if ( "htp3" == processorType )
-        {
-            config.processorType = QNN_PROCESSOR_HTP3;
-        }
-        else if ( "cpu" == processorType )
-        {
-            config.processorType = QNN_PROCESSOR_CPU;
-        }
-        else
-        {
-            config.processorType = QNN_PROCESSOR_GPU;
-        }
-
-        std::string perfProfile = dt.Get<std::string>( "perfProfile", "default" );
-        QC_DEBUG( "QNN perf profile: %s", perfProfile.c_str() );
-        if ( "low_balanced" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_LOW_BALANCED;
-        }
-        else if ( "balanced" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_BALANCED;
-        }
-        else if ( "high_performance" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_HIGH_PERFORMANCE;
-        }
-        else if ( "sustained_high_performance" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_SUSTAINED_HIGH_PERFORMANCE;
-        }
-        else if ( "burst" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_BURST;
-        }
-        else if ( "low_power_saver" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_LOW_POWER_SAVER;
-        }
-        else if ( "power_saver" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_POWER_SAVER;
-        }
-        else if ( "high_power_saver" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_HIGH_POWER_SAVER;
-        }
-        else if ( "extreme_power_saver" == perfProfile )
-        {
-            config.perfProfile = QNN_PERF_PROFILE_EXTREME_POWER_SAVER;
-        }
-        else
-        {
-            config.perfProfile = QNN_PERF_PROFILE_DEFAULT;
-        }
-
-        config.coreIds = dt.Get<std::vector<uint32_t>>( "coreIds", std::vector<uint32_t>( { 0 } ) );
-        std::string loadType = dt.Get<std::string>( "loadType", "binary" );
-        if ( "binary" == loadType )
-        {
-            config.modelPath = dt.Get<std::string>( "modelPath", "" );
-            config.loadType = QNN_LOAD_CONTEXT_BIN_FROM_FILE;
-            QC_DEBUG( "QNN binary model: %s", config.modelPath.c_str() );
-        }
-        else if ( "library" == loadType )
-        {
-            config.modelPath = dt.Get<std::string>( "modelPath", "" );
-            config.loadType = QNN_LOAD_SHARED_LIBRARY_FROM_FILE;
-            QC_DEBUG( "QNN library model: %s", config.modelPath.c_str() );
-        }
-        else /* buffer */
-        {
-            config.contextBufferId = dt.Get<uint32_t>( "contextBufferId", UINT32_MAX );
             config.modelPath = "";
-            config.loadType = QNN_LOAD_CONTEXT_BIN_FROM_BUFFER;
-        }
-
-        std::string priority = dt.Get<std::string>( "priority", "normal" );
-        if ( "low" == priority )
-        {
-            config.priority = QNN_PRIORITY_LOW;
-        }
-        else if ( "normal" == priority )
-        {
-            config.priority = QNN_PRIORITY_NORMAL;
-        }
-        else if ( "normal_high" == priority )
-        {
-            config.priority = QNN_PRIORITY_NORMAL_HIGH;
         }
         else
         {
-            config.priority = QNN_PRIORITY_HIGH;
-        }
-
-        config.bufferIds = dt.Get<uint32_t>( "bufferIds", std::vector<uint32_t>{} );
-
-        std::vector<DataTree> dts;
-        (void) dt.Get( "udoPackages", dts );
-        config.udoPackages.resize( dts.size() );
-        uint32_t idx = 0;
-        for ( DataTree &udt : dts )
-        {
-            config.udoPackages[idx].udoLibPath = udt.Get<std::string>( "udoLibPath", "" );
-            config.udoPackages[idx].interfaceProvider =
-                    udt.Get<std::string>( "interfaceProvider", "" );
-            idx++;
+            QC_DEBUG( "QNN %s model: %s",
+                      ( QNN_LOAD_CONTEXT_BIN_FROM_FILE == config.loadType ) ? "binary" : "library",
+                      config.modelPath.c_str() );
         }
-
-        std::vector<DataTree> globalBufferIdMap;
-        (void) dt.Get( "globalBufferIdMap", globalBufferIdMap );
-        config.globalBufferIdMap.resize( globalBufferIdMap.size() );
-        idx = 0;
-        for ( DataTree &gbm : globalBufferIdMap )
-        {
-            config.globalBufferIdMap[idx].name = gbm.Get<std::string>( "name", "" );
-            config.globalBufferIdMap[idx].globalBufferId = gbm.Get<uint32_t>( "id", UINT32_MAX );
-            idx++;
-        }
-
-        config.bDeRegisterAllBuffersWhenStop =
-                dt.Get<bool>( "deRegisterAllBuffersWhenStop", false );
-        config.bWeightSharingEnabled = dt.Get<bool>( "weightSharingEnabled", false );
-        config.bUseExtendedUdma = dt.Get<bool>( "extendedUdma", false );
+        m_pQnnImpl->GetConfig() = config;
     }
 
     return status;
@@ -372,9 +330,31 @@ QCStatus_e QnnConfig::ApplyDynamicConfig( DataTree &dt, std::string &errors )
 {
     QCStatus_e status = QC_STATUS_OK;
 
-    if ( dt.Exists( "enablePerf" ) )
+    static const DataTree::Path s_enablePerfPath( "enablePerf" );
+    static const DataTree::Path s_activeGraphsPath( "activeGraphs" );
+
+    /* each key is applied on its own, so one dynamic config can update both */
+    if ( ( false == dt.Exists( s_activeGraphsPath ) ) &&
+         ( false == dt.Exists( s_enablePerfPath ) ) )
     {
-        bool bEnablePerf = dt.Get<bool>( "enablePerf", false );
+        QC_ERROR( "only support dynamic enablePerf or activeGraphs option" );
+        status = QC_STATUS_UNSUPPORTED;
+    }
+
+    if ( ( QC_STATUS_OK == status ) && ( true == dt.Exists( s_activeGraphsPath ) ) )
+    {
+        std::vector<std::string> activeGraphs =
+                dt.Get<std::string>( s_activeGraphsPath, std::vector<std::string>{} );
+        status = m_pQnnImpl->SetActiveGraphs( activeGraphs );
+        if ( QC_STATUS_OK != status )
+        {
+            errors += "the activeGraphs is invalid, ";
+        }
+    }
+
+    if ( ( QC_STATUS_OK == status ) && ( true == dt.Exists( s_enablePerfPath ) ) )
+    {
+        bool bEnablePerf = dt.Get<bool>( s_enablePerfPath, false );
         if ( bEnablePerf )
         {
             status = m_pQnnImpl->EnablePerf();
@@ -393,11 +373,6 @@ QCStatus_e QnnConfig::ApplyDynamicConfig( DataTree &dt, std::string &errors )
             QC_DEBUG( "%s perf OK", bEnablePerf ? "Enable" : "Disable" );
         }
     }
-    else
-    {
-        QC_ERROR( "only support dynamic enablePerf option" );
-        status = QC_STATUS_UNSUPPORTED;
-    }
 
     return status;
 }
@@ -435,6 +410,7 @@ const std::string &QnnConfig::GetOptions()
 
     std::vector<Qnn_Tensor_t> inputTensors;
     std::vector<Qnn_Tensor_t> outputTensors;
+    std::vector<std::string> graphNames;
     DataTree dt;
 
     if ( false == m_bOptionsBuilt )
@@ -445,12 +421,18 @@ const std::string &QnnConfig::GetOptions()
             status = m_pQnnImpl->GetOutputTensors( outputTensors );
         }
 
+        if ( QC_STATUS_OK == status )
+        {
+            status = m_pQnnImpl->GetGraphNames( graphNames );
+        }
+
         if ( QC_STATUS_OK == status )
         {
             std::vector<DataTree> inputDts = ConvertTensorInfoListToJson( inputTensors );
             std::vector<DataTree> outputDts = ConvertTensorInfoListToJson( outputTensors );
             dt.Set( "model.inputs", inputDts );
             dt.Set( "model.outputs", outputDts );
+            dt.Set<std::string>( "model.graphs", graphNames );
             dt.Set<uint32_t>( "version", QCNODE_QNN_VERSION );
             m_options = dt.Dump();
             m_bOptionsBuilt = true;
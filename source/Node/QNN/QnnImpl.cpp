@@ -7,14 +7,22 @@
 #include "QnnSdkBuildId.h"
 #include "QnnTypeMacros.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <dlfcn.h>
 #include <libgen.h>
 #include <sstream>
+#include <fcntl.h>
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include "QC/Infras/Memory/HeapAllocator.hpp"
+#include "QC/Infras/Memory/UtilsBase.hpp"
 #include "QnnImpl.hpp"
 
+#ifndef QNN_DISABLE_FASTRPC
 extern "C"
 {
 #include "fastrpc_api.h"
@@ -22,6 +30,12 @@ extern "C"
 #include "rpcmem.h"
 #pragma weak remote_session_control
 #include "remote.h"
+#if defined( __QNXNTO__ )
+#include "QC/Infras/Memory/PMEMAllocator.hpp"
+#else
+#include "QC/Infras/Memory/DMABUFFAllocator.hpp"
+#endif
+#endif
 
 namespace QC
 {
@@ -34,6 +48,10 @@ namespace Node
 
 std::mutex QnnImpl::s_lock[QNN_PROCESSOR_MAX];
 std::map<void *, int> QnnImpl::s_dmaMemRefMap[QNN_PROCESSOR_MAX];
+std::mutex QnnImpl::s_mappedBinaryLock;
+std::map<QnnImpl::MappedBinaryKey_t, QnnImpl::MappedBinary_t> QnnImpl::s_mappedBinaryMap;
+std::mutex QnnImpl::s_perfArbiterLock;
+std::map<QnnImpl::PerfCoreKey_t, std::map<QnnImpl *, Qnn_PerfProfile_e>> QnnImpl::s_perfVotes;
 
 std::map<Qnn_ProcessorType_e, std::string> QnnImpl::s_Backends = {
         { QNN_PROCESSOR_HTP0, "libQnnHtp.so" }, { QNN_PROCESSOR_HTP1, "libQnnHtp.so" },
@@ -896,25 +914,29 @@ QCStatus_e QnnImpl::CreateFromModelSo( std::string modelFile )
             QC_ERROR( "Failed in composeGraphs(), error is %d", retME );
             status = QC_STATUS_FAIL;
         }
-    }
-
-    if ( QC_STATUS_OK == status )
-    {
-        if ( m_graphsCount != 1 )
+        else if ( 0 == m_graphsCount )
         {
-            QC_ERROR( "too much graphs" );
+            QC_ERROR( "no graph composed by the model" );
             status = QC_STATUS_UNSUPPORTED;
         }
+        else
+        {
+            /* OK */
+        }
     }
 
-    if ( QC_STATUS_OK == status )
+    for ( uint32_t graphIdx = 0; graphIdx < m_graphsCount; graphIdx++ )
     {
-        retVal = m_qnnFunctionPointers.qnnInterface.graphFinalize(
-                ( *m_graphsInfo )[0].graph, m_profileBackendHandle, nullptr );
-        if ( QNN_GRAPH_NO_ERROR != retVal )
+        if ( QC_STATUS_OK == status )
         {
-            QC_ERROR( "Failed in graphFinalize()" );
-            status = QC_STATUS_FAIL;
+            retVal = m_qnnFunctionPointers.qnnInterface.graphFinalize(
+                    m_graphsInfo[graphIdx]->graph, m_profileBackendHandle, nullptr );
+            if ( QNN_GRAPH_NO_ERROR != retVal )
+            {
+                QC_ERROR( "Failed in graphFinalize() for graph %s",
+                          m_graphsInfo[graphIdx]->graphName );
+                status = QC_STATUS_FAIL;
+            }
         }
     }
 
@@ -996,63 +1018,112 @@ QCStatus_e QnnImpl::CreateFromBinaryBuffer( QCBufferDescriptorBase &bufDesc )
     return status;
 }
 
-QCStatus_e QnnImpl::CreateFromBinaryFile( std::string modelFile )
+QCStatus_e QnnImpl::MapBinaryFile( const std::string &modelFile, void *&pData, size_t &size )
 {
     QCStatus_e status = QC_STATUS_OK;
-    QCBufferDescriptorBase bufDesc;
-    uint32_t bufferSize = 0;
-    FILE *pFile = fopen( modelFile.c_str(), "rb" );
-    if ( nullptr == pFile )
+    struct stat st;
+
+    std::lock_guard<std::mutex> l( s_mappedBinaryLock );
+    int fd = open( modelFile.c_str(), O_RDONLY );
+    if ( fd < 0 )
     {
         QC_ERROR( "No existing file: %s", modelFile.c_str() );
         status = QC_STATUS_FAIL;
     }
     else
     {
-        fseek( pFile, 0, SEEK_END );
-        bufferSize = static_cast<uint32_t>( ftell( pFile ) );
-        fseek( pFile, 0, SEEK_SET );
-        if ( 0 == bufferSize )
+        if ( 0 != fstat( fd, &st ) )
         {
-            QC_ERROR( "Received path to an empty file. Nothing to deserialize." );
+            QC_ERROR( "Failed to stat file: %s", modelFile.c_str() );
             status = QC_STATUS_FAIL;
         }
-    }
-
-    uint8_t *pBuffer = nullptr;
-    if ( QC_STATUS_OK == status )
-    {
-        pBuffer = (uint8_t *) malloc( bufferSize );
-        if ( nullptr == pBuffer )
+        else if ( 0 == st.st_size )
         {
-            QC_ERROR( "Failed to allocate memory." );
+            QC_ERROR( "Received path to an empty file. Nothing to deserialize." );
             status = QC_STATUS_FAIL;
         }
+        else
+        {
+            MappedBinaryKey_t key( st.st_dev, st.st_ino, st.st_size, st.st_mtime );
+            auto it = s_mappedBinaryMap.find( key );
+            if ( it != s_mappedBinaryMap.end() )
+            {
+                it->second.refCount++;
+                pData = it->second.pData;
+                size = it->second.size;
+                QC_DEBUG( "share the mapping of %s, refCount = %u", modelFile.c_str(),
+                          it->second.refCount );
+            }
+            else
+            {
+                void *pMapped =
+                        mmap( nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+                if ( MAP_FAILED == pMapped )
+                {
+                    QC_ERROR( "Failed to map file: %s", modelFile.c_str() );
+                    status = QC_STATUS_FAIL;
+                }
+                else
+                {
+                    /* the context binary is deserialized from start to end exactly once, so let
+                     * the kernel read ahead aggressively, the advice failure is not fatal */
+                    (void) posix_madvise( pMapped, (size_t) st.st_size, POSIX_MADV_SEQUENTIAL );
+                    (void) posix_madvise( pMapped, (size_t) st.st_size, POSIX_MADV_WILLNEED );
+                    s_mappedBinaryMap[key] = { pMapped, (size_t) st.st_size, 1 };
+                    pData = pMapped;
+                    size = (size_t) st.st_size;
+                }
+            }
+        }
+        (void) close( fd );
     }
 
-    if ( QC_STATUS_OK == status )
+    return status;
+}
+
+void QnnImpl::UnmapBinaryFile( void *pData )
+{
+    std::lock_guard<std::mutex> l( s_mappedBinaryLock );
+    for ( auto it = s_mappedBinaryMap.begin(); it != s_mappedBinaryMap.end(); it++ )
     {
-        size_t readSize = fread( pBuffer, 1, bufferSize, pFile );
-        if ( readSize != bufferSize )
+        if ( it->second.pData == pData )
         {
-            QC_ERROR( "Failed to read binary data." );
-            status = QC_STATUS_FAIL;
+            it->second.refCount--;
+            if ( 0 == it->second.refCount )
+            {
+                (void) munmap( it->second.pData, it->second.size );
+                s_mappedBinaryMap.erase( it );
+            }
+            break;
         }
-        (void) fclose( pFile );
     }
+}
+
+QCStatus_e QnnImpl::CreateFromBinaryFile( std::string modelFile )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    QCBufferDescriptorBase bufDesc;
+    void *pData = nullptr;
+    size_t size = 0;
 
+    status = MapBinaryFile( modelFile, pData, size );
     if ( QC_STATUS_OK == status )
     {
         bufDesc.name = modelFile;
-        bufDesc.pBuf = pBuffer;
-        bufDesc.size = bufferSize;
+        bufDesc.pBuf = pData;
+        bufDesc.size = size;
         bufDesc.type = QC_BUFFER_TYPE_RAW;
         status = CreateFromBinaryBuffer( bufDesc );
-    }
-
-    if ( nullptr != pBuffer )
-    {
-        free( pBuffer );
+        if ( QC_STATUS_OK == status )
+        {
+            /* hold the mapping until Destroy, so the other instances of the same model that
+             * initialize meanwhile reuse the already populated pages */
+            m_pMappedBinary = pData;
+        }
+        else
+        {
+            UnmapBinaryFile( pData );
+        }
     }
 
     return status;
@@ -1063,20 +1134,48 @@ static const int sg_lowerLatency = 40;      // Should be used on V66 and above o
 static const int sg_lowLatency = 100;       // This will limit sleep modes available while running
 static const int sg_mediumLatency = 1000;   // This will limit sleep modes available while running
 
+/* the perf profiles ordered by voltage corner, the steps of the perf governor, the sustained high
+ * performance profile applies the same power config as the high performance profile */
+static const Qnn_PerfProfile_e sg_perfLadder[] = {
+        QNN_PERF_PROFILE_EXTREME_POWER_SAVER, QNN_PERF_PROFILE_LOW_POWER_SAVER,
+        QNN_PERF_PROFILE_POWER_SAVER,         QNN_PERF_PROFILE_HIGH_POWER_SAVER,
+        QNN_PERF_PROFILE_LOW_BALANCED,        QNN_PERF_PROFILE_BALANCED,
+        QNN_PERF_PROFILE_HIGH_PERFORMANCE,    QNN_PERF_PROFILE_BURST };
+
 QCStatus_e QnnImpl::SetHtpPerformanceMode()
 {
     QCStatus_e status = QC_STATUS_OK;
     QnnDevice_Infrastructure_t deviceInfra = nullptr;
     Qnn_ErrorHandle_t retVal;
-    QnnHtpPerfInfrastructure_PowerConfig_t powerConfig;
-    memset( &powerConfig, 0, sizeof( powerConfig ) );
+    Qnn_PerfProfile_e perfProfile = m_config.perfProfile;
 
-#if ( QC_TARGET_SOC == 8797 )
-    QnnHtpPerfInfrastructure_PowerConfig_t powerHmxConfig;
-    memset( &powerHmxConfig, 0, sizeof( powerHmxConfig ) );
-#endif
+    if ( 0 < m_config.targetLatency )
+    {
+        /* the governor starts from the perfProfile if set, otherwise from the highest profile
+         * so that the first frames are not late */
+        if ( QNN_PERF_PROFILE_DEFAULT == perfProfile )
+        {
+            perfProfile = m_config.maxPerfProfile;
+        }
+        else if ( GetPerfLevel( perfProfile ) < GetPerfLevel( m_config.minPerfProfile ) )
+        {
+            perfProfile = m_config.minPerfProfile;
+        }
+        else if ( GetPerfLevel( perfProfile ) > GetPerfLevel( m_config.maxPerfProfile ) )
+        {
+            perfProfile = m_config.maxPerfProfile;
+        }
+        else
+        {
+            /* OK */
+        }
+        m_governorStartProfile = perfProfile;
+        m_governorProfile = perfProfile;
+        m_governorLatencySum = 0;
+        m_governorFrames = 0;
+    }
 
-    QC_INFO( "set HTP perf mode: %d", m_config.perfProfile );
+    QC_INFO( "set HTP perf mode: %d", perfProfile );
 
     retVal = m_qnnFunctionPointers.qnnInterface.deviceGetInfrastructure( &deviceInfra );
     if ( QNN_SUCCESS != retVal )
@@ -1091,6 +1190,8 @@ QCStatus_e QnnImpl::SetHtpPerformanceMode()
                 static_cast<QnnHtpDevice_Infrastructure_t *>( deviceInfra );
         m_perfInfra = &( htpInfra->perfInfra );
         m_powerConfigIds.reserve( m_config.coreIds.size() );
+        m_perfCores.reserve( m_config.coreIds.size() );
+        m_appliedProfiles.reserve( m_config.coreIds.size() );
         for ( size_t i = 0; i < m_config.coreIds.size(); i++ )
         {
             uint32_t deviceId = GetQnnDeviceId( m_config.processorType );
@@ -1110,10 +1211,32 @@ QCStatus_e QnnImpl::SetHtpPerformanceMode()
             else
             {
                 m_powerConfigIds.push_back( powerConfigId );
+                m_perfCores.push_back( PerfCoreKey_t( deviceId, coreId ) );
+                m_appliedProfiles.push_back( QNN_PERF_PROFILE_DEFAULT );
             }
         }
     }
 
+    if ( QC_STATUS_OK == status )
+    {
+        status = VotePerfProfile( perfProfile );
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::ApplyHtpPerfProfile( uint32_t powerConfigId, Qnn_PerfProfile_e perfProfile )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    Qnn_ErrorHandle_t retVal;
+    QnnHtpPerfInfrastructure_PowerConfig_t powerConfig;
+    memset( &powerConfig, 0, sizeof( powerConfig ) );
+
+#if ( QC_TARGET_SOC == 8797 )
+    QnnHtpPerfInfrastructure_PowerConfig_t powerHmxConfig;
+    memset( &powerHmxConfig, 0, sizeof( powerHmxConfig ) );
+#endif
+
     if ( QC_STATUS_OK == status )
     {
         powerConfig.option = QNN_HTP_PERF_INFRASTRUCTURE_POWER_CONFIGOPTION_DCVS_V3;
@@ -1134,7 +1257,7 @@ QCStatus_e QnnImpl::SetHtpPerformanceMode()
         powerHmxConfig.hmxV2Config.hmxPickDefault = 0;
 #endif
 
-        switch ( m_config.perfProfile )
+        switch ( perfProfile )
         {
             case QNN_PERF_PROFILE_BURST:
                 powerConfig.dcvsV3Config.sleepLatency = sg_lowerLatency;
@@ -1280,8 +1403,7 @@ QCStatus_e QnnImpl::SetHtpPerformanceMode()
 #endif
                 break;
             default:
-                QC_ERROR( "Invalid performance profile %d to set power configs",
-                          m_config.perfProfile );
+                QC_ERROR( "Invalid performance profile %d to set power configs", perfProfile );
                 status = QC_STATUS_FAIL;
                 break;
         }
@@ -1289,25 +1411,20 @@ QCStatus_e QnnImpl::SetHtpPerformanceMode()
     if ( QC_STATUS_OK == status )
     {
         // Set power config with different performance parameters
-        for ( uint32_t &powerConfigId : m_powerConfigIds )
-        {
-            powerConfig.dcvsV3Config.contextId = powerConfigId;
-            const QnnHtpPerfInfrastructure_PowerConfig_t *powerConfigs[] = { &powerConfig,
+        powerConfig.dcvsV3Config.contextId = powerConfigId;
+        const QnnHtpPerfInfrastructure_PowerConfig_t *powerConfigs[] = { &powerConfig,
 #if ( QC_TARGET_SOC == 8797 )
-                                                                             &powerHmxConfig,
+                                                                         &powerHmxConfig,
 #endif
-                                                                             NULL };
-            retVal = m_perfInfra->setPowerConfig( powerConfigId, powerConfigs );
-            if ( QNN_SUCCESS != retVal )
-            {
-                QC_ERROR( "Failure in setPowerConfig() = %" PRIu64, retVal );
-                status = QC_STATUS_FAIL;
-                break;
-            }
+                                                                         NULL };
+        retVal = m_perfInfra->setPowerConfig( powerConfigId, powerConfigs );
+        if ( QNN_SUCCESS != retVal )
+        {
+            QC_ERROR( "Failure in setPowerConfig() = %" PRIu64, retVal );
+            status = QC_STATUS_FAIL;
         }
     }
 
-
     return status;
 }
 
@@ -1326,7 +1443,7 @@ QCStatus_e QnnImpl::SetPerformanceMode()
 {
     QCStatus_e status = QC_STATUS_OK;
 
-    if ( QNN_PERF_PROFILE_DEFAULT != m_config.perfProfile )
+    if ( ( QNN_PERF_PROFILE_DEFAULT != m_config.perfProfile ) || ( 0 < m_config.targetLatency ) )
     {
         bool bIsHtp = IsHtpProcessor();
         if ( true == bIsHtp )
@@ -1338,6 +1455,162 @@ QCStatus_e QnnImpl::SetPerformanceMode()
     return status;
 }
 
+int32_t QnnImpl::GetPerfLevel( Qnn_PerfProfile_e perfProfile )
+{
+    int32_t level = -1;
+
+    if ( QNN_PERF_PROFILE_SUSTAINED_HIGH_PERFORMANCE == perfProfile )
+    {
+        perfProfile = QNN_PERF_PROFILE_HIGH_PERFORMANCE;
+    }
+    for ( size_t i = 0; i < sizeof( sg_perfLadder ) / sizeof( sg_perfLadder[0] ); i++ )
+    {
+        if ( sg_perfLadder[i] == perfProfile )
+        {
+            level = (int32_t) i;
+            break;
+        }
+    }
+
+    return level;
+}
+
+uint64_t QnnImpl::GetTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch() )
+            .count();
+}
+
+QCStatus_e QnnImpl::ApplyCoreVotes( const PerfCoreKey_t &core,
+                                    const std::map<QnnImpl *, Qnn_PerfProfile_e> &votes )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    Qnn_PerfProfile_e coreProfile = votes.begin()->second;
+
+    /* the core runs at the highest vote, so that a node does not slow down another */
+    for ( auto &vote : votes )
+    {
+        if ( GetPerfLevel( vote.second ) > GetPerfLevel( coreProfile ) )
+        {
+            coreProfile = vote.second;
+        }
+    }
+
+    for ( auto &vote : votes )
+    {
+        QnnImpl *pVoter = vote.first;
+        for ( size_t i = 0; i < pVoter->m_perfCores.size(); i++ )
+        {
+            if ( ( core == pVoter->m_perfCores[i] ) &&
+                 ( coreProfile != pVoter->m_appliedProfiles[i] ) )
+            {
+                QCStatus_e ret =
+                        pVoter->ApplyHtpPerfProfile( pVoter->m_powerConfigIds[i], coreProfile );
+                if ( QC_STATUS_OK == ret )
+                {
+                    pVoter->m_appliedProfiles[i] = coreProfile;
+                }
+                else
+                {
+                    status = ret;
+                }
+            }
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::VotePerfProfile( Qnn_PerfProfile_e perfProfile )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::lock_guard<std::mutex> l( s_perfArbiterLock );
+
+    for ( PerfCoreKey_t &core : m_perfCores )
+    {
+        std::map<QnnImpl *, Qnn_PerfProfile_e> &votes = s_perfVotes[core];
+        votes[this] = perfProfile;
+        QCStatus_e ret = ApplyCoreVotes( core, votes );
+        if ( QC_STATUS_OK != ret )
+        {
+            status = ret;
+        }
+    }
+
+    return status;
+}
+
+void QnnImpl::WithdrawPerfVote()
+{
+    std::lock_guard<std::mutex> l( s_perfArbiterLock );
+
+    for ( PerfCoreKey_t &core : m_perfCores )
+    {
+        auto it = s_perfVotes.find( core );
+        if ( it != s_perfVotes.end() )
+        {
+            (void) it->second.erase( this );
+            if ( it->second.empty() )
+            {
+                (void) s_perfVotes.erase( it );
+            }
+            else
+            {
+                /* the remaining voters of the core get the highest of their votes */
+                (void) ApplyCoreVotes( core, it->second );
+            }
+        }
+    }
+    m_perfCores.clear();
+    m_appliedProfiles.clear();
+}
+
+void QnnImpl::GovernPerf( uint64_t latencyUs )
+{
+    std::lock_guard<std::mutex> l( m_governorLock );
+    if ( QNN_PERF_PROFILE_DEFAULT != m_governorProfile )
+    {
+        m_governorLatencySum += latencyUs;
+        m_governorFrames++;
+    }
+    if ( ( 0 < m_governorFrames ) && ( m_governorFrames >= m_config.governorWindow ) )
+    {
+        uint64_t avgLatency = m_governorLatencySum / m_governorFrames;
+        uint64_t lowLatency =
+                (uint64_t) m_config.targetLatency * ( 100u - QNN_GOVERNOR_HYSTERESIS ) / 100u;
+        int32_t level = GetPerfLevel( m_governorProfile );
+        int32_t newLevel = level;
+        m_governorLatencySum = 0;
+        m_governorFrames = 0;
+
+        /* one step at a time, the next window measures the effect */
+        if ( ( avgLatency > m_config.targetLatency ) &&
+             ( level < GetPerfLevel( m_config.maxPerfProfile ) ) )
+        {
+            newLevel = level + 1;
+        }
+        else if ( ( avgLatency < lowLatency ) &&
+                  ( level > GetPerfLevel( m_config.minPerfProfile ) ) )
+        {
+            newLevel = level - 1;
+        }
+        else
+        {
+            /* in the hysteresis band or at a bound */
+        }
+
+        if ( newLevel != level )
+        {
+            QC_INFO( "governor: avg latency %" PRIu64 " us, target %u us, perf %d -> %d",
+                     avgLatency, m_config.targetLatency, m_governorProfile,
+                     sg_perfLadder[newLevel] );
+            m_governorProfile = sg_perfLadder[newLevel];
+            (void) VotePerfProfile( m_governorProfile );
+        }
+    }
+}
+
 QCStatus_e
 QnnImpl::Initialize( QCNodeEventCallBack_t callback,
                      std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers )
@@ -1710,6 +1983,12 @@ QnnImpl::Initialize( QCNodeEventCallBack_t callback,
                     QC_ERROR( "buffer %" PRIu32 "is invalid", bufferId );
                     status = QC_STATUS_INVALID_BUF;
                 }
+                else if ( true == m_config.bRegisterBuffersAtStart )
+                {
+                    /* registered in bulk in the background by Start */
+                    std::lock_guard<std::mutex> l( m_registerLock );
+                    m_pendingRegisters.push_back( *pTensorDesc );
+                }
                 else
                 {
                     status = RegisterTensor( *pTensorDesc );
@@ -1728,6 +2007,11 @@ QnnImpl::Initialize( QCNodeEventCallBack_t callback,
         }
     }
 
+    if ( QC_STATUS_OK == status )
+    {
+        status = SetupGraphs();
+    }
+
     if ( QC_STATUS_OK == status )
     {
         status = SetupGlobalBufferIdMap();
@@ -1737,7 +2021,18 @@ QnnImpl::Initialize( QCNodeEventCallBack_t callback,
     {
         QC_INFO( "init with backend %s", s_Backends[m_config.processorType].c_str() );
         m_callback = callback;
-        m_notifyParamQ.Init();
+        m_notifyParamQ.Init( m_config.inFlightDepth );
+        for ( NotifyParam_t &notifyParam : m_notifyParamQ.notifyParam )
+        {
+            notifyParam.tensors.clear();
+            for ( GraphExec_t &graph : m_graphExecs )
+            {
+                notifyParam.tensors.insert( notifyParam.tensors.end(), graph.inputs.begin(),
+                                            graph.inputs.end() );
+                notifyParam.tensors.insert( notifyParam.tensors.end(), graph.outputs.begin(),
+                                            graph.outputs.end() );
+            }
+        }
         m_state = QC_OBJECT_STATE_READY;
     }
     else
@@ -1753,6 +2048,12 @@ QnnImpl::Initialize( QCNodeEventCallBack_t callback,
 QCStatus_e QnnImpl::RemoteRegisterBuf( const TensorDescriptor_t &tensorDesc, int &fd )
 {
     QCStatus_e status = QC_STATUS_OK;
+#if defined( QNN_DISABLE_FASTRPC )
+    /* no FastRPC on this platform, such as an x86 host running the CPU backend */
+    (void) tensorDesc;
+    fd = -1;
+    status = QC_STATUS_UNSUPPORTED;
+#else
 #ifdef QC_USE_REMOTE_REGISTER_V2
     constexpr int client = 0;   // NOTE: default is 0
     int domain = CDSP_DOMAIN_ID;
@@ -1812,6 +2113,7 @@ QCStatus_e QnnImpl::RemoteRegisterBuf( const TensorDescriptor_t &tensorDesc, int
         }
         fd = rpcFd;
     }
+#endif
 
     return status;
 }
@@ -1820,83 +2122,17 @@ QCStatus_e QnnImpl::RegisterBufferToHTP( const TensorDescriptor_t &tensorDesc,
                                          Qnn_MemHandle_t &memHandle )
 {
     QCStatus_e status = QC_STATUS_OK;
-    Qnn_ErrorHandle_t retVal;
-    std::vector<uint32_t> dims( tensorDesc.dims, tensorDesc.dims + tensorDesc.numDims );
-
-#if ( ( QNN_HTP_API_VERSION_MAJOR == 5 ) && ( QNN_HTP_API_VERSION_MINOR >= 16 ) ) ||               \
-        ( QNN_HTP_API_VERSION_MAJOR > 5 )
-#else
-    /* QnnRuntime build with old version QNN SDK that do not support DMA buffer with offset. */
-    if ( 0 != tensorDesc.offset )
-    {
-        QC_ERROR( "Tensor offset is not zero in qnn ealier version!" );
-        status = QC_STATUS_FAIL;
-    }
-#endif
+    bool bRegistered = false;
 
-    if ( QC_STATUS_OK == status )
+    memHandle = nullptr;
     {
         std::lock_guard<std::mutex> l( m_lock );
         auto it = m_dmaMemInfoMap.find( tensorDesc.GetDataPtr() );
-        if ( it == m_dmaMemInfoMap.end() )
-        {
-            int fd;
-            QC_TRACE_BEGIN( "Register", { QCNodeTraceArg( "handle", tensorDesc.dmaHandle ),
-                                          QCNodeTraceArg( "size", tensorDesc.size ) } );
-            status = RemoteRegisterBuf( tensorDesc, fd );
-            if ( QC_STATUS_OK == status )
-            {
-                Qnn_MemDescriptor_t desc;
-                desc.memShape.numDim = tensorDesc.numDims;
-                desc.memShape.dimSize = dims.data();
-                desc.memShape.shapeConfig = nullptr;
-                desc.dataType = SwitchToQnnDataType( tensorDesc.tensorType );
-
-#if ( ( QNN_HTP_API_VERSION_MAJOR == 5 ) && ( QNN_HTP_API_VERSION_MINOR >= 16 ) ) ||               \
-        ( QNN_HTP_API_VERSION_MAJOR > 5 )
-                QnnMemHtp_Descriptor_t htpDesc;
-                htpDesc.type = QNN_HTP_MEM_SHARED_BUFFER;
-                htpDesc.size = tensorDesc.size;
-                htpDesc.sharedBufferConfig.fd = fd;
-                htpDesc.sharedBufferConfig.offset = tensorDesc.offset;
-
-                desc.memType = QNN_MEM_TYPE_CUSTOM;
-                desc.customInfo = &htpDesc;
-#else
-                desc.memType = QNN_MEM_TYPE_ION;
-                desc.ionInfo.fd = fd;
-#endif
-
-                retVal = m_qnnFunctionPointers.qnnInterface.memRegister( m_context, &desc, 1,
-                                                                         &memHandle );
-                if ( QNN_SUCCESS == retVal )
-                {
-                    QnnImpl::DmaMemInfo_t info;
-                    info.memHandle = memHandle;
-                    info.size = tensorDesc.size;
-                    info.fd = fd;
-                    m_dmaMemInfoMap[tensorDesc.GetDataPtr()] = info;
-                    QC_INFO( "succeed to register map buffer %p(%d, %" PRIu64 ", %" PRIu64
-                             ") as %p for core %d",
-                             tensorDesc.pBuf, fd, tensorDesc.size, tensorDesc.offset, memHandle,
-                             m_config.processorType );
-                }
-                else
-                {
-                    RemoteDeRegisterBuf( tensorDesc.pBuf, tensorDesc.size );
-                    QC_ERROR( "failed to map buffer %p(%d, %" PRIu64 ", %" PRIu64
-                              ") for core %d, error %d\n",
-                              tensorDesc.pBuf, fd, tensorDesc.size, tensorDesc.offset,
-                              m_config.processorType, retVal );
-                    status = QC_STATUS_FAIL;
-                }
-            }
-            QC_TRACE_END( "Register", {} );
-        }
-        else
+        if ( it != m_dmaMemInfoMap.end() )
         {
             auto &info = it->second;
             memHandle = info.memHandle;
+            bRegistered = true;
             QC_DEBUG( "already register map buffer %p(%d, %" PRIu64 ", %" PRIu64
                       ") as %p for core %d",
                       tensorDesc.pBuf, info.fd, tensorDesc.size, tensorDesc.offset, memHandle,
@@ -1904,27 +2140,601 @@ QCStatus_e QnnImpl::RegisterBufferToHTP( const TensorDescriptor_t &tensorDesc,
         }
     }
 
+    if ( false == bRegistered )
+    {
+        status = RegisterBuffersToHTP( { &tensorDesc } );
+        if ( QC_STATUS_OK == status )
+        {
+            /* not found if the backend has just rejected the registration */
+            std::lock_guard<std::mutex> l( m_lock );
+            auto it = m_dmaMemInfoMap.find( tensorDesc.GetDataPtr() );
+            if ( it != m_dmaMemInfoMap.end() )
+            {
+                memHandle = it->second.memHandle;
+            }
+        }
+    }
+
     return status;
 }
 
-QCStatus_e QnnImpl::GetMemHandle( const TensorDescriptor_t &tensorDesc, Qnn_MemHandle_t &memHandle )
+QCStatus_e QnnImpl::RegisterBuffersToHTP( const std::vector<const TensorDescriptor_t *> &tensors )
 {
     QCStatus_e status = QC_STATUS_OK;
+    Qnn_ErrorHandle_t retVal;
+    std::vector<const TensorDescriptor_t *> newTensors;
+    std::vector<int> fds;
 
-    memHandle = nullptr;
+    {
+        std::lock_guard<std::mutex> l( m_lock );
+        for ( const TensorDescriptor_t *pTensor : tensors )
+        {
+            void *pData = pTensor->GetDataPtr();
+            if ( ( m_dmaMemInfoMap.end() == m_dmaMemInfoMap.find( pData ) ) &&
+                 ( newTensors.end() ==
+                   std::find_if( newTensors.begin(), newTensors.end(),
+                                 [pData]( const TensorDescriptor_t *pNew ) {
+                                     return pNew->GetDataPtr() == pData;
+                                 } ) ) )
+            {
+                newTensors.push_back( pTensor );
+            }
+        }
+    }
+
+#if ( ( QNN_HTP_API_VERSION_MAJOR == 5 ) && ( QNN_HTP_API_VERSION_MINOR >= 16 ) ) ||               \
+        ( QNN_HTP_API_VERSION_MAJOR > 5 )
+#else
+    for ( const TensorDescriptor_t *pTensor : newTensors )
+    {
+        /* QnnRuntime build with old version QNN SDK that do not support DMA buffer with offset. */
+        if ( 0 != pTensor->offset )
+        {
+            QC_ERROR( "Tensor offset is not zero in qnn ealier version!" );
+            status = QC_STATUS_FAIL;
+        }
+    }
+#endif
+
+    if ( ( QC_STATUS_OK == status ) && ( false == newTensors.empty() ) )
+    {
+        QC_TRACE_BEGIN( "Register", { QCNodeTraceArg( "count", newTensors.size() ) } );
+        for ( const TensorDescriptor_t *pTensor : newTensors )
+        {
+            int fd;
+            status = RemoteRegisterBuf( *pTensor, fd );
+            if ( QC_STATUS_OK != status )
+            {
+                break;
+            }
+            fds.push_back( fd );
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            /* all the buffers are mapped by one call */
+            std::vector<Qnn_MemDescriptor_t> descs( newTensors.size() );
+            std::vector<std::vector<uint32_t>> dims( newTensors.size() );
+            std::vector<Qnn_MemHandle_t> memHandles( newTensors.size(), nullptr );
+#if ( ( QNN_HTP_API_VERSION_MAJOR == 5 ) && ( QNN_HTP_API_VERSION_MINOR >= 16 ) ) ||               \
+        ( QNN_HTP_API_VERSION_MAJOR > 5 )
+            std::vector<QnnMemHtp_Descriptor_t> htpDescs( newTensors.size() );
+#endif
+            for ( size_t i = 0; i < newTensors.size(); i++ )
+            {
+                const TensorDescriptor_t &tensorDesc = *newTensors[i];
+                Qnn_MemDescriptor_t &desc = descs[i];
+                dims[i].assign( tensorDesc.dims, tensorDesc.dims + tensorDesc.numDims );
+                desc.memShape.numDim = tensorDesc.numDims;
+                desc.memShape.dimSize = dims[i].data();
+                desc.memShape.shapeConfig = nullptr;
+                desc.dataType = SwitchToQnnDataType( tensorDesc.tensorType );
+
+#if ( ( QNN_HTP_API_VERSION_MAJOR == 5 ) && ( QNN_HTP_API_VERSION_MINOR >= 16 ) ) ||               \
+        ( QNN_HTP_API_VERSION_MAJOR > 5 )
+                QnnMemHtp_Descriptor_t &htpDesc = htpDescs[i];
+                htpDesc.type = QNN_HTP_MEM_SHARED_BUFFER;
+                htpDesc.size = tensorDesc.size;
+                htpDesc.sharedBufferConfig.fd = fds[i];
+                htpDesc.sharedBufferConfig.offset = tensorDesc.offset;
+
+                desc.memType = QNN_MEM_TYPE_CUSTOM;
+                desc.customInfo = &htpDesc;
+#else
+                desc.memType = QNN_MEM_TYPE_ION;
+                desc.ionInfo.fd = fds[i];
+#endif
+            }
+
+            retVal = m_qnnFunctionPointers.qnnInterface.memRegister(
+                    m_context, descs.data(), static_cast<uint32_t>( descs.size() ),
+                    memHandles.data() );
+            if ( QNN_SUCCESS == retVal )
+            {
+                std::lock_guard<std::mutex> l( m_lock );
+                for ( size_t i = 0; i < newTensors.size(); i++ )
+                {
+                    const TensorDescriptor_t &tensorDesc = *newTensors[i];
+                    if ( m_dmaMemInfoMap.end() != m_dmaMemInfoMap.find( tensorDesc.GetDataPtr() ) )
+                    {
+                        /* registered by a frame in the meantime */
+                        (void) m_qnnFunctionPointers.qnnInterface.memDeRegister( &memHandles[i],
+                                                                                 1 );
+                        RemoteDeRegisterBuf( tensorDesc.pBuf, tensorDesc.size );
+                    }
+                    else
+                    {
+                        QnnImpl::DmaMemInfo_t info;
+                        info.memHandle = memHandles[i];
+                        info.size = tensorDesc.size;
+                        info.fd = fds[i];
+                        info.tensorDesc = tensorDesc;
+                        m_dmaMemInfoMap[tensorDesc.GetDataPtr()] = info;
+                        QC_INFO( "succeed to register map buffer %p(%d, %" PRIu64 ", %" PRIu64
+                                 ") as %p for core %d",
+                                 tensorDesc.pBuf, fds[i], tensorDesc.size, tensorDesc.offset,
+                                 memHandles[i], m_config.processorType );
+                    }
+                }
+            }
+            else
+            {
+                for ( const TensorDescriptor_t *pTensor : newTensors )
+                {
+                    RemoteDeRegisterBuf( pTensor->pBuf, pTensor->size );
+                }
+                if ( QNN_COMMON_ERROR_NOT_SUPPORTED == retVal )
+                {
+                    QC_WARN( "memRegister unsupported, fall back to raw client buffers" );
+                    m_bMemRegisterSupported = false;
+                }
+                else
+                {
+                    QC_ERROR( "failed to map %" PRIu64 " buffers from %p(%d, %" PRIu64
+                              ", %" PRIu64 ") for core %d, error %d\n",
+                              (uint64_t) newTensors.size(), newTensors[0]->pBuf, fds[0],
+                              newTensors[0]->size, newTensors[0]->offset,
+                              m_config.processorType, retVal );
+                    status = QC_STATUS_FAIL;
+                }
+            }
+        }
+        else
+        {
+            for ( size_t i = 0; i < fds.size(); i++ )
+            {
+                RemoteDeRegisterBuf( newTensors[i]->pBuf, newTensors[i]->size );
+            }
+            if ( QC_STATUS_UNSUPPORTED == status )
+            {
+                QC_WARN( "remote register unsupported, fall back to raw client buffers" );
+                m_bMemRegisterSupported = false;
+                status = QC_STATUS_OK;
+            }
+        }
+        QC_TRACE_END( "Register", {} );
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::QueueRegistration( std::vector<TensorDescriptor_t> &tensors )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::lock_guard<std::mutex> l( m_registerLock );
+
+    m_pendingRegisters.insert( m_pendingRegisters.end(), tensors.begin(), tensors.end() );
+    if ( ( false == m_bRegistering ) && ( false == m_pendingRegisters.empty() ) )
+    {
+        if ( m_registerThread.joinable() )
+        {
+            /* done with the previous registration */
+            m_registerThread.join();
+        }
+        m_bRegistering = true;
+        m_registerThread = std::thread( &QnnImpl::RegisterThreadMain, this );
+    }
+
+    return status;
+}
+
+void QnnImpl::RegisterThreadMain()
+{
+    std::unique_lock<std::mutex> l( m_registerLock );
+    while ( false == m_pendingRegisters.empty() )
+    {
+        std::vector<TensorDescriptor_t> tensors;
+        tensors.swap( m_pendingRegisters );
+        l.unlock();
+
+        QCStatus_e status = QC_STATUS_OK;
+        if ( true == m_bMemRegisterSupported )
+        {
+            std::vector<const TensorDescriptor_t *> pTensors;
+            for ( TensorDescriptor_t &tensor : tensors )
+            {
+                pTensors.push_back( &tensor );
+            }
+            status = RegisterBuffersToHTP( pTensors );
+        }
+
+        l.lock();
+        if ( QC_STATUS_OK != status )
+        {
+            m_registerStatus = status;
+        }
+    }
+    m_bRegistering = false;
+    m_registerCond.notify_all();
+}
+
+void QnnImpl::JoinRegisterThread()
+{
+    std::thread registerThread;
+    {
+        std::lock_guard<std::mutex> l( m_registerLock );
+        registerThread.swap( m_registerThread );
+    }
+    if ( registerThread.joinable() )
+    {
+        registerThread.join();
+    }
+}
+
+QCStatus_e QnnImpl::RegisterBuffers(
+        std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers, bool bAsync )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::vector<TensorDescriptor_t> tensors;
+
+    if ( ( QC_OBJECT_STATE_READY != m_state ) && ( QC_OBJECT_STATE_RUNNING != m_state ) )
+    {
+        QC_ERROR( "QNN node not in ready or running status!" );
+        status = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        for ( QCBufferDescriptorBase &bufDesc : buffers )
+        {
+            const TensorDescriptor_t *pTensor =
+                    dynamic_cast<const TensorDescriptor_t *>( &bufDesc );
+            if ( nullptr != pTensor )
+            {
+                tensors.push_back( *pTensor );
+            }
+            else
+            {
+                QC_DEBUG( "buffer %p is not a tensor, not registered", bufDesc.pBuf );
+            }
+        }
+    }
+
+    if ( ( QC_STATUS_OK != status ) || ( false == IsHtpProcessor() ) ||
+         ( false == m_bMemRegisterSupported ) )
+    {
+        /* nothing to register with the CPU and GPU backends */
+    }
+    else if ( true == bAsync )
+    {
+        status = QueueRegistration( tensors );
+    }
+    else
+    {
+        std::vector<const TensorDescriptor_t *> pTensors;
+        for ( TensorDescriptor_t &tensor : tensors )
+        {
+            pTensors.push_back( &tensor );
+        }
+        status = RegisterBuffersToHTP( pTensors );
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::WaitBuffersRegistered( uint32_t timeoutMs )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::unique_lock<std::mutex> l( m_registerLock );
+
+    bool bDone = m_registerCond.wait_for( l, std::chrono::milliseconds( timeoutMs ),
+                                          [this] { return false == m_bRegistering; } );
+    if ( false == bDone )
+    {
+        status = QC_STATUS_TIMEOUT;
+    }
+    else
+    {
+        status = m_registerStatus;
+        m_registerStatus = QC_STATUS_OK;
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::GetMemHandle( const TensorDescriptor_t &tensorDesc, Qnn_MemHandle_t &memHandle )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    memHandle = nullptr;
     bool bIsHtp = IsHtpProcessor();
-    if ( true == bIsHtp )
+    if ( ( true == bIsHtp ) && ( true == m_bMemRegisterSupported ) )
     {
         status = RegisterBufferToHTP( tensorDesc, memHandle );
     }
+    else
+    {
+        /* the CPU and GPU backends, or no memory registration, use raw client buffers */
+    }
 
     return status;
 }
 
-QCStatus_e QnnImpl::RegisterTensor( const TensorDescriptor_t &tensorDesc )
-{
-    Qnn_MemHandle_t memHandle = nullptr;
-    return GetMemHandle( tensorDesc, memHandle );
+QCStatus_e QnnImpl::RegisterTensor( const TensorDescriptor_t &tensorDesc )
+{
+    Qnn_MemHandle_t memHandle = nullptr;
+    return GetMemHandle( tensorDesc, memHandle );
+}
+
+#if !defined( QNN_DISABLE_FASTRPC )
+#if defined( __QNXNTO__ )
+using ScratchDmaAllocator = PMEMAllocator;
+#else
+using ScratchDmaAllocator = DMABUFFAllocator;
+#endif
+#endif
+
+/* the allocator of the warm-up scratch tensors, the DMA memory shared with the HTP, registered as
+ * the buffers of the frames, or the heap for the other backends */
+static QCMemoryAllocatorIfs &GetScratchAllocator( QCMemoryAllocator_e allocatorType )
+{
+    static HeapAllocator s_heapAllocator;
+#if !defined( QNN_DISABLE_FASTRPC )
+    static ScratchDmaAllocator s_dmaHtpAllocator( { "QNN_SCRATCH" }, QC_MEMORY_ALLOCATOR_DMA_HTP );
+    if ( QC_MEMORY_ALLOCATOR_DMA_HTP == allocatorType )
+    {
+        return s_dmaHtpAllocator;
+    }
+#else
+    (void) allocatorType;
+#endif
+    return s_heapAllocator;
+}
+
+QCStatus_e QnnImpl::AllocateScratchTensors()
+{
+    QCStatus_e status = QC_STATUS_OK;
+    bool bIsHtp = IsHtpProcessor();
+
+    if ( false == m_scratchTensors.empty() )
+    {
+        /* allocated by a previous Start */
+    }
+    else
+    {
+        UtilsBase utils;
+        m_scratchTensors.resize( m_nodeTensors.size() );
+        for ( uint32_t tensorId = 0; tensorId < m_nodeTensors.size(); tensorId++ )
+        {
+            const Qnn_Tensor_t *pTensor = m_nodeTensors[tensorId];
+            const uint32_t rank = QNN_TENSOR_GET_RANK( pTensor );
+            const uint32_t *dimensions = QNN_TENSOR_GET_DIMENSIONS( pTensor );
+            TensorDescriptor_t &scratch = m_scratchTensors[tensorId];
+            TensorProps_t props;
+
+            props.tensorType = SwitchFromQnnDataType( QNN_TENSOR_GET_DATA_TYPE( pTensor ) );
+            props.allocatorType = QC_MEMORY_ALLOCATOR_HEAP;
+#if !defined( QNN_DISABLE_FASTRPC )
+            if ( true == bIsHtp )
+            {
+                props.allocatorType = QC_MEMORY_ALLOCATOR_DMA_HTP;
+            }
+#else
+            (void) bIsHtp;
+#endif
+            if ( rank > QC_NUM_TENSOR_DIMS )
+            {
+                status = QC_STATUS_UNSUPPORTED;
+            }
+            else
+            {
+                props.numDims = rank;
+                std::copy( dimensions, dimensions + rank, props.dims );
+                /* the size of the tensor by the data size table of the memory utils */
+                status = utils.SetTensorDescFromTensorProp( props, scratch );
+            }
+
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "Tensor %s: no scratch tensor for the warm-up",
+                          QNN_TENSOR_GET_NAME( pTensor ) );
+                status = QC_STATUS_UNSUPPORTED;
+                break;
+            }
+
+            status = GetScratchAllocator( props.allocatorType ).Allocate( props, scratch );
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "Tensor %s: failed to allocate %" PRIu64 " bytes for the warm-up",
+                          QNN_TENSOR_GET_NAME( pTensor ), (uint64_t) props.size );
+                scratch.pBuf = nullptr;
+                break;
+            }
+
+            scratch.name = QNN_TENSOR_GET_NAME( pTensor );
+            scratch.validSize = scratch.size;
+            scratch.offset = 0;
+            (void) memset( scratch.pBuf, 0, scratch.size );
+        }
+
+        if ( QC_STATUS_OK != status )
+        {
+            FreeScratchTensors();
+        }
+    }
+
+    return status;
+}
+
+void QnnImpl::FreeScratchTensors()
+{
+    Qnn_ErrorHandle_t retVal;
+    bool bIsHtp = IsHtpProcessor();
+
+    for ( TensorDescriptor_t &scratch : m_scratchTensors )
+    {
+        if ( nullptr == scratch.pBuf )
+        {
+            /* not allocated */
+        }
+        else
+        {
+            /* registered by the warm-up, unless all the buffers were deregistered since */
+            std::lock_guard<std::mutex> l( m_lock );
+            auto it = m_dmaMemInfoMap.find( scratch.GetDataPtr() );
+            if ( it != m_dmaMemInfoMap.end() )
+            {
+                retVal = m_qnnFunctionPointers.qnnInterface.memDeRegister( &it->second.memHandle,
+                                                                           1 );
+                if ( QNN_SUCCESS != retVal )
+                {
+                    QC_ERROR( "Failed to DeRegister scratch tensor %s. error is %" PRIu64,
+                              scratch.name.c_str(), retVal );
+                }
+                if ( true == bIsHtp )
+                {
+                    RemoteDeRegisterBuf( it->second.tensorDesc.pBuf, it->second.size );
+                }
+                (void) m_dmaMemInfoMap.erase( it );
+            }
+            (void) GetScratchAllocator( scratch.allocatorType ).Free( scratch );
+        }
+    }
+    m_scratchTensors.clear();
+}
+
+QCStatus_e QnnImpl::Warmup()
+{
+    QCStatus_e status = QC_STATUS_OK;
+    Qnn_ErrorHandle_t retVal;
+    Qnn_ProfileHandle_t profileHandle = m_profileBackendHandle;
+    std::vector<Qnn_PerfBaseline_t> baselines( m_graphExecs.size() );
+
+    status = AllocateScratchTensors();
+    if ( ( QC_STATUS_OK == status ) && ( nullptr == profileHandle ) )
+    {
+        /* a profiler of the warm-up only, the perf of the frames stays disabled */
+        retVal = m_qnnFunctionPointers.qnnInterface.profileCreate(
+                m_backendHandle, QNN_PROFILE_LEVEL_BASIC, &profileHandle );
+        if ( QNN_PROFILE_NO_ERROR != retVal )
+        {
+            QC_WARN( "failed to create the warm-up profile, error is %" PRIu64, retVal );
+            profileHandle = nullptr;
+        }
+    }
+
+    /* the graphs are in the order of their dependencies, so a chained scratch tensor is produced
+     * before it is consumed */
+    for ( uint32_t graphIdx = 0; ( graphIdx < m_graphExecs.size() ) && ( QC_STATUS_OK == status );
+          graphIdx++ )
+    {
+        GraphExec_t &graph = m_graphExecs[graphIdx];
+        std::vector<Qnn_Tensor_t> tensors( graph.inputs );
+        tensors.insert( tensors.end(), graph.outputs.begin(), graph.outputs.end() );
+        std::vector<uint32_t> tensorIds( graph.inputIds );
+        tensorIds.insert( tensorIds.end(), graph.outputIds.begin(), graph.outputIds.end() );
+
+        for ( size_t i = 0; ( i < tensors.size() ) && ( QC_STATUS_OK == status ); i++ )
+        {
+            TensorDescriptor_t &scratch = m_scratchTensors[tensorIds[i]];
+            Qnn_MemHandle_t memHandle = nullptr;
+            status = GetMemHandle( scratch, memHandle );
+            if ( QC_STATUS_OK == status )
+            {
+                QNN_TENSOR_SET_DIMENSIONS( &tensors[i], scratch.dims );
+                if ( nullptr != memHandle )
+                {
+                    QNN_TENSOR_SET_MEM_TYPE( &tensors[i], QNN_TENSORMEMTYPE_MEMHANDLE );
+                    QNN_TENSOR_SET_MEM_HANDLE( &tensors[i], memHandle );
+                }
+                else
+                {
+                    QNN_TENSOR_SET_MEM_TYPE( &tensors[i], QNN_TENSORMEMTYPE_RAW );
+                    Qnn_ClientBuffer_t clientBuffer = { (uint8_t *) scratch.GetDataPtr(),
+                                                        (uint32_t) scratch.GetDataSize() };
+                    QNN_TENSOR_SET_CLIENT_BUF( &tensors[i], clientBuffer );
+                }
+            }
+        }
+
+        std::vector<uint64_t> wallTimes;
+        std::vector<Qnn_Perf_t> perfs;
+        Qnn_Tensor_t *pInputs = tensors.data();
+        Qnn_Tensor_t *pOutputs = pInputs + graph.inputs.size();
+        for ( uint32_t frame = 0; ( frame < m_config.warmupFrames ) && ( QC_STATUS_OK == status );
+              frame++ )
+        {
+            uint64_t beginUs = GetTimeUs();
+            retVal = m_qnnFunctionPointers.qnnInterface.graphExecute(
+                    graph.pGraphInfo->graph, pInputs, graph.inputs.size(), pOutputs,
+                    graph.outputs.size(), profileHandle, nullptr );
+            if ( QNN_GRAPH_NO_ERROR != retVal )
+            {
+                QC_ERROR( "QNN failed to warm up graph %s: %" PRIu64, graph.pGraphInfo->graphName,
+                          retVal );
+                status = QC_STATUS_FAIL;
+            }
+            else
+            {
+                Qnn_Perf_t perf;
+                wallTimes.push_back( GetTimeUs() - beginUs );
+                if ( ( nullptr != profileHandle ) &&
+                     ( QC_STATUS_OK == CollectPerf( profileHandle, perf ) ) )
+                {
+                    perfs.push_back( perf );
+                }
+            }
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            /* the median, not biased by the first executions loading the graph */
+            Qnn_PerfBaseline_t &baseline = baselines[graphIdx];
+            baseline.graphName = graph.pGraphInfo->graphName;
+            baseline.numFrames = m_config.warmupFrames;
+            std::sort( wallTimes.begin(), wallTimes.end() );
+            baseline.wallTime = wallTimes[wallTimes.size() / 2];
+            (void) memset( &baseline.perf, 0, sizeof( baseline.perf ) );
+            if ( false == perfs.empty() )
+            {
+                std::sort( perfs.begin(), perfs.end(),
+                           []( const Qnn_Perf_t &a, const Qnn_Perf_t &b ) {
+                               return a.entireExecTime < b.entireExecTime;
+                           } );
+                baseline.perf = perfs[perfs.size() / 2];
+            }
+            QC_INFO( "graph %s warm-up: %u frames, wall %" PRIu64 " us, execute %" PRIu64
+                     " us, HTP %" PRIu64 " us",
+                     baseline.graphName.c_str(), baseline.numFrames, baseline.wallTime,
+                     baseline.perf.entireExecTime, baseline.perf.rpcExecTimeHTP );
+        }
+    }
+
+    if ( ( nullptr != profileHandle ) && ( m_profileBackendHandle != profileHandle ) )
+    {
+        retVal = m_qnnFunctionPointers.qnnInterface.profileFree( profileHandle );
+        if ( QNN_PROFILE_NO_ERROR != retVal )
+        {
+            QC_WARN( "Could not free the warm-up profile handle. error is %" PRIu64, retVal );
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        std::lock_guard<std::mutex> l( m_baselineLock );
+        m_perfBaselines = baselines;
+    }
+
+    return status;
 }
 
 QCStatus_e QnnImpl::Start()
@@ -1934,7 +2744,51 @@ QCStatus_e QnnImpl::Start()
     QC_TRACE_BEGIN( "Start", {} );
     if ( QC_OBJECT_STATE_READY == m_state )
     {
-        m_state = QC_OBJECT_STATE_RUNNING;
+        bool bVoted = false;
+        if ( 0 < m_config.targetLatency )
+        {
+            /* from the initial profile of the governor, reset by Stop */
+            std::lock_guard<std::mutex> l( m_governorLock );
+            m_governorLatencySum = 0;
+            m_governorFrames = 0;
+            if ( QNN_PERF_PROFILE_DEFAULT != m_governorProfile )
+            {
+                status = VotePerfProfile( m_governorProfile );
+                bVoted = true;
+            }
+        }
+
+        if ( ( QC_STATUS_OK == status ) && ( 0 < m_config.warmupFrames ) )
+        {
+            /* with the perf profile of the frames, so the baselines are of the same clocks */
+            status = Warmup();
+        }
+
+        if ( ( QC_STATUS_OK == status ) && ( true == IsHtpProcessor() ) )
+        {
+            /* the buffers of bufferIds or those deregistered by Stop, the frames may start before
+             * they are all registered */
+            std::vector<TensorDescriptor_t> tensors;
+            status = QueueRegistration( tensors );
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            m_state = QC_OBJECT_STATE_RUNNING;
+        }
+        else
+        {
+            /* still ready, nothing of the failed start is left running or held */
+            JoinRegisterThread();
+            FreeScratchTensors();
+            if ( true == bVoted )
+            {
+                /* the idle vote of Stop, the other nodes of the core may still hold it higher */
+                std::lock_guard<std::mutex> l( m_governorLock );
+                (void) VotePerfProfile( m_config.minPerfProfile );
+            }
+            QC_ERROR( "QNN node start failed: %d", status );
+        }
     }
     else
     {
@@ -1996,161 +2850,403 @@ QCStatus_e QnnImpl::ValidateTensor( const TensorDescriptor_t &tensorDesc,
     return status;
 }
 
-QCStatus_e QnnImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc )
+QCStatus_e QnnImpl::AssembleBatch( QCFrameDescriptorNodeIfs &frameDesc, uint32_t tensorId,
+                                   const Qnn_Tensor_t &tensorInfo, TensorDescriptor_t &batchDesc )
 {
     QCStatus_e status = QC_STATUS_OK;
-    Qnn_ErrorHandle_t retVal;
-    NotifyParam_t *pNotifyParam = nullptr;
+    const std::vector<uint32_t> &sliceIds = m_batchSliceIds[tensorId];
+    const uint32_t *dimensions = QNN_TENSOR_GET_DIMENSIONS( &tensorInfo );
+    uint32_t batch = 0;
+    size_t endOffset = 0;
 
-    if ( QC_OBJECT_STATE_RUNNING != m_state )
+    for ( size_t i = 0; ( i < sliceIds.size() ) && ( QC_STATUS_OK == status ); i++ )
     {
-        QC_ERROR( "QNN node not in running status!" );
-        status = QC_STATUS_BAD_STATE;
+        const TensorDescriptor_t *pSlice =
+                dynamic_cast<const TensorDescriptor_t *>( &frameDesc.GetBuffer( sliceIds[i] ) );
+        if ( nullptr == pSlice )
+        {
+            QC_ERROR( "slice %" PRIu64 "(%u) of tensor %u is not a tensor!", (uint64_t) i,
+                      sliceIds[i], tensorId );
+            status = QC_STATUS_INVALID_BUF;
+        }
+        else if ( 0 == pSlice->numDims )
+        {
+            QC_ERROR( "slice %" PRIu64 "(%u) of tensor %u has no dims!", (uint64_t) i,
+                      sliceIds[i], tensorId );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( 0 == i )
+        {
+            batchDesc = *pSlice;
+        }
+        else if ( ( pSlice->pBuf != batchDesc.pBuf ) ||
+                  ( pSlice->dmaHandle != batchDesc.dmaHandle ) ||
+                  ( pSlice->size != batchDesc.size ) )
+        {
+            QC_ERROR( "slice %" PRIu64 "(%u) of tensor %u is not in the buffer of the first slice!",
+                      (uint64_t) i, sliceIds[i], tensorId );
+            status = QC_STATUS_INVALID_BUF;
+        }
+        else if ( pSlice->offset != endOffset )
+        {
+            QC_ERROR( "slice %" PRIu64 "(%u) of tensor %u at offset %" PRIu64 " does not follow "
+                      "the previous slice ending at %" PRIu64 "!",
+                      (uint64_t) i, sliceIds[i], tensorId, (uint64_t) pSlice->offset,
+                      (uint64_t) endOffset );
+            status = QC_STATUS_INVALID_BUF;
+        }
+        else if ( ( pSlice->tensorType != batchDesc.tensorType ) ||
+                  ( pSlice->numDims != batchDesc.numDims ) ||
+                  ( false == std::equal( pSlice->dims + 1, pSlice->dims + pSlice->numDims,
+                                         batchDesc.dims + 1 ) ) )
+        {
+            QC_ERROR( "slice %" PRIu64 "(%u) of tensor %u differs from the first slice!",
+                      (uint64_t) i, sliceIds[i], tensorId );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            /* OK */
+        }
+
+        if ( QC_STATUS_OK == status )
+        {
+            batch += pSlice->dims[0];
+            endOffset = pSlice->offset + pSlice->validSize;
+        }
     }
-    else
+
+    if ( ( QC_STATUS_OK == status ) && ( batch != dimensions[0] ) )
     {
-        /* OK */
+        QC_ERROR( "the slices of tensor %u have a batch of %u, expected %u", tensorId, batch,
+                  dimensions[0] );
+        status = QC_STATUS_BAD_ARGUMENTS;
     }
 
     if ( QC_STATUS_OK == status )
     {
-        for ( uint32_t i = 0; i < m_inputTensorNum; i++ )
+        /* a view of the whole batch, the slices are not copied */
+        batchDesc.dims[0] = batch;
+        batchDesc.validSize = endOffset - batchDesc.offset;
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::BindTensor( QCFrameDescriptorNodeIfs &frameDesc, uint32_t tensorId,
+                                const Qnn_Tensor_t &tensorInfo, BindingCache_t &bindings,
+                                Qnn_Tensor_t &tensor )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    uint32_t globalBufferId =
+            m_config.globalBufferIdMap[static_cast<size_t>( tensorId )].globalBufferId;
+    QCBufferDescriptorBase_t &bufDesc = frameDesc.GetBuffer( globalBufferId );
+    const bool bSliced = ( false == m_batchSliceIds[tensorId].empty() );
+    TensorDescriptor_t batchDesc;
+
+    if ( true == bSliced )
+    {
+        /* checked on every frame, as any slice may move while the first one stays */
+        status = AssembleBatch( frameDesc, tensorId, tensorInfo, batchDesc );
+    }
+
+    auto it = bindings.find( &bufDesc );
+    if ( QC_STATUS_OK != status )
+    {
+        /* error already reported */
+    }
+    else if ( ( false == m_config.bStrictValidation ) && ( it != bindings.end() ) &&
+              ( it->second.pData == it->second.pTensor->GetDataPtr() ) &&
+              ( it->second.dmaHandle == bufDesc.dmaHandle ) &&
+              ( it->second.size == bufDesc.size ) )
+    {
+        /* a known buffer, already validated and registered */
+        tensor = it->second.tensor;
+    }
+    else
+    {
+        Qnn_MemHandle_t memHandle = nullptr;
+        const char *pDirection = ( tensorId < m_inputTensorNum ) ? "input" : "output";
+        TensorDescriptor_t *pTensor = dynamic_cast<TensorDescriptor_t *>( &bufDesc );
+        /* a batch of slices is bound as the view of the whole batch */
+        const TensorDescriptor_t *pBound = ( true == bSliced ) ? &batchDesc : pTensor;
+        if ( nullptr != pTensor )
         {
-            Qnn_MemHandle_t memHandle = nullptr;
-            uint32_t globalBufferId =
-                    m_config.globalBufferIdMap[static_cast<size_t>( i )].globalBufferId;
-            QCBufferDescriptorBase_t &bufDesc = frameDesc.GetBuffer( globalBufferId );
-            const TensorDescriptor_t *pTensor =
-                    dynamic_cast<const TensorDescriptor_t *>( &bufDesc );
-            if ( nullptr != pTensor )
+            status = ValidateTensor( *pBound, tensorInfo );
+            if ( QC_STATUS_OK != status )
+            {
+                QC_ERROR( "%s %u(%u) is not a valid tensor!", pDirection, tensorId,
+                          globalBufferId );
+            }
+            else
             {
-                QC_TRACE_IF(
-                        0 == i,
-                        QC_TRACE_BEGIN( "Execute", { QCNodeTraceArg( "frameId", pTensor->id ) } ) );
+                status = GetMemHandle( *pBound, memHandle );
+            }
+        }
+        else
+        {
+            QC_ERROR( "%s %u(%u) is not a tensor!", pDirection, tensorId, globalBufferId );
+            status = QC_STATUS_INVALID_BUF;
+        }
 
-                status = ValidateTensor( *pTensor, m_graphsInfo[0]->inputTensors[i] );
-                if ( QC_STATUS_OK != status )
-                {
-                    QC_ERROR( "input %u(%u) is not a valid tensor!", i, globalBufferId );
-                }
-                else
-                {
-                    status = GetMemHandle( *pTensor, memHandle );
-                }
+        if ( QC_STATUS_OK == status )
+        {
+            if ( true == bSliced )
+            {
+                /* the batched dims, as long lived as the graph */
+                QNN_TENSOR_SET_DIMENSIONS( &tensor, QNN_TENSOR_GET_DIMENSIONS( &tensorInfo ) );
             }
             else
             {
-                QC_ERROR( "input %u(%u) is not a tensor!", i, globalBufferId );
-                status = QC_STATUS_INVALID_BUF;
+                QNN_TENSOR_SET_DIMENSIONS( &tensor, (uint32_t *) pTensor->dims );
             }
-            if ( QC_STATUS_OK == status )
+            if ( nullptr != memHandle )
             {
-                QNN_TENSOR_SET_DIMENSIONS( &m_inputs[i], (uint32_t *) pTensor->dims );
-                if ( nullptr != memHandle )
-                {
-                    QNN_TENSOR_SET_MEM_TYPE( &m_inputs[i], QNN_TENSORMEMTYPE_MEMHANDLE );
-                    QNN_TENSOR_SET_MEM_HANDLE( &m_inputs[i], memHandle );
-                }
-                else
-                {
-                    QNN_TENSOR_SET_MEM_TYPE( &m_inputs[i], QNN_TENSORMEMTYPE_RAW );
-                    Qnn_ClientBuffer_t clientBuffer = { (uint8_t *) pTensor->GetDataPtr(),
-                                                        (uint32_t) pTensor->GetDataSize() };
-                    QNN_TENSOR_SET_CLIENT_BUF( &m_inputs[i], clientBuffer );
-                }
+                QNN_TENSOR_SET_MEM_TYPE( &tensor, QNN_TENSORMEMTYPE_MEMHANDLE );
+                QNN_TENSOR_SET_MEM_HANDLE( &tensor, memHandle );
             }
             else
             {
-                break;
+                QNN_TENSOR_SET_MEM_TYPE( &tensor, QNN_TENSORMEMTYPE_RAW );
+                Qnn_ClientBuffer_t clientBuffer = { (uint8_t *) pBound->GetDataPtr(),
+                                                    (uint32_t) pBound->GetDataSize() };
+                QNN_TENSOR_SET_CLIENT_BUF( &tensor, clientBuffer );
             }
+
+            if ( bindings.size() >= QNN_BINDING_CACHE_SIZE )
+            {
+                /* the buffers are not from fixed pools, start over */
+                bindings.clear();
+            }
+            float quantScale = 1.0f;
+            int32_t quantOffset = 0;
+            Qnn_QuantizeParams_t quantizeParams = QNN_TENSOR_GET_QUANT_PARAMS( &tensorInfo );
+            if ( QNN_QUANTIZATION_ENCODING_SCALE_OFFSET == quantizeParams.quantizationEncoding )
+            {
+                quantScale = quantizeParams.scaleOffsetEncoding.scale;
+                quantOffset = quantizeParams.scaleOffsetEncoding.offset;
+            }
+
+            it = bindings.insert_or_assign( &bufDesc,
+                                            TensorBinding_t{ pTensor, pTensor->GetDataPtr(),
+                                                             bufDesc.dmaHandle, bufDesc.size,
+                                                             tensor, quantScale, quantOffset } )
+                         .first;
         }
     }
 
-    if ( QC_STATUS_OK == status )
+    if ( ( QC_STATUS_OK == status ) && ( tensorId >= m_inputTensorNum ) )
     {
-        for ( uint32_t i = 0; i < m_outputTensorNum; i++ )
+        /* publish the quantization of the output along with it, for the CPU post processing */
+        it->second.pTensor->quantScale = it->second.quantScale;
+        it->second.pTensor->quantOffset = it->second.quantOffset;
+        for ( size_t i = 1; i < m_batchSliceIds[tensorId].size(); i++ )
         {
-            Qnn_MemHandle_t memHandle = nullptr;
-            uint32_t globalBufferId =
-                    m_config.globalBufferIdMap[static_cast<size_t>( m_inputTensorNum + i )]
-                            .globalBufferId;
-            QCBufferDescriptorBase_t &bufDesc = frameDesc.GetBuffer( globalBufferId );
-            const TensorDescriptor_t *pTensor =
-                    dynamic_cast<const TensorDescriptor_t *>( &bufDesc );
-            if ( nullptr != pTensor )
-            {
-                status = ValidateTensor( *pTensor, m_graphsInfo[0]->outputTensors[i] );
-                if ( QC_STATUS_OK != status )
-                {
-                    QC_ERROR( "output %u(%u) is not a valid tensor!", i, globalBufferId );
-                }
-                else
-                {
-                    status = GetMemHandle( *pTensor, memHandle );
-                }
-            }
-            else
+            TensorDescriptor_t &slice = dynamic_cast<TensorDescriptor_t &>(
+                    frameDesc.GetBuffer( m_batchSliceIds[tensorId][i] ) );
+            slice.quantScale = it->second.quantScale;
+            slice.quantOffset = it->second.quantOffset;
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::BindGraphTensors( QCFrameDescriptorNodeIfs &frameDesc, GraphExec_t &graph,
+                                      Qnn_Tensor_t *pInputs, Qnn_Tensor_t *pOutputs )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    for ( size_t i = 0; ( i < graph.inputs.size() ) && ( QC_STATUS_OK == status ); i++ )
+    {
+        status = BindTensor( frameDesc, graph.inputIds[i], graph.pGraphInfo->inputTensors[i],
+                             graph.inputBindings[i], pInputs[i] );
+    }
+
+    for ( size_t i = 0; ( i < graph.outputs.size() ) && ( QC_STATUS_OK == status ); i++ )
+    {
+        status = BindTensor( frameDesc, graph.outputIds[i], graph.pGraphInfo->outputTensors[i],
+                             graph.outputBindings[i], pOutputs[i] );
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::SubmitStages( NotifyParam_t &notifyParam, uint32_t stage )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    Qnn_ErrorHandle_t retVal;
+
+    /* called with m_notifyLock held, skip the stages without any active graph */
+    for ( ; ( stage < m_numStages ) && ( 0 == notifyParam.numRunning ); stage++ )
+    {
+        notifyParam.stage = stage;
+        for ( uint32_t graphIdx = 0; graphIdx < m_graphExecs.size(); graphIdx++ )
+        {
+            GraphExec_t &graph = m_graphExecs[graphIdx];
+            if ( ( stage != graph.stage ) ||
+                 ( 0 == ( notifyParam.activeGraphMask & ( 1ull << graphIdx ) ) ) )
             {
-                QC_ERROR( "output %u(%u) is not a tensor!", i, globalBufferId );
-                status = QC_STATUS_INVALID_BUF;
+                continue;
             }
+
+            /* the tensors of this frame, not touched by the other frames in flight */
+            Qnn_Tensor_t *pInputs = notifyParam.tensors.data() + graph.tensorBase;
+            Qnn_Tensor_t *pOutputs = pInputs + graph.inputs.size();
+            status = BindGraphTensors( *notifyParam.pFrameDesc, graph, pInputs, pOutputs );
             if ( QC_STATUS_OK == status )
             {
-                QNN_TENSOR_SET_DIMENSIONS( &m_outputs[i], (uint32_t *) pTensor->dims );
-                if ( nullptr != memHandle )
-                {
-                    QNN_TENSOR_SET_MEM_TYPE( &m_outputs[i], QNN_TENSORMEMTYPE_MEMHANDLE );
-                    QNN_TENSOR_SET_MEM_HANDLE( &m_outputs[i], memHandle );
-                }
-                else
+                /* count it before the submission as the notification may come at once */
+                notifyParam.numRunning++;
+                retVal = m_qnnFunctionPointers.qnnInterface.graphExecuteAsync(
+                        graph.pGraphInfo->graph, pInputs, graph.inputs.size(), pOutputs,
+                        graph.outputs.size(), m_profileBackendHandle, nullptr, QnnNotifyFn,
+                        &notifyParam );
+                if ( QNN_GRAPH_NO_ERROR != retVal )
                 {
-                    QNN_TENSOR_SET_MEM_TYPE( &m_outputs[i], QNN_TENSORMEMTYPE_RAW );
-                    Qnn_ClientBuffer_t clientBuffer = { (uint8_t *) pTensor->GetDataPtr(),
-                                                        (uint32_t) pTensor->GetDataSize() };
-                    QNN_TENSOR_SET_CLIENT_BUF( &m_outputs[i], clientBuffer );
+                    QC_ERROR( "QNN failed to submit graph %s: %" PRIu64,
+                              graph.pGraphInfo->graphName, retVal );
+                    notifyParam.numRunning--;
+                    status = QC_STATUS_FAIL;
                 }
             }
-            else
+
+            if ( QC_STATUS_OK != status )
             {
                 break;
             }
         }
+
+        if ( QC_STATUS_OK != status )
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    Qnn_ErrorHandle_t retVal;
+    NotifyParam_t *pNotifyParam = nullptr;
+
+    if ( QC_OBJECT_STATE_RUNNING != m_state )
+    {
+        QC_ERROR( "QNN node not in running status!" );
+        status = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        /* OK */
     }
 
     if ( QC_STATUS_OK == status )
     {
-        const Qnn_GraphHandle_t hGraph = m_graphsInfo[0]->graph;
-        if ( nullptr == m_callback )
+        uint32_t globalBufferId = m_config.globalBufferIdMap[0].globalBufferId;
+        const TensorDescriptor_t *pTensor =
+                dynamic_cast<const TensorDescriptor_t *>( &frameDesc.GetBuffer( globalBufferId ) );
+        QC_TRACE_IF( nullptr != pTensor,
+                     QC_TRACE_BEGIN( "Execute", { QCNodeTraceArg( "frameId", pTensor->id ) } ) );
+    }
+
+    if ( ( QC_STATUS_OK == status ) && ( nullptr == m_callback ) )
+    {
+        uint64_t beginUs = GetTimeUs();
+        /* with the perf enabled, the governor is fed the execution time profiled by the backend
+         * instead of the host latency */
+        bool bProfiled = ( 0 < m_config.targetLatency ) && ( nullptr != m_profileBackendHandle );
+        uint64_t execTimeUs = 0;
+        /* the stages are in the order of the graph dependencies, so executing the graphs one by
+         * one in stage order produces every chained tensor before it is consumed */
+        for ( uint32_t stage = 0; ( stage < m_numStages ) && ( QC_STATUS_OK == status ); stage++ )
         {
-            retVal = m_qnnFunctionPointers.qnnInterface.graphExecute(
-                    hGraph, m_inputs.data(), m_inputs.size(), m_outputs.data(), m_outputs.size(),
-                    m_profileBackendHandle, nullptr );
-            QC_TRACE_END( "Execute", {} );
+            for ( uint32_t graphIdx = 0; graphIdx < m_graphExecs.size(); graphIdx++ )
+            {
+                GraphExec_t &graph = m_graphExecs[graphIdx];
+                if ( ( stage != graph.stage ) ||
+                     ( 0 == ( m_activeGraphMask & ( 1ull << graphIdx ) ) ) )
+                {
+                    continue;
+                }
+
+                status = BindGraphTensors( frameDesc, graph, graph.inputs.data(),
+                                           graph.outputs.data() );
+                if ( QC_STATUS_OK == status )
+                {
+                    retVal = m_qnnFunctionPointers.qnnInterface.graphExecute(
+                            graph.pGraphInfo->graph, graph.inputs.data(), graph.inputs.size(),
+                            graph.outputs.data(), graph.outputs.size(), m_profileBackendHandle,
+                            nullptr );
+                    if ( QNN_GRAPH_NO_ERROR != retVal )
+                    {
+                        QC_ERROR( "QNN failed %" PRIu64, retVal );
+                        status = QC_STATUS_FAIL;
+                    }
+                    else if ( true == bProfiled )
+                    {
+                        Qnn_Perf_t perf;
+                        bProfiled = ( QC_STATUS_OK == CollectPerf( m_profileBackendHandle, perf ) );
+                        execTimeUs += perf.entireExecTime;
+                    }
+                    else
+                    {
+                        /* OK */
+                    }
+                }
+
+                if ( QC_STATUS_OK != status )
+                {
+                    break;
+                }
+            }
         }
-        else
+        if ( ( QC_STATUS_OK == status ) && ( 0 < m_config.targetLatency ) )
+        {
+            GovernPerf( bProfiled ? execTimeUs : ( GetTimeUs() - beginUs ) );
+        }
+        QC_TRACE_END( "Execute", {} );
+    }
+    else if ( QC_STATUS_OK == status )
+    {
+        std::lock_guard<std::mutex> l( m_notifyLock );
+        pNotifyParam = m_notifyParamQ.Pop();
+        if ( nullptr != pNotifyParam )
         {
-            pNotifyParam = m_notifyParamQ.Pop();
-            if ( nullptr != pNotifyParam )
+            pNotifyParam->pSelf = this;
+            pNotifyParam->pFrameDesc = &frameDesc;
+            pNotifyParam->activeGraphMask = m_activeGraphMask;
+            pNotifyParam->stage = 0;
+            pNotifyParam->numRunning = 0;
+            pNotifyParam->notifyStatus.error = QNN_SUCCESS;
+            pNotifyParam->submitTimeUs = GetTimeUs();
+            status = SubmitStages( *pNotifyParam, 0 );
+            if ( 0 == pNotifyParam->numRunning )
             {
-                pNotifyParam->pSelf = this;
-                pNotifyParam->pFrameDesc = &frameDesc;
-                retVal = m_qnnFunctionPointers.qnnInterface.graphExecuteAsync(
-                        hGraph, m_inputs.data(), m_inputs.size(), m_outputs.data(),
-                        m_outputs.size(), m_profileBackendHandle, nullptr, QnnNotifyFn,
-                        pNotifyParam );
+                m_notifyParamQ.Push( pNotifyParam );
+            }
+            else if ( QC_STATUS_OK != status )
+            {
+                /* the running graphs will report the frame with this error */
+                pNotifyParam->notifyStatus.error = QNN_COMMON_ERROR_GENERAL;
+                status = QC_STATUS_OK;
             }
             else
             {
-                QC_ERROR( "notifyParamQ is empty!" );
-                retVal = QNN_GRAPH_ERROR_MEM_ALLOC;
+                /* OK */
             }
         }
-        if ( QNN_GRAPH_NO_ERROR != retVal )
+        else
         {
-            QC_ERROR( "QNN failed %" PRIu64, retVal );
+            QC_ERROR( "%u frames in flight, notifyParamQ is empty!", m_config.inFlightDepth );
             status = QC_STATUS_FAIL;
         }
     }
+    else
+    {
+        /* error already reported */
+    }
 
     return status;
 }
@@ -2164,7 +3260,37 @@ QCStatus_e QnnImpl::Stop()
     {
         if ( m_config.bDeRegisterAllBuffersWhenStop )
         {
+            JoinRegisterThread();
+            std::vector<TensorDescriptor_t> tensors;
+            if ( true == m_config.bReRegisterBuffersWhenStart )
+            {
+                std::lock_guard<std::mutex> l( m_lock );
+                for ( auto &kv : m_dmaMemInfoMap )
+                {
+                    tensors.push_back( kv.second.tensorDesc );
+                }
+            }
             status = DeRegisterAllBuffers();
+            if ( false == tensors.empty() )
+            {
+                /* kept warm, registered again by the next Start */
+                std::lock_guard<std::mutex> l( m_registerLock );
+                m_pendingRegisters.insert( m_pendingRegisters.end(), tensors.begin(),
+                                           tensors.end() );
+            }
+        }
+        if ( 0 < m_config.targetLatency )
+        {
+            /* an idle node votes for the lowest profile, the other nodes of the core may still
+             * hold it higher, and the next Start governs again from the initial profile */
+            std::lock_guard<std::mutex> l( m_governorLock );
+            if ( QNN_PERF_PROFILE_DEFAULT != m_governorProfile )
+            {
+                (void) VotePerfProfile( m_config.minPerfProfile );
+                m_governorProfile = m_governorStartProfile;
+            }
+            m_governorLatencySum = 0;
+            m_governorFrames = 0;
         }
         m_state = QC_OBJECT_STATE_READY;
     }
@@ -2278,13 +3404,42 @@ QCStatus_e QnnImpl::ExtractProfilingEvent( QnnProfile_EventId_t profileEventId,
     return status;
 }
 
-QCStatus_e QnnImpl::GetPerf( Qnn_Perf_t &perf )
+QCStatus_e QnnImpl::CollectPerf( Qnn_ProfileHandle_t profileHandle, Qnn_Perf_t &perf )
 {
     bool bPerfDataValid = false;
     QCStatus_e status = QC_STATUS_OK;
-    Qnn_ErrorHandle_t retVal;
-    const QnnProfile_EventId_t *profileEvents{ nullptr };
-    uint32_t numEvents{ 0 };
+    Qnn_ErrorHandle_t retVal;
+    const QnnProfile_EventId_t *profileEvents{ nullptr };
+    uint32_t numEvents{ 0 };
+
+    (void) memset( &perf, 0, sizeof( perf ) );
+    retVal = m_qnnFunctionPointers.qnnInterface.profileGetEvents( profileHandle, &profileEvents,
+                                                                  &numEvents );
+    if ( QNN_PROFILE_NO_ERROR != retVal )
+    {
+        QC_ERROR( "Failure in profile get events." );
+        status = QC_STATUS_FAIL;
+    }
+    else
+    {
+        QC_DEBUG( "ProfileEvents: numEvents: [%u]", numEvents );
+        for ( uint32_t event = 0; event < numEvents; event++ )
+        {
+            (void) ExtractProfilingEvent( profileEvents[event], perf, bPerfDataValid );
+        }
+
+        if ( false == bPerfDataValid )
+        {
+            status = QC_STATUS_OUT_OF_BOUND;
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::GetPerf( Qnn_Perf_t &perf )
+{
+    QCStatus_e status = QC_STATUS_OK;
 
     if ( QC_OBJECT_STATE_RUNNING != m_state )
     {
@@ -2298,33 +3453,32 @@ QCStatus_e QnnImpl::GetPerf( Qnn_Perf_t &perf )
     }
     else
     {
-        (void) memset( &perf, 0, sizeof( perf ) );
-        retVal = m_qnnFunctionPointers.qnnInterface.profileGetEvents( m_profileBackendHandle,
-                                                                      &profileEvents, &numEvents );
-        if ( QNN_PROFILE_NO_ERROR != retVal )
-        {
-            QC_ERROR( "Failure in profile get events." );
-            status = QC_STATUS_FAIL;
-        }
-        else
+        status = CollectPerf( m_profileBackendHandle, perf );
+        if ( QC_STATUS_OUT_OF_BOUND == status )
         {
-            QC_DEBUG( "ProfileEvents: numEvents: [%u]", numEvents );
-            for ( uint32_t event = 0; event < numEvents; event++ )
-            {
-                (void) ExtractProfilingEvent( profileEvents[event], perf, bPerfDataValid );
-            }
-
-            if ( false == bPerfDataValid )
-            {
-                QC_ERROR( "no valid perf data!" );
-                status = QC_STATUS_OUT_OF_BOUND;
-            }
+            QC_ERROR( "no valid perf data!" );
         }
     }
 
     return status;
 }
 
+QCStatus_e QnnImpl::GetPerfBaselines( std::vector<Qnn_PerfBaseline_t> &baselines )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::lock_guard<std::mutex> l( m_baselineLock );
+
+    if ( m_perfBaselines.empty() )
+    {
+        status = QC_STATUS_OUT_OF_BOUND;
+    }
+    else
+    {
+        baselines = m_perfBaselines;
+    }
+
+    return status;
+}
 
 QCStatus_e QnnImpl::DisablePerf()
 {
@@ -2360,6 +3514,10 @@ QCStatus_e QnnImpl::DisablePerf()
 
 void QnnImpl::RemoteDeRegisterBuf( void *pData, size_t size )
 {
+#if defined( QNN_DISABLE_FASTRPC )
+    (void) pData;
+    (void) size;
+#else
 #ifdef QC_USE_REMOTE_REGISTER_V2
     constexpr int client = 0;   // NOTE: default is 0
     int domain = CDSP_DOMAIN_ID;
@@ -2393,6 +3551,7 @@ void QnnImpl::RemoteDeRegisterBuf( void *pData, size_t size )
         /* buffer is possbile that remote_register_buf by others */
         QC_INFO( "Can't find buffer %p(%" PRIu64 ") in dma ref map", pData, size );
     }
+#endif
 }
 
 QCStatus_e QnnImpl::DeRegisterAllBuffers()
@@ -2419,11 +3578,25 @@ QCStatus_e QnnImpl::DeRegisterAllBuffers()
 
         if ( true == bIsHtp )
         {
-            RemoteDeRegisterBuf( pData, info.size );
+            /* the remote registration is of the whole buffer, not of the view */
+            RemoteDeRegisterBuf( info.tensorDesc.pBuf, info.size );
         }
     }
     m_dmaMemInfoMap.clear();
 
+    /* the memory handles of the cached bindings are no longer valid */
+    for ( auto &graph : m_graphExecs )
+    {
+        for ( auto &bindings : graph.inputBindings )
+        {
+            bindings.clear();
+        }
+        for ( auto &bindings : graph.outputBindings )
+        {
+            bindings.clear();
+        }
+    }
+
     return status;
 }
 
@@ -2432,7 +3605,18 @@ QCStatus_e QnnImpl::Destroy()
     QCStatus_e status = QC_STATUS_OK;
     Qnn_ErrorHandle_t retVal = QNN_SUCCESS;
 
+    JoinRegisterThread();
+    {
+        std::lock_guard<std::mutex> l( m_registerLock );
+        m_pendingRegisters.clear();
+        m_registerStatus = QC_STATUS_OK;
+    }
     status = DeRegisterAllBuffers();
+    FreeScratchTensors();
+    {
+        std::lock_guard<std::mutex> l( m_baselineLock );
+        m_perfBaselines.clear();
+    }
 
     if ( nullptr != m_profileBackendHandle )
     {
@@ -2456,8 +3640,21 @@ QCStatus_e QnnImpl::Destroy()
         m_context = nullptr;
     }
 
+    if ( nullptr != m_pMappedBinary )
+    {
+        UnmapBinaryFile( m_pMappedBinary );
+        m_pMappedBinary = nullptr;
+    }
+
     if ( nullptr != m_perfInfra )
     {
+        {
+            std::lock_guard<std::mutex> l( m_governorLock );
+            m_governorProfile = QNN_PERF_PROFILE_DEFAULT;
+            m_governorStartProfile = QNN_PERF_PROFILE_DEFAULT;
+        }
+        /* the other nodes on the cores must not keep the profile voted by this node */
+        WithdrawPerfVote();
         for ( uint32_t &powerConfigId : m_powerConfigIds )
         {
             retVal = m_perfInfra->destroyPowerConfigId( powerConfigId );
@@ -2467,6 +3664,7 @@ QCStatus_e QnnImpl::Destroy()
                 status = QC_STATUS_FAIL;
             }
         }
+        m_powerConfigIds.clear();
         m_perfInfra = nullptr;
     }
 
@@ -2525,6 +3723,10 @@ QCStatus_e QnnImpl::Destroy()
         m_logHandle = nullptr;
     }
 
+    m_graphExecs.clear();
+    m_nodeTensors.clear();
+    m_numStages = 0;
+
     if ( m_bLoadFromCachedBinary && ( nullptr != m_graphsInfo ) )
     {
         QC_DEBUG( "Cleaning up graph Info structures." );
@@ -2555,6 +3757,7 @@ QCStatus_e QnnImpl::Destroy()
         m_backendLibraryHandle = nullptr;
     }
 
+    m_bMemRegisterSupported = true;
     m_state = QC_OBJECT_STATE_INITIAL;
 
     return status;
@@ -2596,12 +3799,73 @@ void QnnImpl::QnnNotifyFn( void *pNotifyParam, Qnn_NotifyStatus_t notifyStatus )
 
 void QnnImpl::QnnNotifyFn( NotifyParam_t &notifyParam, Qnn_NotifyStatus_t notifyStatus )
 {
-    if ( QNN_SUCCESS == notifyStatus.error )
+    bool bDone = true;
+    QCFrameDescriptorNodeIfs *pFrameDesc = nullptr;
+    uint64_t latencyUs = 0;
+
+    {
+        std::lock_guard<std::mutex> l( m_notifyLock );
+        pFrameDesc = notifyParam.pFrameDesc;
+        if ( QNN_SUCCESS != notifyStatus.error )
+        {
+            notifyParam.notifyStatus = notifyStatus;
+        }
+        if ( notifyParam.numRunning > 0 )
+        {
+            notifyParam.numRunning--;
+        }
+        if ( 0 == notifyParam.numRunning )
+        {
+            if ( ( QNN_SUCCESS == notifyParam.notifyStatus.error ) &&
+                 ( notifyParam.stage < m_numStages ) )
+            {
+                QCStatus_e status = SubmitStages( notifyParam, notifyParam.stage + 1 );
+                if ( QC_STATUS_OK != status )
+                {
+                    notifyParam.notifyStatus.error = QNN_COMMON_ERROR_GENERAL;
+                }
+            }
+            notifyStatus = notifyParam.notifyStatus;
+            bDone = ( 0 == notifyParam.numRunning );
+        }
+        else
+        {
+            bDone = false;
+        }
+
+        if ( bDone )
+        {
+            /* the frames in flight are executed one after another, a frame queued behind the
+             * previous one starts on the device once that one is done, so the governor is fed
+             * the execution time of the frame and not the time it waited in the queue */
+            uint64_t doneUs = GetTimeUs();
+            uint64_t startUs = std::max( notifyParam.submitTimeUs, m_lastFrameDoneUs );
+            latencyUs = doneUs - startUs;
+            m_lastFrameDoneUs = doneUs;
+            if ( ( 0 < m_config.targetLatency ) && ( nullptr != m_profileBackendHandle ) )
+            {
+                /* the execution time profiled by the backend for the last graph done, which
+                 * ends the frame */
+                Qnn_Perf_t perf;
+                if ( QC_STATUS_OK == CollectPerf( m_profileBackendHandle, perf ) )
+                {
+                    latencyUs = perf.entireExecTime;
+                }
+            }
+            /* release the slot before the callback, which may submit the next frame */
+            m_notifyParamQ.Push( &notifyParam );
+        }
+    }
+
+    if ( false == bDone )
+    {
+        /* wait for the other graphs of the frame */
+    }
+    else if ( QNN_SUCCESS == notifyStatus.error )
     {
         if ( m_callback != nullptr )
         {
             QC_TRACE_END( "Execute", {} );
-            QCFrameDescriptorNodeIfs *pFrameDesc = notifyParam.pFrameDesc;
             QCNodeEventInfo_t info( *pFrameDesc, m_nodeId, QC_STATUS_OK, GetState() );
             m_callback( info );
         }
@@ -2609,12 +3873,15 @@ void QnnImpl::QnnNotifyFn( NotifyParam_t &notifyParam, Qnn_NotifyStatus_t notify
         {
             QC_ERROR( "output callback is nullptr!" );
         }
+        if ( 0 < m_config.targetLatency )
+        {
+            GovernPerf( latencyUs );
+        }
     }
     else
     {
         if ( m_callback != nullptr )
         {
-            QCFrameDescriptorNodeIfs *pFrameDesc = notifyParam.pFrameDesc;
             QCBufferDescriptorBase_t errDesc;
             uint32_t globalBufferId =
                     m_config.globalBufferIdMap[static_cast<size_t>( m_inputTensorNum +
@@ -2639,69 +3906,198 @@ void QnnImpl::QnnNotifyFn( NotifyParam_t &notifyParam, Qnn_NotifyStatus_t notify
             QC_ERROR( "error callback is nullptr!" );
         }
     }
-
-    m_notifyParamQ.Push( &notifyParam );
 }
 
 
+QCStatus_e QnnImpl::SetupGraphs()
+{
+    QCStatus_e status = QC_STATUS_OK;
+    std::vector<uint32_t> graphIds;
+    std::map<std::string, uint32_t> tensorIdMap;
+    std::map<std::string, uint32_t> producerMap;
+    std::vector<const Qnn_Tensor_t *> inputTensors;
+    std::vector<const Qnn_Tensor_t *> outputTensors;
+    size_t numGraphTensors = 0;
+
+    m_graphExecs.clear();
+    m_nodeTensors.clear();
+    m_numStages = 0;
+    m_activeGraphMask = 0;
+
+    if ( 0 == m_config.graphs.size() )
+    {
+        graphIds.push_back( 0 );
+    }
+    else if ( m_config.graphs.size() > QNN_GRAPH_MAX )
+    {
+        QC_ERROR( "too many graphs: %" PRIu64 " > %u", (uint64_t) m_config.graphs.size(),
+                  QNN_GRAPH_MAX );
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        for ( const std::string &graphName : m_config.graphs )
+        {
+            uint32_t graphIdx = 0;
+            for ( ; graphIdx < m_graphsCount; graphIdx++ )
+            {
+                if ( graphName == m_graphsInfo[graphIdx]->graphName )
+                {
+                    break;
+                }
+            }
+            if ( graphIdx >= m_graphsCount )
+            {
+                QC_ERROR( "graph %s not found in the model", graphName.c_str() );
+                status = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else if ( graphIds.end() != std::find( graphIds.begin(), graphIds.end(), graphIdx ) )
+            {
+                QC_ERROR( "graph %s configured more than once", graphName.c_str() );
+                status = QC_STATUS_BAD_ARGUMENTS;
+            }
+            else
+            {
+                graphIds.push_back( graphIdx );
+            }
+
+            if ( QC_STATUS_OK != status )
+            {
+                break;
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        std::map<std::string, uint32_t> inputMap;
+        m_graphExecs.resize( graphIds.size() );
+        for ( uint32_t execIdx = 0; execIdx < graphIds.size(); execIdx++ )
+        {
+            GraphExec_t &graph = m_graphExecs[execIdx];
+            graph.pGraphInfo = m_graphsInfo[graphIds[execIdx]];
+            graph.stage = m_config.bParallelGraphs ? 0 : execIdx;
+            graph.producerMask = 0;
+            graph.inputs.assign( graph.pGraphInfo->inputTensors,
+                                 graph.pGraphInfo->inputTensors +
+                                         graph.pGraphInfo->numInputTensors );
+            graph.outputs.assign( graph.pGraphInfo->outputTensors,
+                                  graph.pGraphInfo->outputTensors +
+                                          graph.pGraphInfo->numOutputTensors );
+            graph.inputBindings.resize( graph.inputs.size() );
+            graph.outputBindings.resize( graph.outputs.size() );
+
+            /* an input produced by a previous graph is chained to that output, so it stays in
+             * the same registered buffer and runs after its producer */
+            for ( uint32_t i = 0; i < graph.pGraphInfo->numInputTensors; i++ )
+            {
+                const Qnn_Tensor_t &tensor = graph.pGraphInfo->inputTensors[i];
+                std::string name( QNN_TENSOR_GET_NAME( &tensor ) );
+                auto it = producerMap.find( name );
+                if ( it != producerMap.end() )
+                {
+                    uint32_t stage = m_graphExecs[it->second].stage + 1;
+                    graph.stage = std::max( graph.stage, stage );
+                    graph.producerMask |= 1ull << it->second;
+                }
+                else if ( inputMap.end() == inputMap.find( name ) )
+                {
+                    inputMap[name] = static_cast<uint32_t>( inputTensors.size() );
+                    inputTensors.push_back( &tensor );
+                }
+                else
+                {
+                    /* shared by several graphs */
+                }
+            }
+
+            for ( uint32_t i = 0; i < graph.pGraphInfo->numOutputTensors; i++ )
+            {
+                const Qnn_Tensor_t &tensor = graph.pGraphInfo->outputTensors[i];
+                std::string name( QNN_TENSOR_GET_NAME( &tensor ) );
+                if ( ( producerMap.end() != producerMap.find( name ) ) ||
+                     ( inputMap.end() != inputMap.find( name ) ) )
+                {
+                    QC_ERROR( "graph %s output %s is an input or output of a previous graph",
+                              graph.pGraphInfo->graphName, name.c_str() );
+                    status = QC_STATUS_BAD_ARGUMENTS;
+                    break;
+                }
+                producerMap[name] = execIdx;
+                outputTensors.push_back( &tensor );
+            }
+
+            if ( QC_STATUS_OK != status )
+            {
+                break;
+            }
+            m_numStages = std::max( m_numStages, graph.stage + 1 );
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        m_nodeTensors = inputTensors;
+        m_nodeTensors.insert( m_nodeTensors.end(), outputTensors.begin(), outputTensors.end() );
+        for ( uint32_t tensorId = 0; tensorId < m_nodeTensors.size(); tensorId++ )
+        {
+            tensorIdMap[QNN_TENSOR_GET_NAME( m_nodeTensors[tensorId] )] = tensorId;
+        }
+
+        for ( uint32_t execIdx = 0; execIdx < m_graphExecs.size(); execIdx++ )
+        {
+            GraphExec_t &graph = m_graphExecs[execIdx];
+            graph.inputIds.clear();
+            graph.outputIds.clear();
+            graph.tensorBase = numGraphTensors;
+            numGraphTensors += graph.inputs.size() + graph.outputs.size();
+            for ( Qnn_Tensor_t &tensor : graph.inputs )
+            {
+                graph.inputIds.push_back( tensorIdMap[QNN_TENSOR_GET_NAME( &tensor )] );
+            }
+            for ( Qnn_Tensor_t &tensor : graph.outputs )
+            {
+                graph.outputIds.push_back( tensorIdMap[QNN_TENSOR_GET_NAME( &tensor )] );
+            }
+            m_activeGraphMask |= 1ull << execIdx;
+            QC_INFO( "graph %s: stage %u, %u inputs, %u outputs", graph.pGraphInfo->graphName,
+                     graph.stage, (uint32_t) graph.inputs.size(),
+                     (uint32_t) graph.outputs.size() );
+        }
+
+        m_inputTensorNum = static_cast<uint32_t>( inputTensors.size() );
+        m_outputTensorNum = static_cast<uint32_t>( outputTensors.size() );
+    }
+
+    return status;
+}
+
 QCStatus_e QnnImpl::SetupGlobalBufferIdMap()
 {
     QCStatus_e status = QC_STATUS_OK;
 
-    m_inputTensorNum = m_graphsInfo[0]->numInputTensors;
-    m_outputTensorNum = m_graphsInfo[0]->numOutputTensors;
     m_bufferDescNum = m_inputTensorNum + m_outputTensorNum + 1;
-    m_inputs.resize( m_inputTensorNum );
-    m_outputs.resize( m_outputTensorNum );
     if ( m_config.globalBufferIdMap.size() > 0 )
     {
         if ( m_bufferDescNum == m_config.globalBufferIdMap.size() )
         {
-            uint32_t globalBufferId = 0;
-            for ( uint32_t i = 0; i < m_inputTensorNum; i++ )
+            for ( uint32_t tensorId = 0; tensorId < m_nodeTensors.size(); tensorId++ )
             {
-                Qnn_Tensor_t *pTensor = &m_graphsInfo[0]->inputTensors[i];
-                std::string name( QNN_TENSOR_GET_NAME( pTensor ) );
-                m_inputs[i] = *pTensor;
-                if ( m_config.globalBufferIdMap[globalBufferId].name != name )
+                std::string name( QNN_TENSOR_GET_NAME( m_nodeTensors[tensorId] ) );
+                if ( m_config.globalBufferIdMap[tensorId].name != name )
                 {
-                    QC_ERROR( "global buffer map[%" PRIu32 "] name %s != %s", globalBufferId,
-                              m_config.globalBufferIdMap[globalBufferId].name.c_str(),
-                              name.c_str() );
+                    QC_ERROR( "global buffer map[%" PRIu32 "] name %s != %s", tensorId,
+                              m_config.globalBufferIdMap[tensorId].name.c_str(), name.c_str() );
                     status = QC_STATUS_BAD_ARGUMENTS;
-                }
-                if ( QC_STATUS_OK != status )
-                {
                     break;
                 }
                 /* In scenarios where the same FrameDescriptor is passed through all nodes,
                  * the actual size of the buffer descriptor exceeds the total number of QNN
                  * inputs and outputs. */
-                if ( m_config.globalBufferIdMap[globalBufferId].globalBufferId > m_bufferDescNum )
-                {
-                    m_bufferDescNum = m_config.globalBufferIdMap[globalBufferId].globalBufferId + 1;
-                }
-                globalBufferId++;
-            }
-            if ( QC_STATUS_OK == status )
-            {
-                for ( uint32_t i = 0; i < m_outputTensorNum; i++ )
+                if ( ( tensorId < m_inputTensorNum ) &&
+                     ( m_config.globalBufferIdMap[tensorId].globalBufferId > m_bufferDescNum ) )
                 {
-                    Qnn_Tensor_t *pTensor = &m_graphsInfo[0]->outputTensors[i];
-                    std::string name( QNN_TENSOR_GET_NAME( pTensor ) );
-                    m_outputs[i] = *pTensor;
-                    if ( m_config.globalBufferIdMap[globalBufferId].name != name )
-                    {
-                        QC_ERROR( "global buffer map[%" PRIu32 "] name %s != %s", globalBufferId,
-                                  m_config.globalBufferIdMap[globalBufferId].name.c_str(),
-                                  name.c_str() );
-                        status = QC_STATUS_BAD_ARGUMENTS;
-                    }
-                    if ( QC_STATUS_OK != status )
-                    {
-                        break;
-                    }
-                    globalBufferId++;
+                    m_bufferDescNum = m_config.globalBufferIdMap[tensorId].globalBufferId + 1;
                 }
             }
         }
@@ -2715,27 +4111,51 @@ QCStatus_e QnnImpl::SetupGlobalBufferIdMap()
     { /* create a default global buffer index map */
         m_config.globalBufferIdMap.resize( m_bufferDescNum );
         uint32_t globalBufferId = 0;
-        for ( uint32_t i = 0; i < m_inputTensorNum; i++ )
-        {
-            Qnn_Tensor_t *pTensor = &m_graphsInfo[0]->inputTensors[i];
-            m_inputs[i] = *pTensor;
-            m_config.globalBufferIdMap[globalBufferId].name = QNN_TENSOR_GET_NAME( pTensor );
-            m_config.globalBufferIdMap[globalBufferId].globalBufferId = globalBufferId;
-            globalBufferId++;
-        }
-        for ( uint32_t i = 0; i < m_outputTensorNum; i++ )
+        for ( ; globalBufferId < m_nodeTensors.size(); globalBufferId++ )
         {
-            Qnn_Tensor_t *pTensor = &m_graphsInfo[0]->outputTensors[i];
-            m_outputs[i] = *pTensor;
-            m_config.globalBufferIdMap[globalBufferId].name = QNN_TENSOR_GET_NAME( pTensor );
+            m_config.globalBufferIdMap[globalBufferId].name =
+                    QNN_TENSOR_GET_NAME( m_nodeTensors[globalBufferId] );
             m_config.globalBufferIdMap[globalBufferId].globalBufferId = globalBufferId;
-            globalBufferId++;
         }
 
         m_config.globalBufferIdMap[globalBufferId].name = "QNN ASYNC ERROR";
         m_config.globalBufferIdMap[globalBufferId].globalBufferId = globalBufferId;
     }
 
+    m_batchSliceIds.assign( m_nodeTensors.size(), std::vector<uint32_t>() );
+    for ( size_t i = 0; ( i < m_config.batchSlices.size() ) && ( QC_STATUS_OK == status ); i++ )
+    {
+        Qnn_BatchSlices_t &slices = m_config.batchSlices[i];
+        uint32_t tensorId = 0;
+        for ( ; tensorId < m_nodeTensors.size(); tensorId++ )
+        {
+            if ( slices.name == QNN_TENSOR_GET_NAME( m_nodeTensors[tensorId] ) )
+            {
+                break;
+            }
+        }
+
+        if ( tensorId >= m_nodeTensors.size() )
+        {
+            QC_ERROR( "batch slices of an unknown tensor %s", slices.name.c_str() );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else if ( ( 0 == QNN_TENSOR_GET_RANK( m_nodeTensors[tensorId] ) ) ||
+                  ( slices.globalBufferIds.empty() ) ||
+                  ( slices.globalBufferIds.size() >
+                    QNN_TENSOR_GET_DIMENSIONS( m_nodeTensors[tensorId] )[0] ) )
+        {
+            QC_ERROR( "tensor %s can not be bound from %" PRIu64 " batch slices",
+                      slices.name.c_str(), (uint64_t) slices.globalBufferIds.size() );
+            status = QC_STATUS_BAD_ARGUMENTS;
+        }
+        else
+        {
+            m_batchSliceIds[tensorId] = slices.globalBufferIds;
+            m_config.globalBufferIdMap[tensorId].globalBufferId = slices.globalBufferIds[0];
+        }
+    }
+
     return status;
 }
 
@@ -2754,8 +4174,7 @@ QCStatus_e QnnImpl::GetInputTensors( std::vector<Qnn_Tensor_t> &inputTensors )
         inputTensors.resize( m_inputTensorNum );
         for ( uint32_t i = 0; i < m_inputTensorNum; ++i )
         {
-            QCTensorProps_t tensorProp;
-            inputTensors[i] = m_graphsInfo[0]->inputTensors[i];
+            inputTensors[i] = *m_nodeTensors[i];
         }
     }
 
@@ -2778,11 +4197,106 @@ QCStatus_e QnnImpl::GetOutputTensors( std::vector<Qnn_Tensor_t> &outputTensors )
         outputTensors.resize( m_outputTensorNum );
         for ( uint32_t i = 0; i < m_outputTensorNum; ++i )
         {
-            QCTensorProps_t tensorProp;
-            outputTensors[i] = m_graphsInfo[0]->outputTensors[i];
+            outputTensors[i] = *m_nodeTensors[m_inputTensorNum + i];
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::GetGraphNames( std::vector<std::string> &graphNames )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( ( QC_OBJECT_STATE_READY != m_state ) && ( QC_OBJECT_STATE_RUNNING != m_state ) )
+    {
+        QC_ERROR( "QNN Node not in ready or running status!" );
+        status = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        graphNames.clear();
+        for ( uint32_t graphIdx = 0; graphIdx < m_graphsCount; graphIdx++ )
+        {
+            graphNames.push_back( m_graphsInfo[graphIdx]->graphName );
+        }
+    }
+
+    return status;
+}
+
+QCStatus_e QnnImpl::SetActiveGraphs( const std::vector<std::string> &graphNames )
+{
+    QCStatus_e status = QC_STATUS_OK;
+    uint64_t activeGraphMask = 0;
+
+    if ( ( QC_OBJECT_STATE_READY != m_state ) && ( QC_OBJECT_STATE_RUNNING != m_state ) )
+    {
+        QC_ERROR( "QNN Node not in ready or running status!" );
+        status = QC_STATUS_BAD_STATE;
+    }
+    else if ( 0 == graphNames.size() )
+    {
+        for ( uint32_t execIdx = 0; execIdx < m_graphExecs.size(); execIdx++ )
+        {
+            activeGraphMask |= 1ull << execIdx;
+        }
+    }
+    else
+    {
+        for ( const std::string &graphName : graphNames )
+        {
+            uint32_t execIdx = 0;
+            for ( ; execIdx < m_graphExecs.size(); execIdx++ )
+            {
+                if ( graphName == m_graphExecs[execIdx].pGraphInfo->graphName )
+                {
+                    activeGraphMask |= 1ull << execIdx;
+                    break;
+                }
+            }
+            if ( execIdx >= m_graphExecs.size() )
+            {
+                QC_ERROR( "graph %s is not configured", graphName.c_str() );
+                status = QC_STATUS_BAD_ARGUMENTS;
+                break;
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == status )
+    {
+        /* a consumer graph reads its chained inputs from the buffers of its producer graphs, so
+         * it can not run while any of them is disabled */
+        for ( uint32_t execIdx = 0; ( execIdx < m_graphExecs.size() ) && ( QC_STATUS_OK == status );
+              execIdx++ )
+        {
+            const GraphExec_t &graph = m_graphExecs[execIdx];
+            if ( 0 != ( activeGraphMask & ( 1ull << execIdx ) ) )
+            {
+                for ( uint32_t producerIdx = 0; producerIdx < execIdx; producerIdx++ )
+                {
+                    uint64_t producerBit = 1ull << producerIdx;
+                    if ( ( 0 != ( graph.producerMask & producerBit ) ) &&
+                         ( 0 == ( activeGraphMask & producerBit ) ) )
+                    {
+                        QC_ERROR( "graph %s is active but its producer graph %s is not",
+                                  graph.pGraphInfo->graphName,
+                                  m_graphExecs[producerIdx].pGraphInfo->graphName );
+                        status = QC_STATUS_BAD_ARGUMENTS;
+                        break;
+                    }
+                }
+            }
         }
     }
 
+    if ( QC_STATUS_OK == status )
+    {
+        std::lock_guard<std::mutex> l( m_notifyLock );
+        m_activeGraphMask = activeGraphMask;
+    }
+
     return status;
 }
 
@@ -2946,7 +4460,7 @@ Qnn_DataType_t QnnImpl::SwitchToQnnDataType( QCTensorType_e tensorType )
     return dataType;
 }
 
-void QnnImpl::NotifyParamQueue::Init()
+void QnnImpl::NotifyParamQueue::Init( uint32_t depth )
 {
     uint16_t idx;
     pushIdx = 0;
@@ -2955,8 +4469,12 @@ void QnnImpl::NotifyParamQueue::Init()
     for ( idx = 0; idx < QNN_NOTIFY_PARAM_NUM; idx++ )
     {
         notifyParam[idx].magic = QNN_NOTIFY_MAGIC;
-        ring[pushIdx % QNN_NOTIFY_PARAM_NUM] = idx;
-        pushIdx++;
+        if ( idx < depth )
+        {
+            /* only depth frames can be in flight */
+            ring[pushIdx % QNN_NOTIFY_PARAM_NUM] = idx;
+            pushIdx++;
+        }
     }
 }
 
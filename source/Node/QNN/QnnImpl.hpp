@@ -12,9 +12,15 @@
 #include "QnnInterface.h"
 #include "QnnWrapperUtils.hpp"
 #include "System/QnnSystemInterface.h"
+#include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <string>
+#include <sys/types.h>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace QC
@@ -30,6 +36,28 @@ using namespace QC::Memory;
 
 #define QNN_NOTIFY_MAGIC ( 0x464900544F4E4E51ull )
 
+/* the max number of graphs a QNN node executes, one bit each in the active graph mask */
+#define QNN_GRAPH_MAX 64u
+
+#ifndef QNN_BINDING_CACHE_SIZE
+/* the max number of buffers cached for a graph tensor, the cache is reset when exceeded */
+#define QNN_BINDING_CACHE_SIZE 64u
+#endif
+
+#ifndef QNN_GOVERNOR_HYSTERESIS
+/* the governor steps the perf profile down only when the average latency is this percent below
+ * the target latency, so that it does not oscillate between two profiles */
+#define QNN_GOVERNOR_HYSTERESIS 25u
+#endif
+
+#ifndef QNN_GOVERNOR_WINDOW_MAX
+#define QNN_GOVERNOR_WINDOW_MAX 1024u
+#endif
+
+#ifndef QNN_WARMUP_FRAMES_MAX
+#define QNN_WARMUP_FRAMES_MAX 100u
+#endif
+
 #ifndef QNNIMPL_FRIEND_CLASS
 #define QNNIMPL_FRIEND_CLASS()
 #endif
@@ -79,6 +107,22 @@ typedef struct
     std::string udoLibPath;
 } Qnn_UdoPackage_t;
 
+/**
+ * @brief The per-batch slices of a batched model tensor.
+ *
+ * The slices are tensor views of one buffer at consecutive offsets, such as the per-camera outputs
+ * of a preprocessing node written into a shared batched buffer. They are bound together as the
+ * batched tensor, so no copy is needed to assemble a batched input or to split a batched output.
+ *
+ * @param name             The name of the model tensor.
+ * @param globalBufferIds  The indices of the slices in QCFrameDescriptorNodeIfs, in batch order.
+ */
+typedef struct
+{
+    std::string name;
+    std::vector<uint32_t> globalBufferIds;
+} Qnn_BatchSlices_t;
+
 /**
  * @brief Enumeration of QNN model loading methods.
  *
@@ -140,6 +184,10 @@ typedef enum
  * @note                   This field is optional. If empty, buffers will be registered when
  *                         the ProcessFrameDescriptor API is called.
  *
+ * @param bRegisterBuffersAtStart If true, the buffers of bufferIds are registered in bulk in the
+ *                         background when the node is started, instead of one by one during the
+ *                         initialization stage.
+ *
  * @param globalBufferIdMap Mapping of global buffer indices used to identify which buffers in
  *                          QCFrameDescriptorNodeIfs correspond to QNN inputs and outputs.
  * @note                   This field is optional. If empty, a default mapping is applied:
@@ -149,9 +197,31 @@ typedef enum
  *
  * @param bDeRegisterAllBuffersWhenStop If true, all registered buffers will be deregistered
  *                         when the QNN node's Stop API is called.
+ * @param bReRegisterBuffersWhenStart If true, the buffers deregistered by the Stop API are
+ *                         registered again in bulk in the background by the next Start API, so
+ *                         the first frames after a restart do not pay for the registration.
  *
  * @param perfProfile      Specifies the performance profile to be used.
  *
+ * @param targetLatency    The target frame latency in microseconds. If not 0, the perf profile of
+ *                         the HTP cores is governed by the measured frame latency: it is stepped
+ *                         up when the average latency of a window of frames is over the target,
+ *                         and stepped down when it is well below the target. The latency is the
+ *                         execution time profiled by the backend when the perf is enabled,
+ *                         otherwise the host latency. The perfProfile, if not default, is the
+ *                         initial profile, which each Start governs again from.
+ * @param minPerfProfile   The lowest perf profile the governor may select, also voted when the
+ *                         node is stopped.
+ * @param maxPerfProfile   The highest perf profile the governor may select.
+ * @param governorWindow   The number of frames averaged before the governor decides.
+ * @note                   The nodes on the same HTP core vote for a perf profile, and the highest
+ *                         vote is applied to the core, so that a node does not slow down another.
+ *
+ * @param warmupFrames     The number of dummy executions of each graph by the Start API on
+ *                         scratch tensors owned by the node, so that the first frames do not pay
+ *                         for the graph and cache warm-up. The median latency of them is kept as
+ *                         the latency baseline of the graph. 0 to disable the warm-up.
+ *
  * @param bWeightSharingEnabled This field sets the weight sharing which is by default false.
  *
  * @param bUseExtendedUdma This field enables preparing graphs, associated with this context, with
@@ -159,6 +229,25 @@ typedef enum
  *                      far region of the DSP which is helpful if PD's limited VA space is
  *                      exhausted. Total RAM usage may increase if used together with shared
  *                      weights. Only available for Hexagon arch v81 and above.
+ *
+ * @param graphs           Names of the graphs of the context to execute for each frame, in order.
+ *                         A graph input with the name of an output of a previous graph is chained
+ *                         to that output, so the intermediate tensor is not a node input.
+ * @note                   This field is optional. If empty, only the first graph is executed.
+ *
+ * @param bParallelGraphs  If true, in asynchronous mode the graphs that do not depend on each other
+ *                         are submitted together. Otherwise the graphs are executed one by one.
+ *
+ * @param bStrictValidation If true, every buffer is validated against its tensor on every frame.
+ *                         Otherwise a buffer is validated on its first use only, and the binding
+ *                         is reused as long as the buffer address, size and DMA handle are the
+ *                         same, which suits buffers from fixed pools.
+ *
+ * @param inFlightDepth    The max number of frames in flight in asynchronous mode, each of them
+ *                         has its own set of graph tensors, up to QNN_NOTIFY_PARAM_NUM.
+ *
+ * @param batchSlices      The model tensors bound from per-batch slices instead of one buffer, the
+ *                         global buffer index of such a tensor is the index of its first slice.
  */
 typedef struct QnnImplConfig : public QCNodeConfigBase_t
 {
@@ -170,13 +259,34 @@ typedef struct QnnImplConfig : public QCNodeConfigBase_t
     Qnn_Priority_t priority;
     std::vector<Qnn_UdoPackage_t> udoPackages;
     std::vector<uint32_t> bufferIds;
+    bool bRegisterBuffersAtStart = false;
     std::vector<QCNodeBufferMapEntry_t> globalBufferIdMap;
     bool bDeRegisterAllBuffersWhenStop;
+    bool bReRegisterBuffersWhenStart = false;
     Qnn_PerfProfile_e perfProfile;
     bool bWeightSharingEnabled;
     bool bUseExtendedUdma;
+    std::vector<std::string> graphs;
+    bool bParallelGraphs;
+    bool bStrictValidation;
+    uint32_t inFlightDepth = QNN_NOTIFY_PARAM_NUM;
+    uint32_t targetLatency = 0;
+    Qnn_PerfProfile_e minPerfProfile = QNN_PERF_PROFILE_POWER_SAVER;
+    Qnn_PerfProfile_e maxPerfProfile = QNN_PERF_PROFILE_BURST;
+    uint32_t governorWindow = 16;
+    uint32_t warmupFrames = 0;
+    std::vector<Qnn_BatchSlices_t> batchSlices;
 } QnnImplConfig_t;
 
+/* the latency baseline of a graph, calibrated by the warm-up executions of the Start API */
+typedef struct
+{
+    std::string graphName;
+    uint32_t numFrames; /* the number of warm-up executions */
+    Qnn_Perf_t perf;    /* the profiled times of the median execution, 0 if not profiled */
+    uint64_t wallTime;  /* the median wall clock time of the executions in microseconds */
+} Qnn_PerfBaseline_t;
+
 // TODO
 typedef struct QnnImplMonitorConfig : public QCNodeMonitoringBase_t
 {
@@ -203,6 +313,7 @@ public:
         : m_nodeId( nodeId ),
           m_logger( logger ),
           m_state( QC_OBJECT_STATE_INITIAL ) {};
+    ~QnnImpl() { JoinRegisterThread(); }
     QnnImplConfig_t &GetConfig() { return m_config; }
     QnnImplMonitorConfig_t &GetMonitorConfig() { return m_monitorConfig; }
 
@@ -213,6 +324,31 @@ public:
     QCStatus_e Stop();
     QCStatus_e DeInitialize();
 
+    /**
+     * @brief Registers buffers into QNN ahead of their first frame.
+     *
+     * The buffers not registered yet are registered together by one memRegister call, so that the
+     * frames do not pay for the registration of new buffers, such as those of a buffer pool.
+     *
+     * @param[in] buffers The buffers to register, only the tensor buffers are registered.
+     * @param[in] bAsync If true, the buffers are registered by a background thread and the call
+     * returns immediately, the completion is waited for by WaitBuffersRegistered.
+     * @return QC_STATUS_OK on success; other status codes indicate failure.
+     * @note The memory of the buffers must stay valid until they are registered, the descriptors
+     * are copied.
+     */
+    QCStatus_e
+    RegisterBuffers( std::vector<std::reference_wrapper<QCBufferDescriptorBase>> &buffers,
+                     bool bAsync );
+
+    /**
+     * @brief Waits for the background buffer registration to be done.
+     * @param[in] timeoutMs The max time to wait in milliseconds.
+     * @return QC_STATUS_OK if all the buffers are registered, QC_STATUS_TIMEOUT if the registration
+     * is still going on, or the error of a failed registration since the last wait.
+     */
+    QCStatus_e WaitBuffersRegistered( uint32_t timeoutMs );
+
     /**
      * @brief Enables performance measurement for QNN model execution.
      * @return QC_STATUS_OK on success; other status codes indicate failure.
@@ -232,6 +368,13 @@ public:
      */
     QCStatus_e DisablePerf();
 
+    /**
+     * @brief Retrieves the latency baselines calibrated by the warm-up of the last Start.
+     * @param[out] baselines The baselines of the configured graphs, in execution order.
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if no warm-up was done.
+     */
+    QCStatus_e GetPerfBaselines( std::vector<Qnn_PerfBaseline_t> &baselines );
+
     /**
      * @brief Retrieves the current state of the QNN Node.
      *
@@ -267,6 +410,25 @@ public:
      */
     QCStatus_e GetOutputTensors( std::vector<Qnn_Tensor_t> &outputTensors );
 
+    /**
+     * @brief Retrieves the names of all the graphs of the loaded context.
+     * @param[out] graphNames A reference to a vector that will be filled with the graph names.
+     * @return QC_STATUS_OK if the operation is successful; an appropriate error code otherwise.
+     */
+    QCStatus_e GetGraphNames( std::vector<std::string> &graphNames );
+
+    /**
+     * @brief Selects the graphs executed for the following frames.
+     *
+     * The frames already submitted are not affected. The buffers of the graphs not selected are
+     * not accessed, but the global buffer index map is kept unchanged.
+     *
+     * @param[in] graphNames The names of the graphs to execute, a subset of the configured graphs.
+     * An empty vector selects all the configured graphs.
+     * @return QC_STATUS_OK if the operation is successful; an appropriate error code otherwise.
+     */
+    QCStatus_e SetActiveGraphs( const std::vector<std::string> &graphNames );
+
     /**
      * @brief Converts a QNN-defined data type to a QCNode-defined tensor type.
      *
@@ -289,21 +451,66 @@ public:
      */
     Qnn_DataType_t SwitchToQnnDataType( QCTensorType_e tensorType );
 
+    /**
+     * @brief Gets the level of a perf profile in the steps of the perf governor.
+     * @param[in] perfProfile The perf profile.
+     * @return The level from 0 for the lowest profile, -1 for the default profile.
+     */
+    static int32_t GetPerfLevel( Qnn_PerfProfile_e perfProfile );
+
 private:
     typedef struct
     {
         Qnn_MemHandle_t memHandle;
         size_t size;
         int32_t fd;
+        TensorDescriptor_t tensorDesc; /* the registered view, to register it again */
     } DmaMemInfo_t;
 
+    /* the state of a frame executed asynchronously, the graphs of one stage are running and the
+     * graphs of the next stages are submitted when all of them are done */
     typedef struct
     {
         uint64_t magic;
         QnnImpl *pSelf;
         QCFrameDescriptorNodeIfs *pFrameDesc;
+        uint64_t activeGraphMask;
+        uint32_t stage;
+        uint32_t numRunning;
+        Qnn_NotifyStatus_t notifyStatus;
+        uint64_t submitTimeUs;             /* for the execution time measured by the governor */
+        std::vector<Qnn_Tensor_t> tensors; /* the graph tensors bound for this frame */
     } NotifyParam_t;
 
+    /* a validated binding of a buffer to a graph tensor, keyed by the buffer descriptor */
+    typedef struct
+    {
+        TensorDescriptor_t *pTensor;
+        void *pData;
+        uint64_t dmaHandle;
+        size_t size;
+        Qnn_Tensor_t tensor;
+        float quantScale;
+        int32_t quantOffset;
+    } TensorBinding_t;
+    typedef std::unordered_map<const QCBufferDescriptorBase_t *, TensorBinding_t> BindingCache_t;
+
+    /* a graph executed by the node, the graph tensors are bound to the node tensors by index,
+     * the tensors of an asynchronous frame start at tensorBase of its NotifyParam_t tensors */
+    typedef struct
+    {
+        qnn_wrapper_api::GraphInfo_t *pGraphInfo;
+        uint32_t stage;
+        uint64_t producerMask; /* the graphs producing the chained inputs of this graph */
+        size_t tensorBase;
+        std::vector<uint32_t> inputIds;
+        std::vector<uint32_t> outputIds;
+        std::vector<Qnn_Tensor_t> inputs;
+        std::vector<Qnn_Tensor_t> outputs;
+        std::vector<BindingCache_t> inputBindings;
+        std::vector<BindingCache_t> outputBindings;
+    } GraphExec_t;
+
     typedef struct NotifyParamQueue
     {
         NotifyParam_t notifyParam[QNN_NOTIFY_PARAM_NUM];
@@ -312,11 +519,14 @@ private:
         uint16_t pushIdx;
 
     public:
-        void Init();
+        void Init( uint32_t depth );
         void Push( NotifyParam_t *pNotifyParam );
         NotifyParam_t *Pop();
     } NotifyParamQueue_t;
 
+    /* a HTP core, identified by the hardware device id and core id */
+    typedef std::pair<uint32_t, uint32_t> PerfCoreKey_t;
+
 private:
     static void QnnNotifyFn( void *pNotifyParam, Qnn_NotifyStatus_t notifyStatus );
     void QnnNotifyFn( NotifyParam_t &notifyParam, Qnn_NotifyStatus_t notifyStatus );
@@ -328,14 +538,34 @@ private:
     QCStatus_e CreateFromModelSo( std::string modelFile );
     QCStatus_e CreateFromBinaryBuffer( QCBufferDescriptorBase &bufDesc );
     QCStatus_e CreateFromBinaryFile( std::string modelFile );
+    QCStatus_e MapBinaryFile( const std::string &modelFile, void *&pData, size_t &size );
+    void UnmapBinaryFile( void *pData );
+    QCStatus_e SetupGraphs();
     QCStatus_e SetupGlobalBufferIdMap();
+    QCStatus_e AssembleBatch( QCFrameDescriptorNodeIfs &frameDesc, uint32_t tensorId,
+                              const Qnn_Tensor_t &tensorInfo, TensorDescriptor_t &batchDesc );
+    QCStatus_e BindTensor( QCFrameDescriptorNodeIfs &frameDesc, uint32_t tensorId,
+                           const Qnn_Tensor_t &tensorInfo, BindingCache_t &bindings,
+                           Qnn_Tensor_t &tensor );
+    QCStatus_e BindGraphTensors( QCFrameDescriptorNodeIfs &frameDesc, GraphExec_t &graph,
+                                 Qnn_Tensor_t *pInputs, Qnn_Tensor_t *pOutputs );
+    QCStatus_e SubmitStages( NotifyParam_t &notifyParam, uint32_t stage );
 
     QCStatus_e ExtractProfilingEvent( QnnProfile_EventId_t profileEventId, Qnn_Perf_t &perf,
                                       bool &bPerfDataValid );
+    QCStatus_e CollectPerf( Qnn_ProfileHandle_t profileHandle, Qnn_Perf_t &perf );
+
+    QCStatus_e AllocateScratchTensors();
+    void FreeScratchTensors();
+    QCStatus_e Warmup();
 
     QCStatus_e RemoteRegisterBuf( const TensorDescriptor_t &tensorDesc, int &fd );
     QCStatus_e RegisterBufferToHTP( const TensorDescriptor_t &tensorDesc,
                                     Qnn_MemHandle_t &memHandle );
+    QCStatus_e RegisterBuffersToHTP( const std::vector<const TensorDescriptor_t *> &tensors );
+    QCStatus_e QueueRegistration( std::vector<TensorDescriptor_t> &tensors );
+    void RegisterThreadMain();
+    void JoinRegisterThread();
     QCStatus_e GetMemHandle( const TensorDescriptor_t &tensorDesc, Qnn_MemHandle_t &memHandle );
     QCStatus_e RegisterTensor( const TensorDescriptor_t &tensorDesc );
 
@@ -365,7 +595,14 @@ private:
     void FreeQnnTensors( Qnn_Tensor_t *&tensors, uint32_t numTensors );
     QCStatus_e FreeGraphsInfo( qnn_wrapper_api::GraphInfoPtr_t **graphsInfo, uint32_t numGraphs );
     QCStatus_e SetHtpPerformanceMode();
+    QCStatus_e ApplyHtpPerfProfile( uint32_t powerConfigId, Qnn_PerfProfile_e perfProfile );
     QCStatus_e SetPerformanceMode();
+    QCStatus_e VotePerfProfile( Qnn_PerfProfile_e perfProfile );
+    static QCStatus_e ApplyCoreVotes( const PerfCoreKey_t &core,
+                                      const std::map<QnnImpl *, Qnn_PerfProfile_e> &votes );
+    void WithdrawPerfVote();
+    void GovernPerf( uint64_t latencyUs );
+    static uint64_t GetTimeUs();
     bool IsHtpProcessor();
 
     static void QnnLog_Callback( const char *fmt, QnnLog_Level_t logLevel, uint64_t timestamp,
@@ -386,6 +623,19 @@ private:
     static std::map<void *, int> s_dmaMemRefMap[QNN_PROCESSOR_MAX];
     static std::map<Qnn_ProcessorType_e, std::string> s_Backends;
 
+    /* the read-only mapping of a context binary, shared by all the instances using the same file,
+     * which is identified by the device, inode, size and modification time */
+    typedef struct
+    {
+        void *pData;
+        size_t size;
+        uint32_t refCount;
+    } MappedBinary_t;
+    typedef std::tuple<dev_t, ino_t, off_t, time_t> MappedBinaryKey_t;
+    static std::mutex s_mappedBinaryLock;
+    static std::map<MappedBinaryKey_t, MappedBinary_t> s_mappedBinaryMap;
+    void *m_pMappedBinary = nullptr;
+
     static constexpr size_t CONTEXT_CONFIG_SIZE = 3;
 
     Qnn_BackendHandle_t m_backendHandle = nullptr;
@@ -427,8 +677,47 @@ private:
     std::vector<uint32_t> m_powerConfigIds;
     QnnHtpDevice_PerfInfrastructure_t *m_perfInfra{ nullptr };
 
-    std::vector<Qnn_Tensor_t> m_inputs;
-    std::vector<Qnn_Tensor_t> m_outputs;
+    /* the perf profile votes of the nodes on a HTP core, the highest vote is applied to the power
+     * configs of all the voters of the core */
+    static std::mutex s_perfArbiterLock;
+    static std::map<PerfCoreKey_t, std::map<QnnImpl *, Qnn_PerfProfile_e>> s_perfVotes;
+    std::vector<PerfCoreKey_t> m_perfCores;           /* parallel to m_powerConfigIds */
+    std::vector<Qnn_PerfProfile_e> m_appliedProfiles; /* parallel to m_powerConfigIds */
+
+    /* the latency driven perf governor, enabled by a non zero targetLatency */
+    std::mutex m_governorLock;
+    Qnn_PerfProfile_e m_governorProfile = QNN_PERF_PROFILE_DEFAULT;
+    Qnn_PerfProfile_e m_governorStartProfile = QNN_PERF_PROFILE_DEFAULT;
+    uint64_t m_governorLatencySum = 0;
+    uint32_t m_governorFrames = 0;
+
+    /* the node tensors, the inputs of the graphs followed by the outputs of the graphs */
+    std::vector<const Qnn_Tensor_t *> m_nodeTensors;
+    /* the global buffer indices of the per-batch slices of each node tensor, empty if the tensor
+     * is bound from one buffer */
+    std::vector<std::vector<uint32_t>> m_batchSliceIds;
+    std::vector<GraphExec_t> m_graphExecs;
+    uint32_t m_numStages = 0;
+
+    /* the scratch tensors of the warm-up, one per node tensor, kept until the node is destroyed */
+    std::vector<TensorDescriptor_t> m_scratchTensors;
+    std::mutex m_baselineLock;
+    std::vector<Qnn_PerfBaseline_t> m_perfBaselines;
+
+    /* false once the backend rejects the memory registration, raw client buffers are used */
+    std::atomic<bool> m_bMemRegisterSupported{ true };
+
+    /* the background bulk registration, the registered buffers are added to m_dmaMemInfoMap under
+     * m_lock, so that a frame registering the same buffer meanwhile is not blocked for long */
+    std::mutex m_registerLock;
+    std::condition_variable m_registerCond;
+    std::thread m_registerThread;
+    std::vector<TensorDescriptor_t> m_pendingRegisters;
+    bool m_bRegistering = false;
+    QCStatus_e m_registerStatus = QC_STATUS_OK;
+    uint64_t m_activeGraphMask = 0;
+    std::mutex m_notifyLock;
+    uint64_t m_lastFrameDoneUs = 0; /* the completion of the last asynchronous frame */
 
     QC_DECLARE_NODETRACE();
 
@@ -17,7 +17,32 @@ QCStatus_e QnnMonitor::VerifyAndSet( const std::string config, std::string &erro
 
 const std::string &QnnMonitor::GetOptions()
 {
-    m_options = "{}";
+    std::vector<Qnn_PerfBaseline_t> baselines;
+    DataTree dt;
+
+    if ( QC_STATUS_OK == m_pQnnImpl->GetPerfBaselines( baselines ) )
+    {
+        std::vector<DataTree> baselineDts;
+        for ( const Qnn_PerfBaseline_t &baseline : baselines )
+        {
+            DataTree baselineDt;
+            baselineDt.Set<std::string>( "graph", baseline.graphName );
+            baselineDt.Set<uint32_t>( "frames", baseline.numFrames );
+            baselineDt.Set<uint64_t>( "wallTime", baseline.wallTime );
+            baselineDt.Set<uint64_t>( "entireExecTime", baseline.perf.entireExecTime );
+            baselineDt.Set<uint64_t>( "rpcExecTimeCPU", baseline.perf.rpcExecTimeCPU );
+            baselineDt.Set<uint64_t>( "rpcExecTimeHTP", baseline.perf.rpcExecTimeHTP );
+            baselineDt.Set<uint64_t>( "rpcExecTimeAcc", baseline.perf.rpcExecTimeAcc );
+            baselineDts.push_back( baselineDt );
+        }
+        dt.Set( "baselines", baselineDts );
+        m_options = dt.Dump();
+    }
+    else
+    {
+        m_options = "{}";
+    }
+
     return m_options;
 }
 
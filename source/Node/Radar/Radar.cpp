@@ -126,6 +126,7 @@ QCStatus_e RadarConfigIfs::ParseStaticConfig( DataTree &dt, std::string &errors
 
         m_config.bDeRegisterAllBuffersWhenStop =
                 dt.Get<bool>( "deRegisterAllBuffersWhenStop", false );
+        m_config.bEnablePerfCounters = dt.Get<bool>( "enablePerfCounters", false );
     }
     else
     {
@@ -245,6 +246,14 @@ QCStatus_e Radar::Initialize( QCNodeInit_t &config )
     {
         bRadarInitDone = true;
         m_bDeRegisterAllBuffersWhenStop = pConfig->bDeRegisterAllBuffersWhenStop;
+        if ( true == pConfig->bEnablePerfCounters )
+        {
+            QCStatus_e status2 = m_perfCounters.Init();
+            if ( QC_STATUS_OK != status2 )
+            {
+                QC_WARN( "Performance counters not supported, disabled" );
+            }
+        }
     }
 
     if ( QC_STATUS_OK == status )
@@ -318,6 +327,8 @@ QCStatus_e Radar::DeInitialize()
         status = status2;
     }
 
+    (void) m_perfCounters.Deinit();
+
     status2 = NodeBase::DeInitialize();
     if ( QC_STATUS_OK != status2 )
     {
@@ -385,8 +396,10 @@ QCStatus_e Radar::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDesc )
             else
             {
                 // Execute radar processing
+                m_perfCounters.Begin();
                 status = m_radar.Execute( &pInputSharedBuffer->buffer,
                                           &pOutputSharedBuffer->buffer );
+                m_perfCounters.End();
 
                 NotifyEvent( frameDesc, status );
             }
@@ -103,5 +103,48 @@ QCObjectState_e Remap::GetState()
     return m_pRemapImpl->GetState();
 }
 
+uint32_t RemapMonitoring::GetMaximalSize()
+{
+    return sizeof( QCNodePerfCounters_t );
+}
+
+uint32_t RemapMonitoring::GetCurrentSize()
+{
+    uint32_t size = 0;
+
+    if ( true == m_pRemapImpl->GetConifg().bEnablePerfCounters )
+    {
+        size = sizeof( QCNodePerfCounters_t );
+    }
+
+    return size;
+}
+
+QCStatus_e RemapMonitoring::Place( void *pData, uint32_t &size )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( nullptr == pData )
+    {
+        QC_ERROR( "Place with null data" );
+        status = QC_STATUS_NULL_PTR;
+    }
+    else if ( size < sizeof( QCNodePerfCounters_t ) )
+    {
+        QC_ERROR( "Place with invalid size" );
+        status = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        status = m_pRemapImpl->GetPerfCounters( *(QCNodePerfCounters_t *) pData );
+        if ( QC_STATUS_OK == status )
+        {
+            size = sizeof( QCNodePerfCounters_t );
+        }
+    }
+
+    return status;
+}
+
 }   // namespace Node
 }   // namespace QC
@@ -171,6 +171,7 @@ QCStatus_e RemapConfig::ParseStaticConfig( DataTree &dt, std::string &errors )
 
         config.bDeRegisterAllBuffersWhenStop =
                 dt.Get<bool>( "deRegisterAllBuffersWhenStop", false );
+        config.bEnablePerfCounters = dt.Get<bool>( "enablePerfCounters", false );
     }
     else
     {
@@ -194,6 +194,15 @@ RemapImpl::Initialize( std::vector<std::reference_wrapper<QCBufferDescriptorBase
             }
         }
 
+        if ( ( QC_STATUS_OK == status ) && ( true == m_config.bEnablePerfCounters ) )
+        {
+            QCStatus_e status2 = m_perfCounters.Init();
+            if ( QC_STATUS_OK != status2 )
+            {
+                QC_WARN( "Performance counters not supported, disabled" );
+            }
+        }
+
         if ( QC_STATUS_OK == status )
         {
             m_state = QC_OBJECT_STATE_READY;
@@ -235,6 +244,7 @@ QCStatus_e RemapImpl::DeInitialize()
             QC_ERROR( "Deinit fadas remap failed!" );
             status = QC_STATUS_FAIL;
         }
+        (void) m_perfCounters.Deinit();
     }
     QC_TRACE_END( "DeInit", {} );
 
@@ -259,7 +269,11 @@ QCStatus_e RemapImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &frameDes
     }
     else
     {
+        m_perfCounters.Begin();
         status = m_fadasRemapObj.RemapRun( frameDesc );
+        m_perfCounters.End();
+        QC_TRACE_IF( m_perfCounters.IsEnabled(),
+                     QC_TRACE_COUNTER( "PerfCounters", m_perfCounters.GetTraceArgs() ) );
     }
     QC_TRACE_END( "Execute", {} );
 
@@ -271,6 +285,22 @@ QCObjectState_e RemapImpl::GetState()
     return m_state;
 }
 
+QCStatus_e RemapImpl::GetPerfCounters( QCNodePerfCounters_t &counters )
+{
+    QCStatus_e status = QC_STATUS_OK;
+
+    if ( false == m_config.bEnablePerfCounters )
+    {
+        status = QC_STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        m_perfCounters.Get( counters );
+    }
+
+    return status;
+}
+
 QCStatus_e RemapImpl::SetupGlobalBufferIdMap()
 {
     QCStatus_e status = QC_STATUS_OK;
@@ -38,6 +38,7 @@ namespace Node
  * - The index N of QCFrameDescriptorNodeIfs will be output.
  * @param bDeRegisterAllBuffersWhenStop When the Stop API of the Remap node is called and
  * bDeRegisterAllBuffersWhenStop is true, deregister all buffers.
+ * @param bEnablePerfCounters Sample the CPU performance counters around each execution.
  */
 typedef struct RemapImplConfig : public QCNodeConfigBase_t
 {
@@ -45,6 +46,7 @@ typedef struct RemapImplConfig : public QCNodeConfigBase_t
     std::vector<uint32_t> bufferIds;
     std::vector<QCNodeBufferMapEntry_t> globalBufferIdMap;
     bool bDeRegisterAllBuffersWhenStop;
+    bool bEnablePerfCounters;
 } RemapImplConfig_t;
 
 class RemapPipelineBase; /**<pipeline base class*/
@@ -65,6 +67,7 @@ public:
     QCStatus_e Stop();
     QCStatus_e DeInitialize();
     QCObjectState_e GetState();
+    QCStatus_e GetPerfCounters( QCNodePerfCounters_t &counters );
 
 private:
     QCStatus_e SetupGlobalBufferIdMap();
@@ -75,6 +78,7 @@ private:
     RemapImplConfig_t m_config;
     QCObjectState_e m_state;
     FadasRemap m_fadasRemapObj;
+    PerfCounters m_perfCounters;
 
     QC_DECLARE_NODETRACE();
 
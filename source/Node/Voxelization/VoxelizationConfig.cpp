@@ -8,6 +8,7 @@ namespace QC
 {
 namespace Node
 {
+
 QCStatus_e VoxelizationConfig::VerifyStaticConfig( DataTree &dt, std::string &errors )
 {
     QCStatus_e ret = QC_STATUS_OK;
@@ -138,6 +139,25 @@ QCStatus_e VoxelizationConfig::VerifyStaticConfig( DataTree &dt, std::string &er
                 errors += "the coordToPlrIdxBufferId is not set, ";
                 ret = QC_STATUS_BAD_ARGUMENTS;
             }
+
+            OpenclIfcae_Perf_e perf;
+            if ( false == GetPerfLevel( dt.Get<std::string>( "priority", "normal" ), perf ) )
+            {
+                errors += "the priority is invalid, ";
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
+
+            if ( false == GetPerfLevel( dt.Get<std::string>( "queuePriority", "normal" ), perf ) )
+            {
+                errors += "the queuePriority is invalid, ";
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
+
+            if ( false == GetPerfLevel( dt.Get<std::string>( "queueThrottle", "normal" ), perf ) )
+            {
+                errors += "the queueThrottle is invalid, ";
+                ret = QC_STATUS_BAD_ARGUMENTS;
+            }
         }
     }
 
@@ -242,6 +262,19 @@ QCStatus_e VoxelizationConfig::ParseStaticConfig( DataTree &dt, std::string &err
 
         config.bDeRegisterAllBuffersWhenStop =
                 dt.Get<bool>( "deRegisterAllBuffersWhenStop", false );
+        config.bEnablePerfCounters = dt.Get<bool>( "enablePerfCounters", false );
+        config.programCacheDir = dt.Get<std::string>( "programCacheDir", "" );
+        (void) GetPerfLevel( dt.Get<std::string>( "priority", "normal" ), config.priority );
+        config.deviceId = dt.Get<uint32_t>( "deviceId", 0 );
+        config.sharedContext = dt.Get<std::string>( "sharedContext", "" );
+        config.queueConfig.name = dt.Get<std::string>( "queueName", "" );
+        (void) GetPerfLevel( dt.Get<std::string>( "queuePriority", "normal" ),
+                             config.queueConfig.priority );
+        (void) GetPerfLevel( dt.Get<std::string>( "queueThrottle", "normal" ),
+                             config.queueConfig.throttle );
+        config.queueConfig.bOutOfOrder = dt.Get<bool>( "outOfOrder", false );
+        config.queueConfig.bProfiling = ( QC_PROCESSOR_GPU == config.voxelConfig.processor ) &&
+                                        dt.Get<bool>( "gpuProfiling", false );
     }
 
     return ret;
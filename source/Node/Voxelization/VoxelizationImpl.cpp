@@ -78,7 +78,9 @@ VoxelizationImpl::Initialize( QCNodeEventCallBack_t callback,
 
         if ( QC_PROCESSOR_GPU == m_processor )
         {
-            ret = m_openCLSrvObj.Init( m_nodeId.name.c_str(), m_logger.GetLevel() );
+            ret = m_openCLSrvObj.Init( m_nodeId.name.c_str(), m_logger.GetLevel(),
+                                       m_config.priority, m_config.deviceId,
+                                       m_config.sharedContext, m_config.queueConfig );
             if ( QC_STATUS_OK != ret )
             {
                 ret = QC_STATUS_FAIL;
@@ -88,7 +90,8 @@ VoxelizationImpl::Initialize( QCNodeEventCallBack_t callback,
             if ( QC_STATUS_OK == ret )
             {
                 bOpenclInitOK = true;
-                ret = m_openCLSrvObj.LoadFromSource( s_pSourceVoxelization );
+                ret = m_openCLSrvObj.LoadFromSource( s_pSourceVoxelization,
+                                                     m_config.programCacheDir );
                 if ( QC_STATUS_OK != ret )
                 {
                     ret = QC_STATUS_FAIL;
@@ -199,6 +202,23 @@ VoxelizationImpl::Initialize( QCNodeEventCallBack_t callback,
         }
     }
 
+    if ( ( QC_STATUS_OK == ret ) && ( true == m_config.bEnablePerfCounters ) )
+    {
+        /* the host counters measure nothing of a GPU dispatch */
+        if ( QC_PROCESSOR_GPU == m_processor )
+        {
+            QC_WARN( "Performance counters are only sampled by the cpu processor, disabled" );
+        }
+        else
+        {
+            QCStatus_e ret2 = m_perfCounters.Init();
+            if ( QC_STATUS_OK != ret2 )
+            {
+                QC_WARN( "Performance counters not supported, disabled" );
+            }
+        }
+    }
+
     if ( QC_STATUS_OK == ret )
     {
         m_state = QC_OBJECT_STATE_READY;
@@ -527,10 +547,16 @@ QCStatus_e VoxelizationImpl::ProcessFrameDescriptor( QCFrameDescriptorNodeIfs &f
         if ( QC_PROCESSOR_GPU == m_processor )
         {
             ret = ProcessCL( *pInputTensor, *pOutputPlrTensor, *pOutputFeatTensor );
+            QC_TRACE_IF( m_openCLSrvObj.IsProfiling(),
+                         m_openCLSrvObj.TraceKernelEvents( m_trace ) );
         }
         else
         {
+            m_perfCounters.Begin();
             ret = m_plrPre.PointPillarRun( *pInputTensor, *pOutputPlrTensor, *pOutputFeatTensor );
+            m_perfCounters.End();
+            QC_TRACE_IF( m_perfCounters.IsEnabled(),
+                         QC_TRACE_COUNTER( "PerfCounters", m_perfCounters.GetTraceArgs() ) );
         }
     }
 
@@ -592,6 +618,7 @@ QCStatus_e VoxelizationImpl::DeInitialize()
         }
 
         m_clBufferDescMap.clear();
+        (void) m_perfCounters.Deinit();
     }
 
     QC_TRACE_END( "DeInit", {} );
@@ -604,6 +631,27 @@ QCObjectState_e VoxelizationImpl::GetState()
     return m_state;
 }
 
+QCStatus_e VoxelizationImpl::GetPerfCounters( QCNodePerfCounters_t &counters )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( false == m_perfCounters.IsEnabled() )
+    {
+        ret = QC_STATUS_UNSUPPORTED;
+    }
+    else
+    {
+        m_perfCounters.Get( counters );
+    }
+
+    return ret;
+}
+
+QCStatus_e VoxelizationImpl::GetGpuProfile( QCNodeGpuProfile_t &profile )
+{
+    return m_openCLSrvObj.GetKernelProfile( profile );
+}
+
 QCStatus_e VoxelizationImpl::ProcessCL( TensorDescriptor_t &inputTensorDesc,
                                         TensorDescriptor_t &outputPlrTensorDesc,
                                         TensorDescriptor_t &outputFeatTensorDesc )
@@ -645,6 +693,16 @@ QCStatus_e VoxelizationImpl::ProcessCL( TensorDescriptor_t &inputTensorDesc,
         }
     }
 
+    if ( ret == QC_STATUS_OK )
+    {
+        /* the input may still be written by a GPU node of the shared context */
+        ret = m_openCLSrvObj.WaitBuffers( &inputTensorDesc.pBuf, 1 );
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "Failed to wait for the input buffer" );
+        }
+    }
+
     if ( ret == QC_STATUS_OK )
     {
         auto outputPlrIt = m_clBufferDescMap.find( outputPlrBufferHandle );
@@ -738,12 +796,34 @@ QCStatus_e VoxelizationImpl::ProcessCL( TensorDescriptor_t &inputTensorDesc,
         /*set local work size to NULL, device would choose optimal size automatically*/
         OpenclWorkParams2.pLocalWorkSize = NULL;
 
-        ret = m_openCLSrvObj.Execute( &m_featGatherKernel, m_openCLArgsFeatGather, m_numOfArgs2,
-                                      &OpenclWorkParams2 );
+        cl_event event = nullptr;
+        ret = m_openCLSrvObj.ExecuteAsync( &m_featGatherKernel, m_openCLArgsFeatGather,
+                                           m_numOfArgs2, &OpenclWorkParams2, &event );
         if ( QC_STATUS_OK != ret )
         {
             QC_ERROR( "Failed to execute FeatureGather OpenCL kernel!" );
         }
+        else
+        {
+            /* the GPU nodes of the shared context reading the outputs wait for this kernel */
+            ret = m_openCLSrvObj.SetBufferEvent( outputPlrTensorDesc.pBuf, event );
+            if ( QC_STATUS_OK == ret )
+            {
+                ret = m_openCLSrvObj.SetBufferEvent( outputFeatTensorDesc.pBuf, event );
+            }
+            if ( QC_STATUS_OK != ret )
+            {
+                QC_ERROR( "Failed to set the event of the output buffers" );
+            }
+            (void) clReleaseEvent( event );
+        }
+
+        QCStatus_e ret2 = m_openCLSrvObj.Finish();
+        if ( QC_STATUS_OK != ret2 )
+        {
+            QC_ERROR( "Failed to finish FeatureGather OpenCL kernel!" );
+            ret = ret2;
+        }
     }
 
     return ret;
@@ -111,6 +111,14 @@ typedef struct Voxelization_Config_t
  * - Index inputBufferIds.size + outputPlrBufferIds.size + outputFeatureBufferIds.size + 1 :
  * Internal (for coordinate to pillar buffer)
  * @param bDeRegisterAllBuffersWhenStop Flag to deregister all buffers when stopped
+ * @param bEnablePerfCounters Flag to sample the CPU performance counters around each execution
+ * @param programCacheDir The directory of the OpenCL program binary cache, empty to disable it
+ * @param priority The performance priority level of the OpenCL context
+ * @param deviceId The index of the OpenCL device
+ * @param sharedContext The name of the OpenCL context shared with other GPU nodes, empty to use
+ * a private context
+ * @param queueConfig The name, the priority and throttle hints, the out-of-order mode and the
+ * profiling of the OpenCL command queue
  */
 typedef struct VoxelizationImplConfig : public QCNodeConfigBase_t
 {
@@ -121,6 +129,12 @@ typedef struct VoxelizationImplConfig : public QCNodeConfigBase_t
     uint32_t coordToPlrIdxBufferId;
     std::vector<QCNodeBufferMapEntry_t> globalBufferIdMap;
     bool bDeRegisterAllBuffersWhenStop;
+    bool bEnablePerfCounters;
+    std::string programCacheDir;
+    OpenclIfcae_Perf_e priority = OPENCLIFACE_PERF_NORMAL;
+    uint32_t deviceId = 0;
+    std::string sharedContext;
+    OpenclIface_QueueConfig_t queueConfig;
 } VoxelizationImplConfig_t;
 
 // TODO
@@ -207,6 +221,32 @@ public:
      */
     QCObjectState_e GetState();
 
+    /**
+     * @brief Get the performance counters sampled around each execution.
+     * @param[out] counters The aggregated performance counters.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if not enabled or not supported.
+     */
+    QCStatus_e GetPerfCounters( QCNodePerfCounters_t &counters );
+
+    /**
+     * @brief Check if the performance counters are sampled.
+     * @return true if enabled for the cpu processor and supported by the platform.
+     */
+    bool IsPerfCounting() { return m_perfCounters.IsEnabled(); }
+
+    /**
+     * @brief Get the GPU profile of the kernels.
+     * @param[out] profile The profile of the kernels aggregated by kernel name.
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if not enabled.
+     */
+    QCStatus_e GetGpuProfile( QCNodeGpuProfile_t &profile );
+
+    /**
+     * @brief Check if the GPU timestamps of the kernels are recorded.
+     * @return true if the profiling is enabled and supported by the OpenCL queue.
+     */
+    bool IsGpuProfiling() { return m_openCLSrvObj.IsProfiling(); }
+
 private:
     QCStatus_e ProcessCL( TensorDescriptor_t &inputTensorDesc,
                           TensorDescriptor_t &outputPlrTensorDesc,
@@ -243,6 +283,7 @@ private:
     bool m_bufferRegisterOK;
     FadasPlrPreProc m_plrPre;
     OpenclSrv m_openCLSrvObj;
+    PerfCounters m_perfCounters;
 
     static constexpr size_t CLUSTER_POINT_KERNEL_ARGS = 19;
     static constexpr size_t FEAT_GATHER_KERNEL_ARGS = 13;
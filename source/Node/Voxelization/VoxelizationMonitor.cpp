@@ -25,5 +25,69 @@ const QCNodeMonitoringBase_t &VoxelizationMonitor::Get()
     return m_pVoxelImpl->GetMonitorConifg();
 }
 
+uint32_t VoxelizationMonitor::GetMaximalSize()
+{
+    return sizeof( QCNodePerfCounters_t ) + sizeof( QCNodeGpuProfile_t );
+}
+
+uint32_t VoxelizationMonitor::GetCurrentSize()
+{
+    uint32_t size = 0;
+
+    if ( true == m_pVoxelImpl->IsPerfCounting() )
+    {
+        size += sizeof( QCNodePerfCounters_t );
+    }
+
+    if ( true == m_pVoxelImpl->IsGpuProfiling() )
+    {
+        size += sizeof( QCNodeGpuProfile_t );
+    }
+
+    return size;
+}
+
+QCStatus_e VoxelizationMonitor::Place( void *pData, uint32_t &size )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    uint32_t currentSize = GetCurrentSize();
+
+    if ( nullptr == pData )
+    {
+        QC_ERROR( "Place with null data" );
+        ret = QC_STATUS_NULL_PTR;
+    }
+    else if ( 0 == currentSize )
+    {
+        ret = QC_STATUS_UNSUPPORTED;
+    }
+    else if ( size < currentSize )
+    {
+        QC_ERROR( "Place with invalid size" );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        uint8_t *pPlace = (uint8_t *) pData;
+        if ( true == m_pVoxelImpl->IsPerfCounting() )
+        {
+            ret = m_pVoxelImpl->GetPerfCounters( *(QCNodePerfCounters_t *) pPlace );
+            pPlace += sizeof( QCNodePerfCounters_t );
+        }
+
+        if ( ( QC_STATUS_OK == ret ) && ( true == m_pVoxelImpl->IsGpuProfiling() ) )
+        {
+            ret = m_pVoxelImpl->GetGpuProfile( *(QCNodeGpuProfile_t *) pPlace );
+        }
+
+        if ( QC_STATUS_OK == ret )
+        {
+            size = currentSize;
+        }
+    }
+
+    return ret;
+}
+
 }   // namespace Node
 }   // namespace QC
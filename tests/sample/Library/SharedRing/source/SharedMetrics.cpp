@@ -0,0 +1,335 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "QC/sample/shared_ring/SharedMetrics.hpp"
+
+#include <chrono>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace QC
+{
+namespace sample
+{
+namespace shared_ring
+{
+
+SharedMetrics::SharedMetrics()
+{
+    QC_LOGGER_INIT( "METRICS", LOGGER_LEVEL_ERROR );
+}
+
+SharedMetrics::~SharedMetrics()
+{
+    QC_LOGGER_DEINIT();
+}
+
+QCStatus_e SharedMetrics::Init( std::string shmName, bool bCreate )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    bool bCreated = false;
+
+    std::lock_guard<std::mutex> l( m_lock );
+    if ( nullptr != m_pMem )
+    {
+        QC_ERROR( "shared metrics %s already opened", shmName.c_str() );
+        ret = QC_STATUS_ALREADY;
+    }
+    else
+    {
+        ret = m_shmem.Open( shmName );
+        if ( ( QC_STATUS_OK != ret ) && ( true == bCreate ) )
+        {
+            ret = m_shmem.Create( shmName, sizeof( SharedMetrics_Memory_t ) );
+            if ( QC_STATUS_OK != ret )
+            { /* maybe created by another process at the same time */
+                ret = m_shmem.Open( shmName );
+            }
+            else
+            {
+                bCreated = true;
+            }
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        SharedMetrics_Memory_t *pMem = (SharedMetrics_Memory_t *) m_shmem.Data();
+        if ( m_shmem.Size() < sizeof( SharedMetrics_Memory_t ) )
+        {
+            QC_ERROR( "shared metrics %s size %" PRIu64 " too small", shmName.c_str(),
+                      (uint64_t) m_shmem.Size() );
+            ret = QC_STATUS_BAD_STATE;
+        }
+        else if ( true == bCreated )
+        {
+            pMem->version = SHARED_METRICS_VERSION;
+            pMem->entrySize = sizeof( SharedMetrics_Entry_t );
+            pMem->numEntries = SHARED_METRICS_NUM_ENTRIES;
+            __atomic_store_n( &pMem->magic, SHARED_METRICS_MAGIC, __ATOMIC_RELAXED );
+            __atomic_store_n( &pMem->status, SHARED_METRICS_MEMORY_INITIALIZED, __ATOMIC_RELEASE );
+        }
+        else
+        {
+            /* the creator may not have finished the header initialization */
+            for ( int i = 0; i < SHARED_METRICS_READ_RETRY_MAX; i++ )
+            {
+                if ( SHARED_METRICS_MEMORY_INITIALIZED ==
+                     __atomic_load_n( &pMem->status, __ATOMIC_ACQUIRE ) )
+                {
+                    break;
+                }
+                (void) usleep( 1000 );
+            }
+
+            if ( SHARED_METRICS_MEMORY_INITIALIZED !=
+                 __atomic_load_n( &pMem->status, __ATOMIC_ACQUIRE ) )
+            {
+                QC_ERROR( "shared metrics %s not initialized", shmName.c_str() );
+                ret = QC_STATUS_BAD_STATE;
+            }
+            else if ( ( SHARED_METRICS_MAGIC != pMem->magic ) ||
+                      ( SHARED_METRICS_VERSION != pMem->version ) ||
+                      ( sizeof( SharedMetrics_Entry_t ) != pMem->entrySize ) ||
+                      ( SHARED_METRICS_NUM_ENTRIES != pMem->numEntries ) )
+            {
+                QC_ERROR( "shared metrics %s layout mismatch: magic=0x%x version=%u",
+                          shmName.c_str(), pMem->magic, pMem->version );
+                ret = QC_STATUS_BAD_STATE;
+            }
+            else
+            {
+                /* OK */
+            }
+        }
+
+        if ( QC_STATUS_OK == ret )
+        {
+            m_pMem = pMem;
+        }
+        else
+        {
+            (void) m_shmem.Close();
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e SharedMetrics::Deinit()
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    std::lock_guard<std::mutex> l( m_lock );
+    if ( nullptr == m_pMem )
+    {
+        QC_ERROR( "shared metrics not opened" );
+        ret = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        m_pMem = nullptr;
+        ret = m_shmem.Close();
+    }
+
+    return ret;
+}
+
+QCStatus_e SharedMetrics::Register( std::string name, uint32_t nodeId, uint32_t &slotId )
+{
+    QCStatus_e ret = QC_STATUS_NO_RESOURCE;
+    int32_t pid = (int32_t) getpid();
+
+    slotId = SHARED_METRICS_INVALID_SLOT;
+    if ( nullptr == m_pMem )
+    {
+        QC_ERROR( "shared metrics not opened" );
+        ret = QC_STATUS_BAD_STATE;
+    }
+    else
+    {
+        for ( uint32_t i = 0; i < SHARED_METRICS_NUM_ENTRIES; i++ )
+        {
+            SharedMetrics_Entry_t *pEntry = &m_pMem->entries[i];
+            if ( false == __atomic_exchange_n( &pEntry->reserved, true, __ATOMIC_ACQUIRE ) )
+            {
+                __atomic_store_n( &pEntry->pid, pid, __ATOMIC_RELAXED );
+                ret = QC_STATUS_OK;
+            }
+            else if ( true == Reclaim( pEntry, pid ) )
+            {
+                QC_INFO( "shared metrics entry %u reclaimed for %s", i, name.c_str() );
+                ret = QC_STATUS_OK;
+            }
+            else
+            {
+                /* in use by a live process */
+            }
+
+            if ( QC_STATUS_OK == ret )
+            { /* an owner that crashed may have left the sequence odd */
+                uint32_t seq = __atomic_load_n( &pEntry->seq, __ATOMIC_RELAXED ) & ~1u;
+                __atomic_store_n( &pEntry->seq, seq + 1, __ATOMIC_RELAXED );
+                __atomic_thread_fence( __ATOMIC_RELEASE );
+                pEntry->nodeId = nodeId;
+                (void) snprintf( pEntry->name, sizeof( pEntry->name ), "%s", name.c_str() );
+                (void) memset( &pEntry->stats, 0, sizeof( pEntry->stats ) );
+                pEntry->stats.timestamp = GetTimestamp();
+                __atomic_store_n( &pEntry->seq, seq + 2, __ATOMIC_RELEASE );
+                slotId = i;
+                break;
+            }
+        }
+
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "no free shared metrics entry for %s", name.c_str() );
+        }
+    }
+
+    return ret;
+}
+
+bool SharedMetrics::Reclaim( SharedMetrics_Entry_t *pEntry, int32_t pid )
+{
+    bool bReclaimed = false;
+    int32_t ownerPid = __atomic_load_n( &pEntry->pid, __ATOMIC_RELAXED );
+
+    /* the pid is 0 while an entry is being reserved or released, and a process that got EPERM
+     * is alive but owned by another user */
+    if ( ( 0 != ownerPid ) && ( pid != ownerPid ) && ( 0 != kill( ownerPid, 0 ) ) &&
+         ( ESRCH == errno ) )
+    { /* only one of the processes that found the same dead owner takes the entry */
+        bReclaimed = __atomic_compare_exchange_n( &pEntry->pid, &ownerPid, pid, false,
+                                                  __ATOMIC_ACQUIRE, __ATOMIC_RELAXED );
+    }
+
+    return bReclaimed;
+}
+
+QCStatus_e SharedMetrics::Unregister( uint32_t slotId )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( nullptr == m_pMem )
+    {
+        QC_ERROR( "shared metrics not opened" );
+        ret = QC_STATUS_BAD_STATE;
+    }
+    else if ( slotId >= SHARED_METRICS_NUM_ENTRIES )
+    {
+        QC_ERROR( "invalid shared metrics slot %u", slotId );
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    {
+        __atomic_store_n( &m_pMem->entries[slotId].pid, 0, __ATOMIC_RELAXED );
+        __atomic_store_n( &m_pMem->entries[slotId].reserved, false, __ATOMIC_RELEASE );
+    }
+
+    return ret;
+}
+
+QCStatus_e SharedMetrics::Update( uint32_t slotId, const SharedMetrics_Stats_t &stats )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+
+    if ( nullptr == m_pMem )
+    {
+        ret = QC_STATUS_BAD_STATE;
+    }
+    else if ( slotId >= SHARED_METRICS_NUM_ENTRIES )
+    {
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else
+    { /* single writer per entry, so a plain sequence lock is enough */
+        SharedMetrics_Entry_t *pEntry = &m_pMem->entries[slotId];
+        uint32_t seq = __atomic_load_n( &pEntry->seq, __ATOMIC_RELAXED );
+        __atomic_store_n( &pEntry->seq, seq + 1, __ATOMIC_RELAXED );
+        __atomic_thread_fence( __ATOMIC_RELEASE );
+        pEntry->stats = stats;
+        __atomic_store_n( &pEntry->seq, seq + 2, __ATOMIC_RELEASE );
+    }
+
+    return ret;
+}
+
+QCStatus_e SharedMetrics::Read( uint32_t slotId, SharedMetrics_Entry_t &entry )
+{
+    QCStatus_e ret = QC_STATUS_TIMEOUT;
+
+    if ( nullptr == m_pMem )
+    {
+        ret = QC_STATUS_BAD_STATE;
+    }
+    else if ( slotId >= SHARED_METRICS_NUM_ENTRIES )
+    {
+        ret = QC_STATUS_BAD_ARGUMENTS;
+    }
+    else if ( false == __atomic_load_n( &m_pMem->entries[slotId].reserved, __ATOMIC_ACQUIRE ) )
+    {
+        ret = QC_STATUS_OUT_OF_BOUND;
+    }
+    else
+    {
+        SharedMetrics_Entry_t *pEntry = &m_pMem->entries[slotId];
+        for ( int i = 0; i < SHARED_METRICS_READ_RETRY_MAX; i++ )
+        {
+            uint32_t seq0 = __atomic_load_n( &pEntry->seq, __ATOMIC_ACQUIRE );
+            if ( 0 == ( seq0 & 1 ) )
+            {
+                (void) memcpy( &entry, pEntry, sizeof( SharedMetrics_Entry_t ) );
+                __atomic_thread_fence( __ATOMIC_ACQUIRE );
+                uint32_t seq1 = __atomic_load_n( &pEntry->seq, __ATOMIC_RELAXED );
+                if ( seq0 == seq1 )
+                {
+                    entry.name[SHARED_METRICS_NAME_MAX - 1] = '\0';
+                    ret = QC_STATUS_OK;
+                    break;
+                }
+            }
+        }
+    }
+
+    return ret;
+}
+
+uint32_t SharedMetrics::GetNumEntries()
+{
+    return SHARED_METRICS_NUM_ENTRIES;
+}
+
+uint64_t SharedMetrics::GetTimestamp()
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch() )
+            .count();
+}
+
+uint64_t SharedMetrics::GetRssBytes()
+{
+    uint64_t rssBytes = 0;
+#if defined( __linux__ )
+    FILE *fp = fopen( "/proc/self/statm", "r" );
+    if ( nullptr != fp )
+    {
+        unsigned long long sizePages = 0;
+        unsigned long long rssPages = 0;
+        if ( 2 == fscanf( fp, "%llu %llu", &sizePages, &rssPages ) )
+        {
+            rssBytes = (uint64_t) rssPages * (uint64_t) sysconf( _SC_PAGESIZE );
+        }
+        (void) fclose( fp );
+    }
+#endif
+    return rssBytes;
+}
+
+}   // namespace shared_ring
+}   // namespace sample
+}   // namespace QC
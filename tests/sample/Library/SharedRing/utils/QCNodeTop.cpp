@@ -0,0 +1,137 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "QC/sample/shared_ring/SharedMetrics.hpp"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+using namespace QC;
+
+using namespace QC::sample;
+using namespace QC::sample::shared_ring;
+
+/* entries not updated for this long are shown as stale */
+#define QCNODE_TOP_STALE_SECONDS 10.0
+
+static int Usage( const char *program, int error )
+{
+    printf( "Usage: %s [-s shm_name] [-i interval_ms] [-n iterations] [-a] [-h]\n"
+            "  -s: the shared metrics memory name, default %s\n"
+            "  -i: the refresh interval in milliseconds, default 1000\n"
+            "  -n: the number of refreshes, default 0 means forever\n"
+            "  -a: show stale entries\n"
+            "examples:\n"
+            "%s -i 500\n",
+            program, SHARED_METRICS_DEFAULT_SHM_NAME, program );
+    return error;
+}
+
+static void ShowTable( SharedMetrics &metrics, bool bShowAll, bool bClear )
+{
+    SharedMetrics_Entry_t entry;
+    uint64_t now = SharedMetrics::GetTimestamp();
+    uint32_t numShown = 0;
+
+    if ( bClear )
+    { /* move cursor to home and clear the screen */
+        printf( "\033[H\033[2J" );
+    }
+
+    printf( "%-4s %-8s %-24s %9s %10s %8s %8s %8s %8s %8s %8s %8s %9s %7s\n", "SLOT", "PID",
+            "NAME", "FPS", "COUNT", "AVG", "MIN", "MAX", "P50", "P90", "P99", "P99.9", "RSS(MB)",
+            "AGE(s)" );
+    for ( uint32_t i = 0; i < metrics.GetNumEntries(); i++ )
+    {
+        QCStatus_e ret = metrics.Read( i, entry );
+        if ( QC_STATUS_OK != ret )
+        {
+            continue;
+        }
+
+        const SharedMetrics_Stats_t &stats = entry.stats;
+        double ageS = 0.0;
+        if ( now > stats.timestamp )
+        {
+            ageS = (double) ( now - stats.timestamp ) / 1000000000.0;
+        }
+        if ( ( false == bShowAll ) && ( ageS > QCNODE_TOP_STALE_SECONDS ) )
+        {
+            continue;
+        }
+
+        float latencyMin = ( 0 == stats.count ) ? 0.f : stats.latencyMin;
+        printf( "%-4" PRIu32 " %-8" PRIi32 " %-24.24s %9.3f %10" PRIu64
+                " %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %9.1f %7.1f\n",
+                i, entry.pid, entry.name, stats.fps, stats.count, stats.latencyAvg, latencyMin,
+                stats.latencyMax, stats.latencyP50, stats.latencyP90, stats.latencyP99,
+                stats.latencyP999, (double) stats.rssBytes / ( 1024.0 * 1024.0 ), ageS );
+        numShown++;
+    }
+
+    if ( 0 == numShown )
+    {
+        printf( "no active node\n" );
+    }
+    (void) fflush( stdout );
+}
+
+int main( int argc, char *argv[] )
+{
+    int opt;
+    std::string shmName = SHARED_METRICS_DEFAULT_SHM_NAME;
+    uint32_t intervalMs = 1000;
+    uint32_t iterations = 0;
+    bool bShowAll = false;
+
+    while ( ( opt = getopt( argc, argv, "s:i:n:ah" ) ) != -1 )
+    {
+        switch ( opt )
+        {
+            case 's':
+                shmName = optarg;
+                break;
+            case 'i':
+                intervalMs = (uint32_t) strtoul( optarg, nullptr, 0 );
+                break;
+            case 'n':
+                iterations = (uint32_t) strtoul( optarg, nullptr, 0 );
+                break;
+            case 'a':
+                bShowAll = true;
+                break;
+            case 'h':
+                return Usage( argv[0], 0 );
+                break;
+            default:
+                return Usage( argv[0], EINVAL );
+                break;
+        }
+    }
+
+    SharedMetrics metrics;
+    QCStatus_e ret = metrics.Init( shmName, false );
+    if ( QC_STATUS_OK != ret )
+    {
+        printf( "Failed to open shared metrics memory: %s\n", shmName.c_str() );
+        return EACCES;
+    }
+
+    bool bClear = ( 1 != iterations ) && ( 1 == isatty( STDOUT_FILENO ) );
+    for ( uint32_t n = 0; ( 0 == iterations ) || ( n < iterations ); n++ )
+    {
+        if ( n > 0 )
+        {
+            (void) usleep( intervalMs * 1000 );
+        }
+        ShowTable( metrics, bShowAll, bClear );
+    }
+
+    (void) metrics.Deinit();
+
+    return 0;
+}
@@ -0,0 +1,318 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef _QC_SAMPLE_LATENCY_HISTOGRAM_HPP_
+#define _QC_SAMPLE_LATENCY_HISTOGRAM_HPP_
+
+#include <cinttypes>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "QC/Common/Types.hpp"
+
+namespace QC
+{
+namespace sample
+{
+
+/** @brief magic "QHST" of the latency histogram binary dump */
+#define LATENCY_HISTOGRAM_MAGIC 0x54534851u
+#define LATENCY_HISTOGRAM_VERSION 1u
+
+/**
+ * @brief the number of bits of the linear sub-buckets, each power of 2 range is split into
+ * 2^(LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1) linear buckets, so the relative error of a recorded
+ * value is less than 1 / 2^(LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1).
+ */
+#ifndef LATENCY_HISTOGRAM_SUB_BUCKET_BITS
+#define LATENCY_HISTOGRAM_SUB_BUCKET_BITS 7
+#endif
+
+/** @brief the max trackable value is 2^LATENCY_HISTOGRAM_MAX_VALUE_BITS - 1 */
+#ifndef LATENCY_HISTOGRAM_MAX_VALUE_BITS
+#define LATENCY_HISTOGRAM_MAX_VALUE_BITS 36
+#endif
+
+/**
+ * @brief Fixed memory log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values are integers (the Profiler records microseconds). Values smaller than
+ * 2^LATENCY_HISTOGRAM_SUB_BUCKET_BITS are counted exactly, larger values are counted in
+ * log-linear buckets. Record never allocates, histograms with the same layout can be merged, and
+ * the counts can be dumped into a binary file to be merged offline.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    static constexpr uint32_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+    static constexpr uint32_t NUM_BUCKETS =
+            ( LATENCY_HISTOGRAM_MAX_VALUE_BITS - LATENCY_HISTOGRAM_SUB_BUCKET_BITS ) *
+                    SUB_BUCKET_HALF_COUNT +
+            SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_VALUE = ( 1llu << LATENCY_HISTOGRAM_MAX_VALUE_BITS ) - 1;
+
+    /** @brief the header of the binary dump, followed by NUM_BUCKETS uint64_t counts */
+    typedef struct
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t subBucketBits;
+        uint32_t numBuckets;
+        uint64_t totalCount;
+        uint64_t minValue;
+        uint64_t maxValue;
+        uint64_t sum;
+    } DumpHeader_t;
+
+public:
+    LatencyHistogram() { Reset(); }
+    ~LatencyHistogram() {}
+
+    void Reset()
+    {
+        (void) memset( m_counts, 0, sizeof( m_counts ) );
+        m_totalCount = 0;
+        m_minValue = UINT64_MAX;
+        m_maxValue = 0;
+        m_sum = 0;
+    }
+
+    /**
+     * @brief Record a value, values larger than MAX_VALUE are counted in the last bucket.
+     * @param[in] value the value to record
+     */
+    void Record( uint64_t value )
+    {
+        m_counts[GetIndex( value )]++;
+        m_totalCount++;
+        m_sum += value;
+        if ( value < m_minValue )
+        {
+            m_minValue = value;
+        }
+        if ( value > m_maxValue )
+        {
+            m_maxValue = value;
+        }
+    }
+
+    /**
+     * @brief Add all the counts of another histogram into this histogram.
+     * @param[in] other the histogram to merge
+     */
+    void Merge( const LatencyHistogram &other )
+    {
+        for ( uint32_t i = 0; i < NUM_BUCKETS; i++ )
+        {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_totalCount += other.m_totalCount;
+        m_sum += other.m_sum;
+        if ( other.m_minValue < m_minValue )
+        {
+            m_minValue = other.m_minValue;
+        }
+        if ( other.m_maxValue > m_maxValue )
+        {
+            m_maxValue = other.m_maxValue;
+        }
+    }
+
+    /**
+     * @brief Get the value at the given percentile.
+     * @param[in] percentile the percentile in range [0, 100]
+     * @return the highest value that is equivalent to the bucket at the percentile, clamped to the
+     * recorded max value, 0 if the histogram is empty
+     */
+    uint64_t GetValueAtPercentile( double percentile ) const
+    {
+        uint64_t value = 0;
+
+        if ( m_totalCount > 0 )
+        {
+            if ( percentile > 100.0 )
+            {
+                percentile = 100.0;
+            }
+            uint64_t target = (uint64_t) ( percentile * (double) m_totalCount / 100.0 + 0.5 );
+            if ( 0 == target )
+            {
+                target = 1;
+            }
+
+            uint64_t accumulated = 0;
+            for ( uint32_t i = 0; i < NUM_BUCKETS; i++ )
+            {
+                accumulated += m_counts[i];
+                if ( accumulated >= target )
+                {
+                    value = GetHighestEquivalentValue( i );
+                    break;
+                }
+            }
+
+            if ( value > m_maxValue )
+            {
+                value = m_maxValue;
+            }
+            if ( value < m_minValue )
+            {
+                value = m_minValue;
+            }
+        }
+
+        return value;
+    }
+
+    uint64_t GetCount() const { return m_totalCount; }
+    uint64_t GetMin() const { return ( m_totalCount > 0 ) ? m_minValue : 0; }
+    uint64_t GetMax() const { return m_maxValue; }
+    double GetMean() const
+    {
+        return ( m_totalCount > 0 ) ? ( (double) m_sum / (double) m_totalCount ) : 0.0;
+    }
+
+    /**
+     * @brief Dump the histogram into a binary file.
+     * @param[in] path the file path
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Save( std::string path ) const
+    {
+        QCStatus_e ret = QC_STATUS_OK;
+        DumpHeader_t header;
+
+        header.magic = LATENCY_HISTOGRAM_MAGIC;
+        header.version = LATENCY_HISTOGRAM_VERSION;
+        header.subBucketBits = LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+        header.numBuckets = NUM_BUCKETS;
+        header.totalCount = m_totalCount;
+        header.minValue = m_minValue;
+        header.maxValue = m_maxValue;
+        header.sum = m_sum;
+
+        FILE *pFile = fopen( path.c_str(), "wb" );
+        if ( nullptr == pFile )
+        {
+            ret = QC_STATUS_FAIL;
+        }
+        else
+        {
+            if ( ( 1 != fwrite( &header, sizeof( header ), 1, pFile ) ) ||
+                 ( NUM_BUCKETS != fwrite( m_counts, sizeof( uint64_t ), NUM_BUCKETS, pFile ) ) )
+            {
+                ret = QC_STATUS_FAIL;
+            }
+            (void) fclose( pFile );
+        }
+
+        return ret;
+    }
+
+    /**
+     * @brief Load a binary dump and merge it into this histogram.
+     * @param[in] path the file path
+     * @return QC_STATUS_OK on success, QC_STATUS_UNSUPPORTED if the dump layout is different,
+     * others on failure
+     */
+    QCStatus_e Load( std::string path )
+    {
+        QCStatus_e ret = QC_STATUS_OK;
+        DumpHeader_t header;
+        LatencyHistogram *pOther = new LatencyHistogram();
+
+        FILE *pFile = fopen( path.c_str(), "rb" );
+        if ( nullptr == pFile )
+        {
+            ret = QC_STATUS_FAIL;
+        }
+        else
+        {
+            if ( 1 != fread( &header, sizeof( header ), 1, pFile ) )
+            {
+                ret = QC_STATUS_FAIL;
+            }
+            else if ( ( LATENCY_HISTOGRAM_MAGIC != header.magic ) ||
+                      ( LATENCY_HISTOGRAM_VERSION != header.version ) ||
+                      ( LATENCY_HISTOGRAM_SUB_BUCKET_BITS != header.subBucketBits ) ||
+                      ( NUM_BUCKETS != header.numBuckets ) )
+            {
+                ret = QC_STATUS_UNSUPPORTED;
+            }
+            else if ( NUM_BUCKETS !=
+                      fread( pOther->m_counts, sizeof( uint64_t ), NUM_BUCKETS, pFile ) )
+            {
+                ret = QC_STATUS_FAIL;
+            }
+            else
+            {
+                pOther->m_totalCount = header.totalCount;
+                pOther->m_minValue = header.minValue;
+                pOther->m_maxValue = header.maxValue;
+                pOther->m_sum = header.sum;
+                Merge( *pOther );
+            }
+            (void) fclose( pFile );
+        }
+
+        delete pOther;
+
+        return ret;
+    }
+
+    static uint32_t GetIndex( uint64_t value )
+    {
+        uint32_t index;
+
+        if ( value > MAX_VALUE )
+        {
+            value = MAX_VALUE;
+        }
+
+        if ( value < SUB_BUCKET_COUNT )
+        {
+            index = (uint32_t) value;
+        }
+        else
+        {
+            uint32_t msb = 63u - (uint32_t) __builtin_clzll( value );
+            uint32_t shift = msb - ( LATENCY_HISTOGRAM_SUB_BUCKET_BITS - 1 );
+            index = shift * SUB_BUCKET_HALF_COUNT + (uint32_t) ( value >> shift );
+        }
+
+        return index;
+    }
+
+    static uint64_t GetHighestEquivalentValue( uint32_t index )
+    {
+        uint64_t value;
+
+        if ( index < SUB_BUCKET_COUNT )
+        {
+            value = index;
+        }
+        else
+        {
+            uint32_t shift = ( index - SUB_BUCKET_HALF_COUNT ) / SUB_BUCKET_HALF_COUNT;
+            uint64_t subBucket = index - shift * SUB_BUCKET_HALF_COUNT;
+            value = ( ( subBucket + 1 ) << shift ) - 1;
+        }
+
+        return value;
+    }
+
+private:
+    uint64_t m_counts[NUM_BUCKETS];
+    uint64_t m_totalCount;
+    uint64_t m_minValue;
+    uint64_t m_maxValue;
+    uint64_t m_sum;
+};
+
+}   // namespace sample
+}   // namespace QC
+
+#endif   // _QC_SAMPLE_LATENCY_HISTOGRAM_HPP_
@@ -10,6 +10,9 @@
 #include <stdio.h>
 #include <string>
 
+#include "QC/sample/LatencyHistogram.hpp"
+#include "QC/sample/shared_ring/SharedMetrics.hpp"
+
 namespace QC
 {
 namespace sample
@@ -51,29 +54,73 @@ namespace sample
 #define PROFILER_SHOW_PERIOD_SECONDS 5
 #endif
 
+#ifndef PROFILER_PERCENTILE_PERIOD_MS
+#define PROFILER_PERCENTILE_PERIOD_MS 1000
+#endif
+
 class Profiler
 {
 public:
     Profiler() {}
-    ~Profiler() {}
+    ~Profiler()
+    {
+        if ( nullptr != m_pMetrics )
+        {
+            (void) m_pMetrics->Unregister( m_metricsSlotId );
+        }
+    }
 
 
     void Show()
     {
         if ( m_count > 0 )
         {
-            printf( "%-16s: FPS=%-7.3f AVG=%-7.3f MIN=%-7.3f MAX=%-7.3f COUNT=%" PRIu64 "\n",
-                    m_name.c_str(), GetFPS(), m_avg, m_min, m_max, m_count );
+            printf( "%-16s: FPS=%-7.3f AVG=%-7.3f MIN=%-7.3f MAX=%-7.3f P50=%-7.3f P90=%-7.3f "
+                    "P99=%-7.3f P99.9=%-7.3f COUNT=%" PRIu64 "\n",
+                    m_name.c_str(), GetFPS(), m_avg, m_min, m_max, GetPercentile( 50.0 ),
+                    GetPercentile( 90.0 ), GetPercentile( 99.0 ), GetPercentile( 99.9 ),
+                    m_count );
+            if ( m_interval.GetCount() > 0 )
+            {
+                printf( "%-16s  INTERVAL: AVG=%-7.3f MIN=%-7.3f MAX=%-7.3f P50=%-7.3f P90=%-7.3f "
+                        "P99=%-7.3f P99.9=%-7.3f COUNT=%" PRIu64 "\n",
+                        m_name.c_str(), m_interval.GetMean() / 1000.0,
+                        m_interval.GetMin() / 1000.0, m_interval.GetMax() / 1000.0,
+                        GetPercentile( 50.0, true ), GetPercentile( 90.0, true ),
+                        GetPercentile( 99.0, true ), GetPercentile( 99.9, true ),
+                        m_interval.GetCount() );
+            }
+            m_interval.Reset();
             m_prevShow = std::chrono::high_resolution_clock::now();
         }
+
+        if ( nullptr != m_pMetrics )
+        { /* the RSS is only sampled in the show period as it requires file IO */
+            m_rssBytes = shared_ring::SharedMetrics::GetRssBytes();
+        }
+    }
+
+    /**
+     * @brief Publish the profiling result into a shared metrics memory at each End.
+     * @param[in] pMetrics the shared metrics memory, the entry will be released at destruction
+     * @param[in] slotId the entry index reserved by SharedMetrics::Register
+     */
+    void SetMetrics( shared_ring::SharedMetrics *pMetrics, uint32_t slotId )
+    {
+        m_pMetrics = pMetrics;
+        m_metricsSlotId = slotId;
+        m_rssBytes = shared_ring::SharedMetrics::GetRssBytes();
     }
 
     void Init( std::string name )
     {
         m_name = name;
         m_count = 0;
+        m_cumulative.Reset();
+        m_interval.Reset();
         m_begin = std::chrono::high_resolution_clock::now();
         m_prevShow = std::chrono::high_resolution_clock::now();
+        m_prevPercentile = std::chrono::high_resolution_clock::now();
     }
 
     void Begin()
@@ -91,7 +138,9 @@ public:
         /* NOTE: no consideration of overflow as uint64 and double can hold large value */
         m_count++;
         m_end = std::chrono::high_resolution_clock::now();
-        float durationMs = (float) PROFILER_GET_MS( m_end, m_prev );
+        int64_t durationUs =
+                std::chrono::duration_cast<std::chrono::microseconds>( m_end - m_prev ).count();
+        float durationMs = (float) durationUs / 1000.f;
         if ( durationMs > m_max )
         {
             m_max = durationMs;
@@ -105,11 +154,21 @@ public:
         m_totalCost += durationMs;
         m_avg = m_totalCost / m_count;
 
+        /* the histograms are fixed memory, no allocation here */
+        uint64_t valueUs = ( durationUs > 0 ) ? (uint64_t) durationUs : 0;
+        m_cumulative.Record( valueUs );
+        m_interval.Record( valueUs );
+
         double elapsedS = PROFILER_GET_SECONDS( m_end, m_prevShow );
         if ( elapsedS > PROFILER_SHOW_PERIOD_SECONDS )
         {
             Show();
         }
+
+        if ( nullptr != m_pMetrics )
+        {
+            Publish();
+        }
     }
 
     float GetFPS()
@@ -129,6 +188,61 @@ public:
     float GetMin() { return m_min; }
     float GetMax() { return m_max; }
 
+    /**
+     * @brief Get the latency at the given percentile.
+     * @param[in] percentile the percentile in range [0, 100]
+     * @param[in] bInterval true to query the histogram since the last Show, false to query the
+     * cumulative histogram since Init
+     * @return the latency in milliseconds
+     */
+    float GetPercentile( double percentile, bool bInterval = false )
+    {
+        const LatencyHistogram &hist = bInterval ? m_interval : m_cumulative;
+        return (float) hist.GetValueAtPercentile( percentile ) / 1000.f;
+    }
+
+    /**
+     * @brief Get the cumulative latency histogram, values are in microseconds.
+     * @return the cumulative latency histogram
+     */
+    const LatencyHistogram &GetHistogram() { return m_cumulative; }
+
+    /**
+     * @brief Dump the cumulative latency histogram into a binary file, which can be merged with
+     * the dumps of other runs or other samples by LatencyHistogram::Load.
+     * @param[in] path the file path
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Dump( std::string path ) { return m_cumulative.Save( path ); }
+
+private:
+    void Publish()
+    {
+        double elapsedMs = PROFILER_GET_MS( m_end, m_prevPercentile );
+        if ( elapsedMs > PROFILER_PERCENTILE_PERIOD_MS )
+        { /* the percentile query walks the histogram, so it is done periodically */
+            m_p50 = GetPercentile( 50.0 );
+            m_p90 = GetPercentile( 90.0 );
+            m_p99 = GetPercentile( 99.0 );
+            m_p999 = GetPercentile( 99.9 );
+            m_prevPercentile = m_end;
+        }
+
+        shared_ring::SharedMetrics_Stats_t stats = {};
+        stats.timestamp = shared_ring::SharedMetrics::GetTimestamp();
+        stats.count = m_count;
+        stats.rssBytes = m_rssBytes;
+        stats.fps = GetFPS();
+        stats.latencyAvg = m_avg;
+        stats.latencyMin = m_min;
+        stats.latencyMax = m_max;
+        stats.latencyP50 = m_p50;
+        stats.latencyP90 = m_p90;
+        stats.latencyP99 = m_p99;
+        stats.latencyP999 = m_p999;
+        (void) m_pMetrics->Update( m_metricsSlotId, stats );
+    }
+
 private:
     std::string m_name;
     uint64_t m_count = 0LLU;
@@ -136,10 +250,20 @@ private:
     float m_min = std::numeric_limits<float>::max();
     float m_avg = 0.f;
     float m_max = 0.f;
+    LatencyHistogram m_cumulative;
+    LatencyHistogram m_interval;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_begin;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_prev;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_prevShow;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_end;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_prevPercentile;
+    shared_ring::SharedMetrics *m_pMetrics = nullptr;
+    uint32_t m_metricsSlotId = SHARED_METRICS_INVALID_SLOT;
+    uint64_t m_rssBytes = 0;
+    float m_p50 = 0.f;
+    float m_p90 = 0.f;
+    float m_p99 = 0.f;
+    float m_p999 = 0.f;
 };
 
 }   // namespace sample
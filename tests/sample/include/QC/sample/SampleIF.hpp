@@ -12,6 +12,7 @@
 #include "QC/sample/DataTypes.hpp"
 #include "QC/sample/Profiler.hpp"
 #include "QC/sample/SysTrace.hpp"
+#include "QC/sample/shared_ring/SharedMetrics.hpp"
 
 #include <atomic>
 #include <map>
@@ -248,6 +249,14 @@ protected:
     QC_DECLARE_NODETRACE();
     QC_DECLARE_LOGGER();
 
+private:
+    /**
+     * @brief Publish the profiling result of this sample into the shared metrics memory.
+     * @param[in] shmName the shared metrics memory name, shared by all samples of the process
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e InitMetrics( std::string shmName );
+
 private:
 #if defined( WITH_RSM_V2 )
     rsm_acquire_cmd_v2 m_acquireCmdV2;
@@ -267,6 +276,10 @@ private:
 private:
     static std::map<std::string, Sample_CreateFunction_t> s_SampleMap;
     static std::atomic<uint32_t> s_nodeId;
+
+    static std::mutex s_metricsLock;
+    static shared_ring::SharedMetrics s_metrics;
+    static bool s_bMetricsReady;
 };   // class SampleIF
 
 }   // namespace sample
@@ -6,6 +6,8 @@
 #define _QC_SAMPLE_POST_PROC_CENTERNET_HPP_
 
 #include "OpenclIface.hpp"
+#include "QC/Infras/Memory/QuantizedTensorView.hpp"
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
 #include "QC/sample/SampleIF.hpp"
 
 using namespace QC;
@@ -53,6 +55,7 @@ private:
     void SetCLParams();
     void NMS( std::vector<Road2DObject_t> &boxes, float thres );
     float ComputeIou( const Road2DObject_t &box1, const Road2DObject_t &box2 );
+    void ShowPerfCounters();
 
 private:
     std::string m_inputTopicName;
@@ -105,6 +108,15 @@ private:
     DataPublisher<Road2DObjects_t> m_pub;
 
     BufferManager *m_pBufMgr = nullptr;
+
+    // the CPU performance counters sampled around the CPU post processing
+    bool m_bPerfCounters = false;
+    PerfCounters m_perfCounters;
+
+    // the CPU post processing works on the quantized heatmap, the sigmoid table is kept across
+    // frames and the candidates buffer is reused
+    QuantizedTensorView m_hmView;
+    std::vector<uint32_t> m_candidates;
 };   // class SamplePostProcCenternet
 
 }   // namespace sample
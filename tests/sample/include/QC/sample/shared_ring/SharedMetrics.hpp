@@ -0,0 +1,190 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#ifndef QC_SAMPLE_SHARED_METRICS_HPP
+#define QC_SAMPLE_SHARED_METRICS_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "QC/Common/Types.hpp"
+#include "QC/Infras/Log/Logger.hpp"
+#include "QC/sample/shared_ring/SharedMemory.hpp"
+
+namespace QC
+{
+namespace sample
+{
+namespace shared_ring
+{
+
+/** @brief magic "QMET" that identifies a shared metrics memory */
+#define SHARED_METRICS_MAGIC 0x514D4554u
+
+/** @brief layout version, must be increased if SharedMetrics_Memory_t is changed */
+#define SHARED_METRICS_VERSION 1u
+
+#ifndef SHARED_METRICS_NUM_ENTRIES
+#define SHARED_METRICS_NUM_ENTRIES 128
+#endif
+
+#ifndef SHARED_METRICS_NAME_MAX
+#define SHARED_METRICS_NAME_MAX 64
+#endif
+
+#ifndef SHARED_METRICS_DEFAULT_SHM_NAME
+#define SHARED_METRICS_DEFAULT_SHM_NAME "_qcnode_metrics"
+#endif
+
+#define SHARED_METRICS_MEMORY_UNINITIALIZED 0
+#define SHARED_METRICS_MEMORY_INITIALIZED 1
+
+#define SHARED_METRICS_INVALID_SLOT ( (uint32_t) 0xFFFFFFFF )
+
+/** @brief the max number of retries for a reader to get a consistent snapshot */
+#define SHARED_METRICS_READ_RETRY_MAX 1000
+
+/**
+ * @brief The metrics of one node, all latency values are in milliseconds.
+ * @note the percentile values are 0 if the producer does not support percentile tracking.
+ */
+typedef struct
+{
+    uint64_t timestamp; /**< steady clock time in nanoseconds of the last update */
+    uint64_t count;     /**< number of frames processed */
+    uint64_t rssBytes;  /**< resident set size of the producer process in bytes */
+    float fps;
+    float latencyAvg;
+    float latencyMin;
+    float latencyMax;
+    float latencyP50;
+    float latencyP90;
+    float latencyP99;
+    float latencyP999;
+} SharedMetrics_Stats_t;
+
+typedef struct SharedMetrics_Entry
+{
+    uint32_t seq;     /**< sequence lock, odd while the writer is updating the stats */
+    int32_t reserved; /**< if true, this entry was in used status */
+    int32_t pid;      /**< the producer process ID */
+    uint32_t nodeId;  /**< the producer node ID */
+    char name[SHARED_METRICS_NAME_MAX];
+    SharedMetrics_Stats_t stats;
+    uint8_t reserved0[256 - ( sizeof( uint32_t ) * 2 + sizeof( int32_t ) * 2 +
+                              SHARED_METRICS_NAME_MAX + sizeof( SharedMetrics_Stats_t ) )];
+} SharedMetrics_Entry_t;
+
+typedef struct SharedMetrics_Memory
+{
+    uint32_t magic;      /**< SHARED_METRICS_MAGIC */
+    uint32_t version;    /**< SHARED_METRICS_VERSION */
+    uint32_t entrySize;  /**< sizeof( SharedMetrics_Entry_t ) */
+    uint32_t numEntries; /**< SHARED_METRICS_NUM_ENTRIES */
+    int32_t status;      /**< status of this shared metrics memory */
+
+    uint8_t reserved0[4096 - ( sizeof( uint32_t ) * 4 + sizeof( int32_t ) )];
+
+    SharedMetrics_Entry_t entries[SHARED_METRICS_NUM_ENTRIES];
+} SharedMetrics_Memory_t;
+
+/**
+ * @brief Publish node metrics into a POSIX shared memory.
+ *
+ * Each node reserves one entry and updates it through a sequence lock, so a reader from another
+ * process can get a consistent snapshot by only reading the mapped memory, without any syscall
+ * and without blocking the writer.
+ */
+class SharedMetrics
+{
+public:
+    SharedMetrics();
+    ~SharedMetrics();
+
+    /**
+     * @brief Open the shared metrics memory, create it if not existed
+     * @param[in] shmName the shared memory name
+     * @param[in] bCreate create the shared memory if it does not exist
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Init( std::string shmName = SHARED_METRICS_DEFAULT_SHM_NAME, bool bCreate = true );
+
+    /**
+     * @brief Close the shared metrics memory
+     * @note the shared memory is not unlinked, so readers can still inspect the last values
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Deinit();
+
+    /**
+     * @brief Reserve an entry for a node
+     * @param[in] name the node name
+     * @param[in] nodeId the node ID
+     * @param[out] slotId the reserved entry index
+     * @return QC_STATUS_OK on success, others on failure
+     * @note an entry still reserved by a process that no longer exists is reclaimed, so the
+     * processes that crashed without Unregister do not use up the entries
+     */
+    QCStatus_e Register( std::string name, uint32_t nodeId, uint32_t &slotId );
+
+    /**
+     * @brief Release an entry reserved by Register
+     * @param[in] slotId the entry index
+     * @return QC_STATUS_OK on success, others on failure
+     */
+    QCStatus_e Unregister( uint32_t slotId );
+
+    /**
+     * @brief Update the stats of an entry
+     * @param[in] slotId the entry index
+     * @param[in] stats the stats
+     * @return QC_STATUS_OK on success, others on failure
+     * @note this API is lock free and does not do any syscall
+     */
+    QCStatus_e Update( uint32_t slotId, const SharedMetrics_Stats_t &stats );
+
+    /**
+     * @brief Read a consistent snapshot of an entry
+     * @param[in] slotId the entry index
+     * @param[out] entry the snapshot of the entry
+     * @return QC_STATUS_OK on success, QC_STATUS_OUT_OF_BOUND if the entry is not in use,
+     * QC_STATUS_TIMEOUT if no consistent snapshot can be got, others on failure
+     */
+    QCStatus_e Read( uint32_t slotId, SharedMetrics_Entry_t &entry );
+
+    /**
+     * @brief Get the number of entries of the shared metrics memory
+     * @return the number of entries
+     */
+    uint32_t GetNumEntries();
+
+    /**
+     * @brief Get the steady clock time in nanoseconds used as the stats timestamp
+     * @return the timestamp
+     */
+    static uint64_t GetTimestamp();
+
+    /**
+     * @brief Get the resident set size of the current process
+     * @return the resident set size in bytes, 0 if not available
+     */
+    static uint64_t GetRssBytes();
+
+private:
+    /* take over an entry whose owner process no longer exists */
+    bool Reclaim( SharedMetrics_Entry_t *pEntry, int32_t pid );
+
+private:
+    QC_DECLARE_LOGGER();
+    std::mutex m_lock;
+    SharedMemory m_shmem;
+    SharedMetrics_Memory_t *m_pMem = nullptr;
+};
+
+}   // namespace shared_ring
+}   // namespace sample
+}   // namespace QC
+
+#endif   // QC_SAMPLE_SHARED_METRICS_HPP
@@ -20,6 +20,10 @@ std::map<std::string, std::vector<std::reference_wrapper<QCBufferDescriptorBase_
 
 std::atomic<uint32_t> SampleIF::s_nodeId( 0 );
 
+std::mutex SampleIF::s_metricsLock;
+shared_ring::SharedMetrics SampleIF::s_metrics;
+bool SampleIF::s_bMetricsReady = false;
+
 
 SampleIF::SampleIF()
 {
@@ -88,6 +92,49 @@ QCStatus_e SampleIF::Init( std::string name, QCNodeType_e type )
     m_profiler.Init( name );
     m_systrace.Init( name );
 
+    const char *envValue = getenv( "QC_SAMPLE_METRICS" );
+    if ( nullptr != envValue )
+    {
+        std::string shmName = envValue;
+        if ( ( "YES" == shmName ) || shmName.empty() )
+        {
+            shmName = SHARED_METRICS_DEFAULT_SHM_NAME;
+        }
+        QCStatus_e ret2 = InitMetrics( shmName );
+        if ( QC_STATUS_OK != ret2 )
+        { /* metrics export is optional, ignore the error */
+            QC_WARN( "shared metrics %s not available: %d", shmName.c_str(), ret2 );
+        }
+    }
+
+    return ret;
+}
+
+QCStatus_e SampleIF::InitMetrics( std::string shmName )
+{
+    QCStatus_e ret = QC_STATUS_OK;
+    uint32_t slotId = SHARED_METRICS_INVALID_SLOT;
+
+    std::lock_guard<std::mutex> l( s_metricsLock );
+    if ( false == s_bMetricsReady )
+    {
+        ret = s_metrics.Init( shmName );
+        if ( QC_STATUS_OK == ret )
+        {
+            s_bMetricsReady = true;
+        }
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        ret = s_metrics.Register( m_name, m_nodeId.id, slotId );
+    }
+
+    if ( QC_STATUS_OK == ret )
+    {
+        m_profiler.SetMetrics( &s_metrics, slotId );
+    }
+
     return ret;
 }
 
@@ -82,32 +82,6 @@ static const char *s_pSourceBboxDet = KernelCode( __kernel void BboxDet(
     }
 } );
 
-static float fastPow( float p )
-{
-    float offset = ( p < 0 ) ? 1.0f : 0.0f;
-    float clipp = ( p < -126 ) ? -126.0f : p;
-    int32_t w = (int32_t) clipp;
-    float z = clipp - w + offset;
-    union
-    {
-        uint32_t i;
-        float f;
-    } v = { (uint32_t) ( ( 1 << 23 ) * ( clipp + 121.2740575f + 27.7280233f / ( 4.84252568f - z ) -
-                                         1.49012907f * z ) ) };
-
-    return v.f;
-}
-
-static float fastExp( float p )
-{
-    return fastPow( 1.442695040f * p );
-}
-
-static float sigmoid( float data )
-{
-    return 1. / ( 1. + fastExp( -data ) );
-}
-
 SamplePostProcCenternet::SamplePostProcCenternet() {}
 SamplePostProcCenternet::~SamplePostProcCenternet() {}
 
@@ -127,6 +101,7 @@ QCStatus_e SamplePostProcCenternet::ParseConfig( SampleConfig_t &config )
         QC_ERROR( "invalid processor type" );
         ret = QC_STATUS_BAD_ARGUMENTS;
     }
+    m_bPerfCounters = Get( config, "perf_counters", false );
 
     m_inputTopicName = Get( config, "input_topic", "" );
     if ( "" == m_inputTopicName )
@@ -166,6 +141,16 @@ QCStatus_e SamplePostProcCenternet::Init( std::string name, SampleConfig_t &conf
         ret = m_pub.Init( name, m_outputTopicName );
     }
 
+    if ( ( QC_STATUS_OK == ret ) && ( true == m_bPerfCounters ) &&
+         ( QC_PROCESSOR_CPU == m_processor ) )
+    {
+        QCStatus_e ret2 = m_perfCounters.Init();
+        if ( QC_STATUS_OK != ret2 )
+        {
+            QC_WARN( "performance counters not supported" );
+        }
+    }
+
     // OpenCL Init
     if ( QC_STATUS_OK == ret )
     {
@@ -240,7 +225,9 @@ void SamplePostProcCenternet::ThreadMain()
             {
                 PROFILER_BEGIN();
                 TRACE_BEGIN( tensors.FrameId( 0 ) );
+                m_perfCounters.Begin();
                 PostProcCPU( tensors );
+                m_perfCounters.End();
                 PROFILER_END();
                 TRACE_END( tensors.FrameId( 0 ) );
             }
@@ -446,7 +433,6 @@ void SamplePostProcCenternet::PostProcCPU( DataFrames_t &tensors )
         classNum = static_cast<int>( pTsHmDesc->dims[3] );
     }
 
-    uint8_t *hm = reinterpret_cast<uint8_t *>( hmDesc.pBuf );
     float hmScale = tensors.QuantScale( 0 );
     int32_t hmOffset = tensors.QuantOffset( 0 );
     uint8_t *wh = reinterpret_cast<uint8_t *>( whDesc.pBuf );
@@ -455,86 +441,81 @@ void SamplePostProcCenternet::PostProcCPU( DataFrames_t &tensors )
     uint8_t *reg = reinterpret_cast<uint8_t *>( regDesc.pBuf );
     float regScale = tensors.QuantScale( 2 );
     int32_t regOffset = tensors.QuantOffset( 2 );
-    const int kernel_size = 7;
 
-    std::vector<int> class_ids;
+    std::vector<bool> classSelected( classNum, false );
     if ( 80 == classNum )
     {
         // coco centernet, only care road object
         // https://github.com/amikelive/coco-labels/blob/master/coco-labels-paper.txt
-        class_ids = std::vector<int>{ 0, 2, 5, 7 };
+        for ( int cls : { 0, 2, 5, 7 } )
+        {
+            classSelected[cls] = true;
+        }
     }
     else
     {
-        class_ids.resize( classNum );
-        for ( int cls = 0; cls < classNum; cls++ )
+        classSelected.assign( classNum, true );
+    }
+
+    /* the sigmoid is monotonic, so the score threshold is applied to the quantized heatmap and
+     * only the elements passing it are dequantized */
+    m_candidates.clear();
+    if ( nullptr != pTsHmDesc )
+    {
+        QCStatus_e ret = m_hmView.Init( *pTsHmDesc, hmScale, hmOffset );
+        if ( QC_STATUS_OK == ret )
+        {
+            ret = m_hmView.BuildSigmoidLut();
+        }
+        if ( QC_STATUS_OK == ret )
         {
-            class_ids[cls] = classNum;
+            ret = m_hmView.Select( m_hmView.GetSigmoidRawThreshold( m_scoreThreshold ), 0,
+                                   (size_t) H * W * classNum, 1, m_candidates );
+        }
+        if ( QC_STATUS_OK != ret )
+        {
+            QC_ERROR( "heatmap is not a valid quantized tensor" );
+            m_candidates.clear();
         }
     }
 
-    for ( int y = 0; y < H; y++ )
+    for ( uint32_t idx : m_candidates )
     {
-        for ( int x = 0; x < W; x++ )
+        int cls = static_cast<int>( idx ) % classNum;
+        if ( false == classSelected[cls] )
         {
-            for ( int cls : class_ids )
-            {
-                int idx = ( y * W + x ) * classNum + cls;
-                float objProb = sigmoid( U2F( hm, idx ) );
-                if ( objProb > m_scoreThreshold )
-                {
-                    int padding = ( kernel_size - 1 ) / 2;
-                    int offset = -padding;
-                    int l, m;
-                    float max = -1;
-                    int max_index = 0;
-                    for ( l = 0; l < kernel_size; ++l )
-                    {
-                        for ( m = 0; m < kernel_size; ++m )
-                        {
-                            int cur_x = offset + l + x;
-                            int cur_y = offset + m + y;
-                            int cur_index = ( y * W + x ) * classNum + cls;
-                            int valid = ( ( cur_x >= 0 ) && ( cur_x < W ) && ( cur_y >= 0 ) &&
-                                          ( cur_y < H ) );
-                            float val = ( valid != 0 ) ? sigmoid( U2F( hm, cur_index ) ) : -1;
-                            max_index = ( val > max ) ? cur_index : max_index;
-                            max = ( val > max ) ? val : max;
-                        }
-                    }
-
-                    if ( idx == max_index )
-                    {
-                        int reg_index = ( y * W + x ) * 2;
-                        float c_x, c_y;
-                        Road2DObject_t det;
-                        c_x = x + U2F( reg, reg_index );
-                        c_y = y + U2F( reg, reg_index + 1 );
-                        float topX = ( c_x - U2F( wh, reg_index ) / 2 ) / W;
-                        float topY = ( c_y - U2F( wh, reg_index + 1 ) / 2 ) / H;
-                        float bottomX = ( c_x + U2F( wh, reg_index ) / 2 ) / W;
-                        float bottomY = ( c_y + U2F( wh, reg_index + 1 ) / 2 ) / H;
-                        topX = ( ( topX > 0 ) ? topX * m_camWidth : 0 ) + m_roiX;
-                        topY = ( ( topY > 0 ) ? topY * m_camHeight : 0 ) + m_roiY;
-                        bottomX = ( ( bottomX < 1 ) ? bottomX : 0.99 ) * m_camWidth + m_roiX;
-                        bottomY = ( ( bottomY < 1 ) ? bottomY : 0.99 ) * m_camHeight + m_roiY;
-                        det.classId = cls;
-                        det.prob = objProb;
-                        if ( ( topX < bottomX ) && ( topY < bottomY ) )
-                        {
-                            det.points[0] = Point2D_t{ topX, topY };
-                            det.points[1] = Point2D_t{ bottomX, topY };
-                            det.points[2] = Point2D_t{ bottomX, bottomY };
-                            det.points[3] = Point2D_t{ topX, bottomY };
-                            objs.objs.push_back( det );
-                            QC_DEBUG( "[frame %" PRIu64 "- %" PRIu64
-                                      "] class=%d score=%.3f points=[%.3f %.3f %.3f %.3f]",
-                                      tensors.FrameId( 0 ), objs.objs.size() - 1, det.classId,
-                                      det.prob, topX, topY, bottomX, bottomY );
-                        }
-                    }
-                }
-            }
+            continue;
+        }
+
+        int x = ( static_cast<int>( idx ) / classNum ) % W;
+        int y = ( static_cast<int>( idx ) / classNum ) / W;
+        float objProb = m_hmView.Sigmoid( idx );
+        int reg_index = ( y * W + x ) * 2;
+        float c_x, c_y;
+        Road2DObject_t det;
+        c_x = x + U2F( reg, reg_index );
+        c_y = y + U2F( reg, reg_index + 1 );
+        float topX = ( c_x - U2F( wh, reg_index ) / 2 ) / W;
+        float topY = ( c_y - U2F( wh, reg_index + 1 ) / 2 ) / H;
+        float bottomX = ( c_x + U2F( wh, reg_index ) / 2 ) / W;
+        float bottomY = ( c_y + U2F( wh, reg_index + 1 ) / 2 ) / H;
+        topX = ( ( topX > 0 ) ? topX * m_camWidth : 0 ) + m_roiX;
+        topY = ( ( topY > 0 ) ? topY * m_camHeight : 0 ) + m_roiY;
+        bottomX = ( ( bottomX < 1 ) ? bottomX : 0.99 ) * m_camWidth + m_roiX;
+        bottomY = ( ( bottomY < 1 ) ? bottomY : 0.99 ) * m_camHeight + m_roiY;
+        det.classId = cls;
+        det.prob = objProb;
+        if ( ( topX < bottomX ) && ( topY < bottomY ) )
+        {
+            det.points[0] = Point2D_t{ topX, topY };
+            det.points[1] = Point2D_t{ bottomX, topY };
+            det.points[2] = Point2D_t{ bottomX, bottomY };
+            det.points[3] = Point2D_t{ topX, bottomY };
+            objs.objs.push_back( det );
+            QC_DEBUG( "[frame %" PRIu64 "- %" PRIu64
+                      "] class=%d score=%.3f points=[%.3f %.3f %.3f %.3f]",
+                      tensors.FrameId( 0 ), objs.objs.size() - 1, det.classId, det.prob, topX,
+                      topY, bottomX, bottomY );
         }
     }
 
@@ -656,10 +637,35 @@ QCStatus_e SamplePostProcCenternet::Stop()
     }
 
     PROFILER_SHOW();
+    ShowPerfCounters();
 
     return ret;
 }
 
+void SamplePostProcCenternet::ShowPerfCounters()
+{
+    QCNodePerfCounters_t counters;
+
+    if ( m_perfCounters.IsEnabled() )
+    {
+        m_perfCounters.Get( counters );
+        if ( counters.numSamples > 0 )
+        {
+            printf( "%-16s: PERF COUNTERS AVG over %" PRIu64 " frames:", m_name.c_str(),
+                    counters.numSamples );
+            for ( uint32_t i = 0; i < QCNODE_PERF_COUNTER_MAX; i++ )
+            {
+                if ( 0 != ( counters.available & ( 1u << i ) ) )
+                {
+                    printf( " %s=%.1f", PerfCounters::GetName( (QCNodePerfCounterType_e) i ),
+                            (double) counters.total[i] / (double) counters.numSamples );
+                }
+            }
+            printf( "\n" );
+        }
+    }
+}
+
 QCStatus_e SamplePostProcCenternet::Deinit()
 {
     QCStatus_e ret = QC_STATUS_OK;
@@ -679,6 +685,9 @@ QCStatus_e SamplePostProcCenternet::Deinit()
         BufferManager::Put( m_pBufMgr );
         m_pBufMgr = nullptr;
     }
+
+    (void) m_perfCounters.Deinit();
+
     return ret;
 }
 
@@ -0,0 +1,218 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+
+#include "QC/sample/LatencyHistogram.hpp"
+
+using namespace QC;
+using namespace QC::sample;
+
+static std::string GetDumpPath( const char *pSuffix )
+{
+    return "/tmp/gtest_histogram_" + std::to_string( (int) getpid() ) + "_" + pSuffix + ".bin";
+}
+
+/* the max relative error of a value above the exact range */
+static double GetMaxError( uint64_t value )
+{
+    return (double) value / (double) LatencyHistogram::SUB_BUCKET_HALF_COUNT;
+}
+
+TEST( LatencyHistogram, SANITY_BucketIndex )
+{
+    /* the values below SUB_BUCKET_COUNT have one bucket each */
+    for ( uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT; value++ )
+    {
+        EXPECT_EQ( value, LatencyHistogram::GetIndex( value ) );
+        EXPECT_EQ( value, LatencyHistogram::GetHighestEquivalentValue( (uint32_t) value ) );
+    }
+
+    /* the first bucket of each power of 2 range follows the last of the previous range */
+    uint32_t index = LatencyHistogram::GetIndex( LatencyHistogram::SUB_BUCKET_COUNT - 1 );
+    for ( uint32_t bit = LATENCY_HISTOGRAM_SUB_BUCKET_BITS; bit < LATENCY_HISTOGRAM_MAX_VALUE_BITS;
+          bit++ )
+    {
+        uint64_t value = 1llu << bit;
+        EXPECT_EQ( index + 1, LatencyHistogram::GetIndex( value ) );
+        index = LatencyHistogram::GetIndex( ( value << 1 ) - 1 );
+        EXPECT_EQ( index, LatencyHistogram::GetIndex( value ) +
+                                  LatencyHistogram::SUB_BUCKET_HALF_COUNT - 1 );
+    }
+    EXPECT_EQ( LatencyHistogram::NUM_BUCKETS - 1, index );
+
+    /* a value is in [lowest, highest] of its bucket and the bucket width bounds the error */
+    for ( uint64_t value = LatencyHistogram::SUB_BUCKET_COUNT;
+          value < LatencyHistogram::MAX_VALUE; value = value * 3 / 2 + 7 )
+    {
+        uint32_t idx = LatencyHistogram::GetIndex( value );
+        uint64_t highest = LatencyHistogram::GetHighestEquivalentValue( idx );
+        uint64_t lowest = LatencyHistogram::GetHighestEquivalentValue( idx - 1 ) + 1;
+        EXPECT_LE( lowest, value );
+        EXPECT_GE( highest, value );
+        EXPECT_LT( (double) ( highest - lowest ), GetMaxError( value ) );
+    }
+
+    /* the values above MAX_VALUE are counted in the last bucket */
+    EXPECT_EQ( LatencyHistogram::NUM_BUCKETS - 1,
+               LatencyHistogram::GetIndex( LatencyHistogram::MAX_VALUE ) );
+    EXPECT_EQ( LatencyHistogram::NUM_BUCKETS - 1, LatencyHistogram::GetIndex( UINT64_MAX ) );
+    EXPECT_EQ( LatencyHistogram::MAX_VALUE,
+               LatencyHistogram::GetHighestEquivalentValue( LatencyHistogram::NUM_BUCKETS - 1 ) );
+}
+
+TEST( LatencyHistogram, SANITY_Percentile )
+{
+    LatencyHistogram *pHist = new LatencyHistogram();
+
+    EXPECT_EQ( 0, pHist->GetCount() );
+    EXPECT_EQ( 0, pHist->GetMin() );
+    EXPECT_EQ( 0, pHist->GetMax() );
+    EXPECT_EQ( 0, pHist->GetValueAtPercentile( 50.0 ) );
+
+    /* small values are exact */
+    for ( uint64_t value = 1; value <= 100; value++ )
+    {
+        pHist->Record( value );
+    }
+    EXPECT_EQ( 50, pHist->GetValueAtPercentile( 50.0 ) );
+    EXPECT_EQ( 99, pHist->GetValueAtPercentile( 99.0 ) );
+    EXPECT_EQ( 1, pHist->GetValueAtPercentile( 0.0 ) );
+    EXPECT_EQ( 100, pHist->GetValueAtPercentile( 100.0 ) );
+    EXPECT_EQ( 100, pHist->GetValueAtPercentile( 200.0 ) );
+    EXPECT_DOUBLE_EQ( 50.5, pHist->GetMean() );
+
+    /* large values are within the bucket error */
+    pHist->Reset();
+    EXPECT_EQ( 0, pHist->GetCount() );
+    for ( uint64_t value = 1; value <= 1000000; value++ )
+    {
+        pHist->Record( value );
+    }
+    EXPECT_EQ( 1000000, pHist->GetCount() );
+    EXPECT_EQ( 1, pHist->GetMin() );
+    EXPECT_EQ( 1000000, pHist->GetMax() );
+    const double percentiles[] = { 10.0, 50.0, 90.0, 99.0, 99.9 };
+    for ( double percentile : percentiles )
+    {
+        double expected = percentile * 10000.0;
+        uint64_t value = pHist->GetValueAtPercentile( percentile );
+        EXPECT_GE( (double) value, expected );
+        EXPECT_LE( (double) value - expected, GetMaxError( (uint64_t) expected ) );
+    }
+    EXPECT_EQ( 1000000, pHist->GetValueAtPercentile( 100.0 ) );
+
+    /* a value above the trackable range keeps its exact max but is counted as MAX_VALUE */
+    pHist->Reset();
+    pHist->Record( 10 );
+    pHist->Record( LatencyHistogram::MAX_VALUE + 100 );
+    EXPECT_EQ( LatencyHistogram::MAX_VALUE + 100, pHist->GetMax() );
+    EXPECT_EQ( 10, pHist->GetValueAtPercentile( 50.0 ) );
+    EXPECT_EQ( LatencyHistogram::MAX_VALUE, pHist->GetValueAtPercentile( 100.0 ) );
+
+    delete pHist;
+}
+
+TEST( LatencyHistogram, SANITY_Merge )
+{
+    LatencyHistogram *pAll = new LatencyHistogram();
+    LatencyHistogram *pLow = new LatencyHistogram();
+    LatencyHistogram *pHigh = new LatencyHistogram();
+
+    for ( uint64_t value = 1; value <= 20000; value++ )
+    {
+        pAll->Record( value * 7 );
+        if ( value <= 5000 )
+        {
+            pLow->Record( value * 7 );
+        }
+        else
+        {
+            pHigh->Record( value * 7 );
+        }
+    }
+
+    pLow->Merge( *pHigh );
+    EXPECT_EQ( pAll->GetCount(), pLow->GetCount() );
+    EXPECT_EQ( pAll->GetMin(), pLow->GetMin() );
+    EXPECT_EQ( pAll->GetMax(), pLow->GetMax() );
+    EXPECT_DOUBLE_EQ( pAll->GetMean(), pLow->GetMean() );
+    for ( double percentile = 0.0; percentile <= 100.0; percentile += 0.5 )
+    {
+        EXPECT_EQ( pAll->GetValueAtPercentile( percentile ),
+                   pLow->GetValueAtPercentile( percentile ) );
+    }
+
+    /* merging an empty histogram changes nothing */
+    pHigh->Reset();
+    pLow->Merge( *pHigh );
+    EXPECT_EQ( pAll->GetCount(), pLow->GetCount() );
+    EXPECT_EQ( pAll->GetMin(), pLow->GetMin() );
+    EXPECT_EQ( pAll->GetValueAtPercentile( 50.0 ), pLow->GetValueAtPercentile( 50.0 ) );
+
+    delete pAll;
+    delete pLow;
+    delete pHigh;
+}
+
+TEST( LatencyHistogram, SANITY_SaveLoad )
+{
+    std::string path = GetDumpPath( "saveload" );
+    LatencyHistogram *pHist = new LatencyHistogram();
+    LatencyHistogram *pLoaded = new LatencyHistogram();
+
+    for ( uint64_t value = 1; value <= 50000; value++ )
+    {
+        pHist->Record( value * 3 );
+    }
+    ASSERT_EQ( QC_STATUS_OK, pHist->Save( path ) );
+
+    ASSERT_EQ( QC_STATUS_OK, pLoaded->Load( path ) );
+    EXPECT_EQ( pHist->GetCount(), pLoaded->GetCount() );
+    EXPECT_EQ( pHist->GetMin(), pLoaded->GetMin() );
+    EXPECT_EQ( pHist->GetMax(), pLoaded->GetMax() );
+    EXPECT_DOUBLE_EQ( pHist->GetMean(), pLoaded->GetMean() );
+    for ( double percentile = 0.0; percentile <= 100.0; percentile += 0.5 )
+    {
+        EXPECT_EQ( pHist->GetValueAtPercentile( percentile ),
+                   pLoaded->GetValueAtPercentile( percentile ) );
+    }
+
+    /* Load merges into the loaded counts */
+    ASSERT_EQ( QC_STATUS_OK, pLoaded->Load( path ) );
+    EXPECT_EQ( 2 * pHist->GetCount(), pLoaded->GetCount() );
+    EXPECT_EQ( pHist->GetValueAtPercentile( 50.0 ), pLoaded->GetValueAtPercentile( 50.0 ) );
+
+    /* a dump of another layout is rejected and leaves the histogram unchanged */
+    FILE *pFile = fopen( path.c_str(), "r+b" );
+    ASSERT_NE( nullptr, pFile );
+    uint32_t magic = 0;
+    ASSERT_EQ( 1, fwrite( &magic, sizeof( magic ), 1, pFile ) );
+    (void) fclose( pFile );
+    EXPECT_EQ( QC_STATUS_UNSUPPORTED, pLoaded->Load( path ) );
+    EXPECT_EQ( 2 * pHist->GetCount(), pLoaded->GetCount() );
+
+    /* a truncated dump is rejected */
+    ASSERT_EQ( QC_STATUS_OK, pHist->Save( path ) );
+    ASSERT_EQ( 0, truncate( path.c_str(), sizeof( LatencyHistogram::DumpHeader_t ) + 8 ) );
+    EXPECT_EQ( QC_STATUS_FAIL, pLoaded->Load( path ) );
+    EXPECT_EQ( 2 * pHist->GetCount(), pLoaded->GetCount() );
+
+    (void) remove( path.c_str() );
+    EXPECT_EQ( QC_STATUS_FAIL, pLoaded->Load( path ) );
+
+    delete pHist;
+    delete pLoaded;
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    return RUN_ALL_TESTS();
+}
+#endif
@@ -0,0 +1,234 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "gtest/gtest.h"
+#include <atomic>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "QC/sample/shared_ring/SharedMetrics.hpp"
+
+using namespace QC;
+using namespace QC::sample::shared_ring;
+
+static std::string GetShmName( const char *pSuffix )
+{
+    return "/_gtest_metrics_" + std::to_string( (int) getpid() ) + "_" + pSuffix;
+}
+
+TEST( SharedMetrics, SANITY_Register )
+{
+    std::string shmName = GetShmName( "register" );
+    SharedMetrics metrics;
+    SharedMetrics reader;
+    SharedMetrics_Entry_t entry;
+    uint32_t slotId0 = SHARED_METRICS_INVALID_SLOT;
+    uint32_t slotId1 = SHARED_METRICS_INVALID_SLOT;
+
+    (void) shm_unlink( shmName.c_str() );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Init( shmName ) );
+    EXPECT_EQ( QC_STATUS_ALREADY, metrics.Init( shmName ) );
+    /* a reader opens the existing memory only */
+    ASSERT_EQ( QC_STATUS_OK, reader.Init( shmName, false ) );
+
+    ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node0", 10, slotId0 ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node1", 11, slotId1 ) );
+    EXPECT_NE( slotId0, slotId1 );
+
+    ASSERT_EQ( QC_STATUS_OK, reader.Read( slotId1, entry ) );
+    EXPECT_STREQ( "node1", entry.name );
+    EXPECT_EQ( 11, entry.nodeId );
+    EXPECT_EQ( (int32_t) getpid(), entry.pid );
+    EXPECT_EQ( 0, entry.seq & 1 );
+    EXPECT_EQ( 0, entry.stats.count );
+
+    /* an unregistered entry is not readable and is reused by the next Register */
+    EXPECT_EQ( QC_STATUS_OK, metrics.Unregister( slotId0 ) );
+    EXPECT_EQ( QC_STATUS_OUT_OF_BOUND, reader.Read( slotId0, entry ) );
+    uint32_t slotId2 = SHARED_METRICS_INVALID_SLOT;
+    ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node2", 12, slotId2 ) );
+    EXPECT_EQ( slotId0, slotId2 );
+
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, metrics.Unregister( SHARED_METRICS_NUM_ENTRIES ) );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, reader.Read( SHARED_METRICS_NUM_ENTRIES, entry ) );
+
+    EXPECT_EQ( QC_STATUS_OK, reader.Deinit() );
+    EXPECT_EQ( QC_STATUS_OK, metrics.Deinit() );
+    EXPECT_EQ( QC_STATUS_BAD_STATE, metrics.Deinit() );
+    (void) shm_unlink( shmName.c_str() );
+}
+
+TEST( SharedMetrics, SANITY_Update )
+{
+    std::string shmName = GetShmName( "update" );
+    SharedMetrics metrics;
+    SharedMetrics_Stats_t stats = {};
+    SharedMetrics_Entry_t entry;
+    uint32_t slotId = SHARED_METRICS_INVALID_SLOT;
+
+    (void) shm_unlink( shmName.c_str() );
+    EXPECT_EQ( QC_STATUS_BAD_STATE, metrics.Update( 0, stats ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Init( shmName ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node", 1, slotId ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Read( slotId, entry ) );
+    uint32_t seq = entry.seq;
+
+    stats.timestamp = SharedMetrics::GetTimestamp();
+    stats.count = 100;
+    stats.fps = 30.0f;
+    stats.latencyAvg = 5.0f;
+    stats.latencyP99 = 9.0f;
+    ASSERT_EQ( QC_STATUS_OK, metrics.Update( slotId, stats ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Read( slotId, entry ) );
+    EXPECT_EQ( seq + 2, entry.seq );
+    EXPECT_EQ( stats.timestamp, entry.stats.timestamp );
+    EXPECT_EQ( 100, entry.stats.count );
+    EXPECT_FLOAT_EQ( 30.0f, entry.stats.fps );
+    EXPECT_FLOAT_EQ( 5.0f, entry.stats.latencyAvg );
+    EXPECT_FLOAT_EQ( 9.0f, entry.stats.latencyP99 );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, metrics.Update( SHARED_METRICS_NUM_ENTRIES, stats ) );
+
+    EXPECT_EQ( QC_STATUS_OK, metrics.Deinit() );
+    (void) shm_unlink( shmName.c_str() );
+}
+
+TEST( SharedMetrics, L2_SeqlockRead )
+{
+    std::string shmName = GetShmName( "seqlock" );
+    SharedMetrics metrics;
+    SharedMetrics reader;
+    uint32_t slotId = SHARED_METRICS_INVALID_SLOT;
+    std::atomic<bool> bDone( false );
+
+    (void) shm_unlink( shmName.c_str() );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Init( shmName ) );
+    ASSERT_EQ( QC_STATUS_OK, reader.Init( shmName, false ) );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node", 1, slotId ) );
+    SharedMetrics_Stats_t first = {};
+    ASSERT_EQ( QC_STATUS_OK, metrics.Update( slotId, first ) );
+
+    /* all the fields of one update carry the same value, so a torn read is detected */
+    std::thread writer( [&]() {
+        SharedMetrics_Stats_t stats;
+        for ( uint64_t i = 1; i <= 1000000; i++ )
+        {
+            stats.timestamp = i;
+            stats.count = i;
+            stats.rssBytes = i;
+            stats.fps = (float) ( i & 0xFFFF );
+            stats.latencyAvg = stats.fps;
+            stats.latencyMin = stats.fps;
+            stats.latencyMax = stats.fps;
+            stats.latencyP50 = stats.fps;
+            stats.latencyP90 = stats.fps;
+            stats.latencyP99 = stats.fps;
+            stats.latencyP999 = stats.fps;
+            (void) metrics.Update( slotId, stats );
+        }
+        bDone = true;
+    } );
+
+    uint32_t numReads = 0;
+    uint32_t numTorn = 0;
+    uint64_t lastCount = 0;
+    do
+    {
+        SharedMetrics_Entry_t entry;
+        QCStatus_e ret = reader.Read( slotId, entry );
+        if ( QC_STATUS_OK == ret )
+        {
+            SharedMetrics_Stats_t &stats = entry.stats;
+            float value = (float) ( stats.count & 0xFFFF );
+            if ( ( 0 != ( entry.seq & 1 ) ) || ( stats.count != stats.timestamp ) ||
+                 ( stats.count != stats.rssBytes ) || ( stats.count < lastCount ) ||
+                 ( value != stats.fps ) || ( value != stats.latencyAvg ) ||
+                 ( value != stats.latencyMin ) || ( value != stats.latencyMax ) ||
+                 ( value != stats.latencyP50 ) || ( value != stats.latencyP90 ) ||
+                 ( value != stats.latencyP99 ) || ( value != stats.latencyP999 ) )
+            {
+                numTorn++;
+            }
+            lastCount = stats.count;
+            numReads++;
+        }
+        else
+        { /* the writer kept the entry busy for all the retries */
+            EXPECT_EQ( QC_STATUS_TIMEOUT, ret );
+        }
+    } while ( false == bDone );
+
+    writer.join();
+    EXPECT_GT( numReads, 0 );
+    EXPECT_EQ( 0, numTorn );
+
+    EXPECT_EQ( QC_STATUS_OK, reader.Deinit() );
+    EXPECT_EQ( QC_STATUS_OK, metrics.Deinit() );
+    (void) shm_unlink( shmName.c_str() );
+}
+
+TEST( SharedMetrics, L2_ReclaimDeadOwner )
+{
+    std::string shmName = GetShmName( "reclaim" );
+    SharedMetrics metrics;
+    SharedMetrics_Entry_t entry;
+    std::vector<uint32_t> slotIds;
+    uint32_t slotId = SHARED_METRICS_INVALID_SLOT;
+
+    (void) shm_unlink( shmName.c_str() );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Init( shmName ) );
+
+    /* a child registers and exits without Unregister, as if it crashed */
+    pid_t child = fork();
+    ASSERT_LE( 0, child );
+    if ( 0 == child )
+    {
+        SharedMetrics childMetrics;
+        uint32_t childSlotId;
+        int code = 1;
+        if ( ( QC_STATUS_OK == childMetrics.Init( shmName, false ) ) &&
+             ( QC_STATUS_OK == childMetrics.Register( "crashed", 7, childSlotId ) ) )
+        {
+            code = 0;
+        }
+        _exit( code );
+    }
+    int status = -1;
+    ASSERT_EQ( child, waitpid( child, &status, 0 ) );
+    ASSERT_TRUE( WIFEXITED( status ) );
+    ASSERT_EQ( 0, WEXITSTATUS( status ) );
+
+    ASSERT_EQ( QC_STATUS_OK, metrics.Read( 0, entry ) );
+    EXPECT_EQ( (int32_t) child, entry.pid );
+    EXPECT_STREQ( "crashed", entry.name );
+
+    /* all the entries are usable again, the one of the dead child included */
+    for ( uint32_t i = 0; i < SHARED_METRICS_NUM_ENTRIES; i++ )
+    {
+        ASSERT_EQ( QC_STATUS_OK, metrics.Register( "node", i, slotId ) );
+        slotIds.push_back( slotId );
+    }
+    EXPECT_EQ( 0, slotIds[0] );
+    ASSERT_EQ( QC_STATUS_OK, metrics.Read( 0, entry ) );
+    EXPECT_EQ( (int32_t) getpid(), entry.pid );
+    EXPECT_EQ( 0, entry.nodeId );
+
+    /* the entries of a live process are never reclaimed */
+    EXPECT_EQ( QC_STATUS_NO_RESOURCE, metrics.Register( "node", 0, slotId ) );
+    EXPECT_EQ( SHARED_METRICS_INVALID_SLOT, slotId );
+
+    EXPECT_EQ( QC_STATUS_OK, metrics.Deinit() );
+    (void) shm_unlink( shmName.c_str() );
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    return RUN_ALL_TESTS();
+}
+#endif
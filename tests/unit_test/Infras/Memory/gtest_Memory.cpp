@@ -199,6 +199,13 @@ TEST( Memory, SANITY_ImageAllocateByWHF )
     ASSERT_LE( 1024 * 3, imgDescM.stride[0] );
     ASSERT_LE( 768, imgDescM.actualHeight[0] );
 
+    /* testing get the last batch of the shared image */
+    status = imgDesc.GetImageDesc( imgDescM, 6 );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( imgDescM.validSize * 6, imgDescM.offset );
+    status = imgDesc.GetImageDesc( imgDescM, 6, 2 );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+
     imgDesc.type = QC_BUFFER_TYPE_RAW;
     status = imgDesc.GetImageDesc( imgDescM, 3 );
     ASSERT_EQ( QC_STATUS_UNSUPPORTED, status );
@@ -1000,6 +1007,57 @@ TEST( Memory, L2_Tensor )
         status = bufMgr.Allocate( tensorProp, tsDesc );
         ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
     }
+
+    {
+        TensorDescriptor_t tsDesc;
+        TensorDescriptor_t tsDescB;
+        TensorDescriptor_t tsDescB2;
+        TensorProps_t tensorProp( QC_TENSOR_TYPE_UFIXED_POINT_8, { 4, 64, 48, 3 } );
+
+        status = tsDesc.GetTensorDesc( tsDescB, 0 );
+        ASSERT_EQ( QC_STATUS_INVALID_BUF, status );
+
+        status = bufMgr.Allocate( tensorProp, tsDesc );
+        ASSERT_EQ( QC_STATUS_OK, status );
+
+        /* testing get the per batch views of the batched tensor */
+        for ( uint32_t i = 0; i < 4; i++ )
+        {
+            status = tsDesc.GetTensorDesc( tsDescB, i );
+            ASSERT_EQ( QC_STATUS_OK, status );
+            ASSERT_EQ( tsDesc.pBuf, tsDescB.pBuf );
+            ASSERT_EQ( tsDesc.size, tsDescB.size );
+            ASSERT_EQ( 64 * 48 * 3, tsDescB.validSize );
+            ASSERT_EQ( 64 * 48 * 3 * i, tsDescB.offset );
+            ASSERT_EQ( 1, tsDescB.dims[0] );
+            ASSERT_EQ( 64, tsDescB.dims[1] );
+            ASSERT_EQ( 4, tsDescB.numDims );
+        }
+
+        /* testing get the middle 2 batches, and a batch of them */
+        status = tsDesc.GetTensorDesc( tsDescB, 1, 2 );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        ASSERT_EQ( 2, tsDescB.dims[0] );
+        ASSERT_EQ( 64 * 48 * 3 * 2, tsDescB.validSize );
+        status = tsDescB.GetTensorDesc( tsDescB2, 1 );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        ASSERT_EQ( 64 * 48 * 3 * 2, tsDescB2.offset );
+
+        status = tsDesc.GetTensorDesc( tsDescB, 4 );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        status = tsDesc.GetTensorDesc( tsDescB, 3, 2 );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        status = tsDesc.GetTensorDesc( tsDescB, 0, 0 );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+
+        tsDesc.type = QC_BUFFER_TYPE_RAW;
+        status = tsDesc.GetTensorDesc( tsDescB, 0 );
+        ASSERT_EQ( QC_STATUS_UNSUPPORTED, status );
+        tsDesc.type = QC_BUFFER_TYPE_TENSOR;
+
+        status = bufMgr.Free( tsDesc );
+        ASSERT_EQ( QC_STATUS_OK, status );
+    }
 }
 
 TEST( Memory, L2_Image2Tensor )
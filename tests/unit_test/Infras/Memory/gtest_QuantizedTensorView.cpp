@@ -0,0 +1,223 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#include "QC/Infras/Memory/QuantizedTensorView.hpp"
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace QC;
+using namespace QC::Memory;
+
+static void SetupTensor( TensorDescriptor_t &tensor, QCTensorType_e tensorType, void *pData,
+                         size_t size, std::vector<uint32_t> dims )
+{
+    tensor.pBuf = pData;
+    tensor.size = size;
+    tensor.validSize = size;
+    tensor.offset = 0;
+    tensor.type = QC_BUFFER_TYPE_TENSOR;
+    tensor.tensorType = tensorType;
+    tensor.numDims = (uint32_t) dims.size();
+    std::copy( dims.begin(), dims.end(), tensor.dims );
+}
+
+TEST( QuantizedTensorView, Dequantize )
+{
+    /* 37 elements, so both the vector path and the scalar tail are used */
+    std::vector<uint8_t> u8( 37 );
+    std::vector<int8_t> s8( 37 );
+    std::vector<uint16_t> u16( 37 );
+    std::vector<int16_t> s16( 37 );
+    for ( size_t i = 0; i < u8.size(); i++ )
+    {
+        u8[i] = (uint8_t) ( i * 7 );
+        s8[i] = (int8_t) ( i * 7 - 128 );
+        u16[i] = (uint16_t) ( i * 1771 );
+        s16[i] = (int16_t) ( i * 1771 - 32768 );
+    }
+
+    struct
+    {
+        QCTensorType_e tensorType;
+        void *pData;
+        size_t size;
+    } cases[] = {
+            { QC_TENSOR_TYPE_UFIXED_POINT_8, u8.data(), u8.size() },
+            { QC_TENSOR_TYPE_SFIXED_POINT_8, s8.data(), s8.size() },
+            { QC_TENSOR_TYPE_UFIXED_POINT_16, u16.data(), u16.size() * sizeof( uint16_t ) },
+            { QC_TENSOR_TYPE_SFIXED_POINT_16, s16.data(), s16.size() * sizeof( int16_t ) },
+    };
+
+    for ( auto &c : cases )
+    {
+        TensorDescriptor_t tensor;
+        QuantizedTensorView view;
+        SetupTensor( tensor, c.tensorType, c.pData, c.size, { 1, 37 } );
+        tensor.quantScale = 0.0173f;
+        tensor.quantOffset = -93;
+        ASSERT_EQ( QC_STATUS_OK, view.Init( tensor ) );
+        ASSERT_EQ( 37u, view.GetNumElements() );
+
+        std::vector<float> out( 37 );
+        ASSERT_EQ( QC_STATUS_OK, view.Dequantize( 0, 37, out.data() ) );
+        for ( size_t i = 0; i < out.size(); i++ )
+        {
+            float expected = (float) ( view.GetRaw( i ) - 93 ) * 0.0173f;
+            EXPECT_EQ( expected, out[i] ) << "type " << c.tensorType << " index " << i;
+            EXPECT_EQ( expected, view.Dequantize( i ) );
+        }
+
+        ASSERT_EQ( QC_STATUS_OK, view.Dequantize( 3, 30, out.data() ) );
+        EXPECT_EQ( view.Dequantize( 3 ), out[0] );
+        EXPECT_EQ( view.Dequantize( 32 ), out[29] );
+        EXPECT_EQ( QC_STATUS_OUT_OF_BOUND, view.Dequantize( 8, 30, out.data() ) );
+    }
+}
+
+TEST( QuantizedTensorView, SigmoidAndThreshold )
+{
+    std::vector<uint8_t> hm( 16 * 16 * 4 );
+    for ( size_t i = 0; i < hm.size(); i++ )
+    {
+        hm[i] = (uint8_t) ( ( i * 37 ) & 0xFF );
+    }
+
+    TensorDescriptor_t tensor;
+    QuantizedTensorView view;
+    SetupTensor( tensor, QC_TENSOR_TYPE_UFIXED_POINT_8, hm.data(), hm.size(), { 1, 16, 16, 4 } );
+    ASSERT_EQ( QC_STATUS_OK, view.Init( tensor, 0.05f, -128 ) );
+    ASSERT_EQ( QC_STATUS_OK, view.BuildSigmoidLut() );
+
+    for ( size_t i = 0; i < hm.size(); i++ )
+    {
+        float expected = 1.0f / ( 1.0f + expf( -( (float) ( hm[i] - 128 ) * 0.05f ) ) );
+        EXPECT_FLOAT_EQ( expected, view.Sigmoid( i ) );
+    }
+
+    int32_t rawThreshold = view.GetRawThreshold( 1.0f );
+    EXPECT_GT( ( rawThreshold - 128 ) * 0.05f, 1.0f );
+    EXPECT_LE( ( rawThreshold - 1 - 128 ) * 0.05f, 1.0f );
+    EXPECT_EQ( 0, view.GetRawThreshold( -1000.0f ) );
+    EXPECT_EQ( 256, view.GetRawThreshold( 1000.0f ) );
+
+    /* selecting in the quantized domain matches thresholding the probability */
+    const float prob = 0.6f;
+    int32_t sigmoidThreshold = view.GetSigmoidRawThreshold( prob );
+    std::vector<uint32_t> all;
+    ASSERT_EQ( QC_STATUS_OK, view.Select( sigmoidThreshold, 0, hm.size(), 1, all ) );
+    std::vector<uint32_t> expected;
+    for ( size_t i = 0; i < hm.size(); i++ )
+    {
+        if ( view.Sigmoid( i ) > prob )
+        {
+            expected.push_back( (uint32_t) i );
+        }
+    }
+    EXPECT_EQ( expected, all );
+
+    /* select the class 2 of the heatmap only */
+    std::vector<uint32_t> cls;
+    ASSERT_EQ( QC_STATUS_OK, view.Select( sigmoidThreshold, 2, 16 * 16, 4, cls ) );
+    expected.clear();
+    for ( size_t i = 2; i < hm.size(); i += 4 )
+    {
+        if ( view.Sigmoid( i ) > prob )
+        {
+            expected.push_back( (uint32_t) i );
+        }
+    }
+    EXPECT_EQ( expected, cls );
+
+    EXPECT_EQ( QC_STATUS_OUT_OF_BOUND, view.Select( sigmoidThreshold, 4, 16 * 16, 4, cls ) );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, view.Select( sigmoidThreshold, 0, 1, 0, cls ) );
+}
+
+TEST( QuantizedTensorView, VectorMatchScalar )
+{
+    /* the blocks of all the starts and lengths up to 3 vectors and a tail are compared with the
+     * elements dequantized or selected one by one */
+    const size_t numElements = 64;
+    std::vector<uint8_t> u8( numElements );
+    std::vector<int8_t> s8( numElements );
+    std::vector<uint16_t> u16( numElements );
+    std::vector<int16_t> s16( numElements );
+    for ( size_t i = 0; i < numElements; i++ )
+    {
+        u8[i] = (uint8_t) ( i * 149 + 11 );
+        s8[i] = (int8_t) ( i * 149 + 11 );
+        u16[i] = (uint16_t) ( i * 40503 + 7 );
+        s16[i] = (int16_t) ( i * 40503 + 7 );
+    }
+
+    struct
+    {
+        QCTensorType_e tensorType;
+        void *pData;
+        size_t size;
+        int32_t rawThreshold;
+    } cases[] = {
+            { QC_TENSOR_TYPE_UFIXED_POINT_8, u8.data(), u8.size(), 128 },
+            { QC_TENSOR_TYPE_SFIXED_POINT_8, s8.data(), s8.size(), -5 },
+            { QC_TENSOR_TYPE_UFIXED_POINT_16, u16.data(), u16.size() * sizeof( uint16_t ), 30000 },
+            { QC_TENSOR_TYPE_SFIXED_POINT_16, s16.data(), s16.size() * sizeof( int16_t ), -1000 },
+    };
+
+    for ( auto &c : cases )
+    {
+        TensorDescriptor_t tensor;
+        QuantizedTensorView view;
+        SetupTensor( tensor, c.tensorType, c.pData, c.size, { (uint32_t) numElements } );
+        ASSERT_EQ( QC_STATUS_OK, view.Init( tensor, 0.0291f, 37 ) );
+
+        std::vector<float> out( numElements );
+        std::vector<uint32_t> indices;
+        for ( size_t start = 0; start < 8; start++ )
+        {
+            for ( size_t count = 0; start + count <= numElements; count++ )
+            {
+                ASSERT_EQ( QC_STATUS_OK, view.Dequantize( start, count, out.data() ) );
+                for ( size_t i = 0; i < count; i++ )
+                {
+                    ASSERT_EQ( view.Dequantize( start + i ), out[i] )
+                            << "type " << c.tensorType << " start " << start << " count " << count
+                            << " index " << i;
+                }
+
+                std::vector<uint32_t> expected;
+                for ( size_t i = start; i < start + count; i++ )
+                {
+                    if ( view.GetRaw( i ) >= c.rawThreshold )
+                    {
+                        expected.push_back( (uint32_t) i );
+                    }
+                }
+                indices.clear();
+                ASSERT_EQ( QC_STATUS_OK, view.Select( c.rawThreshold, start, count, 1, indices ) );
+                ASSERT_EQ( expected, indices ) << "type " << c.tensorType << " start " << start
+                                               << " count " << count;
+            }
+        }
+    }
+}
+
+TEST( QuantizedTensorView, InvalidArguments )
+{
+    std::vector<uint8_t> data( 64 );
+    TensorDescriptor_t tensor;
+    QuantizedTensorView view;
+
+    EXPECT_EQ( QC_STATUS_BAD_STATE, view.BuildSigmoidLut() );
+
+    SetupTensor( tensor, QC_TENSOR_TYPE_FLOAT_32, data.data(), data.size(), { 16 } );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, view.Init( tensor, 1.0f, 0 ) );
+
+    SetupTensor( tensor, QC_TENSOR_TYPE_UFIXED_POINT_16, data.data(), data.size(), { 64 } );
+    EXPECT_EQ( QC_STATUS_INVALID_BUF, view.Init( tensor, 1.0f, 0 ) );
+
+    SetupTensor( tensor, QC_TENSOR_TYPE_UFIXED_POINT_8, data.data(), data.size(), { 64 } );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, view.Init( tensor, 0.0f, 0 ) );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, view.Init( tensor, NAN, 0 ) );
+    EXPECT_EQ( QC_STATUS_OK, view.Init( tensor, 1.0f, 0 ) );
+}
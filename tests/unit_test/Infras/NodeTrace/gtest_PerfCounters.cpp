@@ -0,0 +1,105 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "gtest/gtest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "QC/Infras/NodeTrace/PerfCounters.hpp"
+
+using namespace QC;
+using namespace QC::Node;
+
+static void TouchPages( uint32_t numPages )
+{
+    size_t pageSize = (size_t) sysconf( _SC_PAGESIZE );
+    volatile char *pMem = new char[numPages * pageSize];
+    for ( uint32_t i = 0; i < numPages; i++ )
+    {
+        pMem[i * pageSize] = (char) i;
+    }
+    delete[] pMem;
+}
+
+TEST( PerfCounters, SANITY_Disabled )
+{
+    PerfCounters perfCounters;
+    QCNodePerfCounters_t counters;
+
+    /* Begin/End are no-op before Init */
+    perfCounters.Begin();
+    TouchPages( 16 );
+    perfCounters.End();
+
+    perfCounters.Get( counters );
+    EXPECT_FALSE( perfCounters.IsEnabled() );
+    EXPECT_EQ( 0, counters.numSamples );
+    EXPECT_EQ( 0, perfCounters.GetTraceArgs().size() );
+    EXPECT_EQ( QC_STATUS_OK, perfCounters.Deinit() );
+}
+
+TEST( PerfCounters, SANITY_Names )
+{
+    EXPECT_STREQ( "cycles", PerfCounters::GetName( QCNODE_PERF_COUNTER_CYCLES ) );
+    EXPECT_STREQ( "pageFaults", PerfCounters::GetName( QCNODE_PERF_COUNTER_PAGE_FAULTS ) );
+    EXPECT_STREQ( "unknown", PerfCounters::GetName( QCNODE_PERF_COUNTER_MAX ) );
+}
+
+TEST( PerfCounters, L2_Sample )
+{
+    PerfCounters perfCounters;
+    QCNodePerfCounters_t counters;
+
+    QCStatus_e ret = perfCounters.Init();
+    if ( QC_STATUS_UNSUPPORTED == ret )
+    {
+        GTEST_SKIP() << "perf_event_open not supported";
+    }
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        perfCounters.Begin();
+        TouchPages( 64 );
+        perfCounters.End();
+    }
+
+    perfCounters.Get( counters );
+    if ( false == perfCounters.IsEnabled() )
+    {
+        GTEST_SKIP() << "no performance counter permitted";
+    }
+
+    EXPECT_EQ( 4, counters.numSamples );
+    EXPECT_NE( 0, counters.available );
+    for ( uint32_t i = 0; i < QCNODE_PERF_COUNTER_MAX; i++ )
+    {
+        EXPECT_GE( counters.total[i], counters.last[i] );
+    }
+    if ( 0 != ( counters.available & ( 1u << QCNODE_PERF_COUNTER_PAGE_FAULTS ) ) )
+    {
+        EXPECT_GT( counters.total[QCNODE_PERF_COUNTER_PAGE_FAULTS], 0 );
+    }
+    EXPECT_EQ( (size_t) __builtin_popcount( counters.available ),
+               perfCounters.GetTraceArgs().size() );
+
+    perfCounters.Reset();
+    perfCounters.Get( counters );
+    EXPECT_EQ( 0, counters.numSamples );
+    EXPECT_NE( 0, counters.available );
+
+    EXPECT_EQ( QC_STATUS_OK, perfCounters.Deinit() );
+    EXPECT_FALSE( perfCounters.IsEnabled() );
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    int nVal = RUN_ALL_TESTS();
+    return nVal;
+}
+#endif
@@ -0,0 +1,230 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include "gtest/gtest.h"
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "OpenclIface.hpp"
+
+using namespace QC;
+using namespace QC::libs::OpenclIface;
+
+TEST( OpenclIface, Sanity_ProgramCache )
+{
+    QCStatus_e status;
+    std::string root = "/tmp/gtest_OpenclIface_" + std::to_string( getpid() );
+    std::string dir = root + "/cache/programs";
+    std::string path = dir + "/0123456789abcdef.clbin";
+    std::vector<unsigned char> binary( 1000 );
+    std::vector<unsigned char> loaded;
+
+    for ( size_t i = 0; i < binary.size(); i++ )
+    {
+        binary[i] = (unsigned char) ( i * 7 );
+    }
+
+    /* a miss, nothing cached yet */
+    status = OpenclSrv::ReadProgramCache( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OUT_OF_BOUND, status );
+
+    /* the missing parent directories are created */
+    status = OpenclSrv::WriteProgramCache( path, 1234, binary );
+    ASSERT_EQ( QC_STATUS_OK, status );
+
+    /* a hit */
+    status = OpenclSrv::ReadProgramCache( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( binary, loaded );
+
+    /* a stale entry, of another source, build options or device */
+    status = OpenclSrv::ReadProgramCache( path, 4321, loaded );
+    ASSERT_EQ( QC_STATUS_UNSUPPORTED, status );
+
+    /* a corrupted entry */
+    FILE *pFile = fopen( path.c_str(), "r+b" );
+    ASSERT_NE( nullptr, pFile );
+    ASSERT_EQ( 0, fseek( pFile, sizeof( OpenclIface_CacheHeader_t ) + 10, SEEK_SET ) );
+    ASSERT_EQ( 1u, fwrite( "x", 1, 1, pFile ) );
+    ASSERT_EQ( 0, fclose( pFile ) );
+    status = OpenclSrv::ReadProgramCache( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_FAIL, status );
+
+    /* a truncated entry */
+    ASSERT_EQ( 0, truncate( path.c_str(), sizeof( OpenclIface_CacheHeader_t ) + 100 ) );
+    status = OpenclSrv::ReadProgramCache( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_FAIL, status );
+
+    /* overwritten by a fresh entry */
+    status = OpenclSrv::WriteProgramCache( path, 1234, binary );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    status = OpenclSrv::ReadProgramCache( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( binary, loaded );
+
+    (void) unlink( path.c_str() );
+    (void) rmdir( dir.c_str() );
+    (void) rmdir( ( root + "/cache" ).c_str() );
+    (void) rmdir( root.c_str() );
+}
+
+TEST( OpenclIface, Sanity_Tuning )
+{
+    QCStatus_e status;
+    std::string path = "/tmp/gtest_OpenclIface_" + std::to_string( getpid() ) + ".tuning";
+    std::map<std::string, OpenclIface_TuningEntry_t> entries;
+    std::map<std::string, OpenclIface_TuningEntry_t> loaded;
+
+    entries["Resize 2 640 360 1"] = { { 32, 4, 1 }, 12000 };
+    entries["Convert 2 320 180 1"] = { { 0, 0, 0 }, 8000 };
+
+    /* a miss, nothing tuned yet */
+    status = OpenclSrv::ReadTuning( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OUT_OF_BOUND, status );
+
+    /* a round trip */
+    status = OpenclSrv::WriteTuning( path, 1234, entries );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    status = OpenclSrv::ReadTuning( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( entries.size(), loaded.size() );
+    for ( auto &it : entries )
+    {
+        auto loadedIt = loaded.find( it.first );
+        ASSERT_NE( loaded.end(), loadedIt ) << it.first;
+        ASSERT_EQ( 0, memcmp( it.second.localWorkSize, loadedIt->second.localWorkSize,
+                              sizeof( it.second.localWorkSize ) ) )
+                << it.first;
+        ASSERT_EQ( it.second.timeNs, loadedIt->second.timeNs ) << it.first;
+    }
+
+    /* the entries written by another instance are merged, a kernel tuned again is replaced */
+    std::map<std::string, OpenclIface_TuningEntry_t> others;
+    others["Remap 2 640 360 1"] = { { 16, 8, 1 }, 20000 };
+    others["Resize 2 640 360 1"] = { { 64, 2, 1 }, 11000 };
+    status = OpenclSrv::WriteTuning( path, 1234, others );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    loaded.clear();
+    status = OpenclSrv::ReadTuning( path, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( 3u, loaded.size() );
+    ASSERT_EQ( 64u, loaded["Resize 2 640 360 1"].localWorkSize[0] );
+    ASSERT_EQ( 11000u, loaded["Resize 2 640 360 1"].timeNs );
+    ASSERT_EQ( 8000u, loaded["Convert 2 320 180 1"].timeNs );
+    ASSERT_EQ( 16u, loaded["Remap 2 640 360 1"].localWorkSize[0] );
+
+    /* a database of another device or driver is rejected, and dropped by the next write */
+    loaded.clear();
+    status = OpenclSrv::ReadTuning( path, 4321, loaded );
+    ASSERT_EQ( QC_STATUS_UNSUPPORTED, status );
+    ASSERT_TRUE( loaded.empty() );
+    status = OpenclSrv::WriteTuning( path, 4321, others );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    status = OpenclSrv::ReadTuning( path, 4321, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( 2u, loaded.size() );
+    ASSERT_EQ( 0u, loaded.count( "Convert 2 320 180 1" ) );
+
+    (void) unlink( path.c_str() );
+
+    /* the missing parent directories of the database are created */
+    std::string dir = "/tmp/gtest_OpenclIface_" + std::to_string( getpid() ) + ".dir";
+    std::string nestedPath = dir + "/tuning/db.tuning";
+    status = OpenclSrv::WriteTuning( nestedPath, 1234, entries );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    loaded.clear();
+    status = OpenclSrv::ReadTuning( nestedPath, 1234, loaded );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( entries.size(), loaded.size() );
+    (void) unlink( nestedPath.c_str() );
+    (void) rmdir( ( dir + "/tuning" ).c_str() );
+    (void) rmdir( dir.c_str() );
+}
+
+TEST( OpenclIface, Sanity_PerfLevel )
+{
+    OpenclIfcae_Perf_e perf = OPENCLIFACE_PERF_NORMAL;
+
+    ASSERT_TRUE( GetPerfLevel( "low", perf ) );
+    ASSERT_EQ( OPENCLIFACE_PERF_LOW, perf );
+    ASSERT_TRUE( GetPerfLevel( "high", perf ) );
+    ASSERT_EQ( OPENCLIFACE_PERF_HIGH, perf );
+    ASSERT_TRUE( GetPerfLevel( "normal", perf ) );
+    ASSERT_EQ( OPENCLIFACE_PERF_NORMAL, perf );
+
+    /* an invalid level leaves the level unchanged */
+    ASSERT_FALSE( GetPerfLevel( "highest", perf ) );
+    ASSERT_FALSE( GetPerfLevel( "", perf ) );
+    ASSERT_EQ( OPENCLIFACE_PERF_NORMAL, perf );
+}
+
+TEST( OpenclIface, SharedContext )
+{
+    const char *pSource = "__kernel void Zero( __global int *p ) { p[0] = 0; }";
+    std::string shared = "gtest_OpenclIface";
+    OpenclIface_QueueConfig_t queue0;
+    OpenclIface_QueueConfig_t queue1;
+    OpenclSrv srv0;
+    OpenclSrv srv1;
+    OpenclSrv srv2;
+    OpenclSrv srv3;
+
+    queue0.name = "queue0";
+    queue1.name = "queue1";
+    queue1.priority = OPENCLIFACE_PERF_HIGH;
+    if ( QC_STATUS_OK != srv0.Init( "srv0", LOGGER_LEVEL_ERROR, OPENCLIFACE_PERF_NORMAL, 0,
+                                    shared, queue0 ) )
+    {
+        GTEST_SKIP() << "no OpenCL GPU";
+    }
+
+    /* two queue names in one context, each of its own configuration */
+    ASSERT_EQ( QC_STATUS_OK, srv1.Init( "srv1", LOGGER_LEVEL_ERROR, OPENCLIFACE_PERF_NORMAL, 0,
+                                        shared, queue1 ) );
+    ASSERT_EQ( QC_STATUS_OK, srv0.LoadFromSource( pSource ) );
+    ASSERT_EQ( QC_STATUS_OK, srv1.LoadFromSource( pSource ) );
+    ASSERT_NE( nullptr, srv1.GetCommandQueue() );
+    ASSERT_NE( srv0.GetCommandQueue(), srv1.GetCommandQueue() );
+
+    /* the same queue name, the queue is shared */
+    ASSERT_EQ( QC_STATUS_OK, srv2.Init( "srv2", LOGGER_LEVEL_ERROR, OPENCLIFACE_PERF_NORMAL, 0,
+                                        shared, queue0 ) );
+    ASSERT_EQ( srv0.GetCommandQueue(), srv2.GetCommandQueue() );
+    ASSERT_EQ( QC_STATUS_OK, srv2.LoadFromSource( pSource ) );
+    ASSERT_EQ( QC_STATUS_OK, srv2.Deinit() );
+
+    /* the same queue name of another priority, throttle or order mode, and the context of another
+     * priority */
+    OpenclIface_QueueConfig_t mismatch = queue0;
+    mismatch.priority = OPENCLIFACE_PERF_LOW;
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, srv3.Init( "srv3", LOGGER_LEVEL_ERROR,
+                                                   OPENCLIFACE_PERF_NORMAL, 0, shared, mismatch ) );
+    mismatch = queue0;
+    mismatch.throttle = OPENCLIFACE_PERF_HIGH;
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, srv3.Init( "srv3", LOGGER_LEVEL_ERROR,
+                                                   OPENCLIFACE_PERF_NORMAL, 0, shared, mismatch ) );
+    mismatch = queue0;
+    mismatch.bOutOfOrder = true;
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, srv3.Init( "srv3", LOGGER_LEVEL_ERROR,
+                                                   OPENCLIFACE_PERF_NORMAL, 0, shared, mismatch ) );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, srv3.Init( "srv3", LOGGER_LEVEL_ERROR,
+                                                   OPENCLIFACE_PERF_HIGH, 0, shared, queue0 ) );
+
+    ASSERT_EQ( QC_STATUS_OK, srv1.Deinit() );
+    ASSERT_EQ( QC_STATUS_OK, srv0.Deinit() );
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    int nVal = RUN_ALL_TESTS();
+    return nVal;
+}
+#endif
@@ -0,0 +1,482 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <CL/cl.h>
+
+#include "gtest/gtest.h"
+#include "kernel/CL2DFlex.cl.h"
+#include "pipeline/CL2DBatchParams.hpp"
+#include "pipeline/CL2DPipelineBatch.hpp"
+
+using namespace QC;
+using namespace QC::Node;
+
+/* The batched CL2DFlex kernels against the single input kernels, with plain OpenCL buffers, so it
+ * runs on any OpenCL platform, such as PoCL on a Linux host. The environment variables
+ * CL2DFLEX_BENCH_PLATFORM, CL2DFLEX_BENCH_DEVICE and CL2DFLEX_BENCH_INPUTS select the platform
+ * index, the device index and the number of inputs, default 0, 0 and 12. */
+
+#define BENCH_BUILD_OPTIONS "-cl-fast-relaxed-math"
+
+typedef enum
+{
+    BENCH_MODE_CONVERT,
+    BENCH_MODE_RESIZE,
+    BENCH_MODE_LETTERBOX,
+    BENCH_MODE_MAX
+} BenchMode_e;
+
+static const char *sg_modeNames[BENCH_MODE_MAX] = { "convert", "resize", "letterbox" };
+static const char *sg_serialKernels[BENCH_MODE_MAX] = { "ConvertNV12ToRGB", "ResizeNV12ToRGB",
+                                                        "LetterboxNV12ToRGB" };
+static const char *sg_batchKernels[BENCH_MODE_MAX] = { "ConvertNV12ToRGBBatch",
+                                                       "ResizeNV12ToRGBBatch",
+                                                       "LetterboxNV12ToRGBBatch" };
+
+typedef struct
+{
+    cl_int x;
+    cl_int y;
+    cl_int width;
+    cl_int height;
+} BenchROI_t;
+
+static uint32_t GetEnv( const char *pName, uint32_t defaultValue )
+{
+    const char *pValue = getenv( pName );
+    uint32_t value = defaultValue;
+    if ( nullptr != pValue )
+    {
+        value = (uint32_t) strtoul( pValue, nullptr, 0 );
+    }
+    return value;
+}
+
+class CL2DFlexBatchBench : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        cl_int retCL;
+        cl_uint numPlatforms = 0;
+        cl_uint numDevices = 0;
+        uint32_t platformIdx = GetEnv( "CL2DFLEX_BENCH_PLATFORM", 0 );
+        uint32_t deviceIdx = GetEnv( "CL2DFLEX_BENCH_DEVICE", 0 );
+        numInputs = GetEnv( "CL2DFLEX_BENCH_INPUTS", 12 );
+        ASSERT_GT( numInputs, 0u );
+
+        retCL = clGetPlatformIDs( 0, nullptr, &numPlatforms );
+        if ( ( CL_SUCCESS != retCL ) || ( platformIdx >= numPlatforms ) )
+        {
+            GTEST_SKIP() << "no OpenCL platform " << platformIdx;
+        }
+        std::vector<cl_platform_id> platforms( numPlatforms );
+        ASSERT_EQ( CL_SUCCESS, clGetPlatformIDs( numPlatforms, platforms.data(), nullptr ) );
+        retCL = clGetDeviceIDs( platforms[platformIdx], CL_DEVICE_TYPE_ALL, 0, nullptr,
+                                &numDevices );
+        if ( ( CL_SUCCESS != retCL ) || ( deviceIdx >= numDevices ) )
+        {
+            GTEST_SKIP() << "no OpenCL device " << deviceIdx;
+        }
+        std::vector<cl_device_id> devices( numDevices );
+        ASSERT_EQ( CL_SUCCESS, clGetDeviceIDs( platforms[platformIdx], CL_DEVICE_TYPE_ALL,
+                                               numDevices, devices.data(), nullptr ) );
+        device = devices[deviceIdx];
+        char deviceName[256] = { 0 };
+        (void) clGetDeviceInfo( device, CL_DEVICE_NAME, sizeof( deviceName ) - 1, deviceName,
+                                nullptr );
+        printf( "OpenCL device: %s, %u inputs\n", deviceName, numInputs );
+
+        context = clCreateContext( nullptr, 1, &device, nullptr, nullptr, &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+        queue = clCreateCommandQueueWithProperties( context, device, nullptr, &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+
+        program = clCreateProgramWithSource( context, 1, &s_pSourceCL2DFlex, nullptr, &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+        retCL = clBuildProgram( program, 1, &device, BENCH_BUILD_OPTIONS, nullptr, nullptr );
+        if ( CL_SUCCESS != retCL )
+        {
+            size_t logSize = 0;
+            (void) clGetProgramBuildInfo( program, device, CL_PROGRAM_BUILD_LOG, 0, nullptr,
+                                          &logSize );
+            std::string log( logSize, '\0' );
+            (void) clGetProgramBuildInfo( program, device, CL_PROGRAM_BUILD_LOG, logSize,
+                                          &log[0], nullptr );
+            printf( "build log: %s\n", log.c_str() );
+        }
+        ASSERT_EQ( CL_SUCCESS, retCL );
+
+        /* every input is a different frame */
+        inputStride = inputWidth;
+        inputPlane0Size = inputStride * inputHeight;
+        inputSize = inputPlane0Size + inputStride * inputHeight / 2;
+        std::vector<uint8_t> data( inputSize );
+        for ( uint32_t i = 0; i < numInputs; i++ )
+        {
+            uint32_t seed = 0x9E3779B9u * ( i + 1 );
+            for ( uint8_t &byte : data )
+            {
+                seed = seed * 1664525u + 1013904223u;
+                byte = (uint8_t) ( seed >> 24 );
+            }
+            cl_mem buffer = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                            inputSize, data.data(), &retCL );
+            ASSERT_EQ( CL_SUCCESS, retCL );
+            inputs.push_back( buffer );
+        }
+
+        outputStride = outputWidth * 3;
+        outputSizeOne = outputStride * outputHeight;
+        output = clCreateBuffer( context, CL_MEM_READ_WRITE, outputSizeOne * numInputs, nullptr,
+                                 &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+    }
+
+    void TearDown() override
+    {
+        for ( cl_mem buffer : inputs )
+        {
+            (void) clReleaseMemObject( buffer );
+        }
+        if ( nullptr != output )
+        {
+            (void) clReleaseMemObject( output );
+        }
+        if ( nullptr != program )
+        {
+            (void) clReleaseProgram( program );
+        }
+        if ( nullptr != queue )
+        {
+            (void) clReleaseCommandQueue( queue );
+        }
+        if ( nullptr != context )
+        {
+            (void) clReleaseContext( context );
+        }
+    }
+
+    /* different ROIs per input, the same constraints as the node configuration */
+    BenchROI_t GetROI( BenchMode_e mode, uint32_t inputId )
+    {
+        BenchROI_t roi;
+        if ( BENCH_MODE_CONVERT == mode )
+        {
+            roi.width = outputWidth;
+            roi.height = outputHeight;
+            roi.x = ( inputId * 96 ) % ( inputWidth - outputWidth );
+            roi.y = ( inputId * 48 ) % ( inputHeight - outputHeight );
+        }
+        else
+        {
+            roi.width = inputWidth - 64 * ( inputId % 4 );
+            roi.height = inputHeight - 32 * ( inputId % 3 );
+            roi.x = 16 * ( inputId % 4 );
+            roi.y = 8 * ( inputId % 3 );
+        }
+        return roi;
+    }
+
+    /* the kernel arguments of the CL2DFlex single input pipelines */
+    void EnqueueSerial( cl_kernel kernel, BenchMode_e mode, uint32_t inputId )
+    {
+        BenchROI_t roi = GetROI( mode, inputId );
+        cl_int srcOffset = 0;
+        cl_int dstOffset = inputId * outputSizeOne;
+        cl_int roiX = roi.x;
+        cl_int roiY = roi.y;
+        cl_float inputRatio = (float) roi.height / (float) roi.width;
+        cl_float outputRatio = (float) outputHeight / (float) outputWidth;
+        cl_int paddingValue = 0x202020;
+        cl_uint argIdx = 0;
+        size_t globalWorkSize[2] = { (size_t) outputWidth, (size_t) outputHeight };
+
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_mem ), &inputs[inputId] );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &srcOffset );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_mem ), &output );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &dstOffset );
+        if ( BENCH_MODE_CONVERT == mode )
+        {
+            roiX = roi.x / 2;
+            roiY = roi.y / 2;
+            globalWorkSize[0] = outputWidth / 2;
+            globalWorkSize[1] = outputHeight / 2;
+        }
+        else
+        {
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &roi.height );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &roi.width );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputHeight );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputWidth );
+        }
+        if ( BENCH_MODE_RESIZE == mode )
+        {
+            roiX = roi.x / roi.width * outputWidth;
+            roiY = roi.y / roi.height * outputHeight;
+        }
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &inputStride );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &inputPlane0Size );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &inputStride );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputStride );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &roiX );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &roiY );
+        if ( BENCH_MODE_LETTERBOX == mode )
+        {
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_float ), &inputRatio );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_float ), &outputRatio );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &paddingValue );
+        }
+
+        cl_int retCL = clEnqueueNDRangeKernel( queue, kernel, 2, nullptr, globalWorkSize,
+                                               nullptr, 0, nullptr, nullptr );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+    }
+
+    /* the kernel arguments of CL2DPipelineBatch */
+    void EnqueueBatch( cl_kernel kernel, BenchMode_e mode, uint32_t firstId, uint32_t num )
+    {
+        cl_mem srcs[CL2DFLEX_BATCH_MAX] = { nullptr };
+        CL2DBatchParams_t batch = {};
+        cl_float outputRatio = (float) outputHeight / (float) outputWidth;
+        cl_int paddingValue = 0x202020;
+        cl_uint argIdx = 0;
+        size_t globalWorkSize[3] = { (size_t) outputWidth, (size_t) outputHeight, num };
+
+        for ( uint32_t i = 0; i < num; i++ )
+        {
+            uint32_t inputId = firstId + i;
+            BenchROI_t roi = GetROI( mode, inputId );
+            CL2DBatchParam_t &param = batch.params[i];
+            srcs[i] = inputs[inputId];
+            param.srcOffset = 0;
+            param.dstOffset = inputId * outputSizeOne;
+            param.inputStride0 = inputStride;
+            param.inputPlane0Size = inputPlane0Size;
+            param.inputStride1 = inputStride;
+            param.roiWidth = roi.width;
+            param.roiHeight = roi.height;
+            if ( BENCH_MODE_CONVERT == mode )
+            {
+                param.roiX = roi.x / 2;
+                param.roiY = roi.y / 2;
+            }
+            else if ( BENCH_MODE_RESIZE == mode )
+            {
+                param.roiX = roi.x / roi.width * outputWidth;
+                param.roiY = roi.y / roi.height * outputHeight;
+            }
+            else
+            {
+                param.roiX = roi.x;
+                param.roiY = roi.y;
+                param.inputRatio = (float) roi.height / (float) roi.width;
+            }
+        }
+
+        for ( uint32_t i = 0; i < CL2DFLEX_BATCH_MAX; i++ )
+        {
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_mem ), &srcs[i] );
+        }
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_mem ), &output );
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( batch ), &batch );
+        if ( BENCH_MODE_CONVERT == mode )
+        {
+            globalWorkSize[0] = outputWidth / 2;
+            globalWorkSize[1] = outputHeight / 2;
+        }
+        else
+        {
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputHeight );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputWidth );
+        }
+        (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &outputStride );
+        if ( BENCH_MODE_LETTERBOX == mode )
+        {
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_float ), &outputRatio );
+            (void) clSetKernelArg( kernel, argIdx++, sizeof( cl_int ), &paddingValue );
+        }
+
+        cl_int retCL = clEnqueueNDRangeKernel( queue, kernel, 3, nullptr, globalWorkSize,
+                                               nullptr, 0, nullptr, nullptr );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+    }
+
+    /* 0: one input per dispatch waited one by one, 1: one input per dispatch waited once,
+     * 2: up to CL2DFLEX_BATCH_MAX inputs per dispatch waited once */
+    void RunFrame( cl_kernel serialKernel, cl_kernel batchKernel, BenchMode_e mode,
+                   uint32_t method )
+    {
+        if ( 2 == method )
+        {
+            for ( uint32_t first = 0; first < numInputs; first += CL2DFLEX_BATCH_MAX )
+            {
+                EnqueueBatch( batchKernel, mode, first,
+                              std::min( numInputs - first, CL2DFLEX_BATCH_MAX ) );
+            }
+        }
+        else
+        {
+            for ( uint32_t inputId = 0; inputId < numInputs; inputId++ )
+            {
+                EnqueueSerial( serialKernel, mode, inputId );
+                if ( 0 == method )
+                {
+                    ASSERT_EQ( CL_SUCCESS, clFinish( queue ) );
+                }
+            }
+        }
+        ASSERT_EQ( CL_SUCCESS, clFinish( queue ) );
+    }
+
+    void ReadOutput( std::vector<uint8_t> &result )
+    {
+        result.resize( outputSizeOne * numInputs );
+        cl_int retCL = clEnqueueReadBuffer( queue, output, CL_TRUE, 0, result.size(),
+                                            result.data(), 0, nullptr, nullptr );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+    }
+
+    void ClearOutput()
+    {
+        uint8_t pattern = 0;
+        cl_int retCL = clEnqueueFillBuffer( queue, output, &pattern, 1, 0,
+                                            outputSizeOne * numInputs, 0, nullptr, nullptr );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+        ASSERT_EQ( CL_SUCCESS, clFinish( queue ) );
+    }
+
+    cl_device_id device = nullptr;
+    cl_context context = nullptr;
+    cl_command_queue queue = nullptr;
+    cl_program program = nullptr;
+    std::vector<cl_mem> inputs;
+    cl_mem output = nullptr;
+    uint32_t numInputs = 0;
+    cl_int inputWidth = 1920;
+    cl_int inputHeight = 1080;
+    cl_int inputStride = 0;
+    cl_int inputPlane0Size = 0;
+    size_t inputSize = 0;
+    cl_int outputWidth = 640;
+    cl_int outputHeight = 384;
+    cl_int outputStride = 0;
+    cl_int outputSizeOne = 0;
+};
+
+TEST_F( CL2DFlexBatchBench, BatchedVsSerial )
+{
+    const uint32_t numWarmup = 2;
+    const uint32_t numFrames = 20;
+    const char *methodNames[3] = { "serial, wait each", "serial, wait once", "batched" };
+
+    for ( uint32_t mode = 0; mode < BENCH_MODE_MAX; mode++ )
+    {
+        cl_int retCL;
+        cl_kernel serialKernel = clCreateKernel( program, sg_serialKernels[mode], &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+        cl_kernel batchKernel = clCreateKernel( program, sg_batchKernels[mode], &retCL );
+        ASSERT_EQ( CL_SUCCESS, retCL );
+
+        /* the batched output must be bit exact with the single input kernels */
+        std::vector<uint8_t> serial;
+        std::vector<uint8_t> batched;
+        ClearOutput();
+        RunFrame( serialKernel, batchKernel, (BenchMode_e) mode, 1 );
+        ReadOutput( serial );
+        ClearOutput();
+        RunFrame( serialKernel, batchKernel, (BenchMode_e) mode, 2 );
+        ReadOutput( batched );
+        EXPECT_EQ( 0, memcmp( serial.data(), batched.data(), serial.size() ) )
+                << sg_modeNames[mode] << " mismatch";
+
+        for ( uint32_t method = 0; method < 3; method++ )
+        {
+            for ( uint32_t i = 0; i < numWarmup; i++ )
+            {
+                RunFrame( serialKernel, batchKernel, (BenchMode_e) mode, method );
+            }
+            auto begin = std::chrono::steady_clock::now();
+            for ( uint32_t i = 0; i < numFrames; i++ )
+            {
+                RunFrame( serialKernel, batchKernel, (BenchMode_e) mode, method );
+            }
+            auto end = std::chrono::steady_clock::now();
+            uint64_t totalUs =
+                    std::chrono::duration_cast<std::chrono::microseconds>( end - begin ).count();
+            printf( "%-9s %-17s: %u inputs, avg %" PRIu64 " us per frame\n", sg_modeNames[mode],
+                    methodNames[method], numInputs, totalUs / numFrames );
+        }
+
+        (void) clReleaseKernel( serialKernel );
+        (void) clReleaseKernel( batchKernel );
+    }
+}
+
+/* a batch of more than CL2DFLEX_BATCH_MAX inputs, or of inputs the batch kernels can not
+ * process, is rejected before any OpenCL call, so it runs without an OpenCL platform */
+TEST( CL2DFlexBatch, Rejected )
+{
+    CL2DFlex_Config_t config;
+    std::vector<std::reference_wrapper<QCBufferDescriptorBase>> buffers;
+    cl_kernel kernel = nullptr;
+
+    config.numOfInputs = QC_MAX_INPUTS;
+    config.outputFormat = QC_IMAGE_FORMAT_RGB888;
+    for ( uint32_t inputId = 0; inputId < QC_MAX_INPUTS; inputId++ )
+    {
+        config.workModes[inputId] = CL2DFLEX_WORK_MODE_CONVERT;
+        config.inputFormats[inputId] = QC_IMAGE_FORMAT_NV12;
+    }
+
+    std::vector<uint32_t> inputIds;
+    for ( uint32_t inputId = 0; inputId <= CL2DFLEX_BATCH_MAX; inputId++ )
+    {
+        inputIds.push_back( inputId );
+    }
+    CL2DPipelineBatch tooMany( inputIds );
+    tooMany.InitLogger( "CL2DPipelineBatch", LOGGER_LEVEL_ERROR );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, tooMany.Init( 0, &kernel, &config, nullptr, buffers ) );
+    EXPECT_EQ( nullptr, kernel );
+    tooMany.DeinitLogger();
+
+    std::vector<uint32_t> noInputIds;
+    CL2DPipelineBatch empty( noInputIds );
+    empty.InitLogger( "CL2DPipelineBatch", LOGGER_LEVEL_ERROR );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, empty.Init( 0, &kernel, &config, nullptr, buffers ) );
+    EXPECT_EQ( nullptr, kernel );
+    empty.DeinitLogger();
+
+    /* a full batch with an input of another format, then of another work mode */
+    inputIds.pop_back();
+    config.inputFormats[CL2DFLEX_BATCH_MAX - 1] = QC_IMAGE_FORMAT_UYVY;
+    EXPECT_FALSE( CL2DPipelineBatch::IsBatchable( config, CL2DFLEX_BATCH_MAX - 1 ) );
+    CL2DPipelineBatch mixed( inputIds );
+    mixed.InitLogger( "CL2DPipelineBatch", LOGGER_LEVEL_ERROR );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, mixed.Init( 0, &kernel, &config, nullptr, buffers ) );
+    config.inputFormats[CL2DFLEX_BATCH_MAX - 1] = QC_IMAGE_FORMAT_NV12;
+    config.workModes[CL2DFLEX_BATCH_MAX - 1] = CL2DFLEX_WORK_MODE_RESIZE_NEAREST;
+    EXPECT_TRUE( CL2DPipelineBatch::IsBatchable( config, CL2DFLEX_BATCH_MAX - 1 ) );
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, mixed.Init( 0, &kernel, &config, nullptr, buffers ) );
+    EXPECT_EQ( nullptr, kernel );
+    mixed.DeinitLogger();
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    int nVal = RUN_ALL_TESTS();
+    return nVal;
+}
+#endif
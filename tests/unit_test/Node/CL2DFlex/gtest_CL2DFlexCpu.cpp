@@ -0,0 +1,977 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <CL/cl.h>
+
+#include "gtest/gtest.h"
+#include "kernel/CL2DFlex.cl.h"
+#include "pipeline/CL2DCpuKernels.hpp"
+#include "pipeline/CL2DPipelineCpu.hpp"
+#include "pipeline/CL2DROIParams.hpp"
+
+using namespace QC;
+using namespace QC::Node;
+
+/* The CPU pipelines of CL2DFlex against a scalar reference of the kernels, and against the OpenCL
+ * kernels with the same arguments, with plain OpenCL buffers, so it runs on any OpenCL platform,
+ * such as PoCL on a Linux host. The OpenCL comparison is skipped without an OpenCL platform. The
+ * environment variables CL2DFLEX_CPU_PLATFORM, CL2DFLEX_CPU_DEVICE, CL2DFLEX_CPU_THREADS and
+ * CL2DFLEX_CPU_FRAMES select the platform index, the device index, the number of CPU threads and
+ * the number of benchmark frames, default 0, 0, 0 (all the cores) and 50. */
+
+#define CPU_BUILD_OPTIONS "-cl-fast-relaxed-math"
+
+/* native_recip and the relaxed math of the kernels against the IEEE float of the CPU, the geometry
+ * below has no half pixel ties, so only the color convert may differ, by one */
+#define CPU_TOLERANCE 1
+
+#define CPU_INPUT_WIDTH 1280
+#define CPU_INPUT_HEIGHT 720
+#define CPU_NUM_ROIS 3
+
+typedef struct
+{
+    const char *pName;
+    const char *pKernel;
+    CL2DFlex_Work_Mode_e workMode;
+    QCImageFormat_e inputFormat;
+    QCImageFormat_e outputFormat;
+    uint32_t outputWidth;
+    uint32_t outputHeight;
+    CL2DFlex_ROIConfig_t roi;
+} CpuCase_t;
+
+static const CpuCase_t sg_cases[] = {
+        { "convert nv12 to rgb", "ConvertNV12ToRGB", CL2DFLEX_WORK_MODE_CONVERT,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_RGB888, 640, 360, { 64, 32, 640, 360 } },
+        { "convert uyvy to rgb", "ConvertUYVYToRGB", CL2DFLEX_WORK_MODE_CONVERT,
+          QC_IMAGE_FORMAT_UYVY, QC_IMAGE_FORMAT_RGB888, 640, 360, { 64, 32, 640, 360 } },
+        { "convert uyvy to nv12", "ConvertUYVYToNV12", CL2DFLEX_WORK_MODE_CONVERT,
+          QC_IMAGE_FORMAT_UYVY, QC_IMAGE_FORMAT_NV12, 640, 360, { 64, 32, 640, 360 } },
+        { "resize nv12 to rgb", "ResizeNV12ToRGB", CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_RGB888, 640, 360, { 0, 0, 1280, 720 } },
+        { "resize uyvy to rgb", "ResizeUYVYToRGB", CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+          QC_IMAGE_FORMAT_UYVY, QC_IMAGE_FORMAT_RGB888, 640, 360, { 0, 0, 1280, 720 } },
+        { "resize rgb to rgb", "ResizeRGBToRGB", CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+          QC_IMAGE_FORMAT_RGB888, QC_IMAGE_FORMAT_RGB888, 640, 360, { 0, 0, 1280, 720 } },
+        { "resize uyvy to nv12", "ResizeUYVYToNV12", CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+          QC_IMAGE_FORMAT_UYVY, QC_IMAGE_FORMAT_NV12, 640, 360, { 0, 0, 1280, 720 } },
+        { "resize nv12 to nv12", "ResizeNV12ToNV12", CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_NV12, 640, 360, { 0, 0, 1280, 720 } },
+        { "letterbox nv12 to rgb", "LetterboxNV12ToRGB", CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_RGB888, 640, 640, { 0, 0, 1280, 720 } },
+        { "letterbox multiple", "LetterboxNV12ToRGBMultiple",
+          CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE, QC_IMAGE_FORMAT_NV12,
+          QC_IMAGE_FORMAT_RGB888, 320, 320, { 0, 0, 1280, 720 } },
+        { "resize multiple", "ResizeNV12ToRGBMultiple", CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_RGB888, 320, 320, { 0, 0, 1280, 720 } },
+        { "remap nv12 to rgb", "RemapNV12ToRGB", CL2DFLEX_WORK_MODE_REMAP_NEAREST,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_RGB888, 640, 360, { 0, 0, 1280, 720 } },
+        { "remap nv12 to bgr", "RemapNV12ToBGR", CL2DFLEX_WORK_MODE_REMAP_NEAREST,
+          QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_BGR888, 640, 360, { 0, 0, 1280, 720 } },
+};
+
+/* the [x, y, width, height] of the ROIs of the multiple work modes, with integer scales */
+static const int32_t sg_multipleROIs[CPU_NUM_ROIS * 4] = { 0,   0,  640, 640, 320, 40,
+                                                             320, 320, 0,   0,  1280, 640 };
+
+/* the scalar reference below, one output pixel at a time as the OpenCL kernels, independent of
+ * the CPU pipelines so that they are checked without an OpenCL platform */
+static const float sg_refCoeffY = 1.163999557f;
+static const float sg_refCoeffUV[4] = { 2.017999649f, -0.812999725f, -0.390999794f,
+                                        1.5959997177f };
+
+/* convert_uchar_sat, rounding toward zero */
+static uint8_t RefSat( float value )
+{
+    uint8_t ret = 0;
+    if ( value >= 255.0f )
+    {
+        ret = 255;
+    }
+    else if ( value > 0.0f )
+    {
+        ret = (uint8_t) value;
+    }
+    else
+    {
+        /* NaN and the negative values */
+    }
+    return ret;
+}
+
+/* the Y, U and V of the pixel [x, y] of a packed NV12 or UYVY image */
+static void RefGetYUV( const ImageDescriptor_t &image, int32_t x, int32_t y, uint8_t *pYUV )
+{
+    const uint8_t *pSrc = (const uint8_t *) image.pBuf;
+    if ( QC_IMAGE_FORMAT_NV12 == image.format )
+    {
+        const uint8_t *pUV = pSrc + image.planeBufSize[0] + ( y / 2 ) * image.stride[1] +
+                             ( x / 2 ) * 2;
+        pYUV[0] = pSrc[y * image.stride[0] + x];
+        pYUV[1] = pUV[0];
+        pYUV[2] = pUV[1];
+    }
+    else
+    {
+        const uint8_t *pUYVY = pSrc + y * image.stride[0] + ( x / 2 ) * 4;
+        pYUV[0] = pSrc[y * image.stride[0] + x * 2 + 1];
+        pYUV[1] = pUYVY[0];
+        pYUV[2] = pUYVY[2];
+    }
+}
+
+static void RefYUVToRGB( const uint8_t *pYUV, uint8_t *pDst, bool bBGR )
+{
+    float Y = (float) std::max( 0, (int) pYUV[0] - 16 ) * sg_refCoeffY;
+    float UV[4] = { (float) pYUV[1] - 128.0f, (float) pYUV[2] - 128.0f, (float) pYUV[1] - 128.0f,
+                    (float) pYUV[2] - 128.0f };
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        UV[i] = UV[i] * sg_refCoeffUV[i] + 0.5f;
+    }
+    UV[1] = UV[1] + UV[2] - 0.5f;
+    uint8_t R = RefSat( UV[3] + Y );
+    uint8_t G = RefSat( UV[1] + Y );
+    uint8_t B = RefSat( UV[0] + Y );
+    pDst[0] = bBGR ? B : R;
+    pDst[1] = G;
+    pDst[2] = bBGR ? R : B;
+}
+
+/* the nearest input pixel of the output pixel [x, y] of the scale of size to outputSize */
+static int32_t RefScale( uint32_t x, uint32_t outputSize, uint32_t size )
+{
+    return (int32_t) lroundf( (float) x * ( 1.0f / (float) outputSize ) * (float) size );
+}
+
+static uint32_t GetEnv( const char *pName, uint32_t defaultValue )
+{
+    const char *pValue = getenv( pName );
+    uint32_t value = defaultValue;
+    if ( nullptr != pValue )
+    {
+        value = (uint32_t) strtoul( pValue, nullptr, 0 );
+    }
+    return value;
+}
+
+static bool IsMultiple( CL2DFlex_Work_Mode_e workMode )
+{
+    return ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == workMode ) ||
+           ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE == workMode );
+}
+
+/* the strides and the plane sizes of a packed image */
+static void SetupImage( ImageDescriptor_t &image, QCImageFormat_e format, uint32_t width,
+                        uint32_t height, uint32_t batchSize )
+{
+    image.format = format;
+    image.width = width;
+    image.height = height;
+    image.batchSize = batchSize;
+    image.offset = 0;
+    if ( QC_IMAGE_FORMAT_NV12 == format )
+    {
+        image.numPlanes = 2;
+        image.stride[0] = width;
+        image.stride[1] = width;
+        image.planeBufSize[0] = width * height;
+        image.planeBufSize[1] = width * height / 2;
+    }
+    else
+    {
+        image.numPlanes = 1;
+        image.stride[0] = ( QC_IMAGE_FORMAT_UYVY == format ) ? ( width * 2 ) : ( width * 3 );
+        image.planeBufSize[0] = image.stride[0] * height;
+    }
+    image.size = ( image.planeBufSize[0] + image.planeBufSize[1] ) * batchSize;
+}
+
+class CL2DFlexCpu : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_EQ( QC_STATUS_OK, workers.Init( GetEnv( "CL2DFLEX_CPU_THREADS", 0 ) ) );
+        printf( "CPU threads: %u\n", workers.GetNumThreads() );
+
+        /* the same frame for all the cases, in each of the input formats */
+        uint32_t seed = 12345;
+        inputData.resize( CPU_INPUT_WIDTH * CPU_INPUT_HEIGHT * 3 );
+        for ( uint8_t &value : inputData )
+        {
+            seed = seed * 1103515245u + 12345u;
+            value = (uint8_t) ( seed >> 16 );
+        }
+
+        /* maps in the output size, partly out of the ROI to cover the clamping */
+        mapX.resize( 640 * 360 );
+        mapY.resize( 640 * 360 );
+        for ( uint32_t y = 0; y < 360; y++ )
+        {
+            for ( uint32_t x = 0; x < 640; x++ )
+            {
+                mapX[y * 640 + x] = (float) x * 2.1f - 20.25f;
+                mapY[y * 640 + x] = (float) y * 2.1f - 10.3f + (float) ( x % 7 ) * 0.1f;
+            }
+        }
+
+        SetupOpencl();
+    }
+
+    void TearDown() override
+    {
+        if ( nullptr != program )
+        {
+            (void) clReleaseProgram( program );
+        }
+        if ( nullptr != queue )
+        {
+            (void) clReleaseCommandQueue( queue );
+        }
+        if ( nullptr != context )
+        {
+            (void) clReleaseContext( context );
+        }
+        workers.Deinit();
+    }
+
+    /* an OpenCL platform is optional, the CPU pipelines are then only run */
+    void SetupOpencl()
+    {
+        cl_int retCL;
+        cl_uint numPlatforms = 0;
+        cl_uint numDevices = 0;
+        uint32_t platformIdx = GetEnv( "CL2DFLEX_CPU_PLATFORM", 0 );
+        uint32_t deviceIdx = GetEnv( "CL2DFLEX_CPU_DEVICE", 0 );
+
+        retCL = clGetPlatformIDs( 0, nullptr, &numPlatforms );
+        if ( ( CL_SUCCESS == retCL ) && ( platformIdx < numPlatforms ) )
+        {
+            std::vector<cl_platform_id> platforms( numPlatforms );
+            retCL = clGetPlatformIDs( numPlatforms, platforms.data(), nullptr );
+            if ( CL_SUCCESS == retCL )
+            {
+                retCL = clGetDeviceIDs( platforms[platformIdx], CL_DEVICE_TYPE_ALL, 0, nullptr,
+                                        &numDevices );
+            }
+            if ( ( CL_SUCCESS == retCL ) && ( deviceIdx < numDevices ) )
+            {
+                std::vector<cl_device_id> devices( numDevices );
+                ASSERT_EQ( CL_SUCCESS, clGetDeviceIDs( platforms[platformIdx], CL_DEVICE_TYPE_ALL,
+                                                       numDevices, devices.data(), nullptr ) );
+                device = devices[deviceIdx];
+                char deviceName[256] = { 0 };
+                (void) clGetDeviceInfo( device, CL_DEVICE_NAME, sizeof( deviceName ) - 1,
+                                        deviceName, nullptr );
+                printf( "OpenCL device: %s\n", deviceName );
+
+                context = clCreateContext( nullptr, 1, &device, nullptr, nullptr, &retCL );
+                ASSERT_EQ( CL_SUCCESS, retCL );
+                queue = clCreateCommandQueueWithProperties( context, device, nullptr, &retCL );
+                ASSERT_EQ( CL_SUCCESS, retCL );
+                program = clCreateProgramWithSource( context, 1, &s_pSourceCL2DFlex, nullptr,
+                                                     &retCL );
+                ASSERT_EQ( CL_SUCCESS, retCL );
+                ASSERT_EQ( CL_SUCCESS, clBuildProgram( program, 1, &device, CPU_BUILD_OPTIONS,
+                                                       nullptr, nullptr ) );
+            }
+        }
+        if ( nullptr == program )
+        {
+            printf( "no OpenCL platform %u device %u, the CPU pipelines are not compared\n",
+                    platformIdx, deviceIdx );
+        }
+    }
+
+    void SetupCase( const CpuCase_t &cpuCase )
+    {
+        uint32_t numImages = IsMultiple( cpuCase.workMode ) ? CPU_NUM_ROIS : 1;
+
+        config = CL2DFlex_Config_t();
+        config.numOfInputs = 1;
+        config.workModes[0] = cpuCase.workMode;
+        config.inputFormats[0] = cpuCase.inputFormat;
+        config.inputWidths[0] = CPU_INPUT_WIDTH;
+        config.inputHeights[0] = CPU_INPUT_HEIGHT;
+        config.ROIs[0] = cpuCase.roi;
+        config.outputFormat = cpuCase.outputFormat;
+        config.outputWidth = cpuCase.outputWidth;
+        config.outputHeight = cpuCase.outputHeight;
+        config.letterboxPaddingValue = 0x204060;
+        config.numOfROIs = CPU_NUM_ROIS;
+        config.ROIsBufferId = 0;
+        config.remapTable[0].mapXBufferId = 1;
+        config.remapTable[0].mapYBufferId = 2;
+
+        SetupImage( input, cpuCase.inputFormat, CPU_INPUT_WIDTH, CPU_INPUT_HEIGHT, 1 );
+        input.pBuf = inputData.data();
+        SetupImage( output, cpuCase.outputFormat, cpuCase.outputWidth, cpuCase.outputHeight,
+                    numImages );
+        cpuOutput.assign( output.size, 0 );
+        output.pBuf = cpuOutput.data();
+
+        roisTensor.pBuf = (void *) sg_multipleROIs;
+        roisTensor.size = sizeof( sg_multipleROIs );
+        mapXTensor.pBuf = mapX.data();
+        mapXTensor.size = mapX.size() * sizeof( float );
+        mapYTensor.pBuf = mapY.data();
+        mapYTensor.size = mapY.size() * sizeof( float );
+        buffers.clear();
+        buffers.push_back( roisTensor );
+        buffers.push_back( mapXTensor );
+        buffers.push_back( mapYTensor );
+    }
+
+    /* the input pixel of the output pixel [x, y] of the image idx, false for the padding */
+    bool RefGetSource( const CpuCase_t &cpuCase, uint32_t idx, uint32_t x, uint32_t y,
+                       int32_t &xIn, int32_t &yIn )
+    {
+        bool bSource = true;
+        uint32_t outW = cpuCase.outputWidth;
+        uint32_t outH = cpuCase.outputHeight;
+        const int32_t *pROI = IsMultiple( cpuCase.workMode ) ? &sg_multipleROIs[idx * 4]
+                                                             : nullptr;
+        int32_t roi[4] = { (int32_t) cpuCase.roi.x, (int32_t) cpuCase.roi.y,
+                           (int32_t) cpuCase.roi.width, (int32_t) cpuCase.roi.height };
+        if ( nullptr != pROI )
+        {
+            std::copy( pROI, pROI + 4, roi );
+        }
+
+        if ( CL2DFLEX_WORK_MODE_CONVERT == cpuCase.workMode )
+        {
+            xIn = (int32_t) x;
+            yIn = (int32_t) y;
+        }
+        else if ( CL2DFLEX_WORK_MODE_REMAP_NEAREST == cpuCase.workMode )
+        {
+            xIn = std::min( roi[2] - 1, std::max( 0, (int32_t) lroundf( mapX[y * outW + x] ) ) );
+            yIn = std::min( roi[3] - 1, std::max( 0, (int32_t) lroundf( mapY[y * outW + x] ) ) );
+        }
+        else if ( ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == cpuCase.workMode ) ||
+                  ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == cpuCase.workMode ) )
+        {
+            /* the scale of the longer side of the ROI, the rest is padded */
+            float inputRatio = (float) roi[3] * ( 1.0f / (float) roi[2] );
+            float outputRatio = (float) outH * ( 1.0f / (float) outW );
+            if ( inputRatio < outputRatio )
+            {
+                bSource = ( (float) y < (float) outW * inputRatio );
+                xIn = RefScale( x, outW, roi[2] );
+                yIn = RefScale( y, outW, roi[2] );
+            }
+            else
+            {
+                bSource = ( (float) x < (float) outH * ( 1.0f / inputRatio ) );
+                xIn = RefScale( x, outH, roi[3] );
+                yIn = RefScale( y, outH, roi[3] );
+            }
+        }
+        else
+        {
+            xIn = RefScale( x, outW, roi[2] );
+            yIn = RefScale( y, outH, roi[3] );
+        }
+        xIn += roi[0];
+        yIn += roi[1];
+
+        return bSource;
+    }
+
+    /* the output of the case by the scalar reference into refOutput */
+    void RunReference( const CpuCase_t &cpuCase )
+    {
+        uint32_t outW = cpuCase.outputWidth;
+        uint32_t outH = cpuCase.outputHeight;
+        uint32_t numImages = IsMultiple( cpuCase.workMode ) ? CPU_NUM_ROIS : 1;
+        const uint8_t *pSrc = inputData.data();
+        uint8_t padding[3] = { (uint8_t) ( config.letterboxPaddingValue >> 16 ),
+                               (uint8_t) ( config.letterboxPaddingValue >> 8 ),
+                               (uint8_t) config.letterboxPaddingValue };
+        uint8_t YUV[3];
+        int32_t xIn = 0;
+        int32_t yIn = 0;
+
+        refOutput.assign( output.size, 0 );
+        for ( uint32_t idx = 0; idx < numImages; idx++ )
+        {
+            uint8_t *pDst = refOutput.data() + idx * outH * output.stride[0];
+            for ( uint32_t y = 0; y < outH; y++ )
+            {
+                for ( uint32_t x = 0; x < outW; x++ )
+                {
+                    bool bSource = RefGetSource( cpuCase, idx, x, y, xIn, yIn );
+                    if ( QC_IMAGE_FORMAT_NV12 == cpuCase.outputFormat )
+                    {
+                        RefGetYUV( input, xIn, yIn, YUV );
+                        pDst[y * output.stride[0] + x] = YUV[0];
+                    }
+                    else if ( false == bSource )
+                    {
+                        std::copy( padding, padding + 3, &pDst[y * output.stride[0] + x * 3] );
+                    }
+                    else if ( QC_IMAGE_FORMAT_RGB888 == cpuCase.inputFormat )
+                    {
+                        const uint8_t *pRGB = pSrc + yIn * input.stride[0] + xIn * 3;
+                        std::copy( pRGB, pRGB + 3, &pDst[y * output.stride[0] + x * 3] );
+                    }
+                    else
+                    {
+                        RefGetYUV( input, xIn, yIn, YUV );
+                        RefYUVToRGB( YUV, &pDst[y * output.stride[0] + x * 3],
+                                     QC_IMAGE_FORMAT_BGR888 == cpuCase.outputFormat );
+                    }
+                }
+            }
+        }
+
+        if ( QC_IMAGE_FORMAT_NV12 == cpuCase.outputFormat )
+        {
+            /* the chroma of a 2x2 block: the average of the two rows by the convert, the nearest
+             * pixel of the even output pixel by the resize of UYVY, and the scale of the chroma
+             * coordinates as the luma ones by the resize of NV12 */
+            uint8_t *pUV = refOutput.data() + output.planeBufSize[0];
+            for ( uint32_t y = 0; y < outH / 2; y++ )
+            {
+                for ( uint32_t x = 0; x < outW / 2; x++ )
+                {
+                    uint8_t *pDst = &pUV[y * output.stride[1] + x * 2];
+                    if ( CL2DFLEX_WORK_MODE_CONVERT == cpuCase.workMode )
+                    {
+                        uint8_t YUV2[3];
+                        RefGetYUV( input, x * 2 + cpuCase.roi.x, y * 2 + cpuCase.roi.y, YUV );
+                        RefGetYUV( input, x * 2 + cpuCase.roi.x, y * 2 + 1 + cpuCase.roi.y,
+                                   YUV2 );
+                        pDst[0] = (uint8_t) ( ( YUV[1] + YUV2[1] ) / 2 );
+                        pDst[1] = (uint8_t) ( ( YUV[2] + YUV2[2] ) / 2 );
+                    }
+                    else
+                    {
+                        if ( QC_IMAGE_FORMAT_UYVY == cpuCase.inputFormat )
+                        {
+                            xIn = RefScale( x * 2, outW, cpuCase.roi.width );
+                            yIn = RefScale( y * 2, outH, cpuCase.roi.height );
+                        }
+                        else
+                        {
+                            xIn = RefScale( x, outW, cpuCase.roi.width ) * 2;
+                            yIn = RefScale( y, outH, cpuCase.roi.height ) * 2;
+                        }
+                        RefGetYUV( input, xIn + cpuCase.roi.x, yIn + cpuCase.roi.y, YUV );
+                        pDst[0] = YUV[1];
+                        pDst[1] = YUV[2];
+                    }
+                }
+            }
+        }
+    }
+
+    /* the maximum difference of the bytes of two outputs */
+    static uint32_t MaxDiff( const std::vector<uint8_t> &a, const std::vector<uint8_t> &b,
+                             size_t &numDiff )
+    {
+        uint32_t maxDiff = 0;
+        numDiff = 0;
+        for ( size_t i = 0; i < a.size(); i++ )
+        {
+            uint32_t diff = (uint32_t) abs( (int) a[i] - (int) b[i] );
+            if ( diff > 0 )
+            {
+                numDiff++;
+                maxDiff = std::max( maxDiff, diff );
+            }
+        }
+        return maxDiff;
+    }
+
+    /* the arguments of the kernel in the order of the single input pipelines */
+    void SetKernelArgs( const CpuCase_t &cpuCase, cl_kernel kernel, cl_mem src, cl_mem dst,
+                        cl_mem rois, cl_mem mapXMem, cl_mem mapYMem, size_t *pGlobal,
+                        cl_uint &workDim )
+    {
+        std::vector<std::pair<size_t, const void *>> args;
+        cl_int zero = 0;
+        cl_int roiW = (cl_int) cpuCase.roi.width;
+        cl_int roiH = (cl_int) cpuCase.roi.height;
+        cl_int outW = (cl_int) cpuCase.outputWidth;
+        cl_int outH = (cl_int) cpuCase.outputHeight;
+        cl_int inStride[3] = { (cl_int) input.stride[0], (cl_int) input.planeBufSize[0],
+                               (cl_int) input.stride[1] };
+        cl_int outStride[3] = { (cl_int) output.stride[0], (cl_int) output.planeBufSize[0],
+                                (cl_int) output.stride[1] };
+        cl_int roiX = (cl_int) cpuCase.roi.x;
+        cl_int roiY = (cl_int) cpuCase.roi.y;
+        cl_float inputRatio = (float) cpuCase.roi.height / (float) cpuCase.roi.width;
+        cl_float outputRatio = (float) cpuCase.outputHeight / (float) cpuCase.outputWidth;
+        cl_int padding = (cl_int) config.letterboxPaddingValue;
+        bool bMultiple = IsMultiple( cpuCase.workMode );
+        bool bConvert = ( CL2DFLEX_WORK_MODE_CONVERT == cpuCase.workMode );
+
+        args.push_back( { sizeof( cl_mem ), &src } );
+        args.push_back( { sizeof( cl_int ), &zero } );
+        args.push_back( { sizeof( cl_mem ), &dst } );
+        args.push_back( { sizeof( cl_int ), &zero } );
+        if ( bMultiple )
+        {
+            args.push_back( { sizeof( cl_mem ), &rois } );
+            args.push_back( { sizeof( cl_int ), &outH } );
+            args.push_back( { sizeof( cl_int ), &outW } );
+        }
+        else if ( false == bConvert )
+        {
+            args.push_back( { sizeof( cl_int ), &roiH } );
+            args.push_back( { sizeof( cl_int ), &roiW } );
+            args.push_back( { sizeof( cl_int ), &outH } );
+            args.push_back( { sizeof( cl_int ), &outW } );
+        }
+        else
+        {
+            /* the convert kernels have no size arguments */
+        }
+        uint32_t numInStrides = ( QC_IMAGE_FORMAT_NV12 == cpuCase.inputFormat ) ? 3 : 1;
+        for ( uint32_t i = 0; i < numInStrides; i++ )
+        {
+            args.push_back( { sizeof( cl_int ), &inStride[i] } );
+        }
+        uint32_t numOutStrides = ( QC_IMAGE_FORMAT_NV12 == cpuCase.outputFormat ) ? 3 : 1;
+        for ( uint32_t i = 0; i < numOutStrides; i++ )
+        {
+            args.push_back( { sizeof( cl_int ), &outStride[i] } );
+        }
+
+        pGlobal[0] = cpuCase.outputWidth;
+        pGlobal[1] = cpuCase.outputHeight;
+        workDim = 2;
+        if ( bConvert )
+        {
+            roiX = roiX / 2;
+            roiY = ( QC_IMAGE_FORMAT_UYVY == cpuCase.inputFormat ) &&
+                                   ( QC_IMAGE_FORMAT_RGB888 == cpuCase.outputFormat )
+                           ? roiY
+                           : roiY / 2;
+            pGlobal[0] = cpuCase.outputWidth / 2;
+            pGlobal[1] = ( QC_IMAGE_FORMAT_UYVY == cpuCase.inputFormat ) &&
+                                         ( QC_IMAGE_FORMAT_RGB888 == cpuCase.outputFormat )
+                                 ? cpuCase.outputHeight
+                                 : cpuCase.outputHeight / 2;
+        }
+        else if ( CL2DFLEX_WORK_MODE_RESIZE_NEAREST == cpuCase.workMode )
+        {
+            roiX = (cl_int) ( cpuCase.roi.x / cpuCase.roi.width * cpuCase.outputWidth );
+            roiY = (cl_int) ( cpuCase.roi.y / cpuCase.roi.height * cpuCase.outputHeight );
+        }
+        else
+        {
+            /* the letterbox and remap kernels take the ROI origin */
+        }
+        if ( bMultiple )
+        {
+            pGlobal[0] = CPU_NUM_ROIS;
+            pGlobal[1] = cpuCase.outputWidth;
+            pGlobal[2] = cpuCase.outputHeight;
+            workDim = 3;
+        }
+        else
+        {
+            args.push_back( { sizeof( cl_int ), &roiX } );
+            args.push_back( { sizeof( cl_int ), &roiY } );
+        }
+
+        if ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == cpuCase.workMode )
+        {
+            args.push_back( { sizeof( cl_float ), &inputRatio } );
+            args.push_back( { sizeof( cl_float ), &outputRatio } );
+            args.push_back( { sizeof( cl_int ), &padding } );
+        }
+        else if ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == cpuCase.workMode )
+        {
+            args.push_back( { sizeof( cl_int ), &padding } );
+        }
+        else if ( CL2DFLEX_WORK_MODE_REMAP_NEAREST == cpuCase.workMode )
+        {
+            args.push_back( { sizeof( cl_mem ), &mapXMem } );
+            args.push_back( { sizeof( cl_mem ), &mapYMem } );
+        }
+        else
+        {
+            /* no extra arguments */
+        }
+
+        for ( cl_uint i = 0; i < (cl_uint) args.size(); i++ )
+        {
+            ASSERT_EQ( CL_SUCCESS, clSetKernelArg( kernel, i, args[i].first, args[i].second ) )
+                    << cpuCase.pKernel << " argument " << i;
+        }
+    }
+
+    /* run the kernel numFrames times and read back the output, returns the microseconds */
+    uint64_t RunOpencl( const CpuCase_t &cpuCase, uint32_t numFrames )
+    {
+        cl_int retCL;
+        uint64_t totalUs = 0;
+        size_t global[3] = { 0, 0, 0 };
+        cl_uint workDim = 0;
+
+        cl_kernel kernel = clCreateKernel( program, cpuCase.pKernel, &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL ) << cpuCase.pKernel;
+        cl_mem src = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                     inputData.size(), inputData.data(), &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL );
+        gpuOutput.assign( output.size, 0 );
+        cl_mem dst = clCreateBuffer( context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                                     gpuOutput.size(), gpuOutput.data(), &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL );
+        cl_mem rois = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                      sizeof( sg_multipleROIs ), (void *) sg_multipleROIs,
+                                      &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL );
+        cl_mem mapXMem = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                         mapX.size() * sizeof( float ), mapX.data(), &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL );
+        cl_mem mapYMem = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                         mapY.size() * sizeof( float ), mapY.data(), &retCL );
+        EXPECT_EQ( CL_SUCCESS, retCL );
+
+        if ( false == ::testing::Test::HasFailure() )
+        {
+            SetKernelArgs( cpuCase, kernel, src, dst, rois, mapXMem, mapYMem, global, workDim );
+        }
+        if ( false == ::testing::Test::HasFailure() )
+        {
+            auto begin = std::chrono::steady_clock::now();
+            for ( uint32_t i = 0; i < numFrames; i++ )
+            {
+                EXPECT_EQ( CL_SUCCESS, clEnqueueNDRangeKernel( queue, kernel, workDim, nullptr,
+                                                               global, nullptr, 0, nullptr,
+                                                               nullptr ) );
+            }
+            EXPECT_EQ( CL_SUCCESS, clFinish( queue ) );
+            auto end = std::chrono::steady_clock::now();
+            totalUs = std::chrono::duration_cast<std::chrono::microseconds>( end - begin ).count();
+            EXPECT_EQ( CL_SUCCESS, clEnqueueReadBuffer( queue, dst, CL_TRUE, 0, gpuOutput.size(),
+                                                        gpuOutput.data(), 0, nullptr, nullptr ) );
+        }
+
+        (void) clReleaseMemObject( mapYMem );
+        (void) clReleaseMemObject( mapXMem );
+        (void) clReleaseMemObject( rois );
+        (void) clReleaseMemObject( dst );
+        (void) clReleaseMemObject( src );
+        (void) clReleaseKernel( kernel );
+
+        return totalUs;
+    }
+
+    /* run the CPU pipeline numFrames times, returns the microseconds */
+    uint64_t RunCpu( const CpuCase_t &cpuCase, uint32_t numFrames )
+    {
+        uint64_t totalUs = 0;
+        CL2DPipelineCpu pipeline( workers );
+
+        pipeline.InitLogger( "CL2DPipelineCpu", LOGGER_LEVEL_ERROR );
+        EXPECT_TRUE( CL2DPipelineCpu::IsSupported( config, 0 ) ) << cpuCase.pName;
+        EXPECT_EQ( QC_STATUS_OK, pipeline.Init( 0, nullptr, &config, nullptr, buffers ) )
+                << cpuCase.pName;
+        if ( false == ::testing::Test::HasFailure() )
+        {
+            auto begin = std::chrono::steady_clock::now();
+            for ( uint32_t i = 0; i < numFrames; i++ )
+            {
+                EXPECT_EQ( QC_STATUS_OK, pipeline.Execute( input, output ) );
+            }
+            auto end = std::chrono::steady_clock::now();
+            totalUs = std::chrono::duration_cast<std::chrono::microseconds>( end - begin ).count();
+        }
+        (void) pipeline.Deinit();
+        pipeline.DeinitLogger();
+
+        return totalUs;
+    }
+
+    CL2DCpuWorkers workers;
+    std::vector<uint8_t> inputData;
+    std::vector<float> mapX;
+    std::vector<float> mapY;
+
+    CL2DFlex_Config_t config;
+    ImageDescriptor_t input;
+    ImageDescriptor_t output;
+    TensorDescriptor_t roisTensor;
+    TensorDescriptor_t mapXTensor;
+    TensorDescriptor_t mapYTensor;
+    std::vector<std::reference_wrapper<QCBufferDescriptorBase>> buffers;
+    std::vector<uint8_t> cpuOutput;
+    std::vector<uint8_t> gpuOutput;
+    std::vector<uint8_t> refOutput;
+
+    cl_device_id device = nullptr;
+    cl_context context = nullptr;
+    cl_command_queue queue = nullptr;
+    cl_program program = nullptr;
+};
+
+TEST_F( CL2DFlexCpu, MatchReference )
+{
+    for ( const CpuCase_t &cpuCase : sg_cases )
+    {
+        size_t numDiff = 0;
+        SetupCase( cpuCase );
+        (void) RunCpu( cpuCase, 1 );
+        RunReference( cpuCase );
+        uint32_t maxDiff = MaxDiff( cpuOutput, refOutput, numDiff );
+        printf( "%-22s: %zu of %zu bytes differ from the reference, max %u\n", cpuCase.pName,
+                numDiff, cpuOutput.size(), maxDiff );
+        EXPECT_LE( maxDiff, (uint32_t) CPU_TOLERANCE ) << cpuCase.pName;
+    }
+}
+
+TEST_F( CL2DFlexCpu, MatchOpencl )
+{
+    for ( const CpuCase_t &cpuCase : sg_cases )
+    {
+        SetupCase( cpuCase );
+        (void) RunCpu( cpuCase, 1 );
+        if ( nullptr != program )
+        {
+            size_t numDiff = 0;
+            (void) RunOpencl( cpuCase, 1 );
+            uint32_t maxDiff = MaxDiff( cpuOutput, gpuOutput, numDiff );
+            printf( "%-22s: %zu of %zu bytes differ, max %u\n", cpuCase.pName, numDiff,
+                    cpuOutput.size(), maxDiff );
+            EXPECT_LE( maxDiff, (uint32_t) CPU_TOLERANCE ) << cpuCase.pName;
+        }
+    }
+}
+
+TEST( CL2DFlexCpuKernels, VectorMatchScalar )
+{
+    /* the full blocks of the vector paths and the tails of all the lengths, bit exact */
+    const uint32_t maxWidth = 1280 + 47;
+    std::vector<uint8_t> Y( maxWidth ), U( maxWidth ), V( maxWidth );
+    std::vector<uint8_t> vecOut( maxWidth * 3 ), scalarOut( maxWidth * 3 );
+    srand( 1 );
+    for ( uint32_t i = 0; i < maxWidth; i++ )
+    {
+        Y[i] = (uint8_t) rand();
+        U[i] = (uint8_t) rand();
+        V[i] = (uint8_t) rand();
+    }
+    /* the clamps of Y under 16 and of the saturated channels */
+    Y[0] = 0;
+    Y[1] = 255;
+    U[1] = 255;
+    V[1] = 255;
+    U[2] = 0;
+    V[2] = 0;
+
+    for ( uint32_t width = 0; width <= maxWidth; width += ( width < 64 ) ? 1 : 61 )
+    {
+        for ( bool bBGR : { false, true } )
+        {
+            std::fill( vecOut.begin(), vecOut.end(), 0xA5 );
+            std::fill( scalarOut.begin(), scalarOut.end(), 0xA5 );
+            CL2DCpuYUVToRGBRow( Y.data(), U.data(), V.data(), width, bBGR, vecOut.data() );
+            CL2DCpuYUVToRGBRowScalar( Y.data(), U.data(), V.data(), width, bBGR,
+                                      scalarOut.data() );
+            ASSERT_EQ( scalarOut, vecOut ) << "width " << width << " bgr " << bBGR;
+        }
+    }
+}
+
+TEST_F( CL2DFlexCpu, Errors )
+{
+    CL2DPipelineCpu pipeline( workers );
+
+    pipeline.InitLogger( "CL2DPipelineCpu", LOGGER_LEVEL_ERROR );
+
+    /* the normalize work modes are GPU only */
+    SetupCase( sg_cases[0] );
+    config.workModes[0] = CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE;
+    EXPECT_FALSE( CL2DPipelineCpu::IsSupported( config, 0 ) );
+
+    /* the convert of an ROI of another size than the output */
+    SetupCase( sg_cases[0] );
+    config.ROIs[0].width = 320;
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Init( 0, nullptr, &config, nullptr, buffers ) );
+
+    /* the remap without the maps */
+    SetupCase( sg_cases[11] );
+    config.remapTable[0].mapXBufferId = 3;
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Init( 0, nullptr, &config, nullptr, buffers ) );
+
+    /* null buffers */
+    SetupCase( sg_cases[3] );
+    ASSERT_EQ( QC_STATUS_OK, pipeline.Init( 0, nullptr, &config, nullptr, buffers ) );
+    input.pBuf = nullptr;
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( input, output ) );
+    input.pBuf = inputData.data();
+    output.batchSize = 0;
+    EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( input, output ) );
+
+    (void) pipeline.Deinit();
+    pipeline.DeinitLogger();
+}
+
+TEST_F( CL2DFlexCpu, FrameROIs )
+{
+    /* the ROIs of the frame in the reverse order of the ROIs buffer, the last image of the output
+     * is not written */
+    const uint32_t order[CPU_NUM_ROIS - 1] = { 2, 0 };
+    const CpuCase_t *pCases[] = { &sg_cases[9], &sg_cases[10] };
+
+    for ( const CpuCase_t *pCase : pCases )
+    {
+        SetupCase( *pCase );
+        (void) RunCpu( *pCase, 1 );
+        std::vector<uint8_t> reference = cpuOutput;
+        size_t imageSize = cpuOutput.size() / CPU_NUM_ROIS;
+
+        CL2DFlex_ROIImageDescriptor_t frameInput;
+        frameInput = input;
+        frameInput.numOfROIs = CPU_NUM_ROIS - 1;
+        for ( uint32_t i = 0; i < frameInput.numOfROIs; i++ )
+        {
+            const int32_t *pROI = &sg_multipleROIs[order[i] * 4];
+            frameInput.ROIs[i] = { (uint32_t) pROI[0], (uint32_t) pROI[1], (uint32_t) pROI[2],
+                                   (uint32_t) pROI[3] };
+        }
+
+        /* no ROIs buffer, the ROIs are taken from the frame */
+        CL2DPipelineCpu pipeline( workers );
+        pipeline.InitLogger( "CL2DPipelineCpu", LOGGER_LEVEL_ERROR );
+        config.ROIsBufferId = UINT32_MAX;
+        ASSERT_EQ( QC_STATUS_OK, pipeline.Init( 0, nullptr, &config, nullptr, buffers ) );
+        std::fill( cpuOutput.begin(), cpuOutput.end(), 0x5A );
+        ASSERT_EQ( QC_STATUS_OK, pipeline.Execute( frameInput, output ) );
+        for ( uint32_t i = 0; i < frameInput.numOfROIs; i++ )
+        {
+            EXPECT_EQ( 0, memcmp( cpuOutput.data() + i * imageSize,
+                                  reference.data() + order[i] * imageSize, imageSize ) )
+                    << pCase->pName << " image " << i;
+        }
+        EXPECT_TRUE( std::all_of( cpuOutput.end() - imageSize, cpuOutput.end(),
+                                  []( uint8_t v ) { return 0x5A == v; } ) )
+                << pCase->pName;
+
+        /* more ROIs than the output images, an ROI out of the input and no ROIs at all */
+        frameInput.numOfROIs = CPU_NUM_ROIS + 1;
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( frameInput, output ) );
+        frameInput.numOfROIs = 1;
+        frameInput.ROIs[0] = { CPU_INPUT_WIDTH - 64, 0, 128, 128 };
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( frameInput, output ) );
+        frameInput.ROIs[0] = { 0, 0, 0, 128 };
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( frameInput, output ) );
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pipeline.Execute( input, output ) );
+        (void) pipeline.Deinit();
+        pipeline.DeinitLogger();
+
+        if ( nullptr != program )
+        {
+            /* the kernel taking the ROIs of the frame by value against the CPU pipeline */
+            cl_int retCL;
+            std::string kernelName = std::string( pCase->pKernel ) + "ROIs";
+            cl_kernel kernel = clCreateKernel( program, kernelName.c_str(), &retCL );
+            ASSERT_EQ( CL_SUCCESS, retCL ) << kernelName;
+            cl_mem src = clCreateBuffer( context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                                         inputData.size(), inputData.data(), &retCL );
+            EXPECT_EQ( CL_SUCCESS, retCL );
+            gpuOutput.assign( output.size, 0 );
+            cl_mem dst = clCreateBuffer( context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR,
+                                         gpuOutput.size(), gpuOutput.data(), &retCL );
+            EXPECT_EQ( CL_SUCCESS, retCL );
+
+            CL2DROIParams_t rois = {};
+            for ( uint32_t i = 0; i < CPU_NUM_ROIS - 1; i++ )
+            {
+                for ( uint32_t j = 0; j < 4; j++ )
+                {
+                    rois.ROIs[i * 4 + j] = sg_multipleROIs[order[i] * 4 + j];
+                }
+            }
+            cl_int zero = 0;
+            cl_int outH = (cl_int) pCase->outputHeight;
+            cl_int outW = (cl_int) pCase->outputWidth;
+            cl_int inStride[3] = { (cl_int) input.stride[0], (cl_int) input.planeBufSize[0],
+                                   (cl_int) input.stride[1] };
+            cl_int outStride = (cl_int) output.stride[0];
+            cl_int padding = (cl_int) config.letterboxPaddingValue;
+            std::vector<std::pair<size_t, const void *>> args = {
+                    { sizeof( cl_mem ), &src },         { sizeof( cl_int ), &zero },
+                    { sizeof( cl_mem ), &dst },         { sizeof( cl_int ), &zero },
+                    { sizeof( rois ), &rois },          { sizeof( cl_int ), &zero },
+                    { sizeof( cl_int ), &outH },        { sizeof( cl_int ), &outW },
+                    { sizeof( cl_int ), &inStride[0] }, { sizeof( cl_int ), &inStride[1] },
+                    { sizeof( cl_int ), &inStride[2] }, { sizeof( cl_int ), &outStride } };
+            if ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE == pCase->workMode )
+            {
+                args.push_back( { sizeof( cl_int ), &padding } );
+            }
+            for ( cl_uint i = 0; i < (cl_uint) args.size(); i++ )
+            {
+                EXPECT_EQ( CL_SUCCESS, clSetKernelArg( kernel, i, args[i].first, args[i].second ) )
+                        << kernelName << " argument " << i;
+            }
+            size_t global[3] = { CPU_NUM_ROIS - 1, pCase->outputWidth, pCase->outputHeight };
+            EXPECT_EQ( CL_SUCCESS, clEnqueueNDRangeKernel( queue, kernel, 3, nullptr, global,
+                                                           nullptr, 0, nullptr, nullptr ) );
+            EXPECT_EQ( CL_SUCCESS, clEnqueueReadBuffer( queue, dst, CL_TRUE, 0, gpuOutput.size(),
+                                                        gpuOutput.data(), 0, nullptr, nullptr ) );
+            uint32_t maxDiff = 0;
+            for ( size_t i = 0; i < imageSize * ( CPU_NUM_ROIS - 1 ); i++ )
+            {
+                uint32_t diff = (uint32_t) abs( (int) cpuOutput[i] - (int) gpuOutput[i] );
+                maxDiff = std::max( maxDiff, diff );
+            }
+            EXPECT_LE( maxDiff, (uint32_t) CPU_TOLERANCE ) << kernelName;
+
+            (void) clReleaseMemObject( dst );
+            (void) clReleaseMemObject( src );
+            (void) clReleaseKernel( kernel );
+        }
+    }
+}
+
+TEST_F( CL2DFlexCpu, Bench )
+{
+    uint32_t numFrames = GetEnv( "CL2DFLEX_CPU_FRAMES", 50 );
+    ASSERT_GT( numFrames, 0u );
+
+    for ( const CpuCase_t &cpuCase : sg_cases )
+    {
+        SetupCase( cpuCase );
+        double numPixels = (double) cpuCase.outputWidth * cpuCase.outputHeight *
+                           ( IsMultiple( cpuCase.workMode ) ? CPU_NUM_ROIS : 1 ) * numFrames;
+        (void) RunCpu( cpuCase, 1 );
+        uint64_t cpuUs = std::max( RunCpu( cpuCase, numFrames ), (uint64_t) 1 );
+        printf( "%-22s: cpu %8.1f MPix/s", cpuCase.pName, numPixels / cpuUs );
+        if ( nullptr != program )
+        {
+            (void) RunOpencl( cpuCase, 1 );
+            uint64_t gpuUs = std::max( RunOpencl( cpuCase, numFrames ), (uint64_t) 1 );
+            printf( ", opencl %8.1f MPix/s", numPixels / gpuUs );
+        }
+        printf( "\n" );
+    }
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    int nVal = RUN_ALL_TESTS();
+    return nVal;
+}
+#endif
@@ -3,11 +3,17 @@
 
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <condition_variable>
+#include <mutex>
+#include <set>
 #include <stdio.h>
+#include <string.h>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "QC/Node/CL2DFlex.hpp"
 #include "QC/sample/BufferManager.hpp"
@@ -148,16 +154,30 @@ void SetConfigCL2D( CL2DFlex_Config_t *pCL2DFlexConfig, DataTree *pdt )
             inputDt.Set<uint32_t>( "mapXBufferId", pCL2DFlexConfig->numOfInputs + 1 );
             inputDt.Set<uint32_t>( "mapYBufferId", pCL2DFlexConfig->numOfInputs + 2 );
         }
+        else if ( pCL2DFlexConfig->workModes[i] == CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE )
+        {
+            inputDt.Set<std::string>( "workMode", "resize_normalize" );
+        }
+        else if ( pCL2DFlexConfig->workModes[i] == CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE )
+        {
+            inputDt.Set<std::string>( "workMode", "letterbox_normalize" );
+        }
 
         inputDts.push_back( inputDt );
     }
     pdt->Set( "static.inputs", inputDts );
 }
 
-void Sanity()
+void Sanity( bool bAsync = false )
 {
     QCStatus_e ret;
     std::string errors;
+    std::mutex lock;
+    std::condition_variable condVar;
+    uint32_t numDone = 0;
+    QCStatus_e doneStatus = QC_STATUS_OK;
+    std::set<std::thread::id> callbackThreads;
+    const uint32_t numFrames = 4;
     QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
     BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
 
@@ -185,6 +205,19 @@ void Sanity()
 
     QCNodeInit_t config = { dt.Dump() };
     printf( "config: %s\n", config.config.c_str() );
+    if ( bAsync )
+    {
+        config.callback = [&]( const QCNodeEventInfo_t &info ) {
+            std::lock_guard<std::mutex> l( lock );
+            if ( QC_STATUS_OK != info.status )
+            {
+                doneStatus = info.status;
+            }
+            callbackThreads.insert( std::this_thread::get_id() );
+            numDone++;
+            condVar.notify_one();
+        };
+    }
 
     ImageProps_t imgPropInputs[CL2DFlexConfig.numOfInputs];
     for ( int i = 0; i < CL2DFlexConfig.numOfInputs; i++ )
@@ -272,8 +305,22 @@ void Sanity()
     ret = pCL2DFlex->Start();
     ASSERT_EQ( QC_STATUS_OK, ret );
 
-    ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
-    ASSERT_EQ( QC_STATUS_OK, ret );
+    for ( uint32_t i = 0; i < numFrames; i++ )
+    {
+        ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    if ( bAsync )
+    {
+        std::unique_lock<std::mutex> l( lock );
+        ASSERT_TRUE( condVar.wait_for( l, std::chrono::seconds( 5 ),
+                                       [&]() { return numFrames == numDone; } ) );
+        ASSERT_EQ( QC_STATUS_OK, doneStatus );
+        /* all the frames are notified by the notifier thread of the node */
+        ASSERT_EQ( 1u, callbackThreads.size() );
+        ASSERT_EQ( 0u, callbackThreads.count( std::this_thread::get_id() ) );
+    }
 
     ret = pCL2DFlex->Stop();
     ASSERT_EQ( QC_STATUS_OK, ret );
@@ -569,11 +616,953 @@ void Accuracy( uint32_t inputNumberTest, CL2DFlex_Work_Mode_e modeTest,
     reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
 }
 
+/* run one frame of numOfInputs NV12 inputs with different ROIs, with or without batching, with
+ * pProfile the kernels are profiled and their GPU profile is placed into it */
+void RunBatched( CL2DFlex_Work_Mode_e mode, uint32_t numOfInputs, bool bBatched,
+                 std::vector<uint8_t> &result, bool bOutOfOrder = false,
+                 const std::string &tuningPath = "", QCNodeGpuProfile_t *pProfile = nullptr )
+{
+    QCStatus_e ret;
+    QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
+    BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+
+    CL2DFlex_Config_t CL2DFlexConfig;
+    CL2DFlexConfig.numOfInputs = numOfInputs;
+    CL2DFlexConfig.outputWidth = 64;
+    CL2DFlexConfig.outputHeight = 48;
+    CL2DFlexConfig.outputFormat = QC_IMAGE_FORMAT_RGB888;
+    for ( uint32_t i = 0; i < numOfInputs; i++ )
+    {
+        CL2DFlexConfig.workModes[i] = mode;
+        CL2DFlexConfig.inputWidths[i] = 256;
+        CL2DFlexConfig.inputHeights[i] = 192;
+        CL2DFlexConfig.inputFormats[i] = QC_IMAGE_FORMAT_NV12;
+        CL2DFlexConfig.ROIs[i].x = 8 * i;
+        CL2DFlexConfig.ROIs[i].y = 4 * i;
+        if ( CL2DFLEX_WORK_MODE_CONVERT == mode )
+        {
+            CL2DFlexConfig.ROIs[i].width = CL2DFlexConfig.outputWidth;
+            CL2DFlexConfig.ROIs[i].height = CL2DFlexConfig.outputHeight;
+        }
+        else
+        {
+            CL2DFlexConfig.ROIs[i].width = 96 + 8 * i;
+            CL2DFlexConfig.ROIs[i].height = 120 - 4 * i;
+        }
+    }
+
+    DataTree dt;
+    dt.Set<std::string>( "static.name", "CL2D" );
+    dt.Set<uint32_t>( "static.id", 0 );
+    dt.Set<bool>( "static.batched", bBatched );
+    if ( bOutOfOrder )
+    {
+        dt.Set<bool>( "static.outOfOrder", true );
+        dt.Set<std::string>( "static.queuePriority", "high" );
+    }
+    if ( "" != tuningPath )
+    {
+        dt.Set<std::string>( "static.tuningPath", tuningPath );
+        dt.Set<bool>( "static.tuneWorkGroups", true );
+    }
+    if ( nullptr != pProfile )
+    {
+        dt.Set<bool>( "static.gpuProfiling", true );
+    }
+    SetConfigCL2D( &CL2DFlexConfig, &dt );
+    QCNodeInit_t config = { dt.Dump() };
+
+    NodeFrameDescriptor frameDesc( numOfInputs + 1 );
+    std::vector<ImageDescriptor_t> inputs( numOfInputs );
+    for ( uint32_t i = 0; i < numOfInputs; i++ )
+    {
+        ImageProps_t imgProp;
+        imgProp.batchSize = 1;
+        imgProp.width = CL2DFlexConfig.inputWidths[i];
+        imgProp.height = CL2DFlexConfig.inputHeights[i];
+        imgProp.format = QC_IMAGE_FORMAT_NV12;
+        imgProp.stride[0] = CL2DFlexConfig.inputWidths[i];
+        imgProp.stride[1] = CL2DFlexConfig.inputWidths[i];
+        imgProp.actualHeight[0] = CL2DFlexConfig.inputHeights[i];
+        imgProp.actualHeight[1] = CL2DFlexConfig.inputHeights[i] / 2;
+        imgProp.planeBufSize[0] = 0;
+        imgProp.planeBufSize[1] = 0;
+        imgProp.numPlanes = 2;
+        ret = bufMgr.Allocate( imgProp, inputs[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        uint8_t *pData = (uint8_t *) inputs[i].pBuf;
+        for ( size_t j = 0; j < inputs[i].size; j++ )
+        {
+            pData[j] = (uint8_t) ( ( j * 7 + i * 31 ) & 0xFF );
+        }
+        ret = frameDesc.SetBuffer( i, inputs[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    ImageProps_t imgPropOutput;
+    imgPropOutput.batchSize = numOfInputs;
+    imgPropOutput.width = CL2DFlexConfig.outputWidth;
+    imgPropOutput.height = CL2DFlexConfig.outputHeight;
+    imgPropOutput.format = CL2DFlexConfig.outputFormat;
+    imgPropOutput.stride[0] = CL2DFlexConfig.outputWidth * 3;
+    imgPropOutput.actualHeight[0] = CL2DFlexConfig.outputHeight;
+    imgPropOutput.planeBufSize[0] = 0;
+    imgPropOutput.numPlanes = 1;
+    ImageDescriptor_t output;
+    ret = bufMgr.Allocate( imgPropOutput, output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    memset( output.pBuf, 0, output.size );
+    ret = frameDesc.SetBuffer( numOfInputs, output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Start();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    result.assign( (uint8_t *) output.pBuf, (uint8_t *) output.pBuf + output.size );
+
+    if ( nullptr != pProfile )
+    {
+        QCNodeMonitoringIfs &monitorIfs = pCL2DFlex->GetMonitoringIfs();
+        uint32_t size = sizeof( QCNodeGpuProfile_t );
+        ASSERT_EQ( size, monitorIfs.GetCurrentSize() );
+        ret = monitorIfs.Place( pProfile, size );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ASSERT_EQ( sizeof( QCNodeGpuProfile_t ), size );
+    }
+
+    ret = pCL2DFlex->Stop();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    for ( auto imageDesc : inputs )
+    {
+        ret = bufMgr.Free( imageDesc );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+    ret = bufMgr.Free( output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
+}
+
+/* resize an NV12 image to a smaller NV12 image with a first node, then the NV12 image to RGB888
+ * with a second node, in private contexts or chained in a shared context */
+void RunChain( bool bShared, std::vector<uint8_t> &result )
+{
+    QCStatus_e ret;
+    std::mutex lock;
+    uint32_t numEnqueued = 0;
+    const uint32_t numFrames = 3;
+    QCNodeIfs *pCL2DFlexs[2] = { new QC::Node::CL2DFlex(), new QC::Node::CL2DFlex() };
+    BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+    uint32_t widths[3] = { 256, 128, 64 };
+    uint32_t heights[3] = { 192, 96, 48 };
+    QCImageFormat_e formats[3] = { QC_IMAGE_FORMAT_NV12, QC_IMAGE_FORMAT_NV12,
+                                   QC_IMAGE_FORMAT_RGB888 };
+
+    ImageDescriptor_t images[3];
+    for ( uint32_t i = 0; i < 3; i++ )
+    {
+        ImageProps_t imgProp;
+        imgProp.batchSize = 1;
+        imgProp.width = widths[i];
+        imgProp.height = heights[i];
+        imgProp.format = formats[i];
+        if ( QC_IMAGE_FORMAT_NV12 == formats[i] )
+        {
+            imgProp.stride[0] = widths[i];
+            imgProp.stride[1] = widths[i];
+            imgProp.actualHeight[0] = heights[i];
+            imgProp.actualHeight[1] = heights[i] / 2;
+            imgProp.planeBufSize[0] = 0;
+            imgProp.planeBufSize[1] = 0;
+            imgProp.numPlanes = 2;
+        }
+        else
+        {
+            imgProp.stride[0] = widths[i] * 3;
+            imgProp.actualHeight[0] = heights[i];
+            imgProp.planeBufSize[0] = 0;
+            imgProp.numPlanes = 1;
+        }
+        ret = bufMgr.Allocate( imgProp, images[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        memset( images[i].pBuf, 0, images[i].size );
+    }
+    uint8_t *pData = (uint8_t *) images[0].pBuf;
+    for ( size_t j = 0; j < images[0].size; j++ )
+    {
+        pData[j] = (uint8_t) ( ( j * 7 ) & 0xFF );
+    }
+
+    NodeFrameDescriptor frameDescs[2] = { NodeFrameDescriptor( 2 ), NodeFrameDescriptor( 2 ) };
+    for ( uint32_t n = 0; n < 2; n++ )
+    {
+        CL2DFlex_Config_t CL2DFlexConfig;
+        CL2DFlexConfig.numOfInputs = 1;
+        CL2DFlexConfig.workModes[0] = CL2DFLEX_WORK_MODE_RESIZE_NEAREST;
+        CL2DFlexConfig.inputWidths[0] = widths[n];
+        CL2DFlexConfig.inputHeights[0] = heights[n];
+        CL2DFlexConfig.inputFormats[0] = formats[n];
+        CL2DFlexConfig.ROIs[0].x = 0;
+        CL2DFlexConfig.ROIs[0].y = 0;
+        CL2DFlexConfig.ROIs[0].width = widths[n];
+        CL2DFlexConfig.ROIs[0].height = heights[n];
+        CL2DFlexConfig.outputWidth = widths[n + 1];
+        CL2DFlexConfig.outputHeight = heights[n + 1];
+        CL2DFlexConfig.outputFormat = formats[n + 1];
+
+        DataTree dt;
+        dt.Set<std::string>( "static.name", "CL2D" + std::to_string( n ) );
+        dt.Set<uint32_t>( "static.id", n );
+        if ( bShared )
+        {
+            dt.Set<std::string>( "static.sharedContext", "chain" );
+            dt.Set<bool>( "static.notifyOnEnqueue", 0 == n );
+        }
+        SetConfigCL2D( &CL2DFlexConfig, &dt );
+        QCNodeInit_t config = { dt.Dump() };
+        if ( bShared && ( 0 == n ) )
+        {
+            config.callback = [&]( const QCNodeEventInfo_t &info ) {
+                std::lock_guard<std::mutex> l( lock );
+                ASSERT_EQ( QC_STATUS_OK, info.status );
+                numEnqueued++;
+            };
+        }
+
+        ret = frameDescs[n].SetBuffer( 0, images[n] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = frameDescs[n].SetBuffer( 1, images[n + 1] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        ret = pCL2DFlexs[n]->Initialize( config );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        ret = pCL2DFlexs[n]->Start();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    for ( uint32_t i = 0; i < numFrames; i++ )
+    {
+        for ( uint32_t n = 0; n < 2; n++ )
+        {
+            ret = pCL2DFlexs[n]->ProcessFrameDescriptor( frameDescs[n] );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+    }
+
+    if ( bShared )
+    {
+        /* the first node notified each frame at enqueue, the second node waited for it */
+        ASSERT_EQ( numFrames, numEnqueued );
+    }
+    result.assign( (uint8_t *) images[2].pBuf, (uint8_t *) images[2].pBuf + images[2].size );
+
+    for ( uint32_t n = 0; n < 2; n++ )
+    {
+        ret = pCL2DFlexs[n]->Stop();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        ret = pCL2DFlexs[n]->DeInitialize();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlexs[n] )->~CL2DFlex();
+    }
+
+    for ( uint32_t i = 0; i < 3; i++ )
+    {
+        ret = bufMgr.Free( images[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+}
+
+/* run one frame of 2 inputs into RGB888 images for the reference work modes, or into a tensor for
+ * the normalize work modes when pTensorProp is provided */
+void RunNormalize( CL2DFlex_Work_Mode_e mode, QCImageFormat_e inputFormat,
+                   const TensorProps_t *pTensorProp, CL2DFlex_Tensor_Layout_e layout,
+                   const float *pMean, const float *pStd, std::vector<uint8_t> &result )
+{
+    QCStatus_e ret;
+    QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
+    BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+    uint32_t numOfInputs = 2;
+    bool bLetterbox = ( CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST == mode ) ||
+                      ( CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE == mode );
+
+    CL2DFlex_Config_t CL2DFlexConfig;
+    CL2DFlexConfig.numOfInputs = numOfInputs;
+    CL2DFlexConfig.outputWidth = 64;
+    CL2DFlexConfig.outputHeight = 48;
+    CL2DFlexConfig.outputFormat = QC_IMAGE_FORMAT_RGB888;
+    for ( uint32_t i = 0; i < numOfInputs; i++ )
+    {
+        CL2DFlexConfig.workModes[i] = mode;
+        CL2DFlexConfig.inputWidths[i] = 256;
+        CL2DFlexConfig.inputHeights[i] = 192;
+        CL2DFlexConfig.inputFormats[i] = inputFormat;
+        /* ROIs scaled by 2, letterbox pads the bottom of input 0 and the right of input 1 */
+        CL2DFlexConfig.ROIs[i].x = bLetterbox ? 8 * ( i + 1 ) : 0;
+        CL2DFlexConfig.ROIs[i].y = bLetterbox ? 4 * ( i + 1 ) : 0;
+        CL2DFlexConfig.ROIs[i].width = ( bLetterbox && ( 1 == i ) ) ? 96 : 128;
+        CL2DFlexConfig.ROIs[i].height = bLetterbox ? ( 64 + 32 * i ) : 96;
+    }
+
+    DataTree dt;
+    dt.Set<std::string>( "static.name", "CL2D" );
+    dt.Set<uint32_t>( "static.id", 0 );
+    SetConfigCL2D( &CL2DFlexConfig, &dt );
+    std::vector<float> mean( pMean, pMean + 3 );
+    std::vector<float> stdDev( pStd, pStd + 3 );
+    dt.Set( "static.normalizeMean", mean );
+    dt.Set( "static.normalizeStd", stdDev );
+    dt.Set<std::string>( "static.tensorLayout",
+                         ( CL2DFLEX_TENSOR_LAYOUT_NCHW == layout ) ? "nchw" : "nhwc" );
+    QCNodeInit_t config = { dt.Dump() };
+
+    NodeFrameDescriptor frameDesc( numOfInputs + 1 );
+    std::vector<ImageDescriptor_t> inputs( numOfInputs );
+    for ( uint32_t i = 0; i < numOfInputs; i++ )
+    {
+        ImageProps_t imgProp;
+        imgProp.batchSize = 1;
+        imgProp.width = CL2DFlexConfig.inputWidths[i];
+        imgProp.height = CL2DFlexConfig.inputHeights[i];
+        imgProp.format = inputFormat;
+        if ( QC_IMAGE_FORMAT_UYVY == inputFormat )
+        {
+            imgProp.stride[0] = CL2DFlexConfig.inputWidths[i] * 2;
+            imgProp.actualHeight[0] = CL2DFlexConfig.inputHeights[i];
+            imgProp.planeBufSize[0] = 0;
+            imgProp.numPlanes = 1;
+        }
+        else
+        {
+            imgProp.stride[0] = CL2DFlexConfig.inputWidths[i];
+            imgProp.stride[1] = CL2DFlexConfig.inputWidths[i];
+            imgProp.actualHeight[0] = CL2DFlexConfig.inputHeights[i];
+            imgProp.actualHeight[1] = CL2DFlexConfig.inputHeights[i] / 2;
+            imgProp.planeBufSize[0] = 0;
+            imgProp.planeBufSize[1] = 0;
+            imgProp.numPlanes = 2;
+        }
+        ret = bufMgr.Allocate( imgProp, inputs[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        uint8_t *pData = (uint8_t *) inputs[i].pBuf;
+        for ( size_t j = 0; j < inputs[i].size; j++ )
+        {
+            pData[j] = (uint8_t) ( ( j * 7 + i * 31 ) & 0xFF );
+        }
+        ret = frameDesc.SetBuffer( i, inputs[i] );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    ImageDescriptor_t outputImage;
+    TensorDescriptor_t outputTensor;
+    QCBufferDescriptorBase_t *pOutput = nullptr;
+    if ( nullptr == pTensorProp )
+    {
+        ImageProps_t imgPropOutput;
+        imgPropOutput.batchSize = numOfInputs;
+        imgPropOutput.width = CL2DFlexConfig.outputWidth;
+        imgPropOutput.height = CL2DFlexConfig.outputHeight;
+        imgPropOutput.format = CL2DFlexConfig.outputFormat;
+        imgPropOutput.stride[0] = CL2DFlexConfig.outputWidth * 3;
+        imgPropOutput.actualHeight[0] = CL2DFlexConfig.outputHeight;
+        imgPropOutput.planeBufSize[0] = 0;
+        imgPropOutput.numPlanes = 1;
+        ret = bufMgr.Allocate( imgPropOutput, outputImage );
+        pOutput = &outputImage;
+    }
+    else
+    {
+        ret = bufMgr.Allocate( *pTensorProp, outputTensor );
+        outputTensor.quantScale = 0.0186f;
+        outputTensor.quantOffset = -114;
+        pOutput = &outputTensor;
+    }
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    memset( pOutput->pBuf, 0, pOutput->size );
+    ret = frameDesc.SetBuffer( numOfInputs, *pOutput );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Start();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    result.assign( (uint8_t *) pOutput->pBuf, (uint8_t *) pOutput->pBuf + pOutput->size );
+
+    ret = pCL2DFlex->Stop();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    for ( auto imageDesc : inputs )
+    {
+        ret = bufMgr.Free( imageDesc );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+    ret = bufMgr.Free( *pOutput );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
+}
+
 TEST( NodeCL2D, Sanity )
 {
     Sanity();
 }
 
+TEST( NodeCL2D, Async )
+{
+    Sanity( true );
+}
+
+TEST( NodeCL2D, Batched )
+{
+    CL2DFlex_Work_Mode_e modes[] = { CL2DFLEX_WORK_MODE_CONVERT, CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+                                     CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST };
+    for ( CL2DFlex_Work_Mode_e mode : modes )
+    {
+        /* 10 inputs are processed by a batch of 8 inputs and a batch of 2 inputs */
+        std::vector<uint8_t> serial;
+        std::vector<uint8_t> batched;
+        RunBatched( mode, 10, false, serial );
+        RunBatched( mode, 10, true, batched );
+        ASSERT_EQ( serial.size(), batched.size() );
+        EXPECT_EQ( 0, memcmp( serial.data(), batched.data(), serial.size() ) )
+                << "work mode " << mode << " mismatch";
+    }
+}
+
+TEST( NodeCL2D, OutOfOrder )
+{
+    CL2DFlex_Work_Mode_e modes[] = { CL2DFLEX_WORK_MODE_CONVERT, CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+                                     CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST };
+    for ( CL2DFlex_Work_Mode_e mode : modes )
+    {
+        /* the inputs write disjoint images of the output, so their order does not matter */
+        std::vector<uint8_t> inOrder;
+        std::vector<uint8_t> outOfOrder;
+        RunBatched( mode, 4, false, inOrder );
+        RunBatched( mode, 4, false, outOfOrder, true );
+        ASSERT_EQ( inOrder.size(), outOfOrder.size() );
+        EXPECT_EQ( 0, memcmp( inOrder.data(), outOfOrder.data(), inOrder.size() ) )
+                << "work mode " << mode << " mismatch";
+    }
+}
+
+TEST( NodeCL2D, Tuning )
+{
+    const std::string tuningPath = "/tmp/gtest_CL2DFlexTuning.db";
+    (void) remove( tuningPath.c_str() );
+    CL2DFlex_Work_Mode_e modes[] = { CL2DFLEX_WORK_MODE_CONVERT, CL2DFLEX_WORK_MODE_RESIZE_NEAREST,
+                                     CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST };
+    for ( CL2DFlex_Work_Mode_e mode : modes )
+    {
+        /* tuned on the first run, loaded from the database on the second run */
+        std::vector<uint8_t> reference;
+        std::vector<uint8_t> tuned;
+        std::vector<uint8_t> loaded;
+        RunBatched( mode, 2, false, reference );
+        RunBatched( mode, 2, false, tuned, false, tuningPath );
+        RunBatched( mode, 2, false, loaded, false, tuningPath );
+        ASSERT_EQ( reference.size(), tuned.size() );
+        ASSERT_EQ( reference.size(), loaded.size() );
+        EXPECT_EQ( 0, memcmp( reference.data(), tuned.data(), reference.size() ) )
+                << "work mode " << mode << " mismatch";
+        EXPECT_EQ( 0, memcmp( reference.data(), loaded.data(), reference.size() ) )
+                << "work mode " << mode << " mismatch";
+    }
+
+    FILE *pFile = fopen( tuningPath.c_str(), "r" );
+    ASSERT_NE( nullptr, pFile );
+    char magic[8] = { 0 };
+    EXPECT_EQ( 1, fscanf( pFile, "%7s", magic ) );
+    EXPECT_STREQ( "QCLT", magic );
+    fclose( pFile );
+    (void) remove( tuningPath.c_str() );
+}
+
+TEST( NodeCL2D, GpuProfiling )
+{
+    std::vector<uint8_t> reference;
+    std::vector<uint8_t> profiled;
+    QCNodeGpuProfile_t profile;
+    RunBatched( CL2DFLEX_WORK_MODE_RESIZE_NEAREST, 4, false, reference );
+    RunBatched( CL2DFLEX_WORK_MODE_RESIZE_NEAREST, 4, false, profiled, false, "", &profile );
+    ASSERT_EQ( reference.size(), profiled.size() );
+    EXPECT_EQ( 0, memcmp( reference.data(), profiled.data(), reference.size() ) );
+
+    /* the frame was waited for, so the launch of each input is counted */
+    ASSERT_LT( 0u, profile.numKernels );
+    ASSERT_GE( QCNODE_GPU_PROFILE_KERNELS_MAX, profile.numKernels );
+    uint64_t numLaunches = 0;
+    for ( uint32_t i = 0; i < profile.numKernels; i++ )
+    {
+        QCNodeGpuKernelProfile_t &kernel = profile.kernels[i];
+        uint64_t numBinned = 0;
+        for ( uint32_t bin = 0; bin < QCNODE_GPU_PROFILE_BINS; bin++ )
+        {
+            numBinned += kernel.histogram[bin];
+        }
+        EXPECT_LT( 0u, strlen( kernel.name ) );
+        EXPECT_EQ( kernel.numLaunches, numBinned );
+        EXPECT_GE( kernel.maxExecNs, kernel.lastExecNs );
+        EXPECT_GE( kernel.totalExecNs, kernel.maxExecNs );
+        numLaunches += kernel.numLaunches;
+    }
+    EXPECT_EQ( 4u, numLaunches );
+}
+
+TEST( NodeCL2D, SharedContext )
+{
+    std::vector<uint8_t> serial;
+    std::vector<uint8_t> chained;
+    RunChain( false, serial );
+    RunChain( true, chained );
+    ASSERT_EQ( serial.size(), chained.size() );
+    EXPECT_EQ( 0, memcmp( serial.data(), chained.data(), serial.size() ) );
+}
+
+/* the output of a multiple work mode for the ROIs of a 256x192 NV12 input into 64x48 RGB images,
+ * the ROIs given by the frame if bFrameROIs, else read from the ROIs buffer */
+void RunMultipleROIs( CL2DFlex_Work_Mode_e mode, const std::vector<CL2DFlex_ROIConfig_t> &ROIs,
+                      bool bFrameROIs, std::vector<uint8_t> &result )
+{
+    QCStatus_e ret;
+    uint32_t numOfROIs = (uint32_t) ROIs.size();
+    QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
+    BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+    QCNodeInit_t config;
+
+    CL2DFlex_Config_t CL2DFlexConfig;
+    CL2DFlexConfig.numOfInputs = 1;
+    CL2DFlexConfig.workModes[0] = mode;
+    CL2DFlexConfig.inputWidths[0] = 256;
+    CL2DFlexConfig.inputHeights[0] = 192;
+    CL2DFlexConfig.inputFormats[0] = QC_IMAGE_FORMAT_NV12;
+    CL2DFlexConfig.ROIs[0] = { 0, 0, 256, 192 };
+    CL2DFlexConfig.outputWidth = 64;
+    CL2DFlexConfig.outputHeight = 48;
+    CL2DFlexConfig.outputFormat = QC_IMAGE_FORMAT_RGB888;
+    DataTree dt;
+    dt.Set<std::string>( "static.name", "CL2D" );
+    dt.Set<uint32_t>( "static.id", 0 );
+    dt.Set<uint32_t>( "static.numOfROIs", numOfROIs );
+    SetConfigCL2D( &CL2DFlexConfig, &dt );
+
+    TensorDescriptor_t roisTensor;
+    if ( false == bFrameROIs )
+    {
+        TensorProps_t roisProp = { QC_TENSOR_TYPE_INT_32, { numOfROIs * 4 } };
+        ret = bufMgr.Allocate( roisProp, roisTensor );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        int32_t *pROIs = (int32_t *) roisTensor.pBuf;
+        for ( uint32_t i = 0; i < numOfROIs; i++ )
+        {
+            pROIs[i * 4 + 0] = (int32_t) ROIs[i].x;
+            pROIs[i * 4 + 1] = (int32_t) ROIs[i].y;
+            pROIs[i * 4 + 2] = (int32_t) ROIs[i].width;
+            pROIs[i * 4 + 3] = (int32_t) ROIs[i].height;
+        }
+        config.buffers.push_back( roisTensor );
+        dt.Set<uint32_t>( "static.ROIsBufferId", 0 );
+    }
+    config.config = dt.Dump();
+
+    ImageProps_t imgProp;
+    imgProp.batchSize = 1;
+    imgProp.width = 256;
+    imgProp.height = 192;
+    imgProp.format = QC_IMAGE_FORMAT_NV12;
+    imgProp.stride[0] = 256;
+    imgProp.stride[1] = 256;
+    imgProp.actualHeight[0] = 192;
+    imgProp.actualHeight[1] = 96;
+    imgProp.planeBufSize[0] = 0;
+    imgProp.planeBufSize[1] = 0;
+    imgProp.numPlanes = 2;
+    CL2DFlex_ROIImageDescriptor_t input;
+    ret = bufMgr.Allocate( imgProp, input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    uint8_t *pData = (uint8_t *) input.pBuf;
+    for ( size_t j = 0; j < input.size; j++ )
+    {
+        pData[j] = (uint8_t) ( ( j * 7 + ( j / 256 ) * 13 ) & 0xFF );
+    }
+    if ( bFrameROIs )
+    {
+        input.numOfROIs = numOfROIs;
+        std::copy( ROIs.begin(), ROIs.end(), input.ROIs );
+    }
+
+    ImageProps_t imgPropOutput;
+    imgPropOutput.batchSize = numOfROIs;
+    imgPropOutput.width = 64;
+    imgPropOutput.height = 48;
+    imgPropOutput.format = QC_IMAGE_FORMAT_RGB888;
+    imgPropOutput.stride[0] = 64 * 3;
+    imgPropOutput.actualHeight[0] = 48;
+    imgPropOutput.planeBufSize[0] = 0;
+    imgPropOutput.numPlanes = 1;
+    ImageDescriptor_t output;
+    ret = bufMgr.Allocate( imgPropOutput, output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    NodeFrameDescriptor frameDesc( 2 );
+    ret = frameDesc.SetBuffer( 0, input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = frameDesc.SetBuffer( 1, output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = pCL2DFlex->Start();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    memset( output.pBuf, 0x5A, output.size );
+    ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    result.assign( (uint8_t *) output.pBuf, (uint8_t *) output.pBuf + output.size );
+    ret = pCL2DFlex->Stop();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = pCL2DFlex->DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = bufMgr.Free( input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = bufMgr.Free( output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    if ( false == bFrameROIs )
+    {
+        ret = bufMgr.Free( roisTensor );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
+}
+
+TEST( NodeCL2D, FrameROIs )
+{
+    const CL2DFlex_ROIConfig_t ROIs[2] = { { 16, 8, 96, 120 }, { 128, 64, 64, 48 } };
+    const uint32_t numOfROIs = 4;
+    CL2DFlex_Work_Mode_e modes[] = { CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE,
+                                     CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE };
+    for ( CL2DFlex_Work_Mode_e mode : modes )
+    {
+        QCStatus_e ret;
+        QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
+        BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+
+        /* no ROIs buffer, each frame gives its ROIs */
+        CL2DFlex_Config_t CL2DFlexConfig;
+        CL2DFlexConfig.numOfInputs = 1;
+        CL2DFlexConfig.workModes[0] = mode;
+        CL2DFlexConfig.inputWidths[0] = 256;
+        CL2DFlexConfig.inputHeights[0] = 192;
+        CL2DFlexConfig.inputFormats[0] = QC_IMAGE_FORMAT_NV12;
+        CL2DFlexConfig.ROIs[0] = { 0, 0, 256, 192 };
+        CL2DFlexConfig.outputWidth = 64;
+        CL2DFlexConfig.outputHeight = 48;
+        CL2DFlexConfig.outputFormat = QC_IMAGE_FORMAT_RGB888;
+        DataTree dt;
+        dt.Set<std::string>( "static.name", "CL2D" );
+        dt.Set<uint32_t>( "static.id", 0 );
+        dt.Set<uint32_t>( "static.numOfROIs", numOfROIs );
+        SetConfigCL2D( &CL2DFlexConfig, &dt );
+        QCNodeInit_t config = { dt.Dump() };
+
+        ImageProps_t imgProp;
+        imgProp.batchSize = 1;
+        imgProp.width = 256;
+        imgProp.height = 192;
+        imgProp.format = QC_IMAGE_FORMAT_NV12;
+        imgProp.stride[0] = 256;
+        imgProp.stride[1] = 256;
+        imgProp.actualHeight[0] = 192;
+        imgProp.actualHeight[1] = 96;
+        imgProp.planeBufSize[0] = 0;
+        imgProp.planeBufSize[1] = 0;
+        imgProp.numPlanes = 2;
+        CL2DFlex_ROIImageDescriptor_t input;
+        ret = bufMgr.Allocate( imgProp, input );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        uint8_t *pData = (uint8_t *) input.pBuf;
+        for ( size_t j = 0; j < input.size; j++ )
+        {
+            pData[j] = (uint8_t) ( ( j * 7 + ( j / 256 ) * 13 ) & 0xFF );
+        }
+
+        ImageProps_t imgPropOutput;
+        imgPropOutput.batchSize = numOfROIs;
+        imgPropOutput.width = 64;
+        imgPropOutput.height = 48;
+        imgPropOutput.format = QC_IMAGE_FORMAT_RGB888;
+        imgPropOutput.stride[0] = 64 * 3;
+        imgPropOutput.actualHeight[0] = 48;
+        imgPropOutput.planeBufSize[0] = 0;
+        imgPropOutput.numPlanes = 1;
+        ImageDescriptor_t output;
+        ret = bufMgr.Allocate( imgPropOutput, output );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        NodeFrameDescriptor frameDesc( 2 );
+        ret = frameDesc.SetBuffer( 0, input );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = frameDesc.SetBuffer( 1, output );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        ret = pCL2DFlex->Initialize( config );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = pCL2DFlex->Start();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        /* the same ROIs in the other order in the next frame, the node is not reconfigured */
+        size_t imageSize = output.size / numOfROIs;
+        std::vector<uint8_t> results[2];
+        for ( uint32_t frame = 0; frame < 2; frame++ )
+        {
+            input.numOfROIs = 2;
+            input.ROIs[0] = ROIs[frame];
+            input.ROIs[1] = ROIs[1 - frame];
+            memset( output.pBuf, 0x5A, output.size );
+            ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+            results[frame].assign( (uint8_t *) output.pBuf,
+                                   (uint8_t *) output.pBuf + output.size );
+        }
+        EXPECT_EQ( 0, memcmp( results[0].data(), results[1].data() + imageSize, imageSize ) )
+                << "work mode " << mode << " mismatch";
+        EXPECT_EQ( 0, memcmp( results[0].data() + imageSize, results[1].data(), imageSize ) )
+                << "work mode " << mode << " mismatch";
+        EXPECT_TRUE( std::all_of( results[0].begin() + 2 * imageSize, results[0].end(),
+                                  []( uint8_t v ) { return 0x5A == v; } ) );
+
+        /* each image against the same ROI read from the ROIs buffer */
+        std::vector<uint8_t> reference;
+        RunMultipleROIs( mode, { ROIs[0], ROIs[1], ROIs[0], ROIs[1] }, false, reference );
+        ASSERT_EQ( results[0].size(), reference.size() );
+        for ( uint32_t i = 0; i < 2; i++ )
+        {
+            EXPECT_EQ( 0, memcmp( results[0].data() + i * imageSize,
+                                  reference.data() + i * imageSize, imageSize ) )
+                    << "work mode " << mode << " image " << i << " mismatch";
+        }
+
+        /* without ROIs and with an ROI out of the input */
+        input.numOfROIs = 0;
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pCL2DFlex->ProcessFrameDescriptor( frameDesc ) );
+        input.numOfROIs = 1;
+        input.ROIs[0] = { 200, 0, 64, 48 };
+        EXPECT_EQ( QC_STATUS_BAD_ARGUMENTS, pCL2DFlex->ProcessFrameDescriptor( frameDesc ) );
+
+        ret = pCL2DFlex->Stop();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = pCL2DFlex->DeInitialize();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        ret = bufMgr.Free( input );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = bufMgr.Free( output );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
+    }
+}
+
+TEST( NodeCL2D, FrameROIsMultiDispatch )
+{
+    /* more ROIs than one kernel dispatch takes, each of its own origin and size */
+    std::vector<CL2DFlex_ROIConfig_t> ROIs;
+    for ( uint32_t i = 0; i < 40; i++ )
+    {
+        ROIs.push_back( { ( i * 24 ) % 192, ( i * 10 ) % 96, 32 + ( i % 4 ) * 16,
+                          24 + ( i % 5 ) * 12 } );
+    }
+    CL2DFlex_Work_Mode_e modes[] = { CL2DFLEX_WORK_MODE_RESIZE_NEAREST_MULTIPLE,
+                                     CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST_MULTIPLE };
+    for ( CL2DFlex_Work_Mode_e mode : modes )
+    {
+        std::vector<uint8_t> frameResult;
+        std::vector<uint8_t> reference;
+        RunMultipleROIs( mode, ROIs, true, frameResult );
+        RunMultipleROIs( mode, ROIs, false, reference );
+        ASSERT_EQ( reference.size(), frameResult.size() );
+        size_t imageSize = reference.size() / ROIs.size();
+        for ( uint32_t i = 0; i < ROIs.size(); i++ )
+        {
+            EXPECT_EQ( 0, memcmp( frameResult.data() + i * imageSize,
+                                  reference.data() + i * imageSize, imageSize ) )
+                    << "work mode " << mode << " image " << i << " mismatch";
+        }
+    }
+}
+
+TEST( NodeCL2D, CpuProcessor )
+{
+    /* the pipelines on the CPU worker threads through the node API, a resize by 2 takes the even
+     * pixels of the input */
+    const uint32_t inW = 256, inH = 192, outW = 128, outH = 96;
+    QCStatus_e ret;
+    QCNodeIfs *pCL2DFlex = new QC::Node::CL2DFlex();
+    BufferManager bufMgr( { "MANAGER", QC_NODE_TYPE_CL_2D_FLEX, 0 } );
+
+    CL2DFlex_Config_t CL2DFlexConfig;
+    CL2DFlexConfig.numOfInputs = 1;
+    CL2DFlexConfig.workModes[0] = CL2DFLEX_WORK_MODE_RESIZE_NEAREST;
+    CL2DFlexConfig.inputWidths[0] = inW;
+    CL2DFlexConfig.inputHeights[0] = inH;
+    CL2DFlexConfig.inputFormats[0] = QC_IMAGE_FORMAT_RGB888;
+    CL2DFlexConfig.ROIs[0] = { 0, 0, inW, inH };
+    CL2DFlexConfig.outputWidth = outW;
+    CL2DFlexConfig.outputHeight = outH;
+    CL2DFlexConfig.outputFormat = QC_IMAGE_FORMAT_RGB888;
+    DataTree dt;
+    dt.Set<std::string>( "static.name", "CL2D" );
+    dt.Set<uint32_t>( "static.id", 0 );
+    dt.Set<std::string>( "static.processorType", "cpu" );
+    dt.Set<uint32_t>( "static.cpuThreads", 2 );
+    SetConfigCL2D( &CL2DFlexConfig, &dt );
+    QCNodeInit_t config = { dt.Dump() };
+
+    ImageDescriptor_t input;
+    ret = bufMgr.Allocate( ImageBasicProps_t( inW, inH, QC_IMAGE_FORMAT_RGB888 ), input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    uint8_t *pData = (uint8_t *) input.pBuf;
+    for ( size_t j = 0; j < input.size; j++ )
+    {
+        pData[j] = (uint8_t) ( ( j * 7 + ( j / 768 ) * 13 ) & 0xFF );
+    }
+    ImageDescriptor_t output;
+    ret = bufMgr.Allocate( ImageBasicProps_t( outW, outH, QC_IMAGE_FORMAT_RGB888 ), output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    NodeFrameDescriptor frameDesc( 2 );
+    ret = frameDesc.SetBuffer( 0, input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = frameDesc.SetBuffer( 1, output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = pCL2DFlex->Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = pCL2DFlex->Start();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    memset( output.pBuf, 0x5A, output.size );
+    ret = pCL2DFlex->ProcessFrameDescriptor( frameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    const uint8_t *pOut = (const uint8_t *) output.pBuf;
+    uint32_t numMismatch = 0;
+    for ( uint32_t y = 0; y < outH; y++ )
+    {
+        for ( uint32_t x = 0; x < outW; x++ )
+        {
+            const uint8_t *pIn = pData + y * 2 * input.stride[0] + x * 2 * 3;
+            if ( 0 != memcmp( pOut + y * output.stride[0] + x * 3, pIn, 3 ) )
+            {
+                numMismatch++;
+            }
+        }
+    }
+    EXPECT_EQ( 0u, numMismatch );
+
+    ret = pCL2DFlex->Stop();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = pCL2DFlex->DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    ret = bufMgr.Free( input );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = bufMgr.Free( output );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    reinterpret_cast<QC::Node::CL2DFlex *>( pCL2DFlex )->~CL2DFlex();
+}
+
+TEST( NodeCL2D, Normalize )
+{
+    const float mean[3] = { 123.675f, 116.28f, 103.53f };
+    const float stdDev[3] = { 58.395f, 57.12f, 57.375f };
+    const uint32_t N = 2, H = 48, W = 64;
+    struct
+    {
+        CL2DFlex_Work_Mode_e refMode;
+        CL2DFlex_Work_Mode_e mode;
+        QCImageFormat_e inputFormat;
+    } cases[] = {
+            { CL2DFLEX_WORK_MODE_RESIZE_NEAREST, CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE,
+              QC_IMAGE_FORMAT_NV12 },
+            { CL2DFLEX_WORK_MODE_RESIZE_NEAREST, CL2DFLEX_WORK_MODE_RESIZE_NORMALIZE,
+              QC_IMAGE_FORMAT_UYVY },
+            { CL2DFLEX_WORK_MODE_LETTERBOX_NEAREST, CL2DFLEX_WORK_MODE_LETTERBOX_NORMALIZE,
+              QC_IMAGE_FORMAT_NV12 },
+    };
+    CL2DFlex_Tensor_Layout_e layouts[] = { CL2DFLEX_TENSOR_LAYOUT_NHWC,
+                                           CL2DFLEX_TENSOR_LAYOUT_NCHW };
+    QCTensorType_e types[] = { QC_TENSOR_TYPE_UFIXED_POINT_8, QC_TENSOR_TYPE_FLOAT_32 };
+
+    for ( auto &tc : cases )
+    {
+        /* the fused kernel must match the reference RGB images normalized and quantized on CPU */
+        std::vector<uint8_t> rgb;
+        RunNormalize( tc.refMode, tc.inputFormat, nullptr, CL2DFLEX_TENSOR_LAYOUT_NHWC, mean,
+                      stdDev, rgb );
+        ASSERT_EQ( N * H * W * 3, rgb.size() );
+        for ( CL2DFlex_Tensor_Layout_e layout : layouts )
+        {
+            for ( QCTensorType_e type : types )
+            {
+                bool bNCHW = ( CL2DFLEX_TENSOR_LAYOUT_NCHW == layout );
+                TensorProps_t prop( type, bNCHW ? std::vector<uint32_t>{ N, 3, H, W }
+                                                : std::vector<uint32_t>{ N, H, W, 3 } );
+                std::vector<uint8_t> tensor;
+                RunNormalize( tc.mode, tc.inputFormat, &prop, layout, mean, stdDev, tensor );
+                float maxDiff = 0.0f;
+                for ( uint32_t n = 0; n < N; n++ )
+                {
+                    for ( uint32_t i = 0; i < H * W; i++ )
+                    {
+                        for ( uint32_t c = 0; c < 3; c++ )
+                        {
+                            float value = ( rgb[( n * H * W + i ) * 3 + c] - mean[c] ) / stdDev[c];
+                            size_t idx = bNCHW ? ( ( n * 3 + c ) * H * W + i )
+                                               : ( ( n * H * W + i ) * 3 + c );
+                            float diff;
+                            if ( QC_TENSOR_TYPE_FLOAT_32 == type )
+                            {
+                                diff = value - ( (float *) tensor.data() )[idx];
+                            }
+                            else
+                            {
+                                float q = std::round( value / 0.0186f + 114.0f );
+                                q = std::min( 255.0f, std::max( 0.0f, q ) );
+                                diff = q - (float) tensor[idx];
+                            }
+                            maxDiff = std::max( maxDiff, std::fabs( diff ) );
+                        }
+                    }
+                }
+                float tolerance = ( QC_TENSOR_TYPE_FLOAT_32 == type ) ? 1e-4f : 1.0f;
+                EXPECT_LE( maxDiff, tolerance ) << "work mode " << tc.mode << " format "
+                                                << tc.inputFormat << " layout " << layout
+                                                << " type " << type;
+            }
+        }
+    }
+}
+
 // md5 of 0.nv12 is a1591f4b8c196a47628f0ef6bc3a721c
 // md5 of 0.uyvy is 5b1ae2203a9d97aeafe65e997f3beebc
 // md5 of 0.ubwc is ce5f81f72f9c0ec0c347b1ee55d13584
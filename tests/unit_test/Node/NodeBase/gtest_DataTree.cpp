@@ -188,4 +188,295 @@ TEST( NodeBase, Sanity_DataTree )
             ASSERT_EQ( kv.second, dt.Get<std::string>( "A.B.processor", "" ) );
         }
     }
-}
\ No newline at end of file
+}
+
+typedef enum
+{
+    DATA_TREE_TEST_MODE_FAST,
+    DATA_TREE_TEST_MODE_SLOW
+} DataTreeTestMode_e;
+
+typedef struct
+{
+    std::string name;
+    uint32_t width;
+    float scale;
+    bool bEnable;
+    std::vector<uint32_t> ids;
+    QCImageFormat_e format;
+    QCProcessorType_e processor;
+    DataTreeTestMode_e mode;
+} DataTreeTestConfig_t;
+
+typedef struct
+{
+    std::string name;
+    uint32_t id;
+} DataTreeTestItem_t;
+
+typedef struct
+{
+    uint32_t minWidth;
+    uint32_t maxWidth;
+    uint32_t mask;
+    std::vector<DataTreeTestItem_t> items;
+} DataTreeTestRangeConfig_t;
+
+TEST( NodeBase, Sanity_DataTreePath )
+{
+    QCStatus_e status;
+    std::string errors;
+    DataTree dt;
+
+    status = dt.Load(
+            R"({"static": {"width": 1920, "ids": [1, 2], "format": "nv12", "name": 3}})", errors );
+    ASSERT_EQ( QC_STATUS_OK, status );
+
+    const DataTree::Path widthPath( "static.width" );
+    ASSERT_EQ( "static.width", widthPath.GetKey() );
+    ASSERT_EQ( 2, widthPath.GetTokens().size() );
+    ASSERT_EQ( true, dt.Exists( widthPath ) );
+    ASSERT_EQ( false, dt.Exists( DataTree::Path( "static.width.x" ) ) );
+    ASSERT_EQ( false, dt.Exists( DataTree::Path( "dynamic.width" ) ) );
+    ASSERT_EQ( 1920, dt.Get<uint32_t>( widthPath, 0 ) );
+    ASSERT_EQ( 7, dt.Get<uint32_t>( DataTree::Path( "static.height" ), 7 ) );
+
+    /* wrong type returns the default value */
+    ASSERT_EQ( "none", dt.Get<std::string>( DataTree::Path( "static.name" ), "none" ) );
+    ASSERT_EQ( QC_PROCESSOR_MAX,
+               dt.GetProcessorType( DataTree::Path( "static.name" ), QC_PROCESSOR_CPU ) );
+
+    std::vector<uint32_t> ids =
+            dt.Get<uint32_t>( DataTree::Path( "static.ids" ), std::vector<uint32_t>( {} ) );
+    ASSERT_EQ( 2, ids.size() );
+    ASSERT_EQ( QC_IMAGE_FORMAT_NV12,
+               dt.GetImageFormat( DataTree::Path( "static.format" ), QC_IMAGE_FORMAT_MAX ) );
+
+    DataTree dtStatic;
+    status = dt.Get( DataTree::Path( "static" ), dtStatic );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( 1920, dtStatic.Get<uint32_t>( "width", 0 ) );
+    std::vector<DataTree> dts;
+    status = dt.Get( DataTree::Path( "static.ids" ), dts );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( 2, dts.size() );
+    status = dt.Get( DataTree::Path( "static.x" ), dts );
+    ASSERT_EQ( QC_STATUS_OUT_OF_BOUND, status );
+}
+
+TEST( NodeBase, Sanity_DataTreeSchema )
+{
+    QCStatus_e status;
+    std::string errors;
+    DataTreeTestConfig_t config;
+
+    static const DataTree::Schema<DataTreeTestConfig_t> s_schema =
+            DataTree::Schema<DataTreeTestConfig_t>()
+                    .Add<std::string>( "name", &DataTreeTestConfig_t::name, "", true )
+                    .Add<uint32_t>( "size.width", &DataTreeTestConfig_t::width, 0, true )
+                    .Add<float>( "scale", &DataTreeTestConfig_t::scale, 1.0f )
+                    .Add<bool>( "enable", &DataTreeTestConfig_t::bEnable, false )
+                    .Add<std::vector<uint32_t>>( "ids", &DataTreeTestConfig_t::ids, {} )
+                    .AddImageFormat( "format", &DataTreeTestConfig_t::format,
+                                     QC_IMAGE_FORMAT_RGB888 )
+                    .AddProcessorType( "processor", &DataTreeTestConfig_t::processor,
+                                       QC_PROCESSOR_HTP0 )
+                    .AddEnum<DataTreeTestMode_e>( "mode", &DataTreeTestConfig_t::mode,
+                                                  { { "fast", DATA_TREE_TEST_MODE_FAST },
+                                                    { "slow", DATA_TREE_TEST_MODE_SLOW } },
+                                                  DATA_TREE_TEST_MODE_FAST );
+
+    {
+        DataTree dt;
+        status = dt.Load( R"({"name": "A", "size": {"width": 64}, "enable": true,
+                              "ids": [3, 4, 5], "format": "uyvy", "mode": "slow"})",
+                          errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        ASSERT_EQ( "A", config.name );
+        ASSERT_EQ( 64, config.width );
+        ASSERT_EQ( 1.0f, config.scale );
+        ASSERT_EQ( true, config.bEnable );
+        ASSERT_EQ( 3, config.ids.size() );
+        ASSERT_EQ( QC_IMAGE_FORMAT_UYVY, config.format );
+        ASSERT_EQ( QC_PROCESSOR_HTP0, config.processor );
+        ASSERT_EQ( DATA_TREE_TEST_MODE_SLOW, config.mode );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"name": 1, "scale": "x", "format": "yuv", "mode": "medium"})",
+                          errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_NE( std::string::npos, errors.find( "the name is invalid" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the size.width is required" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the scale is invalid" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the format is invalid" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the mode medium is invalid" ) );
+        ASSERT_EQ( std::string::npos, errors.find( "the enable" ) );
+    }
+}
+
+TEST( NodeBase, Sanity_DataTreeSchemaCheck )
+{
+    QCStatus_e status;
+    std::string errors;
+    DataTreeTestRangeConfig_t config;
+
+    static const DataTree::Schema<DataTreeTestItem_t> s_itemSchema =
+            DataTree::Schema<DataTreeTestItem_t>()
+                    .Add<std::string>( "name", &DataTreeTestItem_t::name, "" )
+                    .Add<uint32_t>( "id", &DataTreeTestItem_t::id, 0, true )
+                    .Check( "name is empty",
+                            []( const DataTreeTestItem_t &item ) { return !item.name.empty(); } );
+    static const DataTree::Schema<DataTreeTestRangeConfig_t> s_schema =
+            DataTree::Schema<DataTreeTestRangeConfig_t>()
+                    .Add<uint32_t>( "minWidth", &DataTreeTestRangeConfig_t::minWidth, 0 )
+                    .Add<uint32_t>( "maxWidth", &DataTreeTestRangeConfig_t::maxWidth, 4096 )
+                    .AddField<std::vector<uint32_t>>(
+                            "bits",
+                            []( const std::vector<uint32_t> *pBits,
+                                DataTreeTestRangeConfig_t &config ) {
+                                bool bValid = true;
+                                config.mask = 0;
+                                if ( nullptr != pBits )
+                                {
+                                    for ( uint32_t bit : *pBits )
+                                    {
+                                        bValid = bValid && ( bit < 32 );
+                                        config.mask |= ( bValid ? ( 1u << bit ) : 0 );
+                                    }
+                                }
+                                return bValid;
+                            } )
+                    .AddList<DataTreeTestItem_t>( "items", &DataTreeTestRangeConfig_t::items,
+                                                  s_itemSchema )
+                    .Check( "minWidth is higher than maxWidth",
+                            []( const DataTreeTestRangeConfig_t &config ) {
+                                return config.minWidth <= config.maxWidth;
+                            } );
+
+    {
+        DataTree dt;
+        status = dt.Load( R"({"minWidth": 64, "bits": [0, 3],
+                              "items": [{"name": "A", "id": 1}, {"name": "B", "id": 2}]})",
+                          errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        ASSERT_EQ( 64, config.minWidth );
+        ASSERT_EQ( 4096, config.maxWidth );
+        ASSERT_EQ( 0x9, config.mask );
+        ASSERT_EQ( 2, config.items.size() );
+        ASSERT_EQ( "B", config.items[1].name );
+        ASSERT_EQ( 2, config.items[1].id );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"minWidth": 64, "maxWidth": 32})", errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_NE( std::string::npos, errors.find( "the minWidth is higher than maxWidth" ) );
+        ASSERT_EQ( 0, config.items.size() );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"minWidth": 64, "maxWidth": 32, "bits": [40],
+                              "items": [{"name": "A", "id": 1}, {"id": 2}, {"name": "C"}, 3]})",
+                          errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_NE( std::string::npos, errors.find( "the bits is invalid" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the items[1].name is empty" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the items[2].id is required" ) );
+        ASSERT_NE( std::string::npos, errors.find( "the items[3] is invalid" ) );
+        ASSERT_EQ( std::string::npos, errors.find( "the items is invalid" ) );
+        ASSERT_EQ( std::string::npos, errors.find( "items[0]" ) );
+        /* the checks only run once all the fields are valid */
+        ASSERT_EQ( std::string::npos, errors.find( "higher than" ) );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"items": {"name": "A", "id": 1}})", errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_NE( std::string::npos, errors.find( "the items is invalid" ) );
+    }
+}
+
+TEST( NodeBase, Sanity_DataTreeSchemaError )
+{
+    QCStatus_e status;
+    std::string errors;
+    DataTreeTestRangeConfig_t config;
+
+    static const DataTree::Schema<DataTreeTestItem_t> s_itemSchema =
+            DataTree::Schema<DataTreeTestItem_t>()
+                    .Add<std::string>( "name", &DataTreeTestItem_t::name, "" )
+                    .Add<uint32_t>( "id", &DataTreeTestItem_t::id, 0 )
+                    .Check( "name is empty",
+                            []( const DataTreeTestItem_t &item ) { return !item.name.empty(); } );
+    static const DataTree::Schema<DataTreeTestRangeConfig_t> s_schema =
+            DataTree::Schema<DataTreeTestRangeConfig_t>()
+                    .AddField<uint32_t>( "minWidth",
+                                         []( const uint32_t *pWidth,
+                                             DataTreeTestRangeConfig_t &config,
+                                             std::string &error ) {
+                                             config.minWidth = ( nullptr != pWidth ) ? *pWidth : 0;
+                                             error = "<" + std::to_string( config.minWidth ) +
+                                                     "> is odd";
+                                             return 0 == ( config.minWidth % 2 );
+                                         } )
+                    .Add<uint32_t>( "maxWidth", &DataTreeTestRangeConfig_t::maxWidth, 4096 )
+                    .AddList<DataTreeTestItem_t>( "items", &DataTreeTestRangeConfig_t::items,
+                                                  s_itemSchema, "item" )
+                    .Check( []( const DataTreeTestRangeConfig_t &config, std::string &error ) {
+                        error = "maxWidth " + std::to_string( config.maxWidth ) + " is too big";
+                        return config.maxWidth <= 4096;
+                    } );
+
+    {
+        DataTree dt;
+        status = dt.Load( R"({"minWidth": 63, "items": [{"id": 1}, 2]})", errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_EQ( "the minWidth <63> is odd, the item 0 name is empty, the item 1 is invalid, ",
+                   errors );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"minWidth": 64, "maxWidth": 8192})", errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, status );
+        ASSERT_EQ( "the maxWidth 8192 is too big, ", errors );
+    }
+
+    {
+        DataTree dt;
+        errors = "";
+        status = dt.Load( R"({"minWidth": 64, "items": [{"name": "A", "id": 1}]})", errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        status = s_schema.Bind( dt, config, errors );
+        ASSERT_EQ( QC_STATUS_OK, status );
+        ASSERT_EQ( "", errors );
+        ASSERT_EQ( 64, config.minWidth );
+        ASSERT_EQ( 1, config.items.size() );
+    }
+}
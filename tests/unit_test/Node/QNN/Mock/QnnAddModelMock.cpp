@@ -166,6 +166,90 @@ static ModelError_t addNode_Add_0( QnnModel &model )
     return err;
 }
 
+/* a float input tensor of the chained graphs, named after the tensor it is chained to */
+static ModelError_t addTensor_input( QnnModel &model, const char *name )
+{
+    ModelError_t err = MODEL_NO_ERROR;
+    uint32_t dimensions_input[] = { 1, 128, 3, 128 };
+    VALIDATE(
+            model.addTensor(
+                    name,   // Tensor Name
+                    (Qnn_Tensor_t) {
+                            .version = QNN_TENSOR_VERSION_2,
+                            { .v2 = { .id = 0,
+                                      .name = name,
+                                      .type = QNN_TENSOR_TYPE_APP_WRITE,
+                                      .dataFormat = QNN_TENSOR_DATA_FORMAT_DENSE,
+                                      .dataType = QNN_DATATYPE_FLOAT_32,
+                                      .quantizeParams =
+                                              { QNN_DEFINITION_UNDEFINED,
+                                                QNN_QUANTIZATION_ENCODING_UNDEFINED,
+                                                { .scaleOffsetEncoding =
+                                                          { .scale =
+                                                                    0.0000000000000000000000000000000000000000f,
+                                                            .offset = 0 } } },
+                                      .rank = 4,
+                                      .dimensions = dimensions_input,
+                                      .memType = QNN_TENSORMEMTYPE_RAW,
+                                      { .clientBuf = { .data = nullptr, .dataSize = 0 } },
+                                      .isDynamicDimensions = nullptr,
+                                      .sparseParams = { QNN_SPARSE_LAYOUT_UNDEFINED,
+                                                        .hybridCoo = { .numSpecifiedElements = 0,
+                                                                       .numSparseDimensions = 0 } },
+                                      .isProduced = 0 } } } ),
+            err );
+    return err;
+}
+
+/* an element wise add of two tensors of the graph into a new output tensor */
+static ModelError_t addNode_Add( QnnModel &model, const char *nodeName, const char *input0,
+                                 const char *input1, const char *output )
+{
+    ModelError_t err = MODEL_NO_ERROR;
+
+    Qnn_Param_t params_Add[] = {
+            { .paramType = QNN_PARAMTYPE_SCALAR,
+              .name = "operation",
+              { .scalarParam = (Qnn_Scalar_t) { QNN_DATATYPE_UINT_32, { .uint32Value = 0 } } } } };
+    const char *inputs_Add[] = { input0, input1 };
+    uint32_t dimensions_output[] = { 1, 128, 3, 128 };
+    Qnn_Tensor_t outputs_Add[] = { (Qnn_Tensor_t) {
+            .version = QNN_TENSOR_VERSION_2,
+            { .v2 = { .id = 0,
+                      .name = output,
+                      .type = QNN_TENSOR_TYPE_APP_READ,
+                      .dataFormat = QNN_TENSOR_DATA_FORMAT_DENSE,
+                      .dataType = QNN_DATATYPE_FLOAT_32,
+                      .quantizeParams =
+                              { QNN_DEFINITION_UNDEFINED,
+                                QNN_QUANTIZATION_ENCODING_UNDEFINED,
+                                { .scaleOffsetEncoding =
+                                          { .scale = 0.0000000000000000000000000000000000000000f,
+                                            .offset = 0 } } },
+                      .rank = 4,
+                      .dimensions = dimensions_output,
+                      .memType = QNN_TENSORMEMTYPE_RAW,
+                      { .clientBuf = { .data = nullptr, .dataSize = 0 } },
+                      .isDynamicDimensions = nullptr,
+                      .sparseParams = { QNN_SPARSE_LAYOUT_UNDEFINED,
+                                        .hybridCoo = { .numSpecifiedElements = 0,
+                                                       .numSparseDimensions = 0 } },
+                      .isProduced = 0 } } } };
+    VALIDATE( model.addNode( QNN_OPCONFIG_VERSION_1,   // Op_Config_t Version
+                             nodeName,                 // Node Name
+                             "qti.aisw",               // Package Name
+                             "ElementWiseBinary",      // Qnn Node Type
+                             params_Add,               // Node Params
+                             1,                        // Num Node Params
+                             inputs_Add,               // Input Tensor Names
+                             2,                        // Num Input Tensor Names
+                             outputs_Add,              // Output Tensors
+                             1                         // Num Output Tensors
+                             ),
+              err );
+    return err;
+}
+
 extern "C" QNN_API ModelError_t QnnModel_composeGraphs(
         Qnn_BackendHandle_t backendHandle, QNN_INTERFACE_VER_TYPE interface,
         Qnn_ContextHandle_t contextHandle, const GraphConfigInfo_t **graphsConfigInfo,
@@ -175,8 +259,17 @@ extern "C" QNN_API ModelError_t QnnModel_composeGraphs(
 
     ModelError_t err = MODEL_NO_ERROR;
 
+    /* the graphs of the context, the models must be contiguous for getGraphInfoFromModels:
+     * add_model: output = input1 + input2
+     * double_model: output2 = output + output, chained to the output of add_model
+     * add_model_3: output3 = input1 + input2, independent of the others */
+    QnnModel models[3];
+    uint32_t numModels = 3;
+    QnnModel &add_model = models[0];
+    QnnModel &double_model = models[1];
+    QnnModel &add_model_3 = models[2];
+
     /* model/graph for add_model*/
-    QnnModel add_model;
     const QnnGraph_Config_t **graphConfigs = nullptr;
     VALIDATE( getQnnGraphConfigFromInfo( "add_model", graphsConfigInfo, numGraphsConfigInfo,
                                          graphConfigs ),
@@ -188,12 +281,31 @@ extern "C" QNN_API ModelError_t QnnModel_composeGraphs(
     VALIDATE( addTensor_input2( add_model ), err );
     VALIDATE( addNode_Add_0( add_model ), err );
 
-    // Add all models to array to get graphsInfo
-    QnnModel *models[] = { &add_model };
-    uint32_t numModels = 1;
+    /* model/graph for double_model*/
+    graphConfigs = nullptr;
+    VALIDATE( getQnnGraphConfigFromInfo( "double_model", graphsConfigInfo, numGraphsConfigInfo,
+                                         graphConfigs ),
+              err );
+    VALIDATE( double_model.initialize( backendHandle, interface, contextHandle, "double_model",
+                                       debug, DO_GRAPH_NODE_VALIDATIONS, graphConfigs ),
+              err );
+    VALIDATE( addTensor_input( double_model, "output" ), err );
+    VALIDATE( addNode_Add( double_model, "Add_1", "output", "output", "output2" ), err );
+
+    /* model/graph for add_model_3*/
+    graphConfigs = nullptr;
+    VALIDATE( getQnnGraphConfigFromInfo( "add_model_3", graphsConfigInfo, numGraphsConfigInfo,
+                                         graphConfigs ),
+              err );
+    VALIDATE( add_model_3.initialize( backendHandle, interface, contextHandle, "add_model_3",
+                                      debug, DO_GRAPH_NODE_VALIDATIONS, graphConfigs ),
+              err );
+    VALIDATE( addTensor_input1( add_model_3 ), err );
+    VALIDATE( addTensor_input2( add_model_3 ), err );
+    VALIDATE( addNode_Add( add_model_3, "Add_2", "input1", "input2", "output3" ), err );
 
     // Populate the constructed graphs in provided output variables
-    VALIDATE( getGraphInfoFromModels( *models, numModels, graphsInfo ), err );
+    VALIDATE( getGraphInfoFromModels( models, numModels, graphsInfo ), err );
     *numGraphsInfo = numModels;
 
     if ( MOCK_ADD_MODEL_CONTROL_API_NONE != s_MockParams[MOCK_ADD_MODEL_API_COMPOSE_GRAPH].action )
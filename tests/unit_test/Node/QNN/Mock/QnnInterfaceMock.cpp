@@ -3,6 +3,11 @@
 
 #include "QnnInterfaceMock.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 typedef Qnn_ErrorHandle_t ( *QnnInterfaceGetProvidersFn_t )( const QnnInterface_t ***providerList,
                                                              uint32_t *numProviders );
 
@@ -654,6 +659,53 @@ Qnn_ErrorHandle_t QnnLog_FreeFn( Qnn_LogHandle_t logger )
     return ret;
 }
 
+/* the time the mock device is busy until, the delayed graphs are executed one by one */
+static std::mutex s_mockDeviceLock;
+static std::chrono::steady_clock::time_point s_mockDeviceFreeTime;
+
+Qnn_ErrorHandle_t QnnGraph_ExecuteAsyncFn( Qnn_GraphHandle_t graphHandle,
+                                           const Qnn_Tensor_t *inputs, uint32_t numInputs,
+                                           Qnn_Tensor_t *outputs, uint32_t numOutputs,
+                                           Qnn_ProfileHandle_t profileHandle,
+                                           Qnn_SignalHandle_t signalHandle, Qnn_NotifyFn_t notifyFn,
+                                           void *notifyParam )
+{
+    Qnn_ErrorHandle_t ret = QNN_SUCCESS;
+    if ( MOCK_CONTROL_API_DELAYED_NOTIFY ==
+         s_MockParams[MOCK_API_QNN_GRAPH_EXECUTE_ASYNC].action )
+    {
+        /* not consumed, so a benchmark can submit many frames to a device of fixed latency */
+        uint32_t latencyUs = *(uint32_t *) s_MockParams[MOCK_API_QNN_GRAPH_EXECUTE_ASYNC].param;
+        std::chrono::steady_clock::time_point doneTime;
+        {
+            std::lock_guard<std::mutex> l( s_mockDeviceLock );
+            doneTime = std::max( std::chrono::steady_clock::now(), s_mockDeviceFreeTime ) +
+                       std::chrono::microseconds( latencyUs );
+            s_mockDeviceFreeTime = doneTime;
+        }
+        std::thread( [doneTime, notifyFn, notifyParam]() {
+            std::this_thread::sleep_until( doneTime );
+            Qnn_NotifyStatus_t notifyStatus;
+            notifyStatus.error = QNN_SUCCESS;
+            notifyFn( notifyParam, notifyStatus );
+        } ).detach();
+    }
+    else
+    {
+        printf( "call real QNN graphExecuteAsync\n" );
+        ret = s_realInterface.QNN_INTERFACE_VER_NAME.graphExecuteAsync(
+                graphHandle, inputs, numInputs, outputs, numOutputs, profileHandle, signalHandle,
+                notifyFn, notifyParam );
+        if ( MOCK_CONTROL_API_RETURN == s_MockParams[MOCK_API_QNN_GRAPH_EXECUTE_ASYNC].action )
+        {
+            ret = *(Qnn_ErrorHandle_t *) s_MockParams[MOCK_API_QNN_GRAPH_EXECUTE_ASYNC].param;
+            s_MockParams[MOCK_API_QNN_GRAPH_EXECUTE_ASYNC].action =
+                    MOCK_CONTROL_API_NONE; /* consume it and invalide the control */
+        }
+    }
+    return ret;
+}
+
 Qnn_ErrorHandle_t QnnInterface_getProviders( const QnnInterface_t ***providerList,
                                              uint32_t *numProviders )
 {
@@ -703,6 +755,7 @@ Qnn_ErrorHandle_t QnnInterface_getProviders( const QnnInterface_t ***providerLis
                     QnnDevice_FreePlatformInfoFn;
             s_mockInterface.QNN_INTERFACE_VER_NAME.backendFree = QnnBackend_FreeFn;
             s_mockInterface.QNN_INTERFACE_VER_NAME.logFree = QnnLog_FreeFn;
+            s_mockInterface.QNN_INTERFACE_VER_NAME.graphExecuteAsync = QnnGraph_ExecuteAsyncFn;
             s_qnnInterfaceHolder[0] = &s_mockInterface;
             *providerList = s_qnnInterfaceHolder;
         }
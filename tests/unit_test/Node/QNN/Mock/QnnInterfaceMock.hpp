@@ -40,6 +40,7 @@ typedef enum
     MOCK_CONTROL_API_OUT_PARAM0_SET_PLATFORM_INFO_NUM_DEVICE_0,
     MOCK_CONTROL_API_OUT_PARAM0_SET_CONTEXT_CREATE_FROM_BINARY_INFO_NULL,
     MOCK_CONTROL_API_OUT_PARAM0_SET_GRAPH_RETRIEVE_NULL,
+    MOCK_CONTROL_API_DELAYED_NOTIFY, /* param is a uint32_t latency in us, kept until reset */
 } MockAPI_Action_e;
 
 typedef enum
@@ -70,6 +71,7 @@ typedef enum
     MOCK_API_QNN_DEVICE_FREE_PLATFORM_INFO,
     MOCK_API_QNN_BACKEND_FREE,
     MOCK_API_QNN_LOG_FREE,
+    MOCK_API_QNN_GRAPH_EXECUTE_ASYNC,
     MOCK_API_MAX
 } MockAPI_ID_e;
 
@@ -117,6 +117,15 @@ public:
         return qnn.CreateFromBinaryFile( modelFile );
     }
 
+    QCStatus_e MapBinaryFile( const std::string &modelFile, void *&pData, size_t &size )
+    {
+        return qnn.MapBinaryFile( modelFile, pData, size );
+    }
+
+    void UnmapBinaryFile( void *pData ) { qnn.UnmapBinaryFile( pData ); }
+
+    static size_t GetNumMappedBinaries() { return QnnImpl::s_mappedBinaryMap.size(); }
+
     QCStatus_e SetupGlobalBufferIdMap() { return qnn.SetupGlobalBufferIdMap(); }
 
     QCStatus_e ExtractProfilingEvent( QnnProfile_EventId_t profileEventId, Qnn_Perf_t &perf,
@@ -223,6 +232,12 @@ public:
 
     QCStatus_e SetPerformanceMode() { return qnn.SetPerformanceMode(); }
 
+    void GovernPerf( uint64_t latencyUs ) { qnn.GovernPerf( latencyUs ); }
+
+    Qnn_PerfProfile_e GetGovernorProfile() { return qnn.m_governorProfile; }
+
+    std::vector<Qnn_PerfProfile_e> GetAppliedProfiles() { return qnn.m_appliedProfiles; }
+
     static void QnnLog_Callback( const char *fmt, QnnLog_Level_t logLevel, uint64_t timestamp,
                                  va_list args )
     {
@@ -408,7 +423,11 @@ protected:
         ASSERT_EQ( QC_STATUS_OK, ret );
     }
 
-    void AllocateBuffers()
+    void AllocateBuffers() { AllocateFrame( pFrameDesc, inputs, outputs ); }
+
+    /* a frame descriptor with its own input and output tensors */
+    void AllocateFrame( NodeFrameDescriptor *&pDesc, std::vector<TensorDescriptor_t> &frameInputs,
+                        std::vector<TensorDescriptor_t> &frameOutputs )
     {
         QCNodeConfigIfs &cfgIfs = qnn.GetConfigurationIfs();
         const std::string &options = cfgIfs.GetOptions();
@@ -430,9 +449,9 @@ protected:
             bufferDescNum = inputDts.size() + outputDts.size() + 1;
         }
 
-        pFrameDesc = new NodeFrameDescriptor( bufferDescNum );
+        pDesc = new NodeFrameDescriptor( bufferDescNum );
         uint32_t globalIdx = 0;
-        inputs.reserve( inputDts.size() );
+        frameInputs.reserve( inputDts.size() );
         for ( auto &inDt : inputDts )
         {
             TensorProps_t props;
@@ -441,20 +460,20 @@ protected:
             TensorDescriptor_t tensorDesc;
             ret = bufMgr.Allocate( props, tensorDesc );
             ASSERT_EQ( QC_STATUS_OK, ret );
-            inputs.push_back( tensorDesc );
+            frameInputs.push_back( tensorDesc );
             if ( globalBufferIds.size() > 0 )
             {
                 uint32_t globalIdxCfg = globalBufferIds[globalIdx];
-                ret = pFrameDesc->SetBuffer( globalIdxCfg, inputs.back() );
+                ret = pDesc->SetBuffer( globalIdxCfg, frameInputs.back() );
             }
             else
             {
-                ret = pFrameDesc->SetBuffer( globalIdx, inputs.back() );
+                ret = pDesc->SetBuffer( globalIdx, frameInputs.back() );
             }
             ASSERT_EQ( QC_STATUS_OK, ret );
             globalIdx++;
         }
-        outputs.reserve( outputDts.size() );
+        frameOutputs.reserve( outputDts.size() );
         for ( auto &outDt : outputDts )
         {
             TensorProps_t props;
@@ -463,15 +482,15 @@ protected:
             TensorDescriptor_t tensorDesc;
             ret = bufMgr.Allocate( props, tensorDesc );
             ASSERT_EQ( QC_STATUS_OK, ret );
-            outputs.push_back( tensorDesc );
+            frameOutputs.push_back( tensorDesc );
             if ( globalBufferIds.size() > 0 )
             {
                 uint32_t globalIdxCfg = globalBufferIds[globalIdx];
-                ret = pFrameDesc->SetBuffer( globalIdxCfg, outputs.back() );
+                ret = pDesc->SetBuffer( globalIdxCfg, frameOutputs.back() );
             }
             else
             {
-                ret = pFrameDesc->SetBuffer( globalIdx, outputs.back() );
+                ret = pDesc->SetBuffer( globalIdx, frameOutputs.back() );
             }
             ASSERT_EQ( QC_STATUS_OK, ret );
             globalIdx++;
@@ -648,6 +667,121 @@ TEST_F( QnnTest, Perf )
     Deinit();
 }
 
+TEST_F( QnnTest, Graphs )
+{
+    std::vector<std::string> invalidGraphs = { "not_exist" };
+    SetupConfig( "GRAPHS", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<std::string>( "static.graphs", invalidGraphs );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+
+    Init( "GRAPHS", "binary", "data/centernet/program.bin", "htp0" );
+    AllocateBuffers();
+
+    QCNodeConfigIfs &cfgIfs = qnn.GetConfigurationIfs();
+    DataTree optionsDt;
+    ret = optionsDt.Load( cfgIfs.GetOptions(), errors );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    std::vector<std::string> graphNames =
+            optionsDt.Get<std::string>( "model.graphs", std::vector<std::string>{} );
+    ASSERT_LE( 1, graphNames.size() );
+
+    DataTree dtg;
+    dtg.Set<std::string>( "dynamic.activeGraphs", invalidGraphs );
+    ret = cfgIfs.VerifyAndSet( dtg.Dump(), errors );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+
+    std::vector<std::string> firstGraph = { graphNames[0] };
+    dtg.Set<std::string>( "dynamic.activeGraphs", firstGraph );
+    ret = cfgIfs.VerifyAndSet( dtg.Dump(), errors );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    Start();
+    Execute();
+    Stop();
+    Deinit();
+
+    /* the first graph configured explicitly behaves as the default */
+    SetupConfig( "GRAPHS", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<std::string>( "static.graphs", firstGraph );
+    dt.Set<bool>( "static.parallelGraphs", true );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Start();
+    Execute();
+    Stop();
+    Deinit();
+}
+
+TEST_F( QnnTest, StrictValidation )
+{
+    Init( "BINDING", "binary", "data/centernet/program.bin", "htp0" );
+    AllocateBuffers();
+    Start();
+    for ( int i = 0; i < 3; i++ )
+    {
+        Execute();
+    }
+
+    /* a buffer not seen before is always validated */
+    TensorDescriptor_t tsDesc = inputs[0];
+    tsDesc.tensorType = QC_TENSOR_TYPE_INT_8;
+    ret = pFrameDesc->SetBuffer( 0, tsDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+    ret = pFrameDesc->SetBuffer( 0, inputs[0] );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Execute();
+    Stop();
+    Deinit();
+
+    /* in strict mode, a known buffer changed in place is validated again */
+    SetupConfig( "BINDING", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<bool>( "static.strictValidation", true );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Start();
+    Execute();
+    Execute();
+    QCTensorType_e tensorType = inputs[0].tensorType;
+    inputs[0].tensorType = QC_TENSOR_TYPE_INT_8;
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+    inputs[0].tensorType = tensorType;
+    Execute();
+    Stop();
+    Deinit();
+}
+
+TEST_F( QnnTest, OutputQuantParams )
+{
+    Init( "QUANT", "binary", "data/centernet/program.bin", "htp0" );
+    AllocateBuffers();
+    Start();
+    Execute();
+
+    /* the quantization of each output is published along with the output tensor */
+    DataTree optionsDt;
+    std::vector<DataTree> outputDts;
+    ret = optionsDt.Load( qnn.GetConfigurationIfs().GetOptions(), errors );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = optionsDt.Get( "model.outputs", outputDts );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ASSERT_EQ( outputDts.size(), outputs.size() );
+    for ( size_t i = 0; i < outputs.size(); i++ )
+    {
+        EXPECT_EQ( outputDts[i].Get<float>( "quantScale", 0.0f ), outputs[i].quantScale );
+        EXPECT_EQ( outputDts[i].Get<int32_t>( "quantOffset", 0 ), outputs[i].quantOffset );
+    }
+
+    Stop();
+    Deinit();
+}
+
 TEST_F( QnnTest, RegisterBuffer )
 {
     Init( "MODEL_FROM_BUF", "binary", "data/centernet/program.bin", "htp0" );
@@ -729,6 +863,109 @@ TEST_F( QnnTest, RegisterBuffer )
     ASSERT_EQ( QC_STATUS_OK, ret );
 }
 
+TEST_F( QnnTest, BulkRegisterBuffers )
+{
+    std::vector<std::reference_wrapper<QCBufferDescriptorBase_t>> buffers;
+    ret = qnn.RegisterBuffers( buffers );
+    ASSERT_EQ( QC_STATUS_BAD_STATE, ret );
+
+    /* the pool buffers registered in the background before the first frame */
+    Init( "QNN", "binary", "data/centernet/program.bin", "htp0" );
+    AllocateBuffers();
+    for ( auto &bufDesc : inputs )
+    {
+        buffers.push_back( bufDesc );
+    }
+    for ( auto &bufDesc : outputs )
+    {
+        buffers.push_back( bufDesc );
+    }
+    ret = qnn.RegisterBuffers( buffers );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = qnn.WaitBuffersRegistered( 5000 );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Start();
+    Execute();
+    ret = qnn.RegisterBuffers( buffers, false );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Stop();
+    Deinit();
+
+    /* the buffers of bufferIds registered by Start, and kept warm across Stop and Start */
+    std::vector<uint32_t> bufferIds;
+    for ( uint32_t i = 0; i < buffers.size(); i++ )
+    {
+        config.buffers.push_back( buffers[i] );
+        bufferIds.push_back( i );
+    }
+    dt.Set<uint32_t>( "static.bufferIds", bufferIds );
+    dt.Set<bool>( "static.registerBuffersAtStart", true );
+    dt.Set<bool>( "static.deRegisterAllBuffersWhenStop", true );
+    dt.Set<bool>( "static.reRegisterBuffersWhenStart", true );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    for ( uint32_t i = 0; i < 3; i++ )
+    {
+        Start();
+        ret = qnn.WaitBuffersRegistered( 5000 );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        Execute();
+        Stop();
+    }
+
+    /* Stop while the buffers are being registered */
+    Start();
+    Stop();
+    Deinit();
+}
+
+TEST_F( QnnTest, WarmupBaseline )
+{
+    DataTree optionsDt;
+    std::vector<DataTree> baselineDts;
+    std::string errors;
+
+    /* no baseline without the warm-up */
+    Init( "QNN", "binary", "data/centernet/program.bin", "htp0" );
+    AllocateBuffers();
+    Start();
+    ASSERT_EQ( "{}", qnn.GetMonitoringIfs().GetOptions() );
+    Stop();
+    Deinit();
+
+    SetupConfig( "QNN", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<uint32_t>( "static.warmupFrames", 5 );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    AllocateBuffers();
+    for ( uint32_t i = 0; i < 2; i++ )
+    {
+        /* calibrated again by each Start, on the scratch tensors of the first one */
+        Start();
+        ret = optionsDt.Load( qnn.GetMonitoringIfs().GetOptions(), errors );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = optionsDt.Get( "baselines", baselineDts );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ASSERT_EQ( 1u, baselineDts.size() );
+        EXPECT_EQ( 5u, baselineDts[0].Get<uint32_t>( "frames", 0 ) );
+        EXPECT_LT( 0u, baselineDts[0].Get<uint64_t>( "wallTime", 0 ) );
+        EXPECT_LT( 0u, baselineDts[0].Get<uint64_t>( "entireExecTime", 0 ) );
+        EXPECT_LE( baselineDts[0].Get<uint64_t>( "rpcExecTimeHTP", 0 ),
+                   baselineDts[0].Get<uint64_t>( "entireExecTime", 0 ) );
+
+        /* the perf of the frames stays disabled */
+        Qnn_Perf_t perf;
+        uint32_t size = sizeof( perf );
+        ret = qnn.GetMonitoringIfs().Place( &perf, size );
+        EXPECT_EQ( QC_STATUS_OUT_OF_BOUND, ret );
+        Execute();
+        Stop();
+    }
+    Deinit();
+}
+
 TEST( QNN, LoadModel )
 {
     QCStatus_e ret = QC_STATUS_OK;
@@ -2300,6 +2537,73 @@ TEST_F( QnnTest, QnnConfig )
         }
     }
 
+    SetupConfig( "QCFG", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<uint32_t>( "static.targetLatency", 10000 );
+    dt.Set<std::string>( "static.minPerfProfile", "default" );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors, "the minPerfProfile is invalid, " );
+
+    dt.Set<std::string>( "static.minPerfProfile", "burst" );
+    dt.Set<std::string>( "static.maxPerfProfile", "balanced" );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors, "the minPerfProfile is higher than the maxPerfProfile, " );
+
+    dt.Set<std::string>( "static.minPerfProfile", "low_power_saver" );
+    dt.Set<uint32_t>( "static.governorWindow", 0 );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors, "the governorWindow is invalid, " );
+
+    dt.Set<uint32_t>( "static.governorWindow", 8 );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_OK );
+
+    dt.Set<uint32_t>( "static.warmupFrames", 101 );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors, "the warmupFrames is invalid, " );
+
+    dt.Set<uint32_t>( "static.warmupFrames", 10 );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_OK );
+
+    dt.Set<bool>( "static.reRegisterBuffersWhenStart", true );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors,
+               "the reRegisterBuffersWhenStart requires the deRegisterAllBuffersWhenStop, " );
+
+    dt.Set<bool>( "static.deRegisterAllBuffersWhenStop", true );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_OK );
+
+    std::vector<DataTree> batchSlices( 1 );
+    std::vector<uint32_t> sliceIds;
+    batchSlices[0].Set<std::string>( "name", "input" );
+    batchSlices[0].Set( "ids", sliceIds );
+    dt.Set( "static.batchSlices", batchSlices );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+    ASSERT_EQ( errors, "the batchSlices 0 ids is empty, " );
+
+    sliceIds.push_back( 5 );
+    batchSlices[0].Set( "ids", sliceIds );
+    dt.Set( "static.batchSlices", batchSlices );
+    config.config = dt.Dump();
+    ret = cfgIfs.VerifyAndSet( config.config, errors );
+    ASSERT_EQ( ret, QC_STATUS_OK );
+
     SetupConfig( "QCFG", "binary", "invalid.bin", "htp0" );
     ret = cfgIfs.VerifyAndSet( config.config, errors );
     ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
@@ -2402,6 +2706,23 @@ TEST_F( QnnTest, QnnConfig )
         ASSERT_EQ( QC_STATUS_UNSUPPORTED, ret );
     }
 
+    {
+        /* an invalid config leaves the last valid config unchanged */
+        SetupConfig( "QCFG", "binary", "data/centernet/program.bin", "htp1", "QNN", 3 );
+        ret = cfgIfs.VerifyAndSet( config.config, errors );
+        ASSERT_EQ( ret, QC_STATUS_OK );
+        SetupConfig( "QCFG2", "binary", "invalid.bin", "cpu", "QNN", 4 );
+        errors = "";
+        ret = cfgIfs.VerifyAndSet( config.config, errors );
+        ASSERT_EQ( ret, QC_STATUS_BAD_ARGUMENTS );
+        ASSERT_EQ( errors, "the modelPath <invalid.bin> is invalid, " );
+        const QnnImplConfig_t &qnnConfig = static_cast<const QnnImplConfig_t &>( cfgIfs.Get() );
+        ASSERT_EQ( "QCFG", qnnConfig.nodeId.name );
+        ASSERT_EQ( 3, qnnConfig.nodeId.id );
+        ASSERT_EQ( QNN_PROCESSOR_HTP1, qnnConfig.processorType );
+        ASSERT_EQ( "data/centernet/program.bin", qnnConfig.modelPath );
+    }
+
     {
         Init( "SANITY", "binary", "data/centernet/program.bin", "htp0" );
         std::string options = cfgIfs.GetOptions();
@@ -2505,6 +2826,91 @@ TEST_F( QnnTest, GlobalBufferIdMap )
     ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
 }
 
+TEST_F( QnnTest, BatchSlices )
+{
+    /* the input is bound from the slice 1 of a 2 batch buffer, at the global buffer 5 */
+    std::vector<DataTree> batchSlices( 1 );
+    std::vector<uint32_t> sliceIds( { 5 } );
+    batchSlices[0].Set<std::string>( "name", "input" );
+    batchSlices[0].Set( "ids", sliceIds );
+    SetupConfig( "QNN", "buffer", "data/centernet/program.bin", "htp0" );
+    dt.Set( "static.batchSlices", batchSlices );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    bufferDescNum = 6;
+    AllocateBuffers();
+    Start();
+
+    TensorDescriptor_t batched;
+    TensorDescriptor_t slice;
+    TensorProps_t props( inputs[0].tensorType,
+                         std::vector<uint32_t>( inputs[0].dims,
+                                                inputs[0].dims + inputs[0].numDims ) );
+    props.dims[0] = 2;
+    ret = bufMgr.Allocate( props, batched );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = batched.GetTensorDesc( slice, 1 );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ASSERT_EQ( batched.validSize / 2, slice.offset );
+
+    size_t inputSize = 0;
+    void *pInputData = LoadRaw( "data/test/qnn/centernet/gd_uint8_input.raw", inputSize );
+    ASSERT_EQ( slice.GetDataSize(), inputSize );
+    memset( batched.GetDataPtr(), 0, slice.GetDataSize() );
+    memcpy( slice.GetDataPtr(), pInputData, inputSize );
+    free( pInputData );
+    ret = pFrameDesc->SetBuffer( 5, slice );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    Execute();
+
+    std::vector<std::string> outputDataPaths;
+    outputDataPaths.push_back( "data/test/qnn/centernet/gd_uint8_output_0.raw" );
+    outputDataPaths.push_back( "data/test/qnn/centernet/gd_uint8_output_1.raw" );
+    outputDataPaths.push_back( "data/test/qnn/centernet/gd_uint8_output_2.raw" );
+    ASSERT_EQ( outputDataPaths.size(), outputs.size() );
+    for ( size_t i = 0; i < outputs.size(); ++i )
+    {
+        size_t outputSize = 0;
+        void *pOutputData = LoadRaw( outputDataPaths[i], outputSize );
+        ASSERT_EQ( outputs[i].size, outputSize );
+        double cosSim = CosineSimilarity( (uint8_t *) pOutputData, (uint8_t *) outputs[i].pBuf,
+                                          outputSize );
+        ASSERT_GT( cosSim, 0.99d );
+        free( pOutputData );
+    }
+
+    /* a slice of the wrong batch size */
+    ret = pFrameDesc->SetBuffer( 5, batched );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+
+    Stop();
+    Deinit();
+    ret = bufMgr.Free( batched );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    /* more slices than the batch of the model tensor */
+    sliceIds = std::vector<uint32_t>( { 5, 6 } );
+    batchSlices[0].Set( "ids", sliceIds );
+    SetupConfig( "QNN", "buffer", "data/centernet/program.bin", "htp0" );
+    dt.Set( "static.batchSlices", batchSlices );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+
+    /* slices of an unknown tensor */
+    sliceIds = std::vector<uint32_t>( { 5 } );
+    batchSlices[0].Set( "ids", sliceIds );
+    batchSlices[0].Set<std::string>( "name", "inputxxx" );
+    SetupConfig( "QNN", "buffer", "data/centernet/program.bin", "htp0" );
+    dt.Set( "static.batchSlices", batchSlices );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+}
+
 void QnnLog_CallbackTest( QnnLog_Level_t logLevel, uint64_t timestamp, const char *fmt, ... )
 {
     va_list args;
@@ -2551,6 +2957,57 @@ TEST( QNN, memscpy )
     ASSERT_EQ( copied, 0 );
 }
 
+TEST( QNN, MapBinaryFile )
+{
+    QCStatus_e status;
+    QCNodeID_t nodeId;
+    Logger logger;
+    logger.Init( "UNIT_TEST" );
+    QnnImplTest qnn0( nodeId, logger );
+    QnnImplTest qnn1( nodeId, logger );
+    void *pData0 = nullptr;
+    void *pData1 = nullptr;
+    size_t size0 = 0;
+    size_t size1 = 0;
+    const char *pPath = "/tmp/gtest_qnn_map_binary.bin";
+    const char content[] = "QNN CONTEXT BINARY";
+
+    FILE *pFile = fopen( pPath, "wb" );
+    ASSERT_NE( nullptr, pFile );
+    ASSERT_EQ( sizeof( content ), fwrite( content, 1, sizeof( content ), pFile ) );
+    fclose( pFile );
+
+    size_t numMapped = QnnImplTest::GetNumMappedBinaries();
+
+    status = qnn0.MapBinaryFile( pPath, pData0, size0 );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( sizeof( content ), size0 );
+    ASSERT_EQ( 0, memcmp( content, pData0, sizeof( content ) ) );
+
+    /* the second instance shares the mapping of the first one */
+    status = qnn1.MapBinaryFile( pPath, pData1, size1 );
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( pData0, pData1 );
+    ASSERT_EQ( size0, size1 );
+    ASSERT_EQ( numMapped + 1, QnnImplTest::GetNumMappedBinaries() );
+
+    qnn0.UnmapBinaryFile( pData0 );
+    ASSERT_EQ( numMapped + 1, QnnImplTest::GetNumMappedBinaries() );
+    ASSERT_EQ( 0, memcmp( content, pData1, sizeof( content ) ) );
+    qnn1.UnmapBinaryFile( pData1 );
+    ASSERT_EQ( numMapped, QnnImplTest::GetNumMappedBinaries() );
+
+    status = qnn0.MapBinaryFile( "/tmp/gtest_qnn_not_exist.bin", pData0, size0 );
+    ASSERT_EQ( QC_STATUS_FAIL, status );
+
+    pFile = fopen( pPath, "wb" );
+    ASSERT_NE( nullptr, pFile );
+    fclose( pFile );
+    status = qnn0.MapBinaryFile( pPath, pData0, size0 );
+    ASSERT_EQ( QC_STATUS_FAIL, status );
+    (void) remove( pPath );
+}
+
 TEST( QNN, QnnImplUnitTest )
 {
     QCStatus_e status;
@@ -3176,6 +3633,91 @@ TEST( QNN, QnnImplUnitTest )
     }
 }
 
+TEST( QNN, PerfGovernor )
+{
+    QCStatus_e status;
+    QCNodeID_t nodeId;
+    Logger logger;
+    logger.Init( "GOVERNOR" );
+    std::vector<std::reference_wrapper<QCBufferDescriptorBase>> buffers;
+
+    /* a node with a fixed profile and a governed node on the same core */
+    QnnImplTest fixed( nodeId, logger );
+    QnnImplConfig_t &fixedCfg = fixed.GetConfig();
+    fixedCfg.loadType = QNN_LOAD_CONTEXT_BIN_FROM_FILE;
+    fixedCfg.modelPath = "data/centernet/program.bin";
+    fixedCfg.processorType = QNN_PROCESSOR_HTP0;
+    fixedCfg.coreIds = { 0 };
+    fixedCfg.priority = QNN_PRIORITY_NORMAL;
+    fixedCfg.perfProfile = QNN_PERF_PROFILE_BALANCED;
+    status = fixed.Initialize( nullptr, buffers );
+    ASSERT_EQ( QC_STATUS_OK, status );
+
+    QnnImplTest governed( nodeId, logger );
+    QnnImplConfig_t &cfg = governed.GetConfig();
+    cfg = fixedCfg;
+    cfg.perfProfile = QNN_PERF_PROFILE_DEFAULT;
+    cfg.targetLatency = 10000;
+    cfg.minPerfProfile = QNN_PERF_PROFILE_POWER_SAVER;
+    cfg.maxPerfProfile = QNN_PERF_PROFILE_BURST;
+    cfg.governorWindow = 4;
+    status = governed.Initialize( nullptr, buffers );
+    ASSERT_EQ( QC_STATUS_OK, status );
+
+    /* the governor starts from the highest profile, which the core runs at */
+    ASSERT_EQ( QNN_PERF_PROFILE_BURST, governed.GetGovernorProfile() );
+    ASSERT_EQ( QNN_PERF_PROFILE_BURST, fixed.GetAppliedProfiles()[0] );
+
+    /* in time frames step the profile down once per window, but not under the fixed node */
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        governed.GovernPerf( 1000 );
+    }
+    ASSERT_EQ( QNN_PERF_PROFILE_HIGH_PERFORMANCE, governed.GetGovernorProfile() );
+    for ( uint32_t i = 0; i < 4 * 8; i++ )
+    {
+        governed.GovernPerf( 1000 );
+    }
+    ASSERT_EQ( QNN_PERF_PROFILE_POWER_SAVER, governed.GetGovernorProfile() );
+    ASSERT_EQ( QNN_PERF_PROFILE_BALANCED, governed.GetAppliedProfiles()[0] );
+    ASSERT_EQ( QNN_PERF_PROFILE_BALANCED, fixed.GetAppliedProfiles()[0] );
+
+    /* a latency within the hysteresis band keeps the profile */
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        governed.GovernPerf( 9000 );
+    }
+    ASSERT_EQ( QNN_PERF_PROFILE_POWER_SAVER, governed.GetGovernorProfile() );
+
+    /* late frames step the profile up */
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        governed.GovernPerf( 20000 );
+    }
+    ASSERT_EQ( QNN_PERF_PROFILE_HIGH_POWER_SAVER, governed.GetGovernorProfile() );
+
+    /* the core follows the governed node once the fixed node is gone */
+    status = fixed.DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( QNN_PERF_PROFILE_HIGH_POWER_SAVER, governed.GetAppliedProfiles()[0] );
+
+    /* a stopped node votes for the lowest profile, and is governed again from the initial one */
+    status = governed.Start();
+    ASSERT_EQ( QC_STATUS_OK, status );
+    status = governed.Stop();
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( QNN_PERF_PROFILE_BURST, governed.GetGovernorProfile() );
+    ASSERT_EQ( QNN_PERF_PROFILE_POWER_SAVER, governed.GetAppliedProfiles()[0] );
+    status = governed.Start();
+    ASSERT_EQ( QC_STATUS_OK, status );
+    ASSERT_EQ( QNN_PERF_PROFILE_BURST, governed.GetAppliedProfiles()[0] );
+    status = governed.Stop();
+    ASSERT_EQ( QC_STATUS_OK, status );
+
+    status = governed.DeInitialize();
+    ASSERT_EQ( QC_STATUS_OK, status );
+}
+
 TEST_F( QnnTest, GetQnnFunctionPointersDllOpenFailed )
 {
     // NOTE: do move libQnnHtp.so as libQnnHtp.so.bak and then recover it
@@ -3421,6 +3963,162 @@ TEST_F( QnnTest, MockQnnInterface )
     }
 }
 
+TEST_F( QnnTest, MockPipelinedAsync )
+{
+    MockApi_ControlFnc_t MockApi_ControlFnc = MockQnn_GetControlFnc( "libQnnHtp.so" );
+    ASSERT_NE( MockApi_ControlFnc, nullptr );
+
+    const uint32_t numFrames = 64;
+    const uint32_t maxDepth = 4;
+    uint32_t deviceUs = 2000; /* the mock device time per frame */
+    uint32_t hostUs = 2000;   /* the host time to prepare a frame */
+    uint32_t depths[2] = { 1, maxDepth };
+    uint64_t elapsedUs[2] = { 0, 0 };
+    std::mutex mtx;
+    std::condition_variable condVar;
+    uint32_t numDone = 0;
+    uint32_t numWrong = 0;
+
+    /* each frame in flight has its own frame descriptor and tensors, the first one of the fixture
+     * and the others allocated once the model is loaded */
+    NodeFrameDescriptor *slotDescs[maxDepth] = { nullptr };
+    std::vector<TensorDescriptor_t> slotInputs[maxDepth];
+    std::vector<TensorDescriptor_t> slotOutputs[maxDepth];
+    bool slotBusy[maxDepth] = { false };
+
+    MockApi_ControlFnc( MOCK_API_QNN_GRAPH_EXECUTE_ASYNC, MOCK_CONTROL_API_DELAYED_NOTIFY,
+                        &deviceUs );
+    for ( uint32_t d = 0; d < 2; d++ )
+    {
+        SetupConfig( "PIPELINE", "binary", "data/centernet/program.bin", "htp0" );
+        dt.Set<uint32_t>( "static.inFlightDepth", depths[d] );
+        config.config = dt.Dump();
+        config.callback = [&]( const QCNodeEventInfo_t &info ) {
+            std::lock_guard<std::mutex> l( mtx );
+            uint32_t slot = 0;
+            while ( ( slot < maxDepth ) && ( &info.frameDesc != slotDescs[slot] ) )
+            {
+                slot++;
+            }
+
+            /* the completion is of a frame in flight and reports the outputs of that frame */
+            bool bOwn = ( QC_STATUS_OK == info.status ) && ( slot < maxDepth ) && slotBusy[slot];
+            for ( size_t i = 0; bOwn && ( i < slotOutputs[slot].size() ); i++ )
+            {
+                uint32_t globalIdx = static_cast<uint32_t>( slotInputs[slot].size() + i );
+                bOwn = ( slotOutputs[slot][i].pBuf == info.frameDesc.GetBuffer( globalIdx ).pBuf );
+            }
+            if ( bOwn )
+            {
+                slotBusy[slot] = false;
+                numDone++;
+            }
+            else
+            {
+                numWrong++;
+            }
+            condVar.notify_one();
+        };
+        ret = qnn.Initialize( config );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        if ( nullptr == pFrameDesc )
+        {
+            AllocateBuffers();
+            slotDescs[0] = pFrameDesc;
+            slotInputs[0] = inputs;
+            slotOutputs[0] = outputs;
+            for ( uint32_t slot = 1; slot < maxDepth; slot++ )
+            {
+                AllocateFrame( slotDescs[slot], slotInputs[slot], slotOutputs[slot] );
+            }
+        }
+        Start();
+
+        numDone = 0;
+        auto begin = std::chrono::steady_clock::now();
+        for ( uint32_t i = 0; i < numFrames; i++ )
+        {
+            uint32_t slot = i % depths[d];
+            std::this_thread::sleep_for( std::chrono::microseconds( hostUs ) );
+            {
+                std::unique_lock<std::mutex> lock( mtx );
+                condVar.wait( lock, [&]() { return false == slotBusy[slot]; } );
+                slotBusy[slot] = true;
+            }
+            ret = qnn.ProcessFrameDescriptor( *slotDescs[slot] );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+        {
+            std::unique_lock<std::mutex> lock( mtx );
+            bool bDone = condVar.wait_for( lock, std::chrono::milliseconds( 1000 ),
+                                           [&]() { return numFrames == numDone; } );
+            ASSERT_TRUE( bDone );
+            ASSERT_EQ( 0u, numWrong );
+        }
+        auto end = std::chrono::steady_clock::now();
+        elapsedUs[d] = std::chrono::duration_cast<std::chrono::microseconds>( end - begin ).count();
+        /* informational, the overlap of the host preparation and the device execution depends on
+         * the load of the machine */
+        printf( "inFlightDepth=%u: %u frames in %" PRIu64 " us, %.1f fps\n", depths[d],
+                numFrames, elapsedUs[d], numFrames * 1000000.0 / elapsedUs[d] );
+
+        Stop();
+        Deinit();
+    }
+    MockApi_ControlFnc( MOCK_API_QNN_GRAPH_EXECUTE_ASYNC, MOCK_CONTROL_API_NONE, nullptr );
+
+    for ( uint32_t slot = 1; slot < maxDepth; slot++ )
+    {
+        for ( TensorDescriptor_t &tensor : slotInputs[slot] )
+        {
+            ret = bufMgr.Free( tensor );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+        for ( TensorDescriptor_t &tensor : slotOutputs[slot] )
+        {
+            ret = bufMgr.Free( tensor );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+        delete slotDescs[slot];
+    }
+
+    /* the depth is limited by the notify parameters */
+    SetupConfig( "PIPELINE", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<uint32_t>( "static.inFlightDepth", QNN_NOTIFY_PARAM_NUM + 1 );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+}
+
+TEST_F( QnnTest, MockWarmupFailure )
+{
+    MockApi_ControlFnc_t MockApi_ControlFnc = MockQnn_GetControlFnc( "libQnnHtp.so" );
+    ASSERT_NE( MockApi_ControlFnc, nullptr );
+    Qnn_ErrorHandle_t qnnErrHandle = QNN_MIN_ERROR_COMMON;
+
+    SetupConfig( "WARMUP", "binary", "data/centernet/program.bin", "htp0" );
+    dt.Set<uint32_t>( "static.warmupFrames", 5 );
+    config.config = dt.Dump();
+    ret = qnn.Initialize( config );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    AllocateBuffers();
+
+    /* a scratch tensor of the warm-up fails to register, the node is not started */
+    MockApi_ControlFnc( MOCK_API_QNN_MEMORY_REGISTER, MOCK_CONTROL_API_RETURN, &qnnErrHandle );
+    ret = qnn.Start();
+    ASSERT_EQ( QC_STATUS_FAIL, ret );
+    ASSERT_EQ( QC_OBJECT_STATE_READY, qnn.GetState() );
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_BAD_STATE, ret );
+
+    /* and starts again once the warm-up succeeds */
+    Start();
+    ASSERT_EQ( QC_OBJECT_STATE_RUNNING, qnn.GetState() );
+    Execute();
+    Stop();
+    Deinit();
+}
+
 TEST_F( QnnTest, MockQnnSystemInterface )
 {
     MockQnnSystemApi_ControlFnc_t MockQnnSystemApi_ControlFnc =
@@ -3512,7 +4210,7 @@ TEST_F( QnnTest, MockQnnAddModel )
     Initialize( "MOCK-ADDMODEL", "library", "lib/libQnnAddModelMock.so", "cpu" );
     ASSERT_EQ( ret, QC_STATUS_FAIL );
 
-    uint32_t numGraphsInfo = 3;
+    uint32_t numGraphsInfo = 0;
     MockAddModelApi_Control( MOCK_ADD_MODEL_API_COMPOSE_GRAPH,
                              MOCK_ADD_MODEL_CONTROL_API_OUT_PARAM1, &numGraphsInfo );
     Initialize( "MOCK-ADDMODEL", "library", "lib/libQnnAddModelMock.so", "cpu" );
@@ -3529,6 +4227,149 @@ TEST_F( QnnTest, MockQnnAddModel )
     ASSERT_EQ( ret, QC_STATUS_FAIL );
 }
 
+TEST_F( QnnTest, MockQnnMultiGraph )
+{
+    /* the mock model composes 3 graphs, all the tensors are float [1, 128, 3, 128]:
+     * add_model: output = input1 + input2
+     * double_model: output2 = output + output, chained to the output of add_model
+     * add_model_3: output3 = input1 + input2, independent of the others */
+    std::vector<std::string> graphs = { "add_model", "double_model", "add_model_3" };
+    std::vector<std::string> withoutProducer = { "double_model", "add_model_3" };
+    std::vector<std::string> withoutConsumer = { "add_model", "add_model_3" };
+    std::vector<std::string> allGraphs;
+    const std::vector<std::string> outputNames = { "output", "output2", "output3" };
+    const float outputScales[3] = { 1.0f, 2.0f, 1.0f };
+    const size_t numElements = 1 * 128 * 3 * 128;
+    std::mutex mtx;
+    std::condition_variable condVar;
+    uint32_t numDone = 0;
+
+    MockApi_ControlFnc_t MockApi_ControlFnc = MockQnn_GetControlFnc( "libQnnCpu.so" );
+    ASSERT_NE( MockApi_ControlFnc, nullptr );
+
+    /* runs one frame and checks the outputs of the active graphs, the outputs of the inactive
+     * graphs are left untouched */
+    auto RunFrame = [&]( float base, uint64_t activeMask, bool bAsync ) {
+        float *pInput1 = static_cast<float *>( inputs[0].pBuf );
+        float *pInput2 = static_cast<float *>( inputs[1].pBuf );
+        for ( size_t i = 0; i < numElements; i++ )
+        {
+            pInput1[i] = base + static_cast<float>( i % 17 );
+            pInput2[i] = 0.5f * static_cast<float>( i % 5 );
+        }
+        for ( size_t k = 0; k < outputs.size(); k++ )
+        {
+            std::fill_n( static_cast<float *>( outputs[k].pBuf ), numElements, -1.0f );
+        }
+
+        numDone = 0;
+        Execute();
+        if ( bAsync )
+        {
+            std::unique_lock<std::mutex> lock( mtx );
+            bool bDone = condVar.wait_for( lock, std::chrono::milliseconds( 1000 ),
+                                           [&]() { return 1 == numDone; } );
+            ASSERT_TRUE( bDone );
+        }
+
+        for ( size_t k = 0; k < outputs.size(); k++ )
+        {
+            const float *pOutput = static_cast<const float *>( outputs[k].pBuf );
+            bool bActive = ( 0 != ( activeMask & ( 1ull << k ) ) );
+            for ( size_t i = 0; i < numElements; i++ )
+            {
+                float expected = bActive ? outputScales[k] * ( pInput1[i] + pInput2[i] ) : -1.0f;
+                ASSERT_FLOAT_EQ( expected, pOutput[i] ) << outputNames[k] << "[" << i << "]";
+            }
+        }
+    };
+
+    /* each graph is submitted on its own in stage order, or the independent add_model and
+     * add_model_3 are submitted together in stage 0 and double_model in stage 1 */
+    const bool modes[3][2] = { { false, false }, { true, false }, { true, true } };
+    for ( auto &mode : modes )
+    {
+        bool bAsync = mode[0];
+        bool bParallel = mode[1];
+        SetupConfig( "MOCK-MULTIGRAPH", "library", "lib/libQnnAddModelMock.so", "cpu" );
+        dt.Set<std::string>( "static.graphs", graphs );
+        dt.Set<bool>( "static.parallelGraphs", bParallel );
+        config.config = dt.Dump();
+        if ( bAsync )
+        {
+            config.callback = [&]( const QCNodeEventInfo_t &info ) {
+                std::lock_guard<std::mutex> l( mtx );
+                if ( QC_STATUS_OK == info.status )
+                {
+                    numDone++;
+                }
+                condVar.notify_one();
+            };
+        }
+        ret = qnn.Initialize( config );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        QCNodeConfigIfs &cfgIfs = qnn.GetConfigurationIfs();
+        DataTree optionsDt;
+        ret = optionsDt.Load( cfgIfs.GetOptions(), errors );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ASSERT_EQ( graphs, optionsDt.Get<std::string>( "model.graphs",
+                                                        std::vector<std::string>{} ) );
+        /* the chained input is not a node input, the intermediate output is a node output */
+        std::vector<DataTree> inputDts;
+        std::vector<DataTree> outputDts;
+        ASSERT_EQ( QC_STATUS_OK, optionsDt.Get( "model.inputs", inputDts ) );
+        ASSERT_EQ( QC_STATUS_OK, optionsDt.Get( "model.outputs", outputDts ) );
+        ASSERT_EQ( 2, inputDts.size() );
+        ASSERT_EQ( "input1", inputDts[0].Get<std::string>( "name", "" ) );
+        ASSERT_EQ( "input2", inputDts[1].Get<std::string>( "name", "" ) );
+        ASSERT_EQ( outputNames.size(), outputDts.size() );
+        for ( size_t k = 0; k < outputNames.size(); k++ )
+        {
+            ASSERT_EQ( outputNames[k], outputDts[k].Get<std::string>( "name", "" ) );
+        }
+
+        if ( nullptr == pFrameDesc )
+        {
+            AllocateBuffers();
+        }
+        Start();
+
+        /* a stale intermediate tensor would give the output2 of the previous frame */
+        RunFrame( 1.0f, 0x7, bAsync );
+        RunFrame( 100.0f, 0x7, bAsync );
+
+        /* a consumer graph can not be active without its producer graph */
+        DataTree dtg;
+        dtg.Set<std::string>( "dynamic.activeGraphs", withoutProducer );
+        ret = cfgIfs.VerifyAndSet( dtg.Dump(), errors );
+        ASSERT_EQ( QC_STATUS_BAD_ARGUMENTS, ret );
+        RunFrame( 2.0f, 0x7, bAsync );
+
+        /* both dynamic keys of one config are applied */
+        dtg = DataTree();
+        dtg.Set<std::string>( "dynamic.activeGraphs", withoutConsumer );
+        dtg.Set<bool>( "dynamic.enablePerf", true );
+        ret = cfgIfs.VerifyAndSet( dtg.Dump(), errors );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        RunFrame( 3.0f, 0x5, bAsync );
+        Qnn_Perf_t perf = { 0, 0, 0, 0 };
+        uint32_t size = sizeof( perf );
+        ret = qnn.GetMonitoringIfs().Place( &perf, size );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        dtg = DataTree();
+        dtg.Set<std::string>( "dynamic.activeGraphs", allGraphs );
+        dtg.Set<bool>( "dynamic.enablePerf", false );
+        ret = cfgIfs.VerifyAndSet( dtg.Dump(), errors );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        RunFrame( 4.0f, 0x7, bAsync );
+
+        Stop();
+        Deinit();
+    }
+}
+
 #ifndef GTEST_QCNODE
 #if __CTC__
 extern "C" void ctc_append_all( void );
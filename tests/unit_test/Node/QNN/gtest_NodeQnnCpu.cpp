@@ -0,0 +1,235 @@
+// Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+// SPDX-License-Identifier: BSD-3-Clause-Clear
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "QC/Node/QNN.hpp"
+#include "QC/sample/BufferManager.hpp"
+#include "gtest/gtest.h"
+
+using namespace QC;
+using namespace QC::Node;
+using namespace QC::sample;
+
+/* The QNN CPU backend runs on any host, so these tests track the node overhead and the model
+ * accuracy without a target board. The model library is compiled for the host by the QNN
+ * converter, its path can be set by the environment variable QNN_CPU_MODEL_PATH. */
+static std::string GetCpuModelPath()
+{
+    const char *pPath = getenv( "QNN_CPU_MODEL_PATH" );
+    std::string modelPath;
+    if ( nullptr != pPath )
+    {
+        modelPath = pPath;
+    }
+    else
+    {
+#if defined( __x86_64__ )
+        modelPath = "data/centernet/x86_64-linux-clang/libqride_centernet.so";
+#elif defined( __QNXNTO__ )
+        modelPath = "data/centernet/aarch64-qnx/libqride_centernet.so";
+#else
+        modelPath = "data/centernet/aarch64-oe-linux-gcc9.3/libqride_centernet.so";
+#endif
+    }
+    return modelPath;
+}
+
+class QnnCpuTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        modelPath = GetCpuModelPath();
+        if ( 0 != access( modelPath.c_str(), R_OK ) )
+        {
+            GTEST_SKIP() << "no QNN CPU model " << modelPath;
+        }
+
+        DataTree dt;
+        dt.Set<std::string>( "static.name", "QNN_CPU" );
+        dt.Set<uint32_t>( "static.id", 0 );
+        dt.Set<std::string>( "static.loadType", "library" );
+        dt.Set<std::string>( "static.modelPath", modelPath );
+        dt.Set<std::string>( "static.processorType", "cpu" );
+        QCNodeInit_t config = { dt.Dump() };
+        ret = qnn.Initialize( config );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        DataTree optionsDt;
+        std::vector<DataTree> inputDts;
+        std::vector<DataTree> outputDts;
+        ret = optionsDt.Load( qnn.GetConfigurationIfs().GetOptions(), errors );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = optionsDt.Get( "model.inputs", inputDts );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        ret = optionsDt.Get( "model.outputs", outputDts );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+
+        /* plain heap buffers, the CPU backend binds them as raw client buffers */
+        pFrameDesc = new NodeFrameDescriptor( inputDts.size() + outputDts.size() + 1 );
+        inputs.resize( inputDts.size() );
+        outputs.resize( outputDts.size() );
+        uint32_t globalIdx = 0;
+        for ( size_t i = 0; i < inputDts.size(); i++ )
+        {
+            AllocateTensor( inputDts[i], inputs[i] );
+            uint8_t *pData = (uint8_t *) inputs[i].GetDataPtr();
+            for ( size_t j = 0; j < inputs[i].GetDataSize(); j++ )
+            {
+                pData[j] = (uint8_t) ( ( j * 7 + i ) & 0x7F );
+            }
+            ret = pFrameDesc->SetBuffer( globalIdx++, inputs[i] );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+        for ( size_t i = 0; i < outputDts.size(); i++ )
+        {
+            AllocateTensor( outputDts[i], outputs[i] );
+            ret = pFrameDesc->SetBuffer( globalIdx++, outputs[i] );
+            ASSERT_EQ( QC_STATUS_OK, ret );
+        }
+
+        ret = qnn.Start();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    void AllocateTensor( DataTree &dt, TensorDescriptor_t &tensor )
+    {
+        TensorProps_t props;
+        std::vector<uint32_t> dims = dt.Get<uint32_t>( "dims", std::vector<uint32_t>( {} ) );
+        ASSERT_LE( dims.size(), QC_NUM_TENSOR_DIMS );
+        props.numDims = dims.size();
+        std::copy( dims.begin(), dims.end(), props.dims );
+        props.tensorType = dt.GetTensorType( "type", QC_TENSOR_TYPE_MAX );
+        ASSERT_NE( QC_TENSOR_TYPE_MAX, props.tensorType );
+        props.allocatorType = QC_MEMORY_ALLOCATOR_HEAP;
+        ret = bufMgr.Allocate( props, tensor );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    void TearDown() override
+    {
+        (void) qnn.Stop();
+        (void) qnn.DeInitialize();
+        if ( nullptr != pFrameDesc )
+        {
+            delete pFrameDesc;
+            pFrameDesc = nullptr;
+        }
+        for ( TensorDescriptor_t &tensor : inputs )
+        {
+            (void) bufMgr.Free( tensor );
+        }
+        for ( TensorDescriptor_t &tensor : outputs )
+        {
+            (void) bufMgr.Free( tensor );
+        }
+    }
+
+    Qnn qnn;
+    BufferManager bufMgr = BufferManager( { "QNN_CPU", QC_NODE_TYPE_QNN, 0 } );
+    std::string modelPath;
+    std::string errors;
+    QCStatus_e ret = QC_STATUS_OK;
+    std::vector<TensorDescriptor_t> inputs;
+    std::vector<TensorDescriptor_t> outputs;
+    NodeFrameDescriptor *pFrameDesc = nullptr;
+};
+
+TEST_F( QnnCpuTest, SANITY_Execute )
+{
+    std::vector<std::vector<uint8_t>> golden( outputs.size() );
+
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    for ( size_t i = 0; i < outputs.size(); i++ )
+    {
+        uint8_t *pData = (uint8_t *) outputs[i].GetDataPtr();
+        golden[i].assign( pData, pData + outputs[i].GetDataSize() );
+        (void) memset( pData, 0, outputs[i].GetDataSize() );
+    }
+
+    /* the CPU backend is deterministic, any difference is an accuracy regression */
+    ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+    for ( size_t i = 0; i < outputs.size(); i++ )
+    {
+        EXPECT_EQ( 0, memcmp( golden[i].data(), outputs[i].GetDataPtr(), golden[i].size() ) )
+                << "output " << i << " mismatch";
+    }
+}
+
+TEST_F( QnnCpuTest, L2_Benchmark )
+{
+    const uint32_t numWarmup = 2;
+    const uint32_t numFrames = 20;
+    std::vector<uint64_t> latencies;
+
+    DataTree dtp;
+    dtp.Set<bool>( "dynamic.enablePerf", true );
+    ret = qnn.GetConfigurationIfs().VerifyAndSet( dtp.Dump(), errors );
+    ASSERT_EQ( QC_STATUS_OK, ret );
+
+    for ( uint32_t i = 0; i < numWarmup; i++ )
+    {
+        ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+        ASSERT_EQ( QC_STATUS_OK, ret );
+    }
+
+    uint64_t overheadUs = 0;
+    uint32_t numPerf = 0;
+    for ( uint32_t i = 0; i < numFrames; i++ )
+    {
+        auto begin = std::chrono::steady_clock::now();
+        ret = qnn.ProcessFrameDescriptor( *pFrameDesc );
+        auto end = std::chrono::steady_clock::now();
+        ASSERT_EQ( QC_STATUS_OK, ret );
+        uint64_t latencyUs =
+                std::chrono::duration_cast<std::chrono::microseconds>( end - begin ).count();
+        latencies.push_back( latencyUs );
+
+        /* the time spent in the node outside of the QNN graph execution */
+        Qnn_Perf_t perf = { 0, 0, 0, 0 };
+        uint32_t size = sizeof( perf );
+        if ( QC_STATUS_OK == qnn.GetMonitoringIfs().Place( &perf, size ) )
+        {
+            if ( latencyUs > perf.entireExecTime )
+            {
+                overheadUs += latencyUs - perf.entireExecTime;
+            }
+            numPerf++;
+        }
+    }
+
+    std::sort( latencies.begin(), latencies.end() );
+    uint64_t totalUs = 0;
+    for ( uint64_t latencyUs : latencies )
+    {
+        totalUs += latencyUs;
+    }
+    printf( "QNN CPU %s: %u frames, avg %" PRIu64 " us, min %" PRIu64 " us, p50 %" PRIu64
+            " us, max %" PRIu64 " us\n",
+            modelPath.c_str(), numFrames, totalUs / numFrames, latencies.front(),
+            latencies[numFrames / 2], latencies.back() );
+    if ( numPerf > 0 )
+    {
+        printf( "QNN CPU node overhead: avg %" PRIu64 " us\n", overheadUs / numPerf );
+    }
+}
+
+#ifndef GTEST_QCNODE
+int main( int argc, char **argv )
+{
+    ::testing::InitGoogleTest( &argc, argv );
+    int nVal = RUN_ALL_TESTS();
+    return nVal;
+}
+#endif